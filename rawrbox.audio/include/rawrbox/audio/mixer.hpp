@@ -0,0 +1,127 @@
+#pragma once
+
+#include <rawrbox/audio/sink.hpp>
+#include <rawrbox/math/vector3.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace rawrbox {
+	// Decoded PCM, interleaved
+	struct AudioClip {
+		std::vector<float> samples = {};
+		uint32_t channels = 1; // 1 or 2
+		uint32_t sampleRate = 44100;
+
+		[[nodiscard]] size_t frames() const;
+	};
+
+	struct AudioVoiceSettings {
+		float volume = 1.F;
+		float pitch = 1.F;
+		bool looping = false;
+
+		// Over the voice limit, the lowest priority (then the quietest) voices go virtual: they keep their time but aren't mixed
+		int priority = 0;
+
+		// 3D, NaN = 2D. Full volume up to minDistance, muted past maxDistance
+		rawrbox::Vector3f position = {std::nanf(""), std::nanf(""), std::nanf("")};
+		float minDistance = 1.F;
+		float maxDistance = 100.F;
+	};
+
+	// Software mixer, no audio device needed (ex: headless servers, tests)
+	// Voices are resampled (linear) and mixed into a stereo float buffer, always in the same order so the output is deterministic
+	//
+	// auto voice = mixer.play(clip, {.position = {10, 0, 0}});
+	// mixer.setListenerLocation(camera->getPos(), camera->getForward());
+	// mixer.render(sink, 1024);
+	class AudioMixer {
+	protected:
+		struct Voice {
+			uint32_t id = 0;
+			std::shared_ptr<const rawrbox::AudioClip> clip = nullptr;
+			rawrbox::AudioVoiceSettings settings = {};
+
+			double cursor = 0.0; // In clip frames
+			float gainLeft = 0.F;
+			float gainRight = 0.F;
+			float audibility = 0.F;
+
+			bool paused = false;
+			bool virtualized = false;
+			bool finished = false;
+		};
+
+		uint32_t _sampleRate = 44100;
+		size_t _maxVoices = 64;
+
+		std::vector<Voice> _voices = {}; // In play order
+		uint32_t _lastId = 0;
+
+		float _masterVolume = 1.F;
+		rawrbox::Vector3f _listener = {};
+		rawrbox::Vector3f _right = {1, 0, 0};
+
+		// Scratch, kept between renders. Planar, so the mixing loops vectorize
+		std::vector<float> _voiceLeft = {};
+		std::vector<float> _voiceRight = {};
+		std::vector<float> _mixLeft = {};
+		std::vector<float> _mixRight = {};
+		std::vector<size_t> _order = {};
+		std::vector<float> _output = {}; // For sinks
+
+		[[nodiscard]] Voice* find(uint32_t id);
+		[[nodiscard]] const Voice* find(uint32_t id) const;
+
+		void updateGains(Voice& voice) const;
+		void virtualize();
+
+		void mixVoice(Voice& voice, size_t frames);
+		void skipVoice(Voice& voice, size_t frames) const;
+
+	public:
+		// Voice id, called from render once the voice is done (never for looping ones)
+		std::function<void(uint32_t)> onEnd = nullptr;
+
+		explicit AudioMixer(uint32_t sampleRate = 44100, size_t maxVoices = 64);
+
+		// VOICES ---
+		uint32_t play(std::shared_ptr<const rawrbox::AudioClip> clip, const rawrbox::AudioVoiceSettings& settings = {});
+		void stop(uint32_t id);
+		void stopAll();
+
+		void setPaused(uint32_t id, bool paused);
+		void setVolume(uint32_t id, float volume);
+		void setPitch(uint32_t id, float pitch);
+		void setLooping(uint32_t id, bool looping);
+		void setPosition(uint32_t id, const rawrbox::Vector3f& position);
+		void setDistance(uint32_t id, float minDistance, float maxDistance);
+		void seek(uint32_t id, double seconds);
+
+		[[nodiscard]] bool isPlaying(uint32_t id) const;
+		[[nodiscard]] bool isPaused(uint32_t id) const;
+		[[nodiscard]] bool isVirtual(uint32_t id) const;
+		[[nodiscard]] double getSeek(uint32_t id) const;
+
+		[[nodiscard]] size_t getVoiceCount() const;
+		[[nodiscard]] size_t getRealVoiceCount() const;
+		// ---
+
+		// LISTENER ---
+		void setMasterVolume(float volume);
+		[[nodiscard]] float getMasterVolume() const;
+
+		void setListenerLocation(const rawrbox::Vector3f& location, const rawrbox::Vector3f& front = {0, 0, 1}, const rawrbox::Vector3f& up = {0, 1, 0});
+		// ---
+
+		// Stereo interleaved, out needs frames * 2 floats (overwritten)
+		void render(float* out, size_t frames);
+		void render(rawrbox::AudioSink& sink, size_t frames);
+
+		[[nodiscard]] uint32_t getSampleRate() const;
+	};
+} // namespace rawrbox
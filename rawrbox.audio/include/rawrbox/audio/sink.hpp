@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace rawrbox {
+	// Where the AudioMixer output goes, stereo interleaved floats
+	class AudioSink {
+	public:
+		AudioSink() = default;
+		AudioSink(const AudioSink&) = default;
+		AudioSink(AudioSink&&) = default;
+		AudioSink& operator=(const AudioSink&) = default;
+		AudioSink& operator=(AudioSink&&) = default;
+		virtual ~AudioSink() = default;
+
+		virtual void write(const float* samples, size_t frames) = 0;
+	};
+
+	// Drops everything (ex: dedicated servers), only counts
+	class NullAudioSink : public rawrbox::AudioSink {
+	protected:
+		size_t _frames = 0;
+
+	public:
+		void write(const float* samples, size_t frames) override;
+		[[nodiscard]] size_t getFrames() const;
+	};
+
+	// Keeps everything in memory, written as a 16 bit WAV on flush / destruction
+	class WAVAudioSink : public rawrbox::AudioSink {
+	protected:
+		std::filesystem::path _path = {};
+		uint32_t _sampleRate = 44100;
+
+		std::vector<float> _samples = {};
+
+	public:
+		explicit WAVAudioSink(std::filesystem::path path, uint32_t sampleRate = 44100);
+		WAVAudioSink(const WAVAudioSink&) = delete;
+		WAVAudioSink(WAVAudioSink&&) = delete;
+		WAVAudioSink& operator=(const WAVAudioSink&) = delete;
+		WAVAudioSink& operator=(WAVAudioSink&&) = delete;
+		~WAVAudioSink() override;
+
+		void write(const float* samples, size_t frames) override;
+		void flush();
+
+		[[nodiscard]] const std::vector<float>& getSamples() const;
+
+		// Interleaved floats (clamped to -1 / 1) to a 16 bit PCM WAV file
+		[[nodiscard]] static std::vector<uint8_t> encode(const std::vector<float>& samples, uint16_t channels, uint32_t sampleRate);
+	};
+} // namespace rawrbox
@@ -0,0 +1,331 @@
+#include <rawrbox/audio/mixer.hpp>
+#include <rawrbox/math/pi.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace rawrbox {
+	size_t AudioClip::frames() const {
+		if (this->channels == 0) return 0;
+		return this->samples.size() / this->channels;
+	}
+
+	AudioMixer::AudioMixer(uint32_t sampleRate, size_t maxVoices) : _sampleRate(std::max<uint32_t>(sampleRate, 1)), _maxVoices(maxVoices) {}
+
+	// PROTECTED ----
+	AudioMixer::Voice* AudioMixer::find(uint32_t id) {
+		auto fnd = std::find_if(this->_voices.begin(), this->_voices.end(), [id](const Voice& voice) { return voice.id == id; });
+		return fnd == this->_voices.end() ? nullptr : &(*fnd);
+	}
+
+	const AudioMixer::Voice* AudioMixer::find(uint32_t id) const {
+		auto fnd = std::find_if(this->_voices.begin(), this->_voices.end(), [id](const Voice& voice) { return voice.id == id; });
+		return fnd == this->_voices.end() ? nullptr : &(*fnd);
+	}
+
+	void AudioMixer::updateGains(Voice& voice) const {
+		const float gain = voice.settings.volume * this->_masterVolume;
+		const auto& position = voice.settings.position;
+
+		if (std::isnan(position.x)) {
+			voice.gainLeft = gain;
+			voice.gainRight = gain;
+			voice.audibility = gain;
+			return;
+		}
+
+		// Inverse distance, like BASS with a rolloff of 1 (and muted past the max)
+		const auto delta = position - this->_listener;
+		const float distance = delta.length();
+
+		float attenuation = 0.F;
+		if (distance < voice.settings.maxDistance) attenuation = voice.settings.minDistance / std::max(distance, voice.settings.minDistance);
+
+		// Equal power panning
+		const float pan = distance > 0.0001F ? std::clamp(delta.dot(this->_right) / distance, -1.F, 1.F) : 0.F;
+		const float angle = (pan + 1.F) * rawrbox::pi<float> * 0.25F;
+
+		voice.audibility = gain * attenuation;
+		voice.gainLeft = voice.audibility * std::cos(angle);
+		voice.gainRight = voice.audibility * std::sin(angle);
+	}
+
+	void AudioMixer::virtualize() {
+		this->_order.clear();
+
+		for (size_t i = 0; i < this->_voices.size(); i++) {
+			auto& voice = this->_voices[i];
+			voice.virtualized = false;
+
+			if (!voice.paused && !voice.finished) this->_order.push_back(i);
+		}
+
+		if (this->_order.size() <= this->_maxVoices) {
+			for (size_t i : this->_order) {
+				auto& voice = this->_voices[i];
+				voice.virtualized = voice.audibility <= 0.F; // Nothing to hear, don't bother
+			}
+
+			return;
+		}
+
+		// Priority first, then the loudest, then the oldest
+		std::sort(this->_order.begin(), this->_order.end(), [this](size_t a, size_t b) {
+			const auto& voiceA = this->_voices[a];
+			const auto& voiceB = this->_voices[b];
+
+			if (voiceA.settings.priority != voiceB.settings.priority) return voiceA.settings.priority > voiceB.settings.priority;
+			if (voiceA.audibility != voiceB.audibility) return voiceA.audibility > voiceB.audibility;
+			return voiceA.id < voiceB.id;
+		});
+
+		size_t real = 0;
+		for (size_t i : this->_order) {
+			auto& voice = this->_voices[i];
+
+			voice.virtualized = real >= this->_maxVoices || voice.audibility <= 0.F;
+			if (!voice.virtualized) real++;
+		}
+	}
+
+	void AudioMixer::mixVoice(Voice& voice, size_t frames) {
+		const auto& clip = *voice.clip;
+		const size_t clipFrames = clip.frames();
+		if (clipFrames == 0) {
+			voice.finished = true;
+			return;
+		}
+
+		const double step = static_cast<double>(clip.sampleRate) / static_cast<double>(this->_sampleRate) * std::max(voice.settings.pitch, 0.F);
+		const bool looping = voice.settings.looping;
+		const bool mono = clip.channels == 1 || !std::isnan(voice.settings.position.x); // 3D is always mono
+		const float* src = clip.samples.data();
+
+		float* left = this->_voiceLeft.data();
+		float* right = this->_voiceRight.data();
+
+		// Resample (linear)
+		double cursor = voice.cursor;
+		size_t count = 0;
+		for (; count < frames; count++) {
+			if (cursor >= static_cast<double>(clipFrames)) {
+				if (!looping) break;
+				cursor = std::fmod(cursor, static_cast<double>(clipFrames));
+			}
+
+			const auto i = static_cast<size_t>(cursor);
+			const auto t = static_cast<float>(cursor - static_cast<double>(i));
+
+			size_t j = i + 1;
+			if (j >= clipFrames) j = looping ? 0 : i;
+
+			if (clip.channels == 1) {
+				left[count] = src[i] + (src[j] - src[i]) * t;
+			} else {
+				const float l = src[i * 2] + (src[j * 2] - src[i * 2]) * t;
+				const float r = src[i * 2 + 1] + (src[j * 2 + 1] - src[i * 2 + 1]) * t;
+
+				if (mono) {
+					left[count] = (l + r) * 0.5F;
+				} else {
+					left[count] = l;
+					right[count] = r;
+				}
+			}
+
+			cursor += step;
+		}
+
+		voice.cursor = cursor;
+		if (!looping && cursor >= static_cast<double>(clipFrames)) voice.finished = true;
+
+		// Gain + accumulate, branch free so it vectorizes
+		const float gainLeft = voice.gainLeft;
+		const float gainRight = voice.gainRight;
+		const float* voiceRight = mono ? left : right;
+
+		float* mixLeft = this->_mixLeft.data();
+		float* mixRight = this->_mixRight.data();
+
+		for (size_t f = 0; f < count; f++) {
+			mixLeft[f] += left[f] * gainLeft;
+		}
+
+		for (size_t f = 0; f < count; f++) {
+			mixRight[f] += voiceRight[f] * gainRight;
+		}
+	}
+
+	void AudioMixer::skipVoice(Voice& voice, size_t frames) const {
+		const auto clipFrames = static_cast<double>(voice.clip->frames());
+		if (clipFrames <= 0.0) {
+			voice.finished = true;
+			return;
+		}
+
+		const double step = static_cast<double>(voice.clip->sampleRate) / static_cast<double>(this->_sampleRate) * std::max(voice.settings.pitch, 0.F);
+		voice.cursor += step * static_cast<double>(frames);
+
+		if (voice.cursor < clipFrames) return;
+		if (voice.settings.looping) {
+			voice.cursor = std::fmod(voice.cursor, clipFrames);
+		} else {
+			voice.finished = true;
+		}
+	}
+	// -------------
+
+	// VOICES ---
+	uint32_t AudioMixer::play(std::shared_ptr<const rawrbox::AudioClip> clip, const rawrbox::AudioVoiceSettings& settings) {
+		if (clip == nullptr) throw std::runtime_error("[RawrBox-Audio] Invalid clip");
+		if (clip->channels != 1 && clip->channels != 2) throw std::runtime_error("[RawrBox-Audio] Only mono and stereo clips are supported");
+
+		Voice voice = {};
+		voice.id = ++this->_lastId;
+		voice.clip = std::move(clip);
+		voice.settings = settings;
+
+		this->_voices.push_back(std::move(voice));
+		return this->_lastId;
+	}
+
+	void AudioMixer::stop(uint32_t id) {
+		std::erase_if(this->_voices, [id](const Voice& voice) { return voice.id == id; });
+	}
+
+	void AudioMixer::stopAll() { this->_voices.clear(); }
+
+	void AudioMixer::setPaused(uint32_t id, bool paused) {
+		auto* voice = this->find(id);
+		if (voice != nullptr) voice->paused = paused;
+	}
+
+	void AudioMixer::setVolume(uint32_t id, float volume) {
+		auto* voice = this->find(id);
+		if (voice != nullptr) voice->settings.volume = volume;
+	}
+
+	void AudioMixer::setPitch(uint32_t id, float pitch) {
+		auto* voice = this->find(id);
+		if (voice != nullptr) voice->settings.pitch = pitch;
+	}
+
+	void AudioMixer::setLooping(uint32_t id, bool looping) {
+		auto* voice = this->find(id);
+		if (voice != nullptr) voice->settings.looping = looping;
+	}
+
+	void AudioMixer::setPosition(uint32_t id, const rawrbox::Vector3f& position) {
+		auto* voice = this->find(id);
+		if (voice != nullptr) voice->settings.position = position;
+	}
+
+	void AudioMixer::setDistance(uint32_t id, float minDistance, float maxDistance) {
+		auto* voice = this->find(id);
+		if (voice == nullptr) return;
+
+		voice->settings.minDistance = minDistance;
+		voice->settings.maxDistance = maxDistance;
+	}
+
+	void AudioMixer::seek(uint32_t id, double seconds) {
+		auto* voice = this->find(id);
+		if (voice != nullptr) voice->cursor = std::max(seconds, 0.0) * static_cast<double>(voice->clip->sampleRate);
+	}
+
+	bool AudioMixer::isPlaying(uint32_t id) const {
+		const auto* voice = this->find(id);
+		return voice != nullptr && !voice->paused;
+	}
+
+	bool AudioMixer::isPaused(uint32_t id) const {
+		const auto* voice = this->find(id);
+		return voice != nullptr && voice->paused;
+	}
+
+	bool AudioMixer::isVirtual(uint32_t id) const {
+		const auto* voice = this->find(id);
+		return voice != nullptr && voice->virtualized;
+	}
+
+	double AudioMixer::getSeek(uint32_t id) const {
+		const auto* voice = this->find(id);
+		if (voice == nullptr) return 0.0;
+
+		return voice->cursor / static_cast<double>(voice->clip->sampleRate);
+	}
+
+	size_t AudioMixer::getVoiceCount() const { return this->_voices.size(); }
+	size_t AudioMixer::getRealVoiceCount() const {
+		return static_cast<size_t>(std::count_if(this->_voices.begin(), this->_voices.end(), [](const Voice& voice) { return !voice.paused && !voice.virtualized; }));
+	}
+	// ---
+
+	// LISTENER ---
+	void AudioMixer::setMasterVolume(float volume) { this->_masterVolume = std::max(volume, 0.F); }
+	float AudioMixer::getMasterVolume() const { return this->_masterVolume; }
+
+	void AudioMixer::setListenerLocation(const rawrbox::Vector3f& location, const rawrbox::Vector3f& front, const rawrbox::Vector3f& up) {
+		this->_listener = location;
+
+		const auto right = up.cross(front);
+		const float length = right.length();
+		this->_right = length > 0.F ? right / length : rawrbox::Vector3f{1, 0, 0};
+	}
+	// ---
+
+	void AudioMixer::render(float* out, size_t frames) {
+		if (this->_mixLeft.size() < frames) {
+			this->_voiceLeft.resize(frames);
+			this->_voiceRight.resize(frames);
+			this->_mixLeft.resize(frames);
+			this->_mixRight.resize(frames);
+		}
+
+		std::fill_n(this->_mixLeft.begin(), frames, 0.F);
+		std::fill_n(this->_mixRight.begin(), frames, 0.F);
+
+		for (auto& voice : this->_voices) {
+			this->updateGains(voice);
+		}
+
+		this->virtualize();
+
+		// Play order, so the float sums always happen the same way
+		for (auto& voice : this->_voices) {
+			if (voice.paused) continue;
+
+			if (voice.virtualized) {
+				this->skipVoice(voice, frames);
+			} else {
+				this->mixVoice(voice, frames);
+			}
+		}
+
+		for (size_t f = 0; f < frames; f++) {
+			out[f * 2] = this->_mixLeft[f];
+			out[f * 2 + 1] = this->_mixRight[f];
+		}
+
+		// Removed before calling onEnd, so it can play new voices
+		std::vector<uint32_t> ended = {};
+		std::erase_if(this->_voices, [&ended](const Voice& voice) {
+			if (voice.finished) ended.push_back(voice.id);
+			return voice.finished;
+		});
+
+		if (this->onEnd == nullptr) return;
+		for (uint32_t id : ended) {
+			this->onEnd(id);
+		}
+	}
+
+	void AudioMixer::render(rawrbox::AudioSink& sink, size_t frames) {
+		this->_output.resize(frames * 2);
+		this->render(this->_output.data(), frames);
+
+		sink.write(this->_output.data(), frames);
+	}
+
+	uint32_t AudioMixer::getSampleRate() const { return this->_sampleRate; }
+} // namespace rawrbox
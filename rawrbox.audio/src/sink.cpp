@@ -0,0 +1,90 @@
+#include <rawrbox/audio/sink.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace rawrbox {
+	namespace {
+		void appendU16(std::vector<uint8_t>& out, uint16_t value) {
+			out.push_back(static_cast<uint8_t>(value & 0xFFU));
+			out.push_back(static_cast<uint8_t>(value >> 8U));
+		}
+
+		void appendU32(std::vector<uint8_t>& out, uint32_t value) {
+			for (uint32_t i = 0; i < 4; i++) {
+				out.push_back(static_cast<uint8_t>((value >> (i * 8U)) & 0xFFU));
+			}
+		}
+
+		void appendTag(std::vector<uint8_t>& out, const char* tag) {
+			for (size_t i = 0; i < 4; i++) {
+				out.push_back(static_cast<uint8_t>(tag[i]));
+			}
+		}
+	} // namespace
+
+	// NULL ---
+	void NullAudioSink::write(const float* /*samples*/, size_t frames) { this->_frames += frames; }
+	size_t NullAudioSink::getFrames() const { return this->_frames; }
+	// ---
+
+	// WAV ---
+	WAVAudioSink::WAVAudioSink(std::filesystem::path path, uint32_t sampleRate) : _path(std::move(path)), _sampleRate(sampleRate) {}
+	WAVAudioSink::~WAVAudioSink() {
+		try {
+			this->flush();
+		} catch (...) {
+			// Nothing to do in a destructor
+		}
+	}
+
+	void WAVAudioSink::write(const float* samples, size_t frames) {
+		this->_samples.insert(this->_samples.end(), samples, samples + frames * 2);
+	}
+
+	void WAVAudioSink::flush() {
+		if (this->_path.empty()) return;
+
+		std::ofstream file(this->_path, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) throw std::runtime_error("[RawrBox-Audio] Failed to open '" + this->_path.generic_string() + "'");
+
+		const auto data = encode(this->_samples, 2, this->_sampleRate);
+		file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+	}
+
+	const std::vector<float>& WAVAudioSink::getSamples() const { return this->_samples; }
+
+	std::vector<uint8_t> WAVAudioSink::encode(const std::vector<float>& samples, uint16_t channels, uint32_t sampleRate) {
+		const auto dataSize = static_cast<uint32_t>(samples.size() * sizeof(int16_t));
+
+		std::vector<uint8_t> out = {};
+		out.reserve(44 + dataSize);
+
+		appendTag(out, "RIFF");
+		appendU32(out, 36 + dataSize);
+		appendTag(out, "WAVE");
+
+		appendTag(out, "fmt ");
+		appendU32(out, 16);
+		appendU16(out, 1); // PCM
+		appendU16(out, channels);
+		appendU32(out, sampleRate);
+		appendU32(out, sampleRate * channels * sizeof(int16_t)); // Bytes per second
+		appendU16(out, static_cast<uint16_t>(channels * sizeof(int16_t)));
+		appendU16(out, 16);
+
+		appendTag(out, "data");
+		appendU32(out, dataSize);
+
+		for (float sample : samples) {
+			const auto value = static_cast<int16_t>(std::lround(std::clamp(sample, -1.F, 1.F) * 32767.F));
+			appendU16(out, static_cast<uint16_t>(value));
+		}
+
+		return out;
+	}
+	// ---
+} // namespace rawrbox
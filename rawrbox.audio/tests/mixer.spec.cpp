@@ -0,0 +1,240 @@
+#include <rawrbox/audio/mixer.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using Catch::Matchers::WithinAbs;
+
+namespace {
+	std::shared_ptr<rawrbox::AudioClip> makeClip(std::vector<float> samples, uint32_t channels = 1, uint32_t sampleRate = 44100) {
+		auto clip = std::make_shared<rawrbox::AudioClip>();
+		clip->samples = std::move(samples);
+		clip->channels = channels;
+		clip->sampleRate = sampleRate;
+
+		return clip;
+	}
+
+	std::shared_ptr<rawrbox::AudioClip> makeSine(float frequency, size_t frames) {
+		std::vector<float> samples(frames);
+		for (size_t i = 0; i < frames; i++) {
+			samples[i] = std::sin(static_cast<float>(i) * frequency * 2.F * 3.14159265F / 44100.F);
+		}
+
+		return makeClip(std::move(samples));
+	}
+
+	std::vector<float> render(rawrbox::AudioMixer& mixer, size_t frames) {
+		std::vector<float> out(frames * 2);
+		mixer.render(out.data(), frames);
+
+		return out;
+	}
+} // namespace
+
+TEST_CASE("AudioMixer should behave as expected", "[rawrbox::AudioMixer]") {
+	rawrbox::AudioMixer mixer(44100, 8);
+
+	SECTION("rawrbox::AudioMixer::play") {
+		auto id = mixer.play(makeClip(std::vector<float>(16, 0.5F)), {.volume = 0.5F});
+		REQUIRE(mixer.isPlaying(id));
+
+		auto out = render(mixer, 4);
+		for (float sample : out) {
+			REQUIRE(sample == 0.25F);
+		}
+
+		mixer.setPaused(id, true);
+		out = render(mixer, 4);
+		for (float sample : out) {
+			REQUIRE(sample == 0.F);
+		}
+
+		mixer.stop(id);
+		REQUIRE_FALSE(mixer.isPlaying(id));
+		REQUIRE(mixer.getVoiceCount() == 0);
+	}
+
+	SECTION("rawrbox::AudioMixer resampling") {
+		std::vector<uint32_t> ended = {};
+		mixer.onEnd = [&ended](uint32_t id) { ended.push_back(id); };
+
+		// Half the mixer rate, every sample is stretched over two frames
+		auto id = mixer.play(makeClip({0.F, 1.F, 2.F, 3.F}, 1, 22050));
+		auto out = render(mixer, 10);
+
+		const std::vector<float> golden = {0.F, 0.5F, 1.F, 1.5F, 2.F, 2.5F, 3.F, 3.F, 0.F, 0.F};
+		for (size_t i = 0; i < golden.size(); i++) {
+			REQUIRE_THAT(out[i * 2], WithinAbs(golden[i], 0.00001));
+			REQUIRE_THAT(out[i * 2 + 1], WithinAbs(golden[i], 0.00001));
+		}
+
+		REQUIRE(ended == std::vector<uint32_t>{id});
+		REQUIRE(mixer.getVoiceCount() == 0);
+	}
+
+	SECTION("rawrbox::AudioMixer looping") {
+		auto id = mixer.play(makeClip({1.F, 0.F}), {.looping = true});
+		auto out = render(mixer, 5);
+
+		const std::vector<float> golden = {1.F, 0.F, 1.F, 0.F, 1.F};
+		for (size_t i = 0; i < golden.size(); i++) {
+			REQUIRE(out[i * 2] == golden[i]);
+		}
+
+		REQUIRE(mixer.isPlaying(id));
+	}
+
+	SECTION("rawrbox::AudioMixer stereo") {
+		mixer.play(makeClip({0.25F, -0.25F, 0.5F, -0.5F}, 2));
+		auto out = render(mixer, 2);
+
+		REQUIRE(out == std::vector<float>{0.25F, -0.25F, 0.5F, -0.5F});
+	}
+
+	SECTION("rawrbox::AudioMixer::setListenerLocation") {
+		mixer.setListenerLocation({0, 0, 0}, {0, 0, 1}, {0, 1, 0});
+		auto clip = makeClip(std::vector<float>(64, 1.F));
+
+		// On the right, 5 units away
+		auto right = mixer.play(clip, {.position = {5, 0, 0}, .minDistance = 1.F, .maxDistance = 100.F});
+		auto out = render(mixer, 1);
+		REQUIRE_THAT(out[0], WithinAbs(0.0, 0.0001));
+		REQUIRE_THAT(out[1], WithinAbs(0.2, 0.0001));
+		mixer.stop(right);
+
+		// Inside the min distance, in front
+		auto front = mixer.play(clip, {.position = {0, 0, 0.5F}, .minDistance = 1.F, .maxDistance = 100.F});
+		out = render(mixer, 1);
+		REQUIRE_THAT(out[0], WithinAbs(std::sqrt(0.5), 0.0001));
+		REQUIRE_THAT(out[1], WithinAbs(std::sqrt(0.5), 0.0001));
+
+		// Turning around, the left ear faces +X
+		mixer.setListenerLocation({0, 0, 0}, {0, 0, -1}, {0, 1, 0});
+		mixer.setPosition(front, {5, 0, 0});
+		out = render(mixer, 1);
+		REQUIRE_THAT(out[0], WithinAbs(0.2, 0.0001));
+		REQUIRE_THAT(out[1], WithinAbs(0.0, 0.0001));
+
+		// Past the max, muted and not mixed
+		mixer.setPosition(front, {200, 0, 0});
+		out = render(mixer, 1);
+		REQUIRE(out[0] == 0.F);
+		REQUIRE(out[1] == 0.F);
+		REQUIRE(mixer.isVirtual(front));
+	}
+
+	SECTION("rawrbox::AudioMixer virtualization") {
+		rawrbox::AudioMixer limited(44100, 2);
+		auto clip = makeClip(std::vector<float>(44100, 0.1F));
+
+		auto low = limited.play(clip, {.priority = 0});
+		auto mid = limited.play(clip, {.priority = 1});
+		auto high = limited.play(clip, {.volume = 0.5F, .priority = 2});
+
+		auto out = render(limited, 100);
+		REQUIRE(limited.isVirtual(low));
+		REQUIRE_FALSE(limited.isVirtual(mid));
+		REQUIRE_FALSE(limited.isVirtual(high));
+		REQUIRE(limited.getRealVoiceCount() == 2);
+		REQUIRE_THAT(out[0], WithinAbs(0.15, 0.00001));
+
+		// Kept its time while virtual
+		REQUIRE_THAT(limited.getSeek(low), WithinAbs(limited.getSeek(mid), 0.00001));
+
+		limited.stop(high);
+		render(limited, 1);
+		REQUIRE_FALSE(limited.isVirtual(low));
+	}
+
+	SECTION("rawrbox::AudioMixer determinism") {
+		auto run = []() {
+			rawrbox::AudioMixer mix(44100, 16);
+			mix.setListenerLocation({1, 0, 2}, {0, 0, 1});
+
+			for (int i = 0; i < 32; i++) {
+				mix.play(makeSine(110.F * static_cast<float>(i + 1), 4096), {.volume = 0.1F, .pitch = 0.5F + static_cast<float>(i) * 0.1F, .looping = (i % 3) == 0, .priority = i % 4, .position = {static_cast<float>(i) - 16.F, 0.F, static_cast<float>(i % 5)}, .maxDistance = 50.F});
+			}
+
+			std::vector<float> all = {};
+			for (int block = 0; block < 8; block++) {
+				auto out = render(mix, 1024);
+				all.insert(all.end(), out.begin(), out.end());
+			}
+
+			return all;
+		};
+
+		auto a = run();
+		auto b = run();
+
+		REQUIRE(a.size() == b.size());
+		REQUIRE(std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0);
+	}
+}
+
+TEST_CASE("AudioSink should behave as expected", "[rawrbox::AudioSink]") {
+	SECTION("rawrbox::NullAudioSink") {
+		rawrbox::AudioMixer mixer;
+		rawrbox::NullAudioSink sink;
+
+		mixer.play(makeSine(440.F, 512));
+		mixer.render(sink, 256);
+		mixer.render(sink, 256);
+
+		REQUIRE(sink.getFrames() == 512);
+		REQUIRE(mixer.getVoiceCount() == 0);
+	}
+
+	SECTION("rawrbox::WAVAudioSink::encode") {
+		auto data = rawrbox::WAVAudioSink::encode({1.F, -1.F, 2.F, 0.F}, 2, 44100);
+		REQUIRE(data.size() == 44 + 4 * 2);
+
+		REQUIRE(std::memcmp(data.data(), "RIFF", 4) == 0);
+		REQUIRE(std::memcmp(data.data() + 8, "WAVEfmt ", 8) == 0);
+		REQUIRE(std::memcmp(data.data() + 36, "data", 4) == 0);
+
+		const std::vector<uint8_t> golden = {0xFF, 0x7F, 0x01, 0x80, 0xFF, 0x7F, 0x00, 0x00}; // 32767, -32767, clamped, 0
+		REQUIRE(std::vector<uint8_t>(data.begin() + 44, data.end()) == golden);
+	}
+
+	SECTION("rawrbox::WAVAudioSink") {
+		rawrbox::AudioMixer mixer;
+		rawrbox::WAVAudioSink sink(""); // No file, just keeps the samples
+
+		mixer.play(makeClip({0.5F, 0.25F}));
+		mixer.render(sink, 4);
+
+		REQUIRE(sink.getSamples() == std::vector<float>{0.5F, 0.5F, 0.25F, 0.25F, 0.F, 0.F, 0.F, 0.F});
+	}
+}
+
+TEST_CASE("AudioMixer benchmark", "[rawrbox::AudioMixer][.benchmark]") {
+	rawrbox::AudioMixer mixer(44100, 512);
+	mixer.setListenerLocation({0, 0, 0});
+
+	for (int i = 0; i < 512; i++) {
+		mixer.play(makeSine(55.F + static_cast<float>(i), 44100), {.volume = 0.01F, .pitch = 0.75F + static_cast<float>(i % 8) * 0.1F, .looping = true, .position = {static_cast<float>(i % 32), 0.F, static_cast<float>(i / 32)}});
+	}
+
+	std::vector<float> out(1024 * 2);
+	BENCHMARK("Render 1024 frames (512 voices)") {
+		mixer.render(out.data(), 1024);
+		return out[0];
+	};
+
+	rawrbox::AudioMixer limited(44100, 64);
+	for (int i = 0; i < 512; i++) {
+		limited.play(makeSine(55.F + static_cast<float>(i), 44100), {.volume = 0.01F, .looping = true, .priority = i % 4});
+	}
+
+	BENCHMARK("Render 1024 frames (512 voices, 64 real)") {
+		limited.render(out.data(), 1024);
+		return out[0];
+	};
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <rawrbox/math/vector3.hpp>
+
+#include <memory>
+
+namespace rawrbox {
+	class SoundBase;
+	class SoundInstance;
+
+	// What plays the sounds, BASS::setMasterVolume / setListenerLocation go through it
+	class SoundBackendBase {
+	public:
+		SoundBackendBase() = default;
+		SoundBackendBase(const SoundBackendBase&) = delete;
+		SoundBackendBase(SoundBackendBase&&) = delete;
+		SoundBackendBase& operator=(const SoundBackendBase&) = delete;
+		SoundBackendBase& operator=(SoundBackendBase&&) = delete;
+		virtual ~SoundBackendBase() = default;
+
+		virtual bool initialize() = 0;
+		virtual void shutdown() = 0;
+
+		virtual void setMasterVolume(float volume) = 0;
+		virtual void setListenerLocation(const rawrbox::Vector3f& location, const rawrbox::Vector3f& front, const rawrbox::Vector3f& up) = 0;
+
+		// Used by SoundBase::createInstance, the instance plays on this backend
+		[[nodiscard]] virtual std::shared_ptr<rawrbox::SoundInstance> createInstance(const rawrbox::SoundBase& sound) = 0;
+	};
+} // namespace rawrbox
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <rawrbox/bass/backends/base.hpp>
+
+namespace rawrbox {
+	// Default, plays through the audio device using BASS 3D
+	class SoundBackendBASS : public rawrbox::SoundBackendBase {
+	protected:
+		rawrbox::Vector3f _oldLocation = {};
+
+	public:
+		bool initialize() override;
+		void shutdown() override;
+
+		void setMasterVolume(float volume) override;
+		void setListenerLocation(const rawrbox::Vector3f& location, const rawrbox::Vector3f& front, const rawrbox::Vector3f& up) override;
+
+		[[nodiscard]] std::shared_ptr<rawrbox::SoundInstance> createInstance(const rawrbox::SoundBase& sound) override;
+	};
+} // namespace rawrbox
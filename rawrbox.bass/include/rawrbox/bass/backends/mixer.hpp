@@ -0,0 +1,54 @@
+#pragma once
+
+#include <rawrbox/audio/mixer.hpp>
+#include <rawrbox/audio/sink.hpp>
+#include <rawrbox/bass/backends/base.hpp>
+#include <rawrbox/bass/sound/instance_mixer.hpp>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace rawrbox {
+	// No audio device, sounds are mixed by rawrbox::AudioMixer into a sink (ex: headless servers, recording)
+	// BASS is only used to decode the files, BASS::loadSound instances play as mixer voices (see SoundInstanceMixer)
+	//
+	// auto* backend = rawrbox::BASS::setBackend<rawrbox::SoundBackendMixer>(std::make_unique<rawrbox::WAVAudioSink>("out.wav"));
+	// rawrbox::BASS::initialize();
+	// rawrbox::BASS::loadSound("./assets/sounds/clown.ogg")->createInstance()->play();
+	// backend->render(1024);
+	class SoundBackendMixer : public rawrbox::SoundBackendBase {
+	protected:
+		rawrbox::AudioMixer _mixer;
+		std::unique_ptr<rawrbox::AudioSink> _sink = nullptr;
+
+		std::unordered_map<std::string, std::shared_ptr<const rawrbox::AudioClip>> _clips = {};
+		std::unordered_map<uint32_t, rawrbox::SoundInstanceMixer*> _voices = {}; // Voice -> instance playing it, for onEnd
+
+	public:
+		explicit SoundBackendMixer(std::unique_ptr<rawrbox::AudioSink> sink = std::make_unique<rawrbox::NullAudioSink>(), uint32_t sampleRate = 44100, size_t maxVoices = 64);
+
+		bool initialize() override;
+		void shutdown() override;
+
+		void setMasterVolume(float volume) override;
+		void setListenerLocation(const rawrbox::Vector3f& location, const rawrbox::Vector3f& front, const rawrbox::Vector3f& up) override;
+
+		// HTTP sounds can't be decoded up front, those are not supported
+		[[nodiscard]] std::shared_ptr<rawrbox::SoundInstance> createInstance(const rawrbox::SoundBase& sound) override;
+
+		// Decoded to float PCM, mono or stereo only. Cached by path
+		[[nodiscard]] std::shared_ptr<const rawrbox::AudioClip> loadClip(const std::filesystem::path& path);
+
+		// Mixes the next frames into the sink
+		void render(size_t frames);
+
+		// Used by SoundInstanceMixer
+		void bindVoice(uint32_t voice, rawrbox::SoundInstanceMixer* instance);
+		void unbindVoice(uint32_t voice);
+
+		[[nodiscard]] rawrbox::AudioMixer& getMixer();
+		[[nodiscard]] rawrbox::AudioSink& getSink();
+	};
+} // namespace rawrbox
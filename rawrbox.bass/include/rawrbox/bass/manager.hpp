@@ -1,9 +1,12 @@
 #pragma once
 
+#include <rawrbox/bass/backends/bass.hpp>
 #include <rawrbox/bass/sound/base.hpp>
 #include <rawrbox/utils/event_named.hpp>
 
+#include <concepts>
 #include <filesystem>
+#include <memory>
 #include <unordered_map>
 
 namespace rawrbox {
@@ -14,7 +17,7 @@ namespace rawrbox {
 		static float _masterVolume;
 		static bool _muteOnUnfocus;
 
-		static rawrbox::Vector3f _oldLocation;
+		static std::unique_ptr<rawrbox::SoundBackendBase> _backend;
 
 		// LOGGER ------
 		static std::unique_ptr<rawrbox::Logger> _logger;
@@ -30,6 +33,26 @@ namespace rawrbox {
 		static void initialize();
 		static void shutdown();
 
+		// BACKEND -----
+		template <typename T = rawrbox::SoundBackendBASS, typename... CallbackArgs>
+			requires(std::derived_from<T, rawrbox::SoundBackendBase>)
+		static T* setBackend(CallbackArgs&&... args) {
+			if (_initialized) RAWRBOX_CRITICAL("'setBackend' must be called before 'initialize'!");
+
+			auto backend = std::make_unique<T>(std::forward<CallbackArgs>(args)...);
+			auto* ptr = backend.get();
+
+			_backend = std::move(backend);
+			return ptr;
+		}
+
+		template <typename T = rawrbox::SoundBackendBase>
+			requires(std::derived_from<T, rawrbox::SoundBackendBase>)
+		[[nodiscard]] static T* getBackend() {
+			return dynamic_cast<T*>(_backend.get());
+		}
+		// -----
+
 		static rawrbox::SoundBase* loadSound(const std::filesystem::path& path, uint32_t flags = SoundFlags::NONE);
 		static rawrbox::SoundBase* loadHTTPSound(const std::string& url, uint32_t flags = SoundFlags::NONE);
 
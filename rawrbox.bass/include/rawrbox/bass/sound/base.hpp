@@ -6,6 +6,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
 
 namespace rawrbox {
 
@@ -16,6 +17,7 @@ namespace rawrbox {
 		uint32_t _flags = rawrbox::SoundFlags::NONE;
 
 		bool _isStream = false;
+		std::string _path = ""; // File or url it was loaded from
 
 		std::vector<std::shared_ptr<rawrbox::SoundInstance>> _instances = {};
 
@@ -25,7 +27,7 @@ namespace rawrbox {
 	public:
 		virtual ~SoundBase();
 
-		SoundBase(uint32_t sample, uint32_t fx, uint32_t flags, bool stream = false);
+		SoundBase(uint32_t sample, uint32_t fx, uint32_t flags, bool stream = false, std::string path = "");
 		SoundBase(SoundBase&&) = delete;
 		SoundBase& operator=(SoundBase&&) = delete;
 		SoundBase(const SoundBase&) = delete;
@@ -34,6 +36,11 @@ namespace rawrbox {
 		[[nodiscard]] bool isValid() const;
 		[[nodiscard]] virtual uint32_t getSample() const;
 		[[nodiscard]] virtual uint32_t getFXSample() const;
+		[[nodiscard]] virtual uint32_t getFlags() const;
+		[[nodiscard]] virtual bool isStream() const;
+		[[nodiscard]] virtual const std::string& getPath() const;
+
+		// Made by the current backend, see SoundBackendBase::createInstance
 
 		virtual std::shared_ptr<rawrbox::SoundInstance> createInstance();
 		virtual std::shared_ptr<rawrbox::SoundInstance> getInstance(size_t i);
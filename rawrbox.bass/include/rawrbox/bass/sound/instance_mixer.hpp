@@ -0,0 +1,54 @@
+#pragma once
+
+#include <rawrbox/audio/mixer.hpp>
+#include <rawrbox/bass/sound/instance.hpp>
+
+#include <memory>
+
+namespace rawrbox {
+	class SoundBackendMixer;
+
+	// SoundInstance of the mixer backend, plays the decoded clip as a rawrbox::AudioMixer voice
+	// No FFT, beat or bpm detection here, those need a BASS channel
+	class SoundInstanceMixer : public rawrbox::SoundInstance {
+	protected:
+		rawrbox::SoundBackendMixer* _backend = nullptr;
+		std::shared_ptr<const rawrbox::AudioClip> _clip = nullptr;
+
+		uint32_t _voice = 0;
+
+		[[nodiscard]] rawrbox::AudioMixer& getMixer() const;
+
+	public:
+		SoundInstanceMixer(rawrbox::SoundBackendMixer& backend, std::shared_ptr<const rawrbox::AudioClip> clip, uint32_t audioSample, uint32_t flags);
+		SoundInstanceMixer(SoundInstanceMixer&&) = delete;
+		SoundInstanceMixer& operator=(SoundInstanceMixer&&) = delete;
+		SoundInstanceMixer(const SoundInstanceMixer&) = delete;
+		SoundInstanceMixer& operator=(const SoundInstanceMixer&) = delete;
+		~SoundInstanceMixer() override;
+
+		void play() override;
+		void pause() override;
+		void stop() override;
+
+		// UTILS ----
+		[[nodiscard]] uint32_t id() const override;
+		[[nodiscard]] bool isCreated() const override;
+		[[nodiscard]] double getSeek() const override;
+
+		[[nodiscard]] bool isPlaying() const override;
+		[[nodiscard]] bool isPaused() const override;
+		[[nodiscard]] bool isHTTPStream() const override;
+
+		[[nodiscard]] std::vector<float> getFFT(int bass_length) const override;
+		// ------------------
+
+		void setBeatSettings(float bandwidth, float center_freq, float release_time) override;
+		void setVolume(float volume) override;
+		void setTempo(float tempo) override;
+		void seek(double seek) override;
+		void setLooping(bool loop) override;
+		void setPosition(const rawrbox::Vector3f& pos) override;
+		void set3D(float maxDistance, float minDistance = 0.F) override;
+	};
+} // namespace rawrbox
@@ -0,0 +1,43 @@
+#include <rawrbox/bass/backends/bass.hpp>
+#include <rawrbox/bass/sound/base.hpp>
+
+#include <bass.h>
+
+namespace rawrbox {
+	bool SoundBackendBASS::initialize() {
+		if (BASS_Init(-1, 44100, BASS_DEVICE_3D, nullptr, nullptr) == 0) return false;
+
+		BASS_Start();
+		BASS_Set3DFactors(1.0F, 10.0F, 1.0F);
+		BASS_Apply3D();
+
+		return true;
+	}
+
+	void SoundBackendBASS::shutdown() {
+		BASS_Free();
+	}
+
+	void SoundBackendBASS::setMasterVolume(float volume) {
+		BASS_SetConfig(BASS_CONFIG_GVOL_MUSIC, static_cast<DWORD>(volume * 10000));
+		BASS_SetConfig(BASS_CONFIG_GVOL_SAMPLE, static_cast<DWORD>(volume * 10000));
+		BASS_SetConfig(BASS_CONFIG_GVOL_STREAM, static_cast<DWORD>(volume * 10000));
+	}
+
+	void SoundBackendBASS::setListenerLocation(const rawrbox::Vector3f& location, const rawrbox::Vector3f& front, const rawrbox::Vector3f& up) {
+		auto velo = location - this->_oldLocation;
+		this->_oldLocation = location;
+
+		BASS_3DVECTOR Bass_Player = {location.x, location.y, location.z};
+		BASS_3DVECTOR Bass_Front = {front.x, front.y, front.z};
+		BASS_3DVECTOR Bass_Top = {up.x, up.y, up.z};
+		BASS_3DVECTOR Bass_Velocity = {velo.x, velo.y, velo.z};
+
+		BASS_Set3DPosition(&Bass_Player, &Bass_Velocity, &Bass_Front, &Bass_Top);
+		BASS_Apply3D();
+	}
+
+	std::shared_ptr<rawrbox::SoundInstance> SoundBackendBASS::createInstance(const rawrbox::SoundBase& sound) {
+		return std::make_shared<rawrbox::SoundInstance>(sound.getSample(), sound.isStream(), sound.getFlags());
+	}
+} // namespace rawrbox
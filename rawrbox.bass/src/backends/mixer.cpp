@@ -0,0 +1,110 @@
+#include <rawrbox/bass/backends/mixer.hpp>
+#include <rawrbox/bass/sound/base.hpp>
+#include <rawrbox/bass/utils/bass.hpp>
+#include <rawrbox/utils/logger.hpp>
+
+#include <bass.h>
+
+#include <array>
+
+namespace rawrbox {
+	SoundBackendMixer::SoundBackendMixer(std::unique_ptr<rawrbox::AudioSink> sink, uint32_t sampleRate, size_t maxVoices) : _mixer(sampleRate, maxVoices), _sink(std::move(sink)) {
+		if (this->_sink == nullptr) RAWRBOX_CRITICAL("Invalid audio sink");
+
+		this->_mixer.onEnd = [this](uint32_t voice) {
+			auto fnd = this->_voices.find(voice);
+			if (fnd == this->_voices.end()) return;
+
+			auto* instance = fnd->second;
+			this->_voices.erase(fnd);
+
+			instance->onEnd();
+		};
+	}
+
+	bool SoundBackendMixer::initialize() {
+		// Device 0 is BASS's "no sound" device, enough for decoding
+		return BASS_Init(0, this->_mixer.getSampleRate(), 0, nullptr, nullptr) != 0;
+	}
+
+	void SoundBackendMixer::shutdown() {
+		this->_mixer.stopAll();
+		this->_voices.clear();
+		this->_clips.clear();
+
+		BASS_Free();
+	}
+
+	void SoundBackendMixer::setMasterVolume(float volume) {
+		this->_mixer.setMasterVolume(volume);
+	}
+
+	void SoundBackendMixer::setListenerLocation(const rawrbox::Vector3f& location, const rawrbox::Vector3f& front, const rawrbox::Vector3f& up) {
+		this->_mixer.setListenerLocation(location, front, up);
+	}
+
+	std::shared_ptr<rawrbox::SoundInstance> SoundBackendMixer::createInstance(const rawrbox::SoundBase& sound) {
+		const auto& path = sound.getPath();
+		if (path.starts_with("http://") || path.starts_with("https://")) RAWRBOX_CRITICAL("HTTP sound '{}' can't be played by the mixer backend", path);
+
+		return std::make_shared<rawrbox::SoundInstanceMixer>(*this, this->loadClip(path), sound.getSample(), sound.getFlags());
+	}
+
+	std::shared_ptr<const rawrbox::AudioClip> SoundBackendMixer::loadClip(const std::filesystem::path& path) {
+		std::string pth = path.generic_string();
+
+		auto fnd = this->_clips.find(pth);
+		if (fnd != this->_clips.end()) return fnd->second;
+		if (!std::filesystem::exists(path)) RAWRBOX_CRITICAL("File '{}' not found!", pth);
+
+		HSTREAM stream = BASS_StreamCreateFile(0, pth.c_str(), 0, 0, BASS_STREAM_DECODE | BASS_SAMPLE_FLOAT);
+		if (stream == 0) rawrbox::BASSUtils::checkBASSError();
+
+		BASS_CHANNELINFO info = {};
+		BASS_ChannelGetInfo(stream, &info);
+		if (info.chans == 0 || info.chans > 2) {
+			BASS_StreamFree(stream);
+			RAWRBOX_CRITICAL("Sound '{}' has {} channels, the mixer only plays mono or stereo", pth, info.chans);
+		}
+
+		auto clip = std::make_shared<rawrbox::AudioClip>();
+		clip->channels = info.chans;
+		clip->sampleRate = info.freq;
+
+		QWORD length = BASS_ChannelGetLength(stream, BASS_POS_BYTE);
+		if (length != static_cast<QWORD>(-1)) clip->samples.reserve(static_cast<size_t>(length / sizeof(float)));
+
+		std::array<float, 4096> buffer = {};
+		while (true) {
+			DWORD read = BASS_ChannelGetData(stream, buffer.data(), static_cast<DWORD>(buffer.size() * sizeof(float)));
+			if (read == 0 || read == static_cast<DWORD>(-1)) break; // -1 once it ended
+
+			clip->samples.insert(clip->samples.end(), buffer.begin(), buffer.begin() + (read / sizeof(float)));
+		}
+
+		BASS_StreamFree(stream);
+
+		this->_clips[pth] = clip;
+		return clip;
+	}
+
+	void SoundBackendMixer::render(size_t frames) {
+		this->_mixer.render(*this->_sink, frames);
+	}
+
+	void SoundBackendMixer::bindVoice(uint32_t voice, rawrbox::SoundInstanceMixer* instance) {
+		this->_voices[voice] = instance;
+	}
+
+	void SoundBackendMixer::unbindVoice(uint32_t voice) {
+		this->_voices.erase(voice);
+	}
+
+	rawrbox::AudioMixer& SoundBackendMixer::getMixer() {
+		return this->_mixer;
+	}
+
+	rawrbox::AudioSink& SoundBackendMixer::getSink() {
+		return *this->_sink;
+	}
+} // namespace rawrbox
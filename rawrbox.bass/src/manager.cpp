@@ -20,7 +20,7 @@ namespace rawrbox {
 	bool BASS::_shutdown = false;
 	bool BASS::_muteOnUnfocus = true;
 	float BASS::_masterVolume = 1.F;
-	rawrbox::Vector3f BASS::_oldLocation = {};
+	std::unique_ptr<rawrbox::SoundBackendBase> BASS::_backend = nullptr;
 
 	// PUBLIC
 	std::unordered_map<std::string, std::unique_ptr<rawrbox::SoundBase>> BASS::sounds = {};
@@ -74,13 +74,12 @@ namespace rawrbox {
 		auto fxVersion = HIWORD(BASS_FX_GetVersion());
 		if (fxVersion != BASSVERSION) RAWRBOX_CRITICAL("BASS Version missmatch! FX [{}] | BASS [{}]", fxVersion, BASSVERSION);
 
-		_initialized = (BASS_Init(-1, 44100, BASS_DEVICE_3D, nullptr, nullptr) != 0);
+		if (_backend == nullptr) _backend = std::make_unique<rawrbox::SoundBackendBASS>();
+
+		_initialized = _backend->initialize();
 		if (_initialized) {
 			_logger->info("Initialized BASS [{}] and BASS_FX [{}]", fxVersion, BASSVERSION);
-
-			BASS_Start();
-			BASS_Set3DFactors(1.0F, 10.0F, 1.0F);
-			BASS_Apply3D();
+			_backend->setMasterVolume(_masterVolume); // Set before initialize
 		} else {
 			RAWRBOX_CRITICAL("BASS initialize error: {}", BASS_ErrorGetCode());
 		}
@@ -91,7 +90,8 @@ namespace rawrbox {
 		_shutdown = true;
 
 		sounds.clear();
-		BASS_Free();
+		_backend->shutdown();
+		_backend.reset();
 
 		_initialized = false;
 
@@ -136,7 +136,7 @@ namespace rawrbox {
 			BASS_FX_BPM_CallbackSet(sample, std::bit_cast<BPMPROC*>(&soundBPM), 1, 0, 0, nullptr);
 		}
 
-		sounds[pth] = std::make_unique<rawrbox::SoundBase>(sample, 0, flags, shouldStream);
+		sounds[pth] = std::make_unique<rawrbox::SoundBase>(sample, 0, flags, shouldStream, pth);
 		return sounds[pth].get();
 	}
 
@@ -171,7 +171,7 @@ namespace rawrbox {
 			BASS_FX_BPM_CallbackSet(sampleStreamed, std::bit_cast<BPMPROC*>(&soundBPM), 1, 0, 0, nullptr);
 		}
 
-		sounds[url] = std::make_unique<rawrbox::SoundBase>(sampleStreamed, 0, flags, true);
+		sounds[url] = std::make_unique<rawrbox::SoundBase>(sampleStreamed, 0, flags, true, url);
 		return sounds[url].get();
 	}
 	// ----
@@ -185,10 +185,9 @@ namespace rawrbox {
 	void BASS::setMasterVolume(float volume, bool set) {
 		volume = std::clamp(volume, 0.F, 1.F);
 		if (set) _masterVolume = volume;
+		if (!_initialized) return;
 
-		BASS_SetConfig(BASS_CONFIG_GVOL_MUSIC, static_cast<DWORD>(volume * 10000));
-		BASS_SetConfig(BASS_CONFIG_GVOL_SAMPLE, static_cast<DWORD>(volume * 10000));
-		BASS_SetConfig(BASS_CONFIG_GVOL_STREAM, static_cast<DWORD>(volume * 10000));
+		_backend->setMasterVolume(volume);
 	}
 
 	void BASS::setMuteOnUnfocus(bool set) {
@@ -202,16 +201,7 @@ namespace rawrbox {
 	void BASS::setListenerLocation(const rawrbox::Vector3f& location, const rawrbox::Vector3f& front, const rawrbox::Vector3f& up) {
 		if (!_initialized) return;
 
-		auto velo = location - _oldLocation;
-		_oldLocation = location;
-
-		BASS_3DVECTOR Bass_Player = {location.x, location.y, location.z};
-		BASS_3DVECTOR Bass_Front = {front.x, front.y, front.z};
-		BASS_3DVECTOR Bass_Top = {up.x, up.y, up.z};
-		BASS_3DVECTOR Bass_Velocity = {velo.x, velo.y, velo.z};
-
-		BASS_Set3DPosition(&Bass_Player, &Bass_Velocity, &Bass_Front, &Bass_Top);
-		BASS_Apply3D();
+		_backend->setListenerLocation(location, front, up);
 	}
 
 } // namespace rawrbox
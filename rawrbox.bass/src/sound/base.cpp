@@ -1,3 +1,4 @@
+#include <rawrbox/bass/manager.hpp>
 #include <rawrbox/bass/sound/base.hpp>
 
 #include <bass.h>
@@ -7,7 +8,7 @@
 #include <memory>
 
 namespace rawrbox {
-	SoundBase::SoundBase(uint32_t sample, uint32_t fx, uint32_t flags, bool stream) : _sample(sample), _fxSample(fx), _flags(flags), _isStream(stream) {}
+	SoundBase::SoundBase(uint32_t sample, uint32_t fx, uint32_t flags, bool stream, std::string path) : _sample(sample), _fxSample(fx), _flags(flags), _isStream(stream), _path(std::move(path)) {}
 	SoundBase::~SoundBase() {
 		this->_instances.clear();
 
@@ -24,10 +25,12 @@ namespace rawrbox {
 
 	std::shared_ptr<rawrbox::SoundInstance> SoundBase::createInstance() {
 		if (!this->isValid()) RAWRBOX_CRITICAL("Sound sample not valid!");
-		auto ptr = std::make_shared<rawrbox::SoundInstance>(this->_sample, this->_isStream, this->_flags);
 
-		this->_instances.push_back(std::move(ptr));
-		return this->_instances.front();
+		auto* backend = rawrbox::BASS::getBackend();
+		if (backend == nullptr) RAWRBOX_CRITICAL("BASS not initialized!");
+
+		this->_instances.push_back(backend->createInstance(*this));
+		return this->_instances.back();
 	}
 
 	std::shared_ptr<rawrbox::SoundInstance> SoundBase::getInstance(size_t i) {
@@ -47,4 +50,16 @@ namespace rawrbox {
 		return this->_fxSample;
 	}
 
+	uint32_t SoundBase::getFlags() const {
+		return this->_flags;
+	}
+
+	bool SoundBase::isStream() const {
+		return this->_isStream;
+	}
+
+	const std::string& SoundBase::getPath() const {
+		return this->_path;
+	}
+
 } // namespace rawrbox
@@ -0,0 +1,124 @@
+#include <rawrbox/bass/backends/mixer.hpp>
+#include <rawrbox/bass/sound/instance_mixer.hpp>
+
+#include <algorithm>
+
+namespace rawrbox {
+	SoundInstanceMixer::SoundInstanceMixer(rawrbox::SoundBackendMixer& backend, std::shared_ptr<const rawrbox::AudioClip> clip, uint32_t audioSample, uint32_t flags) : rawrbox::SoundInstance(audioSample, false, flags), _backend(&backend), _clip(std::move(clip)) {
+		if (this->_clip == nullptr) RAWRBOX_CRITICAL("Invalid audio clip");
+	}
+
+	SoundInstanceMixer::~SoundInstanceMixer() {
+		this->stop();
+	}
+
+	rawrbox::AudioMixer& SoundInstanceMixer::getMixer() const {
+		return this->_backend->getMixer();
+	}
+
+	void SoundInstanceMixer::play() {
+		if (this->isPaused()) {
+			this->getMixer().setPaused(this->_voice, false);
+			return;
+		}
+
+		this->stop(); // Restart, a mixer voice can't be played twice
+
+		rawrbox::AudioVoiceSettings settings = {};
+		settings.volume = this->_volume;
+		settings.pitch = this->_tempo;
+		settings.looping = this->_looping;
+
+		if (this->is3D()) {
+			settings.position = this->_location;
+
+			if (this->_maxDistance > 0.F) { // Not set, keep the mixer ones
+				settings.minDistance = this->_minDistance;
+				settings.maxDistance = this->_maxDistance;
+			}
+		}
+
+		this->_voice = this->getMixer().play(this->_clip, settings);
+		if (this->_seek > 0.0) this->getMixer().seek(this->_voice, this->_seek);
+
+		this->_backend->bindVoice(this->_voice, this);
+	}
+
+	void SoundInstanceMixer::stop() {
+		if (this->_voice == 0) return;
+
+		this->getMixer().stop(this->_voice);
+		this->_backend->unbindVoice(this->_voice);
+		this->_voice = 0;
+	}
+
+	void SoundInstanceMixer::pause() {
+		if (!this->isCreated()) return;
+		this->getMixer().setPaused(this->_voice, true);
+	}
+
+	// UTILS ----
+	uint32_t SoundInstanceMixer::id() const {
+		return this->_voice;
+	}
+
+	bool SoundInstanceMixer::isCreated() const {
+		return this->_voice != 0 && (this->getMixer().isPlaying(this->_voice) || this->getMixer().isPaused(this->_voice));
+	}
+
+	double SoundInstanceMixer::getSeek() const {
+		return this->getMixer().getSeek(this->_voice); // 0 if it's done
+	}
+
+	bool SoundInstanceMixer::isPlaying() const {
+		return this->_voice != 0 && this->getMixer().isPlaying(this->_voice);
+	}
+
+	bool SoundInstanceMixer::isPaused() const {
+		return this->_voice != 0 && this->getMixer().isPaused(this->_voice);
+	}
+
+	bool SoundInstanceMixer::isHTTPStream() const {
+		return false;
+	}
+
+	std::vector<float> SoundInstanceMixer::getFFT(int /*bass_length*/) const {
+		return {};
+	}
+	// --------------
+
+	void SoundInstanceMixer::setBeatSettings(float /*bandwidth*/, float /*center_freq*/, float /*release_time*/) {
+		RAWRBOX_CRITICAL("Beat detection is not supported by the mixer backend!");
+	}
+
+	void SoundInstanceMixer::setVolume(float volume) {
+		this->_volume = volume;
+		this->getMixer().setVolume(this->_voice, volume);
+	}
+
+	void SoundInstanceMixer::setTempo(float tempo) {
+		this->_tempo = std::clamp(tempo, 0.01F, 2.F);
+		this->getMixer().setPitch(this->_voice, this->_tempo);
+	}
+
+	void SoundInstanceMixer::seek(double seek) {
+		this->_seek = seek;
+		this->getMixer().seek(this->_voice, seek);
+	}
+
+	void SoundInstanceMixer::setLooping(bool loop) {
+		this->_looping = loop;
+		this->getMixer().setLooping(this->_voice, loop);
+	}
+
+	void SoundInstanceMixer::setPosition(const rawrbox::Vector3f& pos) {
+		this->_location = pos;
+		if (this->is3D()) this->getMixer().setPosition(this->_voice, pos);
+	}
+
+	void SoundInstanceMixer::set3D(float maxDistance, float minDistance) {
+		this->_maxDistance = maxDistance;
+		this->_minDistance = minDistance;
+		if (this->is3D()) this->getMixer().setDistance(this->_voice, minDistance, maxDistance);
+	}
+} // namespace rawrbox
@@ -0,0 +1,71 @@
+#include <rawrbox/bass/backends/mixer.hpp>
+#include <rawrbox/bass/manager.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <memory>
+
+// SoundBackendBASS needs an audio device, only the mixer backend is tested here
+TEST_CASE("SoundBackendMixer should behave as expected", "[rawrbox::SoundBackendMixer]") {
+	using Catch::Matchers::WithinAbs;
+
+	// No sections, BASS can only be initialized once
+	auto* backend = rawrbox::BASS::setBackend<rawrbox::SoundBackendMixer>();
+	rawrbox::BASS::initialize();
+	REQUIRE(rawrbox::BASS::getBackend() == backend);
+
+	auto& mixer = backend->getMixer();
+	auto* sound = rawrbox::BASS::loadSound("./assets/sounds/error.ogg");
+	REQUIRE(sound->getPath() == "./assets/sounds/error.ogg");
+
+	// Instances are made by the backend, and play as mixer voices
+	auto instance = sound->createInstance();
+	REQUIRE(dynamic_cast<rawrbox::SoundInstanceMixer*>(instance.get()) != nullptr);
+	REQUIRE(sound->getInstance(0) == instance);
+	REQUIRE(sound->createInstance() != instance); // The new one, not the first
+	REQUIRE_FALSE(instance->isCreated());
+
+	instance->setVolume(0.5F);
+	instance->play();
+	REQUIRE(instance->isCreated());
+	REQUIRE(instance->isPlaying());
+	REQUIRE(mixer.getVoiceCount() == 1);
+
+	const auto first = instance->id();
+	backend->render(4410);
+	REQUIRE_THAT(instance->getSeek(), WithinAbs(0.1, 0.01));
+
+	instance->pause();
+	REQUIRE(instance->isPaused());
+	REQUIRE_FALSE(instance->isPlaying());
+
+	// Resumed, same voice
+	instance->play();
+	REQUIRE(instance->isPlaying());
+	REQUIRE(instance->id() == first);
+
+	// Played again, restarted on a new one
+	instance->stop();
+	REQUIRE_FALSE(instance->isCreated());
+	REQUIRE(mixer.getVoiceCount() == 0);
+
+	instance->play();
+	REQUIRE(instance->id() != first);
+	REQUIRE(mixer.getVoiceCount() == 1);
+
+	// Played until the end
+	int ended = 0;
+	instance->onEnd += [&ended]() { ended++; };
+
+	for (int i = 0; i < 1000 && ended == 0; i++) {
+		backend->render(4410);
+	}
+
+	REQUIRE(ended == 1);
+	REQUIRE_FALSE(instance->isCreated());
+	REQUIRE(mixer.getVoiceCount() == 0);
+
+	instance.reset(); // Kept by the sound, freed on shutdown
+	rawrbox::BASS::shutdown();
+}
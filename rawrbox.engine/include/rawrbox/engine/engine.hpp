@@ -1,10 +1,13 @@
 #pragma once
 
+#include <rawrbox/engine/pacer.hpp>
 #include <rawrbox/engine/watch.hpp>
 #include <rawrbox/utils/logger.hpp>
 
 #include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 
 namespace rawrbox {
 	enum class ENGINE_THREADS {
@@ -24,8 +27,12 @@ namespace rawrbox {
 		std::unique_ptr<rawrbox::Logger> _logger = std::make_unique<rawrbox::Logger>("RawrBox-Engine");
 
 		rawrbox::Watch _timer;
+		rawrbox::FramePacer _pacer;
 
-		// Quick sleep from https://github.com/turanszkij/WickedEngine/blob/master/WickedEngine/wiHelper.cpp#L1622
+		std::mutex _inputLock;
+		std::condition_variable _inputWake;
+
+		// Sleeps most of it, and only spins the last few microseconds
 		virtual void sleep(float milliseconds);
 
 		// Create the GLFW window
@@ -33,7 +40,10 @@ namespace rawrbox {
 
 		// Initialize your game
 		virtual void init();
+		// Called in a loop on the input thread, it should block until there are events. Without a window it just waits for the shutdown
 		virtual void pollEvents();
+		// Unblocks pollEvents, so the input thread can see the shutdown
+		virtual void wakeInput();
 		virtual void fixedUpdate();
 		virtual void update();
 		virtual void draw();
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace rawrbox {
+	// Sleeps to absolute deadlines, only spinning for the last part (the OS oversleep, calibrated once on startup)
+	class FramePacer {
+	public:
+		using Clock = std::chrono::steady_clock;
+
+	protected:
+		static std::atomic<int64_t> _spinThreshold; // ns, 0 = not calibrated
+
+		Clock::duration _period = Clock::duration::zero();
+		Clock::time_point _next = {};
+
+	public:
+		// Measures how much the OS oversleeps. Called by the first wait, can be called again if the system changes
+		static void calibrate();
+		[[nodiscard]] static std::chrono::nanoseconds getSpinThreshold();
+
+		static void sleepUntil(Clock::time_point deadline);
+		static void sleepFor(Clock::duration duration);
+
+		// 0 = no limit
+		void setRate(uint32_t perSecond);
+		[[nodiscard]] Clock::duration getPeriod() const;
+
+		// Blocks until the next frame's deadline. Deadlines don't drift, but if it fell behind more than a frame it starts again from now
+		void wait();
+		void reset();
+	};
+} // namespace rawrbox
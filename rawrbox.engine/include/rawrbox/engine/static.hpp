@@ -10,6 +10,8 @@ namespace rawrbox {
 	extern std::thread::id RENDER_THREAD_ID;
 	extern std::queue<std::function<void()>> RENDER_THREAD_INVOKES;
 	extern std::mutex RENDER_THREAD_LOCK;
+
+	extern std::function<void()> INPUT_THREAD_WAKEUP; // Set by the window backend, unblocks its event wait
 	// -----
 
 	// TIMING ---
@@ -1,5 +1,6 @@
 #include <rawrbox/engine/engine.hpp>
 #include <rawrbox/engine/static.hpp>
+#include <rawrbox/utils/profiler.hpp>
 #include <rawrbox/utils/thread_utils.hpp>
 #include <rawrbox/utils/threading.hpp>
 #include <rawrbox/utils/timer.hpp>
@@ -13,22 +14,25 @@
 namespace rawrbox {
 	// INTERNAL ---
 	void Engine::sleep(float milliseconds) {
-		const std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
-		const double seconds = double(milliseconds) / 1000.0;
-		const int sleep_millisec_accuracy = 1;
-		const double sleep_sec_accuracy = double(sleep_millisec_accuracy) / 1000.0;
-
-		while (std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::high_resolution_clock::now() - t1).count() < seconds) {
-			if (seconds - (std::chrono::high_resolution_clock::now() - t1).count() > sleep_sec_accuracy) {
-				std::this_thread::sleep_for(std::chrono::milliseconds(sleep_millisec_accuracy));
-			}
-		}
+		rawrbox::FramePacer::sleepFor(std::chrono::duration_cast<rawrbox::FramePacer::Clock::duration>(std::chrono::duration<float, std::milli>(milliseconds)));
 	}
 
 	// Create the GLFW window
 	void Engine::setupGLFW() { RAWRBOX_CRITICAL("Method 'setupGLFW' not implemented"); }
 	void Engine::init() {}
-	void Engine::pollEvents() {}
+	void Engine::pollEvents() {
+		std::unique_lock<std::mutex> lock(this->_inputLock);
+		this->_inputWake.wait(lock, [this]() { return this->_shutdown == ENGINE_THREADS::THREAD_INPUT; });
+	}
+
+	void Engine::wakeInput() {
+		{
+			const std::lock_guard<std::mutex> lock(this->_inputLock); // So it can't miss it between checking and waiting
+		}
+
+		this->_inputWake.notify_all();
+		if (rawrbox::INPUT_THREAD_WAKEUP != nullptr) rawrbox::INPUT_THREAD_WAKEUP();
+	}
 	void Engine::fixedUpdate() {}
 	void Engine::update() {}
 	void Engine::draw() {}
@@ -58,17 +62,27 @@ namespace rawrbox {
 			this->init();
 			// ---------
 
+			this->_pacer.setRate(this->_fps);
+			this->_pacer.reset();
+			this->_timer.record_elapsed_seconds();
+
 			while (this->_shutdown != ENGINE_THREADS::THREAD_RENDER) {
+				{
+					RAWRBOX_PROFILE_ZONE("Engine::wait");
+					this->_pacer.setRate(this->_fps);
+					this->_pacer.wait();
+				}
+
 				rawrbox::DELTA_TIME = static_cast<float>(std::max(0.0, this->_timer.record_elapsed_seconds()));
 
-				const float target_deltaTime = 1.0F / this->_fps;
-				if (rawrbox::DELTA_TIME < target_deltaTime) {
-					sleep((target_deltaTime - rawrbox::DELTA_TIME) * 1000);
-					rawrbox::DELTA_TIME += static_cast<float>(std::max(0.0, this->_timer.record_elapsed_seconds()));
-				}
+				RAWRBOX_PROFILE_FRAME();
+				RAWRBOX_PROFILE_COUNTER("Frame time (ms)", rawrbox::DELTA_TIME * 1000.F);
 
 				// THREADING ----
-				rawrbox::___runThreadInvokes();
+				{
+					RAWRBOX_PROFILE_ZONE("Engine::invokes");
+					rawrbox::___runThreadInvokes();
+				}
 				// -------
 
 				// Fixed time update --------
@@ -79,7 +93,10 @@ namespace rawrbox {
 				rawrbox::FIXED_DELTA_TIME = targetFrameRateInv;
 
 				while (this->_deltaTimeAccumulator >= targetFrameRateInv) {
-					this->fixedUpdate();
+					{
+						RAWRBOX_PROFILE_ZONE("Engine::fixedUpdate");
+						this->fixedUpdate();
+					}
 
 					this->_deltaTimeAccumulator -= targetFrameRateInv;
 					if (this->_shutdown != ENGINE_THREADS::NONE) break;
@@ -89,13 +106,23 @@ namespace rawrbox {
 				// ---------------------------
 
 				// VARIABLE-TIME
-				rawrbox::TIMER::update();
-				this->update();
+				{
+					RAWRBOX_PROFILE_ZONE("TIMER::update");
+					rawrbox::TIMER::update();
+				}
+
+				{
+					RAWRBOX_PROFILE_ZONE("Engine::update");
+					this->update();
+				}
 				// ----
 
 				// ACTUAL DRAWING
 				rawrbox::FRAME_ALPHA = this->_deltaTimeAccumulator / rawrbox::DELTA_TIME;
-				this->draw();
+				{
+					RAWRBOX_PROFILE_ZONE("Engine::draw");
+					this->draw();
+				}
 				// ----------
 			}
 
@@ -104,6 +131,7 @@ namespace rawrbox {
 
 			this->onThreadShutdown(rawrbox::ENGINE_THREADS::THREAD_RENDER);
 			this->_shutdown = rawrbox::ENGINE_THREADS::THREAD_INPUT; // Done killing rendering, now destroy glfw
+			this->wakeInput();
 		});
 		// ----
 
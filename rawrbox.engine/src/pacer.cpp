@@ -0,0 +1,95 @@
+#include <rawrbox/engine/pacer.hpp>
+
+#ifdef __linux__
+	#include <cerrno>
+	#include <ctime>
+#endif
+
+#include <algorithm>
+#include <thread>
+
+namespace rawrbox {
+	namespace {
+		constexpr std::chrono::nanoseconds MIN_SPIN = std::chrono::microseconds(20);
+		constexpr std::chrono::nanoseconds MAX_SPIN = std::chrono::milliseconds(4);
+		constexpr std::chrono::nanoseconds DEFAULT_SPIN = std::chrono::milliseconds(2); // Until calibrated
+
+		void osSleepUntil(FramePacer::Clock::time_point deadline) {
+#ifdef __linux__
+			// steady_clock is CLOCK_MONOTONIC, an absolute deadline doesn't add the wake up latency of every call
+			const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+
+			timespec ts = {};
+			ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+			ts.tv_nsec = static_cast<long>(ns % 1000000000);
+
+			while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+			}
+#else
+			std::this_thread::sleep_until(deadline);
+#endif
+		}
+	} // namespace
+
+	std::atomic<int64_t> FramePacer::_spinThreshold = 0;
+
+	void FramePacer::calibrate() {
+		constexpr int samples = 16;
+		constexpr auto request = std::chrono::microseconds(500);
+
+		auto worst = std::chrono::nanoseconds::zero();
+		for (int i = 0; i < samples; i++) {
+			const auto start = Clock::now();
+			osSleepUntil(start + request);
+
+			worst = std::max(worst, std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start - request));
+		}
+
+		_spinThreshold = std::clamp(worst + worst / 4, MIN_SPIN, MAX_SPIN).count(); // Some margin over the worst seen
+	}
+
+	std::chrono::nanoseconds FramePacer::getSpinThreshold() {
+		const int64_t threshold = _spinThreshold.load(std::memory_order_relaxed);
+		return threshold == 0 ? DEFAULT_SPIN : std::chrono::nanoseconds(threshold);
+	}
+
+	void FramePacer::sleepUntil(Clock::time_point deadline) {
+		const auto wake = deadline - getSpinThreshold();
+		if (Clock::now() < wake) osSleepUntil(wake);
+
+		while (Clock::now() < deadline) {
+			std::this_thread::yield();
+		}
+	}
+
+	void FramePacer::sleepFor(Clock::duration duration) {
+		sleepUntil(Clock::now() + duration);
+	}
+
+	void FramePacer::setRate(uint32_t perSecond) {
+		const auto period = perSecond == 0 ? Clock::duration::zero() : std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / perSecond));
+		if (period == this->_period) return;
+
+		this->_period = period;
+		this->reset();
+	}
+
+	FramePacer::Clock::duration FramePacer::getPeriod() const { return this->_period; }
+
+	void FramePacer::wait() {
+		if (_spinThreshold.load(std::memory_order_relaxed) == 0) calibrate();
+		if (this->_period == Clock::duration::zero()) return;
+
+		const auto now = Clock::now();
+		if (this->_next == Clock::time_point{} || now > this->_next + this->_period) {
+			this->_next = now + this->_period; // First frame, or too far behind to catch up
+		}
+
+		sleepUntil(this->_next);
+		this->_next += this->_period;
+	}
+
+	void FramePacer::reset() {
+		this->_next = {};
+	}
+} // namespace rawrbox
@@ -9,6 +9,8 @@ namespace rawrbox {
 	std::thread::id RENDER_THREAD_ID;
 	std::queue<std::function<void()>> RENDER_THREAD_INVOKES = {};
 	std::mutex RENDER_THREAD_LOCK;
+
+	std::function<void()> INPUT_THREAD_WAKEUP = nullptr;
 	// -------
 
 } // namespace rawrbox
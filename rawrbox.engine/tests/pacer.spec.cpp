@@ -0,0 +1,138 @@
+#include <rawrbox/engine/pacer.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+namespace {
+	struct FrameStats {
+		double meanMs = 0.0;
+		double jitterMs = 0.0; // Standard deviation of the frame time
+		double worstMs = 0.0;
+		double cpu = 0.0;      // Cores used, process wide
+	};
+
+	// The old Engine::sleep, spins on the clock with 1ms sleeps
+	void legacySleep(float milliseconds) {
+		const auto t1 = std::chrono::high_resolution_clock::now();
+		const double seconds = double(milliseconds) / 1000.0;
+
+		while (std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::high_resolution_clock::now() - t1).count() < seconds) {
+			if (seconds - (std::chrono::high_resolution_clock::now() - t1).count() > 0.001) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+		}
+	}
+
+	template <typename Wait>
+	FrameStats measure(std::chrono::milliseconds duration, Wait&& wait) {
+		std::vector<double> frames = {};
+
+		const auto start = std::chrono::steady_clock::now();
+		const auto cpuStart = std::clock();
+
+		wait(); // The first one can calibrate
+
+		auto last = std::chrono::steady_clock::now();
+		while (last - start < duration) {
+			wait();
+
+			const auto now = std::chrono::steady_clock::now();
+			frames.push_back(std::chrono::duration<double, std::milli>(now - last).count());
+			last = now;
+		}
+
+		const double wall = std::chrono::duration<double>(last - start).count();
+		const double cpu = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+		FrameStats stats = {};
+		for (double frame : frames) {
+			stats.meanMs += frame;
+			stats.worstMs = std::max(stats.worstMs, frame);
+		}
+		stats.meanMs /= static_cast<double>(frames.size());
+
+		for (double frame : frames)
+			stats.jitterMs += (frame - stats.meanMs) * (frame - stats.meanMs);
+		stats.jitterMs = std::sqrt(stats.jitterMs / static_cast<double>(frames.size()));
+
+		stats.cpu = cpu / wall;
+		return stats;
+	}
+} // namespace
+
+TEST_CASE("FramePacer should behave as expected", "[rawrbox::FramePacer]") {
+	SECTION("rawrbox::FramePacer::calibrate") {
+		rawrbox::FramePacer::calibrate();
+
+		auto threshold = rawrbox::FramePacer::getSpinThreshold();
+		REQUIRE(threshold >= std::chrono::microseconds(20));
+		REQUIRE(threshold <= std::chrono::milliseconds(4));
+	}
+
+	SECTION("rawrbox::FramePacer::sleepUntil") {
+		const auto deadline = rawrbox::FramePacer::Clock::now() + std::chrono::milliseconds(5);
+		rawrbox::FramePacer::sleepUntil(deadline);
+
+		REQUIRE(rawrbox::FramePacer::Clock::now() >= deadline); // Never early
+	}
+
+	SECTION("rawrbox::FramePacer::wait") {
+		rawrbox::FramePacer pacer;
+		pacer.setRate(100);
+
+		auto stats = measure(std::chrono::milliseconds(1000), [&pacer]() { pacer.wait(); });
+		REQUIRE(std::abs(stats.meanMs - 10.0) < 0.5);
+
+#ifndef _WIN32 // std::clock is wall time on windows
+		REQUIRE(stats.cpu < 0.5); // Mostly sleeping, the old pacing used a whole core
+#endif
+	}
+
+	SECTION("rawrbox::FramePacer behind") {
+		rawrbox::FramePacer pacer;
+		pacer.setRate(100);
+		pacer.wait();
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(50)); // Long frame, doesn't try to catch up with 5 quick ones
+
+		const auto start = rawrbox::FramePacer::Clock::now();
+		pacer.wait();
+		pacer.wait();
+
+		REQUIRE(rawrbox::FramePacer::Clock::now() - start >= std::chrono::milliseconds(19));
+	}
+}
+
+TEST_CASE("FramePacer benchmark", "[rawrbox::FramePacer][.benchmark]") {
+	constexpr auto duration = std::chrono::seconds(10);
+	constexpr float frameMs = 1000.F / 60.F;
+
+	rawrbox::FramePacer pacer;
+	pacer.setRate(60);
+
+	auto paced = measure(duration, [&pacer]() { pacer.wait(); });
+
+	// Same loop as the old engine, sleeping whatever is left of the frame
+	auto lastFrame = std::chrono::steady_clock::now();
+	auto legacy = measure(duration, [&lastFrame, frameMs]() {
+		const float elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - lastFrame).count();
+		if (elapsed < frameMs) legacySleep(frameMs - elapsed);
+
+		lastFrame = std::chrono::steady_clock::now();
+	});
+
+	fmt::print("\n60 fps, {}s each (spin threshold {}us)\n", duration.count(), std::chrono::duration_cast<std::chrono::microseconds>(rawrbox::FramePacer::getSpinThreshold()).count());
+	fmt::print("  pacer  : mean {:.3f}ms, jitter {:.3f}ms, worst {:.3f}ms, cpu {:.1f}%\n", paced.meanMs, paced.jitterMs, paced.worstMs, paced.cpu * 100.0);
+	fmt::print("  legacy : mean {:.3f}ms, jitter {:.3f}ms, worst {:.3f}ms, cpu {:.1f}%\n", legacy.meanMs, legacy.jitterMs, legacy.worstMs, legacy.cpu * 100.0);
+
+#ifndef _WIN32
+	REQUIRE(paced.cpu < legacy.cpu);
+#endif
+}
@@ -57,7 +57,7 @@ namespace rawrbox {
 		}
 
 		void loadBlendShapes(const rawrbox::GLTFImporter& model) {
-			this->_blend_shapes.clear();
+			this->clearBlendShapes();
 
 			for (size_t i = 0; i < model.meshes.size(); i++) {
 				const auto& mesh = model.meshes[i];
@@ -65,8 +65,7 @@ namespace rawrbox {
 				for (const auto& primitive : mesh->primitives) {
 					for (const auto& blend : primitive.blendShapes) {
 						auto s = std::make_unique<rawrbox::BlendShapes<M>>();
-						s->normals = blend.norms;
-						s->pos = blend.pos;
+						s->setDeltas(blend.pos, blend.norms); // glTF morph targets are displacements
 						s->weight = blend.weight;
 
 						s->mesh = this->_meshes[i].get();
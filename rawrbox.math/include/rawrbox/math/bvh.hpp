@@ -0,0 +1,69 @@
+#pragma once
+
+#include <rawrbox/math/bbox.hpp>
+#include <rawrbox/math/frustum.hpp>
+#include <rawrbox/math/ray.hpp>
+#include <rawrbox/math/vector3.hpp>
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace rawrbox {
+	struct BVHNode {
+		rawrbox::Vector3f min = {};
+		rawrbox::Vector3f max = {};
+
+		uint32_t left = 0;  // First child, the second one is left + 1. 0 = leaf (the root is never a child)
+		uint32_t first = 0; // Items of the whole subtree are [first, first + count) on the BVH indices
+		uint32_t count = 0;
+
+		[[nodiscard]] bool isLeaf() const { return this->left == 0; }
+		[[nodiscard]] rawrbox::BBOX getBBOX() const { return {this->min, this->max, this->max - this->min}; }
+	};
+
+	// Bounding volume hierarchy over a list of boxes, queries return the box indices
+	class BVH {
+	protected:
+		std::vector<rawrbox::BVHNode> _nodes = {};
+		std::vector<uint32_t> _indices = {};
+		std::vector<rawrbox::Vector3f> _centers = {}; // Only used while building
+
+		// Item boxes as center / extent, in the same order as the indices. Leaves test their items in one batch
+		std::array<std::vector<float>, 3> _itemCenter = {};
+		std::array<std::vector<float>, 3> _itemExtent = {};
+
+		uint32_t _leafSize = 8;
+
+		void subdivide(uint32_t root);
+		void updateBounds(uint32_t node, const std::vector<rawrbox::BBOX>& boxes);
+		void updateItems(const std::vector<rawrbox::BBOX>& boxes);
+		void updateNodes(const std::vector<rawrbox::BBOX>& boxes);
+
+	public:
+		BVH() = default;
+		explicit BVH(uint32_t leafSize);
+
+		// Median split on the longest axis, O(n log n)
+		void build(const std::vector<rawrbox::BBOX>& boxes);
+		// Same boxes (count and order) that moved, keeps the tree and only grows / shrinks the nodes
+		void refit(const std::vector<rawrbox::BBOX>& boxes);
+		void clear();
+
+		// Appends the indices of the boxes touching the frustum, subtrees fully inside are added without testing each box
+		void query(const rawrbox::Frustum& frustum, std::vector<uint32_t>& out) const;
+		void query(const rawrbox::Frustum& frustum, uint32_t node, std::vector<uint32_t>& out) const;
+		void query(const rawrbox::BBOX& bbox, std::vector<uint32_t>& out) const;
+		// Appends the boxes the ray goes through, with the distance it enters them at (unsorted)
+		void query(const rawrbox::Ray& ray, float maxDistance, std::vector<std::pair<float, uint32_t>>& out) const;
+
+		// Splits the tree into at least count (if it has enough nodes) independent subtrees, to query them in parallel
+		[[nodiscard]] std::vector<uint32_t> getSubtrees(size_t count) const;
+
+		[[nodiscard]] const std::vector<rawrbox::BVHNode>& getNodes() const;
+		[[nodiscard]] const std::vector<uint32_t>& getIndices() const;
+		[[nodiscard]] size_t size() const;
+		[[nodiscard]] bool empty() const;
+	};
+} // namespace rawrbox
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <rawrbox/math/bbox.hpp>
+#include <rawrbox/math/matrix4x4.hpp>
+#include <rawrbox/math/vector3.hpp>
+#include <rawrbox/math/vector4.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace rawrbox {
+	enum class FrustumTest : uint8_t {
+		OUTSIDE = 0,
+		INTERSECTS,
+		INSIDE
+	};
+
+	// View frustum planes (xyz = normal pointing inside, w = distance), extracted from a view-projection matrix
+	class Frustum {
+	protected:
+		std::array<rawrbox::Vector4f, 6> _planes = {};
+
+	public:
+		Frustum() = default;
+		explicit Frustum(const rawrbox::Matrix4x4& viewProj);
+
+		void update(const rawrbox::Matrix4x4& viewProj);
+
+		[[nodiscard]] bool containsPoint(const rawrbox::Vector3f& pos) const;
+		[[nodiscard]] bool containsSphere(const rawrbox::Vector3f& center, float radius) const;
+		[[nodiscard]] bool containsBBOX(const rawrbox::BBOX& bbox) const;
+		// Like containsBBOX, but also tells if it's fully inside (so its children don't need testing)
+		[[nodiscard]] rawrbox::FrustumTest testBBOX(const rawrbox::BBOX& bbox) const;
+
+		// Batched tests over structure of arrays, visible[i] is set to 1 or 0
+		// Branchless per element, so the compiler vectorizes them (SSE / AVX / NEON, whatever the target has)
+		void cullSpheres(const float* x, const float* y, const float* z, const float* radius, size_t count, uint8_t* visible) const;
+		void cullBoxes(const float* centerX, const float* centerY, const float* centerZ, const float* extentX, const float* extentY, const float* extentZ, size_t count, uint8_t* visible) const;
+
+		[[nodiscard]] const std::array<rawrbox::Vector4f, 6>& getPlanes() const;
+	};
+} // namespace rawrbox
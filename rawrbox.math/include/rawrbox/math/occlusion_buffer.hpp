@@ -0,0 +1,42 @@
+#pragma once
+
+#include <rawrbox/math/bbox.hpp>
+#include <rawrbox/math/matrix4x4.hpp>
+#include <rawrbox/math/vector4.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace rawrbox {
+	// Small CPU depth buffer. Big occluders are rasterized into it, then boxes behind them can be skipped
+	// Depth is clip z / w, smaller = closer. Anything crossing the near plane is never an occluder and always visible
+	class OcclusionBuffer {
+	protected:
+		uint32_t _width = 0;
+		uint32_t _height = 0;
+
+		std::vector<float> _depth = {};
+		rawrbox::Matrix4x4 _viewProj = {};
+
+		// Corners in screen space (x, y in pixels, z = depth). False if any is behind the camera
+		[[nodiscard]] bool project(const rawrbox::BBOX& bbox, std::array<rawrbox::Vector3f, 8>& out) const;
+		void rasterize(const rawrbox::Vector3f& a, const rawrbox::Vector3f& b, const rawrbox::Vector3f& c);
+
+	public:
+		OcclusionBuffer() = default;
+		OcclusionBuffer(uint32_t width, uint32_t height);
+
+		void resize(uint32_t width, uint32_t height);
+
+		// Clears the depth, call once per camera before adding occluders
+		void begin(const rawrbox::Matrix4x4& viewProj);
+
+		void addOccluder(const rawrbox::BBOX& bbox);
+		[[nodiscard]] bool isVisible(const rawrbox::BBOX& bbox) const;
+
+		[[nodiscard]] uint32_t getWidth() const;
+		[[nodiscard]] uint32_t getHeight() const;
+		[[nodiscard]] const std::vector<float>& getDepth() const;
+	};
+} // namespace rawrbox
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <rawrbox/math/bbox.hpp>
+#include <rawrbox/math/matrix4x4.hpp>
+#include <rawrbox/math/vector2.hpp>
+#include <rawrbox/math/vector3.hpp>
+
+#include <cstdint>
+#include <limits>
+
+namespace rawrbox {
+	struct RayHit {
+		float distance = std::numeric_limits<float>::max();
+		uint32_t triangle = 0;
+
+		// Barycentric, the hit point is a * (1 - u - v) + b * u + c * v
+		float u = 0.F;
+		float v = 0.F;
+
+		[[nodiscard]] bool valid() const { return this->distance != std::numeric_limits<float>::max(); }
+	};
+
+	class Ray {
+	protected:
+		rawrbox::Vector3f _origin = {};
+		rawrbox::Vector3f _dir = {0, 0, 1};
+		rawrbox::Vector3f _invDir = {}; // For the slab test, inf on axis the ray doesn't move on
+
+		void updateInverse();
+
+	public:
+		Ray() = default;
+		Ray(const rawrbox::Vector3f& origin, const rawrbox::Vector3f& dir);
+
+		// Through a screen pixel, viewProjInv is the inverse of the camera view-projection
+		[[nodiscard]] static rawrbox::Ray fromScreen(const rawrbox::Vector2f& screenPos, const rawrbox::Vector2f& screenSize, const rawrbox::Matrix4x4& viewProjInv);
+
+		[[nodiscard]] const rawrbox::Vector3f& getOrigin() const;
+		[[nodiscard]] const rawrbox::Vector3f& getDirection() const;
+		[[nodiscard]] const rawrbox::Vector3f& getInverseDirection() const;
+
+		[[nodiscard]] rawrbox::Vector3f at(float distance) const;
+
+		// Same ray in the space of the given matrix (ex: world -> model, with the inverse of the model matrix)
+		// Distances stay the same only if the matrix has no scale
+		[[nodiscard]] rawrbox::Ray transform(const rawrbox::Matrix4x4& matrix) const;
+
+		// Slab test, entry is the distance where the ray enters the box (0 if it starts inside)
+		[[nodiscard]] bool intersects(const rawrbox::Vector3f& min, const rawrbox::Vector3f& max, float maxDistance, float& entry) const;
+		[[nodiscard]] bool intersects(const rawrbox::BBOX& bbox, float maxDistance, float& entry) const;
+
+		// Möller–Trumbore, both sides
+		[[nodiscard]] bool intersects(const rawrbox::Vector3f& a, const rawrbox::Vector3f& b, const rawrbox::Vector3f& c, float maxDistance, float& distance, float& u, float& v) const;
+	};
+} // namespace rawrbox
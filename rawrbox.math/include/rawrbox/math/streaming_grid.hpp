@@ -0,0 +1,78 @@
+#pragma once
+
+#include <rawrbox/math/vector2.hpp>
+#include <rawrbox/math/vector3.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace rawrbox {
+	// Decides which cells of a world (on the XZ plane) should be loaded, around a set of activators (ex: players, cameras)
+	// Cells load within loadRadius and only unload past unloadRadius, so standing on the edge doesn't load / unload every tick
+	// At most budget cells load per update (closest first), unloading is never delayed
+	//
+	// grid.addCell(grid.getCell(pos));
+	// grid.setActivator(playerId, playerPos);
+	// grid.update(toLoad, toUnload);
+	class StreamingGrid {
+	protected:
+		float _cellSize = 0.F;
+		float _loadRadius = 0.F;
+		float _unloadRadius = 0.F;
+		size_t _budget = 0;
+
+		std::unordered_set<uint64_t> _cells = {};  // With content
+		std::unordered_set<uint64_t> _loaded = {}; // Subset of _cells
+		std::unordered_map<uint32_t, rawrbox::Vector3f> _activators = {};
+
+		// Scratch, kept between updates
+		std::vector<std::pair<float, uint64_t>> _candidates = {};
+
+		[[nodiscard]] float cellDistance(uint64_t key) const;
+
+	public:
+		StreamingGrid(float cellSize, float loadRadius, float unloadRadius, size_t budget = std::numeric_limits<size_t>::max());
+
+		[[nodiscard]] static uint64_t key(const rawrbox::Vector2i& cell);
+		[[nodiscard]] static rawrbox::Vector2i fromKey(uint64_t key);
+
+		[[nodiscard]] float getCellSize() const;
+		[[nodiscard]] float getLoadRadius() const;
+		[[nodiscard]] float getUnloadRadius() const;
+
+		[[nodiscard]] rawrbox::Vector2i getCell(const rawrbox::Vector3f& pos) const;
+		[[nodiscard]] rawrbox::Vector3f getCellCenter(const rawrbox::Vector2i& cell) const;
+
+		// CELLS ---
+		void addCell(const rawrbox::Vector2i& cell);
+		// If it was loaded, it is just forgotten (not returned as unloaded)
+		void removeCell(const rawrbox::Vector2i& cell);
+		// Undoes a load handed out by update (ex: it failed), the cell is offered again on the next update
+		void cancelLoad(const rawrbox::Vector2i& cell);
+
+		// Forgets every cell, without unloading them (see unloadAll)
+		void clear();
+
+		[[nodiscard]] bool hasCell(const rawrbox::Vector2i& cell) const;
+		[[nodiscard]] bool isLoaded(const rawrbox::Vector2i& cell) const;
+		[[nodiscard]] size_t size() const;
+		[[nodiscard]] size_t loadedCount() const;
+		// ---
+
+		// ACTIVATORS ---
+		void setActivator(uint32_t id, const rawrbox::Vector3f& pos);
+		void removeActivator(uint32_t id);
+
+		// XZ distance to the closest activator, max float without any
+		[[nodiscard]] float getDistance(const rawrbox::Vector3f& pos) const;
+		// ---
+
+		// Fills the cells to load / unload (cleared first), and marks them as such
+		void update(std::vector<rawrbox::Vector2i>& load, std::vector<rawrbox::Vector2i>& unload);
+		// Every loaded cell goes to unload
+		void unloadAll(std::vector<rawrbox::Vector2i>& unload);
+	};
+} // namespace rawrbox
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <rawrbox/math/bbox.hpp>
+#include <rawrbox/math/bvh.hpp>
+#include <rawrbox/math/ray.hpp>
+#include <rawrbox/math/vector3.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace rawrbox {
+	// Bounding volume hierarchy over the triangles of a mesh, for ray picking without the GPU
+	// Built with binned SAH, so it costs more to build than rawrbox::BVH but rays visit a lot less nodes
+	class TriangleBVH {
+	protected:
+		std::vector<rawrbox::BVHNode> _nodes = {};
+		std::vector<uint32_t> _triangles = {}; // Triangle ids, in leaf order
+
+		std::vector<rawrbox::Vector3f> _positions = {};
+		std::vector<uint32_t> _indices = {};
+
+		// Only used while building
+		std::vector<rawrbox::Vector3f> _centroids = {};
+		std::vector<rawrbox::BBOX> _bounds = {};
+
+		uint32_t _leafSize = 4;
+
+		void subdivide(uint32_t root);
+		void updateNodes();
+
+		[[nodiscard]] rawrbox::BBOX getTriangleBBOX(uint32_t triangle) const;
+
+	public:
+		static constexpr uint32_t BINS = 16;
+
+		TriangleBVH() = default;
+		explicit TriangleBVH(uint32_t leafSize);
+
+		// Indices are 3 per triangle, like Mesh::indices
+		void build(std::vector<rawrbox::Vector3f> positions, std::vector<uint32_t> indices);
+		// New positions for the same triangles (skinned / animated meshes), keeps the tree and only grows / shrinks the nodes
+		// Good while the mesh doesn't deform too much from the pose it was built with, build again if it does
+		void refit(const std::vector<rawrbox::Vector3f>& positions);
+		void clear();
+
+		// Closest hit, false if none is closer than maxDistance
+		[[nodiscard]] bool raycast(const rawrbox::Ray& ray, float maxDistance, rawrbox::RayHit& hit) const;
+		// Appends the triangles with their bbox touching the given one
+		void query(const rawrbox::BBOX& bbox, std::vector<uint32_t>& out) const;
+
+		[[nodiscard]] rawrbox::BBOX getBBOX() const;
+		[[nodiscard]] const std::vector<rawrbox::BVHNode>& getNodes() const;
+		[[nodiscard]] const std::vector<rawrbox::Vector3f>& getPositions() const;
+		[[nodiscard]] const std::vector<uint32_t>& getIndices() const;
+
+		[[nodiscard]] size_t size() const; // Triangles
+		[[nodiscard]] bool empty() const;
+	};
+} // namespace rawrbox
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <rawrbox/math/aabb.hpp>
+#include <rawrbox/math/vector2.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace rawrbox {
+	// MaxRects bin packer (best short side fit), rects are stored in flat arrays and can be removed / reused
+	// Removing only merges the freed rect with its free neighbours, the free rects get rebuilt once there's enough churn or an insert doesn't fit
+	class RectPacker {
+	protected:
+		rawrbox::Vector2u _size = {};
+
+		std::vector<rawrbox::AABBu> _free = {};
+		std::vector<rawrbox::AABBu> _used = {}; // Indexed by id, empty = unused slot
+		std::vector<uint32_t> _freeIds = {};
+		std::vector<rawrbox::AABBu> _split = {}; // Scratch
+
+		size_t _count = 0;
+		uint64_t _usedArea = 0;
+		size_t _removed = 0; // Since the free rects were last rebuilt
+
+		// Free rects from the used ones, so they are all maximal again
+		void buildFreeRects(std::vector<rawrbox::AABBu>& free, std::vector<rawrbox::AABBu>& split) const;
+		void rebuildFreeRects();
+
+	public:
+		explicit RectPacker(const rawrbox::Vector2u& size);
+
+		[[nodiscard]] bool canInsert(uint32_t width, uint32_t height) const;
+		[[nodiscard]] std::optional<uint32_t> insert(uint32_t width, uint32_t height);
+		bool remove(uint32_t id);
+		void clear();
+
+		[[nodiscard]] const rawrbox::AABBu& get(uint32_t id) const;
+		[[nodiscard]] bool valid(uint32_t id) const;
+
+		[[nodiscard]] const rawrbox::Vector2u& getSize() const;
+		[[nodiscard]] size_t size() const;
+		[[nodiscard]] bool empty() const;
+
+		// Used area / total area (0 - 1)
+		[[nodiscard]] float occupancy() const;
+	};
+} // namespace rawrbox
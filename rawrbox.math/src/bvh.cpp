@@ -0,0 +1,277 @@
+#include <rawrbox/math/bvh.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <numeric>
+
+namespace rawrbox {
+	BVH::BVH(uint32_t leafSize) : _leafSize(std::max(leafSize, 1U)) {}
+
+	// PRIVATE ----
+	void BVH::updateBounds(uint32_t node, const std::vector<rawrbox::BBOX>& boxes) {
+		auto& n = this->_nodes[node];
+
+		n.min = boxes[this->_indices[n.first]].min;
+		n.max = boxes[this->_indices[n.first]].max;
+
+		for (uint32_t i = n.first + 1; i < n.first + n.count; i++) {
+			const auto& box = boxes[this->_indices[i]];
+
+			n.min = {std::min(n.min.x, box.min.x), std::min(n.min.y, box.min.y), std::min(n.min.z, box.min.z)};
+			n.max = {std::max(n.max.x, box.max.x), std::max(n.max.y, box.max.y), std::max(n.max.z, box.max.z)};
+		}
+	}
+
+	void BVH::updateItems(const std::vector<rawrbox::BBOX>& boxes) {
+		for (size_t axis = 0; axis < 3; axis++) {
+			this->_itemCenter[axis].resize(boxes.size());
+			this->_itemExtent[axis].resize(boxes.size());
+		}
+
+		for (size_t i = 0; i < this->_indices.size(); i++) {
+			const auto& box = boxes[this->_indices[i]];
+
+			const rawrbox::Vector3f center = (box.min + box.max) / 2.F;
+			const rawrbox::Vector3f extent = (box.max - box.min) / 2.F;
+
+			this->_itemCenter[0][i] = center.x;
+			this->_itemCenter[1][i] = center.y;
+			this->_itemCenter[2][i] = center.z;
+			this->_itemExtent[0][i] = extent.x;
+			this->_itemExtent[1][i] = extent.y;
+			this->_itemExtent[2][i] = extent.z;
+		}
+	}
+
+	void BVH::updateNodes(const std::vector<rawrbox::BBOX>& boxes) {
+		// Children are always after their parent, so going backwards updates them first
+		for (size_t i = this->_nodes.size(); i-- > 0;) {
+			auto& node = this->_nodes[i];
+			if (node.isLeaf()) {
+				this->updateBounds(static_cast<uint32_t>(i), boxes);
+				continue;
+			}
+
+			const auto& a = this->_nodes[node.left];
+			const auto& b = this->_nodes[node.left + 1];
+
+			node.min = {std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z)};
+			node.max = {std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z)};
+		}
+	}
+
+	void BVH::subdivide(uint32_t root) {
+		std::vector<uint32_t> stack = {root};
+
+		while (!stack.empty()) {
+			const uint32_t node = stack.back();
+			stack.pop_back();
+
+			const uint32_t first = this->_nodes[node].first;
+			const uint32_t count = this->_nodes[node].count;
+			if (count <= this->_leafSize) continue;
+
+			// Split on the longest axis of the centers, not the boxes, big boxes would put everything on one side
+			rawrbox::Vector3f cmin = this->_centers[this->_indices[first]];
+			rawrbox::Vector3f cmax = cmin;
+			for (uint32_t i = first + 1; i < first + count; i++) {
+				const auto& c = this->_centers[this->_indices[i]];
+
+				cmin = {std::min(cmin.x, c.x), std::min(cmin.y, c.y), std::min(cmin.z, c.z)};
+				cmax = {std::max(cmax.x, c.x), std::max(cmax.y, c.y), std::max(cmax.z, c.z)};
+			}
+
+			const rawrbox::Vector3f extent = cmax - cmin;
+			if (extent.x <= 0.F && extent.y <= 0.F && extent.z <= 0.F) continue; // All on the same spot, can't split
+
+			int axis = 0;
+			if (extent.y > extent.x) axis = 1;
+			if (extent.z > (axis == 0 ? extent.x : extent.y)) axis = 2;
+
+			const uint32_t half = count / 2;
+			auto begin = this->_indices.begin() + first;
+			std::nth_element(begin, begin + half, begin + count, [this, axis](uint32_t a, uint32_t b) {
+				return this->_centers[a].data()[axis] < this->_centers[b].data()[axis];
+			});
+
+			const auto left = static_cast<uint32_t>(this->_nodes.size());
+			this->_nodes[node].left = left;
+
+			this->_nodes.push_back({{}, {}, 0, first, half});
+			this->_nodes.push_back({{}, {}, 0, first + half, count - half});
+
+			stack.push_back(left + 1);
+			stack.push_back(left);
+		}
+	}
+	// ------------
+
+	void BVH::build(const std::vector<rawrbox::BBOX>& boxes) {
+		this->clear();
+		if (boxes.empty()) return;
+
+		this->_indices.resize(boxes.size());
+		std::iota(this->_indices.begin(), this->_indices.end(), 0U);
+
+		this->_centers.resize(boxes.size());
+		for (size_t i = 0; i < boxes.size(); i++) {
+			this->_centers[i] = (boxes[i].min + boxes[i].max) / 2.F;
+		}
+
+		this->_nodes.reserve(boxes.size() * 2 / this->_leafSize + 1);
+		this->_nodes.push_back({{}, {}, 0, 0, static_cast<uint32_t>(boxes.size())});
+		this->subdivide(0);
+		this->updateItems(boxes);
+		this->updateNodes(boxes);
+
+		this->_centers.clear();
+		this->_centers.shrink_to_fit();
+	}
+
+	void BVH::refit(const std::vector<rawrbox::BBOX>& boxes) {
+		if (boxes.size() != this->_indices.size()) {
+			this->build(boxes);
+			return;
+		}
+
+		this->updateItems(boxes);
+		this->updateNodes(boxes);
+	}
+
+	void BVH::clear() {
+		this->_nodes.clear();
+		this->_indices.clear();
+		this->_centers.clear();
+
+		for (size_t axis = 0; axis < 3; axis++) {
+			this->_itemCenter[axis].clear();
+			this->_itemExtent[axis].clear();
+		}
+	}
+
+	void BVH::query(const rawrbox::Frustum& frustum, std::vector<uint32_t>& out) const {
+		if (this->_nodes.empty()) return;
+		this->query(frustum, 0, out);
+	}
+
+	void BVH::query(const rawrbox::Frustum& frustum, uint32_t root, std::vector<uint32_t>& out) const {
+		std::vector<uint32_t> stack = {root};
+		std::array<uint8_t, 256> visible = {};
+
+		while (!stack.empty()) {
+			const auto& node = this->_nodes[stack.back()];
+			stack.pop_back();
+
+			switch (frustum.testBBOX(node.getBBOX())) {
+				case rawrbox::FrustumTest::OUTSIDE:
+					break;
+				case rawrbox::FrustumTest::INSIDE:
+					out.insert(out.end(), this->_indices.begin() + node.first, this->_indices.begin() + node.first + node.count);
+					break;
+				case rawrbox::FrustumTest::INTERSECTS:
+					if (node.isLeaf()) {
+						// Leaves can be bigger than the leaf size if their items share the same center
+						for (uint32_t start = node.first; start < node.first + node.count; start += static_cast<uint32_t>(visible.size())) {
+							const uint32_t count = std::min(node.first + node.count - start, static_cast<uint32_t>(visible.size()));
+							frustum.cullBoxes(&this->_itemCenter[0][start], &this->_itemCenter[1][start], &this->_itemCenter[2][start], &this->_itemExtent[0][start], &this->_itemExtent[1][start], &this->_itemExtent[2][start], count, visible.data());
+
+							for (uint32_t i = 0; i < count; i++) {
+								if (visible[i] != 0) out.push_back(this->_indices[start + i]);
+							}
+						}
+					} else {
+						stack.push_back(node.left + 1);
+						stack.push_back(node.left);
+					}
+					break;
+			}
+		}
+	}
+
+	void BVH::query(const rawrbox::BBOX& bbox, std::vector<uint32_t>& out) const {
+		if (this->_nodes.empty()) return;
+
+		const auto center = ((bbox.min + bbox.max) / 2.F).data();
+		const auto extent = ((bbox.max - bbox.min) / 2.F).data();
+
+		std::vector<uint32_t> stack = {0};
+		while (!stack.empty()) {
+			const auto& node = this->_nodes[stack.back()];
+			stack.pop_back();
+
+			const bool overlaps = node.min.x <= bbox.max.x && node.max.x >= bbox.min.x &&
+					      node.min.y <= bbox.max.y && node.max.y >= bbox.min.y &&
+					      node.min.z <= bbox.max.z && node.max.z >= bbox.min.z;
+			if (!overlaps) continue;
+
+			if (node.isLeaf()) {
+				for (uint32_t i = node.first; i < node.first + node.count; i++) {
+					bool inside = true;
+					for (size_t axis = 0; axis < 3; axis++) {
+						inside &= std::abs(this->_itemCenter[axis][i] - center[axis]) <= this->_itemExtent[axis][i] + extent[axis];
+					}
+
+					if (inside) out.push_back(this->_indices[i]);
+				}
+			} else {
+				stack.push_back(node.left + 1);
+				stack.push_back(node.left);
+			}
+		}
+	}
+
+	void BVH::query(const rawrbox::Ray& ray, float maxDistance, std::vector<std::pair<float, uint32_t>>& out) const {
+		if (this->_nodes.empty()) return;
+
+		std::vector<uint32_t> stack = {0};
+		while (!stack.empty()) {
+			const auto& node = this->_nodes[stack.back()];
+			stack.pop_back();
+
+			float entry = 0.F;
+			if (!ray.intersects(node.min, node.max, maxDistance, entry)) continue;
+
+			if (node.isLeaf()) {
+				for (uint32_t i = node.first; i < node.first + node.count; i++) {
+					const rawrbox::Vector3f center = {this->_itemCenter[0][i], this->_itemCenter[1][i], this->_itemCenter[2][i]};
+					const rawrbox::Vector3f extent = {this->_itemExtent[0][i], this->_itemExtent[1][i], this->_itemExtent[2][i]};
+
+					if (ray.intersects(center - extent, center + extent, maxDistance, entry)) out.emplace_back(entry, this->_indices[i]);
+				}
+			} else {
+				stack.push_back(node.left + 1);
+				stack.push_back(node.left);
+			}
+		}
+	}
+
+	std::vector<uint32_t> BVH::getSubtrees(size_t count) const {
+		if (this->_nodes.empty()) return {};
+
+		// Breadth first, so the subtrees have about the same size
+		std::deque<uint32_t> open = {0};
+		std::vector<uint32_t> leaves = {};
+
+		while (!open.empty() && open.size() + leaves.size() < count) {
+			const uint32_t node = open.front();
+			open.pop_front();
+
+			if (this->_nodes[node].isLeaf()) {
+				leaves.push_back(node);
+				continue;
+			}
+
+			open.push_back(this->_nodes[node].left);
+			open.push_back(this->_nodes[node].left + 1);
+		}
+
+		leaves.insert(leaves.end(), open.begin(), open.end());
+		return leaves;
+	}
+
+	const std::vector<rawrbox::BVHNode>& BVH::getNodes() const { return this->_nodes; }
+	const std::vector<uint32_t>& BVH::getIndices() const { return this->_indices; }
+	size_t BVH::size() const { return this->_indices.size(); }
+	bool BVH::empty() const { return this->_indices.empty(); }
+} // namespace rawrbox
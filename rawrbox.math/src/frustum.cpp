@@ -0,0 +1,121 @@
+#include <rawrbox/math/frustum.hpp>
+
+#include <cmath>
+
+namespace rawrbox {
+	Frustum::Frustum(const rawrbox::Matrix4x4& viewProj) {
+		this->update(viewProj);
+	}
+
+	void Frustum::update(const rawrbox::Matrix4x4& viewProj) {
+		const auto& m = viewProj.mtx;
+
+		// Clip space rows, clip = mulVec(pos)
+		const rawrbox::Vector4f x = {m[0], m[4], m[8], m[12]};
+		const rawrbox::Vector4f y = {m[1], m[5], m[9], m[13]};
+		const rawrbox::Vector4f z = {m[2], m[6], m[10], m[14]};
+		const rawrbox::Vector4f w = {m[3], m[7], m[11], m[15]};
+
+		this->_planes[0] = w + x; // Left
+		this->_planes[1] = w - x; // Right
+		this->_planes[2] = w + y; // Bottom
+		this->_planes[3] = w - y; // Top
+		this->_planes[4] = w + z; // Near, -1 to 1 depth. Looser than 0 to 1, so still safe to cull with
+		this->_planes[5] = w - z; // Far
+
+		for (auto& plane : this->_planes) {
+			const float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+			if (length > 0.F) plane /= length;
+		}
+	}
+
+	bool Frustum::containsPoint(const rawrbox::Vector3f& pos) const {
+		return this->containsSphere(pos, 0.F);
+	}
+
+	bool Frustum::containsSphere(const rawrbox::Vector3f& center, float radius) const {
+		for (const auto& plane : this->_planes) {
+			if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius) return false;
+		}
+
+		return true;
+	}
+
+	bool Frustum::containsBBOX(const rawrbox::BBOX& bbox) const {
+		for (const auto& plane : this->_planes) {
+			// Corner furthest along the plane normal
+			const float px = plane.x >= 0.F ? bbox.max.x : bbox.min.x;
+			const float py = plane.y >= 0.F ? bbox.max.y : bbox.min.y;
+			const float pz = plane.z >= 0.F ? bbox.max.z : bbox.min.z;
+
+			if (plane.x * px + plane.y * py + plane.z * pz + plane.w < 0.F) return false;
+		}
+
+		return true;
+	}
+
+	rawrbox::FrustumTest Frustum::testBBOX(const rawrbox::BBOX& bbox) const {
+		bool inside = true;
+
+		for (const auto& plane : this->_planes) {
+			// Furthest corner along the normal outside = all outside, nearest corner outside = crossing the plane
+			const float px = plane.x >= 0.F ? bbox.max.x : bbox.min.x;
+			const float py = plane.y >= 0.F ? bbox.max.y : bbox.min.y;
+			const float pz = plane.z >= 0.F ? bbox.max.z : bbox.min.z;
+			if (plane.x * px + plane.y * py + plane.z * pz + plane.w < 0.F) return rawrbox::FrustumTest::OUTSIDE;
+
+			const float nx = plane.x >= 0.F ? bbox.min.x : bbox.max.x;
+			const float ny = plane.y >= 0.F ? bbox.min.y : bbox.max.y;
+			const float nz = plane.z >= 0.F ? bbox.min.z : bbox.max.z;
+			if (plane.x * nx + plane.y * ny + plane.z * nz + plane.w < 0.F) inside = false;
+		}
+
+		return inside ? rawrbox::FrustumTest::INSIDE : rawrbox::FrustumTest::INTERSECTS;
+	}
+
+	void Frustum::cullSpheres(const float* x, const float* y, const float* z, const float* radius, size_t count, uint8_t* visible) const {
+		const auto& p = this->_planes;
+
+		for (size_t i = 0; i < count; i++) {
+			const float r = -radius[i];
+
+			bool in = p[0].x * x[i] + p[0].y * y[i] + p[0].z * z[i] + p[0].w >= r;
+			in &= p[1].x * x[i] + p[1].y * y[i] + p[1].z * z[i] + p[1].w >= r;
+			in &= p[2].x * x[i] + p[2].y * y[i] + p[2].z * z[i] + p[2].w >= r;
+			in &= p[3].x * x[i] + p[3].y * y[i] + p[3].z * z[i] + p[3].w >= r;
+			in &= p[4].x * x[i] + p[4].y * y[i] + p[4].z * z[i] + p[4].w >= r;
+			in &= p[5].x * x[i] + p[5].y * y[i] + p[5].z * z[i] + p[5].w >= r;
+
+			visible[i] = static_cast<uint8_t>(in);
+		}
+	}
+
+	void Frustum::cullBoxes(const float* centerX, const float* centerY, const float* centerZ, const float* extentX, const float* extentY, const float* extentZ, size_t count, uint8_t* visible) const {
+		// Plane normals with the sign dropped, the projected box radius is |n| . extent
+		std::array<rawrbox::Vector3f, 6> abs = {};
+		for (size_t i = 0; i < 6; i++) {
+			abs[i] = rawrbox::Vector3f(this->_planes[i].x, this->_planes[i].y, this->_planes[i].z).abs();
+		}
+
+		const auto& p = this->_planes;
+		for (size_t i = 0; i < count; i++) {
+			const float cx = centerX[i];
+			const float cy = centerY[i];
+			const float cz = centerZ[i];
+			const float ex = extentX[i];
+			const float ey = extentY[i];
+			const float ez = extentZ[i];
+
+			bool in = p[0].x * cx + p[0].y * cy + p[0].z * cz + p[0].w >= -(abs[0].x * ex + abs[0].y * ey + abs[0].z * ez);
+			in &= p[1].x * cx + p[1].y * cy + p[1].z * cz + p[1].w >= -(abs[1].x * ex + abs[1].y * ey + abs[1].z * ez);
+			in &= p[2].x * cx + p[2].y * cy + p[2].z * cz + p[2].w >= -(abs[2].x * ex + abs[2].y * ey + abs[2].z * ez);
+			in &= p[3].x * cx + p[3].y * cy + p[3].z * cz + p[3].w >= -(abs[3].x * ex + abs[3].y * ey + abs[3].z * ez);
+			in &= p[4].x * cx + p[4].y * cy + p[4].z * cz + p[4].w >= -(abs[4].x * ex + abs[4].y * ey + abs[4].z * ez);
+			in &= p[5].x * cx + p[5].y * cy + p[5].z * cz + p[5].w >= -(abs[5].x * ex + abs[5].y * ey + abs[5].z * ez);
+
+			visible[i] = static_cast<uint8_t>(in);
+		}
+	}
+
+	const std::array<rawrbox::Vector4f, 6>& Frustum::getPlanes() const { return this->_planes; }
+} // namespace rawrbox
@@ -0,0 +1,157 @@
+#include <rawrbox/math/occlusion_buffer.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace rawrbox {
+	namespace {
+		constexpr float FAR_DEPTH = std::numeric_limits<float>::max();
+		constexpr float MIN_W = 1e-5F;
+
+		// Two triangles per face
+		constexpr std::array<std::array<uint8_t, 3>, 12> BOX_TRIANGLES = {{
+		    {0, 1, 3},
+		    {0, 3, 2}, // -X
+		    {4, 6, 7},
+		    {4, 7, 5}, // +X
+		    {0, 4, 5},
+		    {0, 5, 1}, // -Y
+		    {2, 3, 7},
+		    {2, 7, 6}, // +Y
+		    {0, 2, 6},
+		    {0, 6, 4}, // -Z
+		    {1, 5, 7},
+		    {1, 7, 3}, // +Z
+		}};
+	} // namespace
+
+	OcclusionBuffer::OcclusionBuffer(uint32_t width, uint32_t height) {
+		this->resize(width, height);
+	}
+
+	// PRIVATE ----
+	bool OcclusionBuffer::project(const rawrbox::BBOX& bbox, std::array<rawrbox::Vector3f, 8>& out) const {
+		const auto& m = this->_viewProj.mtx;
+
+		const auto width = static_cast<float>(this->_width);
+		const auto height = static_cast<float>(this->_height);
+
+		for (size_t i = 0; i < 8; i++) {
+			// Corner bits: x = 4, y = 2, z = 1
+			const float x = (i & 4U) != 0 ? bbox.max.x : bbox.min.x;
+			const float y = (i & 2U) != 0 ? bbox.max.y : bbox.min.y;
+			const float z = (i & 1U) != 0 ? bbox.max.z : bbox.min.z;
+
+			const float cw = x * m[3] + y * m[7] + z * m[11] + m[15];
+			if (cw <= MIN_W) return false;
+
+			const float cx = x * m[0] + y * m[4] + z * m[8] + m[12];
+			const float cy = x * m[1] + y * m[5] + z * m[9] + m[13];
+			const float cz = x * m[2] + y * m[6] + z * m[10] + m[14];
+
+			out[i] = {
+			    (cx / cw * 0.5F + 0.5F) * width,
+			    (0.5F - cy / cw * 0.5F) * height,
+			    cz / cw};
+		}
+
+		return true;
+	}
+
+	void OcclusionBuffer::rasterize(const rawrbox::Vector3f& a, const rawrbox::Vector3f& b, const rawrbox::Vector3f& c) {
+		float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+		if (std::abs(area) < 1e-8F) return;
+
+		// Either winding, the depth test keeps the front faces anyway
+		const rawrbox::Vector3f& v0 = a;
+		const rawrbox::Vector3f& v1 = area > 0.F ? b : c;
+		const rawrbox::Vector3f& v2 = area > 0.F ? c : b;
+		area = std::abs(area);
+
+		const int minX = std::max(static_cast<int>(std::floor(std::min({v0.x, v1.x, v2.x}))), 0);
+		const int maxX = std::min(static_cast<int>(std::ceil(std::max({v0.x, v1.x, v2.x}))), static_cast<int>(this->_width) - 1);
+		const int minY = std::max(static_cast<int>(std::floor(std::min({v0.y, v1.y, v2.y}))), 0);
+		const int maxY = std::min(static_cast<int>(std::ceil(std::max({v0.y, v1.y, v2.y}))), static_cast<int>(this->_height) - 1);
+		if (minX > maxX || minY > maxY) return;
+
+		for (int y = minY; y <= maxY; y++) {
+			const float py = static_cast<float>(y) + 0.5F;
+			float* row = this->_depth.data() + static_cast<size_t>(y) * this->_width;
+
+			for (int x = minX; x <= maxX; x++) {
+				const float px = static_cast<float>(x) + 0.5F;
+
+				// Pixel centers only, so an occluder never covers more than it really does
+				const float w0 = (v2.x - v1.x) * (py - v1.y) - (v2.y - v1.y) * (px - v1.x);
+				const float w1 = (v0.x - v2.x) * (py - v2.y) - (v0.y - v2.y) * (px - v2.x);
+				const float w2 = (v1.x - v0.x) * (py - v0.y) - (v1.y - v0.y) * (px - v0.x);
+				if (w0 < 0.F || w1 < 0.F || w2 < 0.F) continue;
+
+				const float depth = (w0 * v0.z + w1 * v1.z + w2 * v2.z) / area;
+				row[x] = std::min(row[x], depth);
+			}
+		}
+	}
+	// ------------
+
+	void OcclusionBuffer::resize(uint32_t width, uint32_t height) {
+		this->_width = width;
+		this->_height = height;
+		this->_depth.assign(static_cast<size_t>(width) * height, FAR_DEPTH);
+	}
+
+	void OcclusionBuffer::begin(const rawrbox::Matrix4x4& viewProj) {
+		this->_viewProj = viewProj;
+		std::fill(this->_depth.begin(), this->_depth.end(), FAR_DEPTH);
+	}
+
+	void OcclusionBuffer::addOccluder(const rawrbox::BBOX& bbox) {
+		std::array<rawrbox::Vector3f, 8> corners = {};
+		if (!this->project(bbox, corners)) return;
+
+		for (const auto& tri : BOX_TRIANGLES) {
+			this->rasterize(corners[tri[0]], corners[tri[1]], corners[tri[2]]);
+		}
+	}
+
+	bool OcclusionBuffer::isVisible(const rawrbox::BBOX& bbox) const {
+		std::array<rawrbox::Vector3f, 8> corners = {};
+		if (!this->project(bbox, corners)) return true;
+
+		float minX = corners[0].x;
+		float maxX = corners[0].x;
+		float minY = corners[0].y;
+		float maxY = corners[0].y;
+		float nearest = corners[0].z;
+
+		for (const auto& corner : corners) {
+			minX = std::min(minX, corner.x);
+			maxX = std::max(maxX, corner.x);
+			minY = std::min(minY, corner.y);
+			maxY = std::max(maxY, corner.y);
+			nearest = std::min(nearest, corner.z);
+		}
+
+		// Every pixel the box could touch, even partially
+		const int x0 = std::max(static_cast<int>(std::floor(minX)), 0);
+		const int x1 = std::min(static_cast<int>(std::ceil(maxX)), static_cast<int>(this->_width) - 1);
+		const int y0 = std::max(static_cast<int>(std::floor(minY)), 0);
+		const int y1 = std::min(static_cast<int>(std::ceil(maxY)), static_cast<int>(this->_height) - 1);
+		if (x0 > x1 || y0 > y1) return false; // Off screen
+
+		for (int y = y0; y <= y1; y++) {
+			const float* row = this->_depth.data() + static_cast<size_t>(y) * this->_width;
+
+			for (int x = x0; x <= x1; x++) {
+				if (nearest < row[x]) return true;
+			}
+		}
+
+		return false;
+	}
+
+	uint32_t OcclusionBuffer::getWidth() const { return this->_width; }
+	uint32_t OcclusionBuffer::getHeight() const { return this->_height; }
+	const std::vector<float>& OcclusionBuffer::getDepth() const { return this->_depth; }
+} // namespace rawrbox
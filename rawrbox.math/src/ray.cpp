@@ -0,0 +1,102 @@
+#include <rawrbox/math/ray.hpp>
+#include <rawrbox/math/vector4.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace rawrbox {
+	Ray::Ray(const rawrbox::Vector3f& origin, const rawrbox::Vector3f& dir) : _origin(origin), _dir(dir.normalized()) {
+		this->updateInverse();
+	}
+
+	// PRIVATE ----
+	void Ray::updateInverse() {
+		constexpr float inf = std::numeric_limits<float>::infinity();
+
+		this->_invDir = {
+		    this->_dir.x == 0.F ? inf : 1.F / this->_dir.x,
+		    this->_dir.y == 0.F ? inf : 1.F / this->_dir.y,
+		    this->_dir.z == 0.F ? inf : 1.F / this->_dir.z};
+	}
+	// ------------
+
+	rawrbox::Ray Ray::fromScreen(const rawrbox::Vector2f& screenPos, const rawrbox::Vector2f& screenSize, const rawrbox::Matrix4x4& viewProjInv) {
+		const float x = 2.F * (screenPos.x / screenSize.x) - 1.F;
+		const float y = 1.F - 2.F * (screenPos.y / screenSize.y);
+
+		// Two depths that are in front of the camera on both 0..1 and -1..1 clip spaces
+		rawrbox::Vector4f nearPos = viewProjInv.mulVec(rawrbox::Vector4f{x, y, 0.F, 1.F});
+		rawrbox::Vector4f farPos = viewProjInv.mulVec(rawrbox::Vector4f{x, y, 0.5F, 1.F});
+		nearPos /= nearPos.w;
+		farPos /= farPos.w;
+
+		return {nearPos.xyz(), farPos.xyz() - nearPos.xyz()};
+	}
+
+	const rawrbox::Vector3f& Ray::getOrigin() const { return this->_origin; }
+	const rawrbox::Vector3f& Ray::getDirection() const { return this->_dir; }
+	const rawrbox::Vector3f& Ray::getInverseDirection() const { return this->_invDir; }
+
+	rawrbox::Vector3f Ray::at(float distance) const { return this->_origin + this->_dir * distance; }
+
+	rawrbox::Ray Ray::transform(const rawrbox::Matrix4x4& matrix) const {
+		const rawrbox::Vector3f origin = matrix.mulVec(this->_origin);
+		const rawrbox::Vector3f end = matrix.mulVec(this->_origin + this->_dir);
+
+		return {origin, end - origin};
+	}
+
+	bool Ray::intersects(const rawrbox::Vector3f& min, const rawrbox::Vector3f& max, float maxDistance, float& entry) const {
+		// NaNs (0 * inf, the ray lies on a slab plane) fall through the min / max, so they don't reject the box
+		const float tx1 = (min.x - this->_origin.x) * this->_invDir.x;
+		const float tx2 = (max.x - this->_origin.x) * this->_invDir.x;
+		float tmin = std::min(tx1, tx2);
+		float tmax = std::max(tx1, tx2);
+
+		const float ty1 = (min.y - this->_origin.y) * this->_invDir.y;
+		const float ty2 = (max.y - this->_origin.y) * this->_invDir.y;
+		tmin = std::max(tmin, std::min(ty1, ty2));
+		tmax = std::min(tmax, std::max(ty1, ty2));
+
+		const float tz1 = (min.z - this->_origin.z) * this->_invDir.z;
+		const float tz2 = (max.z - this->_origin.z) * this->_invDir.z;
+		tmin = std::max(tmin, std::min(tz1, tz2));
+		tmax = std::min(tmax, std::max(tz1, tz2));
+
+		entry = std::max(tmin, 0.F);
+		return tmax >= entry && entry <= maxDistance;
+	}
+
+	bool Ray::intersects(const rawrbox::BBOX& bbox, float maxDistance, float& entry) const {
+		return this->intersects(bbox.min, bbox.max, maxDistance, entry);
+	}
+
+	bool Ray::intersects(const rawrbox::Vector3f& a, const rawrbox::Vector3f& b, const rawrbox::Vector3f& c, float maxDistance, float& distance, float& u, float& v) const {
+		constexpr float epsilon = 1e-8F;
+
+		const rawrbox::Vector3f edge1 = b - a;
+		const rawrbox::Vector3f edge2 = c - a;
+
+		const rawrbox::Vector3f p = this->_dir.cross(edge2);
+		const float det = edge1.dot(p);
+		if (std::abs(det) < epsilon) return false; // Parallel
+
+		const float invDet = 1.F / det;
+		const rawrbox::Vector3f s = this->_origin - a;
+
+		const float hitU = s.dot(p) * invDet;
+		if (hitU < 0.F || hitU > 1.F) return false;
+
+		const rawrbox::Vector3f q = s.cross(edge1);
+		const float hitV = this->_dir.dot(q) * invDet;
+		if (hitV < 0.F || hitU + hitV > 1.F) return false;
+
+		const float t = edge2.dot(q) * invDet;
+		if (t < 0.F || t > maxDistance) return false;
+
+		distance = t;
+		u = hitU;
+		v = hitV;
+		return true;
+	}
+} // namespace rawrbox
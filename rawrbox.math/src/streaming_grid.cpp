@@ -0,0 +1,130 @@
+#include <rawrbox/math/streaming_grid.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace rawrbox {
+	StreamingGrid::StreamingGrid(float cellSize, float loadRadius, float unloadRadius, size_t budget) : _cellSize(std::max(cellSize, 0.0001F)), _loadRadius(loadRadius), _unloadRadius(std::max(loadRadius, unloadRadius)), _budget(std::max<size_t>(budget, 1)) {}
+
+	// PROTECTED ----
+	float StreamingGrid::cellDistance(uint64_t key) const {
+		return this->getDistance(this->getCellCenter(fromKey(key)));
+	}
+	// -------------
+
+	uint64_t StreamingGrid::key(const rawrbox::Vector2i& cell) {
+		return (static_cast<uint64_t>(static_cast<uint32_t>(cell.x)) << 32U) | static_cast<uint64_t>(static_cast<uint32_t>(cell.y));
+	}
+
+	rawrbox::Vector2i StreamingGrid::fromKey(uint64_t key) {
+		return {static_cast<int>(static_cast<uint32_t>(key >> 32U)), static_cast<int>(static_cast<uint32_t>(key))};
+	}
+
+	float StreamingGrid::getCellSize() const { return this->_cellSize; }
+	float StreamingGrid::getLoadRadius() const { return this->_loadRadius; }
+	float StreamingGrid::getUnloadRadius() const { return this->_unloadRadius; }
+
+	rawrbox::Vector2i StreamingGrid::getCell(const rawrbox::Vector3f& pos) const {
+		return {static_cast<int>(std::floor(pos.x / this->_cellSize)), static_cast<int>(std::floor(pos.z / this->_cellSize))};
+	}
+
+	rawrbox::Vector3f StreamingGrid::getCellCenter(const rawrbox::Vector2i& cell) const {
+		return {(static_cast<float>(cell.x) + 0.5F) * this->_cellSize, 0.F, (static_cast<float>(cell.y) + 0.5F) * this->_cellSize};
+	}
+
+	// CELLS ---
+	void StreamingGrid::addCell(const rawrbox::Vector2i& cell) { this->_cells.insert(key(cell)); }
+
+	void StreamingGrid::removeCell(const rawrbox::Vector2i& cell) {
+		const uint64_t k = key(cell);
+
+		this->_cells.erase(k);
+		this->_loaded.erase(k);
+	}
+
+	void StreamingGrid::cancelLoad(const rawrbox::Vector2i& cell) { this->_loaded.erase(key(cell)); }
+
+	void StreamingGrid::clear() {
+		this->_cells.clear();
+		this->_loaded.clear();
+	}
+
+	bool StreamingGrid::hasCell(const rawrbox::Vector2i& cell) const { return this->_cells.contains(key(cell)); }
+	bool StreamingGrid::isLoaded(const rawrbox::Vector2i& cell) const { return this->_loaded.contains(key(cell)); }
+	size_t StreamingGrid::size() const { return this->_cells.size(); }
+	size_t StreamingGrid::loadedCount() const { return this->_loaded.size(); }
+	// ---
+
+	// ACTIVATORS ---
+	void StreamingGrid::setActivator(uint32_t id, const rawrbox::Vector3f& pos) { this->_activators[id] = pos; }
+	void StreamingGrid::removeActivator(uint32_t id) { this->_activators.erase(id); }
+
+	float StreamingGrid::getDistance(const rawrbox::Vector3f& pos) const {
+		float best = std::numeric_limits<float>::max();
+
+		for (const auto& activator : this->_activators) {
+			const float dx = activator.second.x - pos.x;
+			const float dz = activator.second.z - pos.z;
+
+			best = std::min(best, dx * dx + dz * dz);
+		}
+
+		return best == std::numeric_limits<float>::max() ? best : std::sqrt(best);
+	}
+	// ---
+
+	void StreamingGrid::update(std::vector<rawrbox::Vector2i>& load, std::vector<rawrbox::Vector2i>& unload) {
+		load.clear();
+		unload.clear();
+
+		// Unload, the loaded set stays small (bounded by the radius), so a full pass is cheap
+		for (auto it = this->_loaded.begin(); it != this->_loaded.end();) {
+			if (this->cellDistance(*it) <= this->_unloadRadius) {
+				++it;
+				continue;
+			}
+
+			unload.push_back(fromKey(*it));
+			it = this->_loaded.erase(it);
+		}
+
+		// Load, only look at the cells around each activator
+		this->_candidates.clear();
+
+		const int reach = static_cast<int>(std::ceil(this->_loadRadius / this->_cellSize));
+		for (const auto& activator : this->_activators) {
+			const auto center = this->getCell(activator.second);
+
+			for (int z = center.y - reach; z <= center.y + reach; z++) {
+				for (int x = center.x - reach; x <= center.x + reach; x++) {
+					const uint64_t k = key({x, z});
+					if (!this->_cells.contains(k) || this->_loaded.contains(k)) continue;
+
+					const float distance = this->cellDistance(k);
+					if (distance <= this->_loadRadius) this->_candidates.emplace_back(distance, k);
+				}
+			}
+		}
+
+		// Closest first, ties by key so the order doesn't depend on the hash map
+		std::sort(this->_candidates.begin(), this->_candidates.end());
+		this->_candidates.erase(std::unique(this->_candidates.begin(), this->_candidates.end()), this->_candidates.end()); // Seen by more than one activator
+
+		for (const auto& candidate : this->_candidates) {
+			if (load.size() >= this->_budget) break;
+
+			load.push_back(fromKey(candidate.second));
+			this->_loaded.insert(candidate.second);
+		}
+	}
+
+	void StreamingGrid::unloadAll(std::vector<rawrbox::Vector2i>& unload) {
+		unload.clear();
+
+		for (const uint64_t k : this->_loaded) {
+			unload.push_back(fromKey(k));
+		}
+
+		this->_loaded.clear();
+	}
+} // namespace rawrbox
@@ -0,0 +1,324 @@
+#include <rawrbox/math/triangle_bvh.hpp>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+namespace rawrbox {
+	namespace {
+		// Deeper nodes stay leaves, so raycast can walk the tree with a fixed size stack
+		constexpr uint32_t MAX_DEPTH = 60;
+		constexpr size_t STACK_SIZE = MAX_DEPTH + 4;
+
+		struct Bin {
+			rawrbox::Vector3f min = std::numeric_limits<float>::max();
+			rawrbox::Vector3f max = std::numeric_limits<float>::lowest();
+			uint32_t count = 0;
+
+			void grow(const rawrbox::Vector3f& bmin, const rawrbox::Vector3f& bmax) {
+				this->min = {std::min(this->min.x, bmin.x), std::min(this->min.y, bmin.y), std::min(this->min.z, bmin.z)};
+				this->max = {std::max(this->max.x, bmax.x), std::max(this->max.y, bmax.y), std::max(this->max.z, bmax.z)};
+			}
+
+			[[nodiscard]] float area() const {
+				if (this->count == 0) return 0.F;
+
+				const rawrbox::Vector3f e = this->max - this->min;
+				return e.x * e.y + e.y * e.z + e.z * e.x;
+			}
+		};
+	} // namespace
+
+	TriangleBVH::TriangleBVH(uint32_t leafSize) : _leafSize(std::max(leafSize, 1U)) {}
+
+	// PRIVATE ----
+	rawrbox::BBOX TriangleBVH::getTriangleBBOX(uint32_t triangle) const {
+		const auto& a = this->_positions[this->_indices[triangle * 3]];
+		const auto& b = this->_positions[this->_indices[triangle * 3 + 1]];
+		const auto& c = this->_positions[this->_indices[triangle * 3 + 2]];
+
+		const rawrbox::Vector3f min = {std::min({a.x, b.x, c.x}), std::min({a.y, b.y, c.y}), std::min({a.z, b.z, c.z})};
+		const rawrbox::Vector3f max = {std::max({a.x, b.x, c.x}), std::max({a.y, b.y, c.y}), std::max({a.z, b.z, c.z})};
+
+		return {min, max, max - min};
+	}
+
+	void TriangleBVH::updateNodes() {
+		// Children are always after their parent, so going backwards updates them first
+		for (size_t i = this->_nodes.size(); i-- > 0;) {
+			auto& node = this->_nodes[i];
+
+			if (node.isLeaf()) {
+				const auto first = this->getTriangleBBOX(this->_triangles[node.first]);
+				node.min = first.min;
+				node.max = first.max;
+
+				for (uint32_t t = node.first + 1; t < node.first + node.count; t++) {
+					const auto box = this->getTriangleBBOX(this->_triangles[t]);
+
+					node.min = {std::min(node.min.x, box.min.x), std::min(node.min.y, box.min.y), std::min(node.min.z, box.min.z)};
+					node.max = {std::max(node.max.x, box.max.x), std::max(node.max.y, box.max.y), std::max(node.max.z, box.max.z)};
+				}
+
+				continue;
+			}
+
+			const auto& a = this->_nodes[node.left];
+			const auto& b = this->_nodes[node.left + 1];
+
+			node.min = {std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z)};
+			node.max = {std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z)};
+		}
+	}
+
+	void TriangleBVH::subdivide(uint32_t root) {
+		std::vector<std::pair<uint32_t, uint32_t>> stack = {{root, 0}}; // Node, depth
+
+		while (!stack.empty()) {
+			const auto [node, depth] = stack.back();
+			stack.pop_back();
+
+			const uint32_t first = this->_nodes[node].first;
+			const uint32_t count = this->_nodes[node].count;
+			if (count <= this->_leafSize || depth >= MAX_DEPTH) continue;
+
+			// Node bounds (for the leaf cost) and centroid bounds (for the bins)
+			Bin bounds = {};
+			rawrbox::Vector3f cmin = std::numeric_limits<float>::max();
+			rawrbox::Vector3f cmax = std::numeric_limits<float>::lowest();
+
+			for (uint32_t i = first; i < first + count; i++) {
+				const uint32_t tri = this->_triangles[i];
+				const auto& c = this->_centroids[tri];
+
+				bounds.grow(this->_bounds[tri].min, this->_bounds[tri].max);
+				cmin = {std::min(cmin.x, c.x), std::min(cmin.y, c.y), std::min(cmin.z, c.z)};
+				cmax = {std::max(cmax.x, c.x), std::max(cmax.y, c.y), std::max(cmax.z, c.z)};
+			}
+
+			bounds.count = count;
+
+			// Surface area heuristic, the best plane between bins on any axis
+			float bestCost = bounds.area() * static_cast<float>(count); // Cost of not splitting
+			int bestAxis = -1;
+			uint32_t bestSplit = 0;
+
+			const auto cminData = cmin.data();
+			const auto cmaxData = cmax.data();
+
+			for (int axis = 0; axis < 3; axis++) {
+				const float extent = cmaxData[axis] - cminData[axis];
+				if (extent <= 0.F) continue;
+
+				const float scale = static_cast<float>(BINS) / extent;
+				std::array<Bin, BINS> bins = {};
+
+				for (uint32_t i = first; i < first + count; i++) {
+					const uint32_t tri = this->_triangles[i];
+					const auto bin = std::min(static_cast<uint32_t>((this->_centroids[tri].data()[axis] - cminData[axis]) * scale), BINS - 1);
+
+					bins[bin].count++;
+					bins[bin].grow(this->_bounds[tri].min, this->_bounds[tri].max);
+				}
+
+				// Sweep from both sides, cost of splitting after bin i
+				std::array<float, BINS - 1> leftArea = {};
+				std::array<uint32_t, BINS - 1> leftCount = {};
+
+				Bin left = {};
+				for (uint32_t i = 0; i < BINS - 1; i++) {
+					left.count += bins[i].count;
+					if (bins[i].count > 0) left.grow(bins[i].min, bins[i].max);
+
+					leftArea[i] = left.area();
+					leftCount[i] = left.count;
+				}
+
+				Bin right = {};
+				for (uint32_t i = BINS - 1; i > 0; i--) {
+					right.count += bins[i].count;
+					if (bins[i].count > 0) right.grow(bins[i].min, bins[i].max);
+
+					if (leftCount[i - 1] == 0 || right.count == 0) continue;
+
+					const float cost = leftArea[i - 1] * static_cast<float>(leftCount[i - 1]) + right.area() * static_cast<float>(right.count);
+					if (cost < bestCost) {
+						bestCost = cost;
+						bestAxis = axis;
+						bestSplit = i;
+					}
+				}
+			}
+
+			if (bestAxis < 0) continue; // Splitting doesn't pay off, or all centroids are on the same spot
+
+			const float scale = static_cast<float>(BINS) / (cmaxData[bestAxis] - cminData[bestAxis]);
+			auto begin = this->_triangles.begin() + first;
+			auto middle = std::partition(begin, begin + count, [this, bestAxis, bestSplit, scale, &cminData](uint32_t tri) {
+				return std::min(static_cast<uint32_t>((this->_centroids[tri].data()[bestAxis] - cminData[bestAxis]) * scale), BINS - 1) < bestSplit;
+			});
+
+			const auto leftCount = static_cast<uint32_t>(middle - begin);
+			if (leftCount == 0 || leftCount == count) continue;
+
+			const auto left = static_cast<uint32_t>(this->_nodes.size());
+			this->_nodes[node].left = left;
+
+			this->_nodes.push_back({{}, {}, 0, first, leftCount});
+			this->_nodes.push_back({{}, {}, 0, first + leftCount, count - leftCount});
+
+			stack.emplace_back(left + 1, depth + 1);
+			stack.emplace_back(left, depth + 1);
+		}
+	}
+	// ------------
+
+	void TriangleBVH::build(std::vector<rawrbox::Vector3f> positions, std::vector<uint32_t> indices) {
+		this->clear();
+
+		this->_positions = std::move(positions);
+		this->_indices = std::move(indices);
+		this->_indices.resize(this->_indices.size() - this->_indices.size() % 3); // Drop incomplete triangles
+
+		const auto count = static_cast<uint32_t>(this->_indices.size() / 3);
+		if (count == 0) return;
+
+		this->_triangles.resize(count);
+		std::iota(this->_triangles.begin(), this->_triangles.end(), 0U);
+
+		this->_bounds.resize(count);
+		this->_centroids.resize(count);
+		for (uint32_t i = 0; i < count; i++) {
+			this->_bounds[i] = this->getTriangleBBOX(i);
+			this->_centroids[i] = (this->_bounds[i].min + this->_bounds[i].max) / 2.F;
+		}
+
+		this->_nodes.reserve(count * 2 / this->_leafSize + 1);
+		this->_nodes.push_back({{}, {}, 0, 0, count});
+		this->subdivide(0);
+		this->updateNodes();
+
+		this->_bounds.clear();
+		this->_bounds.shrink_to_fit();
+		this->_centroids.clear();
+		this->_centroids.shrink_to_fit();
+	}
+
+	void TriangleBVH::refit(const std::vector<rawrbox::Vector3f>& positions) {
+		if (positions.size() != this->_positions.size()) {
+			this->build(positions, this->_indices);
+			return;
+		}
+
+		this->_positions = positions;
+		if (!this->_nodes.empty()) this->updateNodes();
+	}
+
+	void TriangleBVH::clear() {
+		this->_nodes.clear();
+		this->_triangles.clear();
+		this->_positions.clear();
+		this->_indices.clear();
+		this->_centroids.clear();
+		this->_bounds.clear();
+	}
+
+	bool TriangleBVH::raycast(const rawrbox::Ray& ray, float maxDistance, rawrbox::RayHit& hit) const {
+		if (this->_nodes.empty()) return false;
+
+		float entry = 0.F;
+		if (!ray.intersects(this->_nodes[0].min, this->_nodes[0].max, maxDistance, entry)) return false;
+
+		float best = maxDistance;
+		bool found = false;
+
+		std::array<uint32_t, STACK_SIZE> stack = {};
+		size_t top = 0;
+		stack[top++] = 0;
+
+		while (top > 0) {
+			const auto& node = this->_nodes[stack[--top]];
+
+			if (node.isLeaf()) {
+				for (uint32_t i = node.first; i < node.first + node.count; i++) {
+					const uint32_t tri = this->_triangles[i];
+
+					float distance = 0.F;
+					float u = 0.F;
+					float v = 0.F;
+
+					if (!ray.intersects(this->_positions[this->_indices[tri * 3]], this->_positions[this->_indices[tri * 3 + 1]], this->_positions[this->_indices[tri * 3 + 2]], best, distance, u, v)) continue;
+
+					best = distance;
+					found = true;
+					hit = {distance, tri, u, v};
+				}
+
+				continue;
+			}
+
+			// Closest child first, so the farther one can be skipped once something closer is hit
+			const uint32_t a = node.left;
+			const uint32_t b = node.left + 1;
+
+			float entryA = 0.F;
+			float entryB = 0.F;
+			const bool hitA = ray.intersects(this->_nodes[a].min, this->_nodes[a].max, best, entryA);
+			const bool hitB = ray.intersects(this->_nodes[b].min, this->_nodes[b].max, best, entryB);
+
+			if (hitA && hitB) {
+				const bool aFirst = entryA <= entryB;
+				stack[top++] = aFirst ? b : a;
+				stack[top++] = aFirst ? a : b;
+			} else if (hitA) {
+				stack[top++] = a;
+			} else if (hitB) {
+				stack[top++] = b;
+			}
+		}
+
+		return found;
+	}
+
+	void TriangleBVH::query(const rawrbox::BBOX& bbox, std::vector<uint32_t>& out) const {
+		if (this->_nodes.empty()) return;
+
+		const auto overlaps = [&bbox](const rawrbox::Vector3f& min, const rawrbox::Vector3f& max) {
+			return min.x <= bbox.max.x && max.x >= bbox.min.x &&
+			       min.y <= bbox.max.y && max.y >= bbox.min.y &&
+			       min.z <= bbox.max.z && max.z >= bbox.min.z;
+		};
+
+		std::vector<uint32_t> stack = {0};
+		while (!stack.empty()) {
+			const auto& node = this->_nodes[stack.back()];
+			stack.pop_back();
+
+			if (!overlaps(node.min, node.max)) continue;
+
+			if (node.isLeaf()) {
+				for (uint32_t i = node.first; i < node.first + node.count; i++) {
+					const auto box = this->getTriangleBBOX(this->_triangles[i]);
+					if (overlaps(box.min, box.max)) out.push_back(this->_triangles[i]);
+				}
+			} else {
+				stack.push_back(node.left + 1);
+				stack.push_back(node.left);
+			}
+		}
+	}
+
+	rawrbox::BBOX TriangleBVH::getBBOX() const {
+		if (this->_nodes.empty()) return {};
+		return this->_nodes[0].getBBOX();
+	}
+
+	const std::vector<rawrbox::BVHNode>& TriangleBVH::getNodes() const { return this->_nodes; }
+	const std::vector<rawrbox::Vector3f>& TriangleBVH::getPositions() const { return this->_positions; }
+	const std::vector<uint32_t>& TriangleBVH::getIndices() const { return this->_indices; }
+
+	size_t TriangleBVH::size() const { return this->_triangles.size(); }
+	bool TriangleBVH::empty() const { return this->_triangles.empty(); }
+} // namespace rawrbox
@@ -0,0 +1,226 @@
+#include <rawrbox/math/utils/rect_packer.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace rawrbox {
+	namespace {
+		bool overlaps(const rawrbox::AABBu& a, const rawrbox::AABBu& b) {
+			return a.left() < b.right() && a.right() > b.left() && a.top() < b.bottom() && a.bottom() > b.top();
+		}
+
+		bool isContainedIn(const rawrbox::AABBu& a, const rawrbox::AABBu& b) {
+			return a.left() >= b.left() && a.top() >= b.top() && a.right() <= b.right() && a.bottom() <= b.bottom();
+		}
+
+		std::optional<rawrbox::AABBu> findPosition(const std::vector<rawrbox::AABBu>& free, uint32_t width, uint32_t height) {
+			if (width == 0 || height == 0) return std::nullopt;
+
+			std::optional<rawrbox::AABBu> best = std::nullopt;
+			uint32_t bestShort = std::numeric_limits<uint32_t>::max();
+			uint32_t bestLong = std::numeric_limits<uint32_t>::max();
+
+			for (const auto& rect : free) {
+				if (rect.size.x < width || rect.size.y < height) continue;
+
+				uint32_t leftX = rect.size.x - width;
+				uint32_t leftY = rect.size.y - height;
+				uint32_t shortSide = std::min(leftX, leftY);
+				uint32_t longSide = std::max(leftX, leftY);
+
+				if (shortSide < bestShort || (shortSide == bestShort && longSide < bestLong)) {
+					best = rawrbox::AABBu{rect.pos.x, rect.pos.y, width, height};
+					bestShort = shortSide;
+					bestLong = longSide;
+
+					if (shortSide == 0 && longSide == 0) break; // Perfect fit
+				}
+			}
+
+			return best;
+		}
+
+		void pruneFreeRects(std::vector<rawrbox::AABBu>& free, size_t firstNew) {
+			// Only the new rects can be redundant with something else
+			for (size_t i = firstNew; i < free.size();) {
+				bool contained = false;
+
+				for (size_t j = 0; j < free.size(); j++) {
+					if (i == j) continue;
+					if (!isContainedIn(free[i], free[j])) continue;
+					if (free[i] == free[j] && j > i) continue; // Keep one of the duplicates
+
+					contained = true;
+					break;
+				}
+
+				if (contained) {
+					free[i] = free.back();
+					free.pop_back();
+					continue;
+				}
+
+				i++;
+			}
+		}
+
+		void splitFreeRects(std::vector<rawrbox::AABBu>& free, std::vector<rawrbox::AABBu>& split, const rawrbox::AABBu& used) {
+			split.clear();
+
+			// Split every free rect the new one overlaps into the (up to 4) maximal rects around it
+			size_t kept = 0;
+			for (size_t i = 0; i < free.size(); i++) {
+				const auto rect = free[i];
+				if (!overlaps(rect, used)) {
+					free[kept++] = rect;
+					continue;
+				}
+
+				if (used.left() > rect.left()) split.emplace_back(rect.left(), rect.top(), used.left() - rect.left(), rect.size.y);
+				if (used.right() < rect.right()) split.emplace_back(used.right(), rect.top(), rect.right() - used.right(), rect.size.y);
+				if (used.top() > rect.top()) split.emplace_back(rect.left(), rect.top(), rect.size.x, used.top() - rect.top());
+				if (used.bottom() < rect.bottom()) split.emplace_back(rect.left(), used.bottom(), rect.size.x, rect.bottom() - used.bottom());
+			}
+
+			free.resize(kept);
+			free.insert(free.end(), split.begin(), split.end());
+
+			pruneFreeRects(free, kept);
+		}
+	} // namespace
+
+	RectPacker::RectPacker(const rawrbox::Vector2u& size) : _size(size) {
+		this->clear();
+	}
+
+	// PROTECTED ---
+	void RectPacker::buildFreeRects(std::vector<rawrbox::AABBu>& free, std::vector<rawrbox::AABBu>& split) const {
+		free.clear();
+		if (this->_size.x == 0 || this->_size.y == 0) return;
+
+		free.emplace_back(0U, 0U, this->_size.x, this->_size.y);
+		for (const auto& used : this->_used) {
+			if (used.size.x == 0) continue; // Unused slot
+			splitFreeRects(free, split, used);
+		}
+	}
+
+	void RectPacker::rebuildFreeRects() {
+		this->buildFreeRects(this->_free, this->_split);
+		this->_removed = 0;
+	}
+	// ------
+
+	bool RectPacker::canInsert(uint32_t width, uint32_t height) const {
+		if (findPosition(this->_free, width, height).has_value()) return true;
+		if (this->_removed == 0) return false; // Already maximal
+
+		std::vector<rawrbox::AABBu> free = {};
+		std::vector<rawrbox::AABBu> split = {};
+		this->buildFreeRects(free, split);
+
+		return findPosition(free, width, height).has_value();
+	}
+
+	std::optional<uint32_t> RectPacker::insert(uint32_t width, uint32_t height) {
+		auto pos = findPosition(this->_free, width, height);
+		if (!pos.has_value() && this->_removed > 0) {
+			this->rebuildFreeRects(); // Fragmented by the removes, might fit once merged
+			pos = findPosition(this->_free, width, height);
+		}
+
+		if (!pos.has_value()) return std::nullopt;
+
+		splitFreeRects(this->_free, this->_split, *pos);
+
+		uint32_t id = 0;
+		if (!this->_freeIds.empty()) {
+			id = this->_freeIds.back();
+			this->_freeIds.pop_back();
+			this->_used[id] = *pos;
+		} else {
+			id = static_cast<uint32_t>(this->_used.size());
+			this->_used.push_back(*pos);
+		}
+
+		this->_count++;
+		this->_usedArea += static_cast<uint64_t>(width) * height;
+
+		return id;
+	}
+
+	bool RectPacker::remove(uint32_t id) {
+		if (!this->valid(id)) return false;
+
+		auto rect = this->_used[id];
+		this->_used[id] = {};
+		this->_freeIds.push_back(id);
+
+		this->_count--;
+		this->_usedArea -= static_cast<uint64_t>(rect.size.x) * rect.size.y;
+
+		if (this->_count == 0) {
+			this->clear();
+			return true;
+		}
+
+		// Give the space back, along with its union with any free neighbour sharing a full edge. Others are merged on the next rebuild
+		std::erase_if(this->_free, [&rect](const rawrbox::AABBu& free) { return isContainedIn(free, rect); });
+
+		this->_split.clear();
+
+		for (const auto& free : this->_free) {
+			if (free.top() == rect.top() && free.size.y == rect.size.y && (free.right() == rect.left() || rect.right() == free.left())) {
+				this->_split.emplace_back(std::min(free.left(), rect.left()), rect.top(), free.size.x + rect.size.x, rect.size.y);
+			} else if (free.left() == rect.left() && free.size.x == rect.size.x && (free.bottom() == rect.top() || rect.bottom() == free.top())) {
+				this->_split.emplace_back(rect.left(), std::min(free.top(), rect.top()), rect.size.x, free.size.y + rect.size.y);
+			}
+		}
+
+		std::erase_if(this->_free, [this](const rawrbox::AABBu& free) {
+			return std::ranges::any_of(this->_split, [&free](const rawrbox::AABBu& merged) { return isContainedIn(free, merged); });
+		});
+
+		const size_t firstNew = this->_free.size();
+		this->_free.push_back(rect);
+		this->_free.insert(this->_free.end(), this->_split.begin(), this->_split.end());
+		pruneFreeRects(this->_free, firstNew);
+
+		// Rebuilding costs about as much as placing every rect again, so it's spread over as many removes
+		if (++this->_removed >= this->_count) this->rebuildFreeRects();
+		return true;
+	}
+
+	void RectPacker::clear() {
+		this->_free.clear();
+		this->_used.clear();
+		this->_freeIds.clear();
+
+		this->_count = 0;
+		this->_usedArea = 0;
+		this->_removed = 0;
+
+		if (this->_size.x > 0 && this->_size.y > 0) this->_free.emplace_back(0U, 0U, this->_size.x, this->_size.y);
+	}
+
+	const rawrbox::AABBu& RectPacker::get(uint32_t id) const {
+		if (!this->valid(id)) throw std::out_of_range("Invalid rect id");
+		return this->_used[id];
+	}
+
+	bool RectPacker::valid(uint32_t id) const {
+		return id < this->_used.size() && this->_used[id].size.x > 0;
+	}
+
+	const rawrbox::Vector2u& RectPacker::getSize() const { return this->_size; }
+	size_t RectPacker::size() const { return this->_count; }
+	bool RectPacker::empty() const { return this->_count == 0; }
+
+	float RectPacker::occupancy() const {
+		const auto total = static_cast<double>(this->_size.x) * this->_size.y;
+		if (total <= 0.0) return 0.F;
+
+		return static_cast<float>(static_cast<double>(this->_usedArea) / total);
+	}
+} // namespace rawrbox
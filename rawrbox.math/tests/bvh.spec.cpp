@@ -0,0 +1,202 @@
+#include <rawrbox/math/bvh.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+	std::vector<rawrbox::BBOX> randomBoxes(size_t count, float range, std::mt19937& rng) {
+		std::uniform_real_distribution<float> pos(-range, range);
+		std::uniform_real_distribution<float> size(0.1F, 2.F);
+
+		std::vector<rawrbox::BBOX> boxes = {};
+		boxes.reserve(count);
+
+		for (size_t i = 0; i < count; i++) {
+			const rawrbox::Vector3f min = {pos(rng), pos(rng), pos(rng)};
+			const rawrbox::Vector3f extent = {size(rng), size(rng), size(rng)};
+
+			boxes.emplace_back(min, min + extent, extent);
+		}
+
+		return boxes;
+	}
+
+	std::vector<uint32_t> bruteForce(const rawrbox::Frustum& frustum, const std::vector<rawrbox::BBOX>& boxes) {
+		std::vector<uint32_t> out = {};
+		for (size_t i = 0; i < boxes.size(); i++) {
+			if (frustum.containsBBOX(boxes[i])) out.push_back(static_cast<uint32_t>(i));
+		}
+
+		return out;
+	}
+
+	rawrbox::Frustum camera(const rawrbox::Vector3f& eye, const rawrbox::Vector3f& at, float far = 100.F) {
+		auto view = rawrbox::Matrix4x4::mtxLookAt(eye, at, {0, 1, 0});
+		auto proj = rawrbox::Matrix4x4::mtxProj(60.F, 16.F / 9.F, 0.1F, far);
+
+		return rawrbox::Frustum(proj * view);
+	}
+} // namespace
+
+TEST_CASE("BVH should behave as expected", "[rawrbox::BVH]") {
+	std::mt19937 rng(1337);
+	auto boxes = randomBoxes(5000, 100.F, rng);
+
+	rawrbox::BVH bvh;
+	bvh.build(boxes);
+
+	SECTION("rawrbox::BVH::build") {
+		REQUIRE(bvh.size() == boxes.size());
+
+		// Every node contains the boxes of its subtree
+		bool contained = true;
+		for (const auto& node : bvh.getNodes()) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				const auto& box = boxes[bvh.getIndices()[i]];
+
+				contained &= box.min.x >= node.min.x && box.min.y >= node.min.y && box.min.z >= node.min.z;
+				contained &= box.max.x <= node.max.x && box.max.y <= node.max.y && box.max.z <= node.max.z;
+			}
+		}
+
+		REQUIRE(contained);
+	}
+
+	SECTION("rawrbox::BVH::query") {
+		const std::vector<rawrbox::Frustum> cameras = {
+		    camera({0, 0, 0}, {0, 0, 1}),
+		    camera({-150, 20, -150}, {0, 0, 0}, 400.F), // Everything
+		    camera({0, 0, 0}, {1, 0.2F, 0}, 30.F),
+		    camera({500, 500, 500}, {1000, 1000, 1000}), // Nothing
+		};
+
+		for (const auto& frustum : cameras) {
+			std::vector<uint32_t> result = {};
+			bvh.query(frustum, result);
+			std::ranges::sort(result);
+
+			REQUIRE(result == bruteForce(frustum, boxes));
+		}
+	}
+
+	SECTION("rawrbox::BVH::getSubtrees") {
+		auto frustum = camera({0, 0, 0}, {0, 0, 1});
+
+		auto subtrees = bvh.getSubtrees(16);
+		REQUIRE(subtrees.size() >= 16);
+
+		std::vector<uint32_t> result = {};
+		for (auto node : subtrees) {
+			bvh.query(frustum, node, result);
+		}
+
+		std::ranges::sort(result);
+		REQUIRE(result == bruteForce(frustum, boxes));
+	}
+
+	SECTION("rawrbox::BVH::refit") {
+		for (auto& box : boxes) {
+			box.min.x += 50.F;
+			box.max.x += 50.F;
+		}
+
+		bvh.refit(boxes);
+
+		auto frustum = camera({0, 0, 0}, {1, 0, 0});
+		std::vector<uint32_t> result = {};
+		bvh.query(frustum, result);
+		std::ranges::sort(result);
+
+		REQUIRE(result == bruteForce(frustum, boxes));
+	}
+
+	SECTION("rawrbox::BVH::query bbox") {
+		rawrbox::BBOX area = {{-10, -10, -10}, {10, 10, 10}, {20, 20, 20}};
+
+		std::vector<uint32_t> result = {};
+		bvh.query(area, result);
+		std::ranges::sort(result);
+
+		std::vector<uint32_t> expected = {};
+		for (size_t i = 0; i < boxes.size(); i++) {
+			const auto& b = boxes[i];
+			if (b.min.x <= 10 && b.max.x >= -10 && b.min.y <= 10 && b.max.y >= -10 && b.min.z <= 10 && b.max.z >= -10) expected.push_back(static_cast<uint32_t>(i));
+		}
+
+		REQUIRE(result == expected);
+	}
+
+	SECTION("rawrbox::BVH::query ray") {
+		// Aimed at one of the boxes, so at least that one is hit
+		const rawrbox::Vector3f origin = {-150, 0, 0};
+		rawrbox::Ray ray(origin, (boxes[42].min + boxes[42].max) / 2.F - origin);
+
+		std::vector<std::pair<float, uint32_t>> result = {};
+		bvh.query(ray, 400.F, result);
+
+		std::vector<uint32_t> found = {};
+		for (const auto& hit : result) {
+			found.push_back(hit.second);
+		}
+		std::ranges::sort(found);
+
+		std::vector<uint32_t> expected = {};
+		for (size_t i = 0; i < boxes.size(); i++) {
+			float entry = 0.F;
+			if (ray.intersects(boxes[i], 400.F, entry)) expected.push_back(static_cast<uint32_t>(i));
+		}
+
+		REQUIRE_FALSE(expected.empty());
+		REQUIRE(found == expected);
+	}
+
+	SECTION("rawrbox::BVH same center") {
+		std::vector<rawrbox::BBOX> stacked(100, {{-1, -1, 9}, {1, 1, 11}, {2, 2, 2}});
+		bvh.build(stacked);
+
+		std::vector<uint32_t> result = {};
+		bvh.query(camera({0, 0, 0}, {0, 0, 1}), result);
+		REQUIRE(result.size() == 100);
+	}
+}
+
+TEST_CASE("BVH benchmark", "[rawrbox::BVH][.benchmark]") {
+	std::mt19937 rng(1337);
+	auto boxes = randomBoxes(1000000, 1000.F, rng);
+
+	rawrbox::BVH bvh;
+	bvh.build(boxes);
+
+	auto frustum = camera({0, 0, -1000}, {0, 0, 0}, 1000.F);
+	std::vector<uint32_t> result = {};
+	result.reserve(boxes.size());
+
+	BENCHMARK("Build (1M boxes)") {
+		rawrbox::BVH tmp;
+		tmp.build(boxes);
+		return tmp.size();
+	};
+
+	BENCHMARK("Refit (1M boxes)") {
+		bvh.refit(boxes);
+		return bvh.size();
+	};
+
+	BENCHMARK("Frustum query (1M boxes)") {
+		result.clear();
+		bvh.query(frustum, result);
+		return result.size();
+	};
+
+	BENCHMARK("Frustum brute force (1M boxes)") {
+		result.clear();
+		for (size_t i = 0; i < boxes.size(); i++) {
+			if (frustum.containsBBOX(boxes[i])) result.push_back(static_cast<uint32_t>(i));
+		}
+		return result.size();
+	};
+}
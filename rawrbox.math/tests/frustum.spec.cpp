@@ -0,0 +1,85 @@
+#include <rawrbox/math/frustum.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+
+TEST_CASE("Frustum should behave as expected", "[rawrbox::Frustum]") {
+	auto view = rawrbox::Matrix4x4::mtxLookAt({0, 0, 0}, {0, 0, 1}, {0, 1, 0});
+	auto proj = rawrbox::Matrix4x4::mtxProj(90.F, 1.F, 0.1F, 100.F);
+
+	rawrbox::Frustum frustum(proj * view);
+
+	SECTION("rawrbox::Frustum::containsPoint") {
+		REQUIRE(frustum.containsPoint({0, 0, 10}));
+		REQUIRE(frustum.containsPoint({5, 5, 10}));
+
+		REQUIRE_FALSE(frustum.containsPoint({0, 0, -10})); // Behind
+		REQUIRE_FALSE(frustum.containsPoint({0, 0, 200}));  // Past far
+		REQUIRE_FALSE(frustum.containsPoint({50, 0, 10}));  // Left / right
+		REQUIRE_FALSE(frustum.containsPoint({0, -50, 10})); // Top / bottom
+	}
+
+	SECTION("rawrbox::Frustum::containsSphere") {
+		REQUIRE(frustum.containsSphere({0, 0, 10}, 1.F));
+		REQUIRE(frustum.containsSphere({12, 0, 10}, 5.F)); // Partially inside
+
+		REQUIRE_FALSE(frustum.containsSphere({0, 0, -10}, 1.F));
+		REQUIRE_FALSE(frustum.containsSphere({30, 0, 10}, 5.F));
+	}
+
+	SECTION("rawrbox::Frustum::containsBBOX") {
+		REQUIRE(frustum.containsBBOX({{-1, -1, 9}, {1, 1, 11}, {2, 2, 2}}));
+		REQUIRE(frustum.containsBBOX({{-100, -100, 9}, {100, 100, 11}, {200, 200, 2}})); // Bigger than the view
+
+		REQUIRE_FALSE(frustum.containsBBOX({{-1, -1, -11}, {1, 1, -9}, {2, 2, 2}}));
+		REQUIRE_FALSE(frustum.containsBBOX({{40, -1, 9}, {42, 1, 11}, {2, 2, 2}}));
+	}
+
+	SECTION("rawrbox::Frustum::testBBOX") {
+		REQUIRE(frustum.testBBOX({{-1, -1, 9}, {1, 1, 11}, {2, 2, 2}}) == rawrbox::FrustumTest::INSIDE);
+		REQUIRE(frustum.testBBOX({{-100, -100, 9}, {100, 100, 11}, {200, 200, 2}}) == rawrbox::FrustumTest::INTERSECTS);
+		REQUIRE(frustum.testBBOX({{40, -1, 9}, {42, 1, 11}, {2, 2, 2}}) == rawrbox::FrustumTest::OUTSIDE);
+	}
+
+	SECTION("rawrbox::Frustum::cullSpheres") {
+		std::array<float, 5> x = {0, 12, 0, 30, 5};
+		std::array<float, 5> y = {0, 0, 0, 0, 5};
+		std::array<float, 5> z = {10, 10, -10, 10, 10};
+		std::array<float, 5> r = {1, 5, 1, 5, 0};
+		std::array<uint8_t, 5> visible = {};
+
+		frustum.cullSpheres(x.data(), y.data(), z.data(), r.data(), x.size(), visible.data());
+		for (size_t i = 0; i < x.size(); i++) {
+			REQUIRE(visible[i] == static_cast<uint8_t>(frustum.containsSphere({x[i], y[i], z[i]}, r[i])));
+		}
+	}
+
+	SECTION("rawrbox::Frustum::cullBoxes") {
+		const std::array<rawrbox::BBOX, 4> boxes = {{
+		    {{-1, -1, 9}, {1, 1, 11}, {2, 2, 2}},
+		    {{-100, -100, 9}, {100, 100, 11}, {200, 200, 2}},
+		    {{-1, -1, -11}, {1, 1, -9}, {2, 2, 2}},
+		    {{40, -1, 9}, {42, 1, 11}, {2, 2, 2}},
+		}};
+
+		std::array<std::array<float, 4>, 3> center = {};
+		std::array<std::array<float, 4>, 3> extent = {};
+		for (size_t i = 0; i < boxes.size(); i++) {
+			const auto c = ((boxes[i].min + boxes[i].max) / 2.F).data();
+			const auto e = ((boxes[i].max - boxes[i].min) / 2.F).data();
+
+			for (size_t axis = 0; axis < 3; axis++) {
+				center[axis][i] = c[axis];
+				extent[axis][i] = e[axis];
+			}
+		}
+
+		std::array<uint8_t, 4> visible = {};
+		frustum.cullBoxes(center[0].data(), center[1].data(), center[2].data(), extent[0].data(), extent[1].data(), extent[2].data(), boxes.size(), visible.data());
+
+		for (size_t i = 0; i < boxes.size(); i++) {
+			REQUIRE(visible[i] == static_cast<uint8_t>(frustum.containsBBOX(boxes[i])));
+		}
+	}
+}
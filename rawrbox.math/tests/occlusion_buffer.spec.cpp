@@ -0,0 +1,42 @@
+#include <rawrbox/math/occlusion_buffer.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("OcclusionBuffer should behave as expected", "[rawrbox::OcclusionBuffer]") {
+	auto view = rawrbox::Matrix4x4::mtxLookAt({0, 0, 0}, {0, 0, 1}, {0, 1, 0});
+	auto proj = rawrbox::Matrix4x4::mtxProj(90.F, 1.F, 0.1F, 100.F);
+
+	rawrbox::OcclusionBuffer buffer(128, 128);
+	buffer.begin(proj * view);
+
+	SECTION("rawrbox::OcclusionBuffer::isVisible") {
+		// Nothing drawn yet
+		REQUIRE(buffer.isVisible({{-1, -1, 19}, {1, 1, 21}, {2, 2, 2}}));
+		REQUIRE_FALSE(buffer.isVisible({{200, -1, 19}, {202, 1, 21}, {2, 2, 2}})); // Off screen
+		REQUIRE(buffer.isVisible({{-1, -1, -1}, {1, 1, 1}, {2, 2, 2}}));          // Crossing the near plane
+	}
+
+	SECTION("rawrbox::OcclusionBuffer::addOccluder") {
+		buffer.addOccluder({{-5, -5, 10}, {5, 5, 11}, {10, 10, 1}}); // Wall in front
+
+		REQUIRE_FALSE(buffer.isVisible({{-1, -1, 19}, {1, 1, 21}, {2, 2, 2}})); // Behind it
+		REQUIRE(buffer.isVisible({{-1, -1, 5}, {1, 1, 6}, {2, 2, 1}}));          // In front of it
+		REQUIRE(buffer.isVisible({{8, -1, 19}, {10, 1, 21}, {2, 2, 2}}));        // Behind, but peeking out on the side
+		REQUIRE(buffer.isVisible({{-2, -2, 8}, {2, 2, 12}, {4, 4, 4}}));         // Crossing the wall
+
+		// Behind the wall, but bigger than it on screen
+		REQUIRE(buffer.isVisible({{-30, -1, 40}, {30, 1, 41}, {60, 2, 1}}));
+	}
+
+	SECTION("rawrbox::OcclusionBuffer::begin") {
+		buffer.addOccluder({{-5, -5, 10}, {5, 5, 11}, {10, 10, 1}});
+		buffer.begin(proj * view);
+
+		REQUIRE(buffer.isVisible({{-1, -1, 19}, {1, 1, 21}, {2, 2, 2}}));
+	}
+
+	SECTION("rawrbox::OcclusionBuffer near occluder") {
+		buffer.addOccluder({{-5, -5, -1}, {5, 5, 1}, {10, 10, 2}}); // Crosses the near plane, ignored
+		REQUIRE(buffer.isVisible({{-1, -1, 19}, {1, 1, 21}, {2, 2, 2}}));
+	}
+}
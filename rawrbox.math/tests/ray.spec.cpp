@@ -0,0 +1,69 @@
+#include <rawrbox/math/ray.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+TEST_CASE("Ray should behave as expected", "[rawrbox::Ray]") {
+	rawrbox::Ray ray({0, 0, -10}, {0, 0, 2});
+
+	SECTION("rawrbox::Ray") {
+		REQUIRE(ray.getDirection() == rawrbox::Vector3f(0, 0, 1)); // Normalized
+		REQUIRE(ray.at(5.F) == rawrbox::Vector3f(0, 0, -5));
+	}
+
+	SECTION("rawrbox::Ray::intersects (bbox)") {
+		float entry = 0.F;
+
+		REQUIRE(ray.intersects(rawrbox::BBOX{{-1, -1, -1}, {1, 1, 1}, {2, 2, 2}}, 100.F, entry));
+		REQUIRE_THAT(entry, Catch::Matchers::WithinAbs(9.F, 0.001F));
+
+		REQUIRE_FALSE(ray.intersects(rawrbox::BBOX{{-1, -1, -1}, {1, 1, 1}, {2, 2, 2}}, 5.F, entry)); // Too far
+		REQUIRE_FALSE(ray.intersects(rawrbox::BBOX{{2, 2, -1}, {3, 3, 1}, {1, 1, 2}}, 100.F, entry));
+		REQUIRE_FALSE(ray.intersects(rawrbox::BBOX{{-1, -1, -20}, {1, 1, -15}, {2, 2, 5}}, 100.F, entry)); // Behind
+
+		// Starting inside
+		rawrbox::Ray inside({0, 0, 0}, {1, 0, 0});
+		REQUIRE(inside.intersects(rawrbox::BBOX{{-1, -1, -1}, {1, 1, 1}, {2, 2, 2}}, 100.F, entry));
+		REQUIRE(entry == 0.F);
+	}
+
+	SECTION("rawrbox::Ray::intersects (triangle)") {
+		float distance = 0.F;
+		float u = 0.F;
+		float v = 0.F;
+
+		REQUIRE(ray.intersects({-1, -1, 0}, {1, -1, 0}, {-1, 1, 0}, 100.F, distance, u, v));
+		REQUIRE_THAT(distance, Catch::Matchers::WithinAbs(10.F, 0.001F));
+		REQUIRE_THAT(u, Catch::Matchers::WithinAbs(0.5F, 0.001F));
+		REQUIRE_THAT(v, Catch::Matchers::WithinAbs(0.5F, 0.001F));
+
+		REQUIRE(ray.intersects({-1, -1, 0}, {-1, 1, 0}, {1, -1, 0}, 100.F, distance, u, v)); // Back face
+		REQUIRE_FALSE(ray.intersects({1, 1, 0}, {2, 1, 0}, {1, 2, 0}, 100.F, distance, u, v));
+		REQUIRE_FALSE(ray.intersects({-1, -1, 0}, {1, -1, 0}, {-1, 1, 0}, 5.F, distance, u, v));
+	}
+
+	SECTION("rawrbox::Ray::transform") {
+		auto matrix = rawrbox::Matrix4x4::mtxSRT({1, 1, 1}, {0, 0, 0, 1}, {5, 0, 0});
+		auto local = ray.transform(matrix);
+
+		REQUIRE(local.getOrigin() == rawrbox::Vector3f(5, 0, -10));
+		REQUIRE(local.getDirection() == rawrbox::Vector3f(0, 0, 1));
+	}
+
+	SECTION("rawrbox::Ray::fromScreen") {
+		auto view = rawrbox::Matrix4x4::mtxLookAt({0, 0, 0}, {0, 0, 1}, {0, 1, 0});
+		auto proj = rawrbox::Matrix4x4::mtxProj(90.F, 1.F, 0.1F, 100.F);
+		auto inv = rawrbox::Matrix4x4::mtxInverse(proj * view);
+
+		auto center = rawrbox::Ray::fromScreen({50, 50}, {100, 100}, inv);
+		REQUIRE_THAT(center.getDirection().x, Catch::Matchers::WithinAbs(0.F, 0.001F));
+		REQUIRE_THAT(center.getDirection().y, Catch::Matchers::WithinAbs(0.F, 0.001F));
+		REQUIRE_THAT(center.getDirection().z, Catch::Matchers::WithinAbs(1.F, 0.001F));
+
+		// Top left corner, 90 fov
+		auto corner = rawrbox::Ray::fromScreen({0, 0}, {100, 100}, inv);
+		REQUIRE(corner.getDirection().z > 0.F);
+		REQUIRE_THAT(std::abs(corner.getDirection().x), Catch::Matchers::WithinAbs(corner.getDirection().z, 0.001F));
+		REQUIRE(corner.getDirection().y > 0.F);
+	}
+}
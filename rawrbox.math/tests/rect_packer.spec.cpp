@@ -0,0 +1,203 @@
+#include <rawrbox/math/utils/rect_packer.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <random>
+
+namespace {
+	bool noOverlaps(const rawrbox::RectPacker& packer, const std::vector<uint32_t>& ids) {
+		for (size_t i = 0; i < ids.size(); i++) {
+			const auto& a = packer.get(ids[i]);
+			if (a.right() > packer.getSize().x || a.bottom() > packer.getSize().y) return false;
+
+			for (size_t j = i + 1; j < ids.size(); j++) {
+				const auto& b = packer.get(ids[j]);
+				if (a.left() < b.right() && a.right() > b.left() && a.top() < b.bottom() && a.bottom() > b.top()) return false;
+			}
+		}
+
+		return true;
+	}
+
+	std::vector<uint32_t> fillRandom(rawrbox::RectPacker& packer, std::mt19937& rng, uint32_t minSize, uint32_t maxSize) {
+		std::uniform_int_distribution<uint32_t> dist(minSize, maxSize);
+		std::vector<uint32_t> ids = {};
+
+		size_t failures = 0;
+		while (failures < 64) {
+			auto id = packer.insert(dist(rng), dist(rng));
+			if (!id.has_value()) {
+				failures++;
+				continue;
+			}
+
+			ids.push_back(*id);
+		}
+
+		return ids;
+	}
+
+	// Slow, tries every position against every used rect
+	bool fitsAnywhere(const rawrbox::RectPacker& packer, const std::vector<uint32_t>& ids, uint32_t width, uint32_t height) {
+		const auto& size = packer.getSize();
+		if (width > size.x || height > size.y) return false;
+
+		for (uint32_t y = 0; y <= size.y - height; y++) {
+			for (uint32_t x = 0; x <= size.x - width; x++) {
+				bool fits = std::ranges::none_of(ids, [&](uint32_t id) {
+					const auto& b = packer.get(id);
+					return x < b.right() && x + width > b.left() && y < b.bottom() && y + height > b.top();
+				});
+
+				if (fits) return true;
+			}
+		}
+
+		return false;
+	}
+} // namespace
+
+TEST_CASE("RectPacker should behave as expected", "[rawrbox::RectPacker]") {
+	SECTION("rawrbox::RectPacker::insert") {
+		rawrbox::RectPacker packer({64, 64});
+
+		auto a = packer.insert(32, 32);
+		auto b = packer.insert(32, 32);
+		auto c = packer.insert(64, 32);
+
+		REQUIRE(a.has_value());
+		REQUIRE(b.has_value());
+		REQUIRE(c.has_value());
+		REQUIRE(packer.size() == 3);
+		REQUIRE(packer.occupancy() == 1.F);
+
+		REQUIRE_FALSE(packer.canInsert(1, 1));
+		REQUIRE_FALSE(packer.insert(1, 1).has_value());
+		REQUIRE_FALSE(packer.insert(0, 0).has_value());
+		REQUIRE(noOverlaps(packer, {*a, *b, *c}));
+	}
+
+	SECTION("rawrbox::RectPacker::remove") {
+		rawrbox::RectPacker packer({64, 64});
+
+		auto a = packer.insert(32, 64);
+		auto b = packer.insert(32, 64);
+		REQUIRE_FALSE(packer.canInsert(32, 32));
+
+		REQUIRE(packer.remove(*a));
+		REQUIRE_FALSE(packer.remove(*a));
+		REQUIRE_FALSE(packer.valid(*a));
+
+		// Freed space and ids are reused
+		auto c = packer.insert(32, 32);
+		auto d = packer.insert(32, 32);
+		REQUIRE(c.has_value());
+		REQUIRE(d.has_value());
+		REQUIRE(*c == *a);
+		REQUIRE(noOverlaps(packer, {*b, *c, *d}));
+
+		REQUIRE(packer.remove(*b));
+		REQUIRE(packer.remove(*c));
+		REQUIRE(packer.remove(*d));
+		REQUIRE(packer.empty());
+		REQUIRE(packer.canInsert(64, 64));
+	}
+
+	SECTION("rawrbox::RectPacker fragmentation") {
+		rawrbox::RectPacker packer({64, 64});
+
+		// a | b
+		// a | c
+		// e e e
+		auto a = packer.insert(32, 32);
+		auto b = packer.insert(32, 16);
+		auto c = packer.insert(32, 16);
+		auto e = packer.insert(64, 32);
+		REQUIRE(packer.occupancy() == 1.F);
+
+		// Freed next to each other, but no full edge in common
+		REQUIRE(packer.remove(*a));
+		REQUIRE(packer.remove(*b));
+
+		REQUIRE(packer.canInsert(64, 16));
+		auto row = packer.insert(64, 16);
+		REQUIRE(row.has_value());
+		REQUIRE(packer.get(*row).pos == rawrbox::Vector2u{0, 0});
+		REQUIRE(noOverlaps(packer, {*c, *e, *row}));
+
+		// Churn, whatever fits somewhere can be inserted
+		std::mt19937 rng(1337);
+		std::uniform_int_distribution<uint32_t> dist(1, 24);
+
+		rawrbox::RectPacker churn({64, 64});
+		auto ids = fillRandom(churn, rng, 4, 16);
+
+		for (int round = 0; round < 20; round++) {
+			std::shuffle(ids.begin(), ids.end(), rng);
+			for (size_t i = 0; i < ids.size() / 3; i++) {
+				REQUIRE(churn.remove(ids.back()));
+				ids.pop_back();
+			}
+
+			for (int i = 0; i < 8; i++) {
+				const uint32_t width = dist(rng);
+				const uint32_t height = dist(rng);
+
+				const bool fits = fitsAnywhere(churn, ids, width, height);
+				REQUIRE(churn.canInsert(width, height) == fits);
+
+				auto id = churn.insert(width, height);
+				REQUIRE(id.has_value() == fits);
+				if (id.has_value()) ids.push_back(*id);
+			}
+
+			REQUIRE(noOverlaps(churn, ids));
+		}
+	}
+
+	SECTION("rawrbox::RectPacker::occupancy") {
+		std::mt19937 rng(1337);
+		rawrbox::RectPacker packer({512, 512});
+
+		auto ids = fillRandom(packer, rng, 8, 32);
+		REQUIRE(noOverlaps(packer, ids));
+		REQUIRE(packer.occupancy() > 0.85F);
+
+		// Remove half of them, then refill
+		std::shuffle(ids.begin(), ids.end(), rng);
+		for (size_t i = 0; i < ids.size() / 2; i++) {
+			REQUIRE(packer.remove(ids[i]));
+		}
+
+		ids.erase(ids.begin(), ids.begin() + static_cast<std::ptrdiff_t>(ids.size() / 2));
+		auto refill = fillRandom(packer, rng, 8, 32);
+		ids.insert(ids.end(), refill.begin(), refill.end());
+
+		REQUIRE(noOverlaps(packer, ids));
+		REQUIRE(packer.occupancy() > 0.75F);
+	}
+}
+
+TEST_CASE("RectPacker benchmark", "[rawrbox::RectPacker][.benchmark]") {
+	std::mt19937 rng(1337);
+
+	BENCHMARK("Insert random glyphs (1024x1024, 8-48px)") {
+		rawrbox::RectPacker packer({1024, 1024});
+		fillRandom(packer, rng, 8, 48);
+		return packer.occupancy();
+	};
+
+	BENCHMARK("Insert / remove churn (1024x1024, 8-48px)") {
+		rawrbox::RectPacker packer({1024, 1024});
+		auto ids = fillRandom(packer, rng, 8, 48);
+
+		for (size_t i = 0; i < ids.size(); i += 2) {
+			packer.remove(ids[i]);
+		}
+
+		fillRandom(packer, rng, 8, 48);
+		return packer.occupancy();
+	};
+}
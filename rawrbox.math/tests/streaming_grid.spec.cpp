@@ -0,0 +1,169 @@
+#include <rawrbox/math/streaming_grid.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <vector>
+
+namespace {
+	// 100x100 cells, 10 units each
+	void fillWorld(rawrbox::StreamingGrid& grid) {
+		for (int z = 0; z < 100; z++) {
+			for (int x = 0; x < 100; x++) {
+				grid.addCell({x, z});
+			}
+		}
+	}
+} // namespace
+
+TEST_CASE("StreamingGrid should behave as expected", "[rawrbox::StreamingGrid]") {
+	rawrbox::StreamingGrid grid(10.F, 50.F, 70.F);
+
+	std::vector<rawrbox::Vector2i> load = {};
+	std::vector<rawrbox::Vector2i> unload = {};
+
+	SECTION("rawrbox::StreamingGrid::key") {
+		REQUIRE(rawrbox::StreamingGrid::fromKey(rawrbox::StreamingGrid::key({-5, 12})) == rawrbox::Vector2i{-5, 12});
+		REQUIRE(rawrbox::StreamingGrid::fromKey(rawrbox::StreamingGrid::key({7, -3})) == rawrbox::Vector2i{7, -3});
+		REQUIRE(rawrbox::StreamingGrid::key({1, 0}) != rawrbox::StreamingGrid::key({0, 1}));
+
+		REQUIRE(grid.getCell({-0.5F, 100.F, 25.F}) == rawrbox::Vector2i{-1, 2});
+	}
+
+	SECTION("rawrbox::StreamingGrid::update") {
+		fillWorld(grid);
+		REQUIRE(grid.size() == 10000);
+
+		grid.update(load, unload);
+		REQUIRE(load.empty()); // No activators
+
+		grid.setActivator(0, {500.F, 0.F, 500.F});
+		grid.update(load, unload);
+
+		REQUIRE_FALSE(load.empty());
+		REQUIRE(unload.empty());
+		REQUIRE(grid.loadedCount() == load.size());
+		REQUIRE(grid.isLoaded({50, 50}));
+		REQUIRE_FALSE(grid.isLoaded({60, 50}));
+
+		// Closest first
+		REQUIRE(grid.getDistance(grid.getCellCenter(load.front())) <= grid.getDistance(grid.getCellCenter(load.back())));
+
+		// Nothing changed
+		grid.update(load, unload);
+		REQUIRE(load.empty());
+		REQUIRE(unload.empty());
+	}
+
+	SECTION("rawrbox::StreamingGrid hysteresis") {
+		grid.addCell({0, 0});
+		grid.setActivator(0, {5.F, 0.F, 5.F});
+		grid.update(load, unload);
+		REQUIRE(grid.isLoaded({0, 0}));
+
+		// Past the load radius, but not the unload one
+		grid.setActivator(0, {65.F, 0.F, 5.F});
+		grid.update(load, unload);
+		REQUIRE(unload.empty());
+		REQUIRE(grid.isLoaded({0, 0}));
+
+		grid.setActivator(0, {80.F, 0.F, 5.F});
+		grid.update(load, unload);
+		REQUIRE(unload.size() == 1);
+		REQUIRE_FALSE(grid.isLoaded({0, 0}));
+	}
+
+	SECTION("rawrbox::StreamingGrid::cancelLoad") {
+		grid.addCell({0, 0});
+		grid.setActivator(0, {5.F, 0.F, 5.F});
+		grid.update(load, unload);
+		REQUIRE(load.size() == 1);
+
+		// Loading it failed, offered again
+		grid.cancelLoad({0, 0});
+		REQUIRE_FALSE(grid.isLoaded({0, 0}));
+		REQUIRE(grid.hasCell({0, 0}));
+
+		grid.update(load, unload);
+		REQUIRE(load.size() == 1);
+		REQUIRE(unload.empty());
+		REQUIRE(grid.isLoaded({0, 0}));
+	}
+
+	SECTION("rawrbox::StreamingGrid budget") {
+		rawrbox::StreamingGrid limited(10.F, 50.F, 70.F, 4);
+		fillWorld(limited);
+
+		limited.setActivator(0, {500.F, 0.F, 500.F});
+
+		size_t total = 0;
+		for (int i = 0; i < 100; i++) {
+			limited.update(load, unload);
+			REQUIRE(load.size() <= 4);
+
+			total += load.size();
+			if (load.empty()) break;
+		}
+
+		fillWorld(grid);
+		grid.setActivator(0, {500.F, 0.F, 500.F});
+		grid.update(load, unload);
+
+		REQUIRE(total == load.size());
+		REQUIRE(limited.loadedCount() == grid.loadedCount());
+	}
+
+	SECTION("rawrbox::StreamingGrid moving activators") {
+		fillWorld(grid);
+
+		// Two players walking across the world, loaded cells always match the radius
+		for (int step = 0; step <= 100; step++) {
+			const float t = static_cast<float>(step) * 10.F;
+			grid.setActivator(0, {t, 0.F, 250.F});
+			grid.setActivator(1, {1000.F - t, 0.F, 750.F});
+			grid.update(load, unload);
+
+			for (int z = 0; z < 100; z++) {
+				for (int x = 0; x < 100; x++) {
+					const float distance = grid.getDistance(grid.getCellCenter({x, z}));
+					if (distance <= 50.F) REQUIRE(grid.isLoaded({x, z}));
+					if (distance > 70.F) REQUIRE_FALSE(grid.isLoaded({x, z}));
+				}
+			}
+		}
+
+		grid.removeActivator(0);
+		grid.removeActivator(1);
+		grid.update(load, unload);
+		REQUIRE(grid.loadedCount() == 0);
+
+		grid.setActivator(0, {500.F, 0.F, 500.F});
+		grid.update(load, unload);
+		grid.unloadAll(unload);
+		REQUIRE(unload.size() == load.size());
+		REQUIRE(grid.loadedCount() == 0);
+
+		grid.clear();
+		REQUIRE(grid.size() == 0);
+	}
+}
+
+TEST_CASE("StreamingGrid benchmark", "[rawrbox::StreamingGrid][.benchmark]") {
+	rawrbox::StreamingGrid grid(10.F, 100.F, 120.F);
+	fillWorld(grid);
+
+	std::vector<rawrbox::Vector2i> load = {};
+	std::vector<rawrbox::Vector2i> unload = {};
+
+	int step = 0;
+	BENCHMARK("Update (10k cells, 4 moving activators)") {
+		const float t = static_cast<float>(step++ % 100) * 10.F;
+		for (uint32_t i = 0; i < 4; i++) {
+			grid.setActivator(i, {t, 0.F, 125.F + static_cast<float>(i) * 250.F});
+		}
+
+		grid.update(load, unload);
+		return load.size() + unload.size();
+	};
+}
@@ -0,0 +1,205 @@
+#include <rawrbox/math/triangle_bvh.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+	// Bumpy grid, like a terrain
+	void grid(size_t size, std::vector<rawrbox::Vector3f>& positions, std::vector<uint32_t>& indices, float time = 0.F) {
+		positions.clear();
+		indices.clear();
+
+		for (size_t z = 0; z <= size; z++) {
+			for (size_t x = 0; x <= size; x++) {
+				const auto fx = static_cast<float>(x);
+				const auto fz = static_cast<float>(z);
+
+				positions.emplace_back(fx, std::sin(fx * 0.3F + time) * std::cos(fz * 0.2F) * 3.F, fz);
+			}
+		}
+
+		const auto row = static_cast<uint32_t>(size + 1);
+		for (uint32_t z = 0; z < size; z++) {
+			for (uint32_t x = 0; x < size; x++) {
+				const uint32_t i = z * row + x;
+				indices.insert(indices.end(), {i, i + row, i + 1, i + 1, i + row, i + row + 1});
+			}
+		}
+	}
+
+	rawrbox::RayHit bruteForce(const rawrbox::Ray& ray, const std::vector<rawrbox::Vector3f>& positions, const std::vector<uint32_t>& indices) {
+		rawrbox::RayHit best = {};
+
+		for (uint32_t tri = 0; tri < indices.size() / 3; tri++) {
+			float distance = 0.F;
+			float u = 0.F;
+			float v = 0.F;
+
+			if (ray.intersects(positions[indices[tri * 3]], positions[indices[tri * 3 + 1]], positions[indices[tri * 3 + 2]], best.distance, distance, u, v)) {
+				best = {distance, tri, u, v};
+			}
+		}
+
+		return best;
+	}
+
+	std::vector<rawrbox::Ray> randomRays(size_t count, float size, std::mt19937& rng) {
+		std::uniform_real_distribution<float> pos(0.F, size);
+		std::uniform_real_distribution<float> dir(-1.F, 1.F);
+
+		std::vector<rawrbox::Ray> rays = {};
+		rays.reserve(count);
+
+		for (size_t i = 0; i < count; i++) {
+			rays.emplace_back(rawrbox::Vector3f{pos(rng), 20.F, pos(rng)}, rawrbox::Vector3f{dir(rng), -1.F, dir(rng)});
+		}
+
+		return rays;
+	}
+} // namespace
+
+TEST_CASE("TriangleBVH should behave as expected", "[rawrbox::TriangleBVH]") {
+	std::vector<rawrbox::Vector3f> positions = {};
+	std::vector<uint32_t> indices = {};
+	grid(64, positions, indices);
+
+	rawrbox::TriangleBVH bvh;
+	bvh.build(positions, indices);
+
+	std::mt19937 rng(1337);
+	const auto rays = randomRays(500, 64.F, rng);
+
+	SECTION("rawrbox::TriangleBVH::build") {
+		REQUIRE(bvh.size() == indices.size() / 3);
+		REQUIRE(bvh.getNodes().size() > 1);
+
+		const auto bbox = bvh.getBBOX();
+		REQUIRE(bbox.min.x == 0.F);
+		REQUIRE(bbox.max.x == 64.F);
+		REQUIRE(bbox.min.z == 0.F);
+		REQUIRE(bbox.max.z == 64.F);
+	}
+
+	SECTION("rawrbox::TriangleBVH::raycast") {
+		bool same = true;
+		size_t hits = 0;
+
+		for (const auto& ray : rays) {
+			const auto expected = bruteForce(ray, positions, indices);
+
+			rawrbox::RayHit hit = {};
+			const bool found = bvh.raycast(ray, 1000.F, hit);
+
+			same &= found == expected.valid();
+			if (!found || !expected.valid()) continue;
+
+			hits++;
+			same &= std::abs(hit.distance - expected.distance) < 0.001F;
+
+			// Two triangles can share the hit point on an edge, compare the points instead of the ids
+			const auto point = [&](const rawrbox::RayHit& h) {
+				const auto& a = positions[indices[h.triangle * 3]];
+				const auto& b = positions[indices[h.triangle * 3 + 1]];
+				const auto& c = positions[indices[h.triangle * 3 + 2]];
+
+				return a * (1.F - h.u - h.v) + b * h.u + c * h.v;
+			};
+
+			same &= point(hit).distance(point(expected)) < 0.001F;
+		}
+
+		REQUIRE(hits > 0);
+		REQUIRE(same);
+
+		// Pointing away / too short
+		rawrbox::RayHit hit = {};
+		REQUIRE_FALSE(bvh.raycast(rawrbox::Ray({32, 20, 32}, {0, 1, 0}), 1000.F, hit));
+		REQUIRE_FALSE(bvh.raycast(rawrbox::Ray({32, 20, 32}, {0, -1, 0}), 5.F, hit));
+
+		REQUIRE(bvh.raycast(rawrbox::Ray({32.25F, 20, 32.25F}, {0, -1, 0}), 1000.F, hit));
+		REQUIRE_THAT(hit.u + hit.v, Catch::Matchers::WithinAbs(0.5F, 0.001F)); // On the shared edge of the quad
+	}
+
+	SECTION("rawrbox::TriangleBVH::refit") {
+		grid(64, positions, indices, 1.5F);
+		bvh.refit(positions);
+
+		bool same = true;
+		for (const auto& ray : rays) {
+			const auto expected = bruteForce(ray, positions, indices);
+
+			rawrbox::RayHit hit = {};
+			const bool found = bvh.raycast(ray, 1000.F, hit);
+
+			same &= found == expected.valid();
+			if (found && expected.valid()) same &= std::abs(hit.distance - expected.distance) < 0.001F;
+		}
+
+		REQUIRE(same);
+	}
+
+	SECTION("rawrbox::TriangleBVH::query") {
+		std::vector<uint32_t> result = {};
+		bvh.query(rawrbox::BBOX{{10.1F, -10.F, 10.1F}, {10.9F, 10.F, 10.9F}, {0.8F, 20.F, 0.8F}}, result);
+		REQUIRE(result.size() == 2); // One quad
+
+		result.clear();
+		bvh.query(rawrbox::BBOX{{100.F, -10.F, 100.F}, {110.F, 10.F, 110.F}, {10.F, 20.F, 10.F}}, result);
+		REQUIRE(result.empty());
+	}
+
+	SECTION("rawrbox::TriangleBVH::clear") {
+		bvh.clear();
+
+		rawrbox::RayHit hit = {};
+		REQUIRE(bvh.empty());
+		REQUIRE_FALSE(bvh.raycast(rays.front(), 1000.F, hit));
+	}
+}
+
+TEST_CASE("TriangleBVH benchmark", "[rawrbox::TriangleBVH][.benchmark]") {
+	std::vector<rawrbox::Vector3f> positions = {};
+	std::vector<uint32_t> indices = {};
+	grid(512, positions, indices); // ~524k triangles
+
+	std::mt19937 rng(1337);
+	const auto rays = randomRays(10000, 512.F, rng);
+
+	rawrbox::TriangleBVH bvh;
+	bvh.build(positions, indices);
+
+	BENCHMARK("Build (524k triangles)") {
+		rawrbox::TriangleBVH other;
+		other.build(positions, indices);
+		return other.size();
+	};
+
+	BENCHMARK("Refit (524k triangles)") {
+		bvh.refit(positions);
+		return bvh.size();
+	};
+
+	BENCHMARK("Raycast (10k rays)") {
+		size_t hits = 0;
+		for (const auto& ray : rays) {
+			rawrbox::RayHit hit = {};
+			hits += bvh.raycast(ray, 1000.F, hit) ? 1 : 0;
+		}
+
+		return hits;
+	};
+
+	BENCHMARK("Brute force (100 rays)") {
+		size_t hits = 0;
+		for (size_t i = 0; i < 100; i++) {
+			hits += bruteForce(rays[i], positions, indices).valid() ? 1 : 0;
+		}
+
+		return hits;
+	};
+}
@@ -1,21 +1,24 @@
 #pragma once
 #include <rawrbox/engine/static.hpp>
 #include <rawrbox/math/vector3.hpp>
+#include <rawrbox/physics_2d/world.hpp>
 #include <rawrbox/utils/event.hpp>
 
 #include <fmt/format.h>
 #include <muli/muli.h>
 
 #include <memory>
+#include <vector>
 
 namespace rawrbox {
+	// Default world, more can be created with PhysicsWorld2D
 	class PHYSICS_2D {
 	protected:
-		static void checkContacts();
+		static std::unique_ptr<rawrbox::PhysicsWorld2D> _world;
 
 	public:
-		static std::unique_ptr<muli::WorldSettings> physSettings;
-		static std::unique_ptr<muli::World> physWorld;
+		static std::unique_ptr<muli::WorldSettings> physSettings; // Used on init
+		static muli::World* physWorld;
 
 		// EVENTS -----
 		static rawrbox::Event<const muli::ContactManifold&> onContact;
@@ -25,5 +28,10 @@ namespace rawrbox {
 		static void shutdown();
 
 		static void tick(); // Should be tick based update
+
+		// Steps all the given worlds at the same time, on the async pool
+		static void tick(const std::vector<rawrbox::PhysicsWorld2D*>& worlds);
+
+		[[nodiscard]] static rawrbox::PhysicsWorld2D& getWorld();
 	};
 } // namespace rawrbox
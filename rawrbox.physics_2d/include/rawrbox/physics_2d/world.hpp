@@ -0,0 +1,38 @@
+#pragma once
+#include <rawrbox/utils/event.hpp>
+
+#include <muli/muli.h>
+
+#include <memory>
+
+namespace rawrbox {
+	// One independent 2D simulation, with its own bodies and events
+	//
+	// rawrbox::PhysicsWorld2D match = {};
+	// match.getWorld().CreateBox(1.F);
+	// rawrbox::PHYSICS_2D::tick({&match, &other}); // Both step at the same time
+	class PhysicsWorld2D {
+	protected:
+		std::unique_ptr<muli::World> _world = nullptr;
+
+		void checkContacts();
+
+	public:
+		bool simulate = true;
+
+		// EVENTS -----
+		rawrbox::Event<const muli::ContactManifold&> onContact;
+		// ----
+
+		explicit PhysicsWorld2D(const muli::WorldSettings& settings = {});
+		PhysicsWorld2D(const PhysicsWorld2D&) = delete;
+		PhysicsWorld2D(PhysicsWorld2D&&) = delete;
+		PhysicsWorld2D& operator=(const PhysicsWorld2D&) = delete;
+		PhysicsWorld2D& operator=(PhysicsWorld2D&&) = delete;
+		virtual ~PhysicsWorld2D() = default;
+
+		void tick(); // Should be tick based update
+
+		[[nodiscard]] muli::World& getWorld() const;
+	};
+} // namespace rawrbox
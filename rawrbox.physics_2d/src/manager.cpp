@@ -1,10 +1,16 @@
-
 #include <rawrbox/physics_2d/manager.hpp>
+#include <rawrbox/utils/logger.hpp>
+#include <rawrbox/utils/profiler.hpp>
+#include <rawrbox/utils/threading.hpp>
 
 namespace rawrbox {
+	// PROTECTED ----
+	std::unique_ptr<rawrbox::PhysicsWorld2D> PHYSICS_2D::_world = nullptr;
+	// -----
+
 	// PUBLIC ----
 	std::unique_ptr<muli::WorldSettings> PHYSICS_2D::physSettings = std::make_unique<muli::WorldSettings>();
-	std::unique_ptr<muli::World> PHYSICS_2D::physWorld = nullptr;
+	muli::World* PHYSICS_2D::physWorld = nullptr;
 
 	// EVENTS -----
 	rawrbox::Event<const muli::ContactManifold&> PHYSICS_2D::onContact = {};
@@ -12,33 +18,39 @@ namespace rawrbox {
 	// -----
 
 	void PHYSICS_2D::init() {
-		physWorld = std::make_unique<muli::World>(*physSettings); // Setup world
+		_world = std::make_unique<rawrbox::PhysicsWorld2D>(*physSettings); // Setup world
+		physWorld = &_world->getWorld();
 	}
 
 	void PHYSICS_2D::shutdown() {
+		physWorld = nullptr;
+
 		physSettings.reset();
-		physWorld.reset();
+		_world.reset();
 	}
 
 	void PHYSICS_2D::tick() {
-		if (physWorld == nullptr) return;
+		if (_world == nullptr) return;
 
-		physWorld->Step(rawrbox::FIXED_DELTA_TIME);
-		checkContacts();
+		// Forward to the static event, only while someone listens to it so contacts are not walked for nothing
+		if (onContact.empty() != _world->onContact.empty()) {
+			_world->onContact.clear();
+			if (!onContact.empty()) _world->onContact += [](const muli::ContactManifold& manifold) { onContact(manifold); };
+		}
+
+		_world->tick();
 	}
 
-	void PHYSICS_2D::checkContacts() {
-		if (physWorld == nullptr || onContact.empty()) return;
+	void PHYSICS_2D::tick(const std::vector<rawrbox::PhysicsWorld2D*>& worlds) {
+		RAWRBOX_PROFILE_ZONE("PHYSICS_2D::tick (worlds)");
 
-		const muli::Contact* c = physWorld->GetContacts();
-		while (c != nullptr) {
-			if (!c->IsTouching()) {
-				c = c->GetNext();
-				continue;
-			}
+		rawrbox::ASYNC::loop(0, worlds.size(), [&worlds](size_t i) {
+			worlds[i]->tick();
+		});
+	}
 
-			onContact(c->GetContactManifold());
-			c = c->GetNext();
-		}
+	rawrbox::PhysicsWorld2D& PHYSICS_2D::getWorld() {
+		if (_world == nullptr) RAWRBOX_CRITICAL("[RawrBox-Physics2D] Physics not initialized");
+		return *_world;
 	}
 } // namespace rawrbox
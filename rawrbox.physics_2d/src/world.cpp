@@ -0,0 +1,34 @@
+#include <rawrbox/engine/static.hpp>
+#include <rawrbox/physics_2d/world.hpp>
+#include <rawrbox/utils/profiler.hpp>
+
+namespace rawrbox {
+	PhysicsWorld2D::PhysicsWorld2D(const muli::WorldSettings& settings) : _world(std::make_unique<muli::World>(settings)) {}
+
+	// PROTECTED ----
+	void PhysicsWorld2D::checkContacts() {
+		if (this->onContact.empty()) return;
+
+		const muli::Contact* c = this->_world->GetContacts();
+		while (c != nullptr) {
+			if (!c->IsTouching()) {
+				c = c->GetNext();
+				continue;
+			}
+
+			this->onContact(c->GetContactManifold());
+			c = c->GetNext();
+		}
+	}
+	// -------------
+
+	void PhysicsWorld2D::tick() {
+		if (!this->simulate) return;
+		RAWRBOX_PROFILE_ZONE("PhysicsWorld2D::tick");
+
+		this->_world->Step(rawrbox::FIXED_DELTA_TIME);
+		this->checkContacts();
+	}
+
+	muli::World& PhysicsWorld2D::getWorld() const { return *this->_world; }
+} // namespace rawrbox
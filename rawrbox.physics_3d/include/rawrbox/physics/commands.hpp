@@ -0,0 +1,104 @@
+#pragma once
+
+#include <rawrbox/math/vector3.hpp>
+#include <rawrbox/math/vector4.hpp>
+#include <rawrbox/utils/batch_buffer.hpp>
+#include <rawrbox/utils/command_buffer.hpp>
+
+#include <Jolt/Jolt.h>
+//--
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Body/BodyID.h>
+#include <Jolt/Physics/Body/BodyInterface.h>
+//---
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace rawrbox {
+	// Body created through PhysicsCommands, usable right away. Resolves to a JPH::BodyID once the commands are applied
+	struct PhysicsHandle {
+		uint32_t id = 0;
+
+		[[nodiscard]] bool isValid() const { return this->id != 0; }
+		bool operator==(const rawrbox::PhysicsHandle& other) const = default;
+	};
+
+	// A handle, or a body that already exists
+	struct PhysicsBodyRef {
+		uint32_t handle = 0;
+		JPH::BodyID body = {};
+
+		PhysicsBodyRef(const rawrbox::PhysicsHandle& handle) : handle(handle.id) {} // NOLINT(hicpp-explicit-conversions)
+		PhysicsBodyRef(const JPH::BodyID& body) : body(body) {}                     // NOLINT(hicpp-explicit-conversions)
+	};
+
+	enum class PhysicsCommandType : uint8_t {
+		CREATE,
+		DESTROY,
+		SET_TRANSFORM,
+		SET_VELOCITY,
+		ADD_IMPULSE,
+		ACTIVATE,
+		DEACTIVATE
+	};
+
+	struct PhysicsCommand {
+		rawrbox::PhysicsCommandType type = rawrbox::PhysicsCommandType::ACTIVATE;
+		uint32_t handle = 0; // 0 = use body
+		JPH::BodyID body = {};
+
+		uint32_t settings = 0; // CREATE, index in the settings batch
+		JPH::EActivation activation = JPH::EActivation::Activate;
+
+		rawrbox::Vector3f vec = {};  // Position / linear velocity / impulse
+		rawrbox::Vector3f vec2 = {}; // Angular velocity
+		rawrbox::Vector4f rotation = {};
+	};
+
+	// Deferred body changes, recorded from any thread (jobs, scripts...) without touching the Jolt body locks
+	// Everything gets applied in record order in a single pass, through the no lock body interface, right before the world updates
+	//
+	// auto crate = world.commands.create(settings);
+	// world.commands.addImpulse(crate, {0, 10, 0}); // Fine, even before it exists
+	// world.tick(); // Applies, then updates
+	// JPH::BodyID id = world.commands.get(crate);
+	class PhysicsCommands {
+	protected:
+		rawrbox::CommandBuffer<rawrbox::PhysicsCommand> _commands;
+		rawrbox::BatchBuffer<JPH::BodyCreationSettings> _settings; // Too big to carry in every command
+
+		std::vector<JPH::BodyCreationSettings> _created = {};
+		std::unordered_map<uint32_t, JPH::BodyID> _handles = {};
+		std::unordered_set<uint32_t> _destroyed = {}; // In the current apply, their ids are stale (and the slot can already be reused)
+
+		[[nodiscard]] JPH::BodyID resolve(const rawrbox::PhysicsCommand& command) const;
+		void push(rawrbox::PhysicsCommandType type, const rawrbox::PhysicsBodyRef& body, rawrbox::PhysicsCommand command = {});
+
+	public:
+		explicit PhysicsCommands(size_t capacity = 1024);
+
+		// Any thread ---
+		[[nodiscard]] rawrbox::PhysicsHandle create(const JPH::BodyCreationSettings& settings, JPH::EActivation activation = JPH::EActivation::DontActivate);
+		void destroy(const rawrbox::PhysicsBodyRef& body);
+
+		void setTransform(const rawrbox::PhysicsBodyRef& body, const rawrbox::Vector3f& pos, const rawrbox::Vector4f& rotation, JPH::EActivation activation = JPH::EActivation::Activate);
+		void setVelocity(const rawrbox::PhysicsBodyRef& body, const rawrbox::Vector3f& linear, const rawrbox::Vector3f& angular = {});
+		void addImpulse(const rawrbox::PhysicsBodyRef& body, const rawrbox::Vector3f& impulse);
+
+		void activate(const rawrbox::PhysicsBodyRef& body);
+		void deactivate(const rawrbox::PhysicsBodyRef& body);
+		// ---
+
+		// Only while the world is NOT updating (PhysicsWorld::tick does it right before), with GetBodyInterfaceNoLock
+		void apply(JPH::BodyInterface& bodyInterface);
+		// Drops the pending commands and forgets every handle
+		void clear();
+
+		// Invalid until the create is applied, or once it's destroyed. Same thread as apply
+		[[nodiscard]] JPH::BodyID get(const rawrbox::PhysicsHandle& handle) const;
+		[[nodiscard]] size_t size() const;
+	};
+} // namespace rawrbox
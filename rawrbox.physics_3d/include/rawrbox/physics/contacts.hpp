@@ -0,0 +1,101 @@
+#pragma once
+
+#include <rawrbox/math/vector3.hpp>
+#include <rawrbox/utils/batch_buffer.hpp>
+#include <rawrbox/utils/event.hpp>
+#include <rawrbox/utils/small_function.hpp>
+
+#include <Jolt/Jolt.h>
+//--
+#include <Jolt/Physics/Body/BodyID.h>
+#include <Jolt/Physics/Collision/ObjectLayer.h>
+#include <Jolt/Physics/Collision/Shape/SubShapeID.h>
+//---
+
+#include <cstdint>
+#include <vector>
+
+namespace rawrbox {
+	enum class ContactType : uint8_t {
+		ADDED = 1 << 0,
+		PERSISTED = 1 << 1,
+		REMOVED = 1 << 2
+	};
+
+	// Plain copy of a Jolt contact, body1 is always the lower body id
+	struct PhysicsContact {
+		rawrbox::ContactType type = rawrbox::ContactType::ADDED;
+
+		JPH::BodyID body1 = {};
+		JPH::BodyID body2 = {};
+		JPH::SubShapeID subShape1 = {};
+		JPH::SubShapeID subShape2 = {};
+
+		// Unset on REMOVED (cObjectLayerInvalid / 0), the bodies can't be read anymore by then
+		JPH::ObjectLayer layer1 = JPH::cObjectLayerInvalid;
+		JPH::ObjectLayer layer2 = JPH::cObjectLayerInvalid;
+		uint64_t userData1 = 0;
+		uint64_t userData2 = 0;
+
+		rawrbox::Vector3f point = {};  // World space, deepest point on body1
+		rawrbox::Vector3f normal = {}; // From body1 to body2
+		float depth = 0.F;
+		float speed = 0.F; // Closing speed along the normal, Jolt doesn't expose the solved impulse to listeners
+
+		[[nodiscard]] bool operator<(const rawrbox::PhysicsContact& other) const;
+	};
+
+	struct PhysicsContactFilter {
+		uint8_t types = 0xFF;          // ContactType mask
+		uint32_t layers = 0xFFFFFFFF;  // Object layer mask, either body on one of them (REMOVED always passes)
+		JPH::BodyID body = {};         // Invalid = any
+
+		[[nodiscard]] bool matches(const rawrbox::PhysicsContact& contact) const;
+	};
+
+	// Contacts are recorded by the Jolt workers into a lock free buffer, then sorted (so the order doesn't depend on the threads)
+	// and dispatched on the thread that called tick, once the update is over
+	// Unlike the PhysicsWorld onContactXXX events, handlers can do anything here (add / remove bodies, touch the game state...)
+	//
+	// world.contacts.listen({.body = player}, [](const rawrbox::PhysicsContact& contact) { ... });
+	class PhysicsContacts {
+	public:
+		using Func = rawrbox::SmallFunction<void(const rawrbox::PhysicsContact&)>;
+
+	protected:
+		struct Listener {
+			uint64_t id = 0;
+			rawrbox::PhysicsContactFilter filter = {};
+			Func func = nullptr;
+		};
+
+		rawrbox::BatchBuffer<rawrbox::PhysicsContact> _buffer;
+		std::vector<rawrbox::PhysicsContact> _contacts = {}; // Of the last dispatch, sorted
+
+		std::vector<Listener> _listeners = {};
+		std::vector<Listener> _pending = {}; // Added while dispatching
+		uint64_t _lastId = 0;
+
+		bool _dispatching = false;
+		bool _record = false;
+
+	public:
+		explicit PhysicsContacts(size_t capacity = 1024);
+
+		// Any thread (called by the Jolt workers)
+		void push(rawrbox::PhysicsContact contact);
+		// Only record when someone is going to read them
+		[[nodiscard]] bool recording() const;
+		// Keep recording without listeners, to read them with get()
+		void setRecording(bool record);
+
+		// Sorts the batch and calls the listeners, on the calling thread
+		void dispatch();
+
+		rawrbox::EventToken listen(const rawrbox::PhysicsContactFilter& filter, Func func);
+		bool remove(const rawrbox::EventToken& token);
+		void clear();
+
+		[[nodiscard]] const std::vector<rawrbox::PhysicsContact>& get() const;
+	};
+} // namespace rawrbox
@@ -2,6 +2,7 @@
 
 #include <rawrbox/engine/static.hpp>
 #include <rawrbox/math/vector3.hpp>
+#include <rawrbox/physics/world.hpp>
 #include <rawrbox/utils/event.hpp>
 
 // Jolt includes
@@ -23,80 +24,31 @@
 
 #include <fmt/format.h>
 
+#include <array>
 #include <memory>
+#include <vector>
 
 using namespace JPH::literals; // If you want your code to compile using single or double precision write 0.0_r to get a Real value that compiles to double or float depending if JPH_DOUBLE_PRECISION is set or not.
 
 namespace rawrbox {
-	enum class PHYS_LAYERS : JPH::ObjectLayer {
-		STATIC = 0,
-		DYNAMIC = 1
-	};
-
-	class LayerFilter : public JPH::ObjectLayerPairFilter {
-	public:
-		[[nodiscard]] bool ShouldCollide(JPH::ObjectLayer inObject1, JPH::ObjectLayer inObject2) const override {
-			switch (static_cast<rawrbox::PHYS_LAYERS>(inObject1)) {
-				case rawrbox::PHYS_LAYERS::STATIC:
-					return static_cast<PHYS_LAYERS>(inObject2) == rawrbox::PHYS_LAYERS::DYNAMIC;
-				case rawrbox::PHYS_LAYERS::DYNAMIC:
-					return true;
-				default:
-					return false;
-			}
-		}
-	};
-
-	class BPLayerInterface final : public JPH::BroadPhaseLayerInterface {
-	protected:
-		std::vector<JPH::BroadPhaseLayer> _objectToBroadPhase = {};
-
-	public:
-		BPLayerInterface() {
-			// Create a mapping table from object to broad phase layer
-			constexpr auto phys = magic_enum::enum_values<rawrbox::PHYS_LAYERS>();
-			for (PHYS_LAYERS p : phys)
-				this->_objectToBroadPhase.emplace_back(static_cast<uint8_t>(p));
-		}
-
-		[[nodiscard]] uint32_t GetNumBroadPhaseLayers() const override {
-			return static_cast<uint32_t>(this->_objectToBroadPhase.size());
-		}
-
-		[[nodiscard]] JPH::BroadPhaseLayer GetBroadPhaseLayer(JPH::ObjectLayer inLayer) const override {
-			if (inLayer >= this->_objectToBroadPhase.size()) throw std::runtime_error(fmt::format("[RawrBox-Physics] Missing physics layer {}!", inLayer));
-			return this->_objectToBroadPhase[inLayer];
-		}
-
-#if defined(JPH_EXTERNAL_PROFILE) || defined(JPH_PROFILE_ENABLED)
-		[[nodiscard]] const char* GetBroadPhaseLayerName(JPH::BroadPhaseLayer inLayer) const override {
-			auto a = static_cast<uint8_t>(inLayer);
-			const auto* name = magic_enum::enum_name(static_cast<rawrbox::PHYS_LAYERS>(a)).data();
-			return name;
-		}
-#endif
-	};
-
-	class BodyActivationListener;
-	class ContactListener;
-	class BPLayerFilter;
-
+	// Default world and the shared bits (factory, job system, layers) every PhysicsWorld uses
 	class PHYSICS {
 	protected:
 		static std::unique_ptr<JPH::JobSystemThreadPool> _threadPool;
 		static std::unique_ptr<JPH::Factory> _factory;
+		static uint32_t _maxWorlds;
 
 		static const std::unique_ptr<rawrbox::BPLayerInterface> _bpLayerInterface;
-		static const std::unique_ptr<rawrbox::BPLayerFilter> _bpLayerFilter;
 		static const std::unique_ptr<rawrbox::LayerFilter> _layerFilter;
 
-		static std::unique_ptr<rawrbox::BodyActivationListener> _bodyListener;
-		static std::unique_ptr<rawrbox::ContactListener> _contactListener;
+		static std::unique_ptr<rawrbox::PhysicsWorld> _world;
+		static std::array<rawrbox::EventToken, 5> _forwards; // Default world -> static events
 
 	public:
 		// VARS ----
-		static std::unique_ptr<JPH::TempAllocatorImpl> allocator;
-		static std::unique_ptr<JPH::PhysicsSystem> physicsSystem;
+		// Of the default world
+		static JPH::TempAllocatorImpl* allocator;
+		static JPH::PhysicsSystem* physicsSystem;
 
 		static JPH::Ref<JPH::Shape> rayBoxShape;
 
@@ -114,64 +66,25 @@ namespace rawrbox {
 		static rawrbox::Event<const JPH::SubShapeIDPair&> onContactRemoved;
 		// ----
 
-		static void init(uint32_t mbAlloc = 20, uint32_t maxBodies = 2048, uint32_t maxBodyMutexes = 2048, uint32_t maxBodyPairs = 2048, uint32_t maxContactConstraints = 2048, uint32_t maxThreads = 0);
+		// Hooks up the static events to the default world, only the ones with handlers (so empty ones cost nothing on the solver threads)
+		// Done by tick, call it when ticking the default world yourself
+		static void forwardEvents();
+
+		// maxWorlds is how many worlds can tick at the same time on the job system
+		static void init(uint32_t mbAlloc = 20, uint32_t maxBodies = 2048, uint32_t maxBodyMutexes = 2048, uint32_t maxBodyPairs = 2048, uint32_t maxContactConstraints = 2048, uint32_t maxThreads = 0, uint32_t maxWorlds = 8);
 		static void shutdown();
 
 		static void clear();
 		static void tick();     // Should be tick based update
 		static void optimize(); // Call only when a lot of bodies are added at a single time
-	};
-
-	class BPLayerFilter : public JPH::ObjectVsBroadPhaseLayerFilter {
-	public:
-		[[nodiscard]] bool ShouldCollide(JPH::ObjectLayer inLayer1, JPH::BroadPhaseLayer inLayer2) const override {
-			auto layer1 = static_cast<rawrbox::PHYS_LAYERS>(inLayer1);
-			auto layer2 = static_cast<rawrbox::PHYS_LAYERS>(static_cast<uint8_t>(inLayer2));
-
-			if (PHYSICS::shouldCollide == nullptr) {
-				switch (layer1) {
-					case rawrbox::PHYS_LAYERS::STATIC:
-						return layer2 == rawrbox::PHYS_LAYERS::DYNAMIC;
-					case rawrbox::PHYS_LAYERS::DYNAMIC:
-						return true;
-					default:
-						return false;
-				}
-			} else {
-				return PHYSICS::shouldCollide(layer1, layer2);
-			}
-		}
-	};
 
-	class BodyActivationListener : public JPH::BodyActivationListener {
-	public:
-		void OnBodyActivated(const JPH::BodyID& inBodyID, uint64_t inBodyUserData) override {
-			PHYSICS::onBodyAwake(inBodyID, inBodyUserData);
-		}
+		// Steps all the given worlds at the same time, on the async pool (each world still splits its own step on the job system)
+		// Only maxWorlds (see init) step at once, the rest wait for the next batch. The default world follows steps / simulate like tick()
+		static void tick(const std::vector<rawrbox::PhysicsWorld*>& worlds);
 
-		void OnBodyDeactivated(const JPH::BodyID& inBodyID, uint64_t inBodyUserData) override {
-			PHYSICS::onBodySleep(inBodyID, inBodyUserData);
-		}
-	};
-
-	class ContactListener : public JPH::ContactListener {
-	public:
-		// See: ContactListener
-		JPH::ValidateResult OnContactValidate(const JPH::Body& inBody1, const JPH::Body& inBody2, JPH::RVec3Arg inBaseOffset, const JPH::CollideShapeResult& inCollisionResult) override {
-			if (rawrbox::PHYSICS::onContactValidate == nullptr) return JPH::ValidateResult::AcceptAllContactsForThisBodyPair;
-			return rawrbox::PHYSICS::onContactValidate(inBody1, inBody2, inBaseOffset, inCollisionResult);
-		}
-
-		void OnContactAdded(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings) override {
-			rawrbox::PHYSICS::onContactAdded(inBody1, inBody2, inManifold, ioSettings);
-		}
-
-		void OnContactPersisted(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings) override {
-			rawrbox::PHYSICS::onContactPersisted(inBody1, inBody2, inManifold, ioSettings);
-		}
-
-		void OnContactRemoved(const JPH::SubShapeIDPair& inSubShapePair) override {
-			rawrbox::PHYSICS::onContactRemoved(inSubShapePair);
-		}
+		[[nodiscard]] static rawrbox::PhysicsWorld& getWorld();
+		[[nodiscard]] static JPH::JobSystem* getJobSystem();
+		[[nodiscard]] static const rawrbox::BPLayerInterface& getBPLayerInterface();
+		[[nodiscard]] static const rawrbox::LayerFilter& getLayerFilter();
 	};
 } // namespace rawrbox
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <rawrbox/math/streaming_grid.hpp>
+#include <rawrbox/physics/world.hpp>
+
+#include <Jolt/Jolt.h>
+//--
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Body/BodyInterface.h>
+//---
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace rawrbox {
+	// What the last update did
+	struct PhysicsPartitionStats {
+		size_t cellsLoaded = 0;
+		size_t cellsUnloaded = 0;
+		size_t bodiesAdded = 0;
+		size_t bodiesRemoved = 0;
+
+		size_t frozen = 0; // Total, not just this update
+		size_t woken = 0;
+		bool optimized = false;
+	};
+
+	// Streams the static bodies of a big world in / out by grid cell, around activators (ex: players)
+	// A loaded cell gets all its bodies added in a single batch (AddBodiesPrepare / Finalize), so maxBodies only needs to fit the loaded area
+	// The broadphase is optimized on its own once enough bodies got added since the last time
+	//
+	// Dynamic bodies far from every activator get frozen (deactivated, velocities kept), and resume when one gets close again
+	// Jolt steps every active body at the same rate, so they can't just be stepped less often, and their ground might get unloaded anyways
+	//
+	// partition.addStatic(floorSettings); // Before / during play, sorted into cells by position
+	// partition.addDynamic(crate);
+	// partition.setActivator(playerId, playerPos);
+	// partition.update(); // Right before PHYSICS::tick
+	class PhysicsPartition {
+	protected:
+		struct Frozen {
+			JPH::Vec3 linear = {};
+			JPH::Vec3 angular = {};
+		};
+
+		rawrbox::PhysicsWorld* _world = nullptr;
+		rawrbox::StreamingGrid _grid;
+
+		std::unordered_map<uint64_t, std::vector<JPH::BodyCreationSettings>> _statics = {};
+		std::unordered_map<uint64_t, JPH::BodyIDVector> _bodies = {}; // Of the loaded cells
+
+		JPH::BodyIDVector _dynamic = {};
+		std::unordered_map<uint32_t, Frozen> _frozen = {}; // By body index and sequence
+
+		float _lodDistance = 0.F;
+		uint32_t _lodInterval = 10;
+		uint64_t _ticks = 0;
+
+		size_t _dirty = 0; // Bodies added since the last optimize
+		rawrbox::PhysicsPartitionStats _stats = {};
+
+		// Scratch, kept between updates
+		std::vector<rawrbox::Vector2i> _load = {};
+		std::vector<rawrbox::Vector2i> _unload = {};
+		JPH::BodyIDVector _batch = {};
+
+		[[nodiscard]] rawrbox::PhysicsWorld& getWorld() const;
+
+		void loadCells();
+		void unloadCells();
+		void updateLOD();
+
+	public:
+		// Bodies added before the broadphase gets optimized
+		size_t optimizeThreshold = 256;
+
+		// Cells load within loadRadius, unload past unloadRadius. cellsPerTick spreads big loads over a few ticks
+		explicit PhysicsPartition(float cellSize = 64.F, float loadRadius = 256.F, float unloadRadius = 320.F, size_t cellsPerTick = 8, rawrbox::PhysicsWorld* world = nullptr);
+		PhysicsPartition(const PhysicsPartition&) = delete;
+		PhysicsPartition(PhysicsPartition&&) = delete;
+		PhysicsPartition& operator=(const PhysicsPartition&) = delete;
+		PhysicsPartition& operator=(PhysicsPartition&&) = delete;
+		~PhysicsPartition() = default;
+
+		// STATIC ---
+		// The body gets created when its cell loads, and destroyed when it unloads
+		void addStatic(const JPH::BodyCreationSettings& settings);
+		// ---
+
+		// DYNAMIC ---
+		// Added by the caller, the partition only freezes / wakes it
+		void addDynamic(const JPH::BodyID& id);
+		void removeDynamic(const JPH::BodyID& id);
+
+		// Frozen past distance (clamped to the load radius), checked every interval ticks
+		void setLOD(float distance, uint32_t interval = 10);
+		// ---
+
+		// ACTIVATORS ---
+		void setActivator(uint32_t id, const rawrbox::Vector3f& pos);
+		void removeActivator(uint32_t id);
+		// ---
+
+		void update();
+		// Removes every streamed body, wakes the frozen ones and forgets everything
+		void clear();
+
+		[[nodiscard]] bool isFrozen(const JPH::BodyID& id) const;
+		[[nodiscard]] size_t getLoadedBodies() const;
+		[[nodiscard]] const rawrbox::PhysicsPartitionStats& getStats() const;
+		[[nodiscard]] const rawrbox::StreamingGrid& getGrid() const;
+	};
+} // namespace rawrbox
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <rawrbox/physics/world.hpp>
+#include <rawrbox/utils/event.hpp>
+#include <rawrbox/utils/snapshot_ring.hpp>
+
+#include <Jolt/Jolt.h>
+//--
+#include <Jolt/Physics/StateRecorderImpl.h>
+//---
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace rawrbox {
+	// Applies the inputs of the given frame (forces, impulses, velocities...), right before it gets simulated
+	using PhysicsInput = std::function<void(uint64_t frame)>;
+
+	// Snapshot / rollback of a PhysicsWorld (the PHYSICS one by default), saving the whole Jolt state (bodies, contacts, constraints) every tick
+	// Jolt only restores the state of existing bodies, bodies added or removed after a frame are NOT rolled back with it
+	//
+	// rollback.save(); // After the scene is loaded
+	// rollback.tick([](uint64_t frame) { applyInputs(frame); }); // Instead of PHYSICS::tick
+	// rollback.resimulate(lateFrame, applyInputs); // A late input arrived, redo from that frame
+	class PhysicsRollback {
+	protected:
+		rawrbox::PhysicsWorld* _world = nullptr;
+
+		rawrbox::SnapshotRing _snapshots;
+		JPH::StateRecorderImpl _recorder = {};
+		uint64_t _frame = 0;
+
+		[[nodiscard]] rawrbox::PhysicsWorld& getWorld() const;
+
+	public:
+		explicit PhysicsRollback(size_t frames = 64, size_t keyframeInterval = 16, rawrbox::PhysicsWorld* world = nullptr);
+
+		// frame, local hash, remote hash
+		rawrbox::Event<uint64_t, uint32_t, uint32_t> onDesync;
+
+		// Records the current state as the current frame
+		void save();
+		// Runs the input of the current frame, ticks the world and records the next frame
+		void tick(const rawrbox::PhysicsInput& input = nullptr);
+
+		// Back to an earlier frame, every frame after it is dropped
+		bool restore(uint64_t frame);
+		// Restores the given frame, then ticks back up to the current one
+		bool resimulate(uint64_t frame, const rawrbox::PhysicsInput& input = nullptr);
+
+		// Compares against the hash of the same frame from somewhere else (ex: the server), fires onDesync if they differ
+		bool validate(uint64_t frame, uint32_t hash);
+
+		void clear();
+
+		[[nodiscard]] std::optional<uint32_t> getHash(uint64_t frame) const;
+		[[nodiscard]] uint64_t getFrame() const;
+		[[nodiscard]] const rawrbox::SnapshotRing& getSnapshots() const;
+
+		// CRC of every body position, rotation and velocity, in body id order
+		[[nodiscard]] static uint32_t hash(const rawrbox::PhysicsWorld& world);
+	};
+} // namespace rawrbox
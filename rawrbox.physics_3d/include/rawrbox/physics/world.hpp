@@ -0,0 +1,164 @@
+#pragma once
+
+#include <rawrbox/physics/commands.hpp>
+#include <rawrbox/physics/contacts.hpp>
+#include <rawrbox/utils/event.hpp>
+
+// Jolt includes
+#include <Jolt/Jolt.h>
+//--
+#include <Jolt/Core/TempAllocator.h>
+#include <Jolt/Physics/Body/BodyActivationListener.h>
+#include <Jolt/Physics/Collision/ContactListener.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+//---
+
+#include <magic_enum.hpp>
+
+#include <fmt/format.h>
+
+#include <functional>
+#include <memory>
+
+namespace rawrbox {
+	enum class PHYS_LAYERS : JPH::ObjectLayer {
+		STATIC = 0,
+		DYNAMIC = 1
+	};
+
+	class LayerFilter : public JPH::ObjectLayerPairFilter {
+	public:
+		[[nodiscard]] bool ShouldCollide(JPH::ObjectLayer inObject1, JPH::ObjectLayer inObject2) const override {
+			switch (static_cast<rawrbox::PHYS_LAYERS>(inObject1)) {
+				case rawrbox::PHYS_LAYERS::STATIC:
+					return static_cast<PHYS_LAYERS>(inObject2) == rawrbox::PHYS_LAYERS::DYNAMIC;
+				case rawrbox::PHYS_LAYERS::DYNAMIC:
+					return true;
+				default:
+					return false;
+			}
+		}
+	};
+
+	class BPLayerInterface final : public JPH::BroadPhaseLayerInterface {
+	protected:
+		std::vector<JPH::BroadPhaseLayer> _objectToBroadPhase = {};
+
+	public:
+		BPLayerInterface() {
+			// Create a mapping table from object to broad phase layer
+			constexpr auto phys = magic_enum::enum_values<rawrbox::PHYS_LAYERS>();
+			for (PHYS_LAYERS p : phys)
+				this->_objectToBroadPhase.emplace_back(static_cast<uint8_t>(p));
+		}
+
+		[[nodiscard]] uint32_t GetNumBroadPhaseLayers() const override {
+			return static_cast<uint32_t>(this->_objectToBroadPhase.size());
+		}
+
+		[[nodiscard]] JPH::BroadPhaseLayer GetBroadPhaseLayer(JPH::ObjectLayer inLayer) const override {
+			if (inLayer >= this->_objectToBroadPhase.size()) throw std::runtime_error(fmt::format("[RawrBox-Physics] Missing physics layer {}!", inLayer));
+			return this->_objectToBroadPhase[inLayer];
+		}
+
+#if defined(JPH_EXTERNAL_PROFILE) || defined(JPH_PROFILE_ENABLED)
+		[[nodiscard]] const char* GetBroadPhaseLayerName(JPH::BroadPhaseLayer inLayer) const override {
+			auto a = static_cast<uint8_t>(inLayer);
+			const auto* name = magic_enum::enum_name(static_cast<rawrbox::PHYS_LAYERS>(a)).data();
+			return name;
+		}
+#endif
+	};
+
+	class PhysicsWorld;
+
+	class BPLayerFilter : public JPH::ObjectVsBroadPhaseLayerFilter {
+	protected:
+		rawrbox::PhysicsWorld* _world = nullptr;
+
+	public:
+		explicit BPLayerFilter(rawrbox::PhysicsWorld* world) : _world(world) {}
+		[[nodiscard]] bool ShouldCollide(JPH::ObjectLayer inLayer1, JPH::BroadPhaseLayer inLayer2) const override;
+	};
+
+	class BodyActivationListener : public JPH::BodyActivationListener {
+	protected:
+		rawrbox::PhysicsWorld* _world = nullptr;
+
+	public:
+		explicit BodyActivationListener(rawrbox::PhysicsWorld* world) : _world(world) {}
+
+		void OnBodyActivated(const JPH::BodyID& inBodyID, uint64_t inBodyUserData) override;
+		void OnBodyDeactivated(const JPH::BodyID& inBodyID, uint64_t inBodyUserData) override;
+	};
+
+	class ContactListener : public JPH::ContactListener {
+	protected:
+		rawrbox::PhysicsWorld* _world = nullptr;
+
+	public:
+		explicit ContactListener(rawrbox::PhysicsWorld* world) : _world(world) {}
+
+		// See: ContactListener
+		JPH::ValidateResult OnContactValidate(const JPH::Body& inBody1, const JPH::Body& inBody2, JPH::RVec3Arg inBaseOffset, const JPH::CollideShapeResult& inCollisionResult) override;
+		void OnContactAdded(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings) override;
+		void OnContactPersisted(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings) override;
+		void OnContactRemoved(const JPH::SubShapeIDPair& inSubShapePair) override;
+	};
+
+	// One independent physics simulation, with its own allocator, bodies, contacts and events
+	// The job system (and type registration) is shared, so PHYSICS::init needs to be called first
+	//
+	// rawrbox::PhysicsWorld match = {};
+	// match.getBodyInterface().CreateAndAddBody(...);
+	// rawrbox::PHYSICS::tick({&match, &other}); // Both step at the same time
+	class PhysicsWorld {
+	protected:
+		std::unique_ptr<JPH::TempAllocatorImpl> _allocator = nullptr;
+		std::unique_ptr<JPH::PhysicsSystem> _system = nullptr;
+
+		std::unique_ptr<rawrbox::BPLayerFilter> _bpLayerFilter = nullptr;
+		std::unique_ptr<rawrbox::BodyActivationListener> _bodyListener = nullptr;
+		std::unique_ptr<rawrbox::ContactListener> _contactListener = nullptr;
+
+	public:
+		int steps = 1;
+		bool simulate = true;
+
+		// Batched, sorted and filtered contacts, dispatched after tick on the same thread (prefer these)
+		rawrbox::PhysicsContacts contacts;
+		// Body changes from any thread, applied at the start of tick (prefer these over getBodyInterface outside of the tick thread)
+		rawrbox::PhysicsCommands commands;
+
+		// EVENTS ----
+		// Called from the Jolt workers during the update, only use them to tweak the contact (ex: ContactSettings) / filter it
+		rawrbox::Event<const JPH::BodyID&, uint64_t> onBodyAwake;
+		rawrbox::Event<const JPH::BodyID&, uint64_t> onBodySleep;
+		std::function<bool(rawrbox::PHYS_LAYERS, rawrbox::PHYS_LAYERS)> shouldCollide = nullptr;
+
+		std::function<JPH::ValidateResult(const JPH::Body&, const JPH::Body&, JPH::RVec3Arg, const JPH::CollideShapeResult&)> onContactValidate = nullptr;
+
+		rawrbox::Event<const JPH::Body&, const JPH::Body&, const JPH::ContactManifold&, JPH::ContactSettings&> onContactAdded;
+		rawrbox::Event<const JPH::Body&, const JPH::Body&, const JPH::ContactManifold&, JPH::ContactSettings&> onContactPersisted;
+		rawrbox::Event<const JPH::SubShapeIDPair&> onContactRemoved;
+		// ----
+
+		explicit PhysicsWorld(uint32_t mbAlloc = 20, uint32_t maxBodies = 2048, uint32_t maxBodyMutexes = 2048, uint32_t maxBodyPairs = 2048, uint32_t maxContactConstraints = 2048);
+		PhysicsWorld(const PhysicsWorld&) = delete;
+		PhysicsWorld(PhysicsWorld&&) = delete;
+		PhysicsWorld& operator=(const PhysicsWorld&) = delete;
+		PhysicsWorld& operator=(PhysicsWorld&&) = delete;
+		virtual ~PhysicsWorld();
+
+		void clear();
+		void tick();     // Should be tick based update
+		void optimize(); // Call only when a lot of bodies are added at a single time
+
+		[[nodiscard]] JPH::PhysicsSystem& getSystem() const;
+		[[nodiscard]] JPH::BodyInterface& getBodyInterface() const;
+		[[nodiscard]] JPH::TempAllocatorImpl& getAllocator() const;
+
+		// What collides when shouldCollide is not set
+		[[nodiscard]] static bool defaultShouldCollide(rawrbox::PHYS_LAYERS layer1, rawrbox::PHYS_LAYERS layer2);
+	};
+} // namespace rawrbox
@@ -0,0 +1,142 @@
+#include <rawrbox/physics/commands.hpp>
+#include <rawrbox/physics/utils.hpp>
+#include <rawrbox/utils/logger.hpp>
+#include <rawrbox/utils/profiler.hpp>
+
+#include <algorithm>
+
+namespace rawrbox {
+	PhysicsCommands::PhysicsCommands(size_t capacity) : _commands(capacity), _settings(std::max<size_t>(capacity / 16, 1)) {}
+
+	// PROTECTED ----
+	JPH::BodyID PhysicsCommands::resolve(const rawrbox::PhysicsCommand& command) const {
+		if (command.handle == 0) return command.body;
+
+		auto fnd = this->_handles.find(command.handle);
+		if (fnd == this->_handles.end()) return {};
+
+		return fnd->second;
+	}
+
+	void PhysicsCommands::push(rawrbox::PhysicsCommandType type, const rawrbox::PhysicsBodyRef& body, rawrbox::PhysicsCommand command) {
+		command.type = type;
+		command.handle = body.handle;
+		command.body = body.body;
+
+		this->_commands.push(command);
+	}
+	// -------------
+
+	// Any thread ---
+	rawrbox::PhysicsHandle PhysicsCommands::create(const JPH::BodyCreationSettings& settings, JPH::EActivation activation) {
+		const rawrbox::PhysicsHandle handle = {this->_commands.reserve()};
+
+		rawrbox::PhysicsCommand command = {};
+		command.settings = static_cast<uint32_t>(this->_settings.push(settings));
+		command.activation = activation;
+
+		this->push(rawrbox::PhysicsCommandType::CREATE, handle, command);
+		return handle;
+	}
+
+	void PhysicsCommands::destroy(const rawrbox::PhysicsBodyRef& body) {
+		this->push(rawrbox::PhysicsCommandType::DESTROY, body);
+	}
+
+	void PhysicsCommands::setTransform(const rawrbox::PhysicsBodyRef& body, const rawrbox::Vector3f& pos, const rawrbox::Vector4f& rotation, JPH::EActivation activation) {
+		rawrbox::PhysicsCommand command = {};
+		command.vec = pos;
+		command.rotation = rotation;
+		command.activation = activation;
+
+		this->push(rawrbox::PhysicsCommandType::SET_TRANSFORM, body, command);
+	}
+
+	void PhysicsCommands::setVelocity(const rawrbox::PhysicsBodyRef& body, const rawrbox::Vector3f& linear, const rawrbox::Vector3f& angular) {
+		rawrbox::PhysicsCommand command = {};
+		command.vec = linear;
+		command.vec2 = angular;
+
+		this->push(rawrbox::PhysicsCommandType::SET_VELOCITY, body, command);
+	}
+
+	void PhysicsCommands::addImpulse(const rawrbox::PhysicsBodyRef& body, const rawrbox::Vector3f& impulse) {
+		rawrbox::PhysicsCommand command = {};
+		command.vec = impulse;
+
+		this->push(rawrbox::PhysicsCommandType::ADD_IMPULSE, body, command);
+	}
+
+	void PhysicsCommands::activate(const rawrbox::PhysicsBodyRef& body) { this->push(rawrbox::PhysicsCommandType::ACTIVATE, body); }
+	void PhysicsCommands::deactivate(const rawrbox::PhysicsBodyRef& body) { this->push(rawrbox::PhysicsCommandType::DEACTIVATE, body); }
+	// ---
+
+	void PhysicsCommands::apply(JPH::BodyInterface& bodyInterface) {
+		if (this->_commands.empty()) return;
+		RAWRBOX_PROFILE_ZONE("PhysicsCommands::apply");
+
+		// Collected first, create commands point into it
+		this->_created.clear();
+		this->_settings.collect(this->_created);
+		this->_destroyed.clear();
+
+		this->_commands.apply([this, &bodyInterface](const rawrbox::PhysicsCommand& command) {
+			if (command.type == rawrbox::PhysicsCommandType::CREATE) {
+				JPH::Body* body = bodyInterface.CreateBody(this->_created[command.settings]);
+				if (body == nullptr) RAWRBOX_CRITICAL("[RawrBox-Physics] Out of bodies, increase maxBodies");
+
+				bodyInterface.AddBody(body->GetID(), command.activation);
+				this->_handles[command.handle] = body->GetID();
+				return;
+			}
+
+			const JPH::BodyID id = this->resolve(command);
+			if (id.IsInvalid()) return; // Destroyed earlier
+
+			switch (command.type) {
+				case rawrbox::PhysicsCommandType::DESTROY:
+					if (command.handle != 0) this->_handles.erase(command.handle);
+					if (!this->_destroyed.insert(id.GetIndexAndSequenceNumber()).second) break; // Already destroyed by an earlier command (ex: once by handle, once by id)
+
+					if (bodyInterface.IsAdded(id)) bodyInterface.RemoveBody(id);
+					bodyInterface.DestroyBody(id);
+					break;
+				case rawrbox::PhysicsCommandType::SET_TRANSFORM:
+					bodyInterface.SetPositionAndRotation(id, rawrbox::PhysUtils::vecToPos(command.vec), rawrbox::PhysUtils::vec4ToQuat(command.rotation), command.activation);
+					break;
+				case rawrbox::PhysicsCommandType::SET_VELOCITY:
+					bodyInterface.SetLinearAndAngularVelocity(id, rawrbox::PhysUtils::vecToPos(command.vec), rawrbox::PhysUtils::vecToPos(command.vec2));
+					break;
+				case rawrbox::PhysicsCommandType::ADD_IMPULSE:
+					bodyInterface.AddImpulse(id, rawrbox::PhysUtils::vecToPos(command.vec));
+					break;
+				case rawrbox::PhysicsCommandType::ACTIVATE:
+					bodyInterface.ActivateBody(id);
+					break;
+				case rawrbox::PhysicsCommandType::DEACTIVATE:
+					bodyInterface.DeactivateBody(id);
+					break;
+				default:
+					break;
+			}
+		});
+
+		this->_created.clear(); // Drop the shape refs
+		this->_destroyed.clear();
+	}
+
+	void PhysicsCommands::clear() {
+		this->_commands.clear();
+		this->_settings.clear();
+		this->_handles.clear();
+	}
+
+	JPH::BodyID PhysicsCommands::get(const rawrbox::PhysicsHandle& handle) const {
+		auto fnd = this->_handles.find(handle.id);
+		if (fnd == this->_handles.end()) return {};
+
+		return fnd->second;
+	}
+
+	size_t PhysicsCommands::size() const { return this->_commands.size(); }
+} // namespace rawrbox
@@ -0,0 +1,105 @@
+#include <rawrbox/physics/contacts.hpp>
+#include <rawrbox/utils/profiler.hpp>
+
+#include <algorithm>
+#include <tuple>
+
+namespace rawrbox {
+	// CONTACT ---
+	bool PhysicsContact::operator<(const rawrbox::PhysicsContact& other) const {
+		// Everything that tells two contacts apart, so equal keys are the same contact and the order is always the same
+		return std::make_tuple(this->body1.GetIndexAndSequenceNumber(), this->body2.GetIndexAndSequenceNumber(), static_cast<uint8_t>(this->type), this->subShape1.GetValue(), this->subShape2.GetValue()) <
+		       std::make_tuple(other.body1.GetIndexAndSequenceNumber(), other.body2.GetIndexAndSequenceNumber(), static_cast<uint8_t>(other.type), other.subShape1.GetValue(), other.subShape2.GetValue());
+	}
+
+	bool PhysicsContactFilter::matches(const rawrbox::PhysicsContact& contact) const {
+		if ((this->types & static_cast<uint8_t>(contact.type)) == 0) return false;
+		if (!this->body.IsInvalid() && contact.body1 != this->body && contact.body2 != this->body) return false;
+		if (contact.type == rawrbox::ContactType::REMOVED || this->layers == 0xFFFFFFFF) return true;
+
+		const auto inMask = [this](JPH::ObjectLayer layer) { return layer < 32 && (this->layers & (1U << layer)) != 0; };
+		return inMask(contact.layer1) || inMask(contact.layer2);
+	}
+	// ---
+
+	PhysicsContacts::PhysicsContacts(size_t capacity) : _buffer(capacity) {}
+
+	void PhysicsContacts::push(rawrbox::PhysicsContact contact) {
+		if (contact.body2 < contact.body1) {
+			std::swap(contact.body1, contact.body2);
+			std::swap(contact.subShape1, contact.subShape2);
+			std::swap(contact.layer1, contact.layer2);
+			std::swap(contact.userData1, contact.userData2);
+			contact.normal = -contact.normal;
+		}
+
+		this->_buffer.push(contact);
+	}
+
+	bool PhysicsContacts::recording() const { return this->_record || !this->_listeners.empty(); }
+	void PhysicsContacts::setRecording(bool record) { this->_record = record; }
+
+	void PhysicsContacts::dispatch() {
+		this->_contacts.clear();
+		if (this->_buffer.empty()) return;
+
+		RAWRBOX_PROFILE_ZONE("PhysicsContacts::dispatch");
+
+		this->_buffer.collect(this->_contacts);
+		std::sort(this->_contacts.begin(), this->_contacts.end());
+
+		// Handlers can listen / remove, listeners added now are only called on the next dispatch
+		this->_dispatching = true;
+		for (const auto& contact : this->_contacts) {
+			for (const auto& listener : this->_listeners) {
+				if (listener.id == 0 || !listener.filter.matches(contact)) continue;
+				listener.func(contact);
+			}
+		}
+		this->_dispatching = false;
+
+		std::erase_if(this->_listeners, [](const Listener& listener) { return listener.id == 0; });
+		for (auto& listener : this->_pending) {
+			this->_listeners.push_back(std::move(listener));
+		}
+
+		this->_pending.clear();
+	}
+
+	rawrbox::EventToken PhysicsContacts::listen(const rawrbox::PhysicsContactFilter& filter, Func func) {
+		const uint64_t id = ++this->_lastId;
+
+		auto& list = this->_dispatching ? this->_pending : this->_listeners;
+		list.push_back({id, filter, std::move(func)});
+
+		return {id};
+	}
+
+	bool PhysicsContacts::remove(const rawrbox::EventToken& token) {
+		if (!token.valid()) return false;
+
+		auto pending = std::ranges::find(this->_pending, token.id, &Listener::id);
+		if (pending != this->_pending.end()) {
+			this->_pending.erase(pending);
+			return true;
+		}
+
+		auto fnd = std::ranges::find(this->_listeners, token.id, &Listener::id);
+		if (fnd == this->_listeners.end()) return false;
+
+		if (this->_dispatching) {
+			fnd->id = 0; // Could be the one running, erased once the dispatch is over
+		} else {
+			this->_listeners.erase(fnd);
+		}
+
+		return true;
+	}
+
+	void PhysicsContacts::clear() {
+		this->_buffer.clear();
+		this->_contacts.clear();
+	}
+
+	const std::vector<rawrbox::PhysicsContact>& PhysicsContacts::get() const { return this->_contacts; }
+} // namespace rawrbox
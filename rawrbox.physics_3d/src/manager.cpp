@@ -1,22 +1,39 @@
-
 #include <rawrbox/physics/manager.hpp>
+#include <rawrbox/utils/logger.hpp>
+#include <rawrbox/utils/profiler.hpp>
+#include <rawrbox/utils/threading.hpp>
+
+#include <algorithm>
 
 namespace rawrbox {
+	namespace {
+		// Hooks the default world's event up to the static one only while it has handlers, so the world can still skip the empty ones
+		template <typename... Args>
+		void forward(rawrbox::Event<Args...>& world, rawrbox::Event<Args...>& global, rawrbox::EventToken& token) {
+			if (global.empty()) {
+				if (token.valid()) world.remove(token);
+				token = {};
+			} else if (!token.valid()) {
+				token = world.add([&global](Args... args) { global(args...); });
+			}
+		}
+	} // namespace
+
 	// Private
 	std::unique_ptr<JPH::JobSystemThreadPool> PHYSICS::_threadPool = nullptr;
 	std::unique_ptr<JPH::Factory> PHYSICS::_factory = nullptr;
+	uint32_t PHYSICS::_maxWorlds = 1;
 
 	const std::unique_ptr<rawrbox::BPLayerInterface> PHYSICS::_bpLayerInterface = std::make_unique<rawrbox::BPLayerInterface>();
-	const std::unique_ptr<rawrbox::BPLayerFilter> PHYSICS::_bpLayerFilter = std::make_unique<rawrbox::BPLayerFilter>();
 	const std::unique_ptr<rawrbox::LayerFilter> PHYSICS::_layerFilter = std::make_unique<rawrbox::LayerFilter>();
 
-	std::unique_ptr<rawrbox::BodyActivationListener> PHYSICS::_bodyListener = nullptr;
-	std::unique_ptr<rawrbox::ContactListener> PHYSICS::_contactListener = nullptr;
+	std::unique_ptr<rawrbox::PhysicsWorld> PHYSICS::_world = nullptr;
+	std::array<rawrbox::EventToken, 5> PHYSICS::_forwards = {};
 	// ---
 
 	// Public
-	std::unique_ptr<JPH::TempAllocatorImpl> PHYSICS::allocator = nullptr;
-	std::unique_ptr<JPH::PhysicsSystem> PHYSICS::physicsSystem = nullptr;
+	JPH::TempAllocatorImpl* PHYSICS::allocator = nullptr;
+	JPH::PhysicsSystem* PHYSICS::physicsSystem = nullptr;
 
 	JPH::Ref<JPH::Shape> PHYSICS::rayBoxShape = nullptr;
 
@@ -37,7 +54,7 @@ namespace rawrbox {
 	bool PHYSICS::simulate = true;
 	// ---
 
-	void PHYSICS::init(uint32_t mbAlloc, uint32_t maxBodies, uint32_t maxBodyMutexes, uint32_t maxBodyPairs, uint32_t maxContactConstraints, uint32_t maxThreads) {
+	void PHYSICS::init(uint32_t mbAlloc, uint32_t maxBodies, uint32_t maxBodyMutexes, uint32_t maxBodyPairs, uint32_t maxContactConstraints, uint32_t maxThreads, uint32_t maxWorlds) {
 		// Register allocation hook
 		JPH::RegisterDefaultAllocator();
 
@@ -47,21 +64,27 @@ namespace rawrbox {
 		// Register all Jolt physics types
 		JPH::RegisterTypes();
 
-		// Initialize allocator
-		allocator = std::make_unique<JPH::TempAllocatorImpl>(mbAlloc * 1024 * 1024); // MB
-
-		// Initialize pool
+		// Initialize pool, every world ticking at the same time needs its own jobs / barriers
 		if (maxThreads == 0) maxThreads = std::thread::hardware_concurrency() - 1;
-		_threadPool = std::make_unique<JPH::JobSystemThreadPool>(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, maxThreads);
+		_maxWorlds = std::max(maxWorlds, 1U);
+		_threadPool = std::make_unique<JPH::JobSystemThreadPool>(JPH::cMaxPhysicsJobs * _maxWorlds, JPH::cMaxPhysicsBarriers * _maxWorlds, maxThreads);
+
+		// Initialize the default world, its callbacks go to the static ones (see forwardEvents)
+		_world = std::make_unique<rawrbox::PhysicsWorld>(mbAlloc, maxBodies, maxBodyMutexes, maxBodyPairs, maxContactConstraints);
+		_forwards = {};
 
-		_bodyListener = std::make_unique<rawrbox::BodyActivationListener>();
-		_contactListener = std::make_unique<rawrbox::ContactListener>();
+		_world->shouldCollide = [](rawrbox::PHYS_LAYERS layer1, rawrbox::PHYS_LAYERS layer2) {
+			if (shouldCollide == nullptr) return rawrbox::PhysicsWorld::defaultShouldCollide(layer1, layer2);
+			return shouldCollide(layer1, layer2);
+		};
 
-		// Initialize physics system
-		physicsSystem = std::make_unique<JPH::PhysicsSystem>();
-		physicsSystem->Init(maxBodies, maxBodyMutexes, maxBodyPairs, maxContactConstraints, *_bpLayerInterface, *_bpLayerFilter, *_layerFilter);
-		physicsSystem->SetBodyActivationListener(_bodyListener.get());
-		physicsSystem->SetContactListener(_contactListener.get());
+		_world->onContactValidate = [](const JPH::Body& a, const JPH::Body& b, JPH::RVec3Arg offset, const JPH::CollideShapeResult& result) {
+			if (onContactValidate == nullptr) return JPH::ValidateResult::AcceptAllContactsForThisBodyPair;
+			return onContactValidate(a, b, offset, result);
+		};
+
+		allocator = &_world->getAllocator();
+		physicsSystem = &_world->getSystem();
 
 		// Create raycast shape --
 		// NOLINTBEGIN(*)
@@ -71,42 +94,75 @@ namespace rawrbox {
 	}
 
 	void PHYSICS::shutdown() {
-		rayBoxShape->Release();
+		rayBoxShape = nullptr; // Releases it, init can be called again
+
+		allocator = nullptr;
+		physicsSystem = nullptr;
+		_world.reset();
+		_forwards = {};
 
 		JPH::UnregisterTypes();
 
 		_factory.reset();
 		JPH::Factory::sInstance = nullptr;
 
-		allocator.reset();
 		_threadPool.reset();
-
-		_bodyListener.reset();
-		_contactListener.reset();
-
-		physicsSystem.reset();
+		_maxWorlds = 1;
 	}
 
 	void PHYSICS::clear() {
-		JPH::BodyInterface& bodyInterface = physicsSystem->GetBodyInterface();
+		if (_world == nullptr) return;
+		_world->clear();
+	}
 
-		JPH::BodyIDVector bodies = {};
-		physicsSystem->GetBodies(bodies);
+	void PHYSICS::tick() {
+		if (_world == nullptr || !simulate) return;
 
-		for (JPH::BodyID id : bodies) {
-			bodyInterface.DeactivateBody(id);
-			bodyInterface.RemoveBody(id);
-			bodyInterface.DestroyBody(id);
-		}
+		forwardEvents();
+
+		_world->steps = steps;
+		_world->tick();
 	}
 
-	void PHYSICS::tick() {
-		if (allocator == nullptr || _threadPool == nullptr || physicsSystem == nullptr || !simulate) return;
-		physicsSystem->Update(rawrbox::FIXED_DELTA_TIME, steps, allocator.get(), _threadPool.get());
+	void PHYSICS::tick(const std::vector<rawrbox::PhysicsWorld*>& worlds) {
+		if (_threadPool == nullptr) return;
+		RAWRBOX_PROFILE_ZONE("PHYSICS::tick (worlds)");
+		// In case the default world is one of them
+		forwardEvents();
+		if (_world != nullptr) _world->steps = steps;
+
+		// The pool only has jobs / barriers for _maxWorlds updates at the same time
+		for (size_t begin = 0; begin < worlds.size(); begin += _maxWorlds) {
+			rawrbox::ASYNC::loop(begin, std::min<size_t>(begin + _maxWorlds, worlds.size()), [&worlds](size_t i) {
+				auto* world = worlds[i];
+				if (world == _world.get() && !simulate) return;
+
+				world->tick();
+			});
+		}
 	}
 
 	void PHYSICS::optimize() {
-		if (physicsSystem == nullptr) return;
-		physicsSystem->OptimizeBroadPhase();
+		if (_world == nullptr) return;
+		_world->optimize();
 	}
+
+	void PHYSICS::forwardEvents() {
+		if (_world == nullptr) return;
+
+		forward(_world->onBodyAwake, onBodyAwake, _forwards[0]);
+		forward(_world->onBodySleep, onBodySleep, _forwards[1]);
+		forward(_world->onContactAdded, onContactAdded, _forwards[2]);
+		forward(_world->onContactPersisted, onContactPersisted, _forwards[3]);
+		forward(_world->onContactRemoved, onContactRemoved, _forwards[4]);
+	}
+
+	rawrbox::PhysicsWorld& PHYSICS::getWorld() {
+		if (_world == nullptr) RAWRBOX_CRITICAL("[RawrBox-Physics] Physics not initialized");
+		return *_world;
+	}
+
+	JPH::JobSystem* PHYSICS::getJobSystem() { return _threadPool.get(); }
+	const rawrbox::BPLayerInterface& PHYSICS::getBPLayerInterface() { return *_bpLayerInterface; }
+	const rawrbox::LayerFilter& PHYSICS::getLayerFilter() { return *_layerFilter; }
 } // namespace rawrbox
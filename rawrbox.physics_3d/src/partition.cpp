@@ -0,0 +1,246 @@
+#include <rawrbox/physics/manager.hpp>
+#include <rawrbox/physics/partition.hpp>
+#include <rawrbox/physics/utils.hpp>
+#include <rawrbox/utils/logger.hpp>
+#include <rawrbox/utils/profiler.hpp>
+
+#include <algorithm>
+
+namespace rawrbox {
+	PhysicsPartition::PhysicsPartition(float cellSize, float loadRadius, float unloadRadius, size_t cellsPerTick, rawrbox::PhysicsWorld* world) : _world(world), _grid(cellSize, loadRadius, unloadRadius, cellsPerTick), _lodDistance(loadRadius) {}
+
+	// PROTECTED ----
+	rawrbox::PhysicsWorld& PhysicsPartition::getWorld() const {
+		// Looked up late, the default world might not exist yet when this is created
+		if (this->_world == nullptr) return rawrbox::PHYSICS::getWorld();
+		return *this->_world;
+	}
+
+	void PhysicsPartition::loadCells() {
+		if (this->_load.empty()) return;
+		auto& bodyInterface = this->getWorld().getBodyInterface();
+
+		this->_batch.clear();
+		for (const auto& cell : this->_load) {
+			const uint64_t key = rawrbox::StreamingGrid::key(cell);
+
+			auto& settings = this->_statics[key];
+			auto& bodies = this->_bodies[key];
+
+			bodies.reserve(settings.size());
+			for (const auto& setting : settings) {
+				JPH::Body* body = bodyInterface.CreateBody(setting);
+				if (body == nullptr) {
+					// Nothing in the batch was added yet, destroy it instead of leaking it
+					if (!this->_batch.empty()) bodyInterface.DestroyBodies(this->_batch.data(), static_cast<int>(this->_batch.size()));
+					this->_batch.clear();
+
+					// The grid already counts them as loaded, hand them back so the next update retries them
+					for (const auto& loaded : this->_load) {
+						this->_bodies.erase(rawrbox::StreamingGrid::key(loaded));
+						this->_grid.cancelLoad(loaded);
+					}
+
+					this->_load.clear();
+
+					RAWRBOX_CRITICAL("[RawrBox-Physics] Out of bodies while streaming, increase maxBodies");
+				}
+
+				bodies.push_back(body->GetID());
+				this->_batch.push_back(body->GetID());
+			}
+		}
+
+		if (this->_batch.empty()) return;
+
+		// One broadphase insert for the whole batch, instead of one per body
+		const int count = static_cast<int>(this->_batch.size());
+		auto state = bodyInterface.AddBodiesPrepare(this->_batch.data(), count);
+		bodyInterface.AddBodiesFinalize(this->_batch.data(), count, state, JPH::EActivation::DontActivate);
+
+		this->_stats.bodiesAdded += this->_batch.size();
+		this->_dirty += this->_batch.size();
+	}
+
+	void PhysicsPartition::unloadCells() {
+		if (this->_unload.empty()) return;
+		auto& bodyInterface = this->getWorld().getBodyInterface();
+
+		this->_batch.clear();
+		for (const auto& cell : this->_unload) {
+			auto fnd = this->_bodies.find(rawrbox::StreamingGrid::key(cell));
+			if (fnd == this->_bodies.end()) continue;
+
+			this->_batch.insert(this->_batch.end(), fnd->second.begin(), fnd->second.end());
+			this->_bodies.erase(fnd);
+		}
+
+		if (this->_batch.empty()) return;
+
+		const int count = static_cast<int>(this->_batch.size());
+		bodyInterface.RemoveBodies(this->_batch.data(), count);
+		bodyInterface.DestroyBodies(this->_batch.data(), count);
+
+		this->_stats.bodiesRemoved += this->_batch.size();
+	}
+
+	void PhysicsPartition::updateLOD() {
+		if (this->_dynamic.empty() || (this->_ticks % this->_lodInterval) != 0) return;
+		auto& bodyInterface = this->getWorld().getBodyInterface();
+
+		JPH::BodyIDVector freeze = {};
+		JPH::BodyIDVector wake = {};
+
+		for (const auto& id : this->_dynamic) {
+			if (!bodyInterface.IsAdded(id)) continue; // Removed / destroyed without removeDynamic
+
+			const uint32_t key = id.GetIndexAndSequenceNumber();
+			const float distance = this->_grid.getDistance(rawrbox::PhysUtils::posToVec(bodyInterface.GetPosition(id)));
+
+			auto fnd = this->_frozen.find(key);
+			if (fnd == this->_frozen.end()) {
+				if (distance > this->_lodDistance) freeze.push_back(id);
+				continue;
+			}
+
+			if (distance <= this->_lodDistance) {
+				wake.push_back(id);
+			} else if (bodyInterface.IsActive(id)) {
+				// Something far bumped into it, freeze it again with its new velocity
+				this->_frozen.erase(fnd);
+				freeze.push_back(id);
+			}
+		}
+
+		// Deactivating resets the velocities, keep them around
+		for (const auto& id : freeze) {
+			this->_frozen[id.GetIndexAndSequenceNumber()] = {bodyInterface.GetLinearVelocity(id), bodyInterface.GetAngularVelocity(id)};
+		}
+
+		if (!freeze.empty()) bodyInterface.DeactivateBodies(freeze.data(), static_cast<int>(freeze.size()));
+
+		if (!wake.empty()) {
+			bodyInterface.ActivateBodies(wake.data(), static_cast<int>(wake.size()));
+
+			for (const auto& id : wake) {
+				auto fnd = this->_frozen.find(id.GetIndexAndSequenceNumber());
+				bodyInterface.SetLinearAndAngularVelocity(id, fnd->second.linear, fnd->second.angular);
+				this->_frozen.erase(fnd);
+			}
+		}
+
+		this->_stats.woken = wake.size();
+	}
+	// -------------
+
+	// STATIC ---
+	void PhysicsPartition::addStatic(const JPH::BodyCreationSettings& settings) {
+		const auto cell = this->_grid.getCell(rawrbox::PhysUtils::posToVec(settings.mPosition));
+		const uint64_t key = rawrbox::StreamingGrid::key(cell);
+
+		this->_grid.addCell(cell);
+		this->_statics[key].push_back(settings);
+
+		// Already streamed in, add it now
+		if (!this->_grid.isLoaded(cell)) return;
+		auto& bodyInterface = this->getWorld().getBodyInterface();
+
+		JPH::Body* body = bodyInterface.CreateBody(settings);
+		if (body == nullptr) RAWRBOX_CRITICAL("[RawrBox-Physics] Out of bodies while streaming, increase maxBodies");
+
+		bodyInterface.AddBody(body->GetID(), JPH::EActivation::DontActivate);
+		this->_bodies[key].push_back(body->GetID());
+		this->_dirty++;
+	}
+	// ---
+
+	// DYNAMIC ---
+	void PhysicsPartition::addDynamic(const JPH::BodyID& id) {
+		if (std::find(this->_dynamic.begin(), this->_dynamic.end(), id) != this->_dynamic.end()) return;
+		this->_dynamic.push_back(id);
+	}
+
+	void PhysicsPartition::removeDynamic(const JPH::BodyID& id) {
+		std::erase(this->_dynamic, id);
+
+		// Hand it back awake, with its velocity
+		auto fnd = this->_frozen.find(id.GetIndexAndSequenceNumber());
+		if (fnd == this->_frozen.end()) return;
+
+		auto& bodyInterface = this->getWorld().getBodyInterface();
+		if (bodyInterface.IsAdded(id)) {
+			bodyInterface.ActivateBody(id);
+			bodyInterface.SetLinearAndAngularVelocity(id, fnd->second.linear, fnd->second.angular);
+		}
+
+		this->_frozen.erase(fnd);
+	}
+
+	void PhysicsPartition::setLOD(float distance, uint32_t interval) {
+		this->_lodDistance = std::min(distance, this->_grid.getLoadRadius()); // Past it, the ground might not be there anymore
+		this->_lodInterval = std::max<uint32_t>(interval, 1);
+	}
+	// ---
+
+	// ACTIVATORS ---
+	void PhysicsPartition::setActivator(uint32_t id, const rawrbox::Vector3f& pos) { this->_grid.setActivator(id, pos); }
+	void PhysicsPartition::removeActivator(uint32_t id) { this->_grid.removeActivator(id); }
+	// ---
+
+	void PhysicsPartition::update() {
+		RAWRBOX_PROFILE_ZONE("PhysicsPartition::update");
+
+		this->_stats = {};
+		this->_grid.update(this->_load, this->_unload);
+
+		// Unload first, frees bodies for the new cells
+		this->unloadCells();
+		this->loadCells();
+
+		if (this->_dirty >= this->optimizeThreshold) {
+			this->getWorld().optimize();
+
+			this->_dirty = 0;
+			this->_stats.optimized = true;
+		}
+
+		this->updateLOD();
+		this->_ticks++;
+
+		this->_stats.cellsLoaded = this->_load.size();
+		this->_stats.cellsUnloaded = this->_unload.size();
+		this->_stats.frozen = this->_frozen.size();
+	}
+
+	void PhysicsPartition::clear() {
+		this->_grid.unloadAll(this->_unload);
+		this->unloadCells();
+		this->_grid.clear();
+
+		// Hand the frozen ones back awake
+		while (!this->_dynamic.empty()) {
+			const JPH::BodyID id = this->_dynamic.back(); // Copy, removeDynamic erases it
+			this->removeDynamic(id);
+		}
+
+		this->_statics.clear();
+		this->_bodies.clear();
+
+		this->_dirty = 0;
+		this->_stats = {};
+	}
+
+	bool PhysicsPartition::isFrozen(const JPH::BodyID& id) const { return this->_frozen.contains(id.GetIndexAndSequenceNumber()); }
+
+	size_t PhysicsPartition::getLoadedBodies() const {
+		size_t total = 0;
+		for (const auto& cell : this->_bodies) {
+			total += cell.second.size();
+		}
+
+		return total;
+	}
+
+	const rawrbox::PhysicsPartitionStats& PhysicsPartition::getStats() const { return this->_stats; }
+	const rawrbox::StreamingGrid& PhysicsPartition::getGrid() const { return this->_grid; }
+} // namespace rawrbox
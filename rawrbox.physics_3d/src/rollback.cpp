@@ -0,0 +1,147 @@
+#include <rawrbox/physics/manager.hpp>
+#include <rawrbox/physics/rollback.hpp>
+#include <rawrbox/utils/crc.hpp>
+#include <rawrbox/utils/logger.hpp>
+#include <rawrbox/utils/profiler.hpp>
+
+#include <Jolt/Physics/Body/BodyLock.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace rawrbox {
+	namespace {
+		template <typename T>
+		void append(std::vector<uint8_t>& out, const T& value) {
+			const auto offset = out.size();
+			out.resize(offset + sizeof(T));
+			std::memcpy(out.data() + offset, &value, sizeof(T));
+		}
+	} // namespace
+
+	PhysicsRollback::PhysicsRollback(size_t frames, size_t keyframeInterval, rawrbox::PhysicsWorld* world) : _world(world), _snapshots(frames, keyframeInterval) {}
+
+	// PROTECTED ----
+	rawrbox::PhysicsWorld& PhysicsRollback::getWorld() const {
+		// Looked up late, the default world might not exist yet when this is created
+		if (this->_world == nullptr) return rawrbox::PHYSICS::getWorld();
+		return *this->_world;
+	}
+	// -------------
+
+	void PhysicsRollback::save() {
+		RAWRBOX_PROFILE_ZONE("PhysicsRollback::save");
+		auto& world = this->getWorld();
+
+		this->_recorder.Clear();
+		world.getSystem().SaveState(this->_recorder);
+
+		const std::string data = this->_recorder.GetData();
+		this->_snapshots.push(this->_frame, data.data(), data.size(), hash(world));
+	}
+
+	void PhysicsRollback::tick(const rawrbox::PhysicsInput& input) {
+		if (input != nullptr) input(this->_frame);
+
+		if (this->_world == nullptr) {
+			rawrbox::PHYSICS::tick(); // Keeps PHYSICS::simulate / steps working
+		} else {
+			this->_world->tick();
+		}
+
+		this->_frame++;
+		this->save();
+	}
+
+	bool PhysicsRollback::restore(uint64_t frame) {
+		RAWRBOX_PROFILE_ZONE("PhysicsRollback::restore");
+
+		std::vector<uint8_t> data = {};
+		if (!this->_snapshots.get(frame, data)) return false;
+
+		this->_recorder.Clear();
+		this->_recorder.WriteBytes(data.data(), data.size());
+		this->_recorder.Rewind();
+
+		if (!this->getWorld().getSystem().RestoreState(this->_recorder)) RAWRBOX_CRITICAL("[RawrBox-Physics] Failed to restore frame {}, were bodies added / removed after it?", frame);
+
+		this->_snapshots.discard(frame);
+		this->_frame = frame;
+		return true;
+	}
+
+	bool PhysicsRollback::resimulate(uint64_t frame, const rawrbox::PhysicsInput& input) {
+		RAWRBOX_PROFILE_ZONE("PhysicsRollback::resimulate");
+
+		const uint64_t target = this->_frame;
+		if (frame > target || !this->restore(frame)) return false;
+
+		while (this->_frame < target) {
+			this->tick(input);
+		}
+
+		return true;
+	}
+
+	bool PhysicsRollback::validate(uint64_t frame, uint32_t hash) {
+		const auto local = this->_snapshots.getHash(frame);
+		if (!local.has_value()) return false; // Too old, or not simulated yet
+
+		if (*local == hash) return true;
+
+		this->onDesync(frame, *local, hash);
+		return false;
+	}
+
+	void PhysicsRollback::clear() {
+		this->_snapshots.clear();
+		this->_recorder.Clear();
+		this->_frame = 0;
+	}
+
+	std::optional<uint32_t> PhysicsRollback::getHash(uint64_t frame) const { return this->_snapshots.getHash(frame); }
+	uint64_t PhysicsRollback::getFrame() const { return this->_frame; }
+	const rawrbox::SnapshotRing& PhysicsRollback::getSnapshots() const { return this->_snapshots; }
+
+	uint32_t PhysicsRollback::hash(const rawrbox::PhysicsWorld& world) {
+		const auto& system = world.getSystem();
+
+		JPH::BodyIDVector bodies = {};
+		system.GetBodies(bodies);
+		std::sort(bodies.begin(), bodies.end());
+
+		// Raw bits, so -0 / NaN differences count too
+		std::vector<uint8_t> data = {};
+		data.reserve(bodies.size() * (sizeof(uint32_t) + sizeof(JPH::Real) * 3 + sizeof(float) * 10));
+
+		const auto& lockInterface = system.GetBodyLockInterface();
+		for (const auto& id : bodies) {
+			JPH::BodyLockRead lock(lockInterface, id);
+			if (!lock.Succeeded()) continue;
+
+			const auto& body = lock.GetBody();
+			const auto position = body.GetPosition();
+			const auto rotation = body.GetRotation();
+			const auto linear = body.GetLinearVelocity();
+			const auto angular = body.GetAngularVelocity();
+
+			append(data, id.GetIndexAndSequenceNumber());
+			append(data, position.GetX());
+			append(data, position.GetY());
+			append(data, position.GetZ());
+			append(data, rotation.GetX());
+			append(data, rotation.GetY());
+			append(data, rotation.GetZ());
+			append(data, rotation.GetW());
+			append(data, linear.GetX());
+			append(data, linear.GetY());
+			append(data, linear.GetZ());
+			append(data, angular.GetX());
+			append(data, angular.GetY());
+			append(data, angular.GetZ());
+		}
+
+		static const CRC::Table<uint32_t, 32> table(CRC::CRC_32());
+		return CRC::Calculate(data.data(), data.size(), table);
+	}
+} // namespace rawrbox
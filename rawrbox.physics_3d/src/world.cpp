@@ -0,0 +1,153 @@
+#include <rawrbox/engine/static.hpp>
+#include <rawrbox/physics/manager.hpp>
+#include <rawrbox/physics/utils.hpp>
+#include <rawrbox/physics/world.hpp>
+#include <rawrbox/utils/logger.hpp>
+#include <rawrbox/utils/profiler.hpp>
+
+namespace rawrbox {
+	namespace {
+		rawrbox::PhysicsContact makeContact(rawrbox::ContactType type, const JPH::Body& body1, const JPH::Body& body2, const JPH::ContactManifold& manifold) {
+			rawrbox::PhysicsContact contact = {};
+			contact.type = type;
+
+			contact.body1 = body1.GetID();
+			contact.body2 = body2.GetID();
+			contact.subShape1 = manifold.mSubShapeID1;
+			contact.subShape2 = manifold.mSubShapeID2;
+			contact.layer1 = body1.GetObjectLayer();
+			contact.layer2 = body2.GetObjectLayer();
+			contact.userData1 = body1.GetUserData();
+			contact.userData2 = body2.GetUserData();
+
+			contact.normal = rawrbox::PhysUtils::posToVec(manifold.mWorldSpaceNormal);
+			contact.depth = manifold.mPenetrationDepth;
+
+			if (!manifold.mRelativeContactPointsOn1.empty()) {
+				const JPH::RVec3 point = manifold.GetWorldSpaceContactPointOn1(0);
+				contact.point = {static_cast<float>(point.GetX()), static_cast<float>(point.GetY()), static_cast<float>(point.GetZ())};
+				contact.speed = (body1.GetPointVelocity(point) - body2.GetPointVelocity(point)).Dot(manifold.mWorldSpaceNormal);
+			}
+
+			return contact;
+		}
+	} // namespace
+
+	// LISTENERS ---
+	bool BPLayerFilter::ShouldCollide(JPH::ObjectLayer inLayer1, JPH::BroadPhaseLayer inLayer2) const {
+		auto layer1 = static_cast<rawrbox::PHYS_LAYERS>(inLayer1);
+		auto layer2 = static_cast<rawrbox::PHYS_LAYERS>(static_cast<uint8_t>(inLayer2));
+
+		if (this->_world->shouldCollide == nullptr) return rawrbox::PhysicsWorld::defaultShouldCollide(layer1, layer2);
+		return this->_world->shouldCollide(layer1, layer2);
+	}
+
+	void BodyActivationListener::OnBodyActivated(const JPH::BodyID& inBodyID, uint64_t inBodyUserData) {
+		this->_world->onBodyAwake(inBodyID, inBodyUserData);
+	}
+
+	void BodyActivationListener::OnBodyDeactivated(const JPH::BodyID& inBodyID, uint64_t inBodyUserData) {
+		this->_world->onBodySleep(inBodyID, inBodyUserData);
+	}
+
+	JPH::ValidateResult ContactListener::OnContactValidate(const JPH::Body& inBody1, const JPH::Body& inBody2, JPH::RVec3Arg inBaseOffset, const JPH::CollideShapeResult& inCollisionResult) {
+		if (this->_world->onContactValidate == nullptr) return JPH::ValidateResult::AcceptAllContactsForThisBodyPair;
+		return this->_world->onContactValidate(inBody1, inBody2, inBaseOffset, inCollisionResult);
+	}
+
+	void ContactListener::OnContactAdded(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings) {
+		if (!this->_world->onContactAdded.empty()) this->_world->onContactAdded(inBody1, inBody2, inManifold, ioSettings);
+		if (this->_world->contacts.recording()) this->_world->contacts.push(makeContact(rawrbox::ContactType::ADDED, inBody1, inBody2, inManifold));
+	}
+
+	void ContactListener::OnContactPersisted(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings) {
+		if (!this->_world->onContactPersisted.empty()) this->_world->onContactPersisted(inBody1, inBody2, inManifold, ioSettings);
+		if (this->_world->contacts.recording()) this->_world->contacts.push(makeContact(rawrbox::ContactType::PERSISTED, inBody1, inBody2, inManifold));
+	}
+
+	void ContactListener::OnContactRemoved(const JPH::SubShapeIDPair& inSubShapePair) {
+		if (!this->_world->onContactRemoved.empty()) this->_world->onContactRemoved(inSubShapePair);
+		if (!this->_world->contacts.recording()) return;
+
+		rawrbox::PhysicsContact contact = {};
+		contact.type = rawrbox::ContactType::REMOVED;
+		contact.body1 = inSubShapePair.GetBody1ID();
+		contact.body2 = inSubShapePair.GetBody2ID();
+		contact.subShape1 = inSubShapePair.GetSubShapeID1();
+		contact.subShape2 = inSubShapePair.GetSubShapeID2();
+
+		this->_world->contacts.push(contact);
+	}
+	// ---
+
+	PhysicsWorld::PhysicsWorld(uint32_t mbAlloc, uint32_t maxBodies, uint32_t maxBodyMutexes, uint32_t maxBodyPairs, uint32_t maxContactConstraints) {
+		if (rawrbox::PHYSICS::getJobSystem() == nullptr) RAWRBOX_CRITICAL("[RawrBox-Physics] PHYSICS::init needs to be called before creating worlds");
+
+		this->_allocator = std::make_unique<JPH::TempAllocatorImpl>(mbAlloc * 1024 * 1024); // MB
+
+		this->_bpLayerFilter = std::make_unique<rawrbox::BPLayerFilter>(this);
+		this->_bodyListener = std::make_unique<rawrbox::BodyActivationListener>(this);
+		this->_contactListener = std::make_unique<rawrbox::ContactListener>(this);
+
+		this->_system = std::make_unique<JPH::PhysicsSystem>();
+		this->_system->Init(maxBodies, maxBodyMutexes, maxBodyPairs, maxContactConstraints, rawrbox::PHYSICS::getBPLayerInterface(), *this->_bpLayerFilter, rawrbox::PHYSICS::getLayerFilter());
+		this->_system->SetBodyActivationListener(this->_bodyListener.get());
+		this->_system->SetContactListener(this->_contactListener.get());
+	}
+
+	PhysicsWorld::~PhysicsWorld() {
+		// Bodies first, their listeners are about to go
+		this->_system.reset();
+		this->_allocator.reset();
+	}
+
+	void PhysicsWorld::clear() {
+		JPH::BodyInterface& bodyInterface = this->_system->GetBodyInterface();
+
+		JPH::BodyIDVector bodies = {};
+		this->_system->GetBodies(bodies);
+
+		for (JPH::BodyID id : bodies) {
+			bodyInterface.DeactivateBody(id);
+			bodyInterface.RemoveBody(id);
+			bodyInterface.DestroyBody(id);
+		}
+
+		this->contacts.clear(); // Would point to destroyed bodies
+		this->commands.clear();
+	}
+
+	void PhysicsWorld::tick() {
+		auto* jobSystem = rawrbox::PHYSICS::getJobSystem();
+		if (jobSystem == nullptr) return;
+
+		RAWRBOX_PROFILE_ZONE("PhysicsWorld::tick");
+
+		// Nothing is simulating yet, no need for the body locks
+		this->commands.apply(this->_system->GetBodyInterfaceNoLock());
+		if (!this->simulate) return;
+
+		this->_system->Update(rawrbox::FIXED_DELTA_TIME, this->steps, this->_allocator.get(), jobSystem);
+
+		this->contacts.dispatch();
+	}
+
+	void PhysicsWorld::optimize() {
+		this->_system->OptimizeBroadPhase();
+	}
+
+	JPH::PhysicsSystem& PhysicsWorld::getSystem() const { return *this->_system; }
+	JPH::BodyInterface& PhysicsWorld::getBodyInterface() const { return this->_system->GetBodyInterface(); }
+	JPH::TempAllocatorImpl& PhysicsWorld::getAllocator() const { return *this->_allocator; }
+
+	bool PhysicsWorld::defaultShouldCollide(rawrbox::PHYS_LAYERS layer1, rawrbox::PHYS_LAYERS layer2) {
+		switch (layer1) {
+			case rawrbox::PHYS_LAYERS::STATIC:
+				return layer2 == rawrbox::PHYS_LAYERS::DYNAMIC;
+			case rawrbox::PHYS_LAYERS::DYNAMIC:
+				return true;
+			default:
+				return false;
+		}
+	}
+} // namespace rawrbox
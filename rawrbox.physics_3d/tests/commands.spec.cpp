@@ -0,0 +1,119 @@
+#include <rawrbox/engine/static.hpp>
+#include <rawrbox/physics/manager.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+	JPH::BodyCreationSettings boxSettings(const JPH::RVec3& pos) {
+		return {new JPH::BoxShape(JPH::Vec3(0.5F, 0.5F, 0.5F)), pos, JPH::Quat::sIdentity(), JPH::EMotionType::Dynamic, static_cast<JPH::ObjectLayer>(rawrbox::PHYS_LAYERS::DYNAMIC)};
+	}
+} // namespace
+
+TEST_CASE("PhysicsCommands should behave as expected", "[rawrbox::PhysicsCommands]") {
+	rawrbox::FIXED_DELTA_TIME = 1.F / 60.F;
+	rawrbox::PHYSICS::init();
+
+	{
+		rawrbox::PhysicsWorld world;
+		auto& commands = world.commands;
+		auto& bodyInterface = world.getBodyInterface();
+		auto flush = [&world, &commands]() { commands.apply(world.getSystem().GetBodyInterfaceNoLock()); };
+
+		SECTION("rawrbox::PhysicsCommands::create") {
+			auto sleeping = commands.create(boxSettings(JPH::RVec3(0, 5, 0)));
+			auto awake = commands.create(boxSettings(JPH::RVec3(2, 5, 0)), JPH::EActivation::Activate);
+
+			REQUIRE(sleeping.isValid());
+			REQUIRE(sleeping != awake);
+			REQUIRE(commands.size() == 2);
+
+			// Nothing until applied
+			REQUIRE(commands.get(sleeping).IsInvalid());
+			REQUIRE(world.getSystem().GetNumBodies() == 0);
+
+			flush();
+			REQUIRE(commands.size() == 0);
+			REQUIRE(world.getSystem().GetNumBodies() == 2);
+
+			const auto id = commands.get(sleeping);
+			REQUIRE_FALSE(id.IsInvalid());
+			REQUIRE(bodyInterface.IsAdded(id));
+			REQUIRE_FALSE(bodyInterface.IsActive(id));
+			REQUIRE(bodyInterface.GetPosition(id).GetX() == 0.F);
+			REQUIRE(bodyInterface.IsActive(commands.get(awake)));
+		}
+
+		SECTION("rawrbox::PhysicsCommands::destroy") {
+			auto handle = commands.create(boxSettings(JPH::RVec3(0, 5, 0)));
+			auto raw = bodyInterface.CreateAndAddBody(boxSettings(JPH::RVec3(2, 5, 0)), JPH::EActivation::Activate);
+			flush();
+			REQUIRE(world.getSystem().GetNumBodies() == 2);
+
+			commands.destroy(handle);
+			commands.destroy(raw); // Bodies not made by the commands work too
+			flush();
+
+			REQUIRE(world.getSystem().GetNumBodies() == 0);
+			REQUIRE(commands.get(handle).IsInvalid());
+		}
+
+		SECTION("rawrbox::PhysicsCommands create and destroy in one flush") {
+			auto handle = commands.create(boxSettings(JPH::RVec3(0, 5, 0)), JPH::EActivation::Activate);
+			commands.addImpulse(handle, {0, 10, 0});
+			commands.destroy(handle);
+			commands.addImpulse(handle, {0, 10, 0}); // Gone by now, skipped
+			commands.destroy(handle);
+
+			flush();
+			REQUIRE(world.getSystem().GetNumBodies() == 0);
+			REQUIRE(commands.get(handle).IsInvalid());
+		}
+
+		SECTION("rawrbox::PhysicsCommands handle resolution") {
+			// Target it before it exists
+			auto handle = commands.create(boxSettings(JPH::RVec3(0, 5, 0)));
+			commands.setTransform(handle, {3, 4, 5}, {0, 0, 0, 1}, JPH::EActivation::DontActivate);
+			commands.setVelocity(handle, {1, 0, 0});
+			commands.activate(handle);
+
+			// Only applied right before the update
+			world.tick();
+
+			const auto id = commands.get(handle);
+			REQUIRE_FALSE(id.IsInvalid());
+			REQUIRE(bodyInterface.IsActive(id));
+			REQUIRE(bodyInterface.GetLinearVelocity(id).GetX() == 1.F);
+			REQUIRE(bodyInterface.GetPosition(id).GetZ() == 5.F);
+			REQUIRE(bodyInterface.GetPosition(id).GetY() < 4.F); // Moved by the update, after the commands
+
+			commands.deactivate(id); // Plain ids are fine once resolved
+			flush();
+			REQUIRE_FALSE(bodyInterface.IsActive(id));
+
+			// Forgotten on clear, never handed out again
+			commands.clear();
+			REQUIRE(commands.get(handle).IsInvalid());
+			REQUIRE(commands.create(boxSettings(JPH::RVec3(0, 5, 0))).id > handle.id);
+		}
+
+		SECTION("rawrbox::PhysicsCommands destroy before create") {
+			auto old = bodyInterface.CreateAndAddBody(boxSettings(JPH::RVec3(0, 5, 0)), JPH::EActivation::Activate);
+
+			// The new body can take the slot of the old one, the old id must not reach it
+			commands.destroy(old);
+			auto handle = commands.create(boxSettings(JPH::RVec3(2, 5, 0)));
+			commands.setTransform(old, {50, 50, 50}, {0, 0, 0, 1});
+			commands.deactivate(old);
+			commands.destroy(old);
+			flush();
+
+			const auto id = commands.get(handle);
+			REQUIRE(world.getSystem().GetNumBodies() == 1);
+			REQUIRE(id != old);
+			REQUIRE(bodyInterface.IsAdded(id));
+			REQUIRE(bodyInterface.GetPosition(id).GetX() == 2.F);
+		}
+	}
+
+	rawrbox::PHYSICS::shutdown();
+}
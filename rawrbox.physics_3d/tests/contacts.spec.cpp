@@ -0,0 +1,93 @@
+#include <rawrbox/engine/static.hpp>
+#include <rawrbox/physics/manager.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace {
+	void addBox(rawrbox::PhysicsWorld& world, const JPH::RVec3& pos, const JPH::Vec3& halfSize, bool dynamic) {
+		JPH::BodyCreationSettings settings(new JPH::BoxShape(halfSize), pos, JPH::Quat::sIdentity(), dynamic ? JPH::EMotionType::Dynamic : JPH::EMotionType::Static, static_cast<JPH::ObjectLayer>(dynamic ? rawrbox::PHYS_LAYERS::DYNAMIC : rawrbox::PHYS_LAYERS::STATIC));
+		world.getBodyInterface().CreateAndAddBody(settings, dynamic ? JPH::EActivation::Activate : JPH::EActivation::DontActivate);
+	}
+
+	// Stacks of crates falling on a floor and on each other, returns every dispatched contact in order
+	std::vector<rawrbox::PhysicsContact> simulate(uint32_t threads) {
+		std::vector<rawrbox::PhysicsContact> out = {};
+		rawrbox::PHYSICS::init(20, 2048, 2048, 2048, 2048, threads);
+
+		{
+			rawrbox::PhysicsWorld world;
+			world.contacts.setRecording(true);
+
+			addBox(world, JPH::RVec3(0, -1, 0), JPH::Vec3(50, 1, 50), false);
+			for (int i = 0; i < 48; i++) {
+				addBox(world, JPH::RVec3(static_cast<float>(i % 4) * 1.1F, 1.F + static_cast<float>(i / 4) * 1.2F, static_cast<float>(i % 3) * 0.3F), JPH::Vec3(0.5F, 0.5F, 0.5F), true);
+			}
+
+			for (int i = 0; i < 90; i++) {
+				world.tick();
+
+				const auto& contacts = world.contacts.get();
+				REQUIRE(std::is_sorted(contacts.begin(), contacts.end()));
+				out.insert(out.end(), contacts.begin(), contacts.end());
+			}
+		}
+
+		rawrbox::PHYSICS::shutdown();
+		return out;
+	}
+
+	bool same(const rawrbox::PhysicsContact& a, const rawrbox::PhysicsContact& b) {
+		return a.type == b.type && a.body1 == b.body1 && a.body2 == b.body2 && a.subShape1 == b.subShape1 && a.subShape2 == b.subShape2 &&
+		       a.layer1 == b.layer1 && a.layer2 == b.layer2 && a.point == b.point && a.normal == b.normal && a.depth == b.depth && a.speed == b.speed;
+	}
+} // namespace
+
+TEST_CASE("PhysicsContacts should behave as expected", "[rawrbox::PhysicsContacts]") {
+	rawrbox::FIXED_DELTA_TIME = 1.F / 60.F;
+
+	SECTION("rawrbox::PhysicsContacts thread count") {
+		const auto single = simulate(1);
+		const auto many = simulate(8);
+
+		REQUIRE_FALSE(single.empty());
+		REQUIRE(single.size() == many.size());
+
+		for (size_t i = 0; i < single.size(); i++) {
+			REQUIRE(same(single[i], many[i]));
+		}
+	}
+
+	SECTION("rawrbox::PHYSICS::forwardEvents") {
+		rawrbox::PHYSICS::init();
+
+		auto& world = rawrbox::PHYSICS::getWorld();
+		addBox(world, JPH::RVec3(0, -1, 0), JPH::Vec3(50, 1, 50), false);
+		addBox(world, JPH::RVec3(0, 1, 0), JPH::Vec3(0.5F, 0.5F, 0.5F), true);
+
+		std::atomic<int> added = 0;
+		auto token = rawrbox::PHYSICS::onContactAdded += [&added](const JPH::Body& /*a*/, const JPH::Body& /*b*/, const JPH::ContactManifold& /*manifold*/, JPH::ContactSettings& /*settings*/) { added++; };
+
+		for (int i = 0; i < 60; i++) {
+			rawrbox::PHYSICS::tick();
+		}
+
+		REQUIRE(added > 0);
+
+		// Unhooked, the world stops calling it
+		rawrbox::PHYSICS::onContactAdded -= token;
+		rawrbox::PHYSICS::tick();
+		REQUIRE(world.onContactAdded.empty());
+
+		added = 0;
+		rawrbox::PHYSICS::onContactAdded += [&added](const JPH::Body& /*a*/, const JPH::Body& /*b*/, const JPH::ContactManifold& /*manifold*/, JPH::ContactSettings& /*settings*/) { added++; };
+		rawrbox::PHYSICS::tick({&world});
+		REQUIRE(world.onContactAdded.size() == 1);
+
+		rawrbox::PHYSICS::onContactAdded.clear();
+		rawrbox::PHYSICS::shutdown();
+	}
+}
@@ -0,0 +1,125 @@
+#include <rawrbox/physics/manager.hpp>
+#include <rawrbox/physics/partition.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+	JPH::BodyCreationSettings boxSettings(const JPH::RVec3& pos, bool dynamic) {
+		return {new JPH::BoxShape(JPH::Vec3(0.5F, 0.5F, 0.5F)), pos, JPH::Quat::sIdentity(), dynamic ? JPH::EMotionType::Dynamic : JPH::EMotionType::Static, static_cast<JPH::ObjectLayer>(dynamic ? rawrbox::PHYS_LAYERS::DYNAMIC : rawrbox::PHYS_LAYERS::STATIC)};
+	}
+} // namespace
+
+TEST_CASE("PhysicsPartition should behave as expected", "[rawrbox::PhysicsPartition]") {
+	rawrbox::PHYSICS::init();
+
+	SECTION("rawrbox::PhysicsPartition out of bodies") {
+		rawrbox::PhysicsWorld world(20, 4, 4, 64, 64);
+		rawrbox::PhysicsPartition partition(64.F, 128.F, 160.F, 8, &world);
+
+		// Something else is holding half the bodies
+		auto& bodyInterface = world.getBodyInterface();
+		auto a = bodyInterface.CreateAndAddBody(boxSettings(JPH::RVec3(0, 50, 0), true), JPH::EActivation::Activate);
+		auto b = bodyInterface.CreateAndAddBody(boxSettings(JPH::RVec3(2, 50, 0), true), JPH::EActivation::Activate);
+
+		// One cell, more bodies than what's left
+		for (int i = 0; i < 3; i++) {
+			partition.addStatic(boxSettings(JPH::RVec3(static_cast<float>(i) * 2.F, 0, 0), false));
+		}
+
+		partition.setActivator(0, {0, 0, 0});
+		REQUIRE_THROWS(partition.update());
+
+		// The half created batch got destroyed, not leaked, and the cell isn't marked as loaded
+		REQUIRE(world.getSystem().GetNumBodies() == 2);
+		REQUIRE(partition.getLoadedBodies() == 0);
+		REQUIRE_FALSE(partition.getGrid().isLoaded({0, 0}));
+
+		// Room again, the next update retries it
+		for (const auto& id : {a, b}) {
+			bodyInterface.RemoveBody(id);
+			bodyInterface.DestroyBody(id);
+		}
+
+		partition.update();
+		REQUIRE(partition.getGrid().isLoaded({0, 0}));
+		REQUIRE(partition.getLoadedBodies() == 3);
+		REQUIRE(world.getSystem().GetNumBodies() == 3);
+
+		partition.clear();
+		REQUIRE(world.getSystem().GetNumBodies() == 0);
+	}
+
+	SECTION("rawrbox::PhysicsPartition streaming") {
+		// 100x100 cells of 10 units, a static on each, way more than the world can hold at once
+		rawrbox::PhysicsWorld world(20, 1024, 1024, 1024, 1024);
+		rawrbox::PhysicsPartition partition(10.F, 50.F, 70.F, 64, &world);
+
+		for (int z = 0; z < 100; z++) {
+			for (int x = 0; x < 100; x++) {
+				partition.addStatic(boxSettings(JPH::RVec3(static_cast<float>(x) * 10.F + 5.F, 0, static_cast<float>(z) * 10.F + 5.F), false));
+			}
+		}
+
+		REQUIRE(partition.getGrid().size() == 10000);
+
+		const auto& grid = partition.getGrid();
+		auto settle = [&partition]() {
+			for (int i = 0; i < 32; i++) {
+				partition.update();
+				if (partition.getStats().cellsLoaded == 0) break;
+			}
+		};
+
+		// Walk across the whole world, the loaded bodies always match the loaded cells
+		for (int step = 0; step <= 20; step++) {
+			const float t = static_cast<float>(step) * 50.F;
+			partition.setActivator(0, {t, 0.F, t});
+			settle();
+
+			REQUIRE(partition.getLoadedBodies() == grid.loadedCount());
+			REQUIRE(world.getSystem().GetNumBodies() == grid.loadedCount());
+
+			for (int z = 0; z < 100; z++) {
+				for (int x = 0; x < 100; x++) {
+					const float distance = grid.getDistance(grid.getCellCenter({x, z}));
+					if (distance <= 50.F) REQUIRE(grid.isLoaded({x, z}));
+					if (distance > 70.F) REQUIRE_FALSE(grid.isLoaded({x, z}));
+				}
+			}
+		}
+
+		REQUIRE(partition.getLoadedBodies() > 0);
+
+		partition.removeActivator(0);
+		partition.update();
+		REQUIRE(partition.getLoadedBodies() == 0);
+		REQUIRE(world.getSystem().GetNumBodies() == 0);
+
+		partition.clear();
+	}
+
+	SECTION("rawrbox::PhysicsPartition destroyed dynamic") {
+		rawrbox::PhysicsWorld world;
+		rawrbox::PhysicsPartition partition(64.F, 128.F, 160.F, 8, &world);
+		partition.setLOD(64.F, 1);
+		partition.setActivator(0, {1000, 0, 0}); // Far from both
+
+		auto& bodyInterface = world.getBodyInterface();
+		auto alive = bodyInterface.CreateAndAddBody(boxSettings(JPH::RVec3(0, 0, 0), true), JPH::EActivation::Activate);
+		auto dead = bodyInterface.CreateAndAddBody(boxSettings(JPH::RVec3(0, 0, 0), true), JPH::EActivation::Activate);
+		partition.addDynamic(alive);
+		partition.addDynamic(dead);
+
+		// Gone without removeDynamic
+		bodyInterface.RemoveBody(dead);
+		bodyInterface.DestroyBody(dead);
+
+		partition.update();
+		REQUIRE(partition.isFrozen(alive));
+		REQUIRE_FALSE(partition.isFrozen(dead));
+
+		partition.clear();
+	}
+
+	rawrbox::PHYSICS::shutdown();
+}
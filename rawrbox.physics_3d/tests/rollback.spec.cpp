@@ -0,0 +1,114 @@
+#include <rawrbox/engine/static.hpp>
+#include <rawrbox/physics/manager.hpp>
+#include <rawrbox/physics/rollback.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace {
+	JPH::BodyID addBox(rawrbox::PhysicsWorld& world, const JPH::RVec3& pos, const JPH::Vec3& halfSize, bool dynamic) {
+		JPH::BodyCreationSettings settings(new JPH::BoxShape(halfSize), pos, JPH::Quat::sIdentity(), dynamic ? JPH::EMotionType::Dynamic : JPH::EMotionType::Static, static_cast<JPH::ObjectLayer>(dynamic ? rawrbox::PHYS_LAYERS::DYNAMIC : rawrbox::PHYS_LAYERS::STATIC));
+		return world.getBodyInterface().CreateAndAddBody(settings, dynamic ? JPH::EActivation::Activate : JPH::EActivation::DontActivate);
+	}
+
+	// Ticks the rollback up to the given frame, returns the hash of every frame it recorded
+	std::map<uint64_t, uint32_t> run(rawrbox::PhysicsRollback& rollback, uint64_t frames, const rawrbox::PhysicsInput& input) {
+		std::map<uint64_t, uint32_t> hashes = {};
+		while (rollback.getFrame() < frames) {
+			rollback.tick(input);
+			hashes[rollback.getFrame()] = rollback.getHash(rollback.getFrame()).value_or(0);
+		}
+
+		return hashes;
+	}
+} // namespace
+
+TEST_CASE("PhysicsRollback should behave as expected", "[rawrbox::PhysicsRollback]") {
+	rawrbox::FIXED_DELTA_TIME = 1.F / 60.F;
+	rawrbox::PHYSICS::init();
+
+	{
+		rawrbox::PhysicsWorld world;
+		rawrbox::PhysicsRollback rollback(64, 16, &world);
+
+		addBox(world, JPH::RVec3(0, -1, 0), JPH::Vec3(50, 1, 50), false);
+		std::vector<JPH::BodyID> crates = {};
+		for (int i = 0; i < 4; i++) {
+			crates.push_back(addBox(world, JPH::RVec3(static_cast<float>(i) * 2.F, 3.F, 0), JPH::Vec3(0.5F, 0.5F, 0.5F), true));
+		}
+
+		// Kicks a crate every few frames
+		auto input = [&world, &crates](uint64_t frame) {
+			if (frame % 5 != 0) return;
+			world.getBodyInterface().AddImpulse(crates[frame % crates.size()], JPH::Vec3(0, 2000.F, 500.F));
+		};
+
+		rollback.save();
+		REQUIRE(rollback.getHash(0).value() == rawrbox::PhysicsRollback::hash(world));
+
+		auto hashes = run(rollback, 40, input);
+		REQUIRE(rollback.getFrame() == 40);
+		REQUIRE(hashes.size() == 40);
+		REQUIRE(hashes[40] == rawrbox::PhysicsRollback::hash(world));
+		REQUIRE(hashes[10] != hashes[40]); // Things moved
+
+		SECTION("rawrbox::PhysicsRollback::restore") {
+			REQUIRE(rollback.restore(10));
+			REQUIRE(rollback.getFrame() == 10);
+			REQUIRE(rawrbox::PhysicsRollback::hash(world) == hashes[10]);
+
+			// Everything after it is gone
+			REQUIRE(rollback.getHash(10).has_value());
+			REQUIRE_FALSE(rollback.getHash(11).has_value());
+			REQUIRE_FALSE(rollback.restore(20));
+		}
+
+		SECTION("rawrbox::PhysicsRollback::resimulate") {
+			REQUIRE(rollback.resimulate(10, input));
+			REQUIRE(rollback.getFrame() == 40);
+
+			// Same inputs, same frames
+			for (uint64_t frame = 11; frame <= 40; frame++) {
+				REQUIRE(rollback.getHash(frame).value() == hashes[frame]);
+			}
+
+			REQUIRE(rawrbox::PhysicsRollback::hash(world) == hashes[40]);
+			REQUIRE(rollback.validate(40, hashes[40]));
+		}
+
+		SECTION("rawrbox::PhysicsRollback late input") {
+			// An input for frame 12 arrived late
+			auto late = [&input, &world, &crates](uint64_t frame) {
+				input(frame);
+				if (frame == 12) world.getBodyInterface().AddImpulse(crates[0], JPH::Vec3(3000.F, 0, 0));
+			};
+
+			REQUIRE(rollback.resimulate(12, late));
+			REQUIRE(rollback.getFrame() == 40);
+			REQUIRE(rollback.getHash(12).value() == hashes[12]); // Before it, untouched
+			REQUIRE(rollback.getHash(40).value() != hashes[40]);
+
+			uint64_t desynced = 0;
+			rollback.onDesync += [&desynced](uint64_t frame, uint32_t /*local*/, uint32_t /*remote*/) { desynced = frame; };
+
+			REQUIRE_FALSE(rollback.validate(40, hashes[40]));
+			REQUIRE(desynced == 40);
+
+			// And back to the original timeline
+			REQUIRE(rollback.resimulate(12, input));
+			REQUIRE(rollback.getHash(40).value() == hashes[40]);
+		}
+
+		SECTION("rawrbox::PhysicsRollback too old") {
+			run(rollback, 100, input);
+			REQUIRE_FALSE(rollback.restore(10)); // Only the last 64 frames are kept
+			REQUIRE_FALSE(rollback.resimulate(101, input));
+			REQUIRE(rollback.restore(60));
+		}
+	}
+
+	rawrbox::PHYSICS::shutdown();
+}
@@ -0,0 +1,223 @@
+#include <rawrbox/engine/static.hpp>
+#include <rawrbox/physics/manager.hpp>
+#include <rawrbox/physics/world.hpp>
+#include <rawrbox/utils/threading.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+	JPH::BodyID addBox(rawrbox::PhysicsWorld& world, const JPH::RVec3& pos, const JPH::Vec3& halfSize, bool dynamic) {
+		JPH::BodyCreationSettings settings(new JPH::BoxShape(halfSize), pos, JPH::Quat::sIdentity(), dynamic ? JPH::EMotionType::Dynamic : JPH::EMotionType::Static, static_cast<JPH::ObjectLayer>(dynamic ? rawrbox::PHYS_LAYERS::DYNAMIC : rawrbox::PHYS_LAYERS::STATIC));
+		return world.getBodyInterface().CreateAndAddBody(settings, dynamic ? JPH::EActivation::Activate : JPH::EActivation::DontActivate);
+	}
+
+	// A floor with a stack of crates dropping on it
+	void fill(rawrbox::PhysicsWorld& world, int crates) {
+		addBox(world, JPH::RVec3(0, -1, 0), JPH::Vec3(50, 1, 50), false);
+
+		for (int i = 0; i < crates; i++) {
+			addBox(world, JPH::RVec3(static_cast<float>(i % 8) * 1.5F, 2.F + static_cast<float>(i / 8) * 1.5F, 0), JPH::Vec3(0.5F, 0.5F, 0.5F), true);
+		}
+
+		world.optimize();
+	}
+
+	// What a world saw during the ticks, contacts come from the Jolt workers
+	struct Touches {
+		std::mutex lock;
+		std::set<JPH::BodyID> bodies = {}; // Dynamic bodies that hit something
+		int added = 0;
+	};
+} // namespace
+
+TEST_CASE("PhysicsWorld should behave as expected", "[rawrbox::PhysicsWorld]") {
+	rawrbox::FIXED_DELTA_TIME = 1.F / 60.F; // 0 = Jolt skips the update
+	rawrbox::PHYSICS::init(20, 2048, 2048, 2048, 2048, 0, 32);
+
+	SECTION("rawrbox::PhysicsWorld isolation") {
+		rawrbox::PhysicsWorld a;
+		rawrbox::PhysicsWorld b;
+
+		// Same spot, only a has a floor
+		addBox(a, JPH::RVec3(0, -1, 0), JPH::Vec3(50, 1, 50), false);
+		auto boxA = addBox(a, JPH::RVec3(0, 2, 0), JPH::Vec3(0.5F, 0.5F, 0.5F), true);
+		auto boxB = addBox(b, JPH::RVec3(0, 2, 0), JPH::Vec3(0.5F, 0.5F, 0.5F), true);
+
+		std::atomic<int> contactsA = 0;
+		std::atomic<int> contactsB = 0;
+		a.onContactAdded += [&contactsA](const JPH::Body& /*a*/, const JPH::Body& /*b*/, const JPH::ContactManifold& /*manifold*/, JPH::ContactSettings& /*settings*/) { contactsA++; };
+		b.onContactAdded += [&contactsB](const JPH::Body& /*a*/, const JPH::Body& /*b*/, const JPH::ContactManifold& /*manifold*/, JPH::ContactSettings& /*settings*/) { contactsB++; };
+
+		for (int i = 0; i < 120; i++) {
+			rawrbox::PHYSICS::tick({&a, &b});
+		}
+
+		REQUIRE(a.getSystem().GetNumBodies() == 2);
+		REQUIRE(b.getSystem().GetNumBodies() == 1);
+		REQUIRE(rawrbox::PHYSICS::getWorld().getSystem().GetNumBodies() == 0);
+
+		REQUIRE(a.getBodyInterface().GetPosition(boxA).GetY() > 0.4F); // Resting on the floor
+		REQUIRE(b.getBodyInterface().GetPosition(boxB).GetY() < -5.F); // Nothing to land on
+		REQUIRE(contactsA > 0);
+		REQUIRE(contactsB == 0);
+
+		// Ids only mean something in their own world
+		REQUIRE_FALSE(b.getBodyInterface().IsAdded(boxA));
+	}
+
+	SECTION("rawrbox::PhysicsWorld::clear") {
+		rawrbox::PhysicsWorld a;
+		rawrbox::PhysicsWorld b;
+		fill(a, 8);
+		fill(b, 8);
+
+		a.clear();
+		REQUIRE(a.getSystem().GetNumBodies() == 0);
+		REQUIRE(b.getSystem().GetNumBodies() == 9);
+	}
+
+	SECTION("rawrbox::PHYSICS default world events") {
+		auto& world = rawrbox::PHYSICS::getWorld();
+
+		// Nothing listening, nothing for the world to dispatch
+		rawrbox::PHYSICS::tick();
+		REQUIRE(world.onContactAdded.empty());
+
+		auto token = rawrbox::PHYSICS::onContactAdded += [](const JPH::Body& /*a*/, const JPH::Body& /*b*/, const JPH::ContactManifold& /*manifold*/, JPH::ContactSettings& /*settings*/) {};
+		rawrbox::PHYSICS::tick();
+		REQUIRE(world.onContactAdded.size() == 1);
+		REQUIRE(world.onContactRemoved.empty());
+
+		rawrbox::PHYSICS::onContactAdded -= token;
+		rawrbox::PHYSICS::tick();
+		REQUIRE(world.onContactAdded.empty());
+	}
+
+	SECTION("rawrbox::PHYSICS default world settings") {
+		auto& world = rawrbox::PHYSICS::getWorld();
+		rawrbox::PhysicsWorld other;
+
+		auto box = addBox(world, JPH::RVec3(0, 2, 0), JPH::Vec3(0.5F, 0.5F, 0.5F), true);
+		auto otherBox = addBox(other, JPH::RVec3(0, 2, 0), JPH::Vec3(0.5F, 0.5F, 0.5F), true);
+
+		rawrbox::PHYSICS::simulate = false;
+		rawrbox::PHYSICS::tick({&world, &other});
+		rawrbox::PHYSICS::simulate = true;
+
+		REQUIRE(world.getBodyInterface().GetPosition(box).GetY() == 2.F);
+		REQUIRE(other.getBodyInterface().GetPosition(otherBox).GetY() < 2.F); // Only the default world follows the static settings
+
+		rawrbox::PHYSICS::steps = 4;
+		rawrbox::PHYSICS::tick({&world});
+		rawrbox::PHYSICS::steps = 1;
+		REQUIRE(world.steps == 4);
+	}
+
+	rawrbox::PHYSICS::shutdown();
+}
+
+TEST_CASE("PhysicsWorld should tick many worlds together", "[rawrbox::PhysicsWorld]") {
+	rawrbox::FIXED_DELTA_TIME = 1.F / 60.F;
+	rawrbox::ASYNC::init(16);
+	rawrbox::PHYSICS::init(20, 2048, 2048, 2048, 2048, 0, 8); // Less than the worlds, so they go in batches
+
+	{
+		constexpr size_t WORLDS = 32;
+
+		std::vector<std::unique_ptr<rawrbox::PhysicsWorld>> owned = {};
+		std::vector<rawrbox::PhysicsWorld*> worlds = {};
+		std::vector<std::vector<JPH::BodyID>> crates(WORLDS);
+		std::array<Touches, WORLDS> touches = {};
+
+		for (size_t i = 0; i < WORLDS; i++) {
+			auto& world = owned.emplace_back(std::make_unique<rawrbox::PhysicsWorld>());
+			worlds.push_back(world.get());
+
+			// Even worlds get a floor, every world a different amount of crates side by side
+			if (i % 2 == 0) addBox(*world, JPH::RVec3(0, -1, 0), JPH::Vec3(50, 1, 50), false);
+			for (size_t c = 0; c < 1 + i % 4; c++) {
+				crates[i].push_back(addBox(*world, JPH::RVec3(static_cast<float>(c) * 2.F, 2.F, 0), JPH::Vec3(0.5F, 0.5F, 0.5F), true));
+			}
+
+			auto& touch = touches[i];
+			world->onContactAdded += [&touch](const JPH::Body& a, const JPH::Body& b, const JPH::ContactManifold& /*manifold*/, JPH::ContactSettings& /*settings*/) {
+				std::scoped_lock lock(touch.lock);
+				touch.added++;
+				touch.bodies.insert(a.IsDynamic() ? a.GetID() : b.GetID());
+			};
+		}
+
+		for (int i = 0; i < 120; i++) {
+			rawrbox::PHYSICS::tick(worlds);
+		}
+
+		for (size_t i = 0; i < WORLDS; i++) {
+			auto& bodyInterface = worlds[i]->getBodyInterface();
+			REQUIRE(worlds[i]->getSystem().GetNumBodies() == crates[i].size() + (i % 2 == 0 ? 1 : 0));
+
+			for (size_t c = 0; c < crates[i].size(); c++) {
+				auto pos = bodyInterface.GetPosition(crates[i][c]);
+				REQUIRE(pos.GetX() == static_cast<float>(c) * 2.F);
+
+				if (i % 2 == 0) {
+					REQUIRE(pos.GetY() > 0.4F); // Resting on the floor
+					REQUIRE(pos.GetY() < 0.6F);
+				} else {
+					REQUIRE(pos.GetY() < -5.F); // Nothing to land on
+				}
+			}
+
+			if (i % 2 == 0) {
+				REQUIRE(touches[i].added >= static_cast<int>(crates[i].size()));
+				REQUIRE(touches[i].bodies == std::set<JPH::BodyID>(crates[i].begin(), crates[i].end()));
+			} else {
+				REQUIRE(touches[i].added == 0);
+			}
+		}
+	}
+
+	rawrbox::PHYSICS::shutdown();
+	rawrbox::ASYNC::shutdown();
+}
+
+TEST_CASE("PhysicsWorld benchmark", "[rawrbox::PhysicsWorld][.benchmark]") {
+	rawrbox::FIXED_DELTA_TIME = 1.F / 60.F;
+	rawrbox::ASYNC::init(std::max(std::thread::hardware_concurrency(), 2U)); // Worlds tick in parallel on it
+	rawrbox::PHYSICS::init(20, 2048, 2048, 2048, 2048, 0, 32);
+
+	{
+		std::vector<std::unique_ptr<rawrbox::PhysicsWorld>> owned = {};
+		std::vector<rawrbox::PhysicsWorld*> worlds = {};
+
+		for (int i = 0; i < 32; i++) {
+			auto& world = owned.emplace_back(std::make_unique<rawrbox::PhysicsWorld>());
+			fill(*world, 64);
+			worlds.push_back(world.get());
+		}
+
+		BENCHMARK("Tick 32 worlds (together)") {
+			rawrbox::PHYSICS::tick(worlds);
+			return worlds.size();
+		};
+
+		BENCHMARK("Tick 32 worlds (one by one)") {
+			for (auto* world : worlds)
+				world->tick();
+
+			return worlds.size();
+		};
+	}
+
+	rawrbox::PHYSICS::shutdown();
+	rawrbox::ASYNC::shutdown();
+}
@@ -20,4 +20,18 @@ namespace rawrbox {
 		void init() override;
 	};
 
+	// For rawrbox::FONT_TYPE::SDF fonts
+	class MaterialText3DSDF : public rawrbox::MaterialText3D {
+		static bool _build;
+
+	public:
+		MaterialText3DSDF() = default;
+		MaterialText3DSDF(const MaterialText3DSDF&) = delete;
+		MaterialText3DSDF(MaterialText3DSDF&&) = delete;
+		MaterialText3DSDF& operator=(const MaterialText3DSDF&) = delete;
+		MaterialText3DSDF& operator=(MaterialText3DSDF&&) = delete;
+		~MaterialText3DSDF() override = default;
+
+		void init() override;
+	};
 } // namespace rawrbox
@@ -5,34 +5,150 @@
 
 #include <Buffer.h>
 
+#include <limits>
+
 namespace rawrbox {
 
+	// Contiguous run of vertices moved by a blend shape, deltas for it start at offset
+	struct BlendShapeSpan {
+		uint32_t start = 0;
+		uint32_t count = 0;
+		uint32_t offset = 0;
+	};
+
+	// Sparse morph target, only the vertices that move are stored, as SoA deltas
 	template <typename M = rawrbox::MaterialUnlit>
 		requires(std::derived_from<M, rawrbox::MaterialBase>)
 	struct BlendShapes {
 	public:
+		// Vertices closer than this get merged in the same span, so tiny gaps don't break the runs
+		static constexpr uint32_t SPAN_GAP = 8;
+		static constexpr float EPSILON = 1e-6F;
+
 		float weight = 0.F;
 
 		rawrbox::Mesh<typename M::vertexBufferType>* mesh = nullptr; // For quick access
 
-		std::vector<rawrbox::Vector3f> pos = {};
-		std::vector<rawrbox::Vector4f> normals = {};
+		std::vector<rawrbox::BlendShapeSpan> spans = {};
+
+		std::vector<float> posX = {};
+		std::vector<float> posY = {};
+		std::vector<float> posZ = {};
+
+		std::vector<float> normX = {}; // Empty if the shape has no normal deltas
+		std::vector<float> normY = {};
+		std::vector<float> normZ = {};
+
+		[[nodiscard]] bool isActive() const { return weight > 0.F && !spans.empty(); }
+		[[nodiscard]] bool hasNormals() const { return !normX.empty(); }
+
+		[[nodiscard]] uint32_t first() const { return spans.empty() ? 0 : spans.front().start; }
+		[[nodiscard]] uint32_t last() const { return spans.empty() ? 0 : spans.back().start + spans.back().count; }
+
+		// Dense per vertex deltas (ex: glTF morph targets), either can be empty
+		void setDeltas(const std::vector<rawrbox::Vector3f>& pos, const std::vector<rawrbox::Vector4f>& normals) {
+			this->spans.clear();
+			this->posX.clear();
+			this->posY.clear();
+			this->posZ.clear();
+			this->normX.clear();
+			this->normY.clear();
+			this->normZ.clear();
+
+			const size_t total = std::max(pos.size(), normals.size());
+
+			auto moves = [&pos, &normals](size_t i) {
+				if (i < pos.size() && (std::abs(pos[i].x) > EPSILON || std::abs(pos[i].y) > EPSILON || std::abs(pos[i].z) > EPSILON)) return true;
+				if (i < normals.size() && (std::abs(normals[i].x) > EPSILON || std::abs(normals[i].y) > EPSILON || std::abs(normals[i].z) > EPSILON)) return true;
+				return false;
+			};
+
+			// Find the spans ---
+			for (size_t i = 0; i < total; i++) {
+				if (!moves(i)) continue;
+
+				if (!this->spans.empty()) {
+					auto& span = this->spans.back();
+					if (i - (span.start + span.count) <= SPAN_GAP) {
+						span.count = static_cast<uint32_t>(i - span.start + 1);
+						continue;
+					}
+				}
+
+				uint32_t offset = this->spans.empty() ? 0 : this->spans.back().offset + this->spans.back().count;
+				this->spans.push_back({static_cast<uint32_t>(i), 1, offset});
+			}
+			// ---
+
+			if (this->spans.empty()) return;
+
+			const size_t deltas = this->spans.back().offset + this->spans.back().count;
+			this->posX.resize(deltas, 0.F);
+			this->posY.resize(deltas, 0.F);
+			this->posZ.resize(deltas, 0.F);
+
+			if (!normals.empty()) {
+				this->normX.resize(deltas, 0.F);
+				this->normY.resize(deltas, 0.F);
+				this->normZ.resize(deltas, 0.F);
+			}
+
+			for (const auto& span : this->spans) {
+				for (uint32_t i = 0; i < span.count; i++) {
+					const size_t vert = span.start + i;
+					const size_t delta = span.offset + i;
+
+					if (vert < pos.size()) {
+						this->posX[delta] = pos[vert].x;
+						this->posY[delta] = pos[vert].y;
+						this->posZ[delta] = pos[vert].z;
+					}
+
+					if (vert < normals.size()) {
+						this->normX[delta] = normals[vert].x;
+						this->normY[delta] = normals[vert].y;
+						this->normZ[delta] = normals[vert].z;
+					}
+				}
+			}
+		}
 
-		[[nodiscard]] bool isActive() const { return weight > 0.F; }
 		BlendShapes() = default;
 	};
 
+	// Per mesh original data + accumulators, in SoA so every active shape is added on one pass
+	struct BlendShapeState {
+		std::vector<float> posX = {};
+		std::vector<float> posY = {};
+		std::vector<float> posZ = {};
+
+		std::vector<float> normX = {};
+		std::vector<float> normY = {};
+		std::vector<float> normZ = {};
+
+		std::vector<float> accum = {}; // 6 * vertices, pos xyz + normal xyz
+
+		// Range written on the last apply, it needs restoring if the shapes turn off
+		uint32_t dirtyStart = 0;
+		uint32_t dirtyEnd = 0;
+		bool dirtyNormals = false;
+
+		[[nodiscard]] size_t size() const { return posX.size(); }
+	};
+
+	// out[i] += weight * delta[i], kept plain so it gets auto-vectorized
+	inline void blendAccumulate(float* __restrict out, const float* __restrict delta, float weight, size_t count) {
+		for (size_t i = 0; i < count; i++) {
+			out[i] += weight * delta[i];
+		}
+	}
+
 	enum class UploadType {
 		STATIC = 0,
 		FIXED_DYNAMIC = 1,
 		RESIZABLE_DYNAMIC = 2
 	};
 
-	struct ModelOriginalData {
-		rawrbox::Vector3f pos = {};
-		uint32_t normal = {};
-	};
-
 	template <typename M = rawrbox::MaterialUnlit>
 		requires(std::derived_from<M, rawrbox::MaterialBase>)
 	class ModelBase {
@@ -45,11 +161,16 @@ namespace rawrbox {
 		std::unique_ptr<M> _material = nullptr;
 
 		std::unordered_map<std::string, std::unique_ptr<rawrbox::BlendShapes<M>>> _blend_shapes = {};
-		std::vector<rawrbox::ModelOriginalData> _original_data = {};
+		std::unordered_map<rawrbox::Mesh<typename M::vertexBufferType>*, rawrbox::BlendShapeState> _blend_states = {};
+		std::unordered_map<rawrbox::Mesh<typename M::vertexBufferType>*, std::vector<rawrbox::BlendShapes<M>*>> _blend_active = {}; // Scratch
 
 		// DYNAMIC SUPPORT ---
 		rawrbox::UploadType _uploadType = rawrbox::UploadType::STATIC;
 		bool _requiresUpdate = false;
+
+		// Partial vertex update, [start, end)
+		uint32_t _dirtyVertexStart = std::numeric_limits<uint32_t>::max();
+		uint32_t _dirtyVertexEnd = 0;
 		// ----
 
 		// LOGGER ------
@@ -57,70 +178,193 @@ namespace rawrbox {
 		// -------------
 
 		// BLEND SHAPES ---
-		virtual void calculateOriginalShape() {
-			auto vertSize = static_cast<uint32_t>(this->_mesh->vertices.size());
-			auto indcSize = static_cast<uint32_t>(this->_mesh->indices.size());
-
-			auto empty = vertSize == 0 || indcSize == 0;
-			if (empty) RAWRBOX_CRITICAL("Invalid mesh! Missing vertices / indices!");
-
-			// Store original positions for blendstates
-			this->_original_data.clear();
-			this->_original_data.reserve(vertSize);
-
-			for (auto& v : this->_mesh->vertices) {
-				if constexpr (supportsNormals<typename M::vertexBufferType>) {
-					this->_original_data.push_back({v.position, v.normal});
-				} else {
-					this->_original_data.push_back({v.position, {}});
+		virtual void captureOriginalShape(rawrbox::Mesh<typename M::vertexBufferType>& mesh, rawrbox::BlendShapeState& state) {
+			const size_t vertSize = mesh.vertices.size();
+			if (vertSize == 0) RAWRBOX_CRITICAL("Invalid mesh! Missing vertices!");
+
+			state.posX.resize(vertSize);
+			state.posY.resize(vertSize);
+			state.posZ.resize(vertSize);
+			state.accum.resize(vertSize * 6);
+
+			for (size_t i = 0; i < vertSize; i++) {
+				const auto& v = mesh.vertices[i];
+
+				state.posX[i] = v.position.x;
+				state.posY[i] = v.position.y;
+				state.posZ[i] = v.position.z;
+			}
+
+			if constexpr (supportsNormals<typename M::vertexBufferType>) {
+				state.normX.resize(vertSize);
+				state.normY.resize(vertSize);
+				state.normZ.resize(vertSize);
+
+				for (size_t i = 0; i < vertSize; i++) {
+					auto normal = rawrbox::PackUtils::fromNormal(mesh.vertices[i].normal);
+
+					state.normX[i] = normal[0];
+					state.normY[i] = normal[1];
+					state.normZ[i] = normal[2];
 				}
 			}
-			// -----------
 		}
 
-		virtual void applyBlendShapes() {
-			if (!this->isUploaded()) RAWRBOX_CRITICAL("Blendshapes require the model to be uploaded!");
-			if (!this->isDynamic()) RAWRBOX_CRITICAL("Blendshapes require the model to be dynamic!");
+		// Evaluates every active shape of the mesh, returns the written vertex range
+		virtual std::pair<uint32_t, uint32_t> evaluateBlendShapes(rawrbox::Mesh<typename M::vertexBufferType>& mesh, rawrbox::BlendShapeState& state, const std::vector<rawrbox::BlendShapes<M>*>& shapes) {
+			auto& verts = mesh.vertices;
+			if (state.size() == 0) this->captureOriginalShape(mesh, state); // Initial setup
+			if (state.size() != verts.size()) RAWRBOX_CRITICAL("Blendshape mesh vertices changed! Original verts: {}, current verts: {}", state.size(), verts.size());
+
+			// Range to write, includes the last one so turned off shapes get restored
+			uint32_t start = state.dirtyStart;
+			uint32_t end = state.dirtyEnd;
+			uint32_t activeStart = std::numeric_limits<uint32_t>::max();
+			uint32_t activeEnd = 0;
+
+			bool normals = false;
+			for (const auto* shape : shapes) {
+				if (shape->last() > verts.size()) RAWRBOX_CRITICAL("Blendshape verts do not match with the mesh verts! Total verts: {}, blend shape verts: {}", verts.size(), shape->last());
+
+				activeStart = std::min(activeStart, shape->first());
+				activeEnd = std::max(activeEnd, shape->last());
+				normals |= shape->hasNormals();
+			}
 
-			if (this->_original_data.empty()) this->calculateOriginalShape(); // Initial setup
+			if (activeEnd > activeStart) {
+				start = start == end ? activeStart : std::min(start, activeStart);
+				end = std::max(end, activeEnd);
+			}
 
-			for (auto& shape : this->_blend_shapes) {
-				if (!shape.second->isActive() || shape.second->mesh == nullptr) continue;
+			if (start >= end) return {0, 0};
 
-				auto& verts = shape.second->mesh->vertices;
-				auto& blendPos = shape.second->pos;
-				auto& blendNormals = shape.second->normals;
+			const size_t vertSize = verts.size();
+			const size_t count = end - start;
 
-				if (!blendPos.empty() && blendPos.size() != verts.size()) {
-					RAWRBOX_CRITICAL("Blendshape verts do not match with the mesh '{}' verts! Total verts: {}, blend shape verts: {}", shape.first, verts.size(), blendPos.size());
-				}
+			float* accPosX = state.accum.data();
+			float* accPosY = accPosX + vertSize;
+			float* accPosZ = accPosY + vertSize;
+			float* accNormX = accPosZ + vertSize;
+			float* accNormY = accNormX + vertSize;
+			float* accNormZ = accNormY + vertSize;
 
-				if (!blendNormals.empty() && blendNormals.size() != verts.size()) {
-					RAWRBOX_CRITICAL("Blendshape normals do not match with the mesh '{}' verts! Total verts: {}, blend shape verts: {}", shape.first, verts.size(), blendNormals.size());
-				}
+			// Reset to original ---
+			std::copy_n(state.posX.data() + start, count, accPosX + start);
+			std::copy_n(state.posY.data() + start, count, accPosY + start);
+			std::copy_n(state.posZ.data() + start, count, accPosZ + start);
 
-				float step = std::clamp(shape.second->weight, 0.F, 1.F);
+			const bool writeNormals = !state.normX.empty() && (normals || state.dirtyNormals);
+			if (writeNormals) {
+				std::copy_n(state.normX.data() + start, count, accNormX + start);
+				std::copy_n(state.normY.data() + start, count, accNormY + start);
+				std::copy_n(state.normZ.data() + start, count, accNormZ + start);
+			}
+			// ---
+
+			// Accumulate ---
+			for (const auto* shape : shapes) {
+				const float weight = std::clamp(shape->weight, 0.F, 1.F);
+
+				for (const auto& span : shape->spans) {
+					blendAccumulate(accPosX + span.start, shape->posX.data() + span.offset, weight, span.count);
+					blendAccumulate(accPosY + span.start, shape->posY.data() + span.offset, weight, span.count);
+					blendAccumulate(accPosZ + span.start, shape->posZ.data() + span.offset, weight, span.count);
 
-				// Apply vertices ----
-				for (size_t i = 0; i < blendPos.size(); i++) {
-					verts[i].position = this->_original_data[i].pos.lerp(blendPos[i], step);
+					if (!writeNormals || !shape->hasNormals()) continue;
+					blendAccumulate(accNormX + span.start, shape->normX.data() + span.offset, weight, span.count);
+					blendAccumulate(accNormY + span.start, shape->normY.data() + span.offset, weight, span.count);
+					blendAccumulate(accNormZ + span.start, shape->normZ.data() + span.offset, weight, span.count);
 				}
-				// -------------------
+			}
+			// ---
+
+			// Write back ---
+			for (uint32_t i = start; i < end; i++) {
+				verts[i].position = {accPosX[i], accPosY[i], accPosZ[i]};
+			}
 
-				// Apply normal ----
-				if constexpr (supportsNormals<typename M::vertexBufferType>) {
-					for (size_t i = 0; i < blendNormals.size(); i++) {
-						rawrbox::Vector4f unpacked = rawrbox::Vector4f(rawrbox::PackUtils::fromNormal(this->_original_data[i].normal)).lerp(blendNormals[i], step); // meh
-						verts[i].normal = rawrbox::PackUtils::packNormal(unpacked.x, unpacked.y, unpacked.z);
+			if constexpr (supportsNormals<typename M::vertexBufferType>) {
+				if (writeNormals) {
+					for (uint32_t i = start; i < end; i++) {
+						rawrbox::Vector3f normal = rawrbox::Vector3f{accNormX[i], accNormY[i], accNormZ[i]}.normalized();
+						verts[i].normal = rawrbox::PackUtils::packNormal(normal.x, normal.y, normal.z);
 					}
 				}
-				// -------------------
 			}
+			// ---
+
+			state.dirtyStart = activeEnd > activeStart ? activeStart : 0;
+			state.dirtyEnd = activeEnd > activeStart ? activeEnd : 0;
+			state.dirtyNormals = normals;
+
+			return {start, end};
+		}
+
+		// Called with the mesh local range written by the blend shapes
+		virtual void onBlendShapesApplied(rawrbox::Mesh<typename M::vertexBufferType>* mesh, uint32_t start, uint32_t end) {
+			if (mesh != this->_mesh.get()) return; // Not part of our buffer
+			this->updateVertexRange(start, end);
+		}
+
+		virtual void applyBlendShapes() {
+			if (!this->isUploaded()) RAWRBOX_CRITICAL("Blendshapes require the model to be uploaded!");
+			if (!this->isDynamic()) RAWRBOX_CRITICAL("Blendshapes require the model to be dynamic!");
+
+			// Group the active shapes per mesh ---
+			for (auto& active : this->_blend_active)
+				active.second.clear();
+
+			for (auto& shape : this->_blend_shapes) {
+				if (shape.second->mesh == nullptr) continue;
+
+				auto& active = this->_blend_active[shape.second->mesh];
+				if (shape.second->isActive()) active.push_back(shape.second.get());
+			}
+			// ---
+
+			for (auto& active : this->_blend_active) {
+				auto range = this->evaluateBlendShapes(*active.first, this->_blend_states[active.first], active.second);
+				if (range.second > range.first) this->onBlendShapesApplied(active.first, range.first, range.second);
+			}
+		}
+
+		virtual void clearBlendShapes() {
+			this->_blend_shapes.clear();
+			this->_blend_states.clear();
+			this->_blend_active.clear();
 		}
 		// --------------
 
+		virtual void internalUpdateRange() {
+			if (this->_dirtyVertexEnd <= this->_dirtyVertexStart) return;
+
+			auto start = static_cast<uint64_t>(this->_dirtyVertexStart);
+			auto end = std::min<uint64_t>(this->_dirtyVertexEnd, this->_mesh->vertices.size());
+
+			this->_dirtyVertexStart = std::numeric_limits<uint32_t>::max();
+			this->_dirtyVertexEnd = 0;
+
+			if (end <= start || end * sizeof(typename M::vertexBufferType) > this->_vbh->GetDesc().Size) return;
+			auto* context = rawrbox::RENDERER->context();
+
+			// BARRIER -----
+			rawrbox::BarrierUtils::barrier({{this->_vbh, Diligent::RESOURCE_STATE_VERTEX_BUFFER, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
+			context->UpdateBuffer(this->_vbh, start * sizeof(typename M::vertexBufferType), (end - start) * sizeof(typename M::vertexBufferType), this->_mesh->vertices.data() + start, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+			rawrbox::BarrierUtils::barrier({{this->_vbh, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::RESOURCE_STATE_VERTEX_BUFFER, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
+			// -----------
+		}
+
 		virtual void internalUpdate() {
-			if (!this->isUploaded() || !this->isDynamic() || !this->_requiresUpdate) return;
+			if (!this->isUploaded() || !this->isDynamic()) return;
+			if (!this->_requiresUpdate) {
+				this->internalUpdateRange();
+				return;
+			}
+
+			// Full update, covers any pending range
+			this->_dirtyVertexStart = std::numeric_limits<uint32_t>::max();
+			this->_dirtyVertexEnd = 0;
+
 			auto* context = rawrbox::RENDERER->context();
 
 			auto vertSize = static_cast<uint64_t>(this->_mesh->vertices.size());
@@ -245,9 +489,25 @@ namespace rawrbox {
 		bool createBlendShape(const std::string& id, const std::vector<rawrbox::Vector3f>& newVertexPos, const std::vector<rawrbox::Vector4f>& newNormPos, float weight = 0.F) {
 			if (this->_mesh == nullptr) RAWRBOX_CRITICAL("Mesh not initialized!");
 
+			auto& verts = this->_mesh->vertices;
+			if (newVertexPos.size() > verts.size() || newNormPos.size() > verts.size()) RAWRBOX_CRITICAL("Blendshape verts do not match with the mesh '{}' verts! Total verts: {}, blend shape verts: {}", id, verts.size(), std::max(newVertexPos.size(), newNormPos.size()));
+
+			// Stored as deltas against the original shape
+			auto& state = this->_blend_states[this->_mesh.get()];
+			if (state.size() == 0) this->captureOriginalShape(*this->_mesh, state);
+
+			std::vector<rawrbox::Vector3f> posDeltas(newVertexPos.size());
+			for (size_t i = 0; i < newVertexPos.size(); i++) {
+				posDeltas[i] = newVertexPos[i] - rawrbox::Vector3f{state.posX[i], state.posY[i], state.posZ[i]};
+			}
+
+			std::vector<rawrbox::Vector4f> normDeltas(state.normX.empty() ? 0 : newNormPos.size());
+			for (size_t i = 0; i < normDeltas.size(); i++) {
+				normDeltas[i] = newNormPos[i] - rawrbox::Vector4f{state.normX[i], state.normY[i], state.normZ[i], newNormPos[i].w};
+			}
+
 			auto blend = std::make_unique<rawrbox::BlendShapes<M>>();
-			blend->pos = newVertexPos;
-			blend->normals = newNormPos;
+			blend->setDeltas(posDeltas, normDeltas);
 			blend->weight = weight;
 			blend->mesh = this->_mesh.get();
 
@@ -295,6 +555,14 @@ namespace rawrbox {
 			this->_requiresUpdate = this->isDynamic() && this->isUploaded();
 		}
 
+		// Only re-upload the vertices on [start, end)
+		virtual void updateVertexRange(uint32_t start, uint32_t end) {
+			if (!this->isDynamic() || !this->isUploaded() || end <= start) return;
+
+			this->_dirtyVertexStart = std::min(this->_dirtyVertexStart, start);
+			this->_dirtyVertexEnd = std::max(this->_dirtyVertexEnd, end);
+		}
+
 		[[nodiscard]] virtual uint32_t getID(int /*index*/ = -1) const { return this->_mesh->getID(); }
 		virtual void setID(uint32_t id, int /*index*/ = -1) {
 			this->_mesh->setID(id);
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <rawrbox/math/frustum.hpp>
 #include <rawrbox/render/materials/instanced.hpp>
 #include <rawrbox/render/models/instance.hpp>
 #include <rawrbox/render/models/model.hpp>
+#include <rawrbox/utils/dirty_ranges.hpp>
+#include <rawrbox/utils/slot_map.hpp>
 
 #include <DynamicBuffer.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 namespace rawrbox {
 
 	template <typename M = rawrbox::MaterialInstanced>
@@ -13,13 +19,130 @@ namespace rawrbox {
 	class InstancedModel : public rawrbox::ModelBase<M> {
 	protected:
 		std::unique_ptr<Diligent::DynamicBuffer> _dataBuffer = nullptr;
-		std::vector<rawrbox::Instance> _instances = {};
+		rawrbox::SlotMap<rawrbox::Instance> _instances = {};
+
+		// INCREMENTAL UPDATES ---
+		rawrbox::DirtyRanges _dirtyInstances = {};
+		uint32_t _dirtyCount = 0;
+		bool _fullInstanceUpdate = false;
+		// ----
+
+		// CULLING ---
+		bool _culling = false;
+		bool _cullDirty = true;
+		rawrbox::Matrix4x4 _cullMatrix = {};
+		std::vector<rawrbox::Instance> _visible = {};
+		// ----
 
 		void updateBuffers() override {
 			rawrbox::ModelBase<M>::updateBuffers();
 			this->updateInstances();
 		}
 
+		virtual void markInstance(uint32_t index) {
+			this->_cullDirty = true;
+			if (this->_fullInstanceUpdate) return;
+
+			// Past this, tracking ranges costs more than uploading everything
+			if (++this->_dirtyCount > std::max<size_t>(this->_instances.size() / 8, 64)) {
+				this->_fullInstanceUpdate = true;
+				this->_dirtyInstances.clear();
+				return;
+			}
+
+			this->_dirtyInstances.mark(index);
+		}
+
+		virtual void reserveInstances(size_t count) {
+			auto* context = rawrbox::RENDERER->context();
+			auto* device = rawrbox::RENDERER->device();
+
+			uint64_t size = sizeof(rawrbox::Instance) * static_cast<uint64_t>(std::max<size_t>(count, 1));
+			if (size <= this->_dataBuffer->GetDesc().Size) return;
+
+			this->_instances.reserve(std::max<size_t>(count, this->_instances.capacity() + this->_instances.capacity() / 2 + 16));
+			this->_dataBuffer->Resize(device, context, sizeof(rawrbox::Instance) * static_cast<uint64_t>(this->_instances.capacity()), true);
+
+			this->_fullInstanceUpdate = true; // Content was discarded
+		}
+
+		virtual void uploadInstances(const rawrbox::Instance* data, const std::vector<rawrbox::DirtyRange>& ranges) {
+			auto* context = rawrbox::RENDERER->context();
+			auto* buffer = this->_dataBuffer->GetBuffer();
+
+			// BARRIER ----
+			rawrbox::BarrierUtils::barrier({{buffer, Diligent::RESOURCE_STATE_VERTEX_BUFFER, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
+			for (const auto& range : ranges) {
+				context->UpdateBuffer(buffer, sizeof(rawrbox::Instance) * static_cast<uint64_t>(range.start), sizeof(rawrbox::Instance) * static_cast<uint64_t>(range.count()), data + range.start, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+			}
+			rawrbox::BarrierUtils::barrier({{buffer, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::RESOURCE_STATE_VERTEX_BUFFER, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
+			//  ---------
+		}
+
+		// Compacts the instances visible from the given view-projection, returns false if nothing changed since the last cull
+		virtual bool cullInstances(const rawrbox::Matrix4x4& viewProj) {
+			auto matrix = viewProj * this->getMatrix();
+			if (!this->_cullDirty && matrix == this->_cullMatrix) return false;
+
+			this->_cullMatrix = matrix;
+			this->_cullDirty = false;
+
+			// Frustum on model space, instances only need their own transform
+			rawrbox::Frustum frustum(matrix);
+
+			const auto& bbox = this->_mesh->bbox;
+			const rawrbox::Vector3f center = (bbox.min + bbox.max) / 2.F;
+			const float radius = (bbox.max - bbox.min).length() / 2.F;
+
+			this->_visible.clear();
+			for (const auto& instance : this->_instances) {
+				if (radius <= 0.F) {
+					this->_visible.push_back(instance);
+					continue;
+				}
+
+				const auto& m = instance.matrix.mtx;
+				const float scale = std::sqrt(std::max({m[0] * m[0] + m[1] * m[1] + m[2] * m[2],
+				    m[4] * m[4] + m[5] * m[5] + m[6] * m[6],
+				    m[8] * m[8] + m[9] * m[9] + m[10] * m[10]}));
+
+				if (frustum.containsSphere(instance.matrix.mulVec(center), radius * scale)) this->_visible.push_back(instance);
+			}
+
+			return true;
+		}
+
+		virtual void internalUpdateInstances(const rawrbox::CameraBase* camera) {
+			if (this->_dataBuffer == nullptr) return;
+
+			if (this->_culling && camera != nullptr) {
+				this->_dirtyInstances.clear();
+				this->_dirtyCount = 0;
+				this->_fullInstanceUpdate = false;
+
+				if (!this->cullInstances(camera->getViewProjMtx()) || this->_visible.empty()) return;
+
+				this->reserveInstances(this->_visible.size());
+				this->uploadInstances(this->_visible.data(), {{0, static_cast<uint32_t>(this->_visible.size())}});
+
+				return;
+			}
+
+			if (this->_instances.empty()) return;
+			this->reserveInstances(this->_instances.size());
+
+			if (this->_fullInstanceUpdate) {
+				this->uploadInstances(this->_instances.data().data(), {{0, static_cast<uint32_t>(this->_instances.size())}});
+			} else if (!this->_dirtyInstances.empty()) {
+				this->_dirtyInstances.clamp(static_cast<uint32_t>(this->_instances.size()));
+				this->uploadInstances(this->_instances.data().data(), this->_dirtyInstances.get());
+			}
+
+			this->_dirtyInstances.clear();
+			this->_dirtyCount = 0;
+			this->_fullInstanceUpdate = false;
+		}
+
 	public:
 		explicit InstancedModel(size_t instanceSize = 0) {
 			if (instanceSize != 0) this->_instances.reserve(instanceSize);
@@ -37,6 +160,7 @@ namespace rawrbox {
 		virtual void setTemplate(rawrbox::Mesh<typename M::vertexBufferType> mesh) {
 			if (mesh.empty()) RAWRBOX_CRITICAL("Invalid mesh! Missing vertices / indices!");
 			this->_mesh = std::make_unique<rawrbox::Mesh<typename M::vertexBufferType>>(mesh);
+			this->_cullDirty = true;
 
 			if (this->isUploaded() && this->isDynamic()) {
 				this->updateBuffers();
@@ -48,22 +172,60 @@ namespace rawrbox {
 			return *this->_mesh;
 		}
 
-		virtual void addInstance(const rawrbox::Instance& instance) {
-			this->_instances.push_back(instance);
+		// INSTANCES ---
+		// Returns a handle that stays valid until the instance is removed (matches the old index until something gets removed)
+		virtual uint32_t addInstance(const rawrbox::Instance& instance) {
+			auto handle = this->_instances.insert(instance);
+			this->markInstance(this->_instances.indexOf(handle));
+
+			return handle;
+		}
+
+		virtual void removeInstance(uint32_t handle = 0) {
+			if (!this->_instances.valid(handle)) RAWRBOX_CRITICAL("Failed to find instance");
+
+			auto moved = this->_instances.remove(handle);
+			if (moved != rawrbox::SlotMap<rawrbox::Instance>::INVALID) this->markInstance(moved);
+
+			this->_cullDirty = true;
+		}
+
+		virtual void updateInstance(uint32_t handle, const rawrbox::Instance& instance) {
+			this->getInstance(handle) = instance;
+			this->markInstanceDirty(handle);
 		}
 
-		virtual void removeInstance(size_t i = 0) {
-			if (i >= this->_instances.size()) RAWRBOX_CRITICAL("Failed to find instance");
-			this->_instances.erase(this->_instances.begin() + i);
+		// Call after modifying an instance from getInstance
+		virtual void markInstanceDirty(uint32_t handle) {
+			if (!this->_instances.valid(handle)) RAWRBOX_CRITICAL("Failed to find instance");
+			this->markInstance(this->_instances.indexOf(handle));
 		}
 
-		[[nodiscard]] rawrbox::Instance& getInstance(size_t i = 0) {
-			if (i >= this->_instances.size()) RAWRBOX_CRITICAL("Failed to find instance");
-			return this->_instances[i];
+		[[nodiscard]] rawrbox::Instance& getInstance(uint32_t handle = 0) {
+			if (!this->_instances.valid(handle)) RAWRBOX_CRITICAL("Failed to find instance");
+			return this->_instances.get(handle);
 		}
 
-		virtual std::vector<rawrbox::Instance>& instances() { return this->_instances; }
+		[[nodiscard]] bool hasInstance(uint32_t handle) const { return this->_instances.valid(handle); }
+
+		// Packed draw order, changes as instances are removed. Use getInstanceHandle + getInstance to modify them
+		[[nodiscard]] virtual const std::vector<rawrbox::Instance>& instances() const { return this->_instances.data(); }
+		[[nodiscard]] virtual uint32_t getInstanceHandle(size_t index) const { return this->_instances.handleAt(index); }
 		[[nodiscard]] virtual size_t count() const { return this->_instances.size(); }
+		// ----
+
+		// CULLING ---
+		// Uploads only the instances inside the frustum of the camera given to draw (MAIN_CAMERA by default), using the template bbox
+		// Drawing the same model from several cameras re-culls (and re-uploads) on every camera switch
+		virtual void setCulling(bool enabled) {
+			this->_culling = enabled;
+			this->_cullDirty = true;
+			this->_fullInstanceUpdate = !enabled;
+		}
+
+		[[nodiscard]] virtual bool isCulling() const { return this->_culling; }
+		[[nodiscard]] virtual size_t visibleCount() const { return this->_culling ? this->_visible.size() : this->_instances.size(); }
+		// ----
 
 		void upload(rawrbox::UploadType type = rawrbox::UploadType::STATIC) override {
 			rawrbox::ModelBase<M>::upload(type);
@@ -91,31 +253,28 @@ namespace rawrbox {
 			if (size != 0) this->updateInstances(); // Data was already added, then update the buffer
 		}
 
+		// Re-uploads every instance right away
 		virtual void updateInstances() {
 			if (this->_dataBuffer == nullptr) RAWRBOX_CRITICAL("Data buffer not valid! Did you call upload()?");
 
-			auto* context = rawrbox::RENDERER->context();
-			auto* device = rawrbox::RENDERER->device();
-
-			// Update buffer ----
-			uint64_t size = sizeof(rawrbox::Instance) * static_cast<uint64_t>(this->_instances.capacity());
-			if (size > this->_dataBuffer->GetDesc().Size) {
-				this->_instances.reserve(this->_instances.capacity() + 16);
-				this->_dataBuffer->Resize(device, context, sizeof(rawrbox::Decal) * static_cast<uint64_t>(_instances.capacity()), true);
-			}
-
-			auto* buffer = this->_dataBuffer->GetBuffer();
+			this->_fullInstanceUpdate = true;
+			this->_cullDirty = true;
 
-			// BARRIER ----
-			rawrbox::BarrierUtils::barrier({{buffer, Diligent::RESOURCE_STATE_VERTEX_BUFFER, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
-			context->UpdateBuffer(buffer, 0, size, this->_instances.empty() ? nullptr : this->_instances.data(), Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
-			rawrbox::BarrierUtils::barrier({{buffer, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::RESOURCE_STATE_VERTEX_BUFFER, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
-			//  ---------
+			this->internalUpdateInstances(rawrbox::MAIN_CAMERA);
 		}
 
-		void draw() override {
+		void draw() override { this->draw(*rawrbox::MAIN_CAMERA); }
+
+		// Culls against the camera being rendered (ex: the one given to the draw call), instead of MAIN_CAMERA
+		virtual void draw(const rawrbox::CameraBase& camera) {
 			if (!this->isUploaded()) RAWRBOX_CRITICAL("Failed to render model, vertex / index buffer is not uploaded");
-			if (this->_instances.empty()) return;
+
+			// Execute pending instance updates --
+			this->internalUpdateInstances(&camera);
+			// --------------------------
+
+			auto total = static_cast<uint32_t>(this->visibleCount());
+			if (total == 0) return;
 
 			auto* context = rawrbox::RENDERER->context();
 
@@ -150,7 +309,7 @@ namespace rawrbox {
 			DrawAttrs.FirstIndexLocation = this->_mesh->baseIndex;
 			DrawAttrs.BaseVertex = this->_mesh->baseVertex;
 			DrawAttrs.NumIndices = this->_mesh->totalIndex;
-			DrawAttrs.NumInstances = static_cast<uint32_t>(this->_instances.size());
+			DrawAttrs.NumInstances = total;
 			DrawAttrs.Flags = Diligent::DRAW_FLAG_VERIFY_ALL; // Instanced buffers are only updated once
 			// if (!updated) DrawAttrs.Flags |= Diligent::DRAW_FLAG_DYNAMIC_RESOURCE_BUFFERS_INTACT;
 
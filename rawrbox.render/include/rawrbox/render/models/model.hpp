@@ -1,11 +1,13 @@
 #pragma once
 
 #include <rawrbox/engine/static.hpp>
+#include <rawrbox/render/cameras/base.hpp>
 #include <rawrbox/render/lights/manager.hpp>
 #include <rawrbox/render/models/animations/skeleton.hpp>
 #include <rawrbox/render/models/animations/vertex.hpp>
 #include <rawrbox/render/models/base.hpp>
 #include <rawrbox/render/models/utils/optimization.hpp>
+#include <rawrbox/render/render_queue.hpp>
 #include <rawrbox/render/static.hpp>
 
 namespace rawrbox {
@@ -151,11 +153,18 @@ namespace rawrbox {
 		}
 
 		// BLEND SHAPES ---
-		void applyBlendShapes() override {
-			rawrbox::ModelBase<M>::applyBlendShapes();
+		// Copy only the blended range into the flattened buffer, instead of re-flattening everything
+		void onBlendShapesApplied(rawrbox::Mesh<typename M::vertexBufferType>* mesh, uint32_t start, uint32_t end) override {
+			if (mesh == this->_mesh.get()) {
+				rawrbox::ModelBase<M>::onBlendShapesApplied(mesh, start, end);
+				return;
+			}
 
-			this->flattenMeshes(false, false); // No need to optimize & sort, it's just vertex changes
-			rawrbox::ModelBase<M>::updateBuffers();
+			auto& verts = this->_mesh->vertices;
+			if (static_cast<size_t>(mesh->baseVertex) + end > verts.size()) RAWRBOX_CRITICAL("Blendshape mesh is not part of the model buffer!");
+
+			std::copy(mesh->vertices.begin() + start, mesh->vertices.begin() + end, verts.begin() + mesh->baseVertex + start);
+			this->updateVertexRange(mesh->baseVertex + start, mesh->baseVertex + end);
 		}
 		// --------------
 
@@ -526,5 +535,48 @@ namespace rawrbox {
 				// -----------
 			}
 		}
+
+		// Like draw(), but adds a draw item per mesh to the queue instead, so they get sorted (and batched) with everything else on it
+		virtual void enqueue(rawrbox::RenderQueue& queue, const rawrbox::CameraBase& camera, uint8_t layer = 0) {
+			if (!this->isUploaded()) RAWRBOX_CRITICAL("Failed to queue model, vertex / index buffer is not uploaded");
+			if (this->_material == nullptr) RAWRBOX_CRITICAL("Material not set");
+
+			this->internalUpdate();
+			this->tickAnimations();
+
+			for (auto& mesh : this->_meshes) {
+				if (mesh == nullptr || mesh->empty()) continue; // Bone, skip it.
+
+				rawrbox::DrawItem item = {};
+				item.material = this->_material.get();
+				item.pipeline = this->_material->getPipeline(*mesh);
+				item.vertexBuffer = this->_vbh;
+				item.indexBuffer = this->_ibh;
+				item.firstIndex = mesh->baseIndex;
+				item.baseVertex = mesh->baseVertex;
+				item.numIndices = mesh->totalIndex;
+				item.transform = this->getMatrix() * mesh->getMatrix();
+				item.owner = mesh.get();
+
+				// The material type is only known here, so the uniforms are bound through it
+				item.bind = [](const rawrbox::DrawItem& queued) {
+					auto* material = static_cast<M*>(queued.material);
+					const auto& data = *static_cast<const rawrbox::Mesh<typename M::vertexBufferType>*>(queued.owner);
+
+					material->bindVertexUniforms(data);
+					material->bindVertexSkinnedUniforms(data);
+					material->bindPixelUniforms(data);
+				};
+
+				const rawrbox::Vector3f center = item.transform.mulVec((mesh->bbox.min + mesh->bbox.max) / 2.F);
+				const uint32_t depth = rawrbox::RenderKey::quantizeDepth(center.distance(camera.getPos()), camera.getZNear(), camera.getZFar());
+
+				const uint16_t pipeline = queue.getPipelineID(item.pipeline);
+				const uint16_t textures = queue.getTextureSetID(mesh->textures.getTextureIDs());
+
+				item.key = mesh->isTransparent() ? rawrbox::RenderKey::translucent(layer, pipeline, textures, depth) : rawrbox::RenderKey::opaque(layer, pipeline, textures, depth);
+				queue.push(item);
+			}
+		}
 	};
 } // namespace rawrbox
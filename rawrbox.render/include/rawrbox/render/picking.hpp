@@ -0,0 +1,122 @@
+#pragma once
+
+#include <rawrbox/math/bvh.hpp>
+#include <rawrbox/math/matrix4x4.hpp>
+#include <rawrbox/math/ray.hpp>
+#include <rawrbox/math/triangle_bvh.hpp>
+#include <rawrbox/render/cameras/base.hpp>
+#include <rawrbox/render/models/mesh.hpp>
+#include <rawrbox/utils/logger.hpp>
+#include <rawrbox/utils/slot_map.hpp>
+
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace rawrbox {
+	struct PickHit {
+		uint32_t instance = 0; // Picking instance handle
+		uint32_t id = 0;       // Whatever was given on addInstance (ex: the mesh id, like gpuPick returns)
+
+		uint32_t triangle = 0;
+		float u = 0.F; // Barycentric, see rawrbox::RayHit
+		float v = 0.F;
+
+		float distance = 0.F; // World space
+		rawrbox::Vector3f position = {};
+	};
+
+	struct PickInstance {
+		uint32_t mesh = 0;
+		uint32_t id = 0;
+
+		rawrbox::Matrix4x4 matrix = {};
+		rawrbox::Matrix4x4 inverse = {};
+	};
+
+	// CPU picking, the alternative to RendererBase::gpuPick that doesn't need the GPU (or a window, works on servers)
+	// Each mesh gets a triangle BVH (shared by all its instances), and a top level BVH holds the instances in world space
+	//
+	// auto mesh = picking.addMesh(*model->getMesh());
+	// picking.addInstance(mesh, model->getMatrix(), id);
+	// auto hit = picking.pick(*camera, mousePos);
+	class Picking {
+	protected:
+		rawrbox::SlotMap<rawrbox::TriangleBVH> _meshes = {};
+		rawrbox::SlotMap<rawrbox::PickInstance> _instances = {};
+
+		// Top level, in the instances dense order
+		rawrbox::BVH _bvh = {};
+		std::vector<rawrbox::BBOX> _bounds = {};
+
+		bool _rebuild = true;             // Instances added / removed, the top level is built again
+		std::vector<uint32_t> _dirty = {}; // Dense indices of the instances that moved (or their mesh deformed), only their bounds are redone before the refit
+
+		void updateTree();
+		void markDirty(uint32_t index);
+		[[nodiscard]] rawrbox::BBOX getWorldBBOX(const rawrbox::PickInstance& instance) const;
+
+	public:
+		Picking() = default;
+		Picking(const Picking&) = delete;
+		Picking(Picking&&) = delete;
+		Picking& operator=(const Picking&) = delete;
+		Picking& operator=(Picking&&) = delete;
+		virtual ~Picking() = default;
+
+		// MESHES ---
+		template <typename T = rawrbox::VertexData>
+		uint32_t addMesh(const rawrbox::Mesh<T>& mesh) {
+			return this->addMesh(getPositions(mesh), mesh.getIndices());
+		}
+
+		uint32_t addMesh(std::vector<rawrbox::Vector3f> positions, std::vector<uint32_t> indices);
+
+		// Skinned / animated meshes, same triangles on new positions
+		template <typename T = rawrbox::VertexData>
+		void updateMesh(uint32_t mesh, const rawrbox::Mesh<T>& data) {
+			this->updateMesh(mesh, getPositions(data));
+		}
+
+		void updateMesh(uint32_t mesh, const std::vector<rawrbox::Vector3f>& positions);
+		// Removes its instances too
+		void removeMesh(uint32_t mesh);
+
+		[[nodiscard]] const rawrbox::TriangleBVH& getMesh(uint32_t mesh) const;
+
+		template <typename T = rawrbox::VertexData>
+		[[nodiscard]] static std::vector<rawrbox::Vector3f> getPositions(const rawrbox::Mesh<T>& mesh) {
+			const auto& vertices = mesh.getVertices();
+
+			std::vector<rawrbox::Vector3f> positions = {};
+			positions.reserve(vertices.size());
+
+			for (const auto& vertex : vertices) {
+				positions.push_back(vertex.position);
+			}
+
+			return positions;
+		}
+		// ---
+
+		// INSTANCES ---
+		uint32_t addInstance(uint32_t mesh, const rawrbox::Matrix4x4& matrix, uint32_t id = 0);
+		void setMatrix(uint32_t instance, const rawrbox::Matrix4x4& matrix);
+		void removeInstance(uint32_t instance);
+
+		[[nodiscard]] const rawrbox::PickInstance& getInstance(uint32_t instance) const;
+		[[nodiscard]] size_t size() const;
+		// ---
+
+		void clear();
+
+		// Closest triangle along the ray (world space)
+		[[nodiscard]] std::optional<rawrbox::PickHit> raycast(const rawrbox::Ray& ray, float maxDistance = std::numeric_limits<float>::max());
+		// Ray through a pixel of the camera render target
+		[[nodiscard]] std::optional<rawrbox::PickHit> pick(const rawrbox::CameraBase& camera, const rawrbox::Vector2i& pos);
+
+		// Instance / triangle pairs with their triangle bbox touching the given (world space) bbox, conservative on rotated instances
+		void query(const rawrbox::BBOX& bbox, std::vector<std::pair<uint32_t, uint32_t>>& out);
+	};
+} // namespace rawrbox
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <rawrbox/math/matrix4x4.hpp>
+#include <rawrbox/math/vector4.hpp>
+#include <rawrbox/utils/sort.hpp>
+
+#include <Buffer.h>
+#include <PipelineState.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace rawrbox {
+	class MaterialBase;
+
+	// 64 bit sort key, draws are ordered by comparing it as a plain integer
+	// Opaque:      layer (8) | translucent = 0 (1) | pipeline (16) | textures (16) | depth (23, front to back)
+	// Translucent: layer (8) | translucent = 1 (1) | depth (23, back to front) | pipeline (16) | textures (16)
+	class RenderKey {
+	public:
+		static constexpr uint32_t DEPTH_BITS = 23;
+		static constexpr uint32_t DEPTH_MAX = (1U << DEPTH_BITS) - 1;
+
+		static constexpr uint64_t LAYER_SHIFT = 56;
+		static constexpr uint64_t TRANSLUCENT_SHIFT = 55;
+
+		[[nodiscard]] static uint64_t opaque(uint8_t layer, uint16_t pipeline, uint16_t textures, uint32_t depth);
+		[[nodiscard]] static uint64_t translucent(uint8_t layer, uint16_t pipeline, uint16_t textures, uint32_t depth);
+
+		[[nodiscard]] static uint8_t getLayer(uint64_t key);
+		[[nodiscard]] static bool isTranslucent(uint64_t key);
+		[[nodiscard]] static uint16_t getPipeline(uint64_t key);
+		[[nodiscard]] static uint16_t getTextures(uint64_t key);
+		[[nodiscard]] static uint32_t getDepth(uint64_t key);
+
+		// Linear depth between the camera planes, to DEPTH_BITS
+		[[nodiscard]] static uint32_t quantizeDepth(float depth, float zNear, float zFar);
+	};
+
+	struct DrawItem {
+		uint64_t key = 0;
+
+		rawrbox::MaterialBase* material = nullptr;
+		Diligent::IPipelineState* pipeline = nullptr;
+		Diligent::IBuffer* vertexBuffer = nullptr;
+		Diligent::IBuffer* indexBuffer = nullptr;
+
+		uint32_t firstIndex = 0;
+		uint32_t baseVertex = 0;
+		uint32_t numIndices = 0;
+
+		rawrbox::Matrix4x4 transform = {};
+
+		// Uploads the per mesh uniforms before drawing, set by whoever queued it (ex: Model::enqueue)
+		void (*bind)(const rawrbox::DrawItem& item) = nullptr;
+		const void* owner = nullptr;
+	};
+
+	struct RenderQueueStats {
+		uint32_t draws = 0;
+		uint32_t pipelines = 0;
+		uint32_t materials = 0;
+		uint32_t buffers = 0;
+		uint32_t transforms = 0;
+	};
+
+	// Where the queue sends its commands, only called when the state actually changes
+	class RenderRecorder {
+	public:
+		RenderRecorder() = default;
+		RenderRecorder(const RenderRecorder&) = default;
+		RenderRecorder(RenderRecorder&&) = default;
+		RenderRecorder& operator=(const RenderRecorder&) = default;
+		RenderRecorder& operator=(RenderRecorder&&) = default;
+		virtual ~RenderRecorder() = default;
+
+		virtual void setPipeline(Diligent::IPipelineState* pipeline) = 0;
+		virtual void setMaterial(rawrbox::MaterialBase* material) = 0;
+		virtual void setBuffers(Diligent::IBuffer* vertex, Diligent::IBuffer* index) = 0;
+		virtual void setTransform(const rawrbox::Matrix4x4& transform) = 0;
+		virtual void draw(const rawrbox::DrawItem& item) = 0;
+	};
+
+	// Records into the renderer context, for the main camera
+	class RenderContextRecorder : public rawrbox::RenderRecorder {
+	public:
+		void setPipeline(Diligent::IPipelineState* pipeline) override;
+		void setMaterial(rawrbox::MaterialBase* material) override;
+		void setBuffers(Diligent::IBuffer* vertex, Diligent::IBuffer* index) override;
+		void setTransform(const rawrbox::Matrix4x4& transform) override;
+		void draw(const rawrbox::DrawItem& item) override;
+	};
+
+	// Draws are queued (with their key) instead of submitted right away, then sorted and submitted skipping redundant binds
+	//
+	// queue.clear();
+	// model->enqueue(queue, *camera);
+	// queue.submit(recorder);
+	class RenderQueue {
+	protected:
+		std::vector<rawrbox::DrawItem> _items = {};
+		std::vector<uint64_t> _keys = {};
+		std::vector<uint32_t> _order = {};
+		rawrbox::SortUtils::RadixScratch _scratch = {};
+		bool _sorted = true;
+
+		// Small stable ids for the keys, kept between frames
+		std::unordered_map<const void*, uint16_t> _pipelineIDs = {};
+		std::unordered_map<uint64_t, uint16_t> _textureIDs = {};
+
+		rawrbox::RenderQueueStats _stats = {};
+
+	public:
+		void clear();
+		void push(const rawrbox::DrawItem& item);
+		void reserve(size_t size);
+
+		// Ids start at 1, when they run out everything else gets the last one (still draws fine, just sorts worse)
+		[[nodiscard]] uint16_t getPipelineID(const void* pipeline);
+		[[nodiscard]] uint16_t getTextureSetID(const rawrbox::Vector4_t<uint32_t>& textures);
+
+		void sort();
+		void submit(rawrbox::RenderRecorder& recorder);
+
+		[[nodiscard]] const std::vector<rawrbox::DrawItem>& getItems() const;
+		[[nodiscard]] const std::vector<uint32_t>& getOrder() const;
+		[[nodiscard]] const rawrbox::RenderQueueStats& getStats() const; // Of the last submit
+		[[nodiscard]] size_t size() const;
+		[[nodiscard]] bool empty() const;
+	};
+} // namespace rawrbox
@@ -7,6 +7,7 @@ namespace rawrbox {
 	class ResourceFont : public rawrbox::Resource {
 
 	public:
+		// flags = rawrbox::FONT_TYPE
 		rawrbox::Font* getSize(uint16_t size, uint32_t flags = 0);
 	};
 
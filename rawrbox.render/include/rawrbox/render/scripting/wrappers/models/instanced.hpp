@@ -21,6 +21,13 @@ namespace rawrbox {
 			    .addFunction("addInstance", &ModelC::addInstance)
 			    .addFunction("removeInstance", &ModelC::removeInstance)
 			    .addFunction("getInstance", &ModelC::getInstance)
+			    .addFunction("hasInstance", &ModelC::hasInstance)
+			    .addFunction("updateInstance", &ModelC::updateInstance)
+			    .addFunction("markInstanceDirty", &ModelC::markInstanceDirty)
+
+			    .addFunction("setCulling", &ModelC::setCulling)
+			    .addFunction("isCulling", &ModelC::isCulling)
+			    .addFunction("visibleCount", &ModelC::visibleCount)
 
 			    .addFunction("count", &ModelC::count)
 			    .endClass();
@@ -1,10 +1,10 @@
 #pragma once
 
-#include <rawrbox/math/aabb.hpp>
 #include <rawrbox/math/color.hpp>
 #include <rawrbox/math/pi.hpp>
-#include <rawrbox/math/vector4.hpp>
+#include <rawrbox/render/stencil_list.hpp>
 #include <rawrbox/render/text/font.hpp>
+#include <rawrbox/render/text/layout.hpp>
 #include <rawrbox/render/textures/flat.hpp>
 #include <rawrbox/render/utils/streaming.hpp>
 
@@ -14,35 +14,12 @@
 #include <ShaderResourceBinding.h>
 #include <Texture.h>
 
+#include <functional>
+#include <initializer_list>
 #include <memory>
 #include <vector>
 
 namespace rawrbox {
-	struct PosUVColorVertexData {
-		// ----------
-		uint32_t textureID = 0x00000000;
-		rawrbox::Vector2f pos = {};
-		uint32_t color = 0x00000000;
-		rawrbox::Vector4f uv = {};
-		//  ----------
-
-		PosUVColorVertexData() = default;
-		PosUVColorVertexData(const uint32_t& _textureID, const rawrbox::Vector2f& _pos, const rawrbox::Vector4f& _uv, const rawrbox::Color& _cl) : textureID(_textureID), pos(_pos), color(_cl.pack()), uv(_uv) {}
-		PosUVColorVertexData(const uint32_t& _textureID, const rawrbox::Vector2f& _pos, const rawrbox::Vector4f& _uv, uint32_t _cl) : textureID(_textureID), pos(_pos), color(_cl), uv(_uv) {}
-
-		static std::vector<Diligent::LayoutElement> vLayout() {
-			return {
-			    // Attribute 0 - TextureID
-			    Diligent::LayoutElement{0, 0, 1, Diligent::VT_UINT32, false, Diligent::LAYOUT_ELEMENT_AUTO_OFFSET, Diligent::LAYOUT_ELEMENT_AUTO_STRIDE, Diligent::INPUT_ELEMENT_FREQUENCY_PER_VERTEX},
-			    // Attribute 1 - Position
-			    Diligent::LayoutElement{1, 0, 2, Diligent::VT_FLOAT32, true, Diligent::LAYOUT_ELEMENT_AUTO_OFFSET, Diligent::LAYOUT_ELEMENT_AUTO_STRIDE, Diligent::INPUT_ELEMENT_FREQUENCY_PER_VERTEX},
-			    // Attribute 2 - Color
-			    Diligent::LayoutElement{2, 0, 4, Diligent::VT_UINT8, true, Diligent::LAYOUT_ELEMENT_AUTO_OFFSET, Diligent::LAYOUT_ELEMENT_AUTO_STRIDE, Diligent::INPUT_ELEMENT_FREQUENCY_PER_VERTEX},
-			    // Attribute 3 - UV
-			    Diligent::LayoutElement{3, 0, 4, Diligent::VT_FLOAT32, false, Diligent::LAYOUT_ELEMENT_AUTO_OFFSET, Diligent::LAYOUT_ELEMENT_AUTO_STRIDE, Diligent::INPUT_ELEMENT_FREQUENCY_PER_VERTEX}};
-		}
-	};
-
 	struct PolygonVertice {
 		rawrbox::Vector2f pos = {};
 		rawrbox::Vector2f uv = {};
@@ -54,38 +31,6 @@ namespace rawrbox {
 		std::vector<uint32_t> indices = {};
 	};
 
-	struct Clip {
-		rawrbox::AABBu bbox = {};
-		bool worldSpace = false;
-
-		bool operator==(const Clip& other) const { return this->bbox == other.bbox && this->worldSpace == other.worldSpace; }
-		bool operator!=(const Clip& other) const { return !operator==(other); }
-	};
-
-	struct StencilDraw {
-		Diligent::IPipelineState* stencilProgram = nullptr;
-
-		std::vector<rawrbox::PosUVColorVertexData> vertices = {};
-		std::vector<uint32_t> indices = {};
-
-		rawrbox::Clip clip = {};
-		bool cull = true;
-		bool optimize = true;
-
-		void clear() {
-			this->cull = true;
-			this->clip = {};
-
-			this->optimize = true;
-			this->stencilProgram = nullptr;
-
-			this->indices.clear();
-			this->vertices.clear();
-		}
-
-		StencilDraw() = default;
-	};
-
 	struct StencilRotation {
 		float rotation = 0.F;
 		rawrbox::Vector2f origin = {};
@@ -158,8 +103,9 @@ namespace rawrbox {
 		Diligent::IPipelineState* _2dPipeline = nullptr;
 		Diligent::IPipelineState* _linePipeline = nullptr;
 		Diligent::IPipelineState* _textPipeline = nullptr;
+		Diligent::IPipelineState* _textSDFPipeline = nullptr;
 
-		static constexpr const int MaxVertsInStreamingBuffer = 65536;
+		static constexpr const uint32_t MaxVertsInStreamingBuffer = rawrbox::StencilDrawList::MAX_BATCH_VERTICES;
 		std::unique_ptr<rawrbox::StreamingBuffer> _streamingVB = nullptr;
 		std::unique_ptr<rawrbox::StreamingBuffer> _streamingIB = nullptr;
 		// ------------
@@ -198,8 +144,15 @@ namespace rawrbox {
 		// ---------------------------
 
 		// Drawing -----
-		rawrbox::StencilDraw _currentDraw = {};
-		std::vector<rawrbox::StencilDraw> _drawCalls = {};
+		rawrbox::StencilCommand _currentDraw = {}; // State of the primitive being pushed, its vertices go straight to the target's buffers
+		rawrbox::StencilDrawList _drawCalls = {};
+		rawrbox::StencilDrawList* _target = &_drawCalls;
+		// ----------
+
+		// Recording ----
+		rawrbox::Vector2f _recordOffset = {};
+		std::vector<rawrbox::Vector2f> _recordOffsets = {};
+		std::vector<rawrbox::Clip> _recordClips = {};
 		// ----------
 
 		// LOGGER ------
@@ -208,7 +161,7 @@ namespace rawrbox {
 
 		// ------ UTILS
 		void pushVertice(const uint32_t& textureID, rawrbox::Vector2f pos, const rawrbox::Vector4f& uv, const rawrbox::Color& col);
-		void pushIndices(std::vector<uint32_t> ind);
+		void pushIndices(std::initializer_list<uint32_t> ind);
 
 		void applyRotation(rawrbox::Vector2f& vert) const;
 		void applyScale(rawrbox::Vector2f& vert);
@@ -220,6 +173,9 @@ namespace rawrbox {
 		void setupDrawCall(Diligent::IPipelineState* program);
 		void pushDrawCall();
 
+		[[nodiscard]] rawrbox::Clip getCurrentClip() const;
+		[[nodiscard]] uint64_t getPipelineKey(Diligent::IPipelineState* program) const;
+
 		void internalDraw();
 		// --------------------
 
@@ -246,11 +202,25 @@ namespace rawrbox {
 		virtual void drawLine(const rawrbox::Vector2& from, const rawrbox::Vector2& to, const rawrbox::Color& col = rawrbox::Colors::White());
 		virtual void drawText(const std::string& text, const rawrbox::Vector2f& pos, const rawrbox::Color& col = rawrbox::Colors::White(), const rawrbox::Color& bgCol = rawrbox::Colors::Transparent(), rawrbox::Alignment alignX = rawrbox::Alignment::Left, rawrbox::Alignment alignY = rawrbox::Alignment::Left);
 		virtual void drawText(const rawrbox::Font& font, const std::string& text, const rawrbox::Vector2f& pos, const rawrbox::Color& col = rawrbox::Colors::White(), rawrbox::Alignment alignX = rawrbox::Alignment::Left, rawrbox::Alignment alignY = rawrbox::Alignment::Left);
+		virtual void drawText(const rawrbox::Font& font, const rawrbox::TextRun& run, const rawrbox::Vector2f& pos, const rawrbox::Color& col = rawrbox::Colors::White());
 		virtual void drawLoading(const rawrbox::Vector2f& pos, const rawrbox::Vector2f& size, const rawrbox::Color& color = rawrbox::Colors::White());
 
 		virtual void drawVertices(const std::vector<rawrbox::PosUVColorVertexData>& vertices, const std::vector<uint32_t>& indices);
 		//  --------------------
 
+		// ------ RECORDING
+		// Draws between these go to the list instead of the screen, starting with no offset or clip
+		virtual void beginRecording(rawrbox::StencilDrawList& list);
+		virtual void endRecording();
+		[[nodiscard]] virtual bool isRecording() const;
+
+		// Replays a recorded list at the current offset. Commands recorded without a clip use the current one
+		// Rotation and scale are baked in when recording
+		virtual void drawList(const rawrbox::StencilDrawList& list);
+		// Records the list with the builder first if it was invalidated
+		virtual void drawList(rawrbox::StencilDrawList& list, const std::function<void()>& builder);
+		// --------------------
+
 		// ------ RENDERING
 		virtual void render();
 		// --------------------
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <rawrbox/math/aabb.hpp>
+#include <rawrbox/math/color.hpp>
+#include <rawrbox/math/vector2.hpp>
+#include <rawrbox/math/vector4.hpp>
+
+#include <PipelineState.h>
+
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace rawrbox {
+	struct PosUVColorVertexData {
+		// ----------
+		uint32_t textureID = 0x00000000;
+		rawrbox::Vector2f pos = {};
+		uint32_t color = 0x00000000;
+		rawrbox::Vector4f uv = {};
+		//  ----------
+
+		PosUVColorVertexData() = default;
+		PosUVColorVertexData(const uint32_t& _textureID, const rawrbox::Vector2f& _pos, const rawrbox::Vector4f& _uv, const rawrbox::Color& _cl) : textureID(_textureID), pos(_pos), color(_cl.pack()), uv(_uv) {}
+		PosUVColorVertexData(const uint32_t& _textureID, const rawrbox::Vector2f& _pos, const rawrbox::Vector4f& _uv, uint32_t _cl) : textureID(_textureID), pos(_pos), color(_cl), uv(_uv) {}
+
+		static std::vector<Diligent::LayoutElement> vLayout() {
+			return {
+			    // Attribute 0 - TextureID
+			    Diligent::LayoutElement{0, 0, 1, Diligent::VT_UINT32, false, Diligent::LAYOUT_ELEMENT_AUTO_OFFSET, Diligent::LAYOUT_ELEMENT_AUTO_STRIDE, Diligent::INPUT_ELEMENT_FREQUENCY_PER_VERTEX},
+			    // Attribute 1 - Position
+			    Diligent::LayoutElement{1, 0, 2, Diligent::VT_FLOAT32, true, Diligent::LAYOUT_ELEMENT_AUTO_OFFSET, Diligent::LAYOUT_ELEMENT_AUTO_STRIDE, Diligent::INPUT_ELEMENT_FREQUENCY_PER_VERTEX},
+			    // Attribute 2 - Color
+			    Diligent::LayoutElement{2, 0, 4, Diligent::VT_UINT8, true, Diligent::LAYOUT_ELEMENT_AUTO_OFFSET, Diligent::LAYOUT_ELEMENT_AUTO_STRIDE, Diligent::INPUT_ELEMENT_FREQUENCY_PER_VERTEX},
+			    // Attribute 3 - UV
+			    Diligent::LayoutElement{3, 0, 4, Diligent::VT_FLOAT32, false, Diligent::LAYOUT_ELEMENT_AUTO_OFFSET, Diligent::LAYOUT_ELEMENT_AUTO_STRIDE, Diligent::INPUT_ELEMENT_FREQUENCY_PER_VERTEX}};
+		}
+	};
+
+	struct Clip {
+		rawrbox::AABBu bbox = {};
+		bool worldSpace = false;
+
+		bool operator==(const Clip& other) const { return this->bbox == other.bbox && this->worldSpace == other.worldSpace; }
+		bool operator!=(const Clip& other) const { return !operator==(other); }
+	};
+
+	struct StencilDraw {
+		Diligent::IPipelineState* stencilProgram = nullptr;
+
+		std::vector<rawrbox::PosUVColorVertexData> vertices = {};
+		std::vector<uint32_t> indices = {};
+
+		rawrbox::Clip clip = {};
+		bool cull = true;
+		bool optimize = true;
+
+		void clear() {
+			this->cull = true;
+			this->clip = {};
+
+			this->optimize = true;
+			this->stencilProgram = nullptr;
+
+			this->indices.clear();
+			this->vertices.clear();
+		}
+
+		StencilDraw() = default;
+	};
+
+	// A batch in a StencilDrawList. Its indices are relative to its first vertex
+	struct StencilCommand {
+		static constexpr uint64_t PIPELINE_SHIFT = 56;
+
+		uint64_t key = 0; // Pipeline, clip and flags packed, so merge candidates are rejected with one compare
+		Diligent::IPipelineState* stencilProgram = nullptr;
+
+		rawrbox::Clip clip = {};
+		bool inheritClip = false; // Recorded without a clip, replays use the current one
+		bool cull = true;
+		bool optimize = true;
+
+		uint32_t vertexOffset = 0;
+		uint32_t vertexCount = 0;
+		uint32_t indexOffset = 0;
+		uint32_t indexCount = 0;
+
+		// Pipeline (8) | world space (1) | inherit clip (1) | cull (1) | clip hash (53)
+		void updateKey(uint64_t pipeline);
+		[[nodiscard]] uint64_t getPipelineKey() const { return this->key >> PIPELINE_SHIFT; }
+
+		[[nodiscard]] bool canMerge(const StencilCommand& other) const {
+			return this->key == other.key && this->stencilProgram == other.stencilProgram && this->clip == other.clip && this->inheritClip == other.inheritClip && this->cull == other.cull;
+		}
+	};
+
+	// Stencil output recorded once and replayed every frame (see Stencil::beginRecording / drawList)
+	// The buffers keep their capacity on clear, so re-recording doesn't allocate once warmed up
+	//
+	// Doesn't need a renderer, the Stencil builds its frames with the same calls:
+	// list.begin(cmd);
+	// list.pushVertex(...);
+	// list.pushIndices({0, 1, 2});
+	// list.commit(cmd);
+	class StencilDrawList {
+	protected:
+		std::vector<rawrbox::PosUVColorVertexData> _vertices = {};
+		std::vector<uint32_t> _indices = {};
+		std::vector<rawrbox::StencilCommand> _commands = {};
+
+		bool _dirty = true;
+
+	public:
+		static constexpr uint32_t MAX_BATCH_VERTICES = 65536; // Size of the stencil's streaming buffer
+		friend class Stencil;
+
+		// Call when whatever was recorded changed, the next Stencil::drawList with a builder records it again
+		void invalidate() { this->_dirty = true; }
+		[[nodiscard]] bool isDirty() const { return this->_dirty; }
+
+		// BUILDING ---
+		// Points the command at the end of the buffers, its vertices and indices go after it
+		void begin(rawrbox::StencilCommand& cmd) const;
+
+		void pushVertex(const rawrbox::PosUVColorVertexData& vert);
+		void pushIndices(std::initializer_list<uint32_t> ind); // Relative to the command's first vertex
+		void pushIndices(const std::vector<uint32_t>& ind);
+
+		// Counts what was pushed since begin, then merges it into the last command when possible
+		void commit(rawrbox::StencilCommand& cmd);
+
+		// Replays another list into this one. Offset is added to its vertices and clips, commands recorded without a clip get the given one
+		void append(const rawrbox::StencilDrawList& list, const rawrbox::Vector2f& offset, const rawrbox::Clip& clip, bool inheritClip);
+		// ---
+
+		void clear();
+		[[nodiscard]] bool empty() const { return this->_commands.empty(); }
+
+		[[nodiscard]] const std::vector<rawrbox::PosUVColorVertexData>& getVertices() const { return this->_vertices; }
+		[[nodiscard]] const std::vector<uint32_t>& getIndices() const { return this->_indices; }
+		[[nodiscard]] const std::vector<rawrbox::StencilCommand>& getCommands() const { return this->_commands; }
+
+		[[nodiscard]] std::vector<rawrbox::StencilDraw> getDrawCalls() const;
+	};
+} // namespace rawrbox
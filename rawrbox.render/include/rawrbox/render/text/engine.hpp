@@ -19,6 +19,7 @@ namespace rawrbox {
 		// -------------
 
 		static std::string getFontInSystem(const std::filesystem::path& path);
+		static rawrbox::Font* loadFile(const std::filesystem::path& filename, const std::string& key, uint16_t size, uint32_t index, rawrbox::FONT_TYPE type);
 
 	public:
 		static uint16_t packID;
@@ -28,6 +29,7 @@ namespace rawrbox {
 		static std::pair<uint16_t, rawrbox::TexturePack*> requestPack(uint16_t width, uint16_t height, Diligent::TEXTURE_FORMAT format = Diligent::TEXTURE_FORMAT::TEX_FORMAT_RGBA8_UNORM);
 		static rawrbox::TexturePack* getPack(uint16_t id);
 
-		static rawrbox::Font* load(const std::filesystem::path& filename, uint16_t size, uint32_t index = 0);
+		// SDF fonts bake their glyphs once (at Font::SDF_SIZE), every requested size shares them
+		static rawrbox::Font* load(const std::filesystem::path& filename, uint16_t size, uint32_t index = 0, rawrbox::FONT_TYPE type = rawrbox::FONT_TYPE::ALPHA);
 	};
 } // namespace rawrbox
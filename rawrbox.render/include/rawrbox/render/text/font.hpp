@@ -4,9 +4,12 @@
 #include <rawrbox/math/vector3.hpp>
 #include <rawrbox/render/textures/pack.hpp>
 
+#include <array>
+#include <atomic>
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <shared_mutex>
 #include <unordered_map>
 
 struct stbtt_fontinfo;
@@ -18,6 +21,11 @@ namespace rawrbox {
 		Right
 	};
 
+	enum class FONT_TYPE : uint32_t {
+		ALPHA = 0, // Coverage bitmap, baked per pixel size
+		SDF = 1    // Signed distance field, one baked glyph set is shared by every size
+	};
+
 	struct FontInfo {
 		/// The font height in pixel.
 		uint16_t pixelSize;
@@ -75,6 +83,7 @@ namespace rawrbox {
 	struct Glyph {
 		uint16_t packID = 0;
 		uint32_t codePoint = 0;
+		int32_t index = 0; // Glyph index in the font file
 
 		float scale = 0.F;
 
@@ -87,11 +96,36 @@ namespace rawrbox {
 	};
 
 	class TextEngine;
+	struct TextRun;
 
 	class Font {
 	private:
+		struct GlyphBitmap {
+			std::unique_ptr<rawrbox::Glyph> glyph = nullptr;
+			std::vector<uint8_t> pixels = {};
+
+			uint16_t width = 0;
+			uint16_t height = 0;
+		};
+
 		std::shared_ptr<stbtt_fontinfo> _font = nullptr; // unique_ptr does not like incomplete types
-		std::unordered_map<uint32_t, std::unique_ptr<rawrbox::Glyph>> _glyphs = {};
+		std::vector<uint8_t> _buffer = {};                // stbtt keeps pointers to the font data, so it needs to outlive it
+
+		// Mutable, SDF fonts fill it lazily by scaling the glyphs of their source (from any thread, so it's locked)
+		// Glyphs are never replaced once stored, the pointers handed out stay valid until the font dies
+		mutable std::unordered_map<uint32_t, std::unique_ptr<rawrbox::Glyph>> _glyphs = {};
+		mutable std::array<std::atomic<rawrbox::Glyph*>, 0x250> _fastGlyphs = {}; // Latin range, indexed by codepoint, read without locking
+		mutable std::shared_mutex _glyphLock;                                     // Guards _glyphs and _kerning
+		uint32_t _version = 0;                                                    // Bumped every time glyphs are added
+
+		// Kerning in font units, key is (prev << 16 | next) for codepoints on the fast range
+		std::unordered_map<uint32_t, int32_t> _kerning = {};
+		bool _hasKerning = false;
+
+		uint64_t _id = 0; // Unique, never reused (unlike the address)
+
+		rawrbox::FONT_TYPE _type = rawrbox::FONT_TYPE::ALPHA;
+		rawrbox::Font* _source = nullptr; // SDF font holding the baked glyphs, owned by the TextEngine
 
 		std::filesystem::path _fileName = {};
 
@@ -112,11 +146,22 @@ namespace rawrbox {
 		// INTERNAL ---
 		virtual void loadFontInfo();
 
-		std::unique_ptr<rawrbox::Glyph> bakeGlyphAlpha(uint32_t codePoint);
+		[[nodiscard]] GlyphBitmap rasterizeGlyph(uint32_t codePoint) const; // Thread safe
+		void packGlyph(GlyphBitmap& bitmap);
+		[[nodiscard]] rawrbox::Glyph* scaleGlyph(uint32_t codePoint) const;
+		rawrbox::Glyph* storeGlyph(std::unique_ptr<rawrbox::Glyph> glyph) const;
+		void updateKerning(const std::vector<uint32_t>& added);
+
 		virtual void generateGlyph(uint32_t codePoint);
+		virtual void generateGlyphs(const std::vector<uint32_t>& codePoints);
 		// ----
 
 	public:
+		// SDF glyphs are baked once at this size, then scaled
+		static constexpr uint16_t SDF_SIZE = 48;
+		static constexpr int SDF_PADDING = 6;
+		static constexpr uint8_t SDF_ON_EDGE = 128;
+
 		virtual ~Font();
 
 		Font(const std::filesystem::path& fileName, int16_t widthPadding = 6, int16_t heightPadding = 6);
@@ -126,13 +171,17 @@ namespace rawrbox {
 		Font& operator=(const Font&) = delete;
 
 		// LOADING ---
-		virtual void load(const std::vector<uint8_t>& buffer, uint16_t pixelHeight, uint32_t fontIndex = 0);
+		virtual void load(const std::vector<uint8_t>& buffer, uint16_t pixelHeight, uint32_t fontIndex = 0, rawrbox::FONT_TYPE type = rawrbox::FONT_TYPE::ALPHA);
+		virtual void load(rawrbox::Font& source, uint16_t pixelHeight); // Share the glyphs of an SDF font at another size
 		virtual void addChars(const std::string& chars);
 		virtual rawrbox::Font* scale(uint16_t size);
 		// ----
 
 		// UTILS ---
 		[[nodiscard]] virtual const rawrbox::FontInfo& getFontInfo() const;
+		[[nodiscard]] virtual rawrbox::FONT_TYPE getType() const;
+		[[nodiscard]] virtual uint32_t getGlyphVersion() const;
+		[[nodiscard]] virtual uint64_t getID() const;
 
 		[[nodiscard]] virtual bool hasGlyph(uint32_t codepoint) const;
 		[[nodiscard]] virtual rawrbox::Glyph* getGlyph(uint32_t codepoint) const;
@@ -148,6 +197,7 @@ namespace rawrbox {
 		[[nodiscard]] virtual rawrbox::TexturePack* getPackTexture(rawrbox::Glyph* g) const;
 
 		virtual void render(const std::string& text, const rawrbox::Vector2f& pos, bool yIsUp, const std::function<void(rawrbox::Glyph*, float, float, float, float)>& render) const;
+		virtual void render(const rawrbox::TextRun& run, const rawrbox::Vector2f& pos, bool yIsUp, const std::function<void(rawrbox::Glyph*, float, float, float, float)>& render) const;
 		// ----
 
 		// GLOBAL UTILS ---
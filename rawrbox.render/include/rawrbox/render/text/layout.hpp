@@ -0,0 +1,60 @@
+#pragma once
+
+#include <rawrbox/render/text/font.hpp>
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rawrbox {
+	struct TextGlyph {
+		rawrbox::Glyph* glyph = nullptr;
+
+		float x = 0.F;     // Quad left, relative to the run origin
+		uint32_t line = 0; // Quad top is line * lineHeight + glyph->offset.y, from the first baseline
+	};
+
+	struct TextRun {
+		std::vector<rawrbox::TextGlyph> glyphs = {};
+
+		rawrbox::Vector2f size = {};
+		uint32_t lines = 1;
+	};
+
+	// Lays out strings into glyph runs, and keeps an LRU of the results
+	// The LRU is per thread, so workers can lay out text without locking (or invalidating the main thread runs)
+	class TextLayout {
+	protected:
+		struct Entry {
+			uint64_t hash = 0;
+
+			uint64_t font = 0; // Font::getID, the address can be reused
+			std::string text;
+			float wrapWidth = 0.F;
+			rawrbox::Alignment align = rawrbox::Alignment::Left;
+
+			uint32_t version = 0;
+			std::shared_ptr<const rawrbox::TextRun> run = nullptr;
+		};
+
+		static thread_local std::list<Entry> _entries; // Most recently used first
+		static thread_local std::unordered_map<uint64_t, std::list<Entry>::iterator> _lookup;
+
+		static uint64_t getHash(const rawrbox::Font& font, const std::string& text, float wrapWidth, rawrbox::Alignment align);
+
+	public:
+		static size_t CACHE_SIZE; // Per thread
+
+		// Shared with the cache, stays valid after it gets evicted / rebuilt (holders just keep the old run)
+		[[nodiscard]] static std::shared_ptr<const rawrbox::TextRun> get(const rawrbox::Font& font, const std::string& text, float wrapWidth = 0.F, rawrbox::Alignment align = rawrbox::Alignment::Left);
+		[[nodiscard]] static rawrbox::TextRun build(const rawrbox::Font& font, const std::string& text, float wrapWidth = 0.F, rawrbox::Alignment align = rawrbox::Alignment::Left);
+
+		// Drops the runs of a font on this thread (called by ~Font). Other threads never hit them again, since ids aren't reused, and they age out
+		static void evict(uint64_t fontID);
+
+		static void clear();
+		[[nodiscard]] static size_t size();
+	};
+} // namespace rawrbox
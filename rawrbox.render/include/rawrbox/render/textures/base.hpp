@@ -2,6 +2,7 @@
 
 #include <rawrbox/math/color.hpp>
 #include <rawrbox/math/vector2.hpp>
+#include <rawrbox/render/textures/utils/processor.hpp>
 #include <rawrbox/render/utils/pipeline.hpp>
 
 #include <RefCntAutoPtr.hpp>
@@ -81,6 +82,12 @@ namespace rawrbox {
 		bool _sRGB = false;
 		bool _registered = false;
 
+		// PROCESSING ---
+		bool _mips = false;
+		rawrbox::MIP_FILTER _mipFilter = rawrbox::MIP_FILTER::BOX;
+		rawrbox::TEXTURE_COMPRESSION _compression = rawrbox::TEXTURE_COMPRESSION::NONE;
+		// -------------
+
 		// LOGGER ------
 		std::unique_ptr<rawrbox::Logger> _logger = std::make_unique<rawrbox::Logger>("RawrBox-Texture");
 		// -------------
@@ -90,6 +97,7 @@ namespace rawrbox {
 		virtual void updateSampler();
 
 		virtual void tryGetFormatChannels(Diligent::TEXTURE_FORMAT& format, uint8_t& channels);
+		virtual Diligent::TEXTURE_FORMAT getCompressedFormat(rawrbox::TEXTURE_COMPRESSION compression);
 
 	public:
 		TextureBase() = default;
@@ -133,6 +141,13 @@ namespace rawrbox {
 
 		virtual void setSRGB(bool set);
 
+		// Only applied to static textures, must be set before upload
+		virtual void setMipMaps(bool set, rawrbox::MIP_FILTER filter = rawrbox::MIP_FILTER::BOX);
+		[[nodiscard]] virtual bool hasMipMaps() const;
+
+		virtual void setCompression(rawrbox::TEXTURE_COMPRESSION compression);
+		[[nodiscard]] virtual rawrbox::TEXTURE_COMPRESSION getCompression() const;
+
 		virtual void setSlice(uint32_t id);
 		[[nodiscard]] virtual uint32_t getSlice() const;
 		// -----
@@ -1,47 +1,54 @@
 #pragma once
 
+#include <rawrbox/math/aabb.hpp>
+#include <rawrbox/math/utils/rect_packer.hpp>
 #include <rawrbox/render/textures/base.hpp>
 
-#include <optional>
+#include <vector>
 
 namespace rawrbox {
 	struct PackNode {
+		uint32_t id = 0;
+
 		uint32_t x = 0;
 		uint32_t y = 0;
 		uint32_t width = 0;
 		uint32_t height = 0;
-
-		std::vector<uint8_t> data = {};
-
-		std::unique_ptr<PackNode> left = nullptr;
-		std::unique_ptr<PackNode> right = nullptr;
-
-		bool canInsertNode(uint32_t insertedWidth, uint32_t insertedHeight);
-		std::optional<std::reference_wrapper<rawrbox::PackNode>> InsertNode(uint32_t width, uint32_t height);
-
-		PackNode() = default;
-		PackNode(uint32_t _x, uint32_t _y, uint32_t _w, uint32_t _h) : x(_x), y(_y), width(_w), height(_h){};
 	};
 
 	class TexturePack : public rawrbox::TextureBase {
 	private:
-		size_t _spriteCount = 0;
-		std::unique_ptr<rawrbox::PackNode> _root = nullptr;
+		rawrbox::RectPacker _packer;
+
+		// Regions of the atlas modified since the last update
+		std::vector<rawrbox::AABBu> _dirty = {};
 		bool _pendingUpdate = false;
 
+		void writeSprite(const rawrbox::AABBu& rect, const std::vector<uint8_t>& data);
+		void markDirty(const rawrbox::AABBu& rect);
+
 	public:
+		// Past this, dirty regions are collapsed into a single upload
+		static constexpr size_t MAX_DIRTY_RECTS = 16;
+
 		explicit TexturePack(uint32_t size = 1024U);
 
 		TexturePack(const TexturePack&) = delete;
 		TexturePack(TexturePack&&) = delete;
 		TexturePack& operator=(const TexturePack&) = delete;
 		TexturePack& operator=(TexturePack&&) = delete;
-		~TexturePack() override;
+		~TexturePack() override = default;
 
 		[[nodiscard]] size_t getSpriteCount() const;
+		[[nodiscard]] float getOccupancy() const;
+
+		[[nodiscard]] bool canInsertNode(uint32_t width, uint32_t height) const;
+		rawrbox::PackNode addSprite(uint32_t width, uint32_t height, const std::vector<uint8_t>& data);
+		void updateSprite(uint32_t id, const std::vector<uint8_t>& data);
+		bool removeSprite(uint32_t id);
 
-		bool canInsertNode(uint32_t width, uint32_t height);
-		rawrbox::PackNode& addSprite(uint32_t width, uint32_t height, const std::vector<uint8_t>& data);
+		[[nodiscard]] rawrbox::PackNode getSprite(uint32_t id) const;
+		[[nodiscard]] bool hasSprite(uint32_t id) const;
 
 		void upload(Diligent::TEXTURE_FORMAT format = Diligent::TEXTURE_FORMAT::TEX_FORMAT_UNKNOWN, bool dynamic = false) override;
 
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <rawrbox/math/vector2.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace rawrbox {
+	enum class TEXTURE_COMPRESSION {
+		NONE,
+		BC1, // RGB, no alpha
+		BC3, // RGBA
+		BC5, // RG (normal maps)
+		BC7  // RGBA, high quality
+	};
+
+	class BCEncoder {
+	protected:
+		static void encodeBC1Block(const uint8_t* rgba, uint8_t* out);
+		static void encodeBC4Block(const uint8_t* rgba, uint8_t channel, uint8_t* out);
+		static void encodeBC7Block(const uint8_t* rgba, uint8_t* out);
+
+	public:
+		[[nodiscard]] static uint32_t getBlockSize(rawrbox::TEXTURE_COMPRESSION compression);
+		[[nodiscard]] static uint32_t getRowPitch(rawrbox::TEXTURE_COMPRESSION compression, uint32_t width);
+		[[nodiscard]] static size_t getEncodedSize(rawrbox::TEXTURE_COMPRESSION compression, const rawrbox::Vector2u& size);
+
+		// Encodes the given pixels into 4x4 blocks, edge blocks are padded by clamping
+		[[nodiscard]] static std::vector<uint8_t> encode(rawrbox::TEXTURE_COMPRESSION compression, const uint8_t* pixels, const rawrbox::Vector2u& size, uint8_t channels);
+	};
+} // namespace rawrbox
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <rawrbox/math/vector2.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace rawrbox {
+	enum class MIP_FILTER {
+		BOX,
+		KAISER
+	};
+
+	struct MipLevel {
+		rawrbox::Vector2u size = {};
+		std::vector<uint8_t> pixels = {};
+	};
+
+	class MipMapUtils {
+	protected:
+		static void downsampleBox(const std::vector<float>& src, const rawrbox::Vector2u& srcSize, std::vector<float>& dst, const rawrbox::Vector2u& dstSize, uint8_t channels);
+		static void downsampleKaiser(const std::vector<float>& src, const rawrbox::Vector2u& srcSize, std::vector<float>& dst, const rawrbox::Vector2u& dstSize, uint8_t channels);
+
+		static void toLinear(const uint8_t* pixels, std::vector<float>& out, const rawrbox::Vector2u& size, uint8_t channels, bool sRGB);
+		static void fromLinear(const std::vector<float>& pixels, std::vector<uint8_t>& out, const rawrbox::Vector2u& size, uint8_t channels, bool sRGB);
+
+	public:
+		[[nodiscard]] static uint32_t getMipCount(const rawrbox::Vector2u& size);
+
+		// Builds the full mip chain (excluding level 0) of the given pixels
+		// If sRGB is set, the color channels are filtered in linear space
+		[[nodiscard]] static std::vector<rawrbox::MipLevel> generate(const uint8_t* pixels, const rawrbox::Vector2u& size, uint8_t channels, bool sRGB, rawrbox::MIP_FILTER filter = rawrbox::MIP_FILTER::BOX);
+	};
+} // namespace rawrbox
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <rawrbox/render/textures/utils/bc.hpp>
+#include <rawrbox/render/textures/utils/mipmap.hpp>
+#include <rawrbox/utils/logger.hpp>
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace rawrbox {
+	struct ImageData;
+
+	struct TextureProcessSettings {
+		bool mips = false;
+		rawrbox::MIP_FILTER filter = rawrbox::MIP_FILTER::BOX;
+		rawrbox::TEXTURE_COMPRESSION compression = rawrbox::TEXTURE_COMPRESSION::NONE;
+		bool sRGB = false;
+	};
+
+	struct ProcessedTexture {
+		rawrbox::TEXTURE_COMPRESSION compression = rawrbox::TEXTURE_COMPRESSION::NONE;
+		uint32_t mipCount = 1;
+
+		// [slice][mip], mip 0 included
+		std::vector<std::vector<rawrbox::MipLevel>> slices = {};
+
+		[[nodiscard]] bool empty() const { return this->slices.empty(); }
+	};
+
+	class TextureProcessor {
+	protected:
+		static std::unique_ptr<rawrbox::Logger> _logger;
+
+		static uint32_t getCRC(const rawrbox::ImageData& data);
+		static std::filesystem::path getCachePath(uint32_t crc, const rawrbox::TextureProcessSettings& settings);
+
+		static bool loadCache(const std::filesystem::path& path, uint32_t crc, const rawrbox::ImageData& data, rawrbox::ProcessedTexture& out);
+		static void saveCache(const std::filesystem::path& path, uint32_t crc, const rawrbox::ProcessedTexture& processed);
+
+	public:
+		// Compressed results are cached on disk by image crc, set to empty to disable caching
+		static std::filesystem::path CACHE_PATH;
+
+		[[nodiscard]] static bool canCompress(rawrbox::TEXTURE_COMPRESSION compression, const rawrbox::ImageData& data);
+		[[nodiscard]] static rawrbox::ProcessedTexture process(const rawrbox::ImageData& data, const rawrbox::TextureProcessSettings& settings);
+	};
+} // namespace rawrbox
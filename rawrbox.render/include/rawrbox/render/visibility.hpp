@@ -0,0 +1,94 @@
+#pragma once
+
+#include <rawrbox/math/bbox.hpp>
+#include <rawrbox/math/bvh.hpp>
+#include <rawrbox/math/matrix4x4.hpp>
+#include <rawrbox/math/occlusion_buffer.hpp>
+#include <rawrbox/render/cameras/base.hpp>
+#include <rawrbox/utils/logger.hpp>
+#include <rawrbox/utils/slot_map.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace rawrbox {
+	struct VisibilityObject {
+		rawrbox::BBOX bbox = {}; // World space
+		uint32_t layers = 0;     // CameraLayers it renders on, 0 = all of them
+		bool occluder = false;   // Big and solid (walls, terrain), hides what's behind it when occlusion is enabled
+		void* userData = nullptr;
+	};
+
+	// CPU culling for the world pass. Keeps a BVH of the objects bounds and returns what each camera can see
+	//
+	// auto& visible = scene.cull(camera);
+	// for (auto handle : visible) draw(scene.get(handle).userData);
+	class Visibility {
+	protected:
+		rawrbox::SlotMap<rawrbox::VisibilityObject> _objects = {};
+		rawrbox::BVH _bvh = {};
+
+		std::vector<rawrbox::BBOX> _bounds = {}; // Dense order, what the BVH was built with
+		bool _rebuild = true;                    // Objects added / removed
+		bool _refit = false;                     // Objects moved
+
+		// OCCLUSION ---
+		bool _occlusion = false;
+		size_t _maxOccluders = 32;
+		rawrbox::OcclusionBuffer _occlusionBuffer = {256, 128};
+		// ---
+
+		// Visible handles, per camera and layers
+		struct VisibleList {
+			std::vector<uint32_t> handles = {};
+			uint64_t lastCull = 0; // _cullCount when it was last filled
+		};
+
+		std::unordered_map<const rawrbox::CameraBase*, std::unordered_map<uint32_t, VisibleList>> _visible = {};
+		uint64_t _cullCount = 0;
+
+		void updateTree();
+		void pruneVisible();
+		void occlusionPass(const rawrbox::Vector3f& eye, const rawrbox::Matrix4x4& viewProj, std::vector<uint32_t>& dense);
+
+	public:
+		static size_t MAX_IDLE_CULLS; // Lists not culled again after this many culls (of any camera) are dropped
+
+		Visibility() = default;
+		Visibility(const Visibility&) = delete;
+		Visibility(Visibility&&) = delete;
+		Visibility& operator=(const Visibility&) = delete;
+		Visibility& operator=(Visibility&&) = delete;
+		virtual ~Visibility() = default;
+
+		// Local bounds (like Mesh::getBBOX) moved to world space, still axis aligned
+		[[nodiscard]] static rawrbox::BBOX toWorld(const rawrbox::BBOX& bbox, const rawrbox::Matrix4x4& matrix);
+
+		// OBJECTS ---
+		uint32_t add(const rawrbox::VisibilityObject& object);
+		void update(uint32_t handle, const rawrbox::BBOX& bbox);
+		void remove(uint32_t handle);
+		void clear();
+
+		[[nodiscard]] bool valid(uint32_t handle) const;
+		[[nodiscard]] const rawrbox::VisibilityObject& get(uint32_t handle) const;
+		[[nodiscard]] size_t size() const;
+		// ---
+
+		// OCCLUSION ---
+		// Rasterizes the closest occluders on a small CPU depth buffer, and drops what's fully behind them
+		virtual void setOcclusion(bool enabled, size_t maxOccluders = 32);
+		[[nodiscard]] virtual bool isOcclusionEnabled() const;
+		virtual void setOcclusionSize(uint32_t width, uint32_t height);
+		// ---
+
+		// Handles of the objects the camera sees, on the given layers (camera.getLayers() if 0, all objects if that's 0 too)
+		// The list stays valid until the next cull with the same camera and layers, or until it's idle for MAX_IDLE_CULLS
+		const std::vector<uint32_t>& cull(const rawrbox::CameraBase& camera, uint32_t layers = 0);
+		const std::vector<uint32_t>& cull(const rawrbox::CameraBase& camera, const rawrbox::Matrix4x4& viewProj, uint32_t layers);
+		[[nodiscard]] const std::vector<uint32_t>& getVisible(const rawrbox::CameraBase& camera, uint32_t layers = 0) const;
+
+		// Drops the lists of a camera, call it before destroying one (a new camera can get the same address)
+		void forget(const rawrbox::CameraBase& camera);
+	};
+} // namespace rawrbox
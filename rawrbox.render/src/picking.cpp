@@ -0,0 +1,202 @@
+#include <rawrbox/render/picking.hpp>
+#include <rawrbox/render/visibility.hpp>
+#include <rawrbox/utils/profiler.hpp>
+
+#include <algorithm>
+
+namespace rawrbox {
+	// PRIVATE ----
+	rawrbox::BBOX Picking::getWorldBBOX(const rawrbox::PickInstance& instance) const {
+		return rawrbox::Visibility::toWorld(this->_meshes.get(instance.mesh).getBBOX(), instance.matrix);
+	}
+
+	void Picking::updateTree() {
+		const auto& instances = this->_instances.data();
+
+		// Only the top level, the mesh trees are never rebuilt for instance changes
+		if (this->_rebuild) {
+			this->_bounds.resize(instances.size());
+			for (size_t i = 0; i < instances.size(); i++) {
+				this->_bounds[i] = this->getWorldBBOX(instances[i]);
+			}
+
+			this->_bvh.build(this->_bounds);
+		} else if (!this->_dirty.empty()) {
+			for (auto index : this->_dirty) {
+				this->_bounds[index] = this->getWorldBBOX(instances[index]);
+			}
+
+			this->_bvh.refit(this->_bounds); // Same tree, only grows / shrinks the nodes
+		}
+
+		this->_rebuild = false;
+		this->_dirty.clear();
+	}
+
+	void Picking::markDirty(uint32_t index) {
+		if (this->_rebuild) return; // Redone anyway
+
+		// Moved more times than there are instances before a query, redo them all
+		if (this->_dirty.size() >= this->_instances.size()) {
+			this->_rebuild = true;
+			this->_dirty.clear();
+			return;
+		}
+
+		this->_dirty.push_back(index);
+	}
+	// ------------
+
+	// MESHES ---
+	uint32_t Picking::addMesh(std::vector<rawrbox::Vector3f> positions, std::vector<uint32_t> indices) {
+		RAWRBOX_PROFILE_ZONE("Picking::addMesh");
+
+		const uint32_t handle = this->_meshes.insert({});
+		this->_meshes.get(handle).build(std::move(positions), std::move(indices));
+
+		return handle;
+	}
+
+	void Picking::updateMesh(uint32_t mesh, const std::vector<rawrbox::Vector3f>& positions) {
+		if (!this->_meshes.valid(mesh)) RAWRBOX_CRITICAL("Invalid picking mesh '{}'", mesh);
+
+		this->_meshes.get(mesh).refit(positions);
+
+		// Only the instances using it changed bounds
+		const auto& instances = this->_instances.data();
+		for (size_t i = 0; i < instances.size(); i++) {
+			if (instances[i].mesh == mesh) this->markDirty(static_cast<uint32_t>(i));
+		}
+	}
+
+	void Picking::removeMesh(uint32_t mesh) {
+		if (!this->_meshes.valid(mesh)) return;
+
+		for (size_t i = this->_instances.size(); i-- > 0;) {
+			if (this->_instances.data()[i].mesh != mesh) continue;
+			this->_instances.remove(this->_instances.handleAt(i));
+		}
+
+		this->_meshes.remove(mesh);
+		this->_rebuild = true;
+	}
+
+	const rawrbox::TriangleBVH& Picking::getMesh(uint32_t mesh) const {
+		if (!this->_meshes.valid(mesh)) RAWRBOX_CRITICAL("Invalid picking mesh '{}'", mesh);
+		return this->_meshes.get(mesh);
+	}
+	// ---
+
+	// INSTANCES ---
+	uint32_t Picking::addInstance(uint32_t mesh, const rawrbox::Matrix4x4& matrix, uint32_t id) {
+		if (!this->_meshes.valid(mesh)) RAWRBOX_CRITICAL("Invalid picking mesh '{}'", mesh);
+
+		this->_rebuild = true;
+		return this->_instances.insert({mesh, id, matrix, rawrbox::Matrix4x4::mtxInverse(matrix)});
+	}
+
+	void Picking::setMatrix(uint32_t instance, const rawrbox::Matrix4x4& matrix) {
+		if (!this->_instances.valid(instance)) RAWRBOX_CRITICAL("Invalid picking instance '{}'", instance);
+
+		auto& data = this->_instances.get(instance);
+		if (data.matrix == matrix) return;
+
+		data.matrix = matrix;
+		data.inverse = rawrbox::Matrix4x4::mtxInverse(matrix);
+		this->markDirty(this->_instances.indexOf(instance));
+	}
+
+	void Picking::removeInstance(uint32_t instance) {
+		if (!this->_instances.valid(instance)) return;
+
+		this->_instances.remove(instance);
+		this->_rebuild = true;
+	}
+
+	const rawrbox::PickInstance& Picking::getInstance(uint32_t instance) const {
+		if (!this->_instances.valid(instance)) RAWRBOX_CRITICAL("Invalid picking instance '{}'", instance);
+		return this->_instances.get(instance);
+	}
+
+	size_t Picking::size() const { return this->_instances.size(); }
+	// ---
+
+	void Picking::clear() {
+		this->_meshes.clear();
+		this->_instances.clear();
+		this->_bvh.clear();
+		this->_bounds.clear();
+		this->_dirty.clear();
+
+		this->_rebuild = false;
+	}
+
+	std::optional<rawrbox::PickHit> Picking::raycast(const rawrbox::Ray& ray, float maxDistance) {
+		RAWRBOX_PROFILE_ZONE("Picking::raycast");
+		this->updateTree();
+
+		std::vector<std::pair<float, uint32_t>> candidates = {};
+		this->_bvh.query(ray, maxDistance, candidates);
+		std::ranges::sort(candidates);
+
+		std::optional<rawrbox::PickHit> result = std::nullopt;
+		float best = maxDistance;
+
+		for (const auto& [entry, index] : candidates) {
+			if (entry > best) break; // Sorted, nothing after this can be closer
+
+			const auto& instance = this->_instances.data()[index];
+			const auto& mesh = this->_meshes.get(instance.mesh);
+
+			// Mesh space, distances there don't match the world ones if the instance is scaled
+			const rawrbox::Ray local = ray.transform(instance.inverse);
+			const float localMax = best == std::numeric_limits<float>::max() ? best : local.getOrigin().distance(instance.inverse.mulVec(ray.at(best)));
+
+			rawrbox::RayHit hit = {};
+			if (!mesh.raycast(local, localMax, hit)) continue;
+
+			const rawrbox::Vector3f position = instance.matrix.mulVec(local.at(hit.distance));
+			const float distance = ray.getOrigin().distance(position);
+			if (distance > best) continue;
+
+			best = distance;
+			result = rawrbox::PickHit{this->_instances.handleAt(index), instance.id, hit.triangle, hit.u, hit.v, distance, position};
+		}
+
+		return result;
+	}
+
+	std::optional<rawrbox::PickHit> Picking::pick(const rawrbox::CameraBase& camera, const rawrbox::Vector2i& pos) {
+		if (camera.getRenderTarget() == nullptr) RAWRBOX_CRITICAL("Camera render target not initialized");
+
+		const auto size = camera.getRenderTarget()->getSize().cast<float>();
+		auto ray = rawrbox::Ray::fromScreen(pos.cast<float>() + 0.5F, size, rawrbox::Matrix4x4::mtxInverse(camera.getViewProjMtx()));
+
+		// Start from the camera, not the depth the ray was unprojected at (on perspective cameras, that's the eye)
+		const rawrbox::Vector3f toCamera = camera.getPos() - ray.getOrigin();
+		ray = {ray.at(toCamera.dot(ray.getDirection())), ray.getDirection()};
+
+		return this->raycast(ray);
+	}
+
+	void Picking::query(const rawrbox::BBOX& bbox, std::vector<std::pair<uint32_t, uint32_t>>& out) {
+		RAWRBOX_PROFILE_ZONE("Picking::query");
+		this->updateTree();
+
+		std::vector<uint32_t> candidates = {};
+		this->_bvh.query(bbox, candidates);
+
+		std::vector<uint32_t> triangles = {};
+		for (auto index : candidates) {
+			const auto& instance = this->_instances.data()[index];
+
+			triangles.clear();
+			this->_meshes.get(instance.mesh).query(rawrbox::Visibility::toWorld(bbox, instance.inverse), triangles);
+
+			const uint32_t handle = this->_instances.handleAt(index);
+			for (auto triangle : triangles) {
+				out.emplace_back(handle, triangle);
+			}
+		}
+	}
+} // namespace rawrbox
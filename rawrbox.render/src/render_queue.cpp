@@ -0,0 +1,195 @@
+#include <rawrbox/render/cameras/base.hpp>
+#include <rawrbox/render/materials/base.hpp>
+#include <rawrbox/render/render_queue.hpp>
+#include <rawrbox/render/renderer.hpp>
+#include <rawrbox/render/static.hpp>
+#include <rawrbox/utils/profiler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace rawrbox {
+	// KEY ---
+	uint64_t RenderKey::opaque(uint8_t layer, uint16_t pipeline, uint16_t textures, uint32_t depth) {
+		return (static_cast<uint64_t>(layer) << LAYER_SHIFT) |
+		       (static_cast<uint64_t>(pipeline) << 39U) |
+		       (static_cast<uint64_t>(textures) << DEPTH_BITS) |
+		       (std::min(depth, DEPTH_MAX));
+	}
+
+	uint64_t RenderKey::translucent(uint8_t layer, uint16_t pipeline, uint16_t textures, uint32_t depth) {
+		return (static_cast<uint64_t>(layer) << LAYER_SHIFT) |
+		       (1ULL << TRANSLUCENT_SHIFT) |
+		       (static_cast<uint64_t>(DEPTH_MAX - std::min(depth, DEPTH_MAX)) << 32U) | // Farthest first, so blending works
+		       (static_cast<uint64_t>(pipeline) << 16U) |
+		       (static_cast<uint64_t>(textures));
+	}
+
+	uint8_t RenderKey::getLayer(uint64_t key) { return static_cast<uint8_t>(key >> LAYER_SHIFT); }
+	bool RenderKey::isTranslucent(uint64_t key) { return ((key >> TRANSLUCENT_SHIFT) & 1U) != 0; }
+
+	uint16_t RenderKey::getPipeline(uint64_t key) {
+		return static_cast<uint16_t>(isTranslucent(key) ? (key >> 16U) : (key >> 39U));
+	}
+
+	uint16_t RenderKey::getTextures(uint64_t key) {
+		return static_cast<uint16_t>(isTranslucent(key) ? key : (key >> DEPTH_BITS));
+	}
+
+	uint32_t RenderKey::getDepth(uint64_t key) {
+		if (isTranslucent(key)) return DEPTH_MAX - static_cast<uint32_t>((key >> 32U) & DEPTH_MAX);
+		return static_cast<uint32_t>(key & DEPTH_MAX);
+	}
+
+	uint32_t RenderKey::quantizeDepth(float depth, float zNear, float zFar) {
+		if (zFar <= zNear) return 0;
+
+		const float normalized = std::clamp((depth - zNear) / (zFar - zNear), 0.F, 1.F);
+		return static_cast<uint32_t>(normalized * static_cast<float>(DEPTH_MAX));
+	}
+	// ---
+
+	// RECORDER ---
+	void RenderContextRecorder::setPipeline(Diligent::IPipelineState* pipeline) {
+		rawrbox::RENDERER->context()->SetPipelineState(pipeline);
+	}
+
+	void RenderContextRecorder::setMaterial(rawrbox::MaterialBase* material) {
+		// The bindless uniform buffers are shared, the last material may have left different values on them
+		if (material != nullptr) material->resetUniformBinds();
+	}
+
+	void RenderContextRecorder::setBuffers(Diligent::IBuffer* vertex, Diligent::IBuffer* index) {
+		auto* context = rawrbox::RENDERER->context();
+
+		std::array<Diligent::IBuffer*, 1> pBuffs = {vertex};
+		context->SetVertexBuffers(0, 1, pBuffs.data(), nullptr, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY, Diligent::SET_VERTEX_BUFFERS_FLAG_RESET);
+		context->SetIndexBuffer(index, 0, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+	}
+
+	void RenderContextRecorder::setTransform(const rawrbox::Matrix4x4& transform) {
+		if (rawrbox::MAIN_CAMERA == nullptr) RAWRBOX_CRITICAL("Main camera not initialized");
+		rawrbox::MAIN_CAMERA->setModelTransform(transform);
+	}
+
+	void RenderContextRecorder::draw(const rawrbox::DrawItem& item) {
+		if (item.bind != nullptr) item.bind(item);
+
+		Diligent::DrawIndexedAttribs DrawAttrs;
+		DrawAttrs.IndexType = Diligent::VT_UINT32;
+		DrawAttrs.FirstIndexLocation = item.firstIndex;
+		DrawAttrs.BaseVertex = item.baseVertex;
+		DrawAttrs.NumIndices = item.numIndices;
+		DrawAttrs.Flags = Diligent::DRAW_FLAG_VERIFY_ALL;
+
+		rawrbox::RENDERER->context()->DrawIndexed(DrawAttrs);
+	}
+	// ---
+
+	// QUEUE ---
+	void RenderQueue::clear() {
+		this->_items.clear();
+		this->_keys.clear();
+		this->_order.clear();
+		this->_sorted = true;
+	}
+
+	void RenderQueue::push(const rawrbox::DrawItem& item) {
+		this->_items.push_back(item);
+		this->_keys.push_back(item.key);
+		this->_sorted = false;
+	}
+
+	void RenderQueue::reserve(size_t size) {
+		this->_items.reserve(size);
+		this->_keys.reserve(size);
+		this->_order.reserve(size);
+	}
+
+	uint16_t RenderQueue::getPipelineID(const void* pipeline) {
+		auto fnd = this->_pipelineIDs.find(pipeline);
+		if (fnd != this->_pipelineIDs.end()) return fnd->second;
+
+		const auto id = static_cast<uint16_t>(std::min<size_t>(this->_pipelineIDs.size() + 1, 0xFFFF));
+		this->_pipelineIDs.emplace(pipeline, id);
+		return id;
+	}
+
+	uint16_t RenderQueue::getTextureSetID(const rawrbox::Vector4_t<uint32_t>& textures) {
+		// Bindless texture ids are below RB_RENDER_MAX_TEXTURES (8192), 16 bits each is enough for the map key
+		const uint64_t hash = (static_cast<uint64_t>(textures.x & 0xFFFF) << 48U) |
+				      (static_cast<uint64_t>(textures.y & 0xFFFF) << 32U) |
+				      (static_cast<uint64_t>(textures.z & 0xFFFF) << 16U) |
+				      (static_cast<uint64_t>(textures.w & 0xFFFF));
+
+		auto fnd = this->_textureIDs.find(hash);
+		if (fnd != this->_textureIDs.end()) return fnd->second;
+
+		const auto id = static_cast<uint16_t>(std::min<size_t>(this->_textureIDs.size() + 1, 0xFFFF));
+		this->_textureIDs.emplace(hash, id);
+		return id;
+	}
+
+	void RenderQueue::sort() {
+		if (this->_sorted && this->_order.size() == this->_items.size()) return;
+		RAWRBOX_PROFILE_ZONE("RenderQueue::sort");
+
+		rawrbox::SortUtils::radix(this->_keys, this->_order, this->_scratch);
+		this->_sorted = true;
+	}
+
+	void RenderQueue::submit(rawrbox::RenderRecorder& recorder) {
+		RAWRBOX_PROFILE_ZONE("RenderQueue::submit");
+		this->sort();
+		this->_stats = {};
+
+		Diligent::IPipelineState* pipeline = nullptr;
+		rawrbox::MaterialBase* material = nullptr;
+		Diligent::IBuffer* vertexBuffer = nullptr;
+		Diligent::IBuffer* indexBuffer = nullptr;
+		const rawrbox::Matrix4x4* transform = nullptr;
+
+		for (auto index : this->_order) {
+			const auto& item = this->_items[index];
+
+			if (item.pipeline != pipeline) {
+				pipeline = item.pipeline;
+				recorder.setPipeline(pipeline);
+				this->_stats.pipelines++;
+			}
+
+			if (item.material != material) {
+				material = item.material;
+				recorder.setMaterial(material);
+				this->_stats.materials++;
+			}
+
+			if (item.vertexBuffer != vertexBuffer || item.indexBuffer != indexBuffer) {
+				vertexBuffer = item.vertexBuffer;
+				indexBuffer = item.indexBuffer;
+				recorder.setBuffers(vertexBuffer, indexBuffer);
+				this->_stats.buffers++;
+			}
+
+			if (transform == nullptr || item.transform != *transform) {
+				transform = &item.transform;
+				recorder.setTransform(item.transform);
+				this->_stats.transforms++;
+			}
+
+			recorder.draw(item);
+			this->_stats.draws++;
+		}
+
+		RAWRBOX_PROFILE_COUNTER("RenderQueue::draws", this->_stats.draws);
+		RAWRBOX_PROFILE_COUNTER("RenderQueue::pipelines", this->_stats.pipelines);
+	}
+
+	const std::vector<rawrbox::DrawItem>& RenderQueue::getItems() const { return this->_items; }
+	const std::vector<uint32_t>& RenderQueue::getOrder() const { return this->_order; }
+	const rawrbox::RenderQueueStats& RenderQueue::getStats() const { return this->_stats; }
+	size_t RenderQueue::size() const { return this->_items.size(); }
+	bool RenderQueue::empty() const { return this->_items.empty(); }
+	// ---
+} // namespace rawrbox
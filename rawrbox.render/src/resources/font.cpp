@@ -3,8 +3,8 @@
 
 namespace rawrbox {
 	// Resource ----
-	rawrbox::Font* ResourceFont::getSize(uint16_t size, uint32_t /*flags*/) {
-		return rawrbox::TextEngine::load(filePath.generic_string(), size);
+	rawrbox::Font* ResourceFont::getSize(uint16_t size, uint32_t flags) {
+		return rawrbox::TextEngine::load(filePath.generic_string(), size, 0, static_cast<rawrbox::FONT_TYPE>(flags));
 	}
 	// -------
 
@@ -21,6 +21,7 @@ namespace rawrbox {
 			this->_texture = std::make_unique<rawrbox::TextureAtlas>(this->filePath, buffer, flags); // Use flags for sprite size
 		} else {
 			this->_texture = std::make_unique<rawrbox::TextureImage>(this->filePath, buffer);
+			this->_texture->setMipMaps(type == rawrbox::TEXTURE_TYPE::PIXEL);
 		}
 
 		this->_texture->setType(type);
@@ -27,6 +27,7 @@ namespace rawrbox {
 		this->_2dPipeline = nullptr;
 		this->_linePipeline = nullptr;
 		this->_textPipeline = nullptr;
+		this->_textSDFPipeline = nullptr;
 
 		this->_streamingIB.reset();
 		this->_streamingVB.reset();
@@ -54,6 +55,9 @@ namespace rawrbox {
 		settings.topology = Diligent::PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
 		settings.pPS = "stencil_text.psh";
 		this->_textPipeline = rawrbox::PipelineUtils::createPipeline("Stencil::2DText", settings);
+
+		settings.macros.AddShaderMacro("SDF_TEXT", true);
+		this->_textSDFPipeline = rawrbox::PipelineUtils::createPipeline("Stencil::2DText::SDF", settings);
 		// -------------
 	}
 
@@ -65,14 +69,14 @@ namespace rawrbox {
 		this->applyScale(pos);
 		this->applyRotation(pos);
 
-		this->_currentDraw.vertices.emplace_back(textureID,
+		this->_target->pushVertex({textureID,
 		    rawrbox::Vector2f(pos.x + this->_offset.x, pos.y + this->_offset.y),
 		    uv,
-		    col);
+		    col});
 	}
 
-	void Stencil::pushIndices(std::vector<uint32_t> ind) {
-		this->_currentDraw.indices.insert(this->_currentDraw.indices.end(), ind.begin(), ind.end());
+	void Stencil::pushIndices(std::initializer_list<uint32_t> ind) {
+		this->_target->pushIndices(ind);
 	}
 
 	void Stencil::applyRotation(rawrbox::Vector2f& vert) const {
@@ -164,7 +168,7 @@ namespace rawrbox {
 			for (const auto& v : poly.verts)
 				this->pushVertice(textureID, v.pos, v.uv, v.col);
 
-			this->_currentDraw.indices.insert(this->_currentDraw.indices.end(), poly.indices.begin(), poly.indices.end());
+			this->_target->pushIndices(poly.indices);
 		}
 
 		// Add to calls
@@ -339,7 +343,7 @@ namespace rawrbox {
 		int num_quads = stb_easy_font_print(0, 0, textCh, nullptr, vertexBuffer.data(), static_cast<int>(vertexBuffer.size()));
 
 		auto* data = std::bit_cast<float*>(vertexBuffer.data());
-		std::vector<uint32_t> indices = {};
+		auto& indices = this->_target->_indices;
 
 		for (int quad = 0, stride = 0; quad < num_quads; ++quad, stride += 16) {
 			// Push vertices for the current quad
@@ -358,8 +362,6 @@ namespace rawrbox {
 			indices.push_back(base_index);
 		}
 
-		this->pushIndices(indices);
-
 		// Add to calls
 		this->pushDrawCall();
 		// ----
@@ -368,14 +370,20 @@ namespace rawrbox {
 	void Stencil::drawText(const rawrbox::Font& font, const std::string& text, const rawrbox::Vector2f& pos, const rawrbox::Color& col, rawrbox::Alignment alignX, rawrbox::Alignment alignY) {
 		if (col.invisible() || text.empty()) return;
 
-		rawrbox::Vector2f tsize = font.getStringSize(text);
-		rawrbox::Vector2f startpos = this->alignPosition(pos, tsize, alignX, alignY);
+		const auto run = rawrbox::TextLayout::get(font, text);
+		this->drawText(font, *run, this->alignPosition(pos, run->size, alignX, alignY), col);
+	}
+
+	void Stencil::drawText(const rawrbox::Font& font, const rawrbox::TextRun& run, const rawrbox::Vector2f& pos, const rawrbox::Color& col) {
+		if (col.invisible() || run.glyphs.empty()) return;
 
-		font.render(text, startpos, false, [this, &font, col](rawrbox::Glyph* glyph, float x0, float y0, float x1, float y1) {
+		auto* pipeline = font.getType() == rawrbox::FONT_TYPE::SDF ? this->_textSDFPipeline : this->_textPipeline;
+
+		font.render(run, pos, false, [this, &font, col, pipeline](rawrbox::Glyph* glyph, float x0, float y0, float x1, float y1) {
 			uint32_t textureID = font.getPackTexture(glyph)->getTextureID();
 
 			// Setup --------
-			this->setupDrawCall(this->_textPipeline);
+			this->setupDrawCall(pipeline);
 			// ----
 
 			this->pushVertice(textureID, {x0, y0}, glyph->textureTopLeft, col);
@@ -422,8 +430,8 @@ namespace rawrbox {
 		this->setupDrawCall(this->_2dPipeline);
 		// ----
 
-		this->_currentDraw.vertices = vertices;
-		this->_currentDraw.indices = indices;
+		this->_target->_vertices.insert(this->_target->_vertices.end(), vertices.begin(), vertices.end());
+		this->_target->pushIndices(indices);
 
 		// Add to calls
 		this->pushDrawCall();
@@ -433,33 +441,35 @@ namespace rawrbox {
 
 	// ------RENDERING
 	void Stencil::setupDrawCall(Diligent::IPipelineState* program) {
-		this->_currentDraw.clear();
+		this->_currentDraw = {};
 
 		this->_currentDraw.optimize = this->_optimizations.empty() ? true : this->_optimizations.back();
 		this->_currentDraw.stencilProgram = program;
-		this->_currentDraw.clip = this->_clips.empty() ? rawrbox::Clip{{0, 0, this->_size.x, this->_size.y}} : this->_clips.back();
+		this->_currentDraw.inheritClip = this->isRecording() && this->_clips.empty();
+		this->_currentDraw.clip = this->getCurrentClip();
+		this->_currentDraw.updateKey(this->getPipelineKey(program));
+
+		this->_target->begin(this->_currentDraw);
 	}
 
 	void Stencil::pushDrawCall() {
-		if (this->_currentDraw.optimize && !this->_drawCalls.empty()) {
-			auto& oldCall = this->_drawCalls.back();
+		this->_target->commit(this->_currentDraw);
 
-			bool canMerge = oldCall.clip == this->_currentDraw.clip &&
-					oldCall.cull == this->_currentDraw.cull &&
-					oldCall.stencilProgram == this->_currentDraw.stencilProgram &&
-					oldCall.vertices.size() + this->_currentDraw.vertices.size() < MaxVertsInStreamingBuffer;
+		// Outlines draw lines inside another primitive, the outer push has nothing left to add
+		this->_target->begin(this->_currentDraw);
+	}
 
-			if (canMerge) {
-				for (auto& ind : this->_currentDraw.indices) {
-					oldCall.indices.push_back(static_cast<uint32_t>(oldCall.vertices.size()) + ind);
-				}
+	rawrbox::Clip Stencil::getCurrentClip() const {
+		return this->_clips.empty() ? rawrbox::Clip{{0, 0, this->_size.x, this->_size.y}} : this->_clips.back();
+	}
 
-				oldCall.vertices.insert(oldCall.vertices.end(), this->_currentDraw.vertices.begin(), this->_currentDraw.vertices.end());
-				return;
-			}
-		}
+	uint64_t Stencil::getPipelineKey(Diligent::IPipelineState* program) const {
+		if (program == this->_2dPipeline) return 1;
+		if (program == this->_linePipeline) return 2;
+		if (program == this->_textPipeline) return 3;
+		if (program == this->_textSDFPipeline) return 4;
 
-		this->_drawCalls.emplace_back(this->_currentDraw);
+		return 5 + (std::bit_cast<uintptr_t>(program) >> 4U) % 251U;
 	}
 
 	void Stencil::internalDraw() {
@@ -468,12 +478,11 @@ namespace rawrbox {
 		auto* context = rawrbox::RENDERER->context();
 		size_t contextID = 0;
 
-		for (auto& group : this->_drawCalls) {
+		for (auto& group : this->_drawCalls._commands) {
 			if (group.stencilProgram == nullptr) continue;
-			if (group.vertices.empty() || group.indices.empty()) continue;
 
-			auto vertSize = static_cast<uint32_t>(group.vertices.size());
-			auto indSize = static_cast<uint32_t>(group.indices.size());
+			auto vertSize = group.vertexCount;
+			auto indSize = group.indexCount;
 
 			// Allocate data -----
 			auto VBOffset = static_cast<uint64_t>(this->_streamingVB->allocate(vertSize * sizeof(rawrbox::PosUVColorVertexData), contextID));
@@ -482,8 +491,8 @@ namespace rawrbox {
 			auto* VertexData = std::bit_cast<rawrbox::PosUVColorVertexData*>(std::bit_cast<uint8_t*>(this->_streamingVB->getCPUAddress(contextID)) + VBOffset);
 			auto* IndexData = std::bit_cast<uint32_t*>(std::bit_cast<uint8_t*>(this->_streamingIB->getCPUAddress(contextID)) + IBOffset);
 
-			std::memcpy(VertexData, group.vertices.data(), vertSize * sizeof(rawrbox::PosUVColorVertexData));
-			std::memcpy(IndexData, group.indices.data(), indSize * sizeof(uint32_t));
+			std::memcpy(VertexData, this->_drawCalls._vertices.data() + group.vertexOffset, vertSize * sizeof(rawrbox::PosUVColorVertexData));
+			std::memcpy(IndexData, this->_drawCalls._indices.data() + group.indexOffset, indSize * sizeof(uint32_t));
 
 			this->_streamingVB->release(contextID);
 			this->_streamingIB->release(contextID);
@@ -529,7 +538,7 @@ namespace rawrbox {
 		this->_streamingIB->flush(contextID);
 		this->_streamingVB->flush(contextID);
 
-		this->_drawCalls.clear();
+		this->_drawCalls.clear(); // Keeps the capacity for the next frame
 	}
 
 	void Stencil::render() {
@@ -539,12 +548,59 @@ namespace rawrbox {
 		if (!this->_clips.empty()) RAWRBOX_CRITICAL("Missing 'popClipping', cannot draw");
 		if (!this->_scales.empty()) RAWRBOX_CRITICAL("Missing 'popScale', cannot draw");
 		if (!this->_optimizations.empty()) RAWRBOX_CRITICAL("Missing 'popOptimize', cannot draw");
+		if (this->isRecording()) RAWRBOX_CRITICAL("Missing 'endRecording', cannot draw");
 
 		this->internalDraw();
 	}
 
 	// --------------------
 
+	// ------ RECORDING
+	void Stencil::beginRecording(rawrbox::StencilDrawList& list) {
+		if (this->isRecording()) RAWRBOX_CRITICAL("Already recording, call 'endRecording' first");
+
+		list.clear();
+		this->_target = &list;
+
+		// Record in local space, drawList adds the offset back
+		this->_recordOffset = this->_offset;
+		this->_offset = {};
+
+		this->_recordOffsets.swap(this->_offsets);
+		this->_recordClips.swap(this->_clips);
+	}
+
+	void Stencil::endRecording() {
+		if (!this->isRecording()) RAWRBOX_CRITICAL("Not recording, call 'beginRecording' first");
+		if (!this->_offsets.empty()) RAWRBOX_CRITICAL("Missing 'popOffset', cannot end recording");
+		if (!this->_clips.empty()) RAWRBOX_CRITICAL("Missing 'popClipping', cannot end recording");
+
+		this->_target->_dirty = false;
+		this->_target = &this->_drawCalls;
+
+		this->_offset = this->_recordOffset;
+		this->_offsets.swap(this->_recordOffsets);
+		this->_clips.swap(this->_recordClips);
+	}
+
+	bool Stencil::isRecording() const { return this->_target != &this->_drawCalls; }
+
+	void Stencil::drawList(const rawrbox::StencilDrawList& list) {
+		if (&list == this->_target) RAWRBOX_CRITICAL("Cannot draw a list into itself");
+		this->_target->append(list, this->_offset, this->getCurrentClip(), this->isRecording() && this->_clips.empty());
+	}
+
+	void Stencil::drawList(rawrbox::StencilDrawList& list, const std::function<void()>& builder) {
+		if (list.isDirty()) {
+			this->beginRecording(list);
+			builder();
+			this->endRecording();
+		}
+
+		this->drawList(list);
+	}
+	// --------------------
+
 	// ------ LOCATION
 	void Stencil::pushOffset(const rawrbox::Vector2f& offset) {
 		this->_offsets.push_back(offset);
@@ -637,7 +693,7 @@ namespace rawrbox {
 
 	// ------ OTHER
 	const rawrbox::Vector2u& Stencil::getSize() const { return this->_size; }
-	std::vector<rawrbox::StencilDraw> Stencil::getDrawCalls() const { return this->_drawCalls; }
+	std::vector<rawrbox::StencilDraw> Stencil::getDrawCalls() const { return this->_drawCalls.getDrawCalls(); }
 
 	void Stencil::clear() { this->_drawCalls.clear(); }
 	// --------------------
@@ -0,0 +1,126 @@
+#include <rawrbox/render/stencil_list.hpp>
+
+namespace rawrbox {
+	// COMMAND ----
+	void StencilCommand::updateKey(uint64_t pipeline) {
+		// Textures are bindless (per vertex), so they never split a batch and aren't part of the key
+		const auto& bbox = this->clip.bbox;
+
+		uint64_t hash = bbox.pos.x;
+		hash = hash * 0x9E3779B1U + bbox.pos.y;
+		hash = hash * 0x9E3779B1U + bbox.size.x;
+		hash = hash * 0x9E3779B1U + bbox.size.y;
+
+		this->key = (pipeline << PIPELINE_SHIFT) |
+			    (static_cast<uint64_t>(this->clip.worldSpace) << 55U) |
+			    (static_cast<uint64_t>(this->inheritClip) << 54U) |
+			    (static_cast<uint64_t>(this->cull) << 53U) |
+			    (hash & ((1ULL << 53U) - 1U));
+	}
+	// -------------
+
+	// BUILDING ----
+	void StencilDrawList::begin(rawrbox::StencilCommand& cmd) const {
+		cmd.vertexOffset = static_cast<uint32_t>(this->_vertices.size());
+		cmd.indexOffset = static_cast<uint32_t>(this->_indices.size());
+		cmd.vertexCount = 0;
+		cmd.indexCount = 0;
+	}
+
+	void StencilDrawList::pushVertex(const rawrbox::PosUVColorVertexData& vert) {
+		this->_vertices.push_back(vert);
+	}
+
+	void StencilDrawList::pushIndices(std::initializer_list<uint32_t> ind) {
+		this->_indices.insert(this->_indices.end(), ind.begin(), ind.end());
+	}
+
+	void StencilDrawList::pushIndices(const std::vector<uint32_t>& ind) {
+		this->_indices.insert(this->_indices.end(), ind.begin(), ind.end());
+	}
+
+	void StencilDrawList::commit(rawrbox::StencilCommand& cmd) {
+		// The vertices and indices were already appended, from the command's offsets to the end
+		cmd.vertexCount = static_cast<uint32_t>(this->_vertices.size()) - cmd.vertexOffset;
+		cmd.indexCount = static_cast<uint32_t>(this->_indices.size()) - cmd.indexOffset;
+		if (cmd.vertexCount == 0 || cmd.indexCount == 0) {
+			this->_vertices.resize(cmd.vertexOffset);
+			this->_indices.resize(cmd.indexOffset);
+			return;
+		}
+
+		if (cmd.optimize && !this->_commands.empty()) {
+			auto& oldCall = this->_commands.back();
+
+			// Both are at the end of the buffers, so merging only needs the indices rebased
+			if (oldCall.canMerge(cmd) && oldCall.vertexCount + cmd.vertexCount < MAX_BATCH_VERTICES) {
+				const uint32_t base = cmd.vertexOffset - oldCall.vertexOffset;
+				for (size_t i = cmd.indexOffset; i < this->_indices.size(); i++) {
+					this->_indices[i] += base;
+				}
+
+				oldCall.vertexCount += cmd.vertexCount;
+				oldCall.indexCount += cmd.indexCount;
+				return;
+			}
+		}
+
+		this->_commands.push_back(cmd);
+	}
+
+	void StencilDrawList::append(const rawrbox::StencilDrawList& list, const rawrbox::Vector2f& offset, const rawrbox::Clip& clip, bool inheritClip) {
+		if (&list == this) return;
+
+		const auto clipOffset = offset.cast<uint32_t>();
+
+		this->_vertices.reserve(this->_vertices.size() + list._vertices.size());
+		this->_indices.reserve(this->_indices.size() + list._indices.size());
+
+		for (const auto& recorded : list._commands) {
+			rawrbox::StencilCommand cmd = recorded;
+			this->begin(cmd);
+
+			if (cmd.inheritClip) {
+				cmd.clip = clip;
+				cmd.inheritClip = inheritClip;
+			} else {
+				cmd.clip.bbox.pos += clipOffset; // Same as pushClipping would have done with the offset applied
+			}
+
+			cmd.updateKey(recorded.getPipelineKey());
+
+			for (uint32_t i = 0; i < recorded.vertexCount; i++) {
+				auto& vert = this->_vertices.emplace_back(list._vertices[recorded.vertexOffset + i]);
+				vert.pos += offset;
+			}
+
+			this->_indices.insert(this->_indices.end(), list._indices.begin() + recorded.indexOffset, list._indices.begin() + recorded.indexOffset + recorded.indexCount);
+			this->commit(cmd);
+		}
+	}
+	// -------------
+
+	void StencilDrawList::clear() {
+		this->_vertices.clear();
+		this->_indices.clear();
+		this->_commands.clear();
+	}
+
+	std::vector<rawrbox::StencilDraw> StencilDrawList::getDrawCalls() const {
+		std::vector<rawrbox::StencilDraw> calls = {};
+		calls.reserve(this->_commands.size());
+
+		for (const auto& cmd : this->_commands) {
+			auto& call = calls.emplace_back();
+			call.stencilProgram = cmd.stencilProgram;
+			call.clip = cmd.clip;
+			call.cull = cmd.cull;
+			call.optimize = cmd.optimize;
+
+			call.vertices.assign(this->_vertices.begin() + cmd.vertexOffset, this->_vertices.begin() + cmd.vertexOffset + cmd.vertexCount);
+			call.indices.assign(this->_indices.begin() + cmd.indexOffset, this->_indices.begin() + cmd.indexOffset + cmd.indexCount);
+		}
+
+		return calls;
+	}
+} // namespace rawrbox
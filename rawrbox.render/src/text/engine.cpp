@@ -1,5 +1,6 @@
 #include <rawrbox/render/static.hpp>
 #include <rawrbox/render/text/engine.hpp>
+#include <rawrbox/render/text/layout.hpp>
 #include <rawrbox/utils/file.hpp>
 
 #include <fmt/format.h>
@@ -36,6 +37,7 @@ namespace rawrbox {
 	}
 
 	void TextEngine::shutdown() {
+		rawrbox::TextLayout::clear(); // Runs point to the glyphs
 		_fonts.clear();
 		_packs.clear();
 		_logger.reset();
@@ -64,9 +66,7 @@ namespace rawrbox {
 		return fnd->second.get();
 	}
 
-	rawrbox::Font* TextEngine::load(const std::filesystem::path& filename, uint16_t size, uint32_t index) {
-		std::string key = fmt::format("{}-{}", filename.generic_string(), size);
-
+	rawrbox::Font* TextEngine::loadFile(const std::filesystem::path& filename, const std::string& key, uint16_t size, uint32_t index, rawrbox::FONT_TYPE type) {
 		// Check cache
 		auto fnd = _fonts.find(key);
 		if (fnd != _fonts.end()) return fnd->second.get();
@@ -88,7 +88,26 @@ namespace rawrbox {
 		if (bytes.empty()) RAWRBOX_CRITICAL("Failed to load font '{}'", filename.generic_string());
 
 		_fonts[key] = std::make_unique<rawrbox::Font>(filename);
-		_fonts[key]->load(bytes, size, index);
+		_fonts[key]->load(bytes, size, index, type);
+
+		return _fonts[key].get();
+	}
+
+	rawrbox::Font* TextEngine::load(const std::filesystem::path& filename, uint16_t size, uint32_t index, rawrbox::FONT_TYPE type) {
+		if (type == rawrbox::FONT_TYPE::ALPHA) return loadFile(filename, fmt::format("{}-{}", filename.generic_string(), size), size, index, type);
+
+		std::string key = fmt::format("{}-{}-sdf", filename.generic_string(), size);
+
+		// Check cache
+		auto fnd = _fonts.find(key);
+		if (fnd != _fonts.end()) return fnd->second.get();
+		// ------
+
+		auto* source = loadFile(filename, fmt::format("{}-sdf", filename.generic_string()), rawrbox::Font::SDF_SIZE, index, type);
+		if (source == nullptr || source->getType() != rawrbox::FONT_TYPE::SDF) return source; // Fallback font
+
+		_fonts[key] = std::make_unique<rawrbox::Font>(filename);
+		_fonts[key]->load(*source, size);
 
 		return _fonts[key].get();
 	}
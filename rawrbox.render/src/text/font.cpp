@@ -1,6 +1,8 @@
 #include <rawrbox/math/utils/color.hpp>
 #include <rawrbox/render/text/engine.hpp>
 #include <rawrbox/render/text/font.hpp>
+#include <rawrbox/render/text/layout.hpp>
+#include <rawrbox/utils/threading.hpp>
 
 // NOLINTBEGIN(clang-diagnostic-unknown-pragmas)
 #pragma warning(push)
@@ -14,10 +16,17 @@
 #include <fmt/format.h>
 #include <utf8.h>
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 
 namespace rawrbox {
+	static std::atomic<uint64_t> fontIDs = 0;
+
 	Font::~Font() {
+		rawrbox::TextLayout::evict(this->_id);
 		if (this->_font == nullptr) return;
 
 		this->_font.reset();
@@ -26,7 +35,7 @@ namespace rawrbox {
 
 	// NOLINTBEGIN(modernize-pass-by-value)
 	Font::Font(
-	    const std::filesystem::path& fileName, int16_t widthPadding, int16_t heightPadding) : _fileName(fileName), _widthPadding(widthPadding), _heightPadding(heightPadding), _info({}) {}
+	    const std::filesystem::path& fileName, int16_t widthPadding, int16_t heightPadding) : _id(++fontIDs), _fileName(fileName), _widthPadding(widthPadding), _heightPadding(heightPadding), _info({}) {}
 	// NOLINTEND(modernize-pass-by-value)
 
 	// INTERNAL ---
@@ -55,7 +64,7 @@ namespace rawrbox {
 		this->_info.underlineThickness = (x1 - x0) * this->_scale / 24.F;
 	}
 
-	std::unique_ptr<rawrbox::Glyph> Font::bakeGlyphAlpha(uint32_t codePoint) {
+	Font::GlyphBitmap Font::rasterizeGlyph(uint32_t codePoint) const {
 		if (this->_font == nullptr) RAWRBOX_CRITICAL("Font not loaded");
 
 		int32_t ascent = 0;
@@ -68,61 +77,166 @@ namespace rawrbox {
 		stbtt_GetCodepointHMetrics(this->_font.get(), codePoint, &advance, &lsb);
 
 		const float scale = this->_scale;
+		GlyphBitmap bitmap = {};
+
 		int32_t x0 = 0;
 		int32_t y0 = 0;
-		int32_t x1 = 0;
-		int32_t y1 = 0;
-		stbtt_GetCodepointBitmapBox(this->_font.get(), codePoint, scale, scale, &x0, &y0, &x1, &y1);
 
-		const auto ww = static_cast<int16_t>(x1 - x0);
-		const auto hh = static_cast<int16_t>(y1 - y0);
+		if (this->_type == rawrbox::FONT_TYPE::SDF) {
+			int32_t ww = 0;
+			int32_t hh = 0;
+
+			auto* sdf = stbtt_GetCodepointSDF(this->_font.get(), scale, static_cast<int>(codePoint), SDF_PADDING, SDF_ON_EDGE, static_cast<float>(SDF_ON_EDGE) / SDF_PADDING, &ww, &hh, &x0, &y0);
+			if (sdf != nullptr) {
+				bitmap.pixels.assign(sdf, sdf + static_cast<size_t>(ww * hh));
+				stbtt_FreeSDF(sdf, nullptr);
 
-		std::unique_ptr<rawrbox::Glyph> glyph = std::make_unique<rawrbox::Glyph>();
-		glyph->codePoint = codePoint;
-		glyph->offset = {static_cast<float>(x0), static_cast<float>(y0)};
-		glyph->size = {static_cast<float>(ww), static_cast<float>(hh)};
-		glyph->advance = {std::round(static_cast<float>(advance) * scale), std::round((static_cast<float>(ascent + descent + lineGap)) * scale)};
+				bitmap.width = static_cast<uint16_t>(ww);
+				bitmap.height = static_cast<uint16_t>(hh);
+			}
+		} else {
+			int32_t x1 = 0;
+			int32_t y1 = 0;
+			stbtt_GetCodepointBitmapBox(this->_font.get(), codePoint, scale, scale, &x0, &y0, &x1, &y1);
+
+			bitmap.width = static_cast<uint16_t>(x1 - x0);
+			bitmap.height = static_cast<uint16_t>(y1 - y0);
 
-		// Bitmap ----
-		uint16_t bpp = 1;
-		uint16_t dstPitch = ww * bpp;
+			bitmap.pixels.resize(static_cast<size_t>(bitmap.width) * bitmap.height);
+			stbtt_MakeCodepointBitmap(this->_font.get(), bitmap.pixels.data(), bitmap.width, bitmap.height, bitmap.width, scale, scale, codePoint);
+		}
 
-		std::vector<uint8_t> buffer = {};
-		buffer.resize(ww * hh * sizeof(uint8_t));
-		stbtt_MakeCodepointBitmap(this->_font.get(), buffer.data(), ww, hh, dstPitch, scale, scale, codePoint);
+		bitmap.glyph = std::make_unique<rawrbox::Glyph>();
+		bitmap.glyph->codePoint = codePoint;
+		bitmap.glyph->index = stbtt_FindGlyphIndex(this->_font.get(), static_cast<int>(codePoint));
+		bitmap.glyph->offset = {static_cast<float>(x0), static_cast<float>(y0)};
+		bitmap.glyph->size = {static_cast<float>(bitmap.width), static_cast<float>(bitmap.height)};
+		bitmap.glyph->advance = {std::round(static_cast<float>(advance) * scale), std::round((static_cast<float>(ascent + descent + lineGap)) * scale)};
+		bitmap.glyph->scale = this->_info.scale;
 
-		auto pack = rawrbox::TextEngine::requestPack(ww, hh, Diligent::TEXTURE_FORMAT::TEX_FORMAT_RGBA8_UNORM); // FONT_TYPE_ALPHA
+		bitmap.glyph->advance *= this->_info.scale;
+		bitmap.glyph->offset *= this->_info.scale;
+		bitmap.glyph->size *= this->_info.scale;
+
+		return bitmap;
+	}
+
+	void Font::packGlyph(GlyphBitmap& bitmap) {
+		if (bitmap.width == 0 || bitmap.height == 0) return; // Nothing to draw (spaces, etc)
+
+		auto pack = rawrbox::TextEngine::requestPack(bitmap.width, bitmap.height, Diligent::TEXTURE_FORMAT::TEX_FORMAT_RGBA8_UNORM); // FONT_TYPE_ALPHA
 		if (pack.second == nullptr) RAWRBOX_CRITICAL("Failed to generate / get atlas texture");
 
-		auto& packNode = pack.second->addSprite(ww, hh, rawrbox::ColorUtils::setChannels(1, 4, ww, hh, buffer));
+		auto packNode = pack.second->addSprite(bitmap.width, bitmap.height, rawrbox::ColorUtils::setChannels(1, 4, bitmap.width, bitmap.height, bitmap.pixels));
 		auto size = pack.second->getSize();
 
-		glyph->packID = pack.first;
-		glyph->textureTopLeft = {packNode.x / static_cast<float>(size.x), packNode.y / static_cast<float>(size.y)};
-		glyph->textureBottomRight = {(packNode.x + packNode.width) / static_cast<float>(size.x), (packNode.y + packNode.height) / static_cast<float>(size.y)};
+		bitmap.glyph->packID = pack.first;
+		bitmap.glyph->textureTopLeft = {packNode.x / static_cast<float>(size.x), packNode.y / static_cast<float>(size.y)};
+		bitmap.glyph->textureBottomRight = {(packNode.x + packNode.width) / static_cast<float>(size.x), (packNode.y + packNode.height) / static_cast<float>(size.y)};
+	}
+
+	rawrbox::Glyph* Font::scaleGlyph(uint32_t codePoint) const {
+		std::unique_ptr<rawrbox::Glyph> glyph = nullptr;
+
+		{
+			const std::shared_lock lock(this->_source->_glyphLock);
+
+			auto fnd = this->_source->_glyphs.find(codePoint);
+			if (fnd == this->_source->_glyphs.end()) return nullptr;
+
+			glyph = std::make_unique<rawrbox::Glyph>(*fnd->second);
+		}
+
+		const float ratio = this->_scale / this->_source->_scale;
+		glyph->size *= ratio;
+		glyph->offset *= ratio;
+		glyph->advance *= ratio;
+
+		return this->storeGlyph(std::move(glyph));
+	}
+
+	rawrbox::Glyph* Font::storeGlyph(std::unique_ptr<rawrbox::Glyph> glyph) const {
+		const uint32_t codePoint = glyph->codePoint;
+		const std::unique_lock lock(this->_glyphLock);
+
+		// Two threads can scale the same glyph, first one wins. Never replace it, someone might be holding it
+		auto [it, added] = this->_glyphs.try_emplace(codePoint, std::move(glyph));
+		auto* ptr = it->second.get();
+
+		if (added && codePoint < this->_fastGlyphs.size()) this->_fastGlyphs[codePoint].store(ptr, std::memory_order_release);
+		return ptr;
+	}
+
+	void Font::updateKerning(const std::vector<uint32_t>& added) {
+		if (!this->_hasKerning) return;
+
+		// Only the fast range is tabled, the rest is looked up on demand
+		std::unordered_map<uint32_t, int32_t> kerning = {};
+		for (auto prev : added) {
+			const auto* prevGlyph = prev < this->_fastGlyphs.size() ? this->_fastGlyphs[prev].load(std::memory_order_acquire) : nullptr;
+			if (prevGlyph == nullptr) continue;
 
-		glyph->scale = this->_info.scale;
+			for (uint32_t next = 0; next < this->_fastGlyphs.size(); next++) {
+				const auto* glyph = this->_fastGlyphs[next].load(std::memory_order_acquire);
+				if (glyph == nullptr) continue;
 
-		glyph->advance *= this->_info.scale;
-		glyph->offset *= this->_info.scale;
-		glyph->size *= this->_info.scale;
+				int32_t kern = stbtt_GetGlyphKernAdvance(this->_font.get(), prevGlyph->index, glyph->index);
+				if (kern != 0) kerning[prev << 16 | next] = kern;
+
+				kern = stbtt_GetGlyphKernAdvance(this->_font.get(), glyph->index, prevGlyph->index);
+				if (kern != 0) kerning[next << 16 | prev] = kern;
+			}
+		}
 
-		return glyph;
+		const std::unique_lock lock(this->_glyphLock);
+		this->_kerning.merge(kerning);
 	}
 
 	void Font::generateGlyph(uint32_t codePoint) {
-		if (this->hasGlyph(codePoint)) return;
-		this->_glyphs[codePoint] = this->bakeGlyphAlpha(codePoint);
+		this->generateGlyphs({codePoint});
+	}
+
+	void Font::generateGlyphs(const std::vector<uint32_t>& codePoints) {
+		if (this->_source != nullptr) {
+			this->_source->generateGlyphs(codePoints); // Scaled lazily on getGlyph
+			return;
+		}
+
+		std::vector<uint32_t> missing = {};
+		for (auto codePoint : codePoints) {
+			if (this->hasGlyph(codePoint) || std::find(missing.begin(), missing.end(), codePoint) != missing.end()) continue;
+			missing.push_back(codePoint);
+		}
+
+		if (missing.empty()) return;
+
+		// Rasterize on the workers, then pack them all at once so the atlas gets a single upload
+		std::vector<GlyphBitmap> bitmaps(missing.size());
+		rawrbox::ASYNC::loop(0, missing.size(), [this, &missing, &bitmaps](size_t i) {
+			bitmaps[i] = this->rasterizeGlyph(missing[i]);
+		});
+
+		for (auto& bitmap : bitmaps) {
+			this->packGlyph(bitmap);
+			this->storeGlyph(std::move(bitmap.glyph));
+		}
+
+		this->updateKerning(missing);
+		this->_version++;
 	}
 	// ----
 
 	// LOADING ---
-	void Font::load(const std::vector<uint8_t>& buffer, uint16_t pixelHeight, uint32_t fontIndex) {
-		int offset = stbtt_GetFontOffsetForIndex(buffer.data(), fontIndex); // Get the offset for `otf` fonts
+	void Font::load(const std::vector<uint8_t>& buffer, uint16_t pixelHeight, uint32_t fontIndex, rawrbox::FONT_TYPE type) {
+		this->_buffer = buffer;
+		this->_type = type;
+
+		int offset = stbtt_GetFontOffsetForIndex(this->_buffer.data(), static_cast<int>(fontIndex)); // Get the offset for `otf` fonts
 
 		// Load
 		this->_font = std::make_shared<stbtt_fontinfo>();
-		if (stbtt_InitFont(this->_font.get(), buffer.data(), offset) == 0) RAWRBOX_CRITICAL("Failed to load font");
+		if (stbtt_InitFont(this->_font.get(), this->_buffer.data(), offset) == 0) RAWRBOX_CRITICAL("Failed to load font");
+		this->_hasKerning = this->_font->kern != 0 || this->_font->gpos != 0;
 		this->_scale = stbtt_ScaleForMappingEmToPixels(this->_font.get(), static_cast<float>(pixelHeight));
 		this->_pixelSize = static_cast<float>(pixelHeight);
 
@@ -132,38 +246,91 @@ namespace rawrbox {
 		this->_charSize = this->getStringSize("�"); // Biggest char in the font
 	}
 
+	void Font::load(rawrbox::Font& source, uint16_t pixelHeight) {
+		if (source._type != rawrbox::FONT_TYPE::SDF || source._source != nullptr) RAWRBOX_CRITICAL("Source font must be a loaded SDF font");
+
+		this->_type = rawrbox::FONT_TYPE::SDF;
+		this->_source = &source;
+		this->_font = source._font;
+
+		this->_scale = stbtt_ScaleForMappingEmToPixels(this->_font.get(), static_cast<float>(pixelHeight));
+		this->_pixelSize = static_cast<float>(pixelHeight);
+
+		this->loadFontInfo();
+		this->_charSize = this->getStringSize("�"); // Biggest char in the font
+	}
+
 	void Font::addChars(const std::string& chars) {
+		std::vector<uint32_t> codePoints = {};
+
 		auto charsIter = chars.begin();
 		while (charsIter < chars.end()) {
-			this->generateGlyph(utf8::next(charsIter, chars.end()));
+			codePoints.push_back(utf8::next(charsIter, chars.end()));
 		}
+
+		this->generateGlyphs(codePoints);
 	}
 
 	rawrbox::Font* Font::scale(uint16_t size) {
 		if (size == this->getSize()) return this;
-		return rawrbox::TextEngine::load(this->_fileName, size);
+		return rawrbox::TextEngine::load(this->_fileName, size, 0, this->_type);
 	}
 	// ----
 
 	// UTILS ---
 	const rawrbox::FontInfo& Font::getFontInfo() const { return this->_info; }
+	rawrbox::FONT_TYPE Font::getType() const { return this->_type; }
+	uint32_t Font::getGlyphVersion() const { return this->_source != nullptr ? this->_source->_version : this->_version; }
+	uint64_t Font::getID() const { return this->_id; }
 
 	bool Font::hasGlyph(uint32_t codepoint) const {
-		return this->_glyphs.find(codepoint) != this->_glyphs.end();
+		{
+			const std::shared_lock lock(this->_glyphLock);
+			if (this->_glyphs.find(codepoint) != this->_glyphs.end()) return true;
+		}
+
+		return this->_source != nullptr && this->_source->hasGlyph(codepoint);
 	}
 
 	rawrbox::Glyph* Font::getGlyph(uint32_t codepoint) const {
-		auto fnd = this->_glyphs.find(codepoint);
-		if (fnd == this->_glyphs.end()) return this->_glyphs.find(65533)->second.get(); // �
-		return fnd->second.get();
+		if (codepoint < this->_fastGlyphs.size()) {
+			auto* glyph = this->_fastGlyphs[codepoint].load(std::memory_order_acquire);
+			if (glyph != nullptr) return glyph;
+		}
+
+		{
+			const std::shared_lock lock(this->_glyphLock);
+
+			auto fnd = this->_glyphs.find(codepoint);
+			if (fnd != this->_glyphs.end()) return fnd->second.get();
+		}
+
+		if (this->_source != nullptr) {
+			auto* glyph = this->scaleGlyph(codepoint);
+			if (glyph != nullptr) return glyph;
+		}
+
+		if (codepoint == 65533) return nullptr;
+		return this->getGlyph(65533); // �
 	}
 
 	float Font::getSize() const { return this->_pixelSize; }
 	float Font::getScale() const { return this->_scale; }
 	float Font::getLineHeight() const { return this->_info.ascender - this->_info.descender + this->_info.lineGap; }
 	float Font::getKerning(uint32_t prevCodePoint, uint32_t nextCodePoint) const {
-		if (this->_font == nullptr || ((this->_font->kern == 0) && (this->_font->gpos == 0))) return 0; // no kerning
-		return this->_info.scale * static_cast<float>(stbtt__GetGlyphKernInfoAdvance(this->_font.get(), prevCodePoint, nextCodePoint));
+		if (prevCodePoint == 0 || this->_font == nullptr) return 0;
+
+		const auto* owner = this->_source != nullptr ? this->_source : this;
+		if (!owner->_hasKerning) return 0; // no kerning
+
+		if (prevCodePoint < this->_fastGlyphs.size() && nextCodePoint < this->_fastGlyphs.size()) {
+			const std::shared_lock lock(owner->_glyphLock);
+
+			auto fnd = owner->_kerning.find(prevCodePoint << 16 | nextCodePoint);
+			return fnd == owner->_kerning.end() ? 0.F : static_cast<float>(fnd->second) * this->_scale;
+		}
+
+		return static_cast<float>(stbtt_GetCodepointKernAdvance(this->_font.get(), static_cast<int>(prevCodePoint), static_cast<int>(nextCodePoint))) * this->_scale;
 	}
 
 	const rawrbox::Vector2f& Font::getCharSize() const {
@@ -171,41 +338,8 @@ namespace rawrbox {
 	}
 
 	rawrbox::Vector2f Font::getStringSize(const std::string& text) const {
-		rawrbox::Vector2f size = {};
-		if (this->_font == nullptr) return size;
-
-		const float lineHeight = this->getLineHeight();
-		size.y = lineHeight;
-
-		if (text.empty()) return size;
-
-		uint32_t prevCodePoint = 0;
-		float cursorX = 0.F;
-
-		auto beginIter = text.begin();
-		auto endIter = utf8::find_invalid(text.begin(), text.end()); // Find invalid utf8
-
-		while (beginIter != endIter) {
-			uint32_t point = utf8::next(beginIter, endIter); // get codepoint
-
-			auto* const glyph = this->getGlyph(point);
-			if (glyph == nullptr) continue;
-
-			if (point == '\n') {
-				size.y += lineHeight;
-				cursorX = 0;
-				prevCodePoint = 0;
-			}
-
-			float kerning = this->getKerning(prevCodePoint, point);
-			cursorX += kerning;
-			cursorX += glyph->advance.x;
-
-			if (cursorX > size.x) size.x = cursorX;
-			prevCodePoint = point;
-		}
-
-		return size;
+		if (this->_font == nullptr) return {};
+		return rawrbox::TextLayout::get(*this, text)->size;
 	}
 
 	rawrbox::TexturePack* Font::getPackTexture(rawrbox::Glyph* g) const {
@@ -214,44 +348,25 @@ namespace rawrbox {
 	}
 
 	void Font::render(const std::string& text, const rawrbox::Vector2f& pos, bool yIsUp, const std::function<void(rawrbox::Glyph*, float, float, float, float)>& renderGlyph) const {
+		this->render(*rawrbox::TextLayout::get(*this, text), pos, yIsUp, renderGlyph);
+	}
+
+	void Font::render(const rawrbox::TextRun& run, const rawrbox::Vector2f& pos, bool yIsUp, const std::function<void(rawrbox::Glyph*, float, float, float, float)>& renderGlyph) const {
 		if (renderGlyph == nullptr) RAWRBOX_CRITICAL("Failed to render glyph! Missing 'renderGlyph' param");
 
-		auto info = this->getFontInfo();
 		const float lineHeight = this->getLineHeight();
+		const float baseline = pos.y + lineHeight + this->_info.descender;
 
-		rawrbox::Vector2f cursor = {pos.x, pos.y + lineHeight + info.descender};
-		uint32_t prevCodePoint = 0;
-
-		auto beginIter = text.begin();
-		auto endIter = utf8::find_invalid(text.begin(), text.end()); // Find invalid utf8
+		for (const auto& textGlyph : run.glyphs) {
+			auto* glyph = textGlyph.glyph;
+			const float lineOffset = static_cast<float>(textGlyph.line) * lineHeight;
 
-		while (beginIter != endIter) {
-			uint32_t point = utf8::next(beginIter, endIter); // get codepoint
-			if (point == L'\n') {
-				if (!yIsUp) {
-					cursor.y += lineHeight;
-				} else {
-					cursor.y -= lineHeight;
-				}
-
-				cursor.x = pos.x;
-				prevCodePoint = 0;
-				continue;
-			}
-
-			auto* const glyph = this->getGlyph(point);
-			float kerning = this->getKerning(prevCodePoint, point);
-			cursor.x += kerning;
-
-			float x0 = cursor.x + glyph->offset.x;
-			float y0 = cursor.y + glyph->offset.y;
+			float x0 = pos.x + textGlyph.x;
+			float y0 = (yIsUp ? baseline - lineOffset : baseline + lineOffset) + glyph->offset.y;
 			float x1 = x0 + glyph->size.x;
 			float y1 = y0 + glyph->size.y;
 
 			renderGlyph(glyph, x0, y0, x1, y1);
-
-			cursor.x += glyph->advance.x;
-			prevCodePoint = point;
 		}
 	}
 	// ----
@@ -0,0 +1,178 @@
+#include <rawrbox/render/text/layout.hpp>
+
+#include <utf8.h>
+
+#include <algorithm>
+#include <bit>
+#include <string_view>
+
+namespace rawrbox {
+	// PROTECTED ----
+	thread_local std::list<TextLayout::Entry> TextLayout::_entries = {};
+	thread_local std::unordered_map<uint64_t, std::list<TextLayout::Entry>::iterator> TextLayout::_lookup = {};
+	// -----------
+
+	// PUBLIC ----
+	size_t TextLayout::CACHE_SIZE = 2048;
+	// -----------
+
+	uint64_t TextLayout::getHash(const rawrbox::Font& font, const std::string& text, float wrapWidth, rawrbox::Alignment align) {
+		uint64_t hash = std::hash<std::string_view>{}(text);
+
+		// boost::hash_combine
+		auto combine = [&hash](uint64_t value) { hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2); };
+		combine(font.getID());
+		combine(std::bit_cast<uint32_t>(wrapWidth));
+		combine(static_cast<uint64_t>(align));
+
+		return hash;
+	}
+
+	std::shared_ptr<const rawrbox::TextRun> TextLayout::get(const rawrbox::Font& font, const std::string& text, float wrapWidth, rawrbox::Alignment align) {
+		const uint64_t hash = getHash(font, text, wrapWidth, align);
+		const uint32_t version = font.getGlyphVersion();
+
+		auto fnd = _lookup.find(hash);
+		if (fnd != _lookup.end()) {
+			auto entry = fnd->second;
+
+			if (entry->font == font.getID() && entry->wrapWidth == wrapWidth && entry->align == align && entry->text == text) {
+				// Glyphs were added since, the run might be using fallback glyphs
+				if (entry->version != version) {
+					entry->run = std::make_shared<const rawrbox::TextRun>(build(font, text, wrapWidth, align));
+					entry->version = version;
+				}
+
+				_entries.splice(_entries.begin(), _entries, entry);
+				return entry->run;
+			}
+
+			// Hash collision, replace it
+			_entries.erase(entry);
+			_lookup.erase(fnd);
+		}
+
+		_entries.push_front({hash, font.getID(), text, wrapWidth, align, version, std::make_shared<const rawrbox::TextRun>(build(font, text, wrapWidth, align))});
+		_lookup[hash] = _entries.begin();
+
+		while (_entries.size() > std::max<size_t>(CACHE_SIZE, 1)) {
+			_lookup.erase(_entries.back().hash);
+			_entries.pop_back();
+		}
+
+		return _entries.front().run;
+	}
+
+	rawrbox::TextRun TextLayout::build(const rawrbox::Font& font, const std::string& text, float wrapWidth, rawrbox::Alignment align) {
+		rawrbox::TextRun run = {};
+		run.glyphs.reserve(text.size());
+
+		std::vector<float> lineWidths = {};
+
+		float cursorX = 0.F;
+		uint32_t prevCodePoint = 0;
+
+		// Last space on the current line, to word wrap from
+		size_t breakIndex = std::string::npos;
+		float breakX = 0.F;
+		float breakWidth = 0.F;
+
+		auto beginIter = text.begin();
+		auto endIter = utf8::find_invalid(text.begin(), text.end()); // Find invalid utf8
+
+		while (beginIter != endIter) {
+			uint32_t point = utf8::next(beginIter, endIter); // get codepoint
+			if (point == '\n') {
+				lineWidths.push_back(cursorX);
+
+				cursorX = 0.F;
+				prevCodePoint = 0;
+				breakIndex = std::string::npos;
+				continue;
+			}
+
+			auto* const glyph = font.getGlyph(point);
+			if (glyph == nullptr) continue;
+
+			float x = cursorX + font.getKerning(prevCodePoint, point);
+			prevCodePoint = point;
+
+			if (point == ' ') {
+				breakWidth = cursorX;
+				cursorX = x + glyph->advance.x;
+
+				breakIndex = run.glyphs.size();
+				breakX = cursorX;
+				continue;
+			}
+
+			if (wrapWidth > 0.F && cursorX > 0.F && x + glyph->advance.x > wrapWidth) {
+				const auto nextLine = static_cast<uint32_t>(lineWidths.size() + 1);
+
+				if (breakIndex != std::string::npos) {
+					// Move the current word to the next line
+					lineWidths.push_back(breakWidth);
+
+					for (size_t i = breakIndex; i < run.glyphs.size(); i++) {
+						run.glyphs[i].x -= breakX;
+						run.glyphs[i].line = nextLine;
+					}
+
+					cursorX -= breakX;
+					x -= breakX;
+				} else {
+					// No space to break at, split the word
+					lineWidths.push_back(cursorX);
+
+					cursorX = 0.F;
+					x = 0.F;
+				}
+
+				breakIndex = std::string::npos;
+			}
+
+			if (glyph->size.x > 0.F && glyph->size.y > 0.F) run.glyphs.push_back({glyph, x + glyph->offset.x, static_cast<uint32_t>(lineWidths.size())});
+			cursorX = x + glyph->advance.x;
+		}
+
+		lineWidths.push_back(cursorX);
+
+		float maxWidth = 0.F;
+		for (float width : lineWidths)
+			maxWidth = std::max(maxWidth, width);
+
+		// Align lines ---
+		const float alignWidth = wrapWidth > 0.F ? wrapWidth : maxWidth;
+		if (align != rawrbox::Alignment::Left) {
+			for (auto& glyph : run.glyphs) {
+				float space = alignWidth - lineWidths[glyph.line];
+				glyph.x += align == rawrbox::Alignment::Center ? space / 2.F : space;
+			}
+		}
+		// ---------------
+
+		run.lines = static_cast<uint32_t>(lineWidths.size());
+		run.size = {align != rawrbox::Alignment::Left ? alignWidth : maxWidth, static_cast<float>(run.lines) * font.getLineHeight()};
+
+		return run;
+	}
+
+	void TextLayout::evict(uint64_t fontID) {
+		for (auto it = _entries.begin(); it != _entries.end();) {
+			if (it->font != fontID) {
+				it++;
+				continue;
+			}
+
+			_lookup.erase(it->hash);
+			it = _entries.erase(it);
+		}
+	}
+
+	void TextLayout::clear() {
+		_lookup.clear();
+		_entries.clear();
+	}
+
+	size_t TextLayout::size() { return _entries.size(); }
+} // namespace rawrbox
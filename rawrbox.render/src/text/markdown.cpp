@@ -224,13 +224,15 @@ namespace rawrbox {
 					corrupted.push_back(letters[dist(this->_prng)]);
 				}
 
+				// Changes every frame, so don't let it into the layout cache
+				auto run = rawrbox::TextLayout::build(*elm.font, rawrbox::Font::toUTF8(corrupted));
+
 				// center text to match letter width changes
-				auto corruptedUtf8 = rawrbox::Font::toUTF8(corrupted);
 				auto midpos = curpos;
-				midpos.x += elm.size.x / 2 - elm.font->getStringSize(corruptedUtf8).x / 2;
+				midpos.x += elm.size.x / 2 - run.size.x / 2;
 
 				// draw modified text
-				stencil.drawText(*elm.font, corruptedUtf8, midpos, elm.color, rawrbox::Alignment::Left);
+				stencil.drawText(*elm.font, run, midpos, elm.color);
 			} else {
 				// draw default text
 				stencil.drawText(*elm.font, elm.text, curpos, elm.color, rawrbox::Alignment::Left);
@@ -80,6 +80,17 @@ namespace rawrbox {
 		}
 	}
 
+	Diligent::TEXTURE_FORMAT TextureBase::getCompressedFormat(rawrbox::TEXTURE_COMPRESSION compression) {
+		switch (compression) {
+			case rawrbox::TEXTURE_COMPRESSION::BC1: return this->_sRGB ? Diligent::TEX_FORMAT_BC1_UNORM_SRGB : Diligent::TEX_FORMAT_BC1_UNORM;
+			case rawrbox::TEXTURE_COMPRESSION::BC3: return this->_sRGB ? Diligent::TEX_FORMAT_BC3_UNORM_SRGB : Diligent::TEX_FORMAT_BC3_UNORM;
+			case rawrbox::TEXTURE_COMPRESSION::BC5: return Diligent::TEX_FORMAT_BC5_UNORM;
+			case rawrbox::TEXTURE_COMPRESSION::BC7: return this->_sRGB ? Diligent::TEX_FORMAT_BC7_UNORM_SRGB : Diligent::TEX_FORMAT_BC7_UNORM;
+			default:
+			case rawrbox::TEXTURE_COMPRESSION::NONE: return Diligent::TEX_FORMAT_UNKNOWN;
+		}
+	}
+
 	// UTILS ---
 	void TextureBase::setID(uint64_t id) { this->_id = id; }
 	uint64_t TextureBase::getID() const { return this->_id; }
@@ -130,6 +141,15 @@ namespace rawrbox {
 
 	void TextureBase::setSRGB(bool set) { this->_sRGB = set; }
 
+	void TextureBase::setMipMaps(bool set, rawrbox::MIP_FILTER filter) {
+		this->_mips = set;
+		this->_mipFilter = filter;
+	}
+	bool TextureBase::hasMipMaps() const { return this->_mips; }
+
+	void TextureBase::setCompression(rawrbox::TEXTURE_COMPRESSION compression) { this->_compression = compression; }
+	rawrbox::TEXTURE_COMPRESSION TextureBase::getCompression() const { return this->_compression; }
+
 	void TextureBase::setSlice(uint32_t id) { this->_slice = id; }
 	uint32_t TextureBase::getSlice() const { return this->_slice; }
 	// ----
@@ -149,6 +169,14 @@ namespace rawrbox {
 			this->_transparent = this->_data.transparent();
 		}
 
+		// Mips & compression, only for static textures using the default formats ---
+		rawrbox::ProcessedTexture processed = {};
+		if (!dynamic && (format == Diligent::TEX_FORMAT_RGBA8_UNORM || format == Diligent::TEX_FORMAT_RGBA8_UNORM_SRGB || format == Diligent::TEX_FORMAT_RG8_UNORM || format == Diligent::TEX_FORMAT_A8_UNORM)) {
+			processed = rawrbox::TextureProcessor::process(this->_data, {this->_mips, this->_mipFilter, this->_compression, format == Diligent::TEX_FORMAT_RGBA8_UNORM_SRGB});
+			if (processed.compression != rawrbox::TEXTURE_COMPRESSION::NONE) format = this->getCompressedFormat(processed.compression);
+		}
+		// ------------
+
 		Diligent::TextureDesc desc;
 		desc.Type = Diligent::RESOURCE_DIM_TEX_2D_ARRAY;
 		desc.BindFlags = Diligent::BIND_SHADER_RESOURCE;
@@ -156,7 +184,7 @@ namespace rawrbox {
 		desc.CPUAccessFlags = Diligent::CPU_ACCESS_NONE;
 		desc.Width = this->_data.size.x;
 		desc.Height = this->_data.size.y;
-		desc.MipLevels = 1;
+		desc.MipLevels = processed.empty() ? 1 : processed.mipCount;
 		desc.Format = format;
 		desc.Name = this->_name.c_str();
 
@@ -165,12 +193,27 @@ namespace rawrbox {
 		desc.ArraySize = static_cast<uint32_t>(this->_data.total());
 		// NOLINTEND(cppcoreguidelines-pro-type-union-access)
 
-		subresData.resize(desc.ArraySize);
-		for (uint32_t slice = 0; slice < subresData.size(); slice++) {
-			auto& res = subresData[slice];
-
-			res.pData = this->_data.frames[slice].pixels.data();
-			res.Stride = desc.Width * this->_data.channels;
+		// Subresources are ordered by slice, then mip
+		subresData.resize(desc.ArraySize * desc.MipLevels);
+		for (uint32_t slice = 0; slice < desc.ArraySize; slice++) {
+			for (uint32_t mip = 0; mip < desc.MipLevels; mip++) {
+				auto& res = subresData[slice * desc.MipLevels + mip];
+
+				if (processed.empty()) {
+					res.pData = this->_data.frames[slice].pixels.data();
+					res.Stride = desc.Width * this->_data.channels;
+					continue;
+				}
+
+				const auto& level = processed.slices[slice][mip];
+				res.pData = level.pixels.data();
+
+				if (processed.compression == rawrbox::TEXTURE_COMPRESSION::NONE) {
+					res.Stride = level.size.x * this->_data.channels;
+				} else {
+					res.Stride = rawrbox::BCEncoder::getRowPitch(processed.compression, level.size.x);
+				}
+			}
 		}
 
 		Diligent::TextureData data;
@@ -8,138 +8,133 @@
 #include <fmt/format.h>
 
 namespace rawrbox {
-	TexturePack::TexturePack(uint32_t size) {
+	namespace {
+		bool touches(const rawrbox::AABBu& a, const rawrbox::AABBu& b) {
+			return a.left() <= b.right() && a.right() >= b.left() && a.top() <= b.bottom() && a.bottom() >= b.top();
+		}
+
+		rawrbox::AABBu merge(const rawrbox::AABBu& a, const rawrbox::AABBu& b) {
+			const uint32_t x = std::min(a.left(), b.left());
+			const uint32_t y = std::min(a.top(), b.top());
+
+			return {x, y, std::max(a.right(), b.right()) - x, std::max(a.bottom(), b.bottom()) - y};
+		}
+
+		uint64_t area(const rawrbox::AABBu& a) {
+			return static_cast<uint64_t>(a.size.x) * a.size.y;
+		}
+	} // namespace
+
+	TexturePack::TexturePack(uint32_t size) : _packer({size, size}) {
 		this->_data.size = {size, size};
 		this->_data.channels = 4;
 		this->_data.createFrame(); // Create empty frame to be filled later
 
-		this->_root = std::make_unique<rawrbox::PackNode>(0U, 0U, size, size);
 		this->_name = "RawrBox::Texture::Pack";
 	}
 
-	TexturePack::~TexturePack() { this->_root.reset(); }
+	// PRIVATE ---
+	void TexturePack::writeSprite(const rawrbox::AABBu& rect, const std::vector<uint8_t>& data) {
+		const size_t stride = static_cast<size_t>(rect.size.x) * this->_data.channels;
+		const size_t atlasStride = static_cast<size_t>(this->_data.size.x) * this->_data.channels;
+
+		auto* dest = this->_data.pixels().data() + static_cast<size_t>(rect.top()) * atlasStride + static_cast<size_t>(rect.left()) * this->_data.channels;
+		for (size_t y = 0; y < rect.size.y; y++) {
+			if (data.empty()) {
+				std::memset(dest + y * atlasStride, 0, stride);
+			} else {
+				std::memcpy(dest + y * atlasStride, data.data() + y * stride, stride);
+			}
+		}
 
-	size_t TexturePack::getSpriteCount() const {
-		return this->_spriteCount;
+		this->markDirty(rect);
 	}
 
-	rawrbox::PackNode& TexturePack::addSprite(uint32_t width, uint32_t height, const std::vector<uint8_t>& data) {
-		if (this->_tex == nullptr) RAWRBOX_CRITICAL("Texture not bound");
-
-		auto nodeOpt = this->_root->InsertNode(width, height);
-		if (!nodeOpt.has_value()) RAWRBOX_CRITICAL("Failed to add sprite with size {}, {}", width, height);
+	void TexturePack::markDirty(const rawrbox::AABBu& rect) {
+		auto merged = rect;
 
-		auto& node = (*nodeOpt).get();
-		node.data = data; // Set the data of that node
-
-		if (!data.empty()) {
-			Diligent::Box UpdateBox;
-			UpdateBox.MinX = node.x;
-			UpdateBox.MinY = node.y;
-			UpdateBox.MaxX = node.x + node.width;
-			UpdateBox.MaxY = node.y + node.height;
-
-			for (size_t y = 0; y < node.height; y++) {
-				const auto stride = node.width * this->_data.channels;
-				const auto* start = data.data() + y * stride;
-				const auto* last = start + stride;
-
-				auto startPointY = UpdateBox.MinY + y;
-				auto startPointX = UpdateBox.MinX;
-
-				auto* dest = this->_data.pixels().data() + (startPointY * this->_data.size.x + startPointX) * this->_data.channels;
-				std::copy(start, last, dest);
+		// Merge with overlapping / adjacent regions, as long as it doesn't upload too much untouched space
+		for (size_t i = 0; i < this->_dirty.size();) {
+			const auto& dirty = this->_dirty[i];
+			if (!touches(dirty, merged)) {
+				i++;
+				continue;
 			}
 
-			if (!this->_pendingUpdate) {
-				this->_pendingUpdate = true;
-				rawrbox::BindlessManager::registerUpdateTexture(*this);
+			auto combined = merge(dirty, merged);
+			if (area(combined) * 2 > (area(dirty) + area(merged)) * 3) {
+				i++;
+				continue;
 			}
-		}
 
-		this->_spriteCount++;
-		return node;
-	}
-
-	bool TexturePack::canInsertNode(uint32_t width, uint32_t height) {
-		return this->_root->canInsertNode(width, height);
-	}
+			merged = combined;
+			this->_dirty.erase(this->_dirty.begin() + static_cast<std::ptrdiff_t>(i));
+			i = 0; // The grown region might now reach previously skipped ones
+		}
 
-	bool PackNode::canInsertNode(uint32_t insertedWidth, uint32_t insertedHeight) {
-		if (!data.empty()) return false;
+		this->_dirty.push_back(merged);
 
-		if (left && right) {
-			if (left->canInsertNode(insertedWidth, insertedHeight)) return true;
-			if (right->canInsertNode(insertedWidth, insertedHeight)) return true;
+		if (this->_dirty.size() > MAX_DIRTY_RECTS) {
+			auto all = this->_dirty.front();
+			for (const auto& dirty : this->_dirty)
+				all = merge(all, dirty);
 
-			return false;
+			this->_dirty = {all};
 		}
 
-		if (insertedWidth > width || insertedHeight > height) return false;
-		if (width == insertedWidth && height == insertedHeight) return true;
-
-		// if all of the above didn't return, the current leaf is large enough,
-		// with some space to spare, so we split up the current node so we have
-		// one prefectly fitted node and some spare nodes
-		int remainingWidth = std::max<int>(0, static_cast<int>(width) - static_cast<int>(insertedWidth));
-		int remainingHeight = std::max<int>(0, static_cast<int>(height) - static_cast<int>(insertedHeight));
+		if (!this->_pendingUpdate) {
+			this->_pendingUpdate = true;
+			rawrbox::BindlessManager::registerUpdateTexture(*this);
+		}
+	}
+	// ------
 
-		bool isRemainderWiderThanHigh = remainingWidth > remainingHeight;
+	size_t TexturePack::getSpriteCount() const {
+		return this->_packer.size();
+	}
 
-		if (isRemainderWiderThanHigh) { // if wider than high, split verticallly
-			left = std::make_unique<rawrbox::PackNode>(x, y, insertedWidth, height);
-			right = std::make_unique<rawrbox::PackNode>(x + insertedWidth, y, remainingWidth, height);
-		} else { // That'd make the remainder higher than it's wide, split horizontally
-			left = std::make_unique<rawrbox::PackNode>(x, y, width, insertedHeight);
-			right = std::make_unique<rawrbox::PackNode>(x, y + insertedHeight, width, remainingHeight);
-		}
+	float TexturePack::getOccupancy() const {
+		return this->_packer.occupancy();
+	}
 
-		return left->canInsertNode(insertedWidth, insertedHeight);
+	bool TexturePack::canInsertNode(uint32_t width, uint32_t height) const {
+		return this->_packer.canInsert(width, height);
 	}
 
-	std::optional<std::reference_wrapper<rawrbox::PackNode>> PackNode::InsertNode(uint32_t insertedWidth, uint32_t insertedHeight) {
-		if (!data.empty()) return std::nullopt;
+	rawrbox::PackNode TexturePack::addSprite(uint32_t width, uint32_t height, const std::vector<uint8_t>& data) {
+		if (this->_tex == nullptr) RAWRBOX_CRITICAL("Texture not bound");
+		if (!data.empty() && data.size() != static_cast<size_t>(width) * height * this->_data.channels) RAWRBOX_CRITICAL("Invalid sprite data size, expected {} got {}", static_cast<size_t>(width) * height * this->_data.channels, data.size());
 
-		if (left && right) {
-			// both children exist, which means this node is full, try left then right
-			if (auto node = left->InsertNode(insertedWidth, insertedHeight); node != std::nullopt) {
-				return node;
-			}
+		auto id = this->_packer.insert(width, height);
+		if (!id.has_value()) RAWRBOX_CRITICAL("Failed to add sprite with size {}, {}", width, height);
 
-			if (auto node = right->InsertNode(insertedWidth, insertedHeight); node != std::nullopt) {
-				return node;
-			}
+		if (!data.empty()) this->writeSprite(this->_packer.get(*id), data);
+		return this->getSprite(*id);
+	}
 
-			return std::nullopt;
-		}
+	void TexturePack::updateSprite(uint32_t id, const std::vector<uint8_t>& data) {
+		if (!this->_packer.valid(id)) RAWRBOX_CRITICAL("Invalid sprite id '{}'", id);
 
-		if (insertedWidth > width || insertedHeight > height) {
-			// to be insterted node is too big, can't fit here
-			return std::nullopt;
-		}
+		const auto& rect = this->_packer.get(id);
+		if (data.size() != static_cast<size_t>(rect.size.x) * rect.size.y * this->_data.channels) RAWRBOX_CRITICAL("Invalid sprite data size, expected {} got {}", static_cast<size_t>(rect.size.x) * rect.size.y * this->_data.channels, data.size());
 
-		if (width == insertedWidth && height == insertedHeight) {
-			// fits perfectly
-			return *this;
-		}
+		this->writeSprite(rect, data);
+	}
 
-		// if all of the above didn't return, the current leaf is large enough,
-		// with some space to spare, so we split up the current node so we have
-		// one prefectly fitted node and some spare nodes
-		int remainingWidth = width - insertedWidth;
-		int remainingHeight = height - insertedHeight;
+	bool TexturePack::removeSprite(uint32_t id) {
+		if (!this->_packer.valid(id)) return false;
 
-		bool isRemainderWiderThanHigh = remainingWidth > remainingHeight;
+		this->writeSprite(this->_packer.get(id), {}); // Clear it, so re-used space doesn't bleed old pixels
+		return this->_packer.remove(id);
+	}
 
-		if (isRemainderWiderThanHigh) { // if wider than high, split verticallly
-			left = std::make_unique<rawrbox::PackNode>(x, y, insertedWidth, height);
-			right = std::make_unique<rawrbox::PackNode>(x + insertedWidth, y, remainingWidth, height);
-		} else { // That'd make the remainder higher than it's wide, split horizontally
-			left = std::make_unique<rawrbox::PackNode>(x, y, width, insertedHeight);
-			right = std::make_unique<rawrbox::PackNode>(x, y + insertedHeight, width, remainingHeight);
-		}
+	rawrbox::PackNode TexturePack::getSprite(uint32_t id) const {
+		const auto& rect = this->_packer.get(id);
+		return {id, rect.pos.x, rect.pos.y, rect.size.x, rect.size.y};
+	}
 
-		return left->InsertNode(insertedWidth, insertedHeight);
+	bool TexturePack::hasSprite(uint32_t id) const {
+		return this->_packer.valid(id);
 	}
 
 	void TexturePack::upload(Diligent::TEXTURE_FORMAT format, bool /*dynamic*/) {
@@ -151,22 +146,30 @@ namespace rawrbox {
 		if (!this->_pendingUpdate) return;
 		auto* context = rawrbox::RENDERER->context();
 
-		Diligent::Box UpdateBox;
-		UpdateBox.MinX = 0;
-		UpdateBox.MinY = 0;
-		UpdateBox.MaxX = this->_data.size.x;
-		UpdateBox.MaxY = this->_data.size.y;
-
-		Diligent::TextureSubResData SubresData;
-		SubresData.Stride = this->_data.size.x * this->_data.channels;
-		SubresData.pData = this->_data.pixels().data();
+		const size_t stride = static_cast<size_t>(this->_data.size.x) * this->_data.channels;
+		const auto* pixels = this->_data.pixels().data();
 
 		// BARRIER ----
 		rawrbox::BarrierUtils::barrier({{this->_tex, Diligent::RESOURCE_STATE_SHADER_RESOURCE, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
-		context->UpdateTexture(this->_tex, 0, 0, UpdateBox, SubresData, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+		for (const auto& dirty : this->_dirty) {
+			Diligent::Box UpdateBox;
+			UpdateBox.MinX = dirty.left();
+			UpdateBox.MinY = dirty.top();
+			UpdateBox.MaxX = dirty.right();
+			UpdateBox.MaxY = dirty.bottom();
+
+			Diligent::TextureSubResData SubresData;
+			SubresData.Stride = stride;
+			SubresData.pData = pixels + static_cast<size_t>(dirty.top()) * stride + static_cast<size_t>(dirty.left()) * this->_data.channels;
+
+			context->UpdateTexture(this->_tex, 0, 0, UpdateBox, SubresData, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+		}
+
 		rawrbox::BarrierUtils::barrier({{this->_tex, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::RESOURCE_STATE_SHADER_RESOURCE, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
 		// ------------
 
+		this->_dirty.clear();
 		this->_pendingUpdate = false;
 	}
 
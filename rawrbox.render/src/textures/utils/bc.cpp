@@ -0,0 +1,365 @@
+#include <rawrbox/render/textures/utils/bc.hpp>
+#include <rawrbox/utils/logger.hpp>
+#include <rawrbox/utils/threading.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace rawrbox {
+	namespace {
+		constexpr std::array<uint32_t, 16> BC7_WEIGHTS_4 = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+		uint16_t toRGB565(const uint8_t* c) {
+			return static_cast<uint16_t>(((c[0] * 31 + 127) / 255) << 11 | ((c[1] * 63 + 127) / 255) << 5 | ((c[2] * 31 + 127) / 255));
+		}
+
+		void fromRGB565(uint16_t v, uint8_t* out) {
+			uint8_t r = (v >> 11) & 31;
+			uint8_t g = (v >> 5) & 63;
+			uint8_t b = v & 31;
+
+			out[0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+			out[1] = static_cast<uint8_t>((g << 2) | (g >> 4));
+			out[2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+		}
+
+		uint32_t colorDistance(const uint8_t* a, const uint8_t* b, size_t channels) {
+			uint32_t dist = 0;
+			for (size_t c = 0; c < channels; c++) {
+				int d = static_cast<int>(a[c]) - static_cast<int>(b[c]);
+				dist += static_cast<uint32_t>(d * d);
+			}
+
+			return dist;
+		}
+
+		// Picks the two block colors at the extremes of the principal axis (power iteration over the covariance)
+		void selectEndpoints(const uint8_t* rgba, size_t channels, std::array<uint8_t, 4>& start, std::array<uint8_t, 4>& end) {
+			std::array<float, 4> mean = {};
+			for (size_t i = 0; i < 16; i++) {
+				for (size_t c = 0; c < channels; c++)
+					mean[c] += rgba[i * 4 + c];
+			}
+
+			for (auto& m : mean)
+				m /= 16.F;
+
+			std::array<std::array<float, 4>, 4> cov = {};
+			for (size_t i = 0; i < 16; i++) {
+				for (size_t a = 0; a < channels; a++) {
+					for (size_t b = 0; b < channels; b++)
+						cov[a][b] += (rgba[i * 4 + a] - mean[a]) * (rgba[i * 4 + b] - mean[b]);
+				}
+			}
+
+			// Seeded with the highest variance channel row, a flat (1, 1, 1, 1) seed cancels out on anti-correlated channels (ex: red vs green)
+			size_t seed = 0;
+			for (size_t c = 1; c < channels; c++) {
+				if (cov[c][c] > cov[seed][seed]) seed = c;
+			}
+
+			std::array<float, 4> axis = cov[seed];
+			for (size_t iter = 0; iter < 8; iter++) {
+				std::array<float, 4> next = {};
+				float len = 0.F;
+
+				for (size_t a = 0; a < channels; a++) {
+					for (size_t b = 0; b < channels; b++)
+						next[a] += cov[a][b] * axis[b];
+
+					len = std::max(len, std::abs(next[a]));
+				}
+
+				if (len <= 0.F) break;
+				for (size_t a = 0; a < channels; a++)
+					axis[a] = next[a] / len;
+			}
+
+			float minProj = FLT_MAX;
+			float maxProj = -FLT_MAX;
+			for (size_t i = 0; i < 16; i++) {
+				float proj = 0.F;
+				for (size_t c = 0; c < channels; c++)
+					proj += (rgba[i * 4 + c] - mean[c]) * axis[c];
+
+				minProj = std::min(minProj, proj);
+				maxProj = std::max(maxProj, proj);
+			}
+
+			float axisLen = 0.F;
+			for (size_t c = 0; c < channels; c++)
+				axisLen += axis[c] * axis[c];
+
+			if (axisLen <= 0.F) axisLen = 1.F;
+			for (size_t c = 0; c < channels; c++) {
+				start[c] = static_cast<uint8_t>(std::clamp(mean[c] + axis[c] * minProj / axisLen + 0.5F, 0.F, 255.F));
+				end[c] = static_cast<uint8_t>(std::clamp(mean[c] + axis[c] * maxProj / axisLen + 0.5F, 0.F, 255.F));
+			}
+		}
+
+		class BitWriter {
+			uint8_t* _out = nullptr;
+			uint32_t _bit = 0;
+
+		public:
+			explicit BitWriter(uint8_t* out) : _out(out) { std::memset(out, 0, 16); }
+
+			void write(uint32_t value, uint32_t bits) {
+				for (uint32_t i = 0; i < bits; i++, _bit++) {
+					if (((value >> i) & 1U) != 0U) _out[_bit >> 3] |= static_cast<uint8_t>(1U << (_bit & 7U));
+				}
+			}
+		};
+	} // namespace
+
+	// PROTECTED ---
+	void BCEncoder::encodeBC1Block(const uint8_t* rgba, uint8_t* out) {
+		std::array<uint8_t, 4> start = {};
+		std::array<uint8_t, 4> end = {};
+		selectEndpoints(rgba, 3, start, end);
+
+		uint16_t c0 = toRGB565(end.data());
+		uint16_t c1 = toRGB565(start.data());
+
+		uint32_t indices = 0;
+		if (c0 != c1) {
+			if (c0 < c1) std::swap(c0, c1); // Four color mode requires c0 > c1
+
+			std::array<std::array<uint8_t, 3>, 4> palette = {};
+			fromRGB565(c0, palette[0].data());
+			fromRGB565(c1, palette[1].data());
+
+			for (size_t c = 0; c < 3; c++) {
+				palette[2][c] = static_cast<uint8_t>((2 * palette[0][c] + palette[1][c] + 1) / 3);
+				palette[3][c] = static_cast<uint8_t>((palette[0][c] + 2 * palette[1][c] + 1) / 3);
+			}
+
+			for (size_t i = 0; i < 16; i++) {
+				uint32_t best = 0;
+				uint32_t bestDist = UINT32_MAX;
+
+				for (uint32_t p = 0; p < 4; p++) {
+					uint32_t dist = colorDistance(rgba + i * 4, palette[p].data(), 3);
+					if (dist >= bestDist) continue;
+
+					bestDist = dist;
+					best = p;
+				}
+
+				indices |= best << (i * 2);
+			}
+		}
+
+		std::memcpy(out, &c0, 2);
+		std::memcpy(out + 2, &c1, 2);
+		std::memcpy(out + 4, &indices, 4);
+	}
+
+	void BCEncoder::encodeBC4Block(const uint8_t* rgba, uint8_t channel, uint8_t* out) {
+		uint8_t min = 255;
+		uint8_t max = 0;
+
+		for (size_t i = 0; i < 16; i++) {
+			min = std::min(min, rgba[i * 4 + channel]);
+			max = std::max(max, rgba[i * 4 + channel]);
+		}
+
+		out[0] = max;
+		out[1] = min;
+
+		uint64_t indices = 0;
+		if (max != min) {
+			// Eight value mode (a0 > a1): 0 = a0, 1 = a1, 2..7 = interpolated from a0 to a1
+			std::array<uint8_t, 8> palette = {max, min};
+			for (uint32_t p = 1; p < 7; p++) {
+				palette[p + 1] = static_cast<uint8_t>(((7 - p) * max + p * min + 3) / 7);
+			}
+
+			for (size_t i = 0; i < 16; i++) {
+				uint8_t v = rgba[i * 4 + channel];
+
+				uint64_t best = 0;
+				int bestDist = INT32_MAX;
+				for (uint64_t p = 0; p < 8; p++) {
+					int dist = std::abs(static_cast<int>(v) - static_cast<int>(palette[p]));
+					if (dist >= bestDist) continue;
+
+					bestDist = dist;
+					best = p;
+				}
+
+				indices |= best << (i * 3);
+			}
+		}
+
+		for (size_t b = 0; b < 6; b++) {
+			out[2 + b] = static_cast<uint8_t>((indices >> (b * 8)) & 0xFF);
+		}
+	}
+
+	void BCEncoder::encodeBC7Block(const uint8_t* rgba, uint8_t* out) {
+		// Mode 6: one subset, RGBA 7.7.7.7 endpoints with a unique p-bit each, 4 bit indices
+		std::array<uint8_t, 4> start = {};
+		std::array<uint8_t, 4> end = {};
+		selectEndpoints(rgba, 4, start, end);
+
+		// Quantize both endpoints, picking the p-bit that best matches the original values
+		auto quantize = [](const std::array<uint8_t, 4>& color, std::array<uint8_t, 4>& quant, uint8_t& pbit, std::array<uint8_t, 4>& expanded) {
+			uint32_t bestErr = UINT32_MAX;
+
+			for (uint8_t p = 0; p < 2; p++) {
+				std::array<uint8_t, 4> q = {};
+				std::array<uint8_t, 4> e = {};
+				uint32_t err = 0;
+
+				for (size_t c = 0; c < 4; c++) {
+					int v = std::clamp((static_cast<int>(color[c]) - p + 1) >> 1, 0, 127);
+					q[c] = static_cast<uint8_t>(v);
+					e[c] = static_cast<uint8_t>((v << 1) | p);
+
+					int d = static_cast<int>(color[c]) - static_cast<int>(e[c]);
+					err += static_cast<uint32_t>(d * d);
+				}
+
+				if (err >= bestErr) continue;
+				bestErr = err;
+				quant = q;
+				expanded = e;
+				pbit = p;
+			}
+		};
+
+		std::array<uint8_t, 4> q0 = {};
+		std::array<uint8_t, 4> q1 = {};
+		std::array<uint8_t, 4> e0 = {};
+		std::array<uint8_t, 4> e1 = {};
+		uint8_t p0 = 0;
+		uint8_t p1 = 0;
+
+		quantize(start, q0, p0, e0);
+		quantize(end, q1, p1, e1);
+
+		std::array<std::array<uint8_t, 4>, 16> palette = {};
+		for (size_t p = 0; p < 16; p++) {
+			for (size_t c = 0; c < 4; c++) {
+				palette[p][c] = static_cast<uint8_t>(((64 - BC7_WEIGHTS_4[p]) * e0[c] + BC7_WEIGHTS_4[p] * e1[c] + 32) >> 6);
+			}
+		}
+
+		std::array<uint8_t, 16> indices = {};
+		for (size_t i = 0; i < 16; i++) {
+			uint32_t bestDist = UINT32_MAX;
+			for (uint8_t p = 0; p < 16; p++) {
+				uint32_t dist = colorDistance(rgba + i * 4, palette[p].data(), 4);
+				if (dist >= bestDist) continue;
+
+				bestDist = dist;
+				indices[i] = p;
+			}
+		}
+
+		// The anchor index MSB is implicit (must be 0), swap the endpoints if needed
+		if (indices[0] >= 8) {
+			std::swap(q0, q1);
+			std::swap(p0, p1);
+
+			for (auto& idx : indices)
+				idx = static_cast<uint8_t>(15 - idx);
+		}
+
+		BitWriter writer(out);
+		writer.write(1U << 6, 7); // Mode 6
+
+		for (size_t c = 0; c < 4; c++) {
+			writer.write(q0[c], 7);
+			writer.write(q1[c], 7);
+		}
+
+		writer.write(p0, 1);
+		writer.write(p1, 1);
+
+		writer.write(indices[0], 3);
+		for (size_t i = 1; i < 16; i++) {
+			writer.write(indices[i], 4);
+		}
+	}
+	// ------
+
+	uint32_t BCEncoder::getBlockSize(rawrbox::TEXTURE_COMPRESSION compression) {
+		switch (compression) {
+			case TEXTURE_COMPRESSION::BC1: return 8;
+			case TEXTURE_COMPRESSION::BC3:
+			case TEXTURE_COMPRESSION::BC5:
+			case TEXTURE_COMPRESSION::BC7: return 16;
+			default:
+			case TEXTURE_COMPRESSION::NONE: return 0;
+		}
+	}
+
+	uint32_t BCEncoder::getRowPitch(rawrbox::TEXTURE_COMPRESSION compression, uint32_t width) {
+		return ((width + 3) / 4) * getBlockSize(compression);
+	}
+
+	size_t BCEncoder::getEncodedSize(rawrbox::TEXTURE_COMPRESSION compression, const rawrbox::Vector2u& size) {
+		return static_cast<size_t>(getRowPitch(compression, size.x)) * ((size.y + 3) / 4);
+	}
+
+	std::vector<uint8_t> BCEncoder::encode(rawrbox::TEXTURE_COMPRESSION compression, const uint8_t* pixels, const rawrbox::Vector2u& size, uint8_t channels) {
+		if (compression == TEXTURE_COMPRESSION::NONE) RAWRBOX_CRITICAL("Invalid compression mode");
+		if (pixels == nullptr || channels == 0U || channels > 4U) RAWRBOX_CRITICAL("Invalid pixel data");
+
+		const uint32_t blocksX = (size.x + 3) / 4;
+		const uint32_t blocksY = (size.y + 3) / 4;
+		const uint32_t blockSize = getBlockSize(compression);
+
+		std::vector<uint8_t> out(getEncodedSize(compression, size));
+
+		// Each row of blocks is independent
+		rawrbox::ASYNC::loop(0, blocksY, [&](size_t by) {
+			std::array<uint8_t, 16 * 4> block = {};
+
+			for (uint32_t bx = 0; bx < blocksX; bx++) {
+				// Gather the 4x4 block as RGBA, clamping on the edges
+				for (uint32_t py = 0; py < 4; py++) {
+					uint32_t y = std::min(static_cast<uint32_t>(by) * 4 + py, size.y - 1);
+
+					for (uint32_t px = 0; px < 4; px++) {
+						uint32_t x = std::min(bx * 4 + px, size.x - 1);
+
+						const uint8_t* src = pixels + (static_cast<size_t>(y) * size.x + x) * channels;
+						uint8_t* dst = block.data() + (py * 4 + px) * 4;
+
+						dst[0] = src[0];
+						dst[1] = channels > 1 ? src[1] : src[0];
+						dst[2] = channels > 2 ? src[2] : src[0];
+						dst[3] = channels > 3 ? src[3] : 255;
+					}
+				}
+
+				uint8_t* dst = out.data() + (by * blocksX + bx) * blockSize;
+				switch (compression) {
+					case TEXTURE_COMPRESSION::BC1:
+						encodeBC1Block(block.data(), dst);
+						break;
+					case TEXTURE_COMPRESSION::BC3:
+						encodeBC4Block(block.data(), 3, dst);
+						encodeBC1Block(block.data(), dst + 8);
+						break;
+					case TEXTURE_COMPRESSION::BC5:
+						encodeBC4Block(block.data(), 0, dst);
+						encodeBC4Block(block.data(), 1, dst + 8);
+						break;
+					case TEXTURE_COMPRESSION::BC7:
+						encodeBC7Block(block.data(), dst);
+						break;
+					default: break;
+				}
+			}
+		});
+
+		return out;
+	}
+} // namespace rawrbox
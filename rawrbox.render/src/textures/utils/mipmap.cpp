@@ -0,0 +1,308 @@
+#include <rawrbox/render/textures/utils/mipmap.hpp>
+#include <rawrbox/utils/threading.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <numbers>
+
+namespace rawrbox {
+	namespace {
+		constexpr int KAISER_RADIUS = 3; // In destination pixels
+		constexpr float KAISER_ALPHA = 4.F;
+		constexpr size_t KAISER_TAPS = KAISER_RADIUS * 4;
+
+		constexpr size_t SRGB_LUT_SIZE = 4096;
+
+		const std::array<float, 256>& toLinearLUT() {
+			static const std::array<float, 256> lut = []() {
+				std::array<float, 256> ret = {};
+				for (size_t i = 0; i < ret.size(); i++) {
+					float c = static_cast<float>(i) / 255.F;
+					ret[i] = c <= 0.04045F ? c / 12.92F : std::pow((c + 0.055F) / 1.055F, 2.4F);
+				}
+
+				return ret;
+			}();
+
+			return lut;
+		}
+
+		const std::array<uint8_t, SRGB_LUT_SIZE>& fromLinearLUT() {
+			static const std::array<uint8_t, SRGB_LUT_SIZE> lut = []() {
+				std::array<uint8_t, SRGB_LUT_SIZE> ret = {};
+				for (size_t i = 0; i < ret.size(); i++) {
+					float l = static_cast<float>(i) / static_cast<float>(SRGB_LUT_SIZE - 1);
+					float c = l <= 0.0031308F ? l * 12.92F : 1.055F * std::pow(l, 1.F / 2.4F) - 0.055F;
+					ret[i] = static_cast<uint8_t>(std::clamp(c * 255.F + 0.5F, 0.F, 255.F));
+				}
+
+				return ret;
+			}();
+
+			return lut;
+		}
+
+		float besselI0(float x) {
+			float sum = 1.F;
+			float term = 1.F;
+			float halfX = x * 0.5F;
+
+			for (int k = 1; k < 32; k++) {
+				term *= (halfX / static_cast<float>(k)) * (halfX / static_cast<float>(k));
+				sum += term;
+				if (term < sum * 1e-8F) break;
+			}
+
+			return sum;
+		}
+
+		// Weights for a 2:1 reduction, the destination center always lands between two source pixels so they are shared by every pixel
+		const std::array<float, KAISER_TAPS>& kaiserWeights() {
+			static const std::array<float, KAISER_TAPS> weights = []() {
+				std::array<float, KAISER_TAPS> ret = {};
+
+				float total = 0.F;
+				for (size_t i = 0; i < KAISER_TAPS; i++) {
+					float d = (static_cast<float>(i) - static_cast<float>(KAISER_TAPS / 2) + 0.5F) * 0.5F; // Distance in destination pixels
+					float t = d / static_cast<float>(KAISER_RADIUS);
+
+					float sinc = d == 0.F ? 1.F : std::sin(std::numbers::pi_v<float> * d) / (std::numbers::pi_v<float> * d);
+					float window = besselI0(KAISER_ALPHA * std::sqrt(std::max(0.F, 1.F - t * t))) / besselI0(KAISER_ALPHA);
+
+					ret[i] = sinc * window;
+					total += ret[i];
+				}
+
+				for (auto& w : ret)
+					w /= total;
+
+				return ret;
+			}();
+
+			return weights;
+		}
+
+		// Source pixels under a destination one, weighted by how much of them it covers
+		// Odd sizes don't halve evenly (ex: 5 -> 2 covers 2.5 pixels each), so the last row / column is split instead of dropped
+		struct BoxTaps {
+			size_t first = 0;
+			uint32_t count = 0;
+			std::array<float, 4> weights = {};
+		};
+
+		std::vector<BoxTaps> boxTaps(uint32_t srcSize, uint32_t dstSize) {
+			std::vector<BoxTaps> taps(dstSize);
+			const double scale = static_cast<double>(srcSize) / static_cast<double>(dstSize);
+
+			for (size_t x = 0; x < dstSize; x++) {
+				const double start = static_cast<double>(x) * scale;
+				const double end = static_cast<double>(x + 1) * scale;
+
+				auto& tap = taps[x];
+				tap.first = std::min<size_t>(static_cast<size_t>(start), srcSize - 1);
+
+				for (size_t i = tap.first; i < srcSize && static_cast<double>(i) < end && tap.count < tap.weights.size(); i++) {
+					const double covered = std::min(end, static_cast<double>(i + 1)) - std::max(start, static_cast<double>(i));
+					tap.weights[tap.count++] = static_cast<float>(covered / scale);
+				}
+			}
+
+			return taps;
+		}
+
+		bool isColorChannel(uint8_t channel, uint8_t channels, bool sRGB) {
+			return sRGB && channels >= 3 && channel < 3;
+		}
+	} // namespace
+
+	// PROTECTED ---
+	void MipMapUtils::toLinear(const uint8_t* pixels, std::vector<float>& out, const rawrbox::Vector2u& size, uint8_t channels, bool sRGB) {
+		const auto& lut = toLinearLUT();
+		const size_t rowSize = static_cast<size_t>(size.x) * channels;
+
+		out.resize(rowSize * size.y);
+		rawrbox::ASYNC::loop(0, size.y, [&](size_t y) {
+			const uint8_t* src = pixels + y * rowSize;
+			float* dst = out.data() + y * rowSize;
+
+			for (size_t i = 0; i < rowSize; i++) {
+				auto c = static_cast<uint8_t>(i % channels);
+				dst[i] = isColorChannel(c, channels, sRGB) ? lut[src[i]] : static_cast<float>(src[i]) / 255.F;
+			}
+		});
+	}
+
+	void MipMapUtils::fromLinear(const std::vector<float>& pixels, std::vector<uint8_t>& out, const rawrbox::Vector2u& size, uint8_t channels, bool sRGB) {
+		const auto& lut = fromLinearLUT();
+		const size_t rowSize = static_cast<size_t>(size.x) * channels;
+
+		out.resize(rowSize * size.y);
+		rawrbox::ASYNC::loop(0, size.y, [&](size_t y) {
+			const float* src = pixels.data() + y * rowSize;
+			uint8_t* dst = out.data() + y * rowSize;
+
+			for (size_t i = 0; i < rowSize; i++) {
+				float v = std::clamp(src[i], 0.F, 1.F);
+				auto c = static_cast<uint8_t>(i % channels);
+
+				if (isColorChannel(c, channels, sRGB)) {
+					dst[i] = lut[static_cast<size_t>(v * static_cast<float>(SRGB_LUT_SIZE - 1) + 0.5F)];
+				} else {
+					dst[i] = static_cast<uint8_t>(v * 255.F + 0.5F);
+				}
+			}
+		});
+	}
+
+	void MipMapUtils::downsampleBox(const std::vector<float>& src, const rawrbox::Vector2u& srcSize, std::vector<float>& dst, const rawrbox::Vector2u& dstSize, uint8_t channels) {
+		dst.resize(static_cast<size_t>(dstSize.x) * dstSize.y * channels);
+
+		const size_t srcRow = static_cast<size_t>(srcSize.x) * channels;
+		const size_t dstRow = static_cast<size_t>(dstSize.x) * channels;
+
+		// Even sizes, plain 2x2 average
+		if (srcSize.x == dstSize.x * 2 && srcSize.y == dstSize.y * 2) {
+			rawrbox::ASYNC::loop(0, dstSize.y, [&](size_t y) {
+				const float* row0 = src.data() + y * 2 * srcRow;
+				const float* row1 = row0 + srcRow;
+				float* out = dst.data() + y * dstRow;
+
+				for (size_t x = 0; x < dstSize.x; x++) {
+					const size_t x0 = x * 2 * channels;
+					const size_t x1 = x0 + channels;
+
+					for (size_t c = 0; c < channels; c++) {
+						out[x * channels + c] = (row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c]) * 0.25F;
+					}
+				}
+			});
+
+			return;
+		}
+
+		const auto tapsX = boxTaps(srcSize.x, dstSize.x);
+		const auto tapsY = boxTaps(srcSize.y, dstSize.y);
+
+		rawrbox::ASYNC::loop(0, dstSize.y, [&](size_t y) {
+			const auto& tapY = tapsY[y];
+			float* out = dst.data() + y * dstRow;
+
+			std::fill(out, out + dstRow, 0.F);
+
+			for (uint32_t r = 0; r < tapY.count; r++) {
+				const float* row = src.data() + (tapY.first + r) * srcRow;
+				const float wy = tapY.weights[r];
+
+				for (size_t x = 0; x < dstSize.x; x++) {
+					const auto& tapX = tapsX[x];
+
+					for (uint32_t t = 0; t < tapX.count; t++) {
+						const float* in = row + (tapX.first + t) * channels;
+						const float w = wy * tapX.weights[t];
+
+						for (size_t c = 0; c < channels; c++) {
+							out[x * channels + c] += in[c] * w;
+						}
+					}
+				}
+			}
+		});
+	}
+
+	void MipMapUtils::downsampleKaiser(const std::vector<float>& src, const rawrbox::Vector2u& srcSize, std::vector<float>& dst, const rawrbox::Vector2u& dstSize, uint8_t channels) {
+		const auto& weights = kaiserWeights();
+		constexpr auto half = static_cast<int64_t>(KAISER_TAPS / 2);
+
+		// Horizontal pass (srcSize.y rows of dstSize.x pixels) ---
+		std::vector<float> tmp(static_cast<size_t>(dstSize.x) * srcSize.y * channels);
+		rawrbox::ASYNC::loop(0, srcSize.y, [&](size_t y) {
+			const float* in = src.data() + y * srcSize.x * channels;
+			float* out = tmp.data() + y * dstSize.x * channels;
+
+			if (srcSize.x == dstSize.x) {
+				std::copy(in, in + static_cast<size_t>(srcSize.x) * channels, out);
+				return;
+			}
+
+			for (size_t x = 0; x < dstSize.x; x++) {
+				const int64_t start = static_cast<int64_t>(x * 2) - half + 1;
+
+				for (size_t c = 0; c < channels; c++) {
+					float sum = 0.F;
+					for (size_t t = 0; t < KAISER_TAPS; t++) {
+						auto sx = static_cast<size_t>(std::clamp<int64_t>(start + static_cast<int64_t>(t), 0, srcSize.x - 1));
+						sum += in[sx * channels + c] * weights[t];
+					}
+
+					out[x * channels + c] = sum;
+				}
+			}
+		});
+		// ---
+
+		// Vertical pass ---
+		const size_t dstRow = static_cast<size_t>(dstSize.x) * channels;
+
+		dst.resize(dstRow * dstSize.y);
+		rawrbox::ASYNC::loop(0, dstSize.y, [&](size_t y) {
+			float* out = dst.data() + y * dstRow;
+
+			if (srcSize.y == dstSize.y) {
+				std::copy(tmp.data() + y * dstRow, tmp.data() + (y + 1) * dstRow, out);
+				return;
+			}
+
+			std::fill(out, out + dstRow, 0.F);
+
+			const int64_t start = static_cast<int64_t>(y * 2) - half + 1;
+			for (size_t t = 0; t < KAISER_TAPS; t++) {
+				auto sy = static_cast<size_t>(std::clamp<int64_t>(start + static_cast<int64_t>(t), 0, srcSize.y - 1));
+				const float* in = tmp.data() + sy * dstRow;
+				const float w = weights[t];
+
+				for (size_t i = 0; i < dstRow; i++) {
+					out[i] += in[i] * w;
+				}
+			}
+		});
+		// ---
+	}
+	// -------
+
+	uint32_t MipMapUtils::getMipCount(const rawrbox::Vector2u& size) {
+		return static_cast<uint32_t>(std::bit_width(std::max(size.x, size.y)));
+	}
+
+	std::vector<rawrbox::MipLevel> MipMapUtils::generate(const uint8_t* pixels, const rawrbox::Vector2u& size, uint8_t channels, bool sRGB, rawrbox::MIP_FILTER filter) {
+		std::vector<rawrbox::MipLevel> levels = {};
+		if (pixels == nullptr || channels == 0U || size.x == 0U || size.y == 0U) return levels;
+
+		const uint32_t total = getMipCount(size);
+		levels.resize(total - 1);
+
+		std::vector<float> current = {};
+		std::vector<float> next = {};
+
+		toLinear(pixels, current, size, channels, sRGB);
+
+		rawrbox::Vector2u currentSize = size;
+		for (auto& level : levels) {
+			level.size = {std::max(currentSize.x / 2U, 1U), std::max(currentSize.y / 2U, 1U)};
+
+			if (filter == rawrbox::MIP_FILTER::KAISER) {
+				downsampleKaiser(current, currentSize, next, level.size, channels);
+			} else {
+				downsampleBox(current, currentSize, next, level.size, channels);
+			}
+
+			fromLinear(next, level.pixels, level.size, channels, sRGB);
+
+			std::swap(current, next);
+			currentSize = level.size;
+		}
+
+		return levels;
+	}
+} // namespace rawrbox
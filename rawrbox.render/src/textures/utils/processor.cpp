@@ -0,0 +1,200 @@
+#include <rawrbox/render/textures/base.hpp>
+#include <rawrbox/render/textures/utils/processor.hpp>
+#include <rawrbox/utils/crc.hpp>
+#include <rawrbox/utils/file.hpp>
+#include <rawrbox/utils/threading.hpp>
+
+#include <magic_enum.hpp>
+
+#include <fmt/format.h>
+
+#include <array>
+#include <chrono>
+#include <cstring>
+
+namespace rawrbox {
+	namespace {
+		constexpr uint32_t CACHE_MAGIC = 0x43544252; // RBTC
+		constexpr uint32_t CACHE_VERSION = 1;
+
+		struct CacheHeader {
+			uint32_t magic = CACHE_MAGIC;
+			uint32_t version = CACHE_VERSION;
+			uint32_t crc = 0;
+			uint32_t compression = 0;
+			uint32_t mipCount = 0;
+			uint32_t sliceCount = 0;
+		};
+
+		struct CacheLevel {
+			uint32_t width = 0;
+			uint32_t height = 0;
+			uint32_t size = 0;
+		};
+	} // namespace
+
+	// PRIVATE ---
+	std::unique_ptr<rawrbox::Logger> TextureProcessor::_logger = std::make_unique<rawrbox::Logger>("RawrBox-TextureProcessor");
+	// ----------
+
+	// PUBLIC ---
+	std::filesystem::path TextureProcessor::CACHE_PATH = "./cache/textures";
+	// ----------
+
+	uint32_t TextureProcessor::getCRC(const rawrbox::ImageData& data) {
+		static const CRC::Table<uint32_t, 32> table(CRC::CRC_32());
+
+		std::array<uint32_t, 3> info = {data.size.x, data.size.y, data.channels};
+		uint32_t crc = CRC::Calculate(info.data(), info.size() * sizeof(uint32_t), table);
+
+		for (const auto& frame : data.frames) {
+			crc = CRC::Calculate(frame.pixels.data(), frame.pixels.size(), table, crc);
+		}
+
+		return crc;
+	}
+
+	std::filesystem::path TextureProcessor::getCachePath(uint32_t crc, const rawrbox::TextureProcessSettings& settings) {
+		std::string_view mips = settings.mips ? magic_enum::enum_name(settings.filter) : "NOMIPS";
+		return CACHE_PATH / fmt::format("{:08x}_{}_{}{}.rbtex", crc, magic_enum::enum_name(settings.compression), mips, settings.sRGB ? "_SRGB" : "");
+	}
+
+	bool TextureProcessor::loadCache(const std::filesystem::path& path, uint32_t crc, const rawrbox::ImageData& data, rawrbox::ProcessedTexture& out) {
+		if (!std::filesystem::exists(path)) return false;
+
+		auto raw = rawrbox::FileUtils::getRawData(path);
+		size_t offset = 0;
+
+		auto read = [&raw, &offset](void* dst, size_t size) {
+			if (offset + size > raw.size()) return false;
+
+			std::memcpy(dst, raw.data() + offset, size);
+			offset += size;
+			return true;
+		};
+
+		CacheHeader header = {};
+		if (!read(&header, sizeof(CacheHeader))) return false;
+		if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION || header.crc != crc) return false;
+		if (header.sliceCount != data.total() || header.mipCount == 0) return false;
+
+		out.compression = static_cast<rawrbox::TEXTURE_COMPRESSION>(header.compression);
+		out.mipCount = header.mipCount;
+		out.slices.resize(header.sliceCount);
+
+		for (auto& slice : out.slices) {
+			slice.resize(header.mipCount);
+
+			for (auto& level : slice) {
+				CacheLevel info = {};
+				if (!read(&info, sizeof(CacheLevel))) return false;
+
+				level.size = {info.width, info.height};
+				level.pixels.resize(info.size);
+				if (!read(level.pixels.data(), info.size)) return false;
+			}
+		}
+
+		return true;
+	}
+
+	void TextureProcessor::saveCache(const std::filesystem::path& path, uint32_t crc, const rawrbox::ProcessedTexture& processed) {
+		std::vector<uint8_t> raw = {};
+
+		auto write = [&raw](const void* src, size_t size) {
+			const auto* bytes = static_cast<const uint8_t*>(src);
+			raw.insert(raw.end(), bytes, bytes + size);
+		};
+
+		CacheHeader header = {};
+		header.crc = crc;
+		header.compression = static_cast<uint32_t>(processed.compression);
+		header.mipCount = processed.mipCount;
+		header.sliceCount = static_cast<uint32_t>(processed.slices.size());
+		write(&header, sizeof(CacheHeader));
+
+		for (const auto& slice : processed.slices) {
+			for (const auto& level : slice) {
+				CacheLevel info = {level.size.x, level.size.y, static_cast<uint32_t>(level.pixels.size())};
+
+				write(&info, sizeof(CacheLevel));
+				write(level.pixels.data(), level.pixels.size());
+			}
+		}
+
+		std::error_code ec;
+		std::filesystem::create_directories(path.parent_path(), ec);
+		if (ec || !rawrbox::FileUtils::saveData(path, raw)) {
+			_logger->warn("Failed to write texture cache '{}'", path.generic_string());
+		}
+	}
+
+	bool TextureProcessor::canCompress(rawrbox::TEXTURE_COMPRESSION compression, const rawrbox::ImageData& data) {
+		if (compression == rawrbox::TEXTURE_COMPRESSION::NONE) return false;
+		if (data.size.x % 4 != 0 || data.size.y % 4 != 0) return false; // Top level must be a multiple of the block size
+
+		if (compression == rawrbox::TEXTURE_COMPRESSION::BC5) return data.channels >= 2U;
+		return data.channels == 4U;
+	}
+
+	rawrbox::ProcessedTexture TextureProcessor::process(const rawrbox::ImageData& data, const rawrbox::TextureProcessSettings& settings) {
+		rawrbox::ProcessedTexture processed = {};
+		if (!data.valid() || data.empty()) return processed;
+
+		auto compression = canCompress(settings.compression, data) ? settings.compression : rawrbox::TEXTURE_COMPRESSION::NONE;
+		if (!settings.mips && compression == rawrbox::TEXTURE_COMPRESSION::NONE) return processed;
+
+		// Check the cache first ---
+		std::filesystem::path cachePath = {};
+		uint32_t crc = 0;
+
+		if (compression != rawrbox::TEXTURE_COMPRESSION::NONE && !CACHE_PATH.empty()) {
+			crc = getCRC(data);
+			cachePath = getCachePath(crc, {settings.mips, settings.filter, compression, settings.sRGB});
+			if (loadCache(cachePath, crc, data, processed)) return processed;
+
+			processed = {};
+		}
+		// ----
+
+		auto start = std::chrono::steady_clock::now();
+
+		processed.compression = compression;
+		processed.mipCount = settings.mips ? rawrbox::MipMapUtils::getMipCount(data.size) : 1U;
+		processed.slices.resize(data.total());
+
+		// Generate the mips, slices are independent ---
+		rawrbox::ASYNC::loop(0, data.total(), [&](size_t i) {
+			const auto& frame = data.frames[i];
+			auto& slice = processed.slices[i];
+
+			slice.reserve(processed.mipCount);
+			slice.push_back({data.size, frame.pixels});
+
+			if (!settings.mips) return;
+
+			auto levels = rawrbox::MipMapUtils::generate(frame.pixels.data(), data.size, data.channels, settings.sRGB, settings.filter);
+			std::move(levels.begin(), levels.end(), std::back_inserter(slice));
+		});
+		// ----
+
+		// Encode every (slice, mip) pair ---
+		if (compression != rawrbox::TEXTURE_COMPRESSION::NONE) {
+			const size_t mips = processed.mipCount;
+
+			rawrbox::ASYNC::loop(0, processed.slices.size() * mips, [&](size_t i) {
+				auto& level = processed.slices[i / mips][i % mips];
+				level.pixels = rawrbox::BCEncoder::encode(compression, level.pixels.data(), level.size, data.channels);
+			});
+
+			auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+			auto mpixels = static_cast<double>(data.size.x) * data.size.y * static_cast<double>(data.total()) / 1000000.0;
+			_logger->debug("Encoded {}x{} ({} slices, {} mips) to {} in {}ms ({:.2f} MPixels/s)", data.size.x, data.size.y, data.total(), mips, magic_enum::enum_name(compression), elapsed / 1000.0, mpixels / (static_cast<double>(std::max<int64_t>(elapsed, 1)) / 1000000.0));
+
+			if (!cachePath.empty()) saveCache(cachePath, crc, processed);
+		}
+		// ----
+
+		return processed;
+	}
+} // namespace rawrbox
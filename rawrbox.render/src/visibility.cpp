@@ -0,0 +1,235 @@
+#include <rawrbox/math/frustum.hpp>
+#include <rawrbox/render/visibility.hpp>
+#include <rawrbox/utils/profiler.hpp>
+#include <rawrbox/utils/threading.hpp>
+
+#include <algorithm>
+#include <array>
+#include <thread>
+
+namespace rawrbox {
+	namespace {
+		constexpr size_t CHUNK_SIZE = 4096;
+	} // namespace
+
+	// PUBLIC ----
+	size_t Visibility::MAX_IDLE_CULLS = 120;
+	// -----------
+
+	// PRIVATE ----
+	void Visibility::updateTree() {
+		if (this->_rebuild) {
+			this->_bounds.clear();
+			this->_bounds.reserve(this->_objects.size());
+
+			for (const auto& object : this->_objects) {
+				this->_bounds.push_back(object.bbox);
+			}
+
+			this->_bvh.build(this->_bounds);
+		} else if (this->_refit) {
+			this->_bvh.refit(this->_bounds);
+		}
+
+		this->_rebuild = false;
+		this->_refit = false;
+	}
+
+	void Visibility::pruneVisible() {
+		for (auto cam = this->_visible.begin(); cam != this->_visible.end();) {
+			std::erase_if(cam->second, [this](const auto& list) { return this->_cullCount - list.second.lastCull > MAX_IDLE_CULLS; });
+
+			if (cam->second.empty()) {
+				cam = this->_visible.erase(cam);
+			} else {
+				cam++;
+			}
+		}
+	}
+
+	void Visibility::occlusionPass(const rawrbox::Vector3f& eye, const rawrbox::Matrix4x4& viewProj, std::vector<uint32_t>& dense) {
+		RAWRBOX_PROFILE_ZONE("Visibility::occlusion");
+		const auto& objects = this->_objects.data();
+
+		// Closest occluders first, they hide the most
+		std::vector<std::pair<float, uint32_t>> occluders = {};
+		for (auto index : dense) {
+			const auto& object = objects[index];
+			if (!object.occluder) continue;
+
+			const rawrbox::Vector3f center = (object.bbox.min + object.bbox.max) / 2.F;
+			occluders.emplace_back(center.distance(eye), index);
+		}
+
+		if (occluders.empty()) return;
+
+		const size_t count = std::min(occluders.size(), this->_maxOccluders);
+		std::ranges::partial_sort(occluders, occluders.begin() + static_cast<std::ptrdiff_t>(count));
+		occluders.resize(count);
+
+		this->_occlusionBuffer.begin(viewProj);
+		for (const auto& occluder : occluders) {
+			this->_occlusionBuffer.addOccluder(objects[occluder.second].bbox);
+		}
+
+		// The buffer is read only from here, test in parallel
+		std::vector<uint8_t> keep(dense.size(), 1);
+		const size_t chunks = (dense.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+		rawrbox::ASYNC::loop(0, chunks, [this, &dense, &keep, &objects](size_t chunk) {
+			const size_t end = std::min(dense.size(), (chunk + 1) * CHUNK_SIZE);
+			for (size_t i = chunk * CHUNK_SIZE; i < end; i++) {
+				const auto& object = objects[dense[i]];
+				if (object.occluder) continue; // Would hide itself
+
+				keep[i] = static_cast<uint8_t>(this->_occlusionBuffer.isVisible(object.bbox));
+			}
+		});
+
+		size_t write = 0;
+		for (size_t i = 0; i < dense.size(); i++) {
+			if (keep[i] != 0) dense[write++] = dense[i];
+		}
+
+		dense.resize(write);
+	}
+	// ------------
+
+	rawrbox::BBOX Visibility::toWorld(const rawrbox::BBOX& bbox, const rawrbox::Matrix4x4& matrix) {
+		rawrbox::Vector3f min = matrix.mulVec(bbox.min);
+		rawrbox::Vector3f max = min;
+
+		for (size_t i = 1; i < 8; i++) {
+			const rawrbox::Vector3f corner = {
+			    (i & 4U) != 0 ? bbox.max.x : bbox.min.x,
+			    (i & 2U) != 0 ? bbox.max.y : bbox.min.y,
+			    (i & 1U) != 0 ? bbox.max.z : bbox.min.z};
+
+			const rawrbox::Vector3f pos = matrix.mulVec(corner);
+			min = {std::min(min.x, pos.x), std::min(min.y, pos.y), std::min(min.z, pos.z)};
+			max = {std::max(max.x, pos.x), std::max(max.y, pos.y), std::max(max.z, pos.z)};
+		}
+
+		return {min, max, max - min};
+	}
+
+	// OBJECTS ---
+	uint32_t Visibility::add(const rawrbox::VisibilityObject& object) {
+		this->_rebuild = true;
+		return this->_objects.insert(object);
+	}
+
+	void Visibility::update(uint32_t handle, const rawrbox::BBOX& bbox) {
+		if (!this->_objects.valid(handle)) RAWRBOX_CRITICAL("Invalid visibility handle '{}'", handle);
+
+		const uint32_t index = this->_objects.indexOf(handle);
+		this->_objects.data()[index].bbox = bbox;
+
+		if (this->_rebuild) return; // Rebuilt anyway
+		this->_bounds[index] = bbox;
+		this->_refit = true;
+	}
+
+	void Visibility::remove(uint32_t handle) {
+		if (!this->_objects.valid(handle)) return;
+
+		this->_objects.remove(handle);
+		this->_rebuild = true; // The last object took its place, indices changed
+	}
+
+	void Visibility::clear() {
+		this->_objects.clear();
+		this->_bounds.clear();
+		this->_bvh.clear();
+		this->_visible.clear();
+		this->_cullCount = 0;
+
+		this->_rebuild = false;
+		this->_refit = false;
+	}
+
+	bool Visibility::valid(uint32_t handle) const { return this->_objects.valid(handle); }
+	const rawrbox::VisibilityObject& Visibility::get(uint32_t handle) const { return this->_objects.get(handle); }
+	size_t Visibility::size() const { return this->_objects.size(); }
+	// ---
+
+	// OCCLUSION ---
+	void Visibility::setOcclusion(bool enabled, size_t maxOccluders) {
+		this->_occlusion = enabled;
+		this->_maxOccluders = maxOccluders;
+	}
+
+	bool Visibility::isOcclusionEnabled() const { return this->_occlusion; }
+	void Visibility::setOcclusionSize(uint32_t width, uint32_t height) { this->_occlusionBuffer.resize(width, height); }
+	// ---
+
+	const std::vector<uint32_t>& Visibility::cull(const rawrbox::CameraBase& camera, uint32_t layers) {
+		return this->cull(camera, camera.getViewProjMtx(), layers == 0 ? camera.getLayers() : layers);
+	}
+
+	const std::vector<uint32_t>& Visibility::cull(const rawrbox::CameraBase& camera, const rawrbox::Matrix4x4& viewProj, uint32_t layers) {
+		RAWRBOX_PROFILE_ZONE("Visibility::cull");
+		this->updateTree();
+
+		const rawrbox::Frustum frustum(viewProj);
+		const auto& objects = this->_objects.data();
+
+		// Each job walks its own subtree, and drops the objects not on the layers
+		const auto subtrees = this->_bvh.getSubtrees(std::max(std::thread::hardware_concurrency(), 1U) * 4);
+		std::vector<std::vector<uint32_t>> partial(subtrees.size());
+
+		rawrbox::ASYNC::loop(0, subtrees.size(), [this, &frustum, &subtrees, &partial, &objects, layers](size_t i) {
+			auto& out = partial[i];
+			this->_bvh.query(frustum, subtrees[i], out);
+
+			if (layers != 0) {
+				std::erase_if(out, [&objects, layers](uint32_t index) {
+					const uint32_t objectLayers = objects[index].layers;
+					return objectLayers != 0 && (objectLayers & layers) == 0;
+				});
+			}
+		});
+
+		std::vector<uint32_t> dense = {};
+		size_t total = 0;
+		for (const auto& part : partial) {
+			total += part.size();
+		}
+
+		dense.reserve(total);
+		for (const auto& part : partial) {
+			dense.insert(dense.end(), part.begin(), part.end());
+		}
+
+		if (this->_occlusion) this->occlusionPass(camera.getPos(), viewProj, dense);
+
+		// Handles are what the user keeps, dense indices change when removing
+		auto& list = this->_visible[&camera][layers];
+		list.lastCull = ++this->_cullCount;
+		list.handles.resize(dense.size());
+
+		for (size_t i = 0; i < dense.size(); i++) {
+			list.handles[i] = this->_objects.handleAt(dense[i]);
+		}
+
+		this->pruneVisible(); // Cameras that stopped culling (or died) don't keep their lists forever
+
+		RAWRBOX_PROFILE_COUNTER("Visibility::visible", list.handles.size());
+		return list.handles;
+	}
+
+	const std::vector<uint32_t>& Visibility::getVisible(const rawrbox::CameraBase& camera, uint32_t layers) const {
+		static const std::vector<uint32_t> empty = {};
+		if (layers == 0) layers = camera.getLayers();
+
+		auto cam = this->_visible.find(&camera);
+		if (cam == this->_visible.end()) return empty;
+
+		auto list = cam->second.find(layers);
+		return list == cam->second.end() ? empty : list->second.handles;
+	}
+
+	void Visibility::forget(const rawrbox::CameraBase& camera) {
+		this->_visible.erase(&camera);
+	}
+} // namespace rawrbox
@@ -29,6 +29,7 @@
 #endif
 
 #include <rawrbox/engine/engine.hpp>
+#include <rawrbox/engine/static.hpp>
 #include <rawrbox/math/matrix4x4.hpp>
 #include <rawrbox/render/bindless.hpp>
 #include <rawrbox/render/text/engine.hpp>
@@ -100,6 +101,7 @@ namespace rawrbox {
 		// Check if the window should close
 		for (const auto& window : __WINDOWS) {
 			if (glfwWindowShouldClose(window->_handle) != 0) {
+				glfwWaitEventsTimeout(0.1); // Closing, wait for the engine's wake up instead of spinning
 				return;
 			}
 		}
@@ -144,6 +146,7 @@ namespace rawrbox {
 		}
 
 		__WINDOWS.clear();
+		rawrbox::INPUT_THREAD_WAKEUP = nullptr;
 
 		glfwPostEmptyEvent();
 		glfwTerminate();
@@ -210,6 +213,7 @@ namespace rawrbox {
 
 		glfwSetErrorCallback(glfw_errorCallback);
 		if (glfwInit() == 0) RAWRBOX_CRITICAL("Failed to initialize glfw");
+		rawrbox::INPUT_THREAD_WAKEUP = []() { glfwPostEmptyEvent(); }; // Thread safe, wakes up glfwWaitEvents
 
 		glfwWindowHint(GLFW_CLIENT_API, APIHint); // Disable opengl
 		if (APIHint == GLFW_OPENGL_API) {
@@ -0,0 +1,174 @@
+#include <rawrbox/math/utils/pack.hpp>
+#include <rawrbox/render/materials/lit.hpp>
+#include <rawrbox/render/models/base.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace {
+	// Vertex i sits at {i, 0, 0} facing up. Never uploaded, but acts as a dynamic one so the vertex ranges get recorded
+	class BlendModel : public rawrbox::ModelBase<rawrbox::MaterialLit> {
+	public:
+		explicit BlendModel(size_t vertices, rawrbox::UploadType type = rawrbox::UploadType::FIXED_DYNAMIC) : rawrbox::ModelBase<rawrbox::MaterialLit>(vertices) {
+			this->_uploadType = type;
+
+			for (size_t i = 0; i < vertices; i++) {
+				this->_mesh->vertices[i] = rawrbox::VertexNormData(rawrbox::Vector3f{static_cast<float>(i), 0, 0}, rawrbox::Vector4f{}, rawrbox::Vector3f{0, 1, 0});
+			}
+		}
+
+		[[nodiscard]] bool isUploaded() const override { return true; }
+
+		// Range the next draw would upload, then forgets it
+		std::pair<uint32_t, uint32_t> flush() {
+			std::pair<uint32_t, uint32_t> range = {this->_dirtyVertexStart, this->_dirtyVertexEnd};
+			if (range.second <= range.first) range = {0, 0};
+
+			this->_dirtyVertexStart = std::numeric_limits<uint32_t>::max();
+			this->_dirtyVertexEnd = 0;
+			return range;
+		}
+
+		[[nodiscard]] rawrbox::Vector3f pos(size_t i) const { return this->_mesh->vertices[i].position; }
+		[[nodiscard]] rawrbox::Vector3f normal(size_t i) const {
+			auto n = rawrbox::PackUtils::fromNormal(this->_mesh->vertices[i].normal);
+			return {n[0], n[1], n[2]};
+		}
+	};
+
+	// Original positions, with [start, end) moved by offset
+	std::vector<rawrbox::Vector3f> moved(size_t start, size_t end, const rawrbox::Vector3f& offset) {
+		std::vector<rawrbox::Vector3f> pos(end);
+		for (size_t i = 0; i < end; i++) {
+			pos[i] = {static_cast<float>(i), 0, 0};
+			if (i >= start) pos[i] += offset;
+		}
+
+		return pos;
+	}
+
+	void requirePos(const rawrbox::Vector3f& pos, const rawrbox::Vector3f& expected) {
+		using Catch::Matchers::WithinAbs;
+
+		REQUIRE_THAT(pos.x, WithinAbs(expected.x, 0.0001F));
+		REQUIRE_THAT(pos.y, WithinAbs(expected.y, 0.0001F));
+		REQUIRE_THAT(pos.z, WithinAbs(expected.z, 0.0001F));
+	}
+} // namespace
+
+TEST_CASE("Blend shapes should behave as expected", "[rawrbox::BlendShapes]") {
+	using Catch::Matchers::WithinAbs;
+
+	BlendModel model(64);
+
+	SECTION("rawrbox::BlendShapes weighted deltas") {
+		REQUIRE(model.createBlendShape("a", moved(10, 14, {0, 2, 0}), {}));
+		REQUIRE(model.createBlendShape("b", moved(12, 16, {0, 0, 4}), {}));
+
+		REQUIRE(model.setBlendShape("a", 0.5F));
+		requirePos(model.pos(10), {10, 1, 0});
+		requirePos(model.pos(13), {13, 1, 0});
+		requirePos(model.pos(14), {14, 0, 0});
+		REQUIRE(model.flush() == std::pair<uint32_t, uint32_t>{10, 14});
+
+		// Both on the overlap
+		REQUIRE(model.setBlendShape("b", 0.25F));
+		requirePos(model.pos(12), {12, 1, 1});
+		requirePos(model.pos(15), {15, 0, 1});
+		REQUIRE(model.flush() == std::pair<uint32_t, uint32_t>{10, 16});
+
+		// Weights are clamped to [0, 1]
+		REQUIRE(model.setBlendShape("a", 2.F));
+		requirePos(model.pos(10), {10, 2, 0});
+
+		REQUIRE_FALSE(model.setBlendShape("missing", 1.F));
+	}
+
+	SECTION("rawrbox::BlendShapes zero weights") {
+		REQUIRE(model.createBlendShape("a", moved(10, 14, {0, 2, 0}), {}));
+		REQUIRE(model.createBlendShape("b", moved(30, 32, {1, 0, 0}), {}));
+
+		REQUIRE(model.setBlendShape("a", 1.F));
+		REQUIRE(model.setBlendShape("b", 1.F));
+		REQUIRE(model.flush() == std::pair<uint32_t, uint32_t>{10, 32});
+
+		// Turned off, the last written range is restored
+		REQUIRE(model.setBlendShape("a", 0.F));
+		requirePos(model.pos(10), {10, 0, 0});
+		requirePos(model.pos(30), {31, 0, 0});
+		REQUIRE(model.flush() == std::pair<uint32_t, uint32_t>{10, 32});
+
+		REQUIRE(model.setBlendShape("b", 0.F));
+		requirePos(model.pos(30), {30, 0, 0});
+		REQUIRE(model.flush() == std::pair<uint32_t, uint32_t>{30, 32});
+
+		// Nothing active and nothing to restore, nothing written
+		REQUIRE(model.setBlendShape("a", 0.F));
+		REQUIRE(model.flush() == std::pair<uint32_t, uint32_t>{0, 0});
+
+		// Removing an active one restores it too
+		REQUIRE(model.setBlendShape("a", 1.F));
+		std::ignore = model.flush();
+
+		REQUIRE(model.removeBlendShape("a"));
+		requirePos(model.pos(12), {12, 0, 0});
+		REQUIRE(model.flush() == std::pair<uint32_t, uint32_t>{10, 14});
+	}
+
+	SECTION("rawrbox::BlendShapes normals") {
+		// Same as the packed ones, so only the last one moves
+		std::vector<rawrbox::Vector4f> normals(21);
+		for (size_t i = 0; i < normals.size(); i++) {
+			auto normal = model.normal(i);
+			normals[i] = {normal.x, normal.y, normal.z, 0};
+		}
+
+		normals[20] = {1, 0, 0, 0};
+
+		REQUIRE(model.createBlendShape("turn", {}, normals));
+		REQUIRE(model.setBlendShape("turn", 1.F));
+
+		auto normal = model.normal(20);
+		REQUIRE_THAT(normal.x, WithinAbs(1.F, 0.02F));
+		REQUIRE_THAT(normal.y, WithinAbs(0.F, 0.02F));
+		REQUIRE(model.flush() == std::pair<uint32_t, uint32_t>{20, 21});
+
+		// Halfway, renormalized
+		REQUIRE(model.setBlendShape("turn", 0.5F));
+		normal = model.normal(20);
+		REQUIRE_THAT(normal.x, WithinAbs(0.7071F, 0.03F));
+		REQUIRE_THAT(normal.y, WithinAbs(0.7071F, 0.03F));
+		requirePos(model.pos(20), {20, 0, 0});
+
+		REQUIRE(model.setBlendShape("turn", 0.F));
+		normal = model.normal(20);
+		REQUIRE_THAT(normal.x, WithinAbs(0.F, 0.02F));
+		REQUIRE_THAT(normal.y, WithinAbs(1.F, 0.02F));
+	}
+
+	SECTION("rawrbox::ModelBase::updateVertexRange") {
+		REQUIRE(model.createBlendShape("a", moved(40, 42, {0, 1, 0}), {}));
+
+		// Vertices outside of the shapes are never written
+		model.mesh()->vertices[50].position = {99, 99, 99};
+		REQUIRE(model.setBlendShape("a", 1.F));
+		requirePos(model.pos(50), {99, 99, 99});
+
+		// Ranges queued before the draw are merged
+		model.updateVertexRange(5, 8);
+		model.updateVertexRange(2, 4);
+		model.updateVertexRange(9, 9); // Empty
+		REQUIRE(model.flush() == std::pair<uint32_t, uint32_t>{2, 42});
+		REQUIRE(model.flush() == std::pair<uint32_t, uint32_t>{0, 0});
+
+		// Static models are never updated
+		BlendModel fixed(8, rawrbox::UploadType::STATIC);
+		fixed.updateVertexRange(0, 4);
+		REQUIRE(fixed.flush() == std::pair<uint32_t, uint32_t>{0, 0});
+	}
+}
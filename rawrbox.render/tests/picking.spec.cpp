@@ -0,0 +1,131 @@
+#include <rawrbox/render/cameras/perspective.hpp>
+#include <rawrbox/render/picking.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <vector>
+
+namespace {
+	// 2x2 quad on the XY plane, facing -z
+	uint32_t addQuad(rawrbox::Picking& picking) {
+		return picking.addMesh({{-1, -1, 0}, {1, -1, 0}, {1, 1, 0}, {-1, 1, 0}}, {0, 1, 2, 0, 2, 3});
+	}
+
+	rawrbox::Matrix4x4 at(const rawrbox::Vector3f& pos, float scale = 1.F) {
+		return rawrbox::Matrix4x4::mtxSRT({scale, scale, scale}, {0, 0, 0, 1}, pos);
+	}
+} // namespace
+
+TEST_CASE("Picking should behave as expected", "[rawrbox::Picking]") {
+	using Catch::Matchers::WithinAbs;
+
+	rawrbox::Picking picking;
+	const rawrbox::Ray forward({0, 0, 0}, {0, 0, 1});
+
+	SECTION("rawrbox::Picking instancing") {
+		auto quad = addQuad(picking);
+
+		auto first = picking.addInstance(quad, at({0, 0, 5}), 1);
+		picking.addInstance(quad, at({0, 0, 10}), 2);
+		picking.addInstance(quad, at({0, 0, 15}), 3);
+		auto side = picking.addInstance(quad, at({10, 0, 5}), 4);
+		REQUIRE(picking.size() == 4);
+
+		// One mesh tree, shared by all of them
+		auto hit = picking.raycast(forward);
+		REQUIRE(hit.has_value());
+		REQUIRE(hit->instance == first);
+		REQUIRE(hit->id == 1);
+		REQUIRE_THAT(hit->distance, WithinAbs(5.F, 0.001F));
+
+		hit = picking.raycast({{10, 0, 0}, {0, 0, 1}});
+		REQUIRE(hit.has_value());
+		REQUIRE(hit->instance == side);
+
+		picking.removeInstance(first);
+		hit = picking.raycast(forward);
+		REQUIRE(hit.has_value());
+		REQUIRE(hit->id == 2);
+		REQUIRE_THAT(hit->distance, WithinAbs(10.F, 0.001F));
+
+		REQUIRE_FALSE(picking.raycast(forward, 8.F).has_value());
+
+		picking.removeMesh(quad);
+		REQUIRE(picking.size() == 0);
+		REQUIRE_FALSE(picking.raycast(forward).has_value());
+	}
+
+	SECTION("rawrbox::Picking scaled instances") {
+		auto quad = addQuad(picking);
+
+		// Tiny and close, its mesh space distance (100) is way past the far one (12)
+		picking.addInstance(quad, at({0, 0, 10}, 0.1F), 1);
+		picking.addInstance(quad, at({0, 0, 12}), 2);
+
+		auto hit = picking.raycast(forward);
+		REQUIRE(hit.has_value());
+		REQUIRE(hit->id == 1);
+		REQUIRE_THAT(hit->distance, WithinAbs(10.F, 0.001F));
+		REQUIRE_THAT(hit->position.z, WithinAbs(10.F, 0.001F));
+
+		// Big and far, world distance not the mesh one
+		picking.clear();
+		quad = addQuad(picking);
+		picking.addInstance(quad, at({3, 0, 20}, 4.F), 3);
+
+		hit = picking.raycast(forward);
+		REQUIRE(hit.has_value());
+		REQUIRE_THAT(hit->distance, WithinAbs(20.F, 0.001F));
+		REQUIRE_THAT(hit->position.x, WithinAbs(0.F, 0.001F));
+		REQUIRE_FALSE(picking.raycast(forward, 19.F).has_value());
+	}
+
+	SECTION("rawrbox::Picking moving") {
+		auto quad = addQuad(picking);
+		auto moving = picking.addInstance(quad, at({0, 0, 5}), 1);
+		picking.addInstance(quad, at({0, 0, 10}), 2);
+		REQUIRE(picking.raycast(forward)->id == 1);
+
+		// Only the moved instance gets new bounds, the tree is refit
+		picking.setMatrix(moving, at({50, 0, 5}));
+		REQUIRE(picking.raycast(forward)->id == 2);
+
+		picking.setMatrix(moving, at({0, 0, 5}));
+		REQUIRE(picking.raycast(forward)->id == 1);
+
+		// Moved many times before a query
+		for (int i = 0; i < 10; i++) {
+			picking.setMatrix(moving, at({0, 0, 5.F + static_cast<float>(i)}));
+		}
+
+		REQUIRE(picking.raycast(forward)->id == 2);
+
+		// Deformed mesh, both instances follow it
+		picking.setMatrix(moving, at({0, 0, 5}));
+		picking.updateMesh(quad, {{-1, -1, 2}, {1, -1, 2}, {1, 1, 2}, {-1, 1, 2}});
+
+		auto hit = picking.raycast(forward);
+		REQUIRE(hit.has_value());
+		REQUIRE(hit->id == 1);
+		REQUIRE_THAT(hit->distance, WithinAbs(7.F, 0.001F));
+	}
+
+	SECTION("rawrbox::Picking::pick") {
+		rawrbox::CameraPerspective camera({64, 64}, 90.F, 0.1F, 100.F, false);
+		camera.setPos({0, 0, -10});
+
+		auto quad = addQuad(picking);
+		picking.addInstance(quad, at({0, 0, 5}, 10.F), 7);
+
+		// Center of the screen, from the camera and not the near plane
+		auto hit = picking.pick(camera, {32, 32});
+		REQUIRE(hit.has_value());
+		REQUIRE(hit->id == 7);
+		REQUIRE_THAT(hit->distance, WithinAbs(15.F, 0.05F));
+		REQUIRE_THAT(hit->position.z, WithinAbs(5.F, 0.001F));
+
+		// Corner, past the quad edges
+		REQUIRE_FALSE(picking.pick(camera, {0, 0}).has_value());
+	}
+}
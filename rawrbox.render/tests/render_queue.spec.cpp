@@ -0,0 +1,194 @@
+#include <rawrbox/render/render_queue.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <bit>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+	// Never dereferenced, the queue only compares them
+	template <typename T>
+	T* fake(uintptr_t id) { return std::bit_cast<T*>(id * 0x10); }
+
+	// Logs what the queue sends, instead of recording into a context
+	class FakeRecorder : public rawrbox::RenderRecorder {
+	public:
+		std::vector<std::string> calls = {};
+		std::vector<const void*> draws = {}; // Owners, in draw order
+
+		void setPipeline(Diligent::IPipelineState* pipeline) override { this->calls.push_back("pipeline " + std::to_string(std::bit_cast<uintptr_t>(pipeline) / 0x10)); }
+		void setMaterial(rawrbox::MaterialBase* material) override { this->calls.push_back("material " + std::to_string(std::bit_cast<uintptr_t>(material) / 0x10)); }
+		void setBuffers(Diligent::IBuffer* vertex, Diligent::IBuffer* /*index*/) override { this->calls.push_back("buffers " + std::to_string(std::bit_cast<uintptr_t>(vertex) / 0x10)); }
+		void setTransform(const rawrbox::Matrix4x4& /*transform*/) override { this->calls.emplace_back("transform"); }
+		void draw(const rawrbox::DrawItem& item) override {
+			this->calls.emplace_back("draw");
+			this->draws.push_back(item.owner);
+		}
+	};
+
+	rawrbox::DrawItem makeItem(uint64_t key, uintptr_t owner, uintptr_t pipeline, uintptr_t material, uintptr_t buffers) {
+		rawrbox::DrawItem item = {};
+		item.key = key;
+		item.owner = fake<const void>(owner);
+		item.pipeline = fake<Diligent::IPipelineState>(pipeline);
+		item.material = fake<rawrbox::MaterialBase>(material);
+		item.vertexBuffer = fake<Diligent::IBuffer>(buffers);
+		item.indexBuffer = fake<Diligent::IBuffer>(buffers);
+
+		return item;
+	}
+} // namespace
+
+TEST_CASE("RenderKey should behave as expected", "[rawrbox::RenderKey]") {
+	SECTION("rawrbox::RenderKey::opaque") {
+		auto key = rawrbox::RenderKey::opaque(3, 1234, 56, 789);
+		REQUIRE(rawrbox::RenderKey::getLayer(key) == 3);
+		REQUIRE_FALSE(rawrbox::RenderKey::isTranslucent(key));
+		REQUIRE(rawrbox::RenderKey::getPipeline(key) == 1234);
+		REQUIRE(rawrbox::RenderKey::getTextures(key) == 56);
+		REQUIRE(rawrbox::RenderKey::getDepth(key) == 789);
+
+		// Pipeline first, then front to back
+		REQUIRE(rawrbox::RenderKey::opaque(0, 1, 1, 10) < rawrbox::RenderKey::opaque(0, 1, 1, 20));
+		REQUIRE(rawrbox::RenderKey::opaque(0, 1, 1, 20) < rawrbox::RenderKey::opaque(0, 2, 1, 10));
+	}
+
+	SECTION("rawrbox::RenderKey::translucent") {
+		auto key = rawrbox::RenderKey::translucent(3, 1234, 56, 789);
+		REQUIRE(rawrbox::RenderKey::getLayer(key) == 3);
+		REQUIRE(rawrbox::RenderKey::isTranslucent(key));
+		REQUIRE(rawrbox::RenderKey::getPipeline(key) == 1234);
+		REQUIRE(rawrbox::RenderKey::getTextures(key) == 56);
+		REQUIRE(rawrbox::RenderKey::getDepth(key) == 789);
+
+		// Back to front, after every opaque draw of the same layer
+		REQUIRE(rawrbox::RenderKey::translucent(0, 1, 1, 20) < rawrbox::RenderKey::translucent(0, 1, 1, 10));
+		REQUIRE(rawrbox::RenderKey::opaque(0, 0xFFFF, 0xFFFF, rawrbox::RenderKey::DEPTH_MAX) < rawrbox::RenderKey::translucent(0, 0, 0, 0));
+		REQUIRE(rawrbox::RenderKey::translucent(0, 0, 0, 0) < rawrbox::RenderKey::opaque(1, 0, 0, 0));
+	}
+
+	SECTION("rawrbox::RenderKey::quantizeDepth") {
+		REQUIRE(rawrbox::RenderKey::quantizeDepth(0.1F, 0.1F, 100.F) == 0);
+		REQUIRE(rawrbox::RenderKey::quantizeDepth(500.F, 0.1F, 100.F) == rawrbox::RenderKey::DEPTH_MAX);
+		REQUIRE(rawrbox::RenderKey::quantizeDepth(10.F, 0.1F, 100.F) < rawrbox::RenderKey::quantizeDepth(20.F, 0.1F, 100.F));
+		REQUIRE(rawrbox::RenderKey::quantizeDepth(10.F, 5.F, 5.F) == 0);
+	}
+}
+
+TEST_CASE("RenderQueue should behave as expected", "[rawrbox::RenderQueue]") {
+	rawrbox::RenderQueue queue;
+	FakeRecorder recorder;
+
+	SECTION("rawrbox::RenderQueue ids") {
+		auto a = queue.getPipelineID(fake<const void>(1));
+		auto b = queue.getPipelineID(fake<const void>(2));
+		REQUIRE(a == 1);
+		REQUIRE(b == 2);
+		REQUIRE(queue.getPipelineID(fake<const void>(1)) == a);
+
+		auto texA = queue.getTextureSetID({1, 2, 3, 4});
+		REQUIRE(texA == 1);
+		REQUIRE(queue.getTextureSetID({4, 3, 2, 1}) == 2);
+		REQUIRE(queue.getTextureSetID({1, 2, 3, 4}) == texA);
+	}
+
+	SECTION("rawrbox::RenderQueue::submit order") {
+		queue.push(makeItem(rawrbox::RenderKey::translucent(0, 1, 1, 10), 1, 1, 1, 1)); // Near, drawn last
+		queue.push(makeItem(rawrbox::RenderKey::opaque(0, 2, 1, 10), 2, 2, 1, 1));
+		queue.push(makeItem(rawrbox::RenderKey::translucent(0, 1, 1, 90), 3, 1, 1, 1)); // Far
+		queue.push(makeItem(rawrbox::RenderKey::opaque(0, 1, 1, 50), 4, 1, 1, 1));
+		queue.push(makeItem(rawrbox::RenderKey::opaque(1, 1, 1, 0), 5, 1, 1, 1)); // Next layer
+		queue.push(makeItem(rawrbox::RenderKey::opaque(0, 1, 1, 5), 6, 1, 1, 1));
+
+		queue.submit(recorder);
+		REQUIRE(recorder.draws == std::vector<const void*>{fake<const void>(6), fake<const void>(4), fake<const void>(2), fake<const void>(3), fake<const void>(1), fake<const void>(5)});
+		REQUIRE(queue.getOrder() == std::vector<uint32_t>{5, 3, 1, 2, 0, 4});
+
+		// Same keys, kept in push order
+		queue.clear();
+		recorder.draws.clear();
+		for (uintptr_t i = 1; i <= 4; i++)
+			queue.push(makeItem(rawrbox::RenderKey::opaque(0, 1, 1, 1), i, 1, 1, 1));
+
+		queue.submit(recorder);
+		REQUIRE(recorder.draws == std::vector<const void*>{fake<const void>(1), fake<const void>(2), fake<const void>(3), fake<const void>(4)});
+	}
+
+	SECTION("rawrbox::RenderQueue::submit state changes") {
+		rawrbox::Matrix4x4 moved = {};
+		moved.translate({1, 2, 3});
+
+		// Pushed interleaved, sorted by pipeline so each one is only bound once
+		auto a = makeItem(rawrbox::RenderKey::opaque(0, 1, 1, 1), 1, 1, 1, 1);
+		auto b = makeItem(rawrbox::RenderKey::opaque(0, 2, 1, 1), 2, 2, 1, 1);
+		auto c = makeItem(rawrbox::RenderKey::opaque(0, 1, 1, 2), 3, 1, 1, 1);
+		auto d = makeItem(rawrbox::RenderKey::opaque(0, 2, 1, 2), 4, 2, 2, 2);
+		d.transform = moved;
+
+		queue.push(a);
+		queue.push(b);
+		queue.push(c);
+		queue.push(d);
+		queue.submit(recorder);
+
+		REQUIRE(recorder.calls == std::vector<std::string>{
+					      "pipeline 1", "material 1", "buffers 1", "transform", "draw",
+					      "draw",
+					      "pipeline 2", "draw",
+					      "material 2", "buffers 2", "transform", "draw"});
+
+		const auto& stats = queue.getStats();
+		REQUIRE(stats.draws == 4);
+		REQUIRE(stats.pipelines == 2);
+		REQUIRE(stats.materials == 2);
+		REQUIRE(stats.buffers == 2);
+		REQUIRE(stats.transforms == 2);
+
+		// Stats are per submit
+		queue.submit(recorder);
+		REQUIRE(queue.getStats().draws == 4);
+	}
+
+	SECTION("rawrbox::RenderQueue::clear") {
+		queue.push(makeItem(0, 1, 1, 1, 1));
+		REQUIRE(queue.size() == 1);
+
+		queue.clear();
+		REQUIRE(queue.empty());
+
+		queue.submit(recorder);
+		REQUIRE(recorder.calls.empty());
+		REQUIRE(queue.getStats().draws == 0);
+	}
+}
+
+TEST_CASE("RenderQueue benchmark", "[rawrbox::RenderQueue][.benchmark]") {
+	rawrbox::RenderQueue queue;
+	FakeRecorder recorder;
+
+	std::vector<rawrbox::DrawItem> items = {};
+	items.reserve(10000);
+	for (uintptr_t i = 0; i < 10000; i++) {
+		auto pipeline = (i * 7) % 16;
+		items.push_back(makeItem(rawrbox::RenderKey::opaque(0, static_cast<uint16_t>(pipeline), static_cast<uint16_t>(i % 64), static_cast<uint32_t>((i * 7919) % rawrbox::RenderKey::DEPTH_MAX)), i, pipeline, i % 32, i % 128));
+	}
+
+	queue.reserve(items.size());
+	recorder.calls.reserve(items.size() * 5);
+	recorder.draws.reserve(items.size());
+
+	BENCHMARK("Queue + submit 10k draws") {
+		recorder.calls.clear();
+		recorder.draws.clear();
+
+		queue.clear();
+		for (const auto& item : items)
+			queue.push(item);
+
+		queue.submit(recorder);
+		return queue.getStats().pipelines;
+	};
+}
@@ -0,0 +1,193 @@
+#include <rawrbox/render/stencil_list.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace {
+	// Never dereferenced, the list only compares them
+	auto* const PIPELINE_2D = std::bit_cast<Diligent::IPipelineState*>(uintptr_t{0x10});
+	auto* const PIPELINE_LINE = std::bit_cast<Diligent::IPipelineState*>(uintptr_t{0x20});
+
+	const rawrbox::Clip SCREEN = {{0, 0, 1280, 720}};
+
+	struct Widget {
+		rawrbox::Vector2f pos = {};
+		rawrbox::Vector2f size = {};
+		Diligent::IPipelineState* pipeline = PIPELINE_2D;
+		std::optional<rawrbox::Clip> clip = std::nullopt;
+		bool optimize = true;
+	};
+
+	// Same calls as Stencil::drawTexture, with the offset and clip Stencil would have at that point
+	void drawWidget(rawrbox::StencilDrawList& list, const Widget& widget, const rawrbox::Vector2f& offset, const rawrbox::Clip& clip, bool inheritClip) {
+		rawrbox::StencilCommand cmd = {};
+		cmd.optimize = widget.optimize;
+		cmd.stencilProgram = widget.pipeline;
+		cmd.inheritClip = inheritClip && !widget.clip.has_value();
+		cmd.clip = clip;
+
+		if (widget.clip.has_value()) {
+			cmd.clip = widget.clip.value();
+			cmd.clip.bbox.pos += offset.cast<uint32_t>();
+		}
+
+		cmd.updateKey(widget.pipeline == PIPELINE_2D ? 1 : 2);
+		list.begin(cmd);
+
+		const auto pos = widget.pos + offset;
+		list.pushVertex({0, pos, {0, 0, 0, 0}, 0xFFFFFFFF});
+		list.pushVertex({0, {pos.x, pos.y + widget.size.y}, {0, 1, 0, 0}, 0xFFFFFFFF});
+		list.pushVertex({0, {pos.x + widget.size.x, pos.y}, {1, 0, 0, 0}, 0xFFFFFFFF});
+		list.pushVertex({0, pos + widget.size, {1, 1, 0, 0}, 0xFFFFFFFF});
+		list.pushIndices({0, 1, 2,
+		    1, 3, 2});
+
+		list.commit(cmd);
+	}
+
+	std::vector<Widget> makeWidgets(size_t count) {
+		std::vector<Widget> widgets = {};
+		widgets.reserve(count);
+
+		for (size_t i = 0; i < count; i++) {
+			auto& widget = widgets.emplace_back();
+			widget.pos = {static_cast<float>(i % 100) * 12.F, static_cast<float>(i / 100) * 7.F};
+			widget.size = {10.F, 5.F};
+			if (i % 7 == 0) widget.pipeline = PIPELINE_LINE;
+			if (i % 25 == 0) widget.clip = rawrbox::Clip{{static_cast<uint32_t>(i % 100), 0, 300, 200}};
+			if (i % 50 == 0) widget.optimize = false;
+		}
+
+		return widgets;
+	}
+
+	void requireSame(const std::vector<rawrbox::StencilDraw>& a, const std::vector<rawrbox::StencilDraw>& b) {
+		REQUIRE(a.size() == b.size());
+
+		for (size_t i = 0; i < a.size(); i++) {
+			REQUIRE(a[i].stencilProgram == b[i].stencilProgram);
+			REQUIRE(a[i].clip == b[i].clip);
+			REQUIRE(a[i].cull == b[i].cull);
+			REQUIRE(a[i].indices == b[i].indices);
+			REQUIRE(a[i].vertices.size() == b[i].vertices.size());
+
+			for (size_t v = 0; v < a[i].vertices.size(); v++) {
+				REQUIRE(a[i].vertices[v].pos == b[i].vertices[v].pos);
+				REQUIRE(a[i].vertices[v].uv == b[i].vertices[v].uv);
+				REQUIRE(a[i].vertices[v].color == b[i].vertices[v].color);
+			}
+		}
+	}
+} // namespace
+
+TEST_CASE("StencilDrawList should behave as expected", "[rawrbox::StencilDrawList]") {
+	rawrbox::StencilDrawList list;
+
+	SECTION("rawrbox::StencilDrawList::commit") {
+		drawWidget(list, {.pos = {0, 0}, .size = {10, 10}}, {}, SCREEN, false);
+		drawWidget(list, {.pos = {20, 0}, .size = {10, 10}}, {}, SCREEN, false);
+
+		// Same pipeline and clip, one batch with the second quad's indices rebased
+		REQUIRE(list.getCommands().size() == 1);
+		REQUIRE(list.getCommands()[0].vertexCount == 8);
+		REQUIRE(list.getIndices() == std::vector<uint32_t>{0, 1, 2, 1, 3, 2, 4, 5, 6, 5, 7, 6});
+
+		drawWidget(list, {.pos = {40, 0}, .size = {10, 10}, .pipeline = PIPELINE_LINE}, {}, SCREEN, false);
+		drawWidget(list, {.pos = {60, 0}, .size = {10, 10}, .clip = rawrbox::Clip{{0, 0, 5, 5}}}, {}, SCREEN, false);
+		drawWidget(list, {.pos = {80, 0}, .size = {10, 10}, .optimize = false}, {}, SCREEN, false);
+		REQUIRE(list.getCommands().size() == 4);
+
+		// Nothing pushed, nothing kept
+		rawrbox::StencilCommand empty = {};
+		list.begin(empty);
+		list.pushVertex({});
+		list.commit(empty);
+		REQUIRE(list.getCommands().size() == 4);
+		REQUIRE(list.getVertices().size() == 20);
+
+		list.clear();
+		REQUIRE(list.empty());
+		REQUIRE(list.getVertices().empty());
+	}
+
+	SECTION("rawrbox::StencilDrawList::append") {
+		rawrbox::StencilDrawList recorded;
+		drawWidget(recorded, {.pos = {0, 0}, .size = {10, 10}}, {}, SCREEN, true);
+		drawWidget(recorded, {.pos = {0, 0}, .size = {10, 10}, .clip = rawrbox::Clip{{1, 2, 3, 4}}}, {}, SCREEN, true);
+
+		const rawrbox::Clip parent = {{50, 50, 100, 100}};
+		list.append(recorded, {100, 200}, parent, false);
+
+		const auto& cmds = list.getCommands();
+		REQUIRE(cmds.size() == 2);
+		REQUIRE(cmds[0].clip == parent); // Recorded without a clip
+		REQUIRE_FALSE(cmds[0].inheritClip);
+		REQUIRE(cmds[1].clip == rawrbox::Clip{{101, 202, 3, 4}});
+		REQUIRE(list.getVertices()[0].pos == rawrbox::Vector2f{100, 200});
+
+		list.append(list, {}, parent, false); // Into itself, ignored
+		REQUIRE(list.getCommands().size() == 2);
+	}
+
+	SECTION("rawrbox::StencilDrawList immediate == cached") {
+		const auto widgets = makeWidgets(1000);
+		const rawrbox::Vector2f offset = {33, 17};
+		const rawrbox::Clip parent = {{10, 10, 800, 600}};
+
+		rawrbox::StencilDrawList immediate;
+		for (const auto& widget : widgets)
+			drawWidget(immediate, widget, offset, parent, false);
+
+		// Recorded in local space without a clip, like Stencil::beginRecording
+		rawrbox::StencilDrawList cached;
+		for (const auto& widget : widgets)
+			drawWidget(cached, widget, {}, SCREEN, true);
+
+		rawrbox::StencilDrawList frame;
+		frame.append(cached, offset, parent, false);
+		requireSame(immediate.getDrawCalls(), frame.getDrawCalls());
+
+		// Replayed twice, keeps merging across the seam
+		frame.clear();
+		frame.append(cached, offset, parent, false);
+		frame.append(cached, offset, parent, false);
+
+		immediate.clear();
+		for (size_t i = 0; i < 2; i++) {
+			for (const auto& widget : widgets)
+				drawWidget(immediate, widget, offset, parent, false);
+		}
+
+		requireSame(immediate.getDrawCalls(), frame.getDrawCalls());
+	}
+}
+
+TEST_CASE("StencilDrawList benchmark", "[rawrbox::StencilDrawList][.benchmark]") {
+	const auto widgets = makeWidgets(10000);
+	const rawrbox::Vector2f offset = {33, 17};
+
+	rawrbox::StencilDrawList frame;
+	BENCHMARK("Immediate 10k widgets") {
+		frame.clear();
+		for (const auto& widget : widgets)
+			drawWidget(frame, widget, offset, SCREEN, false);
+
+		return frame.getCommands().size();
+	};
+
+	rawrbox::StencilDrawList cached;
+	for (const auto& widget : widgets)
+		drawWidget(cached, widget, {}, SCREEN, true);
+
+	BENCHMARK("Cached 10k widgets") {
+		frame.clear();
+		frame.append(cached, offset, SCREEN, false);
+
+		return frame.getCommands().size();
+	};
+}
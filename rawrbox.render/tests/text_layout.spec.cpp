@@ -0,0 +1,182 @@
+#include <rawrbox/render/text/layout.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <fmt/format.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+	// Monospaced, no font file needed. Every glyph is 8x10 with an advance of 10
+	class FakeFont : public rawrbox::Font {
+	protected:
+		mutable std::unordered_map<uint32_t, std::unique_ptr<rawrbox::Glyph>> _fake = {};
+
+	public:
+		FakeFont() : rawrbox::Font("fake.ttf") {}
+
+		[[nodiscard]] rawrbox::Glyph* getGlyph(uint32_t codepoint) const override {
+			auto& glyph = this->_fake[codepoint];
+			if (glyph == nullptr) {
+				glyph = std::make_unique<rawrbox::Glyph>();
+				glyph->codePoint = codepoint;
+				glyph->size = codepoint == ' ' ? rawrbox::Vector2f{} : rawrbox::Vector2f{8, 10};
+				glyph->advance = {10, 12};
+			}
+
+			return glyph.get();
+		}
+
+		[[nodiscard]] bool hasGlyph(uint32_t /*codepoint*/) const override { return true; }
+		[[nodiscard]] uint32_t getGlyphVersion() const override { return 0; }
+		[[nodiscard]] float getLineHeight() const override { return 12.F; }
+		[[nodiscard]] float getKerning(uint32_t /*prevCodePoint*/, uint32_t /*nextCodePoint*/) const override { return 0.F; }
+	};
+} // namespace
+
+TEST_CASE("TextLayout should behave as expected", "[rawrbox::TextLayout]") {
+	rawrbox::TextLayout::clear();
+	FakeFont font;
+
+	SECTION("rawrbox::TextLayout::build") {
+		auto run = rawrbox::TextLayout::build(font, "ab c");
+		REQUIRE(run.glyphs.size() == 3); // Spaces have no quad
+		REQUIRE(run.glyphs[2].x == 30.F);
+		REQUIRE(run.size == rawrbox::Vector2f{40, 12});
+
+		run = rawrbox::TextLayout::build(font, "ab\ncd");
+		REQUIRE(run.lines == 2);
+		REQUIRE(run.glyphs[2].line == 1);
+		REQUIRE(run.glyphs[2].x == 0.F);
+	}
+
+	SECTION("rawrbox::TextLayout::build wrapping") {
+		// Breaks at the space
+		auto run = rawrbox::TextLayout::build(font, "aaa bbb", 50.F);
+		REQUIRE(run.lines == 2);
+		REQUIRE(run.glyphs[3].line == 1);
+		REQUIRE(run.glyphs[3].x == 0.F);
+
+		// No space, splits the word
+		run = rawrbox::TextLayout::build(font, "aaaaaaa", 50.F);
+		REQUIRE(run.lines == 2);
+		REQUIRE(run.glyphs[5].line == 1);
+
+		// Aligned inside the wrap width
+		run = rawrbox::TextLayout::build(font, "ab", 100.F, rawrbox::Alignment::Right);
+		REQUIRE(run.glyphs[0].x == 80.F);
+		run = rawrbox::TextLayout::build(font, "ab", 100.F, rawrbox::Alignment::Center);
+		REQUIRE(run.glyphs[0].x == 40.F);
+	}
+
+	SECTION("rawrbox::TextLayout::get") {
+		auto a = rawrbox::TextLayout::get(font, "hello");
+		auto b = rawrbox::TextLayout::get(font, "hello");
+		REQUIRE(a == b);
+		REQUIRE(rawrbox::TextLayout::size() == 1);
+
+		std::ignore = rawrbox::TextLayout::get(font, "hello", 20.F);
+		REQUIRE(rawrbox::TextLayout::size() == 2);
+	}
+
+	SECTION("rawrbox::TextLayout LRU") {
+		const size_t old = rawrbox::TextLayout::CACHE_SIZE;
+		rawrbox::TextLayout::CACHE_SIZE = 4;
+
+		for (int i = 0; i < 10; i++)
+			std::ignore = rawrbox::TextLayout::get(font, std::to_string(i));
+
+		REQUIRE(rawrbox::TextLayout::size() == 4);
+		rawrbox::TextLayout::CACHE_SIZE = old;
+	}
+
+	SECTION("rawrbox::TextLayout handles") {
+		const size_t old = rawrbox::TextLayout::CACHE_SIZE;
+		rawrbox::TextLayout::CACHE_SIZE = 1;
+
+		// Kept alive after the cache drops it
+		auto run = rawrbox::TextLayout::get(font, "abc");
+		std::ignore = rawrbox::TextLayout::get(font, "something else");
+		REQUIRE(rawrbox::TextLayout::size() == 1);
+		REQUIRE(run->glyphs.size() == 3);
+		REQUIRE(run->size == rawrbox::Vector2f{30, 12});
+
+		rawrbox::TextLayout::clear();
+		REQUIRE(run->glyphs[2].x == 20.F);
+		REQUIRE(rawrbox::TextLayout::get(font, "abc") != run); // Rebuilt, not the old one
+
+		rawrbox::TextLayout::CACHE_SIZE = old;
+	}
+
+	SECTION("rawrbox::TextLayout::evict") {
+		{
+			FakeFont temp;
+			std::ignore = rawrbox::TextLayout::get(temp, "bye");
+			std::ignore = rawrbox::TextLayout::get(font, "hi");
+			REQUIRE(rawrbox::TextLayout::size() == 2);
+		}
+
+		REQUIRE(rawrbox::TextLayout::size() == 1); // ~Font dropped its runs
+
+		// Same address or not, a new font never hits the old runs
+		FakeFont other;
+		REQUIRE(other.getID() != font.getID());
+		std::ignore = rawrbox::TextLayout::get(other, "hi");
+		REQUIRE(rawrbox::TextLayout::size() == 2);
+	}
+
+	SECTION("rawrbox::TextLayout threads") {
+		std::ignore = rawrbox::TextLayout::get(font, "main");
+
+		size_t workerSize = 0;
+		std::thread worker([&font, &workerSize]() {
+			workerSize = rawrbox::TextLayout::size();
+			std::ignore = rawrbox::TextLayout::get(font, "worker");
+			std::ignore = rawrbox::TextLayout::get(font, "worker 2");
+		});
+		worker.join();
+
+		REQUIRE(workerSize == 0);
+		REQUIRE(rawrbox::TextLayout::size() == 1);
+	}
+
+	rawrbox::TextLayout::clear();
+}
+
+TEST_CASE("TextLayout benchmark", "[rawrbox::TextLayout][.benchmark]") {
+	FakeFont font;
+
+	std::vector<std::string> strings = {};
+	strings.reserve(10000);
+	for (int i = 0; i < 10000; i++)
+		strings.push_back(fmt::format("Label {} with some text to lay out", i));
+
+	const size_t old = rawrbox::TextLayout::CACHE_SIZE;
+	rawrbox::TextLayout::CACHE_SIZE = strings.size();
+
+	BENCHMARK("Build 10k strings") {
+		float width = 0.F;
+		for (const auto& str : strings)
+			width += rawrbox::TextLayout::build(font, str, 120.F).size.x;
+
+		return width;
+	};
+
+	for (const auto& str : strings)
+		std::ignore = rawrbox::TextLayout::get(font, str, 120.F);
+
+	BENCHMARK("Cached 10k strings") {
+		float width = 0.F;
+		for (const auto& str : strings)
+			width += rawrbox::TextLayout::get(font, str, 120.F)->size.x;
+
+		return width;
+	};
+
+	rawrbox::TextLayout::CACHE_SIZE = old;
+	rawrbox::TextLayout::clear();
+}
@@ -0,0 +1,181 @@
+#include <rawrbox/render/textures/utils/bc.hpp>
+#include <rawrbox/render/textures/utils/mipmap.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+	std::array<uint8_t, 3> fromRGB565(uint16_t v) {
+		const auto r = static_cast<uint8_t>((v >> 11) & 31);
+		const auto g = static_cast<uint8_t>((v >> 5) & 63);
+		const auto b = static_cast<uint8_t>(v & 31);
+
+		return {static_cast<uint8_t>((r << 3) | (r >> 2)), static_cast<uint8_t>((g << 2) | (g >> 4)), static_cast<uint8_t>((b << 3) | (b >> 2))};
+	}
+
+	// Reference BC1 decode of a single texel
+	std::array<uint8_t, 3> decodeBC1(const uint8_t* block, uint32_t texel) {
+		const auto c0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+		const auto c1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+		const auto a = fromRGB565(c0);
+		const auto b = fromRGB565(c1);
+
+		const uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<uint32_t>(block[7]) << 24);
+		const uint32_t index = (indices >> (texel * 2)) & 3U;
+
+		std::array<uint8_t, 3> out = {};
+		for (size_t c = 0; c < 3; c++) {
+			switch (index) {
+				case 0: out[c] = a[c]; break;
+				case 1: out[c] = b[c]; break;
+				case 2: out[c] = static_cast<uint8_t>(c0 > c1 ? (2 * a[c] + b[c]) / 3 : (a[c] + b[c]) / 2); break;
+				default: out[c] = static_cast<uint8_t>(c0 > c1 ? (a[c] + 2 * b[c]) / 3 : 0); break;
+			}
+		}
+
+		return out;
+	}
+
+	std::vector<uint8_t> noise(const rawrbox::Vector2u& size, uint8_t channels) {
+		std::mt19937 rng(1337);
+		std::uniform_int_distribution<int> dist(0, 255);
+
+		std::vector<uint8_t> pixels(static_cast<size_t>(size.x) * size.y * channels);
+		for (auto& p : pixels)
+			p = static_cast<uint8_t>(dist(rng));
+
+		return pixels;
+	}
+} // namespace
+
+TEST_CASE("BCEncoder should behave as expected", "[rawrbox::BCEncoder]") {
+	SECTION("rawrbox::BCEncoder::getEncodedSize") {
+		REQUIRE(rawrbox::BCEncoder::getEncodedSize(rawrbox::TEXTURE_COMPRESSION::BC1, {4, 4}) == 8);
+		REQUIRE(rawrbox::BCEncoder::getEncodedSize(rawrbox::TEXTURE_COMPRESSION::BC1, {5, 5}) == 32); // Padded to 2x2 blocks
+		REQUIRE(rawrbox::BCEncoder::getEncodedSize(rawrbox::TEXTURE_COMPRESSION::BC7, {8, 4}) == 32);
+		REQUIRE(rawrbox::BCEncoder::getRowPitch(rawrbox::TEXTURE_COMPRESSION::BC3, 16) == 64);
+	}
+
+	SECTION("rawrbox::BCEncoder::encode BC1") {
+		// Two colors, split down the middle
+		std::vector<uint8_t> pixels(4 * 4 * 3);
+		for (uint32_t i = 0; i < 16; i++) {
+			const bool left = (i % 4) < 2;
+
+			pixels[i * 3 + 0] = left ? 255 : 0;
+			pixels[i * 3 + 1] = left ? 0 : 255;
+			pixels[i * 3 + 2] = 0;
+		}
+
+		auto encoded = rawrbox::BCEncoder::encode(rawrbox::TEXTURE_COMPRESSION::BC1, pixels.data(), {4, 4}, 3);
+		REQUIRE(encoded.size() == 8);
+
+		for (uint32_t i = 0; i < 16; i++) {
+			auto texel = decodeBC1(encoded.data(), i);
+			for (size_t c = 0; c < 3; c++) {
+				REQUIRE(std::abs(static_cast<int>(texel[c]) - static_cast<int>(pixels[i * 3 + c])) <= 8);
+			}
+		}
+	}
+
+	SECTION("rawrbox::BCEncoder::encode is deterministic") {
+		auto pixels = noise({64, 64}, 4);
+
+		auto a = rawrbox::BCEncoder::encode(rawrbox::TEXTURE_COMPRESSION::BC7, pixels.data(), {64, 64}, 4);
+		auto b = rawrbox::BCEncoder::encode(rawrbox::TEXTURE_COMPRESSION::BC7, pixels.data(), {64, 64}, 4);
+
+		REQUIRE(a == b);
+	}
+}
+
+TEST_CASE("MipMapUtils should behave as expected", "[rawrbox::MipMapUtils]") {
+	SECTION("rawrbox::MipMapUtils::getMipCount") {
+		REQUIRE(rawrbox::MipMapUtils::getMipCount({1, 1}) == 1);
+		REQUIRE(rawrbox::MipMapUtils::getMipCount({256, 128}) == 9);
+	}
+
+	SECTION("rawrbox::MipMapUtils::generate") {
+		std::vector<uint8_t> pixels(8 * 8 * 4, 128);
+		auto levels = rawrbox::MipMapUtils::generate(pixels.data(), {8, 8}, 4, false);
+
+		REQUIRE(levels.size() == 3);
+		REQUIRE(levels.back().size == rawrbox::Vector2u{1, 1});
+
+		for (const auto& level : levels) {
+			for (auto p : level.pixels)
+				REQUIRE(p == 128); // Flat stays flat
+		}
+	}
+
+	SECTION("rawrbox::MipMapUtils::generate non power of two") {
+		// 5x5, only the last column and row are lit
+		std::vector<uint8_t> pixels(5 * 5, 0);
+		for (size_t i = 0; i < 5; i++) {
+			pixels[i * 5 + 4] = 255;
+			pixels[4 * 5 + i] = 255;
+		}
+
+		auto levels = rawrbox::MipMapUtils::generate(pixels.data(), {5, 5}, 1, false);
+		REQUIRE(levels.size() == 2);
+		REQUIRE(levels[0].size == rawrbox::Vector2u{2, 2});
+		REQUIRE(levels[1].size == rawrbox::Vector2u{1, 1});
+
+		// Each one covers 2.5 source pixels, the last column / row is 40% of the second ones
+		const auto& mip = levels[0].pixels;
+		REQUIRE(mip[0] == 0);
+		REQUIRE(mip[1] == 102);
+		REQUIRE(mip[2] == 102);
+		REQUIRE(mip[3] == 163); // 1 - 0.6 * 0.6 lit
+
+		// Nothing lost on the way down, the average stays the same
+		auto noisy = noise({13, 7}, 4);
+		auto chain = rawrbox::MipMapUtils::generate(noisy.data(), {13, 7}, 4, false);
+		REQUIRE(chain.front().size == rawrbox::Vector2u{6, 3});
+
+		auto average = [](const std::vector<uint8_t>& data, uint8_t channel) {
+			double sum = 0.0;
+			for (size_t i = channel; i < data.size(); i += 4)
+				sum += data[i];
+
+			return sum / static_cast<double>(data.size() / 4);
+		};
+
+		for (uint8_t c = 0; c < 4; c++) {
+			for (const auto& level : chain) {
+				REQUIRE(std::abs(average(level.pixels, c) - average(noisy, c)) < 1.0);
+			}
+		}
+	}
+}
+
+TEST_CASE("Texture encode benchmark", "[rawrbox::BCEncoder][.benchmark]") {
+	const rawrbox::Vector2u size = {1024, 1024};
+	auto pixels = noise(size, 4);
+
+	BENCHMARK("BC1 (1024x1024)") {
+		return rawrbox::BCEncoder::encode(rawrbox::TEXTURE_COMPRESSION::BC1, pixels.data(), size, 4);
+	};
+
+	BENCHMARK("BC3 (1024x1024)") {
+		return rawrbox::BCEncoder::encode(rawrbox::TEXTURE_COMPRESSION::BC3, pixels.data(), size, 4);
+	};
+
+	BENCHMARK("BC7 (1024x1024)") {
+		return rawrbox::BCEncoder::encode(rawrbox::TEXTURE_COMPRESSION::BC7, pixels.data(), size, 4);
+	};
+
+	BENCHMARK("Mip chain, box (1024x1024)") {
+		return rawrbox::MipMapUtils::generate(pixels.data(), size, 4, true);
+	};
+
+	BENCHMARK("Mip chain, kaiser (1024x1024)") {
+		return rawrbox::MipMapUtils::generate(pixels.data(), size, 4, true, rawrbox::MIP_FILTER::KAISER);
+	};
+}
@@ -0,0 +1,135 @@
+#include <rawrbox/render/cameras/perspective.hpp>
+#include <rawrbox/render/visibility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+namespace {
+	rawrbox::BBOX box(const rawrbox::Vector3f& center, const rawrbox::Vector3f& half) {
+		return {center - half, center + half, half * 2.F};
+	}
+
+	bool has(const std::vector<uint32_t>& visible, uint32_t handle) {
+		return std::find(visible.begin(), visible.end(), handle) != visible.end();
+	}
+} // namespace
+
+TEST_CASE("Visibility should behave as expected", "[rawrbox::Visibility]") {
+	// At the origin, looking down +z
+	const auto viewProj = rawrbox::Matrix4x4::mtxProj(90.F, 1.F, 0.1F, 100.F) * rawrbox::Matrix4x4::mtxLookAt({0, 0, 0}, {0, 0, 1}, {0, 1, 0});
+
+	rawrbox::CameraPerspective camera({64, 64}, 90.F, 0.1F, 100.F, false);
+	rawrbox::Visibility scene;
+
+	SECTION("rawrbox::Visibility layers") {
+		auto all = scene.add({box({0, 0, 20}, {1, 1, 1}), 0});
+		auto first = scene.add({box({4, 0, 20}, {1, 1, 1}), 1U << 0U});
+		auto second = scene.add({box({-4, 0, 20}, {1, 1, 1}), 1U << 1U});
+		auto behind = scene.add({box({0, 0, -20}, {1, 1, 1}), 0});
+
+		const auto visible = scene.cull(camera, viewProj, 0); // Copy, the next culls reuse the lists
+		REQUIRE(visible.size() == 3);
+		REQUIRE_FALSE(has(visible, behind));
+
+		const auto& layerA = scene.cull(camera, viewProj, 1U << 0U);
+		REQUIRE(layerA.size() == 2);
+		REQUIRE(has(layerA, all));
+		REQUIRE(has(layerA, first));
+
+		const auto& layerB = scene.cull(camera, viewProj, 1U << 1U);
+		REQUIRE(layerB.size() == 2);
+		REQUIRE(has(layerB, all));
+		REQUIRE(has(layerB, second));
+
+		// Both layers, kept apart
+		REQUIRE(scene.cull(camera, viewProj, (1U << 0U) | (1U << 1U)).size() == 3);
+		REQUIRE(scene.getVisible(camera, 1U << 0U).size() == 2);
+
+		camera.setLayers(1U << 1U);
+		REQUIRE(&scene.getVisible(camera) == &layerB);
+	}
+
+	SECTION("rawrbox::Visibility occlusion") {
+		auto wall = scene.add({box({0, 0, 10.5F}, {5, 5, 0.5F}), 0, true});
+		auto hidden = scene.add({box({0, 0, 20}, {1, 1, 1}), 0});
+		auto front = scene.add({box({0, 0, 5}, {0.5F, 0.5F, 0.5F}), 0});
+		auto side = scene.add({box({9, 0, 20}, {1, 1, 1}), 0}); // Behind, but peeking out
+
+		REQUIRE(scene.cull(camera, viewProj, 0).size() == 4);
+
+		scene.setOcclusion(true);
+		REQUIRE(scene.isOcclusionEnabled());
+
+		const auto& visible = scene.cull(camera, viewProj, 0);
+		REQUIRE(visible.size() == 3);
+		REQUIRE(has(visible, wall)); // Never hides itself
+		REQUIRE(has(visible, front));
+		REQUIRE(has(visible, side));
+		REQUIRE_FALSE(has(visible, hidden));
+
+		// Not an occluder anymore, nothing hidden
+		scene.remove(wall);
+		REQUIRE(scene.cull(camera, viewProj, 0).size() == 3);
+
+		// Only the closest ones are rasterized
+		scene.add({box({0, 0, 10.5F}, {5, 5, 0.5F}), 0, true});
+		scene.add({box({0, 0, 60}, {1, 1, 1}), 0, true});
+		scene.setOcclusion(true, 1);
+		REQUIRE_FALSE(has(scene.cull(camera, viewProj, 0), hidden));
+	}
+
+	SECTION("rawrbox::Visibility handles") {
+		std::vector<int> tags = {0, 1, 2, 3};
+		std::vector<uint32_t> handles = {};
+
+		for (int i = 0; i < 4; i++) {
+			handles.push_back(scene.add({box({static_cast<float>(i) * 3.F - 4.5F, 0, 20}, {1, 1, 1}), 0, false, &tags[i]}));
+		}
+
+		// The last object takes the dense slot of the first, handles stay the same
+		scene.remove(handles[0]);
+		REQUIRE_FALSE(scene.valid(handles[0]));
+		REQUIRE(scene.size() == 3);
+
+		const auto& visible = scene.cull(camera, viewProj, 0);
+		REQUIRE(visible.size() == 3);
+		REQUIRE_FALSE(has(visible, handles[0]));
+
+		for (size_t i = 1; i < handles.size(); i++) {
+			REQUIRE(has(visible, handles[i]));
+			REQUIRE(scene.get(handles[i]).userData == &tags[i]);
+		}
+
+		// Moved out of view, refit
+		scene.update(handles[3], box({0, 0, -20}, {1, 1, 1}));
+		REQUIRE_FALSE(has(scene.cull(camera, viewProj, 0), handles[3]));
+	}
+
+	SECTION("rawrbox::Visibility pruning") {
+		const size_t old = rawrbox::Visibility::MAX_IDLE_CULLS;
+		rawrbox::Visibility::MAX_IDLE_CULLS = 2;
+
+		rawrbox::CameraPerspective other({64, 64}, 90.F, 0.1F, 100.F, false);
+		scene.add({box({0, 0, 20}, {1, 1, 1}), 0});
+
+		std::ignore = scene.cull(camera, viewProj, 0);
+		for (int i = 0; i < 2; i++) {
+			std::ignore = scene.cull(other, viewProj, 0);
+		}
+
+		REQUIRE(scene.getVisible(camera, 0).size() == 1);
+
+		// Idle for too long, dropped
+		std::ignore = scene.cull(other, viewProj, 0);
+		REQUIRE(scene.getVisible(camera, 0).empty());
+		REQUIRE(scene.getVisible(other, 0).size() == 1);
+
+		scene.forget(other);
+		REQUIRE(scene.getVisible(other, 0).empty());
+
+		rawrbox::Visibility::MAX_IDLE_CULLS = old;
+	}
+}
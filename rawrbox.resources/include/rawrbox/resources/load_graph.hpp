@@ -0,0 +1,123 @@
+#pragma once
+
+#include <rawrbox/resources/loader.hpp>
+#include <rawrbox/utils/logger.hpp>
+
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rawrbox {
+	enum class LoadNodeStatus {
+		QUEUED = 0,
+		READING, // Reading the file and finding its dependencies
+		WAITING, // Waiting on dependencies
+		LOADING,
+		LOADED,
+		FAILED
+	};
+
+	// Loads a set of files and everything they depend on (see Loader::dependencies) on the ASYNC pool
+	// Shared files are only loaded once, independent branches load in parallel, and a failure fails every file depending on it
+	// Must be owned by a std::shared_ptr, since pending jobs keep it alive
+	class LoadGraph : public std::enable_shared_from_this<LoadGraph> {
+	protected:
+		struct Node {
+			std::string key;
+			std::filesystem::path path = {};
+			uint32_t flags = 0;
+
+			rawrbox::LoadNodeStatus status = rawrbox::LoadNodeStatus::QUEUED;
+			rawrbox::Loader* loader = nullptr;
+			rawrbox::Resource* resource = nullptr;
+			rawrbox::ResourceData data = {};
+
+			bool owned = false; // Created the resource, instead of finding it on the loader
+
+			std::vector<Node*> dependencies = {};
+			std::vector<Node*> dependents = {};
+			size_t pending = 0; // Dependencies not loaded yet
+
+			std::promise<rawrbox::Resource*> promise = {};
+			std::shared_future<rawrbox::Resource*> future = {};
+		};
+
+		const std::vector<std::unique_ptr<rawrbox::Loader>>& _loaders;
+
+		std::mutex _lock;
+		std::vector<std::function<void()>> _notifications = {}; // Callbacks queued under _lock, called by notify once it's released
+
+		std::recursive_mutex _notifyLock;
+		bool _notifying = false;
+
+		std::unordered_map<std::string, std::unique_ptr<Node>> _nodes = {};
+		std::vector<Node*> _roots = {};
+
+		size_t _done = 0;
+		size_t _failed = 0;
+		bool _started = false;
+		bool _notified = false; // onComplete was called
+		std::atomic<bool> _cancelled = false;
+
+		// LOGGER ------
+		static std::unique_ptr<rawrbox::Logger> _logger;
+		// -------------
+
+		Node* getNode(const std::filesystem::path& filePath, uint32_t loadFlags, bool& created); // Requires _lock
+		[[nodiscard]] bool reaches(const Node* from, const Node* target) const;                    // Requires _lock
+
+		void queue(std::function<void()> notification); // Requires _lock
+		void notify();                                  // Must NOT hold _lock
+
+		void schedule(Node* node);
+		void chain(Node* node);
+		void process(Node* node);
+		void read(Node* node);
+		void load(Node* node);
+
+		void finish(Node* node); // Requires _lock
+		void fail(Node* node, const std::string& error); // Requires _lock
+		void completed();                                 // Requires _lock
+
+		[[nodiscard]] rawrbox::Loader* findLoader(const std::filesystem::path& filePath) const;
+
+	public:
+		// Called once per file, when its job starts
+		std::function<void(const std::filesystem::path&, uint32_t)> onStart = nullptr;
+		// Called once per file when it's loaded or failed, with the finished / total files in the graph (including discovered dependencies)
+		// Calls are serialized, in the same order the counter increases, and never made while holding the graph lock (so they can use it)
+		std::function<void(const std::filesystem::path&, uint32_t, size_t, size_t)> onProgress = nullptr;
+		// Called after every file finished (loaded or failed) with the amount of failed files, and again if more files are added later on
+		std::function<void(size_t)> onComplete = nullptr;
+
+		explicit LoadGraph(const std::vector<std::unique_ptr<rawrbox::Loader>>& loaders);
+		LoadGraph(const LoadGraph&) = delete;
+		LoadGraph(LoadGraph&&) = delete;
+		LoadGraph& operator=(const LoadGraph&) = delete;
+		LoadGraph& operator=(LoadGraph&&) = delete;
+		~LoadGraph() = default;
+
+		// Adding the same file twice returns the same future. Failed files throw on get(), and can be retried on a new graph
+		// Discovered dependencies get the same loadFlags
+		std::shared_future<rawrbox::Resource*> add(const std::filesystem::path& filePath, uint32_t loadFlags = 0);
+		void start();
+
+		// Files not being read / loaded yet fail as cancelled, the ones in progress finish their current step
+		void cancel();
+
+		[[nodiscard]] std::shared_future<rawrbox::Resource*> get(const std::filesystem::path& filePath);
+		[[nodiscard]] rawrbox::LoadNodeStatus getStatus(const std::filesystem::path& filePath);
+
+		[[nodiscard]] size_t total();
+		[[nodiscard]] size_t done();
+		[[nodiscard]] size_t failed();
+		[[nodiscard]] bool isComplete();
+		[[nodiscard]] bool isCancelled() const;
+	};
+} // namespace rawrbox
@@ -1,12 +1,16 @@
 #pragma once
+#include <rawrbox/resources/path_index.hpp>
 #include <rawrbox/resources/resource.hpp>
 #include <rawrbox/utils/logger.hpp>
 #include <rawrbox/utils/path.hpp>
 
 #include <fmt/printf.h>
 
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <span>
+#include <unordered_map>
 #include <vector>
 
 namespace rawrbox {
@@ -14,8 +18,12 @@ namespace rawrbox {
 	protected:
 		std::mutex _threadLock;
 		std::vector<std::unique_ptr<rawrbox::Resource>> _files = {};
+		rawrbox::PathIndex _index = {};
 		std::vector<std::pair<std::filesystem::path, uint32_t>> _preLoadFiles = {};
 
+		// Created but not loaded / failed yet, with whoever is waiting on them. Guarded by _threadLock
+		std::unordered_map<const rawrbox::Resource*, std::vector<std::function<void(bool)>>> _loading = {};
+
 		// LOGGER ------
 		std::unique_ptr<rawrbox::Logger> _logger = std::make_unique<rawrbox::Logger>("RawrBox-Loader");
 		// -------------
@@ -36,42 +44,85 @@ namespace rawrbox {
 		}
 
 		[[nodiscard]] virtual bool hasFile(const std::filesystem::path& filePath) const {
-			return std::ranges::any_of(this->_files, [&filePath](const auto& file) {
-				return rawrbox::PathUtils::isSame(filePath, file->filePath);
-			});
+			return this->_index.has(filePath);
 		}
 		// ----------
 
 		// GET ------
 		template <class T>
 		T* getFile(const std::filesystem::path& filePath) {
-			const std::lock_guard<std::mutex> mutexGuard(_threadLock);
-			for (auto& file : this->_files) {
-				if (!rawrbox::PathUtils::isSame(filePath, file->filePath)) continue;
-				return dynamic_cast<T*>(file.get());
-			}
-
-			return nullptr;
+			return dynamic_cast<T*>(this->_index.get(filePath));
 		}
 
+		// If the path was already created (ex: by another thread), returns that one instead and created is set to false
+		// Passing created means the caller loads it: it's marked as loading until finishLoading is called, see whenLoaded
 		template <class T>
-		T* createResource(const std::filesystem::path& filePath, uint32_t /*flags*/ = 0) {
+		T* createResource(const std::filesystem::path& filePath, uint32_t /*flags*/ = 0, bool* created = nullptr) {
+			if (created != nullptr) *created = false;
+
 			auto obj = this->createEntry();
 			obj->status = rawrbox::LoadStatus::UNLOADED;
 			obj->filePath = filePath;
 
 			// store pointer so we can return it
-			auto* ptr = obj.get();
+			auto* ptr = dynamic_cast<T*>(obj.get());
+			if (ptr == nullptr) return nullptr;
+
+			const std::lock_guard<std::mutex> mutexGuard(_threadLock);
+
+			auto* stored = this->_index.insert(filePath, ptr);
+			if (stored != ptr) return dynamic_cast<T*>(stored); // Lost the race, obj is dropped
+
+			this->_files.push_back(std::move(obj));
+			if (created != nullptr) {
+				*created = true;
+				this->_loading[ptr] = {};
+			}
+
+			return ptr;
+		}
 
+		// Calls back once the resource is loaded (true) or failed (false), right away if it's not being loaded
+		virtual void whenLoaded(const rawrbox::Resource& resource, std::function<void(bool)> callback) {
 			{
 				const std::lock_guard<std::mutex> mutexGuard(_threadLock);
-				this->_files.push_back(std::move(obj));
+
+				auto fnd = this->_loading.find(&resource);
+				if (fnd != this->_loading.end()) {
+					fnd->second.push_back(std::move(callback));
+					return;
+				}
+			}
+
+			callback(resource.status == rawrbox::LoadStatus::LOADED);
+		}
+
+		// Called by whoever created the resource (see createResource), once it's loaded or failed
+		// A failed one is dropped from the index, so the next createResource of the path starts over
+		virtual void finishLoading(const rawrbox::Resource& resource, bool loaded) {
+			std::vector<std::function<void(bool)>> callbacks = {};
+
+			{
+				const std::lock_guard<std::mutex> mutexGuard(_threadLock);
+
+				auto fnd = this->_loading.find(&resource);
+				if (fnd == this->_loading.end()) return;
+
+				callbacks = std::move(fnd->second);
+				this->_loading.erase(fnd);
+
+				// Forget the path so it can be loaded again, the resource itself stays alive (waiters still point to it)
+				if (!loaded && this->_index.get(resource.filePath) == &resource) this->_index.remove(resource.filePath);
 			}
 
-			return dynamic_cast<T*>(ptr);
+			for (auto& callback : callbacks)
+				callback(loaded);
 		}
 		// -----------
 
+		// Files that have to be loaded before this one. Data is empty if the loader doesn't support buffers
+		virtual std::vector<std::filesystem::path> dependencies(const std::filesystem::path& /*filePath*/, std::span<const uint8_t> /*data*/) { return {}; }
+
 		virtual bool canLoad(const std::string& fileExtention) = 0;
 		virtual bool supportsBuffer(const std::string& fileExtention) = 0;
 
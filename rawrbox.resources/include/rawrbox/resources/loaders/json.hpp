@@ -15,6 +15,7 @@ namespace rawrbox {
 
 	public:
 		bool load(const std::vector<uint8_t>& buffer) override;
+		bool load(std::span<const uint8_t> buffer) override;
 		[[nodiscard]] const glz::json_t& get() const;
 	};
 
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <rawrbox/resources/load_graph.hpp>
 #include <rawrbox/resources/loader.hpp>
+#include <rawrbox/resources/pack.hpp>
+#include <rawrbox/resources/path_index.hpp>
 #include <rawrbox/utils/crc.hpp>
 #include <rawrbox/utils/file.hpp>
 #include <rawrbox/utils/threading.hpp>
@@ -9,39 +12,49 @@
 
 #include <filesystem>
 #include <functional>
+#include <future>
+#include <memory>
+#include <shared_mutex>
 #include <string>
 #include <utility>
 #include <vector>
 
 namespace rawrbox {
 	class RESOURCES {
+		friend class rawrbox::LoadGraph;
+
 	protected:
-		static std::mutex _threadLock;
-		static std::vector<std::filesystem::path> _loadedFiles;
+		static rawrbox::PathIndex _index; // Every resource, from all loaders
+		static std::atomic<size_t> _loadedFiles;
 		static std::vector<std::unique_ptr<rawrbox::Loader>> _loaders;
-
-		static std::atomic<size_t> _loadingFiles;
-		static std::atomic<size_t> _loadingPreloadFiles;
+		static std::vector<std::shared_ptr<rawrbox::PackReader>> _packs; // Last mounted first
+		static std::shared_mutex _packsLock;
 
 		// LOGGER ------
 		static std::unique_ptr<rawrbox::Logger> _logger;
 		// -------------
 
 		// LOADS ---
+		static rawrbox::ResourceData readResource(rawrbox::Loader& loader, rawrbox::Resource& resource);
+		static void loadResource(rawrbox::Loader& loader, rawrbox::Resource& resource, const rawrbox::ResourceData& data);
+
 		template <class T = rawrbox::Resource>
 			requires(std::derived_from<T, rawrbox::Resource>)
 		static T* getFileImpl(const std::filesystem::path& filePath) {
-			auto ext = filePath.extension().generic_string();
-			for (auto& loader : _loaders) {
-				if (!loader->canLoad(ext)) continue;
+			return dynamic_cast<T*>(_index.get(filePath));
+		}
 
-				auto ret = loader->getFile<T>(filePath);
-				if (ret == nullptr) continue;
+		// Blocks until whoever is loading it is done. If that failed, the path is free to be loaded again
+		template <class T = rawrbox::Resource>
+			requires(std::derived_from<T, rawrbox::Resource>)
+		static T* waitLoaded(rawrbox::Loader& loader, T* resource) {
+			std::promise<bool> loaded = {};
+			auto future = loaded.get_future();
 
-				return ret;
-			}
+			loader.whenLoaded(*resource, [&loaded](bool success) { loaded.set_value(success); });
+			if (!future.get()) RAWRBOX_CRITICAL("Failed to load file '{}'", resource->filePath.generic_string());
 
-			return nullptr;
+			return resource;
 		}
 
 		template <class T = rawrbox::Resource>
@@ -49,45 +62,41 @@ namespace rawrbox {
 		static T* loadFileImpl(const std::filesystem::path& filePath, uint32_t loadFlags = 0) {
 			std::string path = filePath.generic_string();
 
+			auto ext = filePath.extension().generic_string();
+
 			// check if it's already loaded
 			auto found = getFileImpl<T>(path);
-			if (found != nullptr) return found;
+			if (found != nullptr) {
+				for (auto& loader : _loaders) {
+					if (loader->canLoad(ext)) return waitLoaded(*loader, found);
+				}
+
+				return found;
+			}
 
 			// load file
-			auto ext = filePath.extension().generic_string();
 			for (auto& loader : _loaders) {
 				if (!loader->canLoad(ext)) continue;
 
-				auto ret = loader->createResource<T>(filePath, loadFlags);
+				bool created = false;
+				auto ret = loader->createResource<T>(filePath, loadFlags, &created);
 				if (ret == nullptr) continue;
+				if (!created) return waitLoaded(*loader, ret); // Another thread got to it first
+
+				_index.insert(filePath, ret);
 
 				ret->extention = ext;
 				ret->flags = loadFlags;
 
-				// try to see if the file exists to make a crc32 of it
-				std::vector<uint8_t> buffer = {};
-				if (loader->supportsBuffer(ext)) {
-					buffer = rawrbox::FileUtils::getRawData(filePath);
-					if (buffer.empty()) {
-						RAWRBOX_CRITICAL("Failed to load file '{}'", path);
-					}
-					ret->crc32 = CRC::Calculate(buffer.data(), buffer.size(), CRC::CRC_32());
-				}
-
-				ret->status = rawrbox::LoadStatus::LOADING;
-
-				if (!ret->load(buffer)) RAWRBOX_CRITICAL("Failed to load file '{}'", path);
-				ret->upload();
-
-				ret->status = rawrbox::LoadStatus::LOADED;
-
-				// Add to the list for later on easy access
-				{
-					const std::lock_guard<std::mutex> mutexGuard(_threadLock);
-					_loadedFiles.push_back(filePath);
+				try {
+					loadResource(*loader, *ret, readResource(*loader, *ret));
+				} catch (...) {
+					if (_index.get(filePath) == ret) _index.remove(filePath); // So it can be loaded again
+					loader->finishLoading(*ret, false);
+					throw;
 				}
-				// ---
 
+				loader->finishLoading(*ret, true);
 				return ret;
 			}
 
@@ -104,6 +113,15 @@ namespace rawrbox {
 
 		static const std::vector<std::unique_ptr<rawrbox::Loader>>& getLoaders() { return _loaders; }
 
+		// PACKS ---
+		// Files found on mounted packs are read from them instead of the disk, newer mounts take priority
+		static bool mountPack(const std::filesystem::path& packPath);
+		static bool unmountPack(const std::filesystem::path& packPath);
+		static void unmountPacks();
+
+		[[nodiscard]] static bool isPacked(const std::filesystem::path& filePath);
+		// ---------
+
 		// LOADING ---
 		static void loadFolder(const std::filesystem::path& folderPath, const std::function<void(std::string)>& startLoad = nullptr, const std::function<void(std::string)>& endLoad = nullptr) {
 			for (const auto& p : std::filesystem::recursive_directory_iterator(folderPath)) {
@@ -136,20 +154,29 @@ namespace rawrbox {
 			return loadFileImpl<T>(filePath, loadFlags);
 		}
 
+		// Loads the files and their dependencies, see rawrbox::LoadGraph. onComplete gets the amount of files that failed (0 = all loaded)
 		template <class T = rawrbox::Resource>
 			requires(std::derived_from<T, rawrbox::Resource>)
-		static void loadListAsync(const std::vector<std::pair<std::string, uint32_t>>& files, const std::function<void()>& onComplete = nullptr) {
-			_loadingFiles += files.size();
+		static std::shared_ptr<rawrbox::LoadGraph> loadListAsync(const std::vector<std::pair<std::string, uint32_t>>& files, const std::function<void(size_t)>& onComplete) {
+			auto graph = std::make_shared<rawrbox::LoadGraph>(_loaders);
+			graph->onProgress = [](const std::filesystem::path& path, uint32_t /*flags*/, size_t /*done*/, size_t /*total*/) {
+				_logger->debug("Loaded '{}'", fmt::styled(path.generic_string(), fmt::fg(fmt::color::coral)));
+			};
+			graph->onComplete = onComplete;
 
 			for (const auto& file : files) {
-				rawrbox::ASYNC::run([file, onComplete]() {
-					loadFileImpl<T>(file.first, file.second);
-					_logger->debug("Loaded '{}'", fmt::styled(file.first, fmt::fg(fmt::color::coral)));
-
-					_loadingFiles = std::max<size_t>(_loadingFiles - 1, 0);
-					if (_loadingFiles <= 0 && onComplete != nullptr) onComplete();
-				});
+				graph->add(file.first, file.second);
 			}
+
+			graph->start();
+			return graph;
+		}
+
+		template <class T = rawrbox::Resource>
+			requires(std::derived_from<T, rawrbox::Resource>)
+		static std::shared_ptr<rawrbox::LoadGraph> loadListAsync(const std::vector<std::pair<std::string, uint32_t>>& files, const std::function<void()>& onComplete = nullptr) {
+			if (onComplete == nullptr) return loadListAsync<T>(files, std::function<void(size_t)>{});
+			return loadListAsync<T>(files, std::function<void(size_t)>{[onComplete](size_t /*failed*/) { onComplete(); }});
 		}
 
 		template <class T = rawrbox::Resource>
@@ -191,23 +218,28 @@ namespace rawrbox {
 			}
 		}
 
-		static void startPreLoadQueueAsync(const std::function<void(std::string, uint32_t)>& startLoad = nullptr, const std::function<void(std::string, uint32_t)>& endLoad = nullptr, const std::function<void()>& onComplete = nullptr) {
-			_loadingPreloadFiles += getTotalPreload();
+		static std::shared_ptr<rawrbox::LoadGraph> startPreLoadQueueAsync(const std::function<void(std::string, uint32_t)>& startLoad = nullptr, const std::function<void(std::string, uint32_t)>& endLoad = nullptr, const std::function<void()>& onComplete = nullptr) {
+			auto graph = std::make_shared<rawrbox::LoadGraph>(_loaders);
+			if (startLoad != nullptr) {
+				graph->onStart = [startLoad](const std::filesystem::path& path, uint32_t flags) { startLoad(path.generic_string(), flags); };
+			}
+
+			graph->onProgress = [endLoad](const std::filesystem::path& path, uint32_t flags, size_t /*done*/, size_t /*total*/) {
+				if (endLoad != nullptr) endLoad(path.generic_string(), flags);
+				_logger->debug("Loaded '{}'", fmt::styled(path.generic_string(), fmt::fg(fmt::color::coral)));
+			};
+			if (onComplete != nullptr) {
+				graph->onComplete = [onComplete](size_t /*failed*/) { onComplete(); };
+			}
 
 			for (auto& loader : _loaders) {
 				for (const auto& file : loader->getPreload()) {
-					rawrbox::ASYNC::run([startLoad, &file, endLoad, onComplete]() {
-						if (startLoad != nullptr) startLoad(file.first.generic_string(), file.second);
-						loadFile(file.first, file.second);
-						if (endLoad != nullptr) endLoad(file.first.generic_string(), file.second);
-
-						_logger->debug("Loaded '{}'", fmt::styled(file.first.generic_string(), fmt::fg(fmt::color::coral)));
-
-						_loadingPreloadFiles = std::max<size_t>(_loadingPreloadFiles - 1, 0);
-						if (_loadingPreloadFiles <= 0 && onComplete != nullptr) onComplete();
-					});
+					graph->add(file.first, file.second);
 				}
 			}
+
+			graph->start();
+			return graph;
 		}
 
 		static void startPreLoadQueue(const std::function<void(std::string, uint32_t)>& startLoad = nullptr, const std::function<void(std::string, uint32_t)>& endLoad = nullptr) {
@@ -230,16 +262,19 @@ namespace rawrbox {
 		}
 
 		static size_t filesLoaded() {
-			return _loadedFiles.size();
+			return _loadedFiles;
 		}
 
 		static bool isLoaded(const std::filesystem::path& filePath) {
-			return std::find(_loadedFiles.begin(), _loadedFiles.end(), filePath) != _loadedFiles.end();
+			auto* file = _index.get(filePath);
+			return file != nullptr && file->status == rawrbox::LoadStatus::LOADED;
 		}
 
 		// -----
 		static void shutdown() {
+			_index.clear();
 			_loaders.clear();
+			_packs.clear();
 			_logger.reset();
 		}
 	};
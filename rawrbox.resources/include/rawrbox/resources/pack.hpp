@@ -0,0 +1,106 @@
+#pragma once
+
+#include <rawrbox/utils/mapped_file.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace rawrbox {
+	// Pack layout: header | 4 KiB aligned entries | table of contents (sorted by path hash) | path names
+	namespace PACK {
+		constexpr uint32_t MAGIC = 0x4B504252; // RBPK
+		constexpr uint32_t VERSION = 1;
+		constexpr uint64_t ALIGNMENT = 4096;
+
+		enum ENTRY_FLAGS : uint32_t {
+			NONE = 0,
+			COMPRESSED = 1 << 0, // zlib
+		};
+
+		struct Header {
+			uint32_t magic = MAGIC;
+			uint32_t version = VERSION;
+			uint32_t count = 0;
+			uint32_t alignment = static_cast<uint32_t>(ALIGNMENT);
+
+			uint64_t tocOffset = 0;
+			uint64_t namesOffset = 0;
+			uint64_t namesSize = 0;
+		};
+
+		// Entries are always followed by at least one zero byte, for loaders that expect null terminated text
+		struct Entry {
+			uint64_t hash = 0; // PathUtils::hash of the path key
+			uint64_t offset = 0;
+			uint64_t size = 0;       // Uncompressed
+			uint64_t packedSize = 0; // Stored
+
+			uint32_t crc32 = 0; // Of the uncompressed content, calculated at build time
+			uint32_t flags = ENTRY_FLAGS::NONE;
+
+			uint32_t nameOffset = 0;
+			uint32_t nameSize = 0;
+		};
+
+		static_assert(sizeof(Header) == 40, "Pack header must not have padding");
+		static_assert(sizeof(Entry) == 48, "Pack entry must not have padding");
+	} // namespace PACK
+
+	class PackReader {
+	protected:
+		rawrbox::MappedFile _file = {};
+		std::filesystem::path _path = {};
+
+		std::span<const rawrbox::PACK::Entry> _entries = {};
+		std::string_view _names = {};
+
+	public:
+		PackReader() = default;
+		explicit PackReader(const std::filesystem::path& path);
+
+		bool open(const std::filesystem::path& path);
+		void close();
+
+		[[nodiscard]] const rawrbox::PACK::Entry* find(const std::filesystem::path& path) const;
+		[[nodiscard]] const rawrbox::PACK::Entry* find(std::string_view key, uint64_t hash) const;
+
+		// Points straight to the mapped file, empty if the entry is compressed
+		[[nodiscard]] std::span<const uint8_t> view(const rawrbox::PACK::Entry& entry) const;
+		// Decompresses if needed
+		[[nodiscard]] std::vector<uint8_t> read(const rawrbox::PACK::Entry& entry) const;
+
+		[[nodiscard]] std::string_view getName(const rawrbox::PACK::Entry& entry) const;
+		[[nodiscard]] std::span<const rawrbox::PACK::Entry> getEntries() const;
+		[[nodiscard]] const std::filesystem::path& getPath() const;
+
+		[[nodiscard]] bool valid() const;
+		[[nodiscard]] size_t size() const;
+	};
+
+	class PackWriter {
+	protected:
+		struct File {
+			std::string key;
+			std::vector<uint8_t> data;
+			bool compress = false;
+		};
+
+		std::vector<File> _files = {};
+		std::unordered_map<std::string, size_t> _lookup = {};
+
+	public:
+		// Key is normalized with PathUtils::toKey, compression is only kept if it saves space. Identical content is only stored once
+		void add(const std::filesystem::path& path, std::vector<uint8_t> data, bool compress = false);
+		void addFolder(const std::filesystem::path& folder, bool compress = false);
+
+		bool write(const std::filesystem::path& output) const;
+
+		[[nodiscard]] size_t size() const;
+	};
+} // namespace rawrbox
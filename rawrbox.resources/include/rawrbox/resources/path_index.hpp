@@ -0,0 +1,44 @@
+#pragma once
+
+#include <rawrbox/resources/resource.hpp>
+
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace rawrbox {
+	// Resources keyed by their interned path hash, split in shards so readers rarely contend
+	class PathIndex {
+	protected:
+		struct Entry {
+			std::string key;
+			rawrbox::Resource* resource = nullptr;
+		};
+
+		struct Shard {
+			mutable std::shared_mutex lock;
+			std::unordered_multimap<uint64_t, Entry> entries = {};
+		};
+
+		std::array<Shard, 16> _shards = {};
+		std::atomic<size_t> _size = 0;
+
+		[[nodiscard]] Shard& getShard(uint64_t hash);
+		[[nodiscard]] const Shard& getShard(uint64_t hash) const;
+
+	public:
+		// Returns the already stored resource if the path was taken
+		rawrbox::Resource* insert(const std::filesystem::path& path, rawrbox::Resource* resource);
+		bool remove(const std::filesystem::path& path);
+		void clear();
+
+		[[nodiscard]] rawrbox::Resource* get(const std::filesystem::path& path) const;
+		[[nodiscard]] rawrbox::Resource* get(const std::string& key, uint64_t hash) const;
+		[[nodiscard]] bool has(const std::filesystem::path& path) const;
+
+		[[nodiscard]] size_t size() const;
+	};
+} // namespace rawrbox
@@ -1,5 +1,7 @@
 #pragma once
 #include <filesystem>
+#include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -11,6 +13,14 @@ namespace rawrbox {
 		LOADED
 	};
 
+	// Raw contents of a resource, before it's loaded
+	struct ResourceData {
+		std::vector<uint8_t> buffer = {};           // Read from disk / decompressed
+		std::span<const uint8_t> view = {};         // Points to buffer, or straight to a mapped pack
+		std::shared_ptr<const void> owner = nullptr; // Keeps the memory behind view alive, if not owned
+		uint32_t crc32 = 0;
+	};
+
 	class Resource {
 	public:
 		rawrbox::LoadStatus status = rawrbox::LoadStatus::NONE;
@@ -22,6 +32,8 @@ namespace rawrbox {
 		std::string extention;
 
 		virtual bool load(const std::vector<uint8_t>& buffer);
+		// Packed files point straight to the mapped pack (followed by a null terminator). By default it's copied into load(std::vector)
+		virtual bool load(std::span<const uint8_t> buffer);
 		virtual void upload();
 
 		Resource() = default;
@@ -0,0 +1,399 @@
+#include <rawrbox/resources/load_graph.hpp>
+#include <rawrbox/resources/manager.hpp>
+#include <rawrbox/utils/path.hpp>
+#include <rawrbox/utils/threading.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+
+namespace rawrbox {
+	// LOGGER ------
+	std::unique_ptr<rawrbox::Logger> LoadGraph::_logger = std::make_unique<rawrbox::Logger>("RawrBox-LoadGraph");
+	// -------------
+
+	LoadGraph::LoadGraph(const std::vector<std::unique_ptr<rawrbox::Loader>>& loaders) : _loaders(loaders) {}
+
+	// PROTECTED ----
+	LoadGraph::Node* LoadGraph::getNode(const std::filesystem::path& filePath, uint32_t loadFlags, bool& created) {
+		auto key = rawrbox::PathUtils::toKey(filePath);
+
+		auto fnd = this->_nodes.find(key);
+		if (fnd != this->_nodes.end()) {
+			created = false;
+			return fnd->second.get();
+		}
+
+		auto node = std::make_unique<Node>();
+		node->key = key;
+		node->path = filePath;
+		node->flags = loadFlags;
+		node->future = node->promise.get_future().share();
+
+		created = true;
+		return this->_nodes.emplace(key, std::move(node)).first->second.get();
+	}
+
+	bool LoadGraph::reaches(const Node* from, const Node* target) const {
+		std::vector<const Node*> stack = {from};
+		std::vector<const Node*> visited = {};
+
+		while (!stack.empty()) {
+			const auto* node = stack.back();
+			stack.pop_back();
+
+			if (node == target) return true;
+			if (std::ranges::find(visited, node) != visited.end()) continue;
+			visited.push_back(node);
+
+			for (const auto* dep : node->dependencies)
+				stack.push_back(dep);
+		}
+
+		return false;
+	}
+
+	rawrbox::Loader* LoadGraph::findLoader(const std::filesystem::path& filePath) const {
+		auto ext = filePath.extension().generic_string();
+
+		for (const auto& loader : this->_loaders) {
+			if (loader->canLoad(ext)) return loader.get();
+		}
+
+		return nullptr;
+	}
+
+	void LoadGraph::queue(std::function<void()> notification) {
+		this->_notifications.push_back(std::move(notification));
+	}
+
+	void LoadGraph::notify() {
+		const std::lock_guard<std::recursive_mutex> guard(this->_notifyLock);
+		if (this->_notifying) return; // Called from one of the callbacks, the loop below picks them up in order
+
+		this->_notifying = true;
+
+		try {
+			while (true) {
+				std::vector<std::function<void()>> pending = {};
+
+				{
+					const std::lock_guard<std::mutex> lock(this->_lock);
+					pending.swap(this->_notifications);
+				}
+
+				if (pending.empty()) break;
+				for (auto& notification : pending)
+					notification();
+			}
+		} catch (...) {
+			this->_notifying = false;
+			throw;
+		}
+
+		this->_notifying = false;
+	}
+
+	void LoadGraph::schedule(Node* node) {
+		rawrbox::ASYNC::run([self = this->shared_from_this(), node]() { self->process(node); });
+	}
+
+	void LoadGraph::chain(Node* node) {
+		node->loader->whenLoaded(*node->resource, [self = this->shared_from_this(), node](bool loaded) {
+			{
+				const std::lock_guard<std::mutex> lock(self->_lock);
+
+				if (loaded) {
+					self->finish(node);
+				} else {
+					self->fail(node, "Failed to load outside of the graph");
+				}
+			}
+
+			self->notify();
+		});
+	}
+
+	void LoadGraph::process(Node* node) {
+		rawrbox::LoadNodeStatus status = rawrbox::LoadNodeStatus::FAILED;
+
+		{
+			const std::lock_guard<std::mutex> lock(this->_lock);
+			if (node->status == rawrbox::LoadNodeStatus::QUEUED) node->status = rawrbox::LoadNodeStatus::READING;
+			status = node->status;
+		}
+
+		if (status == rawrbox::LoadNodeStatus::READING) {
+			if (this->onStart != nullptr) this->onStart(node->path, node->flags);
+			this->read(node);
+		} else if (status == rawrbox::LoadNodeStatus::LOADING) {
+			this->load(node);
+		}
+	}
+
+	void LoadGraph::read(Node* node) {
+		std::vector<std::filesystem::path> dependencies = {};
+
+		try {
+			if (this->_cancelled) RAWRBOX_CRITICAL("Cancelled");
+
+			node->loader = this->findLoader(node->path);
+			if (node->loader == nullptr) RAWRBOX_CRITICAL("Attempted to load unknown file extension '{}'. Missing loader!", node->path.generic_string());
+
+			bool created = false;
+
+			node->resource = node->loader->getFile<rawrbox::Resource>(node->path);
+			if (node->resource == nullptr) node->resource = node->loader->createResource<rawrbox::Resource>(node->path, node->flags, &created);
+
+			if (!created) {
+				// Loaded (or still loading) outside of the graph, done once it is
+				this->chain(node);
+				return;
+			}
+
+			node->owned = true;
+			node->resource->extention = node->path.extension().generic_string();
+			node->resource->flags = node->flags;
+			if (&this->_loaders == &rawrbox::RESOURCES::getLoaders()) rawrbox::RESOURCES::_index.insert(node->path, node->resource); // Only the global loaders are indexed globally
+
+			node->data = rawrbox::RESOURCES::readResource(*node->loader, *node->resource);
+			dependencies = node->loader->dependencies(node->path, node->data.view);
+		} catch (const std::exception& e) {
+			{
+				const std::lock_guard<std::mutex> lock(this->_lock);
+				this->fail(node, e.what());
+			}
+
+			this->notify();
+			return;
+		}
+
+		std::vector<Node*> created = {};
+		bool ready = false;
+
+		{
+			const std::lock_guard<std::mutex> lock(this->_lock);
+			if (this->_cancelled) this->fail(node, "Cancelled");
+
+			for (const auto& path : dependencies) {
+				if (node->status != rawrbox::LoadNodeStatus::READING) break;
+
+				bool isNew = false;
+				auto* dep = this->getNode(path, node->flags, isNew); // Dependencies load with the flags of whoever found them first
+				if (isNew) created.push_back(dep);
+
+				if (std::ranges::find(node->dependencies, dep) != node->dependencies.end()) continue;
+				if (dep == node || this->reaches(dep, node)) {
+					this->fail(node, fmt::format("Dependency cycle between '{}' and '{}'", node->path.generic_string(), dep->path.generic_string()));
+					break;
+				}
+
+				node->dependencies.push_back(dep);
+				dep->dependents.push_back(node);
+
+				if (dep->status == rawrbox::LoadNodeStatus::FAILED) {
+					this->fail(node, fmt::format("Dependency '{}' failed", dep->path.generic_string()));
+					break;
+				}
+
+				if (dep->status != rawrbox::LoadNodeStatus::LOADED) node->pending++;
+			}
+
+			if (node->status == rawrbox::LoadNodeStatus::READING) {
+				ready = node->pending == 0;
+				node->status = ready ? rawrbox::LoadNodeStatus::LOADING : rawrbox::LoadNodeStatus::WAITING;
+			}
+
+			for (auto* dep : created)
+				this->schedule(dep);
+		}
+
+		this->notify();
+		if (ready) this->load(node);
+	}
+
+	void LoadGraph::load(Node* node) {
+		try {
+			if (this->_cancelled) RAWRBOX_CRITICAL("Cancelled");
+			rawrbox::RESOURCES::loadResource(*node->loader, *node->resource, node->data);
+		} catch (const std::exception& e) {
+			{
+				const std::lock_guard<std::mutex> lock(this->_lock);
+				this->fail(node, e.what());
+			}
+
+			this->notify();
+			return;
+		}
+
+		node->data = {}; // Not needed anymore
+
+		{
+			const std::lock_guard<std::mutex> lock(this->_lock);
+			this->finish(node);
+		}
+
+		this->notify();
+	}
+
+	void LoadGraph::finish(Node* node) {
+		if (node->status == rawrbox::LoadNodeStatus::LOADED || node->status == rawrbox::LoadNodeStatus::FAILED) return;
+
+		node->status = rawrbox::LoadNodeStatus::LOADED;
+		node->promise.set_value(node->resource);
+		this->_done++;
+
+		this->queue([this, path = node->path, flags = node->flags, done = this->_done, total = this->_nodes.size()]() {
+			if (this->onProgress != nullptr) this->onProgress(path, flags, done, total);
+		});
+
+		if (node->owned) this->queue([loader = node->loader, resource = node->resource]() { loader->finishLoading(*resource, true); });
+
+		for (auto* dependent : node->dependents) {
+			if (dependent->status != rawrbox::LoadNodeStatus::WAITING) continue;
+			if (--dependent->pending != 0) continue;
+
+			dependent->status = rawrbox::LoadNodeStatus::LOADING;
+			this->schedule(dependent);
+		}
+
+		this->completed();
+	}
+
+	void LoadGraph::fail(Node* node, const std::string& error) {
+		if (node->status == rawrbox::LoadNodeStatus::LOADED || node->status == rawrbox::LoadNodeStatus::FAILED) return;
+
+		node->status = rawrbox::LoadNodeStatus::FAILED;
+		node->data = {};
+		node->promise.set_exception(std::make_exception_ptr(std::runtime_error(error)));
+
+		this->_done++;
+		this->_failed++;
+
+		if (!this->_cancelled) this->_logger->warn("Failed to load '{}'\n  └── {}", fmt::styled(node->path.generic_string(), fmt::fg(fmt::color::coral)), error);
+		this->queue([this, path = node->path, flags = node->flags, done = this->_done, total = this->_nodes.size()]() {
+			if (this->onProgress != nullptr) this->onProgress(path, flags, done, total);
+		});
+
+		if (node->owned) {
+			this->queue([this, path = node->path, loader = node->loader, resource = node->resource]() {
+				// Forgotten, so a later load (or graph) can retry it
+				if (&this->_loaders == &rawrbox::RESOURCES::getLoaders() && rawrbox::RESOURCES::_index.get(path) == resource) rawrbox::RESOURCES::_index.remove(path);
+				loader->finishLoading(*resource, false);
+			});
+		}
+
+		for (auto* dependent : node->dependents)
+			this->fail(dependent, fmt::format("Dependency '{}' failed", node->path.generic_string()));
+
+		this->completed();
+	}
+
+	void LoadGraph::completed() {
+		if (!this->_started || this->_notified || this->_done != this->_nodes.size()) return;
+
+		this->_notified = true;
+		this->queue([this, failed = this->_failed]() {
+			if (this->onComplete != nullptr) this->onComplete(failed);
+		});
+	}
+	// --------------
+
+	std::shared_future<rawrbox::Resource*> LoadGraph::add(const std::filesystem::path& filePath, uint32_t loadFlags) {
+		if (filePath.empty()) RAWRBOX_CRITICAL("Attempted to load empty path");
+		std::shared_future<rawrbox::Resource*> future = {};
+
+		{
+			const std::lock_guard<std::mutex> lock(this->_lock);
+
+			bool created = false;
+			auto* node = this->getNode(filePath, loadFlags, created);
+			if (!created) return node->future;
+
+			this->_roots.push_back(node);
+			this->_notified = false;
+
+			if (this->_cancelled) {
+				this->fail(node, "Cancelled");
+			} else if (this->_started) {
+				this->schedule(node);
+			}
+
+			future = node->future;
+		}
+
+		this->notify();
+		return future;
+	}
+
+	void LoadGraph::start() {
+		{
+			const std::lock_guard<std::mutex> lock(this->_lock);
+			if (this->_started) return;
+
+			this->_started = true;
+			for (auto* node : this->_roots) {
+				if (node->status == rawrbox::LoadNodeStatus::QUEUED) this->schedule(node);
+			}
+
+			this->completed(); // Nothing to load
+		}
+
+		this->notify();
+	}
+
+	void LoadGraph::cancel() {
+		this->_cancelled = true;
+
+		{
+			const std::lock_guard<std::mutex> lock(this->_lock);
+
+			for (auto& node : this->_nodes) {
+				if (node.second->status != rawrbox::LoadNodeStatus::QUEUED && node.second->status != rawrbox::LoadNodeStatus::WAITING) continue;
+				this->fail(node.second.get(), "Cancelled");
+			}
+		}
+
+		this->notify();
+	}
+
+	std::shared_future<rawrbox::Resource*> LoadGraph::get(const std::filesystem::path& filePath) {
+		const std::lock_guard<std::mutex> lock(this->_lock);
+
+		auto fnd = this->_nodes.find(rawrbox::PathUtils::toKey(filePath));
+		if (fnd == this->_nodes.end()) RAWRBOX_CRITICAL("File '{}' is not part of the graph", filePath.generic_string());
+
+		return fnd->second->future;
+	}
+
+	rawrbox::LoadNodeStatus LoadGraph::getStatus(const std::filesystem::path& filePath) {
+		const std::lock_guard<std::mutex> lock(this->_lock);
+
+		auto fnd = this->_nodes.find(rawrbox::PathUtils::toKey(filePath));
+		if (fnd == this->_nodes.end()) RAWRBOX_CRITICAL("File '{}' is not part of the graph", filePath.generic_string());
+
+		return fnd->second->status;
+	}
+
+	size_t LoadGraph::total() {
+		const std::lock_guard<std::mutex> lock(this->_lock);
+		return this->_nodes.size();
+	}
+
+	size_t LoadGraph::done() {
+		const std::lock_guard<std::mutex> lock(this->_lock);
+		return this->_done;
+	}
+
+	size_t LoadGraph::failed() {
+		const std::lock_guard<std::mutex> lock(this->_lock);
+		return this->_failed;
+	}
+
+	bool LoadGraph::isComplete() {
+		const std::lock_guard<std::mutex> lock(this->_lock);
+		return this->_done == this->_nodes.size();
+	}
+
+	bool LoadGraph::isCancelled() const { return this->_cancelled; }
+} // namespace rawrbox
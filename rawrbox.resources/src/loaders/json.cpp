@@ -10,7 +10,11 @@ namespace rawrbox {
 	// ------
 
 	bool ResourceJSON::load(const std::vector<uint8_t>& buffer) {
-		auto err = glz::read_json(this->_json, buffer);
+		return this->load(std::span<const uint8_t>(buffer));
+	}
+
+	bool ResourceJSON::load(std::span<const uint8_t> buffer) {
+		auto err = glz::read_json(this->_json, std::string_view(reinterpret_cast<const char*>(buffer.data()), buffer.size())); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
 		if (err != glz::error_code::none) {
 			RAWRBOX_CRITICAL("Failed to load '{}' ──> {}\n", this->filePath.generic_string(), magic_enum::enum_name(err.ec));
 		}
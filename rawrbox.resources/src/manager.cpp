@@ -1,13 +1,15 @@
 #include <rawrbox/resources/loaders/json.hpp>
 #include <rawrbox/resources/manager.hpp>
+#include <rawrbox/utils/profiler.hpp>
 
-namespace rawrbox {
-	std::mutex rawrbox::RESOURCES::_threadLock;
+#include <algorithm>
 
-	std::vector<std::filesystem::path> rawrbox::RESOURCES::_loadedFiles = {};
+namespace rawrbox {
+	rawrbox::PathIndex rawrbox::RESOURCES::_index = {};
+	std::atomic<size_t> rawrbox::RESOURCES::_loadedFiles = 0;
 
-	std::atomic<size_t> rawrbox::RESOURCES::_loadingFiles = 0;
-	std::atomic<size_t> rawrbox::RESOURCES::_loadingPreloadFiles = 0;
+	std::vector<std::shared_ptr<rawrbox::PackReader>> rawrbox::RESOURCES::_packs = {};
+	std::shared_mutex rawrbox::RESOURCES::_packsLock;
 
 	std::vector<std::unique_ptr<rawrbox::Loader>> rawrbox::RESOURCES::_loaders = [] {
 		std::vector<std::unique_ptr<rawrbox::Loader>> defaults;
@@ -18,4 +20,100 @@ namespace rawrbox {
 	// LOGGER ------
 	std::unique_ptr<rawrbox::Logger> rawrbox::RESOURCES::_logger = std::make_unique<rawrbox::Logger>("RawrBox-Resources");
 	// -------------
+
+	// LOADS ---
+	rawrbox::ResourceData RESOURCES::readResource(rawrbox::Loader& loader, rawrbox::Resource& resource) {
+		rawrbox::ResourceData data = {};
+		if (!loader.supportsBuffer(resource.extention)) return data;
+
+		const auto& filePath = resource.filePath;
+		RAWRBOX_PROFILE_ZONE_DETAIL("RESOURCES::read", filePath.generic_string());
+
+		auto key = rawrbox::PathUtils::toKey(filePath);
+		auto hash = rawrbox::PathUtils::hash(key);
+
+		{
+			const std::shared_lock lock(_packsLock);
+			for (const auto& pack : _packs) {
+				const auto* entry = pack->find(key, hash);
+				if (entry == nullptr) continue;
+
+				data.crc32 = entry->crc32; // Calculated when packing
+
+				if ((entry->flags & rawrbox::PACK::COMPRESSED) != 0) {
+					data.buffer = pack->read(*entry);
+					data.buffer.push_back('\0');
+					data.view = data.buffer;
+				} else {
+					data.view = pack->view(*entry); // No copy
+					data.owner = pack;              // Keep it mapped, even if unmounted
+				}
+
+				return data;
+			}
+		}
+
+		data.buffer = rawrbox::FileUtils::getRawData(filePath);
+		if (data.buffer.empty()) RAWRBOX_CRITICAL("Failed to load file '{}'", filePath.generic_string());
+
+		data.crc32 = CRC::Calculate(data.buffer.data(), data.buffer.size() - 1, CRC::CRC_32()); // Without the null terminator, like packs
+		data.view = data.buffer;
+
+		return data;
+	}
+
+	void RESOURCES::loadResource(rawrbox::Loader& loader, rawrbox::Resource& resource, const rawrbox::ResourceData& data) {
+		RAWRBOX_PROFILE_ZONE_DETAIL("RESOURCES::load", resource.filePath.generic_string());
+		resource.status = rawrbox::LoadStatus::LOADING;
+		resource.crc32 = data.crc32;
+
+		bool loaded = false;
+		if (!loader.supportsBuffer(resource.extention) || data.owner == nullptr) {
+			loaded = resource.load(data.buffer);
+		} else {
+			loaded = resource.load(data.view);
+		}
+
+		if (!loaded) RAWRBOX_CRITICAL("Failed to load file '{}'", resource.filePath.generic_string());
+		resource.upload();
+
+		resource.status = rawrbox::LoadStatus::LOADED;
+		_loadedFiles++;
+	}
+	// ---------
+
+	// PACKS ---
+	bool RESOURCES::mountPack(const std::filesystem::path& packPath) {
+		auto pack = std::make_shared<rawrbox::PackReader>();
+		if (!pack->open(packPath)) {
+			_logger->warn("Failed to mount pack '{}'", fmt::styled(packPath.generic_string(), fmt::fg(fmt::color::coral)));
+			return false;
+		}
+
+		_logger->info("Mounted pack '{}' ({} files)", fmt::styled(packPath.generic_string(), fmt::fg(fmt::color::coral)), pack->size());
+
+		const std::unique_lock lock(_packsLock);
+		_packs.insert(_packs.begin(), std::move(pack));
+
+		return true;
+	}
+
+	bool RESOURCES::unmountPack(const std::filesystem::path& packPath) {
+		const std::unique_lock lock(_packsLock);
+		return std::erase_if(_packs, [&packPath](const auto& pack) { return pack->getPath() == packPath; }) > 0;
+	}
+
+	void RESOURCES::unmountPacks() {
+		const std::unique_lock lock(_packsLock);
+		_packs.clear();
+	}
+
+	bool RESOURCES::isPacked(const std::filesystem::path& filePath) {
+		auto key = rawrbox::PathUtils::toKey(filePath);
+		auto hash = rawrbox::PathUtils::hash(key);
+
+		const std::shared_lock lock(_packsLock);
+		return std::ranges::any_of(_packs, [&key, hash](const auto& pack) { return pack->find(key, hash) != nullptr; });
+	}
+	// ---------
 } // namespace rawrbox
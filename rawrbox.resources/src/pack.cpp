@@ -0,0 +1,235 @@
+#include <rawrbox/resources/pack.hpp>
+#include <rawrbox/utils/crc.hpp>
+#include <rawrbox/utils/file.hpp>
+#include <rawrbox/utils/logger.hpp>
+#include <rawrbox/utils/path.hpp>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace rawrbox {
+	// READER ----
+	PackReader::PackReader(const std::filesystem::path& path) {
+		if (!this->open(path)) RAWRBOX_CRITICAL("Failed to open pack '{}'", path.generic_string());
+	}
+
+	bool PackReader::open(const std::filesystem::path& path) {
+		this->close();
+		if (!this->_file.open(path)) return false;
+
+		auto data = this->_file.data();
+		if (data.size() < sizeof(rawrbox::PACK::Header)) {
+			this->close();
+			return false;
+		}
+
+		rawrbox::PACK::Header header = {};
+		std::memcpy(&header, data.data(), sizeof(header));
+
+		const uint64_t tocSize = static_cast<uint64_t>(header.count) * sizeof(rawrbox::PACK::Entry);
+		if (header.magic != rawrbox::PACK::MAGIC || header.version != rawrbox::PACK::VERSION || header.tocOffset + tocSize > data.size() || header.namesOffset + header.namesSize > data.size() || header.tocOffset % alignof(rawrbox::PACK::Entry) != 0) {
+			this->close();
+			return false;
+		}
+
+		this->_path = path;
+		this->_entries = {reinterpret_cast<const rawrbox::PACK::Entry*>(data.data() + header.tocOffset), header.count}; // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		this->_names = {reinterpret_cast<const char*>(data.data() + header.namesOffset), header.namesSize};       // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+		return true;
+	}
+
+	void PackReader::close() {
+		this->_entries = {};
+		this->_names = {};
+		this->_path.clear();
+		this->_file.close();
+	}
+
+	const rawrbox::PACK::Entry* PackReader::find(const std::filesystem::path& path) const {
+		auto key = rawrbox::PathUtils::toKey(path);
+		return this->find(key, rawrbox::PathUtils::hash(key));
+	}
+
+	const rawrbox::PACK::Entry* PackReader::find(std::string_view key, uint64_t hash) const {
+		auto it = std::lower_bound(this->_entries.begin(), this->_entries.end(), hash, [](const rawrbox::PACK::Entry& entry, uint64_t value) { return entry.hash < value; });
+
+		for (; it != this->_entries.end() && it->hash == hash; ++it) {
+			if (this->getName(*it) == key) return &(*it);
+		}
+
+		return nullptr;
+	}
+
+	std::span<const uint8_t> PackReader::view(const rawrbox::PACK::Entry& entry) const {
+		if ((entry.flags & rawrbox::PACK::COMPRESSED) != 0) return {};
+		if (entry.offset + entry.size > this->_file.size()) RAWRBOX_CRITICAL("Corrupted pack entry '{}'", this->getName(entry));
+
+		return this->_file.data().subspan(entry.offset, entry.size);
+	}
+
+	std::vector<uint8_t> PackReader::read(const rawrbox::PACK::Entry& entry) const {
+		if ((entry.flags & rawrbox::PACK::COMPRESSED) == 0) {
+			auto data = this->view(entry);
+			return {data.begin(), data.end()};
+		}
+
+		if (entry.offset + entry.packedSize > this->_file.size()) RAWRBOX_CRITICAL("Corrupted pack entry '{}'", this->getName(entry));
+
+		std::vector<uint8_t> data(entry.size, 0);
+		auto size = static_cast<uLongf>(entry.size);
+
+		if (uncompress(data.data(), &size, this->_file.data().data() + entry.offset, static_cast<uLong>(entry.packedSize)) != Z_OK || size != entry.size) {
+			RAWRBOX_CRITICAL("Failed to decompress pack entry '{}'", this->getName(entry));
+		}
+
+		return data;
+	}
+
+	std::string_view PackReader::getName(const rawrbox::PACK::Entry& entry) const {
+		if (static_cast<size_t>(entry.nameOffset) + entry.nameSize > this->_names.size()) return {};
+		return this->_names.substr(entry.nameOffset, entry.nameSize);
+	}
+
+	std::span<const rawrbox::PACK::Entry> PackReader::getEntries() const { return this->_entries; }
+	const std::filesystem::path& PackReader::getPath() const { return this->_path; }
+
+	bool PackReader::valid() const { return this->_file.valid(); }
+	size_t PackReader::size() const { return this->_entries.size(); }
+	// ----------
+
+	// WRITER ----
+	void PackWriter::add(const std::filesystem::path& path, std::vector<uint8_t> data, bool compress) {
+		auto key = rawrbox::PathUtils::toKey(path);
+
+		auto fnd = this->_lookup.find(key);
+		if (fnd != this->_lookup.end()) {
+			this->_files[fnd->second] = {std::move(key), std::move(data), compress}; // Replace it
+			return;
+		}
+
+		this->_lookup[key] = this->_files.size();
+		this->_files.push_back({std::move(key), std::move(data), compress});
+	}
+
+	void PackWriter::addFolder(const std::filesystem::path& folder, bool compress) {
+		for (const auto& p : std::filesystem::recursive_directory_iterator(folder)) {
+			if (!p.is_regular_file()) continue;
+
+			auto data = rawrbox::FileUtils::getRawData(p.path());
+			if (!data.empty()) data.pop_back(); // Trailing null terminator
+
+			this->add(p.path(), std::move(data), compress);
+		}
+	}
+
+	bool PackWriter::write(const std::filesystem::path& output) const {
+		std::ofstream file(output, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!file) return false;
+
+		auto alignUp = [](uint64_t value) { return (value + rawrbox::PACK::ALIGNMENT - 1) & ~(rawrbox::PACK::ALIGNMENT - 1); };
+		auto pad = [&file](uint64_t from, uint64_t to) {
+			static const std::vector<char> zeros(rawrbox::PACK::ALIGNMENT, 0);
+			while (from < to) {
+				auto count = std::min<uint64_t>(to - from, zeros.size());
+				file.write(zeros.data(), static_cast<std::streamsize>(count));
+				from += count;
+			}
+		};
+
+		std::vector<rawrbox::PACK::Entry> entries = {};
+		std::string names = {};
+
+		// Content hash -> first entry with it, to share the data
+		std::unordered_multimap<uint64_t, size_t> contents = {};
+
+		entries.reserve(this->_files.size());
+
+		// Data ----
+		uint64_t offset = rawrbox::PACK::ALIGNMENT; // Header gets its own page
+		pad(0, offset);
+
+		for (const auto& src : this->_files) {
+			rawrbox::PACK::Entry entry = {};
+			entry.hash = rawrbox::PathUtils::hash(src.key);
+			entry.offset = offset;
+			entry.size = src.data.size();
+			entry.crc32 = CRC::Calculate(src.data.data(), src.data.size(), CRC::CRC_32());
+			entry.nameOffset = static_cast<uint32_t>(names.size());
+			entry.nameSize = static_cast<uint32_t>(src.key.size());
+
+			names += src.key;
+
+			// Already stored? ----
+			const uint64_t contentHash = (static_cast<uint64_t>(entry.crc32) << 32) ^ entry.size;
+			const rawrbox::PACK::Entry* duplicate = nullptr;
+
+			auto range = contents.equal_range(contentHash);
+			for (auto it = range.first; it != range.second; ++it) {
+				if (this->_files[it->second].data != src.data) continue;
+
+				duplicate = &entries[it->second];
+				break;
+			}
+
+			if (duplicate != nullptr) {
+				entry.offset = duplicate->offset;
+				entry.packedSize = duplicate->packedSize;
+				entry.flags = duplicate->flags;
+
+				entries.push_back(entry);
+				continue;
+			}
+
+			contents.emplace(contentHash, entries.size());
+			// ----
+
+			const std::vector<uint8_t>* stored = &src.data;
+			std::vector<uint8_t> packed = {};
+
+			if (src.compress && !src.data.empty()) {
+				auto packedSize = compressBound(static_cast<uLong>(src.data.size()));
+				packed.resize(packedSize);
+
+				// Only worth it if it saves at least an eighth
+				if (compress2(packed.data(), &packedSize, src.data.data(), static_cast<uLong>(src.data.size()), Z_BEST_COMPRESSION) == Z_OK && packedSize < src.data.size() - src.data.size() / 8) {
+					packed.resize(packedSize);
+					stored = &packed;
+					entry.flags |= rawrbox::PACK::COMPRESSED;
+				}
+			}
+
+			entry.packedSize = stored->size();
+			file.write(reinterpret_cast<const char*>(stored->data()), static_cast<std::streamsize>(stored->size())); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+			uint64_t next = alignUp(offset + entry.packedSize + 1); // +1, always leave a null terminator
+			pad(offset + entry.packedSize, next);
+
+			offset = next;
+			entries.push_back(entry);
+		}
+		// ----
+
+		std::stable_sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return a.hash < b.hash; });
+
+		rawrbox::PACK::Header header = {};
+		header.count = static_cast<uint32_t>(entries.size());
+		header.tocOffset = offset;
+		header.namesOffset = offset + entries.size() * sizeof(rawrbox::PACK::Entry);
+		header.namesSize = names.size();
+
+		file.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(rawrbox::PACK::Entry))); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		file.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+		file.seekp(0);
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+		return file.good();
+	}
+
+	size_t PackWriter::size() const { return this->_files.size(); }
+	// ----------
+} // namespace rawrbox
@@ -0,0 +1,85 @@
+#include <rawrbox/resources/path_index.hpp>
+#include <rawrbox/utils/path.hpp>
+
+#include <mutex>
+
+namespace rawrbox {
+	// PROTECTED ----
+	PathIndex::Shard& PathIndex::getShard(uint64_t hash) {
+		return this->_shards[(hash >> 32) % this->_shards.size()];
+	}
+
+	const PathIndex::Shard& PathIndex::getShard(uint64_t hash) const {
+		return this->_shards[(hash >> 32) % this->_shards.size()];
+	}
+	// -------------
+
+	rawrbox::Resource* PathIndex::insert(const std::filesystem::path& path, rawrbox::Resource* resource) {
+		auto key = rawrbox::PathUtils::toKey(path);
+		auto hash = rawrbox::PathUtils::hash(key);
+		auto& shard = this->getShard(hash);
+
+		const std::unique_lock lock(shard.lock);
+
+		auto range = shard.entries.equal_range(hash);
+		for (auto it = range.first; it != range.second; ++it) {
+			if (it->second.key == key) return it->second.resource;
+		}
+
+		shard.entries.emplace(hash, Entry{std::move(key), resource});
+		this->_size++;
+
+		return resource;
+	}
+
+	bool PathIndex::remove(const std::filesystem::path& path) {
+		auto key = rawrbox::PathUtils::toKey(path);
+		auto hash = rawrbox::PathUtils::hash(key);
+		auto& shard = this->getShard(hash);
+
+		const std::unique_lock lock(shard.lock);
+
+		auto range = shard.entries.equal_range(hash);
+		for (auto it = range.first; it != range.second; ++it) {
+			if (it->second.key != key) continue;
+
+			shard.entries.erase(it);
+			this->_size--;
+			return true;
+		}
+
+		return false;
+	}
+
+	void PathIndex::clear() {
+		for (auto& shard : this->_shards) {
+			const std::unique_lock lock(shard.lock);
+			shard.entries.clear();
+		}
+
+		this->_size = 0;
+	}
+
+	rawrbox::Resource* PathIndex::get(const std::filesystem::path& path) const {
+		auto key = rawrbox::PathUtils::toKey(path);
+		return this->get(key, rawrbox::PathUtils::hash(key));
+	}
+
+	rawrbox::Resource* PathIndex::get(const std::string& key, uint64_t hash) const {
+		const auto& shard = this->getShard(hash);
+		const std::shared_lock lock(shard.lock);
+
+		auto range = shard.entries.equal_range(hash);
+		for (auto it = range.first; it != range.second; ++it) {
+			if (it->second.key == key) return it->second.resource;
+		}
+
+		return nullptr;
+	}
+
+	bool PathIndex::has(const std::filesystem::path& path) const {
+		return this->get(path) != nullptr;
+	}
+
+	size_t PathIndex::size() const { return this->_size; }
+} // namespace rawrbox
@@ -3,5 +3,11 @@
 
 namespace rawrbox {
 	bool Resource::load(const std::vector<uint8_t>& /*buffer*/) { return true; };
+	bool Resource::load(std::span<const uint8_t> buffer) {
+		std::vector<uint8_t> data(buffer.begin(), buffer.end());
+		data.push_back('\0');
+
+		return this->load(data);
+	};
 	void Resource::upload(){};
 } // namespace rawrbox
@@ -0,0 +1,348 @@
+#include <rawrbox/resources/load_graph.hpp>
+#include <rawrbox/utils/threading.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+	class MockLoader;
+
+	class MockResource : public rawrbox::Resource {
+		MockLoader* _loader = nullptr;
+
+	public:
+		explicit MockResource(MockLoader* loader) : _loader(loader) {}
+		bool load(const std::vector<uint8_t>& buffer) override;
+	};
+
+	// In-memory files, dependencies come from the deps map
+	class MockLoader : public rawrbox::Loader {
+	public:
+		std::unordered_map<std::string, std::vector<std::filesystem::path>> deps = {};
+		std::unordered_map<std::string, size_t> loads = {};
+		std::unordered_set<std::string> broken = {}; // Fail on load, besides the "fail" ones
+		std::vector<std::string> order = {};
+		std::mutex lock;
+
+		std::promise<void> gateStarted = {};
+		std::shared_future<void> gate = {};
+
+		bool onLoad(const std::filesystem::path& path) {
+			auto name = path.generic_string();
+			if (name == "gate.mock") {
+				gateStarted.set_value();
+				gate.wait();
+			}
+
+			const std::lock_guard<std::mutex> guard(lock);
+			loads[name]++;
+			order.push_back(name);
+
+			return name.find("fail") == std::string::npos && !broken.contains(name);
+		}
+
+		[[nodiscard]] size_t position(const std::string& name) {
+			const std::lock_guard<std::mutex> guard(lock);
+			return static_cast<size_t>(std::distance(order.begin(), std::find(order.begin(), order.end(), name)));
+		}
+
+		std::vector<std::filesystem::path> dependencies(const std::filesystem::path& filePath, std::span<const uint8_t> /*data*/) override {
+			auto fnd = deps.find(filePath.generic_string());
+			return fnd == deps.end() ? std::vector<std::filesystem::path>{} : fnd->second;
+		}
+
+		std::unique_ptr<rawrbox::Resource> createEntry() override { return std::make_unique<MockResource>(this); }
+		bool canLoad(const std::string& fileExtention) override { return fileExtention == ".mock"; }
+		bool supportsBuffer(const std::string& /*fileExtention*/) override { return false; }
+	};
+
+	bool MockResource::load(const std::vector<uint8_t>& /*buffer*/) { return this->_loader->onLoad(this->filePath); }
+
+	void initPool() {
+		static std::once_flag flag;
+		std::call_once(flag, []() { rawrbox::ASYNC::init(4); });
+	}
+
+	std::shared_ptr<rawrbox::LoadGraph> createGraph(const std::vector<std::unique_ptr<rawrbox::Loader>>& loaders, std::promise<void>& complete) {
+		auto graph = std::make_shared<rawrbox::LoadGraph>(loaders);
+		graph->onComplete = [&complete](size_t /*failed*/) { complete.set_value(); };
+		return graph;
+	}
+
+	bool throws(const std::shared_future<rawrbox::Resource*>& future) {
+		try {
+			future.get();
+		} catch (const std::exception&) {
+			return true;
+		}
+
+		return false;
+	}
+} // namespace
+
+TEST_CASE("LoadGraph should behave as expected", "[rawrbox::LoadGraph]") {
+	initPool();
+
+	std::vector<std::unique_ptr<rawrbox::Loader>> loaders = {};
+	loaders.push_back(std::make_unique<MockLoader>());
+	auto* loader = dynamic_cast<MockLoader*>(loaders.front().get());
+
+	std::promise<void> complete = {};
+	auto done = complete.get_future();
+
+	SECTION("rawrbox::LoadGraph::diamond") {
+		loader->deps["top.mock"] = {"left.mock", "right.mock"};
+		loader->deps["left.mock"] = {"base.mock"};
+		loader->deps["right.mock"] = {"./base.mock"};
+
+		auto graph = createGraph(loaders, complete);
+
+		std::vector<size_t> progress = {};
+		size_t lastTotal = 0;
+		graph->onProgress = [&graph, &progress, &lastTotal](const std::filesystem::path& /*path*/, uint32_t /*flags*/, size_t finished, size_t total) {
+			REQUIRE(graph->done() >= finished); // Not called under the graph lock
+			progress.push_back(finished);
+			lastTotal = total;
+		};
+
+		auto top = graph->add("top.mock");
+		auto base = graph->add("base.mock"); // Shared with the dependencies
+		graph->start();
+
+		REQUIRE(done.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+		REQUIRE(top.get() != nullptr);
+		REQUIRE(top.get()->status == rawrbox::LoadStatus::LOADED);
+		REQUIRE(base.get() == graph->get("base.mock").get());
+
+		REQUIRE(graph->total() == 4);
+		REQUIRE(graph->failed() == 0);
+		REQUIRE(loader->loads["base.mock"] == 1);
+
+		REQUIRE(loader->position("base.mock") < loader->position("left.mock"));
+		REQUIRE(loader->position("base.mock") < loader->position("right.mock"));
+		REQUIRE(loader->position("left.mock") < loader->position("top.mock"));
+		REQUIRE(loader->position("right.mock") < loader->position("top.mock"));
+
+		REQUIRE(progress == std::vector<size_t>{1, 2, 3, 4});
+		REQUIRE(lastTotal == 4);
+	}
+
+	SECTION("rawrbox::Loader::createResource") {
+		bool first = false;
+		bool second = true;
+
+		auto* a = loader->createResource<rawrbox::Resource>("dup.mock", 0, &first);
+		auto* b = loader->createResource<rawrbox::Resource>("./dup.mock", 0, &second);
+		REQUIRE(a == b);
+		REQUIRE(first);
+		REQUIRE_FALSE(second);
+
+		// Racing threads all get the same one
+		std::vector<rawrbox::Resource*> results(8, nullptr);
+		std::vector<std::thread> threads = {};
+		for (size_t i = 0; i < results.size(); i++)
+			threads.emplace_back([loader, &results, i]() { results[i] = loader->createResource<rawrbox::Resource>("race.mock"); });
+
+		for (auto& thread : threads)
+			thread.join();
+
+		for (auto* res : results)
+			REQUIRE(res == results.front());
+	}
+
+	SECTION("rawrbox::LoadGraph in flight") {
+		loader->deps["user.mock"] = {"shared.mock"};
+
+		// Created by someone else, not loaded yet
+		bool created = false;
+		auto* shared = loader->createResource<rawrbox::Resource>("shared.mock", 0, &created);
+		REQUIRE(created);
+
+		auto graph = createGraph(loaders, complete);
+		auto user = graph->add("user.mock");
+		graph->start();
+
+		REQUIRE(done.wait_for(std::chrono::milliseconds(100)) == std::future_status::timeout);
+		REQUIRE(graph->getStatus("user.mock") == rawrbox::LoadNodeStatus::WAITING);
+		REQUIRE(loader->loads.count("user.mock") == 0);
+
+		shared->status = rawrbox::LoadStatus::LOADED;
+		loader->finishLoading(*shared, true);
+
+		REQUIRE(done.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+		REQUIRE_FALSE(throws(user));
+		REQUIRE(graph->get("shared.mock").get() == shared);
+		REQUIRE(loader->loads.count("shared.mock") == 0); // Not loaded twice
+	}
+
+	SECTION("rawrbox::LoadGraph in flight failure") {
+		loader->deps["user.mock"] = {"broken.mock"};
+
+		bool created = false;
+		auto* broken = loader->createResource<rawrbox::Resource>("broken.mock", 0, &created);
+
+		size_t failed = 0;
+		auto graph = std::make_shared<rawrbox::LoadGraph>(loaders);
+		graph->onComplete = [&complete, &failed](size_t count) {
+			failed = count;
+			complete.set_value();
+		};
+
+		auto user = graph->add("user.mock");
+		graph->start();
+
+		loader->finishLoading(*broken, false);
+
+		REQUIRE(done.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+		REQUIRE(throws(user));
+		REQUIRE(failed == 2);
+	}
+
+	SECTION("rawrbox::LoadGraph::errors") {
+		loader->deps["model.mock"] = {"texture_fail.mock"};
+		loader->deps["scene.mock"] = {"model.mock", "sky.mock"};
+
+		size_t failed = 0;
+		auto graph = std::make_shared<rawrbox::LoadGraph>(loaders);
+		graph->onComplete = [&graph, &complete, &failed](size_t count) {
+			failed = count;
+			REQUIRE(graph->failed() == count);
+			complete.set_value();
+		};
+
+		auto scene = graph->add("scene.mock");
+		auto other = graph->add("other.mock");
+		graph->start();
+
+		REQUIRE(done.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+		REQUIRE(throws(scene));
+		REQUIRE(throws(graph->get("model.mock")));
+		REQUIRE(throws(graph->get("texture_fail.mock")));
+
+		REQUIRE_FALSE(throws(other));
+		REQUIRE(graph->getStatus("sky.mock") == rawrbox::LoadNodeStatus::LOADED);
+
+		REQUIRE(graph->failed() == 3);
+		REQUIRE(failed == 3);
+		REQUIRE(loader->loads.count("model.mock") == 0);
+		REQUIRE(loader->loads.count("scene.mock") == 0);
+	}
+
+	SECTION("rawrbox::LoadGraph retry") {
+		loader->deps["scene.mock"] = {"flaky.mock"};
+		loader->broken.insert("flaky.mock");
+
+		{
+			auto graph = createGraph(loaders, complete);
+			auto scene = graph->add("scene.mock");
+			graph->start();
+
+			REQUIRE(done.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+			REQUIRE(throws(scene));
+		}
+
+		// Not stuck as failed
+		REQUIRE_FALSE(loader->hasFile("flaky.mock"));
+		REQUIRE_FALSE(loader->hasFile("scene.mock"));
+
+		loader->broken.clear();
+
+		std::promise<void> again = {};
+		auto retried = again.get_future();
+
+		auto graph = createGraph(loaders, again);
+		auto scene = graph->add("scene.mock");
+		graph->start();
+
+		REQUIRE(retried.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+		REQUIRE_FALSE(throws(scene));
+		REQUIRE(loader->loads["flaky.mock"] == 2);
+		REQUIRE(loader->getFile<rawrbox::Resource>("flaky.mock")->status == rawrbox::LoadStatus::LOADED);
+	}
+
+	SECTION("rawrbox::LoadGraph flags") {
+		loader->deps["top.mock"] = {"dep.mock"};
+		loader->deps["dep.mock"] = {"leaf.mock"};
+
+		std::mutex lock;
+		std::unordered_map<std::string, uint32_t> started = {};
+
+		auto graph = createGraph(loaders, complete);
+		graph->onStart = [&lock, &started](const std::filesystem::path& path, uint32_t flags) {
+			const std::lock_guard<std::mutex> guard(lock);
+			started[path.generic_string()] = flags;
+		};
+
+		auto top = graph->add("top.mock", 7);
+		graph->start();
+
+		REQUIRE(done.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+		REQUIRE(top.get()->flags == 7);
+		REQUIRE(graph->get("dep.mock").get()->flags == 7);
+		REQUIRE(graph->get("leaf.mock").get()->flags == 7);
+		REQUIRE(started["leaf.mock"] == 7);
+	}
+
+	SECTION("rawrbox::LoadGraph::cycles") {
+		loader->deps["a.mock"] = {"b.mock"};
+		loader->deps["b.mock"] = {"c.mock"};
+		loader->deps["c.mock"] = {"a.mock"};
+		loader->deps["user.mock"] = {"a.mock"};
+		loader->deps["self.mock"] = {"self.mock"};
+
+		auto graph = createGraph(loaders, complete);
+		graph->add("user.mock");
+		graph->add("self.mock");
+		graph->add("free.mock");
+		graph->start();
+
+		REQUIRE(done.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+		REQUIRE(throws(graph->get("a.mock")));
+		REQUIRE(throws(graph->get("b.mock")));
+		REQUIRE(throws(graph->get("c.mock")));
+		REQUIRE(throws(graph->get("user.mock")));
+		REQUIRE(throws(graph->get("self.mock")));
+		REQUIRE_FALSE(throws(graph->get("free.mock")));
+
+		REQUIRE(graph->failed() == 5);
+		REQUIRE(loader->order == std::vector<std::string>{"free.mock"});
+	}
+
+	SECTION("rawrbox::LoadGraph::cancel") {
+		std::promise<void> release = {};
+		loader->gate = release.get_future().share();
+		auto started = loader->gateStarted.get_future();
+
+		loader->deps["level.mock"] = {"gate.mock"};
+		loader->deps["mod.mock"] = {"level.mock"};
+
+		auto graph = createGraph(loaders, complete);
+		auto mod = graph->add("mod.mock");
+		graph->start();
+
+		REQUIRE(started.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+		graph->cancel();
+		release.set_value();
+
+		REQUIRE(done.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+		REQUIRE(graph->isCancelled());
+		REQUIRE(graph->isComplete());
+
+		REQUIRE(graph->getStatus("gate.mock") == rawrbox::LoadNodeStatus::LOADED); // Was already loading
+		REQUIRE(throws(graph->get("level.mock")));
+		REQUIRE(throws(mod));
+
+		graph->onComplete = nullptr;
+		REQUIRE(throws(graph->add("late.mock")));
+		REQUIRE(loader->loads.count("level.mock") == 0);
+		REQUIRE_FALSE(loader->hasFile("level.mock")); // Cancelled ones can be loaded again later
+	}
+}
@@ -1,8 +1,14 @@
 #include <rawrbox/resources/loaders/json.hpp>
 #include <rawrbox/resources/manager.hpp>
+#include <rawrbox/resources/pack.hpp>
+#include <rawrbox/utils/crc.hpp>
+#include <rawrbox/utils/file.hpp>
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <filesystem>
+#include <string>
+
 TEST_CASE("RESOURCES should behave as expected", "[rawrbox::RESOURCES]") {
 	SECTION("rawrbox::RESOURCES::getLoaders") {
 		REQUIRE(rawrbox::RESOURCES::getLoaders().size() == 1);
@@ -21,4 +27,46 @@ TEST_CASE("RESOURCES should behave as expected", "[rawrbox::RESOURCES]") {
 		rawrbox::RESOURCES::preLoadFile("./assets/json/test.json");
 		REQUIRE(ld->getPreload().size() == 1);
 	}
+
+	SECTION("rawrbox::RESOURCES crc32") {
+		const std::string text = R"({"hello": "world"})";
+		const std::vector<uint8_t> data = {text.begin(), text.end()};
+		const auto crc = CRC::Calculate(data.data(), data.size(), CRC::CRC_32());
+
+		auto packPath = std::filesystem::temp_directory_path() / "rawrbox-crc-test.rpak";
+		{
+			rawrbox::PackWriter writer;
+			writer.add("rawrbox-crc-packed.json", data);
+			writer.add("rawrbox-crc-compressed.json", data, true);
+			REQUIRE(writer.write(packPath));
+		}
+
+		REQUIRE(rawrbox::FileUtils::saveData("rawrbox-crc-loose.json", data));
+		REQUIRE(rawrbox::RESOURCES::mountPack(packPath));
+
+		// Same bytes, same crc, wherever it was loaded from
+		REQUIRE(rawrbox::RESOURCES::loadFile("rawrbox-crc-loose.json")->crc32 == crc);
+		REQUIRE(rawrbox::RESOURCES::loadFile("rawrbox-crc-packed.json")->crc32 == crc);
+		REQUIRE(rawrbox::RESOURCES::loadFile("rawrbox-crc-compressed.json")->crc32 == crc);
+
+		rawrbox::RESOURCES::unmountPacks();
+		std::filesystem::remove("rawrbox-crc-loose.json");
+		std::filesystem::remove(packPath);
+	}
+
+	SECTION("rawrbox::RESOURCES::loadFile retry") {
+		const std::string text = R"({"hello": "again"})";
+		std::filesystem::remove("rawrbox-retry.json");
+
+		// Missing, fails, but isn't remembered as failed
+		REQUIRE_THROWS(rawrbox::RESOURCES::loadFile("rawrbox-retry.json"));
+		REQUIRE_FALSE(rawrbox::RESOURCES::isLoaded("rawrbox-retry.json"));
+		REQUIRE_FALSE(rawrbox::RESOURCES::getLoaders().front()->hasFile("rawrbox-retry.json"));
+
+		REQUIRE(rawrbox::FileUtils::saveData("rawrbox-retry.json", {text.begin(), text.end()}));
+		REQUIRE(rawrbox::RESOURCES::loadFile("rawrbox-retry.json") != nullptr);
+		REQUIRE(rawrbox::RESOURCES::isLoaded("rawrbox-retry.json"));
+
+		std::filesystem::remove("rawrbox-retry.json");
+	}
 }
@@ -0,0 +1,162 @@
+#include <rawrbox/resources/pack.hpp>
+#include <rawrbox/utils/crc.hpp>
+#include <rawrbox/utils/file.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <fmt/format.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+	std::vector<uint8_t> makeData(size_t size, uint8_t seed) {
+		std::vector<uint8_t> data(size);
+		for (size_t i = 0; i < size; i++)
+			data[i] = static_cast<uint8_t>((i * 31 + seed) % 251);
+
+		return data;
+	}
+} // namespace
+
+TEST_CASE("Pack should behave as expected", "[rawrbox::PackReader]") {
+	auto packPath = std::filesystem::temp_directory_path() / "rawrbox-pack-test.rpak";
+
+	auto text = std::string(R"({"hello": "world"})");
+	auto big = makeData(10000, 3);
+	auto repetitive = std::vector<uint8_t>(20000, 'A');
+
+	{
+		rawrbox::PackWriter writer;
+		writer.add("./assets/json/test.json", {text.begin(), text.end()});
+		writer.add("assets/big.bin", big);
+		writer.add("assets/repetitive.txt", repetitive, true);
+		writer.add("assets/copy.bin", big); // Same content, stored once
+		writer.add("assets/empty.bin", {});
+
+		REQUIRE(writer.size() == 5);
+		REQUIRE(writer.write(packPath));
+	}
+
+	SECTION("rawrbox::PackReader::find") {
+		rawrbox::PackReader reader(packPath);
+		REQUIRE(reader.valid());
+		REQUIRE(reader.size() == 5);
+
+		REQUIRE(reader.find("assets/json/test.json") != nullptr);
+		REQUIRE(reader.find("./assets/json/../json/test.json") != nullptr);
+		REQUIRE(reader.find("assets/missing.json") == nullptr);
+
+		// Sorted by hash
+		auto entries = reader.getEntries();
+		for (size_t i = 1; i < entries.size(); i++) {
+			REQUIRE(entries[i - 1].hash <= entries[i].hash);
+		}
+	}
+
+	SECTION("rawrbox::PackReader::view") {
+		rawrbox::PackReader reader(packPath);
+
+		const auto* entry = reader.find("assets/json/test.json");
+		REQUIRE(entry != nullptr);
+		REQUIRE(entry->offset % rawrbox::PACK::ALIGNMENT == 0);
+		REQUIRE(entry->crc32 == CRC::Calculate(text.data(), text.size(), CRC::CRC_32()));
+
+		auto view = reader.view(*entry);
+		REQUIRE(std::string(view.begin(), view.end()) == text);
+		REQUIRE(view.data()[view.size()] == 0); // Null terminated
+
+		const auto* bigEntry = reader.find("assets/big.bin");
+		const auto* copyEntry = reader.find("assets/copy.bin");
+		REQUIRE(bigEntry != nullptr);
+		REQUIRE(copyEntry != nullptr);
+		REQUIRE(bigEntry->offset == copyEntry->offset);
+
+		auto bigView = reader.view(*bigEntry);
+		REQUIRE(std::vector<uint8_t>(bigView.begin(), bigView.end()) == big);
+
+		const auto* emptyEntry = reader.find("assets/empty.bin");
+		REQUIRE(emptyEntry != nullptr);
+		REQUIRE(reader.view(*emptyEntry).empty());
+	}
+
+	SECTION("rawrbox::PackReader::read") {
+		rawrbox::PackReader reader(packPath);
+
+		const auto* entry = reader.find("assets/repetitive.txt");
+		REQUIRE(entry != nullptr);
+		REQUIRE((entry->flags & rawrbox::PACK::COMPRESSED) != 0);
+		REQUIRE(entry->packedSize < entry->size);
+		REQUIRE(reader.view(*entry).empty());
+
+		REQUIRE(reader.read(*entry) == repetitive);
+		REQUIRE(reader.read(*reader.find("assets/big.bin")) == big);
+	}
+
+	SECTION("rawrbox::PackReader::open") {
+		rawrbox::PackReader reader;
+		REQUIRE_FALSE(reader.open(std::filesystem::temp_directory_path() / "rawrbox-missing.rpak"));
+
+		auto badPath = std::filesystem::temp_directory_path() / "rawrbox-bad.rpak";
+		REQUIRE(rawrbox::FileUtils::saveData(badPath, makeData(128, 1)));
+		REQUIRE_FALSE(reader.open(badPath));
+
+		std::filesystem::remove(badPath);
+	}
+
+	std::filesystem::remove(packPath);
+}
+
+TEST_CASE("Pack benchmark", "[rawrbox::PackReader][.benchmark]") {
+	constexpr size_t TOTAL = 1000;
+
+	auto root = std::filesystem::temp_directory_path() / "rawrbox-pack-bench";
+	auto packPath = std::filesystem::temp_directory_path() / "rawrbox-pack-bench.rpak";
+	std::filesystem::create_directories(root);
+
+	std::vector<std::filesystem::path> files = {};
+	rawrbox::PackWriter writer;
+
+	for (size_t i = 0; i < TOTAL; i++) {
+		auto path = root / fmt::format("file_{}.bin", i);
+		auto data = makeData(2048 + (i % 16) * 512, static_cast<uint8_t>(i));
+
+		rawrbox::FileUtils::saveData(path, data);
+		writer.add(path, data);
+		files.push_back(path);
+	}
+
+	REQUIRE(writer.write(packPath));
+	rawrbox::PackReader reader(packPath);
+
+	BENCHMARK("Loose files (1000 files, read + crc)") {
+		uint32_t crc = 0;
+		for (const auto& file : files) {
+			auto data = rawrbox::FileUtils::getRawData(file);
+			crc ^= CRC::Calculate(data.data(), data.size(), CRC::CRC_32());
+		}
+
+		return crc;
+	};
+
+	BENCHMARK("Packed files (1000 files, view + stored crc)") {
+		uint32_t crc = 0;
+		size_t bytes = 0;
+
+		for (const auto& file : files) {
+			const auto* entry = reader.find(file);
+			auto data = reader.view(*entry);
+
+			crc ^= entry->crc32;
+			bytes += data.size();
+		}
+
+		return crc ^ bytes;
+	};
+
+	reader.close();
+	std::filesystem::remove(packPath);
+	std::filesystem::remove_all(root);
+}
@@ -0,0 +1,72 @@
+#include <rawrbox/resources/path_index.hpp>
+#include <rawrbox/utils/path.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <fmt/format.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+TEST_CASE("PathIndex should behave as expected", "[rawrbox::PathIndex]") {
+	SECTION("rawrbox::PathIndex::insert") {
+		rawrbox::PathIndex index;
+		rawrbox::Resource a;
+		rawrbox::Resource b;
+
+		REQUIRE(index.insert("./assets/json/test.json", &a) == &a);
+		REQUIRE(index.insert("assets/json/test.json", &b) == &a); // Already taken
+		REQUIRE(index.size() == 1);
+
+		REQUIRE(index.get("assets/json/test.json") == &a);
+		REQUIRE(index.get("assets/json/../json/test.json") == &a);
+		REQUIRE(index.get(std::filesystem::current_path() / "assets/json/test.json") == &a);
+		REQUIRE(index.get("assets/json/test2.json") == nullptr);
+	}
+
+	SECTION("rawrbox::PathIndex::remove") {
+		rawrbox::PathIndex index;
+		rawrbox::Resource a;
+
+		index.insert("assets/a.json", &a);
+		REQUIRE(index.has("assets/a.json"));
+
+		REQUIRE(index.remove("./assets/a.json"));
+		REQUIRE_FALSE(index.remove("./assets/a.json"));
+		REQUIRE_FALSE(index.has("assets/a.json"));
+		REQUIRE(index.size() == 0);
+	}
+}
+
+TEST_CASE("PathIndex benchmark", "[rawrbox::PathIndex][.benchmark]") {
+	for (size_t total : {500, 5000, 50000}) {
+		rawrbox::PathIndex index;
+
+		std::vector<std::unique_ptr<rawrbox::Resource>> resources(total);
+		std::vector<std::string> paths(total);
+
+		for (size_t i = 0; i < total; i++) {
+			resources[i] = std::make_unique<rawrbox::Resource>();
+			paths[i] = fmt::format("./assets/textures/folder_{}/texture_{}.png", i % 64, i);
+
+			index.insert(paths[i], resources[i].get());
+		}
+
+		std::mt19937 rng(1337);
+		std::uniform_int_distribution<size_t> dist(0, total - 1);
+
+		std::vector<std::string> lookups(1000);
+		for (auto& lookup : lookups)
+			lookup = paths[dist(rng)];
+
+		BENCHMARK(fmt::format("1000 lookups ({} resources)", total)) {
+			size_t found = 0;
+			for (const auto& lookup : lookups)
+				found += index.get(lookup) != nullptr ? 1 : 0;
+
+			return found;
+		};
+	}
+}
@@ -0,0 +1,66 @@
+#include <rawrbox/resources/pack.hpp>
+#include <rawrbox/utils/file.hpp>
+
+#include <fmt/format.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Usage:
+//   rawrbox-pack [--compress] <output.rpak> <folder / file>...
+//   rawrbox-pack --list <input.rpak>
+int main(int argc, char* argv[]) {
+	std::vector<std::string> args(argv + 1, argv + argc);
+
+	if (args.size() == 2 && args[0] == "--list") {
+		rawrbox::PackReader reader;
+		if (!reader.open(args[1])) {
+			fmt::print(stderr, "Failed to open pack '{}'\n", args[1]);
+			return 1;
+		}
+
+		for (const auto& entry : reader.getEntries()) {
+			bool compressed = (entry.flags & rawrbox::PACK::COMPRESSED) != 0;
+			fmt::print("{:016x}  {:>10}  {:>10}  {:08x}  {}{}\n", entry.hash, entry.size, entry.packedSize, entry.crc32, reader.getName(entry), compressed ? " (compressed)" : "");
+		}
+
+		return 0;
+	}
+
+	bool compress = false;
+	if (!args.empty() && args[0] == "--compress") {
+		compress = true;
+		args.erase(args.begin());
+	}
+
+	if (args.size() < 2) {
+		fmt::print(stderr, "Usage:\n  rawrbox-pack [--compress] <output.rpak> <folder / file>...\n  rawrbox-pack --list <input.rpak>\n");
+		return 1;
+	}
+
+	rawrbox::PackWriter writer;
+	for (size_t i = 1; i < args.size(); i++) {
+		std::filesystem::path input = args[i];
+
+		if (std::filesystem::is_directory(input)) {
+			writer.addFolder(input, compress);
+		} else if (std::filesystem::is_regular_file(input)) {
+			auto data = rawrbox::FileUtils::getRawData(input);
+			if (!data.empty()) data.pop_back(); // Trailing null terminator
+
+			writer.add(input, std::move(data), compress);
+		} else {
+			fmt::print(stderr, "Input '{}' not found\n", input.generic_string());
+			return 1;
+		}
+	}
+
+	if (!writer.write(args[0])) {
+		fmt::print(stderr, "Failed to write pack '{}'\n", args[0]);
+		return 1;
+	}
+
+	fmt::print("Packed {} files into '{}'\n", writer.size(), args[0]);
+	return 0;
+}
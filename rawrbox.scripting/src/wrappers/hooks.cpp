@@ -1,4 +1,5 @@
 #include <rawrbox/scripting/wrappers/hooks.hpp>
+#include <rawrbox/utils/profiler.hpp>
 
 namespace rawrbox {
 	// PRIVATE -----
@@ -6,6 +7,7 @@ namespace rawrbox {
 	// -------------
 
 	void Hooks::call(const std::string& id, const luabridge::LuaRef& args) {
+		RAWRBOX_PROFILE_ZONE_DETAIL("Hooks::call", id);
 		for (auto& hook : _hooks[id]) {
 			auto result = luabridge::call(hook.func, args);
 			if (result.hasFailed()) fmt::print("Lua error\n  └── {}\n", result.errorMessage());
@@ -1,14 +1,13 @@
 #pragma once
 
 #include <rawrbox/math/color.hpp>
+#include <rawrbox/render/text/font.hpp>
 #include <rawrbox/ui/container.hpp>
 
 #include <filesystem>
 #include <string>
 
 namespace rawrbox {
-	class Font;
-
 	class UILabel : public rawrbox::UIContainer {
 		rawrbox::Color _color = rawrbox::Colors::White();
 		rawrbox::Color _shadowColor = rawrbox::Colors::Transparent();
@@ -20,6 +19,9 @@ namespace rawrbox {
 		std::string _text;
 		rawrbox::Vector2f _shadow = {1, 1};
 
+		float _wrapWidth = 0.F; // 0 = no wrapping
+		rawrbox::Alignment _alignment = rawrbox::Alignment::Left;
+
 	public:
 		UILabel(rawrbox::UIRoot* root);
 		UILabel(const UILabel&) = default;
@@ -47,6 +49,12 @@ namespace rawrbox {
 		virtual void setText(const std::string& text);
 		[[nodiscard]] virtual const std::string& getText() const;
 
+		virtual void setWrapWidth(float width);
+		[[nodiscard]] virtual float getWrapWidth() const;
+
+		virtual void setAlignment(rawrbox::Alignment alignment);
+		[[nodiscard]] virtual rawrbox::Alignment getAlignment() const;
+
 		virtual void setFont(rawrbox::Font* font);
 		virtual void setFont(const std::filesystem::path& font, uint16_t size = 11);
 		[[nodiscard]] virtual rawrbox::Font* getFont() const;
@@ -3,6 +3,7 @@
 #include <rawrbox/render/static.hpp>
 #include <rawrbox/render/stencil.hpp>
 #include <rawrbox/render/text/font.hpp>
+#include <rawrbox/render/text/layout.hpp>
 #include <rawrbox/resources/manager.hpp>
 #include <rawrbox/ui/elements/label.hpp>
 
@@ -33,6 +34,12 @@ namespace rawrbox {
 	void UILabel::setText(const std::string& text) { this->_text = text; }
 	const std::string& UILabel::getText() const { return this->_text; }
 
+	void UILabel::setWrapWidth(float width) { this->_wrapWidth = width; }
+	float UILabel::getWrapWidth() const { return this->_wrapWidth; }
+
+	void UILabel::setAlignment(rawrbox::Alignment alignment) { this->_alignment = alignment; }
+	rawrbox::Alignment UILabel::getAlignment() const { return this->_alignment; }
+
 	void UILabel::setFont(const std::filesystem::path& font, uint16_t size) {
 		this->_font = rawrbox::RESOURCES::getFile<rawrbox::ResourceFont>(font)->getSize(size);
 	}
@@ -46,7 +53,7 @@ namespace rawrbox {
 
 	void UILabel::sizeToContents() {
 		if (this->_font == nullptr) return;
-		this->setSize(this->_font->getStringSize(this->_text));
+		this->setSize(rawrbox::TextLayout::get(*this->_font, this->_text, this->_wrapWidth, this->_alignment)->size);
 	}
 	// ----------
 
@@ -54,8 +61,10 @@ namespace rawrbox {
 	void UILabel::draw(Stencil& stencil) {
 		if (this->_font == nullptr) return;
 
-		stencil.drawText(*this->_font, this->_text, this->_shadow, this->_shadowColor);
-		stencil.drawText(*this->_font, this->_text, {0, 0}, this->_color);
+		const auto run = rawrbox::TextLayout::get(*this->_font, this->_text, this->_wrapWidth, this->_alignment);
+
+		stencil.drawText(*this->_font, *run, this->_shadow, this->_shadowColor);
+		stencil.drawText(*this->_font, *run, {0, 0}, this->_color);
 	}
 	// ----------
 } // namespace rawrbox
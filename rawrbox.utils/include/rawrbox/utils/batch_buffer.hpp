@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rawrbox {
+	// Many threads push, one thread collects once they are done (ex: contacts from the physics workers, read after the update)
+	// Pushing is a single atomic add into preallocated storage, the mutex is only hit when it runs out,
+	// and the next collect grows it so it doesn't happen again
+	// Items come out in push order (the order the slots got handed out), so it can also carry commands
+	template <typename T>
+	class BatchBuffer {
+		static_assert(std::is_default_constructible_v<T> && std::is_move_assignable_v<T>, "BatchBuffer items should be default constructible and movable");
+
+	protected:
+		std::vector<T> _items = {};
+		std::atomic<size_t> _count = 0;
+
+		std::mutex _overflowLock;
+		std::vector<std::pair<size_t, T>> _overflow = {}; // With their slot, to keep the order
+
+	public:
+		explicit BatchBuffer(size_t capacity = 1024) : _items(std::max<size_t>(capacity, 1)) {}
+
+		// Any thread, returns where it will be in the next collect
+		size_t push(T item) {
+			const size_t index = this->_count.fetch_add(1, std::memory_order_relaxed);
+			if (index < this->_items.size()) {
+				this->_items[index] = std::move(item);
+				return index;
+			}
+
+			std::scoped_lock lock(this->_overflowLock);
+			this->_overflow.emplace_back(index, std::move(item));
+			return index;
+		}
+
+		// NOT thread safe against push, moves everything pushed since the last collect into out (in push order) and empties the buffer
+		void collect(std::vector<T>& out) {
+			const size_t count = std::min(this->_count.load(std::memory_order_acquire), this->_items.size());
+			out.insert(out.end(), std::make_move_iterator(this->_items.begin()), std::make_move_iterator(this->_items.begin() + static_cast<std::ptrdiff_t>(count)));
+
+			if (!this->_overflow.empty()) {
+				// Threads can grab the lock in any order
+				std::sort(this->_overflow.begin(), this->_overflow.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+				for (auto& item : this->_overflow) {
+					out.push_back(std::move(item.second));
+				}
+
+				this->_items.resize((this->_items.size() + this->_overflow.size()) * 2);
+				this->_overflow.clear();
+			}
+
+			this->_count.store(0, std::memory_order_release);
+		}
+
+		void clear() {
+			this->_count.store(0, std::memory_order_release);
+			this->_overflow.clear();
+		}
+
+		[[nodiscard]] size_t size() const { return this->_count.load(std::memory_order_acquire); }
+		[[nodiscard]] size_t capacity() const { return this->_items.size(); }
+		[[nodiscard]] bool empty() const { return this->size() == 0; }
+	};
+} // namespace rawrbox
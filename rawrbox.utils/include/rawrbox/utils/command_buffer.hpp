@@ -0,0 +1,56 @@
+#pragma once
+
+#include <rawrbox/utils/batch_buffer.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace rawrbox {
+	// Deferred commands, recorded from any thread and applied all at once on a single one (ex: right before the physics update)
+	// Handles are handed out on record, so a command can already target something an earlier (not applied yet) command creates
+	//
+	// auto handle = buffer.reserve();
+	// buffer.push({Type::CREATE, handle});
+	// buffer.push({Type::IMPULSE, handle, ...}); // Same frame, fine
+	// buffer.apply([](Command& command) { ... }); // In push order
+	template <typename T>
+	class CommandBuffer {
+	protected:
+		rawrbox::BatchBuffer<T> _buffer;
+		std::vector<T> _commands = {};
+
+		std::atomic<uint32_t> _lastHandle = 0;
+
+	public:
+		explicit CommandBuffer(size_t capacity = 1024) : _buffer(capacity) {}
+
+		// Any thread ---
+		// Never 0, and never reused (not even after clear)
+		[[nodiscard]] uint32_t reserve() { return this->_lastHandle.fetch_add(1, std::memory_order_relaxed) + 1; }
+		size_t push(T command) { return this->_buffer.push(std::move(command)); }
+		// ---
+
+		// NOT thread safe against push, runs everything pushed so far in push order. Commands pushed by func run on the next apply
+		template <typename F>
+		size_t apply(F&& func) {
+			this->_commands.clear();
+			this->_buffer.collect(this->_commands);
+
+			for (auto& command : this->_commands) {
+				func(command);
+			}
+
+			const size_t count = this->_commands.size();
+			this->_commands.clear();
+
+			return count;
+		}
+
+		void clear() { this->_buffer.clear(); }
+
+		[[nodiscard]] size_t size() const { return this->_buffer.size(); }
+		[[nodiscard]] bool empty() const { return this->_buffer.empty(); }
+	};
+} // namespace rawrbox
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace rawrbox {
+	struct DirtyRange {
+		uint32_t start = 0;
+		uint32_t end = 0; // Exclusive
+
+		[[nodiscard]] uint32_t count() const { return end - start; }
+	};
+
+	// Tracks modified element ranges, so only the changed spans of a buffer get uploaded
+	class DirtyRanges {
+	protected:
+		std::vector<rawrbox::DirtyRange> _ranges = {}; // Sorted, non overlapping
+		uint32_t _gap = 0;
+		size_t _maxRanges = 0;
+
+		void collapse();
+
+	public:
+		// Ranges closer than gap get merged, past maxRanges the closest ones are merged together
+		explicit DirtyRanges(uint32_t gap = 16, size_t maxRanges = 64);
+
+		void mark(uint32_t index);
+		void mark(uint32_t start, uint32_t end);
+
+		// Drops anything past size (ex: after the buffer shrunk)
+		void clamp(uint32_t size);
+		void clear();
+
+		[[nodiscard]] const std::vector<rawrbox::DirtyRange>& get() const;
+		[[nodiscard]] bool empty() const;
+
+		// Total marked elements
+		[[nodiscard]] uint32_t count() const;
+	};
+} // namespace rawrbox
@@ -1,47 +1,216 @@
-﻿#pragma once
+#pragma once
 
-#include <algorithm>
-#include <functional>
+#include <rawrbox/utils/small_function.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace rawrbox {
+	// Returned when subscribing, used to unsubscribe
+	struct EventToken {
+		uint64_t id = 0;
+
+		[[nodiscard]] bool valid() const { return id != 0; }
+		bool operator==(const EventToken& other) const = default;
+	};
+
+	// Handlers can subscribe / unsubscribe (even themselves) while it's being called, without copying the handler list
+	// Handlers added during a call are first called on the next one
+	//
+	// It can be called from several threads at once (ex: physics contacts from the job threads), and add / remove / clear are safe from any thread
+	// Changes made while calling are applied by the last call to finish. A handler removed from another thread might still be running
 	template <typename... CallbackArgs>
 	class Event {
 	public:
-		using Func = std::function<void(CallbackArgs...)>;
+		using Func = rawrbox::SmallFunction<void(CallbackArgs...)>;
+
+	protected:
+		struct Handler {
+			uint64_t id = 0;
+			std::atomic<bool> removed = false; // Erased once nothing is calling
+			Func func = nullptr;
+
+			Handler(uint64_t handlerId, Func callback) : id(handlerId), func(std::move(callback)) {}
+			Handler(const Handler& other) : id(other.id), removed(other.removed.load()), func(other.func) {}
+			Handler(Handler&& other) noexcept : id(other.id), removed(other.removed.load()), func(std::move(other.func)) {}
+			Handler& operator=(const Handler& other) {
+				this->id = other.id;
+				this->removed = other.removed.load();
+				this->func = other.func;
+				return *this;
+			}
+			Handler& operator=(Handler&& other) noexcept {
+				this->id = other.id;
+				this->removed = other.removed.load();
+				this->func = std::move(other.func);
+				return *this;
+			}
+			~Handler() = default;
+		};
+
+		std::mutex _lock; // Changes only, calls never take it
+		std::vector<Handler> _calls = {};
+		std::vector<Handler> _pending = {}; // Added while calling
+
+		uint64_t _lastId = 0;
+		std::atomic<size_t> _count = 0;
+
+		std::atomic<uint32_t> _calling = 0;
+		std::atomic<bool> _changing = false; // _calls is being resized / erased from, calls wait for it
+		std::atomic<bool> _dirty = false;    // Something to flush once nothing is calling
+
+		// Requires _lock, and _dirty set before calling it. Flushes the changes if nothing is calling, otherwise the last call to finish does
+		void change() {
+			this->_changing = true;
+			if (this->_calling == 0) this->flush();
+			this->_changing = false;
+		}
 
+		void flush() {
+			if (!this->_dirty) return;
+
+			std::erase_if(this->_calls, [](const Handler& handler) { return handler.removed.load(); });
+			for (auto& handler : this->_pending) {
+				this->_calls.push_back(std::move(handler));
+			}
+
+			this->_pending.clear();
+			this->_dirty = false;
+		}
+
+	public:
 		Event() = default;
-		explicit Event(Func callback) { (*this) += callback; }
-		explicit Event(Func& callback) { (*this) += callback; }
+		explicit Event(Func callback) { this->add(std::move(callback)); }
+
+		Event(const Event& other) { *this = other; }
+		Event(Event&& other) { *this = std::move(other); }
+		Event& operator=(const Event& other) {
+			if (this == &other) return *this;
 
-		Event& operator+=(Func callback) {
-			calls.push_back(callback);
+			std::vector<Handler> handlers = {};
+			{
+				const std::scoped_lock lock(const_cast<Event&>(other)._lock);
+
+				for (const auto& handler : other._calls) {
+					if (!handler.removed) handlers.push_back(handler);
+				}
+
+				handlers.insert(handlers.end(), other._pending.begin(), other._pending.end());
+			}
+
+			this->clear();
+
+			const std::scoped_lock lock(this->_lock);
+			for (auto& handler : handlers) {
+				handler.id = ++this->_lastId;
+				this->_pending.push_back(std::move(handler));
+			}
+
+			this->_count = this->_pending.size();
+			this->_dirty = true;
+			this->change();
+
+			return *this;
+		}
+		Event& operator=(Event&& other) {
+			*this = static_cast<const Event&>(other);
+			other.clear();
 			return *this;
 		}
+		~Event() = default;
 
-		bool operator==(Event& right) { return calls == right.calls; }
-		bool operator!=(Event& right) { return !(this == &right); }
+		rawrbox::EventToken add(Func callback) {
+			const std::scoped_lock lock(this->_lock);
 
-		Func& operator[](int i) { return calls[i]; }
+			const uint64_t id = ++this->_lastId;
+			this->_count++;
+
+			// Moved to _calls right away if nothing is calling, don't move the handlers being called
+			this->_pending.emplace_back(id, std::move(callback));
+			this->_dirty = true;
+			this->change();
+
+			return {id};
+		}
 
-		size_t size() { return calls.size(); }
-		bool empty() { return calls.empty(); }
-		void clear() { calls.clear(); }
+		bool remove(const rawrbox::EventToken& token) {
+			if (!token.valid()) return false;
+			const std::scoped_lock lock(this->_lock);
+
+			auto pending = std::ranges::find(this->_pending, token.id, &Handler::id);
+			if (pending != this->_pending.end()) {
+				this->_pending.erase(pending);
+				this->_count--;
+				return true;
+			}
+
+			auto fnd = std::ranges::find(this->_calls, token.id, &Handler::id);
+			if (fnd == this->_calls.end() || fnd->removed) return false;
+
+			fnd->removed = true; // Might be the one running, keep it alive until the call is over
+			this->_dirty = true;
+			this->_count--;
+
+			this->change();
+			return true;
+		}
 
-		Event& operator-=(Func callback) {
-			calls.erase(std::remove_if(calls.begin(), calls.end(), [&](const Func& func) { return func.target_type() == callback.target_type(); }), calls.end());
+		rawrbox::EventToken operator+=(Func callback) { return this->add(std::move(callback)); }
+		Event& operator-=(const rawrbox::EventToken& token) {
+			this->remove(token);
 			return *this;
 		}
 
-		void operator()(CallbackArgs... args) {
-			// copy it so we can += and -= inside the callback
-			auto callsCopy = calls;
-			for (const auto& callback : callsCopy) {
-				callback(args...);
+		[[nodiscard]] size_t size() const { return this->_count; }
+		[[nodiscard]] bool empty() const { return this->_count == 0; }
+
+		void clear() {
+			const std::scoped_lock lock(this->_lock);
+
+			this->_pending.clear();
+			this->_count = 0;
+
+			for (auto& handler : this->_calls) {
+				handler.removed = true;
 			}
+
+			this->_dirty = true;
+			this->change();
 		}
 
-	private:
-		std::vector<Func> calls = {};
+		void operator()(CallbackArgs... args) {
+			struct Scope {
+				Event* event;
+				explicit Scope(Event* e) : event(e) {
+					event->_calling++;
+					while (event->_changing) std::this_thread::yield(); // Someone is resizing _calls, it's quick
+				}
+
+				~Scope() {
+					if (--event->_calling > 0 || !event->_dirty) return;
+
+					const std::scoped_lock lock(event->_lock);
+					event->change();
+				}
+
+				Scope(const Scope&) = delete;
+				Scope(Scope&&) = delete;
+				Scope& operator=(const Scope&) = delete;
+				Scope& operator=(Scope&&) = delete;
+			} scope(this);
+
+			// By index, nothing is added to / erased from _calls until every call is over
+			const size_t count = this->_calls.size();
+			for (size_t i = 0; i < count; i++) {
+				const auto& handler = this->_calls[i];
+				if (handler.removed.load(std::memory_order_relaxed)) continue;
+
+				handler.func(args...);
+			}
+		}
 	};
 } // namespace rawrbox
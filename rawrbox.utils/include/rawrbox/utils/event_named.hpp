@@ -1,75 +1,74 @@
 #pragma once
 
-#include <atomic>
-#include <functional>
-#include <map>
-#include <memory>
+#include <rawrbox/utils/event.hpp>
+
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 namespace rawrbox {
+	// Event where handlers can also be replaced / removed by name, same threading rules as rawrbox::Event
 	template <typename... CallbackArgs>
 	class EventNamed {
-		std::atomic<size_t> uniqueId = 0;
-
 	public:
-		using Func = std::function<void(CallbackArgs...)>;
+		using Func = typename rawrbox::Event<CallbackArgs...>::Func;
 
-		class EventScoped {
-			EventNamed<CallbackArgs...>* map = nullptr;
-			std::string name;
+	protected:
+		rawrbox::Event<CallbackArgs...> _event = {};
 
-		public:
-			void call(CallbackArgs... args) {
-				if (map == nullptr) return;
+		mutable std::mutex _lock;
+		std::unordered_map<std::string, rawrbox::EventToken> _names = {};
 
-				auto cb = map->find(name);
-				if (cb == map->end()) return;
+	public:
+		EventNamed() = default;
 
-				cb->second(args...);
-			}
-		};
+		rawrbox::EventToken add(Func callback) {
+			return this->_event.add(std::move(callback));
+		}
 
-		EventNamed() = default;
+		// Replaces the handler with the same name
+		rawrbox::EventToken add(const std::string& name, Func callback) {
+			const std::scoped_lock lock(this->_lock);
 
-		std::shared_ptr<EventScoped> add(Func callback) {
-			std::string name = "__" + std::to_string(uniqueId++) + "__";
-			calls[name] = callback;
+			auto& token = this->_names[name];
+			this->_event.remove(token);
 
-			return std::make_shared<EventScoped>(this, name);
+			token = this->_event.add(std::move(callback));
+			return token;
 		}
 
-		void add(const std::string& name, Func callback) {
-			calls[name] = callback;
+		[[nodiscard]] bool exists(const std::string& name) const {
+			const std::scoped_lock lock(this->_lock);
+			return this->_names.contains(name);
 		}
 
-		Func& operator[](const std::string& name) { return calls[name]; }
-		auto find(const std::string& name) { return calls.find(name); }
-		auto begin() { return calls.begin(); }
-		auto end() { return calls.end(); }
-
-		size_t size() { return calls.size(); }
+		[[nodiscard]] size_t size() const { return this->_event.size(); }
+		[[nodiscard]] bool empty() const { return this->_event.empty(); }
 
 		void clear() {
-			calls.clear();
+			const std::scoped_lock lock(this->_lock);
+
+			this->_event.clear();
+			this->_names.clear();
 		}
 
 		bool remove(const std::string& name) {
-			auto found = calls.find(name);
-			if (found == calls.end()) return false;
+			const std::scoped_lock lock(this->_lock);
+
+			auto found = this->_names.find(name);
+			if (found == this->_names.end()) return false;
 
-			calls.erase(found);
+			this->_event.remove(found->second);
+			this->_names.erase(found);
 			return true;
 		}
 
-		void operator()(CallbackArgs... args) {
-			// copy it so we can += and -= inside the callback
-			auto callsCopy = calls;
-			for (const auto& pair : callsCopy) {
-				pair.second(args...);
-			}
+		bool remove(const rawrbox::EventToken& token) {
+			return this->_event.remove(token); // Named handlers keep their entry until replaced / removed by name
 		}
 
-	private:
-		std::map<std::string, Func> calls;
+		void operator()(CallbackArgs... args) {
+			this->_event(args...);
+		}
 	};
 } // namespace rawrbox
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <filesystem>
 #include <functional>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace rawrbox {
 	enum class FileStatus {
@@ -13,25 +17,69 @@ namespace rawrbox {
 		erased
 	};
 
+	enum class FileWatcherMode {
+		AUTO = 0, // Native (inotify on linux) if available, polling otherwise
+		POLLING
+	};
+
+	// Changes are debounced by the delay, so a burst of writes / an editor's save-to-temp-then-rename is a single modified event
+	// Callbacks are always called from the watcher thread. Erased files stop being watched
 	class FileWatcher {
-		bool _stopThread = false;
-		std::thread* _thread = nullptr;
+	protected:
+		struct Directory {
+			int handle = -1;
+			std::unordered_map<std::string, std::string> files = {}; // File name -> watched path
+		};
+
+		std::mutex _lock;
+		std::condition_variable _wake;
+		std::thread _thread;
+		std::atomic<bool> _stopThread = false;
+
 		std::chrono::duration<int, std::milli> _delay;
+		std::atomic<rawrbox::FileWatcherMode> _mode = rawrbox::FileWatcherMode::AUTO;
 
 		std::function<void(std::string, rawrbox::FileStatus)> _action = nullptr;
 		std::unordered_map<std::string, std::filesystem::file_time_type> _files = {};
+		std::unordered_map<std::string, std::chrono::steady_clock::time_point> _pending = {}; // Changed, waiting for the delay to pass
+
+		// NATIVE ---
+		int _native = -1;
+		int _wakeup = -1;
+		std::unordered_map<std::string, Directory> _directories = {};
+		std::unordered_map<int, std::string> _handles = {};
+		// ----------
+
+		[[nodiscard]] static std::string getDirectory(const std::filesystem::path& path);
+
+		void markPending(const std::string& path); // Requires _lock
+		void scan();                               // Requires _lock
+		void removeFile(const std::string& path);  // Requires _lock
+		[[nodiscard]] std::vector<std::pair<std::string, rawrbox::FileStatus>> collect(std::chrono::steady_clock::time_point now); // Requires _lock
+
+		bool openNative();
+		void closeNative();
+		bool watchNative(const std::string& path);
+		void readNative();
+
+		void run();
+		void wakeup();
+		void deliver(const std::vector<std::pair<std::string, rawrbox::FileStatus>>& events);
 
 	public:
-		FileWatcher(const FileWatcher&) = default;
+		FileWatcher(const FileWatcher&) = delete;
 		FileWatcher(FileWatcher&&) = delete;
-		FileWatcher& operator=(const FileWatcher&) = default;
+		FileWatcher& operator=(const FileWatcher&) = delete;
 		FileWatcher& operator=(FileWatcher&&) = delete;
-		FileWatcher(const std::function<void(std::string, rawrbox::FileStatus)>& action, std::chrono::duration<int, std::milli> delay);
+		FileWatcher(const std::function<void(std::string, rawrbox::FileStatus)>& action, std::chrono::duration<int, std::milli> delay, rawrbox::FileWatcherMode mode = rawrbox::FileWatcherMode::AUTO);
 		~FileWatcher();
 
 		void watchFile(const std::filesystem::path& path);
 		void unwatchFile(const std::filesystem::path& path);
 
+		[[nodiscard]] bool isWatching(const std::filesystem::path& path);
+		[[nodiscard]] bool isNative() const;
+
 		void stop();
 		void start();
 	};
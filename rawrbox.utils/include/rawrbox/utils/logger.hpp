@@ -2,70 +2,237 @@
 
 #include <fmt/color.h>
 #include <fmt/format.h>
-#include <spdlog/sinks/basic_file_sink.h>
-#include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 
+#include <chrono>
+#include <concepts>
+#include <cstring>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
 
 #define RAWRBOX_CRITICAL(...) \
 	{ \
+		rawrbox::Logger::flush(); \
 		spdlog::critical("] {}\n  └── {}:{}\n\t└── {}", fmt::format(__VA_ARGS__), __FILE__, __LINE__, fmt::styled(__FUNCTION__, fmt::fg(fmt::color::red))); \
 		throw std::runtime_error(fmt::format(__VA_ARGS__)); \
 	}
 
 namespace rawrbox {
+	// Messages are queued with their arguments, and only formatted on the logger thread
+	namespace LOG {
+		using Formatter = void (*)(const uint8_t* args, std::string_view format, fmt::memory_buffer& out);
+
+		struct Record {
+			uint32_t size = 0; // Including this header and padding, PADDING skips to the start of the queue
+			spdlog::level::level_enum level = spdlog::level::info;
+
+			const std::string* title = nullptr;
+			std::string_view format = {}; // Format strings are compile time literals, so they outlive the record
+			Formatter formatter = nullptr;
+		};
+
+		template <typename T>
+		struct StyledView {
+			T value;
+			fmt::text_style style;
+		};
+
+		// Whatever fmt::styled returns, without naming fmt's internal type
+		template <typename T>
+		using StyledArg = decltype(fmt::styled(std::declval<const T&>(), fmt::text_style{}));
+
+		template <typename T>
+		concept Styled = requires(const T& arg) {
+			arg.value;
+			{ arg.style } -> std::convertible_to<fmt::text_style>;
+		} && std::is_same_v<T, StyledArg<std::remove_cvref_t<decltype(std::declval<const T&>().value)>>>;
+
+		// Copied as they are
+		template <typename T>
+		concept LogValue = std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_same_v<T, std::nullptr_t> || std::is_same_v<T, const void*> || std::is_same_v<T, void*>;
+
+		// Copied into the queue, read back as a std::string_view
+		template <typename T>
+		concept LogString = !LogValue<T> && std::is_convertible_v<const T&, std::string_view>;
+
+		template <typename T>
+		struct Capture;
+
+		template <typename T>
+		concept Capturable = requires { typename Capture<T>::Decoded; };
+
+		template <typename T>
+			requires(LogValue<T>)
+		struct Capture<T> {
+			using Decoded = T;
+
+			static size_t size(const T& /*value*/) { return sizeof(T); }
+			static void write(uint8_t*& out, const T& value) {
+				std::memcpy(out, &value, sizeof(T));
+				out += sizeof(T);
+			}
+
+			static Decoded read(const uint8_t*& in) {
+				T value;
+				std::memcpy(&value, in, sizeof(T));
+				in += sizeof(T);
+				return value;
+			}
+		};
+
+		template <typename T>
+			requires(LogString<T>)
+		struct Capture<T> {
+			using Decoded = std::string_view;
+
+			static size_t size(const T& value) { return sizeof(uint32_t) + std::string_view(value).size(); }
+			static void write(uint8_t*& out, const T& value) {
+				const std::string_view str(value);
+				const auto length = static_cast<uint32_t>(str.size());
+
+				std::memcpy(out, &length, sizeof(uint32_t));
+				std::memcpy(out + sizeof(uint32_t), str.data(), str.size());
+				out += sizeof(uint32_t) + str.size();
+			}
+
+			static Decoded read(const uint8_t*& in) {
+				uint32_t length = 0;
+				std::memcpy(&length, in, sizeof(uint32_t));
+
+				std::string_view str(reinterpret_cast<const char*>(in + sizeof(uint32_t)), length);
+				in += sizeof(uint32_t) + length;
+				return str;
+			}
+		};
+
+		template <typename T>
+			requires(Styled<T> && Capturable<std::remove_cvref_t<decltype(std::declval<T>().value)>>)
+		struct Capture<T> {
+			using Value = std::remove_cvref_t<decltype(std::declval<T>().value)>;
+			using Decoded = StyledView<typename Capture<Value>::Decoded>;
+
+			static size_t size(const T& arg) { return sizeof(fmt::text_style) + Capture<Value>::size(arg.value); }
+			static void write(uint8_t*& out, const T& arg) {
+				std::memcpy(out, &arg.style, sizeof(fmt::text_style));
+				out += sizeof(fmt::text_style);
+
+				Capture<Value>::write(out, arg.value);
+			}
+
+			static Decoded read(const uint8_t*& in) {
+				fmt::text_style style;
+				std::memcpy(&style, in, sizeof(fmt::text_style));
+				in += sizeof(fmt::text_style);
+
+				return {Capture<Value>::read(in), style};
+			}
+		};
+
+		template <typename... T>
+		void formatRecord([[maybe_unused]] const uint8_t* args, std::string_view format, fmt::memory_buffer& out) {
+			std::tuple<typename Capture<T>::Decoded...> decoded{Capture<T>::read(args)...}; // Braced init, read in order
+			std::apply([&out, format](auto&... values) { fmt::vformat_to(fmt::appender(out), format, fmt::make_format_args(values...)); }, decoded);
+		}
+	} // namespace LOG
+
 	class Logger {
 	protected:
-		std::string _title;
+		const std::string* _title = nullptr; // Interned, queued messages can outlive the logger
+
+		static void createLogger();
+
+		// Returns nullptr if the message can't be queued (too big, or the logger thread is gone)
+		static rawrbox::LOG::Record* beginRecord(size_t argsSize);
+		static void endRecord();
+
+		template <typename... T>
+		void enqueue(spdlog::level::level_enum level, std::string_view format, const T&... args) {
+			const size_t size = (rawrbox::LOG::Capture<T>::size(args) + ... + size_t(0));
+
+			auto* record = beginRecord(size);
+			if (record == nullptr) {
+				write(level, *this->_title, fmt::vformat(format, fmt::make_format_args(args...)));
+				return;
+			}
+
+			record->level = level;
+			record->title = this->_title;
+			record->format = format;
+			record->formatter = &rawrbox::LOG::formatRecord<T...>;
+
+			[[maybe_unused]] auto* out = reinterpret_cast<uint8_t*>(record + 1);
+			(rawrbox::LOG::Capture<T>::write(out, args), ...);
+
+			endRecord();
+		}
+
+		template <typename... T>
+		void log(spdlog::level::level_enum level, fmt::format_string<T...> format, T&&... args) {
+			if constexpr ((rawrbox::LOG::Capturable<std::remove_cvref_t<T>> && ...)) {
+				const fmt::string_view view = format;
+				this->enqueue<std::remove_cvref_t<T>...>(level, std::string_view(view.data(), view.size()), args...);
+			} else {
+				// Can't be copied (containers, custom types...), so the whole message is formatted here, keeping every spec
+				const std::string message = fmt::format(format, std::forward<T>(args)...);
+				this->enqueue<std::string>(level, "{}", message);
+			}
+		}
 
 	public:
 		static std::shared_ptr<spdlog::logger> LOGGER;
-		static spdlog::level::level_enum LEVEL;
+		static spdlog::level::level_enum LEVEL; // Messages below it are dropped before anything is captured
 		static bool ENABLE_FILE_LOGGING;
 
+		static std::chrono::milliseconds FLUSH_INTERVAL; // How often the log file is synced to disk
+		static size_t QUEUE_SIZE;                        // Bytes per logging thread
+
 		Logger(const std::string& title);
 
+		// Blocks until everything logged before the call is written
+		static void flush();
+		// Writes straight to the sinks, from the calling thread
+		static void write(spdlog::level::level_enum level, const std::string& title, std::string_view message);
+
 		// LOGGING ----
 		template <typename... T>
 		void info(fmt::format_string<T...> fmt, T&&... args) {
-			if (LOGGER == nullptr) return;
-
-			auto str = fmt::format(fmt, std::forward<T>(args)...);
-			LOGGER->info(" ▓ {}] {}", this->_title, str);
+			if (spdlog::level::info < LEVEL) return;
+			this->log(spdlog::level::info, fmt, std::forward<T>(args)...);
 		}
 
 		template <typename... T>
 		void warn(fmt::format_string<T...> fmt, T&&... args) {
-			if (LOGGER == nullptr) return;
-
-			auto str = fmt::format(fmt, std::forward<T>(args)...);
-			LOGGER->warn(" ▓ {}] {}", this->_title, fmt::styled(str, fmt::fg(fmt::color::gold)));
+			if (spdlog::level::warn < LEVEL) return;
+			this->log(spdlog::level::warn, fmt, std::forward<T>(args)...);
 		}
 
 		template <typename... T>
 		void trace(fmt::format_string<T...> fmt, T&&... args) {
-			if (LOGGER == nullptr) return;
-
-			auto str = fmt::format(fmt, std::forward<T>(args)...);
-			LOGGER->trace(" ▓ {}] {}", this->_title, str);
+			if (spdlog::level::trace < LEVEL) return;
+			this->log(spdlog::level::trace, fmt, std::forward<T>(args)...);
 		}
 
 		template <typename... T>
 		void debug(fmt::format_string<T...> fmt, T&&... args) {
-			if (LOGGER == nullptr) return;
-
-			auto str = fmt::format(fmt, std::forward<T>(args)...);
-			LOGGER->debug(" ▓ {}] {}", this->_title, str);
+			if (spdlog::level::debug < LEVEL) return;
+			this->log(spdlog::level::debug, fmt, std::forward<T>(args)...);
 		}
 
 		template <typename... T>
 		void error(fmt::format_string<T...> fmt, T&&... args) {
-			if (LOGGER == nullptr) return;
-
-			auto str = fmt::format(fmt, std::forward<T>(args)...);
-			LOGGER->error(" ▓ {}] {}", this->_title, str);
+			if (spdlog::level::err < LEVEL) return;
+			this->log(spdlog::level::err, fmt, std::forward<T>(args)...);
 		}
 		// ----------
 	};
 } // namespace rawrbox
+
+template <typename T>
+struct fmt::formatter<rawrbox::LOG::StyledView<T>> : fmt::formatter<rawrbox::LOG::StyledArg<T>> {
+	template <typename FormatContext>
+	auto format(const rawrbox::LOG::StyledView<T>& arg, FormatContext& ctx) const {
+		return fmt::formatter<rawrbox::LOG::StyledArg<T>>::format(fmt::styled(arg.value, arg.style), ctx);
+	}
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace rawrbox {
+	// Read-only memory mapped file
+	class MappedFile {
+	protected:
+		const uint8_t* _data = nullptr;
+		size_t _size = 0;
+
+#ifdef _WIN32
+		void* _file = nullptr;
+		void* _mapping = nullptr;
+#else
+		int _file = -1;
+#endif
+
+	public:
+		MappedFile() = default;
+		explicit MappedFile(const std::filesystem::path& path);
+		MappedFile(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+		virtual ~MappedFile();
+
+		bool open(const std::filesystem::path& path);
+		void close();
+
+		[[nodiscard]] bool valid() const;
+		[[nodiscard]] std::span<const uint8_t> data() const;
+		[[nodiscard]] size_t size() const;
+	};
+} // namespace rawrbox
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace rawrbox {
@@ -10,6 +13,10 @@ namespace rawrbox {
 		static std::filesystem::path normalizePath(const std::filesystem::path& messyPath);
 		static bool isSame(const std::filesystem::path& path1, const std::filesystem::path& path2);
 
+		// Lexical only (no filesystem access), relative to the working directory when possible
+		static std::string toKey(const std::filesystem::path& path);
+		static uint64_t hash(std::string_view key);
+
 		static std::vector<std::string> glob(const std::filesystem::path& root, bool ignoreFiles = false);
 	};
 } // namespace rawrbox
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Instrumentation macros, they compile to nothing unless the build enables RAWRBOX_ENABLE_PROFILER
+#ifdef RAWRBOX_PROFILER
+	#define RAWRBOX_PROFILE_CONCAT_(a, b) a##b
+	#define RAWRBOX_PROFILE_CONCAT(a, b) RAWRBOX_PROFILE_CONCAT_(a, b)
+
+	#define RAWRBOX_PROFILE_ZONE(name) const rawrbox::ProfileZone RAWRBOX_PROFILE_CONCAT(__rawrboxZone, __LINE__)(name)
+	#define RAWRBOX_PROFILE_ZONE_DETAIL(name, detail) const rawrbox::ProfileZone RAWRBOX_PROFILE_CONCAT(__rawrboxZone, __LINE__)(name, detail)
+	#define RAWRBOX_PROFILE_FUNCTION() RAWRBOX_PROFILE_ZONE(__FUNCTION__)
+	#define RAWRBOX_PROFILE_COUNTER(name, value) rawrbox::PROFILER::counter(name, static_cast<double>(value))
+	#define RAWRBOX_PROFILE_FRAME() rawrbox::PROFILER::frame()
+#else
+	#define RAWRBOX_PROFILE_ZONE(name)
+	#define RAWRBOX_PROFILE_ZONE_DETAIL(name, detail)
+	#define RAWRBOX_PROFILE_FUNCTION()
+	#define RAWRBOX_PROFILE_COUNTER(name, value)
+	#define RAWRBOX_PROFILE_FRAME()
+#endif
+
+namespace rawrbox {
+	enum class ProfileEventType : uint8_t {
+		ZONE = 0,
+		COUNTER,
+		FRAME
+	};
+
+	struct ProfileEvent {
+		const char* name = nullptr;   // Literal or interned, never freed
+		const char* detail = nullptr; // Optional, interned
+		uint64_t start = 0;           // Nanoseconds since the profiler started
+		uint64_t end = 0;
+		double value = 0.0;
+		rawrbox::ProfileEventType type = rawrbox::ProfileEventType::ZONE;
+	};
+
+	// Only written by its thread, the size is published after each event so it can be exported without locking the writer
+	// Captures alternate between two stores, so a new capture never overwrites the one being exported (see PROFILER::start)
+	class ProfileBuffer {
+	public:
+		static constexpr size_t CHUNK_SIZE = 4096;
+		static constexpr size_t MAX_CHUNKS = 256; // ~1M events per thread and capture, the rest are dropped
+
+		struct Store {
+			std::array<std::atomic<rawrbox::ProfileEvent*>, MAX_CHUNKS> chunks = {};
+			std::atomic<size_t> size = 0;
+			std::atomic<uint32_t> capture = 0; // Capture the events belong to, reset on the first write of a newer one
+
+			[[nodiscard]] const rawrbox::ProfileEvent& get(size_t index) const;
+		};
+
+		uint32_t id = 0;
+		std::string name;
+
+		std::array<Store, 2> stores = {};
+
+		ProfileBuffer() = default;
+		ProfileBuffer(const ProfileBuffer&) = delete;
+		ProfileBuffer(ProfileBuffer&&) = delete;
+		ProfileBuffer& operator=(const ProfileBuffer&) = delete;
+		ProfileBuffer& operator=(ProfileBuffer&&) = delete;
+		~ProfileBuffer() = default;
+
+		// False if it's full, or the capture is already over
+		bool push(uint32_t capture, const rawrbox::ProfileEvent& event);
+		[[nodiscard]] const Store& getStore(uint32_t capture) const;
+	};
+
+	class PROFILER {
+	protected:
+		static std::atomic<bool> _recording;
+		static std::atomic<uint32_t> _capture;
+		static std::atomic<uint64_t> _dropped;
+		static std::atomic<uint64_t> _frame;
+		static std::atomic<uint64_t> _captureStart;
+		static std::chrono::steady_clock::time_point _epoch;
+
+		static std::mutex _lock;
+		static std::vector<rawrbox::ProfileBuffer*> _buffers; // Never freed, threads can still be writing while exiting
+
+		static rawrbox::ProfileBuffer& getBuffer();
+		static void push(const rawrbox::ProfileEvent& event);
+
+	public:
+		// Starts a new capture, dropping the previous one. Waits for any export in progress
+		static void start();
+		static void stop();
+		[[nodiscard]] static bool isRecording() { return _recording.load(std::memory_order_relaxed); }
+
+		[[nodiscard]] static uint64_t now();
+		[[nodiscard]] static uint64_t getDropped();
+		// Keeps the string alive until exit, for names that are not literals. Cached per thread, only new strings take a lock
+		[[nodiscard]] static const char* intern(std::string_view str);
+
+		static void setThreadName(const std::string& name);
+
+		static void zone(const char* name, const char* detail, uint64_t start, uint64_t end);
+		static void counter(const char* name, double value);
+		static void frame();
+
+		// Chrome / Perfetto trace event format (chrome://tracing, ui.perfetto.dev), of the last capture. Best called after stop
+		[[nodiscard]] static std::string exportJSON();
+		static void exportJSON(const std::filesystem::path& path);
+	};
+
+	// Records a zone from construction to destruction, if the profiler is recording
+	class ProfileZone {
+	protected:
+		const char* _name = nullptr;
+		const char* _detail = nullptr;
+		uint64_t _start = 0;
+		bool _active = false;
+
+	public:
+		explicit ProfileZone(const char* name) : _name(name), _active(rawrbox::PROFILER::isRecording()) {
+			if (this->_active) this->_start = rawrbox::PROFILER::now();
+		}
+
+		ProfileZone(const char* name, std::string_view detail) : _name(name), _active(rawrbox::PROFILER::isRecording()) {
+			if (!this->_active) return;
+
+			this->_detail = rawrbox::PROFILER::intern(detail);
+			this->_start = rawrbox::PROFILER::now();
+		}
+
+		ProfileZone(const ProfileZone&) = delete;
+		ProfileZone(ProfileZone&&) = delete;
+		ProfileZone& operator=(const ProfileZone&) = delete;
+		ProfileZone& operator=(ProfileZone&&) = delete;
+
+		~ProfileZone() {
+			if (this->_active) rawrbox::PROFILER::zone(this->_name, this->_detail, this->_start, rawrbox::PROFILER::now());
+		}
+	};
+} // namespace rawrbox
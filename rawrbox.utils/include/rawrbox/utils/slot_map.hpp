@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace rawrbox {
+	// Dense storage with stable handles, removing swaps the last element into the hole
+	template <typename T>
+	class SlotMap {
+	public:
+		static constexpr uint32_t INVALID = std::numeric_limits<uint32_t>::max();
+
+	protected:
+		std::vector<T> _data = {};
+		std::vector<uint32_t> _handles = {}; // Dense index -> handle
+		std::vector<uint32_t> _slots = {};   // Handle -> dense index, INVALID = unused
+		std::vector<uint32_t> _freeHandles = {};
+
+	public:
+		SlotMap() = default;
+
+		void reserve(size_t size) {
+			this->_data.reserve(size);
+			this->_handles.reserve(size);
+			this->_slots.reserve(size);
+		}
+
+		uint32_t insert(const T& item) {
+			uint32_t handle = 0;
+
+			if (!this->_freeHandles.empty()) {
+				handle = this->_freeHandles.back();
+				this->_freeHandles.pop_back();
+			} else {
+				handle = static_cast<uint32_t>(this->_slots.size());
+				this->_slots.push_back(INVALID);
+			}
+
+			this->_slots[handle] = static_cast<uint32_t>(this->_data.size());
+			this->_data.push_back(item);
+			this->_handles.push_back(handle);
+
+			return handle;
+		}
+
+		// Returns the dense index that got filled by the swapped element, or INVALID if the last one was removed / not found
+		uint32_t remove(uint32_t handle) {
+			if (!this->valid(handle)) return INVALID;
+
+			const uint32_t index = this->_slots[handle];
+			const auto last = static_cast<uint32_t>(this->_data.size() - 1);
+
+			if (index != last) {
+				this->_data[index] = std::move(this->_data[last]);
+				this->_handles[index] = this->_handles[last];
+				this->_slots[this->_handles[index]] = index;
+			}
+
+			this->_data.pop_back();
+			this->_handles.pop_back();
+
+			this->_slots[handle] = INVALID;
+			this->_freeHandles.push_back(handle);
+
+			return index != last ? index : INVALID;
+		}
+
+		void clear() {
+			this->_data.clear();
+			this->_handles.clear();
+			this->_slots.clear();
+			this->_freeHandles.clear();
+		}
+
+		[[nodiscard]] bool valid(uint32_t handle) const { return handle < this->_slots.size() && this->_slots[handle] != INVALID; }
+
+		[[nodiscard]] uint32_t indexOf(uint32_t handle) const {
+			if (!this->valid(handle)) throw std::runtime_error("[RawrBox-SlotMap] Invalid handle");
+			return this->_slots[handle];
+		}
+
+		[[nodiscard]] uint32_t handleAt(size_t index) const { return this->_handles.at(index); }
+
+		[[nodiscard]] T& get(uint32_t handle) { return this->_data[this->indexOf(handle)]; }
+		[[nodiscard]] const T& get(uint32_t handle) const { return this->_data[this->indexOf(handle)]; }
+
+		[[nodiscard]] std::vector<T>& data() { return this->_data; }
+		[[nodiscard]] const std::vector<T>& data() const { return this->_data; }
+
+		[[nodiscard]] size_t size() const { return this->_data.size(); }
+		[[nodiscard]] size_t capacity() const { return this->_data.capacity(); }
+		[[nodiscard]] bool empty() const { return this->_data.empty(); }
+
+		[[nodiscard]] auto begin() { return this->_data.begin(); }
+		[[nodiscard]] auto end() { return this->_data.end(); }
+		[[nodiscard]] auto begin() const { return this->_data.begin(); }
+		[[nodiscard]] auto end() const { return this->_data.end(); }
+	};
+} // namespace rawrbox
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace rawrbox {
+	template <typename Signature, size_t Capacity = 48>
+	class SmallFunction;
+
+	// std::function-like, but callables up to Capacity bytes are stored inline instead of on the heap
+	template <typename R, typename... Args, size_t Capacity>
+	class SmallFunction<R(Args...), Capacity> {
+	protected:
+		struct VTable {
+			R (*invoke)(void* storage, Args&&... args);
+			void (*copy)(const void* from, void* to);
+			void (*move)(void* from, void* to) noexcept;
+			void (*destroy)(void* storage) noexcept;
+		};
+
+		template <typename F>
+		static constexpr bool INLINE = sizeof(F) <= Capacity && alignof(F) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<F>;
+
+		template <typename F>
+		static F* get(void* storage) {
+			if constexpr (INLINE<F>) {
+				return std::launder(reinterpret_cast<F*>(storage));
+			} else {
+				return *std::launder(reinterpret_cast<F**>(storage));
+			}
+		}
+
+		template <typename F>
+		static constexpr VTable TABLE = {
+		    [](void* storage, Args&&... args) -> R { return std::invoke(*get<F>(storage), std::forward<Args>(args)...); },
+		    [](const void* from, void* to) {
+			    const auto* src = get<F>(const_cast<void*>(from));
+			    if constexpr (INLINE<F>) {
+				    ::new (to) F(*src);
+			    } else {
+				    ::new (to) F*(new F(*src));
+			    }
+		    },
+		    [](void* from, void* to) noexcept {
+			    if constexpr (INLINE<F>) {
+				    auto* src = get<F>(from);
+				    ::new (to) F(std::move(*src));
+				    src->~F();
+			    } else {
+				    ::new (to) F*(get<F>(from)); // Just take the pointer
+			    }
+		    },
+		    [](void* storage) noexcept {
+			    if constexpr (INLINE<F>) {
+				    get<F>(storage)->~F();
+			    } else {
+				    delete get<F>(storage);
+			    }
+		    }};
+
+		alignas(std::max_align_t) mutable std::byte _storage[Capacity] = {};
+		const VTable* _vtable = nullptr;
+
+	public:
+		SmallFunction() = default;
+		SmallFunction(std::nullptr_t) {} // NOLINT(google-explicit-constructor)
+
+		template <typename F>
+			requires(!std::is_same_v<std::remove_cvref_t<F>, SmallFunction> && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+		SmallFunction(F&& func) { // NOLINT(google-explicit-constructor)
+			using Callable = std::decay_t<F>;
+
+			if constexpr (INLINE<Callable>) {
+				::new (static_cast<void*>(this->_storage)) Callable(std::forward<F>(func));
+			} else {
+				::new (static_cast<void*>(this->_storage)) Callable*(new Callable(std::forward<F>(func)));
+			}
+
+			this->_vtable = &TABLE<Callable>;
+		}
+
+		SmallFunction(const SmallFunction& other) : _vtable(other._vtable) {
+			if (this->_vtable != nullptr) this->_vtable->copy(other._storage, this->_storage);
+		}
+
+		SmallFunction(SmallFunction&& other) noexcept : _vtable(other._vtable) {
+			if (this->_vtable == nullptr) return;
+
+			this->_vtable->move(other._storage, this->_storage);
+			other._vtable = nullptr;
+		}
+
+		SmallFunction& operator=(const SmallFunction& other) {
+			if (this == &other) return *this;
+
+			SmallFunction copy(other);
+			*this = std::move(copy);
+			return *this;
+		}
+
+		SmallFunction& operator=(SmallFunction&& other) noexcept {
+			if (this == &other) return *this;
+			this->reset();
+
+			if (other._vtable != nullptr) {
+				other._vtable->move(other._storage, this->_storage);
+				this->_vtable = other._vtable;
+				other._vtable = nullptr;
+			}
+
+			return *this;
+		}
+
+		SmallFunction& operator=(std::nullptr_t) {
+			this->reset();
+			return *this;
+		}
+
+		~SmallFunction() { this->reset(); }
+
+		void reset() {
+			if (this->_vtable == nullptr) return;
+
+			this->_vtable->destroy(this->_storage);
+			this->_vtable = nullptr;
+		}
+
+		R operator()(Args... args) const {
+			if (this->_vtable == nullptr) throw std::bad_function_call();
+			return this->_vtable->invoke(this->_storage, std::forward<Args>(args)...);
+		}
+
+		explicit operator bool() const { return this->_vtable != nullptr; }
+		bool operator==(std::nullptr_t) const { return this->_vtable == nullptr; }
+	};
+} // namespace rawrbox
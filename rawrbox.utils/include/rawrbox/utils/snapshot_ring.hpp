@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace rawrbox {
+	struct Snapshot {
+		uint64_t frame = 0;
+		uint32_t hash = 0;
+		bool keyframe = false; // Full data, otherwise a delta against the previous frame
+
+		size_t size = 0; // Uncompressed
+		std::vector<uint8_t> data = {};
+	};
+
+	// Keeps the last N frames of some serialized state (ex: the physics world), for rollback
+	// Frames are stored as deltas against the previous one, with a full keyframe every keyframeInterval frames
+	//
+	// ring.push(frame, data, size, hash);
+	// ring.get(frame - 5, out); // Rebuilds that frame
+	// ring.discard(frame - 5);  // Drop everything after it, before resimulating
+	class SnapshotRing {
+	protected:
+		std::vector<rawrbox::Snapshot> _frames = {};
+		size_t _head = 0; // Oldest
+		size_t _count = 0;
+
+		size_t _keyframeInterval = 0;
+		size_t _sinceKeyframe = 0;
+
+		std::vector<uint8_t> _last = {}; // Full data of the newest frame, base of the next delta
+		std::vector<uint8_t> _scratch = {};
+
+		[[nodiscard]] rawrbox::Snapshot& at(size_t index);
+		[[nodiscard]] const rawrbox::Snapshot& at(size_t index) const;
+		[[nodiscard]] std::optional<size_t> indexOf(uint64_t frame) const;
+
+		void rebuild(size_t index, std::vector<uint8_t>& out, std::vector<uint8_t>& scratch) const;
+		void evict();
+
+	public:
+		explicit SnapshotRing(size_t capacity = 64, size_t keyframeInterval = 16);
+
+		// Frames must go up, pushing an older (or same) frame discards everything from it onwards first
+		void push(uint64_t frame, const void* data, size_t size, uint32_t hash = 0);
+		[[nodiscard]] bool get(uint64_t frame, std::vector<uint8_t>& out) const;
+
+		// Removes every frame after the given one
+		void discard(uint64_t frame);
+		void clear();
+
+		[[nodiscard]] bool has(uint64_t frame) const;
+		[[nodiscard]] std::optional<uint32_t> getHash(uint64_t frame) const;
+
+		[[nodiscard]] std::optional<uint64_t> getOldest() const;
+		[[nodiscard]] std::optional<uint64_t> getNewest() const;
+
+		[[nodiscard]] size_t size() const;
+		[[nodiscard]] size_t capacity() const;
+		[[nodiscard]] bool empty() const;
+
+		// Bytes held by the stored frames (compressed)
+		[[nodiscard]] size_t getMemoryUsage() const;
+
+		// DELTA ---
+		// Runs of bytes matching the base are skipped, the rest are stored as is
+		static void encode(const std::vector<uint8_t>& base, const uint8_t* target, size_t size, std::vector<uint8_t>& out);
+		static void decode(const std::vector<uint8_t>& base, const std::vector<uint8_t>& delta, size_t size, std::vector<uint8_t>& out);
+		// ---
+	};
+} // namespace rawrbox
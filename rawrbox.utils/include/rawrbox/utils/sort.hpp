@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace rawrbox {
+	class SortUtils {
+	public:
+		// Keep one around to avoid allocating on every sort
+		struct RadixScratch {
+			std::vector<uint64_t> keys = {};
+			std::vector<uint64_t> keysSwap = {};
+			std::vector<uint32_t> orderSwap = {};
+		};
+
+		// Stable LSD radix sort (8 bits per pass), order gets the indices of the keys from smallest to biggest
+		// Passes where every key has the same byte are skipped, so keys with unused high bits are cheaper
+		static void radix(const std::vector<uint64_t>& keys, std::vector<uint32_t>& order, rawrbox::SortUtils::RadixScratch& scratch);
+		static void radix(const std::vector<uint64_t>& keys, std::vector<uint32_t>& order);
+	};
+} // namespace rawrbox
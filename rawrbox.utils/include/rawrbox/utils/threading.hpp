@@ -18,5 +18,9 @@ namespace rawrbox {
 		static void shutdown();
 
 		static void run(const std::function<void()>& job);
+
+		// Runs job(i) for every i in [begin, end) on the pool and blocks until all of them finish
+		// Falls back to running inline if the pool is not ready, or if called from a pool thread (to avoid deadlocks)
+		static void loop(size_t begin, size_t end, const std::function<void(size_t)>& job);
 	};
 } // namespace rawrbox
@@ -1,17 +1,58 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace rawrbox {
+	struct TimerHandle {
+		uint32_t index = UINT32_MAX;
+		uint32_t generation = 0;
+
+		[[nodiscard]] bool valid() const { return index != UINT32_MAX; }
+		bool operator==(const TimerHandle& other) const = default;
+	};
+
+	// Timers live on a hierarchical timing wheel with 1ms integer ticks, so update only visits the buckets that expired
 	class TIMER {
 	protected:
+		struct Bucket {
+			rawrbox::TIMER* head = nullptr;
+			rawrbox::TIMER* tail = nullptr;
+		};
+
+		static constexpr size_t WHEEL_BITS = 6;
+		static constexpr size_t WHEEL_SLOTS = 1 << WHEEL_BITS;
+		static constexpr size_t WHEEL_LEVELS = 6; // 2^36 ms, ~795 days. Later timers wait on the overflow bucket
+
+		// WHEEL ---
+		static std::array<std::array<Bucket, WHEEL_SLOTS>, WHEEL_LEVELS> _wheel;
+		static std::array<size_t, WHEEL_LEVELS> _wheelCounts;
+		static Bucket _overflow;
+		static Bucket _firing;
+		static uint64_t _now;
+
+		static rawrbox::TIMER* _current; // The timer running its callback
+		// ---------
+
+		// POOL ---
+		static std::vector<std::unique_ptr<rawrbox::TIMER>> _pool;
+		static std::vector<uint32_t> _generations;
+		static std::vector<uint32_t> _freeSlots;
+		// ---------
+
 		std::string _id;
+		rawrbox::TimerHandle _handle = {};
 
-		float _nextTick = 0;
-		float _msDelay = 0;
-		float _pausedTime = 0;
+		uint64_t _start = 0;    // Tick of the first interval, moved forward by pauses
+		uint64_t _delayUs = 0;  // Microseconds, so fractional delays don't drift
+		uint64_t _fired = 0;    // Intervals run
+		uint64_t _expiry = 0;   // Tick of the next interval
+		uint64_t _pausedAt = 0; // Tick it was paused at
 
 		int _iterations = -1;
 		int _ticks = 0;
@@ -21,27 +62,56 @@ namespace rawrbox {
 
 		bool _paused = false;
 		bool _infinite = false;
+		bool _destroyed = false;
+
+		// Intrusive bucket list
+		rawrbox::TIMER* _prev = nullptr;
+		rawrbox::TIMER* _next = nullptr;
+		Bucket* _bucket = nullptr;
+		int _level = -1; // Wheel level, -1 for overflow / firing
 
 		static rawrbox::TIMER* init(const std::string& id, int reps, float msDelay, std::function<void()> func, std::function<void()> onComplete = nullptr);
 
+		static void link(Bucket& bucket, rawrbox::TIMER* timer, int level = -1);
+		static void unlink(rawrbox::TIMER* timer);
+		static void schedule(rawrbox::TIMER* timer, bool cascading = false);
+		static void release(rawrbox::TIMER* timer);
+		static void cascade(size_t level);
+		static void fire();
+
+		[[nodiscard]] uint64_t getExpiry() const;
+
 	public:
 		static uint32_t ID;
-		static std::unordered_map<std::string, std::unique_ptr<rawrbox::TIMER>> timers;
+		static std::unordered_map<std::string, rawrbox::TIMER*> timers; // By id, does not own them
+		static uint64_t (*CLOCK)();                                     // Milliseconds, TimeUtils::time by default
 
 		// STATIC ----
 		static void update();
+		static void update(uint64_t time); // Runs every timer expired up to the given tick
 
 		static rawrbox::TIMER* simple(const std::string& id, float msDelay, std::function<void()> func, std::function<void()> onComplete = nullptr);
 		static rawrbox::TIMER* simple(float msDelay, std::function<void()> func, std::function<void()> onComplete = nullptr);
 		static rawrbox::TIMER* create(const std::string& id, int reps, float msDelay, std::function<void()> func, std::function<void()> onComplete = nullptr);
 		static rawrbox::TIMER* create(int reps, float msDelay, std::function<void()> func, std::function<void()> onComplete = nullptr);
 
+		[[nodiscard]] static rawrbox::TIMER* get(const std::string& id);
+		[[nodiscard]] static rawrbox::TIMER* get(const rawrbox::TimerHandle& handle); // nullptr once the timer is gone
+
 		static bool destroy(const std::string& id);
+		static bool destroy(const rawrbox::TimerHandle& handle);
 		static bool pause(const std::string& id, bool pause);
 		static bool exists(const std::string& id);
 		static void clear();
+
+		[[nodiscard]] static size_t size();
+		[[nodiscard]] static uint64_t now();
 		// ----
 
+		[[nodiscard]] const std::string& getID() const;
+		[[nodiscard]] const rawrbox::TimerHandle& getHandle() const;
+		[[nodiscard]] bool isPaused() const;
+
 		void destroy();
 		void pause(bool pause);
 	};
@@ -0,0 +1,81 @@
+#include <rawrbox/utils/dirty_ranges.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace rawrbox {
+	DirtyRanges::DirtyRanges(uint32_t gap, size_t maxRanges) : _gap(gap), _maxRanges(std::max<size_t>(maxRanges, 1)) {}
+
+	// PROTECTED ----
+	void DirtyRanges::collapse() {
+		// Merge the two closest ranges, wastes the least untouched elements
+		size_t best = 0;
+		uint32_t bestGap = std::numeric_limits<uint32_t>::max();
+
+		for (size_t i = 0; i + 1 < this->_ranges.size(); i++) {
+			uint32_t gap = this->_ranges[i + 1].start - this->_ranges[i].end;
+			if (gap >= bestGap) continue;
+
+			bestGap = gap;
+			best = i;
+		}
+
+		this->_ranges[best].end = this->_ranges[best + 1].end;
+		this->_ranges.erase(this->_ranges.begin() + static_cast<std::ptrdiff_t>(best) + 1);
+	}
+	// -------------
+
+	void DirtyRanges::mark(uint32_t index) {
+		this->mark(index, index + 1);
+	}
+
+	void DirtyRanges::mark(uint32_t start, uint32_t end) {
+		if (end <= start) return;
+
+		// First range that could touch the new one
+		auto it = std::lower_bound(this->_ranges.begin(), this->_ranges.end(), start, [this](const rawrbox::DirtyRange& range, uint32_t value) {
+			return range.end + this->_gap < value;
+		});
+
+		if (it == this->_ranges.end() || it->start > end + this->_gap) {
+			this->_ranges.insert(it, {start, end});
+			if (this->_ranges.size() > this->_maxRanges) this->collapse();
+
+			return;
+		}
+
+		// Grow it, then eat any range it now reaches
+		it->start = std::min(it->start, start);
+		it->end = std::max(it->end, end);
+
+		auto next = it + 1;
+		while (next != this->_ranges.end() && next->start <= it->end + this->_gap) {
+			it->end = std::max(it->end, next->end);
+			next++;
+		}
+
+		this->_ranges.erase(it + 1, next);
+	}
+
+	void DirtyRanges::clamp(uint32_t size) {
+		while (!this->_ranges.empty() && this->_ranges.back().start >= size)
+			this->_ranges.pop_back();
+
+		if (!this->_ranges.empty()) this->_ranges.back().end = std::min(this->_ranges.back().end, size);
+	}
+
+	void DirtyRanges::clear() {
+		this->_ranges.clear();
+	}
+
+	const std::vector<rawrbox::DirtyRange>& DirtyRanges::get() const { return this->_ranges; }
+	bool DirtyRanges::empty() const { return this->_ranges.empty(); }
+
+	uint32_t DirtyRanges::count() const {
+		uint32_t total = 0;
+		for (const auto& range : this->_ranges)
+			total += range.count();
+
+		return total;
+	}
+} // namespace rawrbox
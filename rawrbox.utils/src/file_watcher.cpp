@@ -1,58 +1,299 @@
 #include <rawrbox/utils/file_watcher.hpp>
 
+#ifdef __linux__
+	#include <poll.h>
+	#include <sys/eventfd.h>
+	#include <sys/inotify.h>
+	#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <array>
+
 namespace rawrbox {
-	FileWatcher::FileWatcher(const std::function<void(std::string, rawrbox::FileStatus)>& action, std::chrono::duration<int, std::milli> delay) : _delay{delay}, _action(action) {}
-	FileWatcher::~FileWatcher() { this->stop(); }
+	FileWatcher::FileWatcher(const std::function<void(std::string, rawrbox::FileStatus)>& action, std::chrono::duration<int, std::milli> delay, rawrbox::FileWatcherMode mode) : _delay{delay}, _mode(mode), _action(action) {
+		if (this->_mode == rawrbox::FileWatcherMode::AUTO) this->openNative();
+	}
 
-	void FileWatcher::stop() {
-		this->_stopThread = true;
+	FileWatcher::~FileWatcher() {
+		this->stop();
+		this->closeNative();
+	}
+
+	// PROTECTED ----
+	std::string FileWatcher::getDirectory(const std::filesystem::path& path) {
+		auto parent = std::filesystem::absolute(path).lexically_normal().parent_path();
+		return parent.generic_string();
+	}
+
+	void FileWatcher::markPending(const std::string& path) {
+		this->_pending[path] = std::chrono::steady_clock::now() + this->_delay; // Pushed back on every change
+	}
+
+	void FileWatcher::scan() {
+		for (auto& file : this->_files) {
+			std::error_code ec;
+			auto time = std::filesystem::last_write_time(file.first, ec);
+
+			if (ec) {
+				if (!this->_pending.contains(file.first)) this->markPending(file.first); // Gone, or being replaced
+			} else if (time != file.second) {
+				file.second = time;
+				this->markPending(file.first);
+			}
+		}
+	}
+
+	void FileWatcher::removeFile(const std::string& path) {
+		this->_files.erase(path);
+		this->_pending.erase(path);
+
+		auto dir = this->_directories.find(getDirectory(path));
+		if (dir == this->_directories.end()) return;
 
-		// NOLINTBEGIN(cppcoreguidelines-owning-memory)
-		if (this->_thread != nullptr) {
-			if (this->_thread->joinable()) this->_thread->join();
-			delete this->_thread;
-			this->_thread = nullptr;
+		dir->second.files.erase(std::filesystem::path(path).filename().generic_string());
+		if (!dir->second.files.empty()) return;
+
+#ifdef __linux__
+		if (dir->second.handle >= 0) {
+			inotify_rm_watch(this->_native, dir->second.handle);
+			this->_handles.erase(dir->second.handle);
 		}
-		// NOLINTEND(cppcoreguidelines-owning-memory)
+#endif
+
+		this->_directories.erase(dir);
 	}
 
+	std::vector<std::pair<std::string, rawrbox::FileStatus>> FileWatcher::collect(std::chrono::steady_clock::time_point now) {
+		std::vector<std::pair<std::string, rawrbox::FileStatus>> events = {};
+
+		for (auto it = this->_pending.begin(); it != this->_pending.end();) {
+			if (it->second > now) {
+				it++;
+				continue;
+			}
+
+			auto path = it->first;
+			it = this->_pending.erase(it);
+
+			// The final state is what matters, a delete + create or a rename over it is just a modification
+			std::error_code ec;
+			auto time = std::filesystem::last_write_time(path, ec);
+
+			if (ec) {
+				events.emplace_back(path, rawrbox::FileStatus::erased);
+			} else {
+				this->_files[path] = time;
+				events.emplace_back(path, rawrbox::FileStatus::modified);
+
+				// Its folder might have been replaced
+				if (this->isNative() && !this->watchNative(path)) {
+					this->_mode = rawrbox::FileWatcherMode::POLLING;
+				}
+			}
+		}
+
+		for (const auto& event : events) {
+			if (event.second == rawrbox::FileStatus::erased) this->removeFile(event.first);
+		}
+
+		return events;
+	}
+
+	bool FileWatcher::openNative() {
+#ifdef __linux__
+		this->_native = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (this->_native < 0) return false;
+
+		this->_wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (this->_wakeup < 0) {
+			this->closeNative();
+			return false;
+		}
+
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	void FileWatcher::closeNative() {
+#ifdef __linux__
+		if (this->_native >= 0) close(this->_native);
+		if (this->_wakeup >= 0) close(this->_wakeup);
+#endif
+
+		this->_native = -1;
+		this->_wakeup = -1;
+	}
+
+	bool FileWatcher::watchNative(const std::string& path) {
+		auto dirPath = getDirectory(path);
+		auto& dir = this->_directories[dirPath];
+		dir.files[std::filesystem::path(path).filename().generic_string()] = path;
+
+#ifdef __linux__
+		if (this->_native < 0 || dir.handle >= 0) return true;
+
+		// Watch the folder, editors usually replace the file instead of writing to it
+		dir.handle = inotify_add_watch(this->_native, dirPath.c_str(), IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF);
+		if (dir.handle < 0) return false;
+
+		this->_handles[dir.handle] = dirPath;
+		return true;
+#else
+		return true;
+#endif
+	}
+
+	void FileWatcher::readNative() {
+#ifdef __linux__
+		alignas(inotify_event) std::array<char, 16 * 1024> buffer = {};
+
+		while (true) {
+			auto size = read(this->_native, buffer.data(), buffer.size());
+			if (size <= 0) return;
+
+			const std::lock_guard<std::mutex> lock(this->_lock);
+			for (ssize_t offset = 0; offset < size;) {
+				const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+				offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+				if ((event->mask & IN_Q_OVERFLOW) != 0) {
+					this->scan(); // Events were lost, compare everything
+					continue;
+				}
+
+				auto handle = this->_handles.find(event->wd);
+				if (handle == this->_handles.end()) continue;
+
+				auto& dir = this->_directories[handle->second];
+
+				if ((event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) != 0) {
+					for (const auto& file : dir.files)
+						this->markPending(file.second);
+
+					// The folder is gone, drop the stale handle so it's watched again if it comes back (see collect)
+					if ((event->mask & IN_IGNORED) == 0) inotify_rm_watch(this->_native, event->wd);
+					dir.handle = -1;
+					this->_handles.erase(handle);
+
+					continue;
+				}
+
+				if (event->len == 0) continue;
+
+				auto file = dir.files.find(event->name);
+				if (file == dir.files.end()) continue; // Not watched (temp files, etc)
+
+				this->markPending(file->second);
+			}
+		}
+#endif
+	}
+
+	void FileWatcher::run() {
+		while (!this->_stopThread) {
+			std::vector<std::pair<std::string, rawrbox::FileStatus>> events = {};
+			auto wait = this->_delay;
+
+			{
+				std::unique_lock<std::mutex> lock(this->_lock);
+
+				if (!this->isNative()) this->scan();
+				events = this->collect(std::chrono::steady_clock::now());
+
+				if (!this->_pending.empty()) {
+					auto next = std::ranges::min_element(this->_pending, {}, [](const auto& pending) { return pending.second; })->second;
+					wait = std::max(std::chrono::duration_cast<std::chrono::milliseconds>(next - std::chrono::steady_clock::now()), std::chrono::milliseconds(1));
+				} else if (this->isNative()) {
+					wait = std::chrono::duration<int, std::milli>(-1); // Nothing pending, sleep until something changes
+				}
+
+				if (!this->isNative() && events.empty()) {
+					this->_wake.wait_for(lock, this->_delay, [this]() { return this->_stopThread.load(); });
+					continue;
+				}
+			}
+
+			this->deliver(events);
+
+#ifdef __linux__
+			if (this->isNative()) {
+				std::array<pollfd, 2> fds = {pollfd{this->_native, POLLIN, 0}, pollfd{this->_wakeup, POLLIN, 0}};
+				poll(fds.data(), fds.size(), wait.count());
+
+				if ((fds[1].revents & POLLIN) != 0) {
+					uint64_t value = 0;
+					[[maybe_unused]] auto r = read(this->_wakeup, &value, sizeof(value));
+				}
+
+				this->readNative();
+			}
+#endif
+		}
+	}
+
+	void FileWatcher::wakeup() {
+		this->_wake.notify_all();
+
+#ifdef __linux__
+		if (this->_wakeup >= 0) {
+			uint64_t value = 1;
+			[[maybe_unused]] auto r = write(this->_wakeup, &value, sizeof(value));
+		}
+#endif
+	}
+
+	void FileWatcher::deliver(const std::vector<std::pair<std::string, rawrbox::FileStatus>>& events) {
+		if (this->_action == nullptr) return;
+
+		for (const auto& event : events)
+			this->_action(event.first, event.second);
+	}
+	// --------------
+
 	void FileWatcher::watchFile(const std::filesystem::path& path) {
-		this->_files[path.generic_string()] = std::filesystem::last_write_time(path);
+		auto key = path.generic_string();
+		auto time = std::filesystem::last_write_time(path);
+
+		const std::lock_guard<std::mutex> lock(this->_lock);
+		this->_files[key] = time;
+
+		if (this->isNative() && !this->watchNative(key)) {
+			// Out of watches, fall back to polling everything
+			this->_mode = rawrbox::FileWatcherMode::POLLING;
+			this->wakeup();
+		}
 	}
 
 	void FileWatcher::unwatchFile(const std::filesystem::path& path) {
-		auto fnd = this->_files.find(path.generic_string());
-		if (fnd == this->_files.end()) return;
+		const std::lock_guard<std::mutex> lock(this->_lock);
+		this->removeFile(path.generic_string());
+	}
+
+	bool FileWatcher::isWatching(const std::filesystem::path& path) {
+		const std::lock_guard<std::mutex> lock(this->_lock);
+		return this->_files.contains(path.generic_string());
+	}
+
+	bool FileWatcher::isNative() const { return this->_native >= 0 && this->_mode == rawrbox::FileWatcherMode::AUTO; }
+
+	void FileWatcher::stop() {
+		this->_stopThread = true;
+
+		{
+			const std::lock_guard<std::mutex> lock(this->_lock);
+			this->wakeup();
+		}
 
-		this->_files.erase(fnd);
+		if (this->_thread.joinable()) this->_thread.join();
 	}
 
 	void FileWatcher::start() {
-		// NOLINTBEGIN(cppcoreguidelines-owning-memory)
-		this->_thread = new std::thread([this]() {
-			while (!this->_stopThread) {
-				// Wait for "delay" milliseconds
-				std::this_thread::sleep_for(this->_delay);
-				if (this->_files.empty()) continue;
-
-				auto it = this->_files.begin();
-				while (it != this->_files.end()) {
-					if (!std::filesystem::exists(it->first)) {
-						if (this->_action != nullptr) this->_action(it->first, FileStatus::erased);
-						it = this->_files.erase(it);
-					} else {
-						auto current_file_last_write_time = std::filesystem::last_write_time((*it).first);
-
-						if ((*it).second != current_file_last_write_time) {
-							(*it).second = current_file_last_write_time;
-							if (this->_action != nullptr) this->_action((*it).first, FileStatus::modified);
-						}
-
-						it++;
-					}
-				}
-			}
-		});
-		// NOLINTEND(cppcoreguidelines-owning-memory)
+		if (this->_thread.joinable()) return;
+
+		this->_stopThread = false;
+		this->_thread = std::thread([this]() { this->run(); });
 	}
 } // namespace rawrbox
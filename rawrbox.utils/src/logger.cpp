@@ -1,6 +1,310 @@
 #include <rawrbox/utils/logger.hpp>
 
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+#ifdef _WIN32
+	#include <io.h>
+#else
+	#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
 namespace rawrbox {
+	namespace {
+		constexpr uint32_t PADDING = 0xFFFFFFFF;
+		constexpr size_t RECORD_ALIGN = alignof(rawrbox::LOG::Record);
+
+		// Single producer (the owning thread), single consumer (the logger thread)
+		struct LogQueue {
+			std::vector<uint8_t> data;
+			size_t mask = 0;
+
+			alignas(64) std::atomic<size_t> head = 0; // Written by the producer
+			alignas(64) std::atomic<size_t> tail = 0; // Written by the consumer
+			size_t reserved = 0;                       // Producer only, head after the pending record
+
+			std::atomic<bool> alive = true;
+
+			explicit LogQueue(size_t size) : data(std::bit_ceil(std::max<size_t>(size, 4096))), mask(data.size() - 1) {}
+		};
+
+		// Appends to the log file, and only syncs it to disk on flush
+		class FileSink : public spdlog::sinks::base_sink<std::mutex> {
+			FILE* _file = nullptr;
+
+		protected:
+			void sink_it_(const spdlog::details::log_msg& msg) override {
+				if (this->_file == nullptr) return;
+
+				spdlog::memory_buf_t formatted;
+				this->formatter_->format(msg, formatted);
+				std::fwrite(formatted.data(), 1, formatted.size(), this->_file);
+			}
+
+			void flush_() override {
+				if (this->_file == nullptr) return;
+				std::fflush(this->_file);
+
+#ifdef _WIN32
+				_commit(_fileno(this->_file));
+#else
+				fsync(fileno(this->_file));
+#endif
+			}
+
+		public:
+			explicit FileSink(const std::string& path) : _file(std::fopen(path.c_str(), "wb")) {}
+			FileSink(const FileSink&) = delete;
+			FileSink(FileSink&&) = delete;
+			FileSink& operator=(const FileSink&) = delete;
+			FileSink& operator=(FileSink&&) = delete;
+			~FileSink() override {
+				if (this->_file != nullptr) std::fclose(this->_file);
+			}
+		};
+
+		class LogBackend {
+			std::shared_ptr<spdlog::logger> _output = nullptr; // Kept alive with the backend, LOGGER can be gone by the time atexit runs
+
+			std::mutex _queuesLock;
+			std::vector<std::shared_ptr<LogQueue>> _queues = {};
+
+			std::mutex _lock;
+			std::condition_variable _wake;
+			std::condition_variable _flushed;
+			uint64_t _flushRequest = 0;
+			uint64_t _flushDone = 0;
+
+			std::thread _thread;
+
+			size_t drain(LogQueue& queue, fmt::memory_buffer& buffer) {
+				size_t tail = queue.tail.load(std::memory_order_relaxed);
+				const size_t head = queue.head.load(std::memory_order_acquire);
+
+				size_t total = 0;
+				while (tail != head) {
+					const auto* record = reinterpret_cast<const rawrbox::LOG::Record*>(queue.data.data() + (tail & queue.mask));
+					if (record->size == PADDING) {
+						tail += queue.data.size() - (tail & queue.mask);
+						continue;
+					}
+
+					this->dispatch(*record, buffer);
+
+					tail += record->size;
+					total++;
+				}
+
+				queue.tail.store(tail, std::memory_order_release);
+				return total;
+			}
+
+			void dispatch(const rawrbox::LOG::Record& record, fmt::memory_buffer& buffer) {
+				buffer.clear();
+
+				try {
+					record.formatter(reinterpret_cast<const uint8_t*>(&record + 1), record.format, buffer);
+				} catch (const std::exception& e) {
+					buffer.clear();
+					fmt::format_to(fmt::appender(buffer), "Failed to format log message '{}': {}", record.format, e.what());
+				}
+
+				Logger::write(record.level, *record.title, std::string_view(buffer.data(), buffer.size()));
+			}
+
+			bool pending() {
+				const std::lock_guard<std::mutex> guard(this->_queuesLock);
+				return std::any_of(this->_queues.begin(), this->_queues.end(), [](const auto& queue) { return !queue->alive || queue->head.load() != queue->tail.load(std::memory_order_relaxed); });
+			}
+
+			size_t drainAll(fmt::memory_buffer& buffer) {
+				std::vector<std::shared_ptr<LogQueue>> queues = {};
+				{
+					const std::lock_guard<std::mutex> guard(this->_queuesLock);
+					queues = this->_queues;
+				}
+
+				size_t total = 0;
+				for (const auto& queue : queues) {
+					const bool alive = queue->alive; // Read before draining, so nothing written before the thread exited is missed
+					total += this->drain(*queue, buffer);
+
+					if (!alive) {
+						const std::lock_guard<std::mutex> guard(this->_queuesLock);
+						std::erase(this->_queues, queue);
+					}
+				}
+
+				return total;
+			}
+
+			void run() {
+				fmt::memory_buffer buffer;
+				auto lastSync = std::chrono::steady_clock::now();
+				bool dirty = false;
+
+				while (true) {
+					uint64_t request = 0;
+					bool stopping = false;
+					{
+						const std::lock_guard<std::mutex> guard(this->_lock);
+						request = this->_flushRequest;
+						stopping = !this->running;
+					}
+
+					const size_t written = this->drainAll(buffer);
+					dirty |= written > 0;
+
+					auto now = std::chrono::steady_clock::now();
+					if (dirty && (request != this->_flushDone || stopping || now - lastSync >= Logger::FLUSH_INTERVAL)) {
+						this->_output->flush(); // Batched, syncing every message is too slow
+
+						dirty = false;
+						lastSync = now;
+					}
+
+					std::unique_lock<std::mutex> lock(this->_lock);
+					this->_flushDone = request;
+					this->_flushed.notify_all();
+
+					if (stopping) break;
+					if (written > 0 || this->_flushRequest != request || !this->running) continue;
+
+					// Producers only notify while we sleep, so check the queues again after saying so
+					this->sleeping = true;
+					if (!this->pending()) {
+						if (dirty) {
+							this->_wake.wait_until(lock, lastSync + Logger::FLUSH_INTERVAL);
+						} else {
+							this->_wake.wait(lock);
+						}
+					}
+
+					this->sleeping = false;
+				}
+			}
+
+		public:
+			bool running = true; // Guarded by _lock
+			std::atomic<bool> stopped = false;
+			std::atomic<bool> sleeping = false;
+
+			explicit LogBackend(std::shared_ptr<spdlog::logger> output) : _output(std::move(output)) { this->_thread = std::thread([this]() { this->run(); }); } // After every member is initialized
+
+			[[nodiscard]] spdlog::logger& output() const { return *this->_output; }
+
+			// Called after a record is pushed
+			void wake() {
+				if (!this->sleeping) return;
+
+				const std::lock_guard<std::mutex> guard(this->_lock);
+				this->_wake.notify_one();
+			}
+
+			std::shared_ptr<LogQueue> createQueue() {
+				auto queue = std::make_shared<LogQueue>(Logger::QUEUE_SIZE);
+
+				const std::lock_guard<std::mutex> guard(this->_queuesLock);
+				this->_queues.push_back(queue);
+
+				return queue;
+			}
+
+			void flush() {
+				std::unique_lock<std::mutex> lock(this->_lock);
+				if (!this->running) return;
+
+				const uint64_t ticket = ++this->_flushRequest;
+				this->_wake.notify_one();
+				this->_flushed.wait(lock, [this, ticket]() { return this->_flushDone >= ticket || !this->running; });
+			}
+
+			void stop() {
+				{
+					const std::lock_guard<std::mutex> guard(this->_lock);
+					this->running = false;
+					this->_wake.notify_one();
+				}
+
+				if (this->_thread.joinable()) this->_thread.join();
+				this->stopped = true;
+
+				// Anything queued while stopping
+				fmt::memory_buffer buffer;
+				this->drainAll(buffer);
+				this->_output->flush();
+			}
+		};
+
+		// Never destroyed, loggers can still be used during static destruction (written directly once stopped)
+		std::atomic<LogBackend*> backend = nullptr;
+
+		// The first call's output is used for good. The atexit is registered after it exists, so it runs before it's destroyed
+		LogBackend* getBackend(const std::shared_ptr<spdlog::logger>& output) {
+			static LogBackend* instance = [&output]() {
+				auto* created = new LogBackend(output);
+				backend = created;
+
+				std::atexit([]() { backend.load()->stop(); });
+				return created;
+			}();
+
+			return instance;
+		}
+
+		const std::string* intern(const std::string& title) {
+			static std::mutex lock;
+			static auto* titles = new std::unordered_set<std::string>();
+
+			const std::lock_guard<std::mutex> guard(lock);
+			return &*titles->insert(title).first;
+		}
+
+		// Plain pointers, they are safe to read after the thread's destructors ran
+		thread_local LogQueue* threadQueue = nullptr;
+		thread_local bool threadExited = false;
+
+		struct QueueOwner {
+			std::shared_ptr<LogQueue> queue = nullptr;
+
+			QueueOwner() = default;
+			QueueOwner(const QueueOwner&) = delete;
+			QueueOwner(QueueOwner&&) = delete;
+			QueueOwner& operator=(const QueueOwner&) = delete;
+			QueueOwner& operator=(QueueOwner&&) = delete;
+			~QueueOwner() {
+				if (this->queue != nullptr) this->queue->alive = false; // The logger thread drains and frees it
+
+				threadQueue = nullptr;
+				threadExited = true;
+			}
+		};
+
+		LogQueue* getQueue() {
+			if (threadQueue != nullptr || threadExited) return threadQueue;
+
+			auto* logBackend = backend.load();
+			if (logBackend == nullptr || logBackend->stopped) return nullptr;
+
+			thread_local QueueOwner owner;
+			owner.queue = logBackend->createQueue();
+			threadQueue = owner.queue.get();
+
+			return threadQueue;
+		}
+	} // namespace
+
 #ifdef _DEBUG
 	spdlog::level::level_enum Logger::LEVEL = spdlog::level::trace; // Default
 #else
@@ -10,22 +314,89 @@ namespace rawrbox {
 	bool Logger::ENABLE_FILE_LOGGING = true;
 	std::shared_ptr<spdlog::logger> Logger::LOGGER = nullptr;
 
-	Logger::Logger(const std::string& title) : _title(title) {
-		if (LOGGER != nullptr) return;
+	std::chrono::milliseconds Logger::FLUSH_INTERVAL = std::chrono::milliseconds(500);
+	size_t Logger::QUEUE_SIZE = 256 * 1024;
 
+	Logger::Logger(const std::string& title) : _title(intern(title)) {
+		if (LOGGER == nullptr) createLogger();
+		getBackend(LOGGER);
+	}
+
+	// PROTECTED ----
+	void Logger::createLogger() {
 		auto _spdConsole = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
 
 		if (ENABLE_FILE_LOGGING) {
-			auto _spdLogFile = std::make_shared<spdlog::sinks::basic_file_sink_mt>("logs.log", true);
+			auto _spdLogFile = std::make_shared<FileSink>("logs.log");
 			LOGGER = std::make_shared<spdlog::logger>("CONSOLE", spdlog::sinks_init_list{_spdConsole, _spdLogFile});
 		} else {
 			LOGGER = std::make_shared<spdlog::logger>("CONSOLE", spdlog::sinks_init_list{_spdConsole});
 		}
 
 		LOGGER->set_pattern("[%^%l%$%v");
-		LOGGER->set_level(Logger::LEVEL);
+		LOGGER->set_level(spdlog::level::trace); // Already filtered by LEVEL before being queued
 
 		spdlog::set_default_logger(LOGGER);
 		spdlog::set_error_handler([](const std::string& msg) { fmt::print("*** LOG ERROR: {} ***\n", msg); });
 	}
+
+	rawrbox::LOG::Record* Logger::beginRecord(size_t argsSize) {
+		auto* queue = getQueue();
+		if (queue == nullptr) return nullptr;
+
+		const size_t size = (sizeof(rawrbox::LOG::Record) + argsSize + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1);
+		if (size > queue->data.size() / 4) return nullptr; // Huge message, not worth blocking the queue for it
+
+		size_t head = queue->head.load(std::memory_order_relaxed);
+		const size_t offset = head & queue->mask;
+		const size_t padding = offset + size > queue->data.size() ? queue->data.size() - offset : 0; // Records are never split
+
+		// Full, wait for the logger thread instead of dropping messages
+		while (head + padding + size - queue->tail.load(std::memory_order_acquire) > queue->data.size()) {
+			if (backend.load()->stopped) return nullptr;
+			std::this_thread::yield();
+		}
+
+		if (padding > 0) {
+			reinterpret_cast<rawrbox::LOG::Record*>(queue->data.data() + offset)->size = PADDING;
+			head += padding;
+		}
+
+		auto* record = new (queue->data.data() + (head & queue->mask)) rawrbox::LOG::Record();
+		record->size = static_cast<uint32_t>(size);
+
+		queue->reserved = head + size;
+		return record;
+	}
+
+	void Logger::endRecord() {
+		auto* queue = threadQueue;
+		queue->head.store(queue->reserved); // seq_cst, pairs with the logger thread's sleeping flag
+
+		backend.load()->wake();
+	}
+
+	void Logger::write(spdlog::level::level_enum level, const std::string& title, std::string_view message) {
+		auto* logBackend = backend.load();
+		if (logBackend == nullptr) return;
+
+		auto& output = logBackend->output();
+		if (level == spdlog::level::warn) {
+			output.log(level, " ▓ {}] {}", title, fmt::styled(message, fmt::fg(fmt::color::gold)));
+		} else {
+			output.log(level, " ▓ {}] {}", title, message);
+		}
+	}
+	// --------------
+
+	void Logger::flush() {
+		auto* logBackend = backend.load();
+		if (logBackend == nullptr) return;
+
+		if (logBackend->stopped) {
+			logBackend->output().flush();
+		} else {
+			logBackend->flush();
+		}
+	}
 } // namespace rawrbox
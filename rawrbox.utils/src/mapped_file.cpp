@@ -0,0 +1,108 @@
+#include <rawrbox/utils/mapped_file.hpp>
+
+#include <utility>
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace rawrbox {
+	MappedFile::MappedFile(const std::filesystem::path& path) {
+		this->open(path);
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept {
+		*this = std::move(other);
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+		if (this == &other) return *this;
+		this->close();
+
+		this->_data = std::exchange(other._data, nullptr);
+		this->_size = std::exchange(other._size, 0);
+#ifdef _WIN32
+		this->_file = std::exchange(other._file, nullptr);
+		this->_mapping = std::exchange(other._mapping, nullptr);
+#else
+		this->_file = std::exchange(other._file, -1);
+#endif
+
+		return *this;
+	}
+
+	MappedFile::~MappedFile() { this->close(); }
+
+	bool MappedFile::open(const std::filesystem::path& path) {
+		this->close();
+
+		std::error_code err;
+		auto size = std::filesystem::file_size(path, err);
+		if (err || size == 0) return false;
+
+#ifdef _WIN32
+		HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+		if (file == INVALID_HANDLE_VALUE) return false;
+
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr) {
+			CloseHandle(file);
+			return false;
+		}
+
+		void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (data == nullptr) {
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		this->_file = file;
+		this->_mapping = mapping;
+#else
+		int file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (file < 0) return false;
+
+		void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+		if (data == MAP_FAILED) {
+			::close(file);
+			return false;
+		}
+
+		this->_file = file;
+#endif
+
+		this->_data = static_cast<const uint8_t*>(data);
+		this->_size = static_cast<size_t>(size);
+
+		return true;
+	}
+
+	void MappedFile::close() {
+#ifdef _WIN32
+		if (this->_data != nullptr) UnmapViewOfFile(this->_data);
+		if (this->_mapping != nullptr) CloseHandle(this->_mapping);
+		if (this->_file != nullptr) CloseHandle(this->_file);
+
+		this->_file = nullptr;
+		this->_mapping = nullptr;
+#else
+		if (this->_data != nullptr) munmap(const_cast<uint8_t*>(this->_data), this->_size);
+		if (this->_file >= 0) ::close(this->_file);
+
+		this->_file = -1;
+#endif
+
+		this->_data = nullptr;
+		this->_size = 0;
+	}
+
+	bool MappedFile::valid() const { return this->_data != nullptr; }
+	std::span<const uint8_t> MappedFile::data() const { return {this->_data, this->_size}; }
+	size_t MappedFile::size() const { return this->_size; }
+} // namespace rawrbox
@@ -21,6 +21,45 @@ namespace rawrbox {
 		return normalizePath(path1) == normalizePath(path2);
 	}
 
+	std::string PathUtils::toKey(const std::filesystem::path& path) {
+		auto key = path.generic_string();
+		while (key.starts_with("./"))
+			key.erase(0, 2);
+
+		// Most paths are already clean & relative, skip the (slow) lexical normalization
+		if (!key.empty() && key.front() != '/' && key.find(':') == std::string::npos && key.find("//") == std::string::npos && key.find("/.") == std::string::npos && !key.starts_with("..") && key.back() != '.' && key.back() != '/') {
+			return key;
+		}
+
+		auto normal = path.lexically_normal();
+		if (normal.is_absolute()) {
+			// Not cached, the working directory can change
+			std::error_code err;
+			auto workingDir = std::filesystem::current_path(err);
+
+			if (!err && !workingDir.empty()) {
+				auto relative = normal.lexically_relative(workingDir);
+				if (!relative.empty() && *relative.begin() != "..") normal = relative;
+			}
+		}
+
+		key = normal.generic_string();
+		if (key.starts_with("./")) key.erase(0, 2);
+
+		return key;
+	}
+
+	uint64_t PathUtils::hash(std::string_view key) {
+		// FNV-1a
+		uint64_t hash = 0xcbf29ce484222325ULL;
+		for (char c : key) {
+			hash ^= static_cast<uint8_t>(c);
+			hash *= 0x100000001b3ULL;
+		}
+
+		return hash;
+	}
+
 	std::vector<std::string> PathUtils::glob(const std::filesystem::path& root, bool ignoreFiles) {
 		std::vector<std::string> dirs = {};
 
@@ -0,0 +1,250 @@
+#include <rawrbox/utils/logger.hpp>
+#include <rawrbox/utils/profiler.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <fstream>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace rawrbox {
+	// BUFFER ----
+	bool ProfileBuffer::push(uint32_t capture, const rawrbox::ProfileEvent& event) {
+		auto& store = this->stores[capture % 2];
+
+		// First event of a new capture, drop the old ones. Only this thread writes to it, and the export reads the other store
+		const uint32_t storeCapture = store.capture.load(std::memory_order_relaxed);
+		if (storeCapture != capture) {
+			if (storeCapture > capture) return false; // Zone of an old capture, ended after two new ones started
+
+			store.size.store(0, std::memory_order_relaxed);
+			store.capture.store(capture, std::memory_order_release);
+		}
+
+		const size_t index = store.size.load(std::memory_order_relaxed);
+
+		const size_t chunkIndex = index / CHUNK_SIZE;
+		if (chunkIndex >= MAX_CHUNKS) return false;
+
+		auto* chunk = store.chunks[chunkIndex].load(std::memory_order_acquire);
+		if (chunk == nullptr) {
+			chunk = new rawrbox::ProfileEvent[CHUNK_SIZE]; // Kept for the next captures, never freed
+			store.chunks[chunkIndex].store(chunk, std::memory_order_release);
+		}
+
+		chunk[index % CHUNK_SIZE] = event;
+		store.size.store(index + 1, std::memory_order_release);
+		return true;
+	}
+
+	const ProfileBuffer::Store& ProfileBuffer::getStore(uint32_t capture) const { return this->stores[capture % 2]; }
+
+	const rawrbox::ProfileEvent& ProfileBuffer::Store::get(size_t index) const {
+		return this->chunks[index / CHUNK_SIZE].load(std::memory_order_acquire)[index % CHUNK_SIZE];
+	}
+	// -----------
+
+	// PROTECTED ----
+	std::atomic<bool> PROFILER::_recording = false;
+	std::atomic<uint32_t> PROFILER::_capture = 0;
+	std::atomic<uint64_t> PROFILER::_dropped = 0;
+	std::atomic<uint64_t> PROFILER::_frame = 0;
+	std::atomic<uint64_t> PROFILER::_captureStart = 0;
+	std::chrono::steady_clock::time_point PROFILER::_epoch = std::chrono::steady_clock::now();
+
+	std::mutex PROFILER::_lock;
+	std::vector<rawrbox::ProfileBuffer*> PROFILER::_buffers = {};
+	// -----------
+
+	namespace {
+		thread_local rawrbox::ProfileBuffer* threadBuffer = nullptr;
+
+		void writeEscaped(fmt::memory_buffer& out, std::string_view str) {
+			for (const char c : str) {
+				switch (c) {
+					case '"': fmt::format_to(fmt::appender(out), "\\\""); break;
+					case '\\': fmt::format_to(fmt::appender(out), "\\\\"); break;
+					case '\n': fmt::format_to(fmt::appender(out), "\\n"); break;
+					case '\t': fmt::format_to(fmt::appender(out), "\\t"); break;
+					case '\r': fmt::format_to(fmt::appender(out), "\\r"); break;
+					default:
+						if (static_cast<unsigned char>(c) < 0x20) {
+							fmt::format_to(fmt::appender(out), "\\u{:04x}", static_cast<int>(c));
+						} else {
+							out.push_back(c);
+						}
+						break;
+				}
+			}
+		}
+	} // namespace
+
+	rawrbox::ProfileBuffer& PROFILER::getBuffer() {
+		if (threadBuffer != nullptr) return *threadBuffer;
+
+		auto* buffer = new rawrbox::ProfileBuffer();
+
+		const std::lock_guard<std::mutex> lock(_lock);
+		buffer->id = static_cast<uint32_t>(_buffers.size() + 1);
+		buffer->name = fmt::format("thread-{}", buffer->id);
+		_buffers.push_back(buffer);
+
+		threadBuffer = buffer;
+		return *buffer;
+	}
+
+	void PROFILER::push(const rawrbox::ProfileEvent& event) {
+		auto& buffer = getBuffer();
+		if (!buffer.push(_capture.load(std::memory_order_acquire), event)) _dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+	// -----------
+
+	void PROFILER::start() {
+		const std::lock_guard<std::mutex> lock(_lock); // Not while exporting, the next capture reuses the stores of the one before the last
+
+		_dropped = 0;
+		_frame = 0;
+		_captureStart = now();
+
+		_capture.fetch_add(1, std::memory_order_release);
+		_recording = true;
+	}
+
+	void PROFILER::stop() { _recording = false; }
+
+	uint64_t PROFILER::now() {
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _epoch).count());
+	}
+
+	uint64_t PROFILER::getDropped() { return _dropped.load(); }
+
+	const char* PROFILER::intern(std::string_view str) {
+		static std::mutex lock;
+		static std::unordered_set<std::string>* strings = new std::unordered_set<std::string>(); // Leaked, same as the buffers
+
+		// Lookups by string_view, no allocation on a hit
+		struct Hash {
+			using is_transparent = void;
+			size_t operator()(std::string_view view) const { return std::hash<std::string_view>{}(view); }
+		};
+
+		thread_local std::unordered_map<std::string, const char*, Hash, std::equal_to<>> cache = {};
+
+		auto fnd = cache.find(str);
+		if (fnd != cache.end()) return fnd->second;
+
+		const char* interned = nullptr;
+		{
+			const std::lock_guard<std::mutex> guard(lock);
+			interned = strings->emplace(str).first->c_str();
+		}
+
+		cache.emplace(str, interned);
+		return interned;
+	}
+
+	void PROFILER::setThreadName(const std::string& name) {
+		auto& buffer = getBuffer();
+
+		const std::lock_guard<std::mutex> lock(_lock);
+		buffer.name = name;
+	}
+
+	void PROFILER::zone(const char* name, const char* detail, uint64_t start, uint64_t end) {
+		push({name, detail, start, end, 0.0, rawrbox::ProfileEventType::ZONE});
+	}
+
+	void PROFILER::counter(const char* name, double value) {
+		if (!isRecording()) return;
+
+		const uint64_t time = now();
+		push({name, nullptr, time, time, value, rawrbox::ProfileEventType::COUNTER});
+	}
+
+	void PROFILER::frame() {
+		if (!isRecording()) return;
+
+		const uint64_t time = now();
+		push({"frame", nullptr, time, time, static_cast<double>(_frame++), rawrbox::ProfileEventType::FRAME});
+	}
+
+	std::string PROFILER::exportJSON() {
+		struct Entry {
+			const rawrbox::ProfileEvent* event;
+			uint32_t thread;
+		};
+
+		fmt::memory_buffer out;
+		std::vector<Entry> entries = {};
+
+		const std::lock_guard<std::mutex> lock(_lock);
+		const uint32_t capture = _capture.load(std::memory_order_acquire);
+		const uint64_t captureStart = _captureStart.load();
+
+		fmt::format_to(fmt::appender(out), "{{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+		fmt::format_to(fmt::appender(out), "{{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{{\"name\":\"rawrbox\"}}}}");
+
+		for (const auto* buffer : _buffers) {
+			fmt::format_to(fmt::appender(out), ",\n{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"", buffer->id);
+			writeEscaped(out, buffer->name);
+			fmt::format_to(fmt::appender(out), "\"}}}}");
+
+			const auto& store = buffer->getStore(capture);
+			if (store.capture.load(std::memory_order_acquire) != capture) continue; // Nothing recorded on this capture
+
+			const size_t size = store.size.load(std::memory_order_acquire);
+			for (size_t i = 0; i < size; i++) {
+				const auto& event = store.get(i);
+				if (event.start < captureStart) continue; // Zone opened on an old capture, that ended after the new one started
+
+				entries.push_back({&event, buffer->id});
+			}
+		}
+
+		// Parents first, so viewers nest them correctly
+		std::ranges::stable_sort(entries, [](const Entry& a, const Entry& b) {
+			if (a.event->start != b.event->start) return a.event->start < b.event->start;
+			return a.event->end > b.event->end;
+		});
+
+		for (const auto& entry : entries) {
+			const auto& event = *entry.event;
+
+			out.push_back(',');
+			out.push_back('\n');
+			fmt::format_to(fmt::appender(out), "{{\"name\":\"");
+			writeEscaped(out, event.name != nullptr ? event.name : "?");
+			fmt::format_to(fmt::appender(out), "\",\"cat\":\"rawrbox\",\"pid\":1,\"tid\":{},\"ts\":{:.3f}", entry.thread, static_cast<double>(event.start) / 1000.0);
+
+			switch (event.type) {
+				case rawrbox::ProfileEventType::ZONE:
+					fmt::format_to(fmt::appender(out), ",\"ph\":\"X\",\"dur\":{:.3f}", static_cast<double>(event.end - event.start) / 1000.0);
+					if (event.detail != nullptr) {
+						fmt::format_to(fmt::appender(out), ",\"args\":{{\"detail\":\"");
+						writeEscaped(out, event.detail);
+						fmt::format_to(fmt::appender(out), "\"}}");
+					}
+					break;
+				case rawrbox::ProfileEventType::COUNTER:
+					fmt::format_to(fmt::appender(out), ",\"ph\":\"C\",\"args\":{{\"value\":{}}}", event.value);
+					break;
+				case rawrbox::ProfileEventType::FRAME:
+					fmt::format_to(fmt::appender(out), ",\"ph\":\"i\",\"s\":\"g\",\"args\":{{\"frame\":{}}}", static_cast<uint64_t>(event.value));
+					break;
+			}
+
+			out.push_back('}');
+		}
+
+		fmt::format_to(fmt::appender(out), "]}}");
+		return fmt::to_string(out);
+	}
+
+	void PROFILER::exportJSON(const std::filesystem::path& path) {
+		std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) RAWRBOX_CRITICAL("Failed to open '{}' for writing", path.generic_string());
+
+		file << exportJSON();
+	}
+} // namespace rawrbox
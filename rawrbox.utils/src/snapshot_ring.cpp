@@ -0,0 +1,292 @@
+#include <rawrbox/utils/logger.hpp>
+#include <rawrbox/utils/snapshot_ring.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace rawrbox {
+	namespace {
+		// Shorter matches cost more to skip than to store
+		constexpr size_t MIN_MATCH = 4;
+
+		void writeVarint(std::vector<uint8_t>& out, size_t value) {
+			while (value >= 0x80) {
+				out.push_back(static_cast<uint8_t>(value | 0x80));
+				value >>= 7;
+			}
+
+			out.push_back(static_cast<uint8_t>(value));
+		}
+
+		size_t readVarint(const std::vector<uint8_t>& in, size_t& pos) {
+			size_t value = 0;
+			for (size_t shift = 0; pos < in.size(); shift += 7) {
+				const uint8_t byte = in[pos++];
+				value |= static_cast<size_t>(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0) return value;
+			}
+
+			RAWRBOX_CRITICAL("[RawrBox-SnapshotRing] Corrupted delta");
+		}
+
+		// Bytes past the end of the base count as zero
+		uint8_t baseAt(const std::vector<uint8_t>& base, size_t index) {
+			return index < base.size() ? base[index] : 0;
+		}
+
+		size_t matchLength(const std::vector<uint8_t>& base, const uint8_t* target, size_t start, size_t size) {
+			size_t i = start;
+
+			// 8 bytes at a time while both sides have them, most of a frame is usually untouched
+			const size_t shared = std::min(base.size(), size);
+			while (i + 8 <= shared) {
+				uint64_t a = 0;
+				uint64_t b = 0;
+				std::memcpy(&a, base.data() + i, 8);
+				std::memcpy(&b, target + i, 8);
+				if (a != b) break;
+
+				i += 8;
+			}
+
+			while (i < size && target[i] == baseAt(base, i))
+				i++;
+
+			return i - start;
+		}
+	} // namespace
+
+	SnapshotRing::SnapshotRing(size_t capacity, size_t keyframeInterval) : _keyframeInterval(std::max<size_t>(keyframeInterval, 1)) {
+		this->_frames.resize(std::max<size_t>(capacity, 1));
+	}
+
+	// PROTECTED ----
+	rawrbox::Snapshot& SnapshotRing::at(size_t index) {
+		return this->_frames[(this->_head + index) % this->_frames.size()];
+	}
+
+	const rawrbox::Snapshot& SnapshotRing::at(size_t index) const {
+		return this->_frames[(this->_head + index) % this->_frames.size()];
+	}
+
+	std::optional<size_t> SnapshotRing::indexOf(uint64_t frame) const {
+		// Frames always go up, so binary search
+		size_t low = 0;
+		size_t high = this->_count;
+
+		while (low < high) {
+			const size_t mid = (low + high) / 2;
+			const uint64_t value = this->at(mid).frame;
+
+			if (value == frame) return mid;
+			if (value < frame) {
+				low = mid + 1;
+			} else {
+				high = mid;
+			}
+		}
+
+		return std::nullopt;
+	}
+
+	void SnapshotRing::rebuild(size_t index, std::vector<uint8_t>& out, std::vector<uint8_t>& scratch) const {
+		size_t keyframe = index;
+		while (!this->at(keyframe).keyframe)
+			keyframe--; // The oldest frame is always a keyframe
+
+		out = this->at(keyframe).data;
+		for (size_t i = keyframe + 1; i <= index; i++) {
+			const auto& snapshot = this->at(i);
+
+			decode(out, snapshot.data, snapshot.size, scratch);
+			std::swap(out, scratch);
+		}
+	}
+
+	void SnapshotRing::evict() {
+		// The next one is about to lose its base, promote it to a keyframe
+		if (this->_count > 1 && !this->at(1).keyframe) {
+			auto& next = this->at(1);
+
+			decode(this->at(0).data, next.data, next.size, this->_scratch);
+			next.data = this->_scratch;
+			next.keyframe = true;
+		}
+
+		this->at(0) = {};
+		this->_head = (this->_head + 1) % this->_frames.size();
+		this->_count--;
+	}
+	// -------------
+
+	void SnapshotRing::push(uint64_t frame, const void* data, size_t size, uint32_t hash) {
+		const auto newest = this->getNewest();
+		if (newest.has_value() && frame <= *newest) {
+			if (frame == 0) {
+				this->clear();
+			} else {
+				this->discard(frame - 1);
+			}
+		}
+
+		if (this->_count == this->_frames.size()) this->evict();
+
+		const auto* bytes = static_cast<const uint8_t*>(data);
+		const bool keyframe = this->_count == 0 || this->_sinceKeyframe + 1 >= this->_keyframeInterval;
+
+		rawrbox::Snapshot snapshot = {};
+		snapshot.frame = frame;
+		snapshot.hash = hash;
+		snapshot.keyframe = keyframe;
+		snapshot.size = size;
+
+		if (keyframe) {
+			snapshot.data.assign(bytes, bytes + size);
+			this->_sinceKeyframe = 0;
+		} else {
+			encode(this->_last, bytes, size, snapshot.data);
+			this->_sinceKeyframe++;
+		}
+
+		this->_last.assign(bytes, bytes + size);
+
+		this->at(this->_count) = std::move(snapshot);
+		this->_count++;
+	}
+
+	bool SnapshotRing::get(uint64_t frame, std::vector<uint8_t>& out) const {
+		const auto index = this->indexOf(frame);
+		if (!index.has_value()) return false;
+
+		if (*index + 1 == this->_count) {
+			out = this->_last;
+			return true;
+		}
+
+		std::vector<uint8_t> scratch = {};
+		this->rebuild(*index, out, scratch);
+		return true;
+	}
+
+	void SnapshotRing::discard(uint64_t frame) {
+		size_t keep = 0;
+		while (keep < this->_count && this->at(keep).frame <= frame)
+			keep++;
+
+		if (keep == this->_count) return;
+
+		for (size_t i = keep; i < this->_count; i++) {
+			this->at(i) = {};
+		}
+
+		this->_count = keep;
+		if (this->_count == 0) {
+			this->clear();
+			return;
+		}
+
+		// Next push deltas against the new newest frame
+		this->rebuild(this->_count - 1, this->_last, this->_scratch);
+
+		this->_sinceKeyframe = 0;
+		for (size_t i = this->_count; i-- > 0 && !this->at(i).keyframe;) {
+			this->_sinceKeyframe++;
+		}
+	}
+
+	void SnapshotRing::clear() {
+		for (auto& snapshot : this->_frames) {
+			snapshot = {};
+		}
+
+		this->_head = 0;
+		this->_count = 0;
+		this->_sinceKeyframe = 0;
+		this->_last.clear();
+	}
+
+	bool SnapshotRing::has(uint64_t frame) const { return this->indexOf(frame).has_value(); }
+
+	std::optional<uint32_t> SnapshotRing::getHash(uint64_t frame) const {
+		const auto index = this->indexOf(frame);
+		if (!index.has_value()) return std::nullopt;
+
+		return this->at(*index).hash;
+	}
+
+	std::optional<uint64_t> SnapshotRing::getOldest() const {
+		if (this->_count == 0) return std::nullopt;
+		return this->at(0).frame;
+	}
+
+	std::optional<uint64_t> SnapshotRing::getNewest() const {
+		if (this->_count == 0) return std::nullopt;
+		return this->at(this->_count - 1).frame;
+	}
+
+	size_t SnapshotRing::size() const { return this->_count; }
+	size_t SnapshotRing::capacity() const { return this->_frames.size(); }
+	bool SnapshotRing::empty() const { return this->_count == 0; }
+
+	size_t SnapshotRing::getMemoryUsage() const {
+		size_t total = 0;
+		for (size_t i = 0; i < this->_count; i++) {
+			total += this->at(i).data.size();
+		}
+
+		return total;
+	}
+
+	// DELTA ---
+	void SnapshotRing::encode(const std::vector<uint8_t>& base, const uint8_t* target, size_t size, std::vector<uint8_t>& out) {
+		out.clear();
+
+		size_t pos = 0;
+		while (pos < size) {
+			const size_t skip = matchLength(base, target, pos, size);
+			if (pos + skip == size) break; // Rest matches, decode copies it from the base
+
+			// Changed bytes, until a match long enough to be worth skipping
+			size_t end = pos + skip;
+			while (end < size) {
+				const size_t limit = std::min(end + MIN_MATCH, size);
+				if (target[end] == baseAt(base, end) && matchLength(base, target, end, limit) == limit - end) break;
+				end++;
+			}
+
+			writeVarint(out, skip);
+			writeVarint(out, end - pos - skip);
+			out.insert(out.end(), target + pos + skip, target + end);
+
+			pos = end;
+		}
+	}
+
+	void SnapshotRing::decode(const std::vector<uint8_t>& base, const std::vector<uint8_t>& delta, size_t size, std::vector<uint8_t>& out) {
+		out.resize(size);
+
+		const auto copyBase = [&](size_t from, size_t count) {
+			const size_t available = from < base.size() ? std::min(count, base.size() - from) : 0;
+			if (available != 0) std::memcpy(out.data() + from, base.data() + from, available);
+			if (available != count) std::memset(out.data() + from + available, 0, count - available);
+		};
+
+		size_t pos = 0;
+		size_t read = 0;
+		while (read < delta.size()) {
+			const size_t skip = readVarint(delta, read);
+			const size_t count = readVarint(delta, read);
+			if (pos + skip + count > size || read + count > delta.size()) RAWRBOX_CRITICAL("[RawrBox-SnapshotRing] Corrupted delta");
+
+			copyBase(pos, skip);
+			pos += skip;
+
+			std::memcpy(out.data() + pos, delta.data() + read, count);
+			pos += count;
+			read += count;
+		}
+
+		copyBase(pos, size - pos);
+	}
+	// ---
+} // namespace rawrbox
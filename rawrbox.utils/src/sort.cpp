@@ -0,0 +1,60 @@
+#include <rawrbox/utils/sort.hpp>
+
+#include <array>
+#include <numeric>
+
+namespace rawrbox {
+	void SortUtils::radix(const std::vector<uint64_t>& keys, std::vector<uint32_t>& order, rawrbox::SortUtils::RadixScratch& scratch) {
+		constexpr size_t PASSES = sizeof(uint64_t);
+		constexpr size_t BUCKETS = 256;
+
+		order.resize(keys.size());
+		std::iota(order.begin(), order.end(), 0U);
+		if (keys.size() < 2) return;
+
+		// All the histograms in one read of the keys
+		std::array<std::array<uint32_t, BUCKETS>, PASSES> histograms = {};
+		for (auto key : keys) {
+			for (size_t pass = 0; pass < PASSES; pass++) {
+				histograms[pass][(key >> (pass * 8)) & 0xFF]++;
+			}
+		}
+
+		// Keys move along with the indices, so every pass reads them in order
+		scratch.keys.assign(keys.begin(), keys.end());
+		scratch.keysSwap.resize(keys.size());
+		scratch.orderSwap.resize(keys.size());
+
+		const auto total = static_cast<uint32_t>(keys.size());
+
+		for (size_t pass = 0; pass < PASSES; pass++) {
+			const size_t shift = pass * 8;
+
+			auto& histogram = histograms[pass];
+			if (histogram[(keys[0] >> shift) & 0xFF] == total) continue; // Same byte everywhere, nothing to move
+
+			uint32_t offset = 0;
+			for (auto& count : histogram) {
+				const uint32_t size = count;
+				count = offset;
+				offset += size;
+			}
+
+			for (size_t i = 0; i < keys.size(); i++) {
+				const uint64_t key = scratch.keys[i];
+				const uint32_t dest = histogram[(key >> shift) & 0xFF]++;
+
+				scratch.keysSwap[dest] = key;
+				scratch.orderSwap[dest] = order[i];
+			}
+
+			scratch.keys.swap(scratch.keysSwap);
+			order.swap(scratch.orderSwap);
+		}
+	}
+
+	void SortUtils::radix(const std::vector<uint64_t>& keys, std::vector<uint32_t>& order) {
+		rawrbox::SortUtils::RadixScratch scratch = {};
+		radix(keys, order, scratch);
+	}
+} // namespace rawrbox
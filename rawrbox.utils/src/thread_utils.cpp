@@ -1,3 +1,4 @@
+#include <rawrbox/utils/profiler.hpp>
 #include <rawrbox/utils/thread_utils.hpp>
 
 #include <bit>
@@ -28,8 +29,16 @@ namespace rawrbox {
 			RaiseException(0x406D1388, 0, sizeof(info) / sizeof(ULONG_PTR), std::bit_cast<ULONG_PTR*>(&info));
 		} __except (EXCEPTION_EXECUTE_HANDLER) {
 		}
+
+	#ifdef RAWRBOX_PROFILER
+		rawrbox::PROFILER::setThreadName(name);
+	#endif
 	}
 #else
-	void ThreadUtils::setName(const std::string& name) {}
+	void ThreadUtils::setName([[maybe_unused]] const std::string& name) {
+	#ifdef RAWRBOX_PROFILER
+		rawrbox::PROFILER::setThreadName(name);
+	#endif
+	}
 #endif
 } // namespace rawrbox
@@ -1,3 +1,4 @@
+#include <rawrbox/utils/profiler.hpp>
 #include <rawrbox/utils/threading.hpp>
 
 #include <fmt/format.h>
@@ -20,16 +21,38 @@ namespace rawrbox {
 		if (_pool == nullptr) return;
 
 		_pool->purge();
-		_pool->reset();
+		_pool.reset(); // Waits for the running tasks, init can be called again
 	}
 
 	void ASYNC::run(const std::function<void()>& job) {
 		if (_pool == nullptr) RAWRBOX_CRITICAL("ASYNC not initialized!");
 
 		try {
+#ifdef RAWRBOX_PROFILER
+			_pool->detach_task([job]() {
+				RAWRBOX_PROFILE_ZONE("ASYNC::run");
+				job();
+			});
+#else
 			_pool->detach_task(job);
+#endif
 		} catch (const std::exception& e) {
 			RAWRBOX_CRITICAL("Fatal error\n  └── {}", e.what());
 		}
 	}
+
+	void ASYNC::loop(size_t begin, size_t end, const std::function<void(size_t)>& job) {
+		if (begin >= end) return;
+		RAWRBOX_PROFILE_ZONE("ASYNC::loop");
+
+		if (_pool == nullptr || end - begin == 1 || BS::this_thread::get_index().has_value()) {
+			for (size_t i = begin; i < end; i++) {
+				job(i);
+			}
+
+			return;
+		}
+
+		_pool->submit_loop(begin, end, job).get();
+	}
 } // namespace rawrbox
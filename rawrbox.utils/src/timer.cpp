@@ -1,45 +1,207 @@
 #include <rawrbox/utils/time.hpp>
 #include <rawrbox/utils/timer.hpp>
 
+#include <algorithm>
+#include <bit>
+#include <cmath>
 #include <utility>
 
 namespace rawrbox {
+	// PROTECTED ----
+	std::array<std::array<TIMER::Bucket, TIMER::WHEEL_SLOTS>, TIMER::WHEEL_LEVELS> TIMER::_wheel = {};
+	std::array<size_t, TIMER::WHEEL_LEVELS> TIMER::_wheelCounts = {};
+	TIMER::Bucket TIMER::_overflow = {};
+	TIMER::Bucket TIMER::_firing = {};
+	uint64_t TIMER::_now = 0;
+
+	rawrbox::TIMER* TIMER::_current = nullptr;
+
+	std::vector<std::unique_ptr<rawrbox::TIMER>> TIMER::_pool = {};
+	std::vector<uint32_t> TIMER::_generations = {};
+	std::vector<uint32_t> TIMER::_freeSlots = {};
+	// -----------
+
+	// PUBLIC ----
 	uint32_t TIMER::ID = 0;
-	std::unordered_map<std::string, std::unique_ptr<rawrbox::TIMER>> TIMER::timers = {};
+	std::unordered_map<std::string, rawrbox::TIMER*> TIMER::timers = {};
+	uint64_t (*TIMER::CLOCK)() = &rawrbox::TimeUtils::time;
+	// -----------
 
-	// STATIC -----
-	void TIMER::update() {
-		if (timers.empty()) return;
-
-		auto time = static_cast<float>(rawrbox::TimeUtils::time());
-		for (auto it = timers.begin(); it != timers.end();) {
-			auto& timer = (*it).second;
-			if (timer == nullptr) {
-				it = timers.erase(it);
-				continue;
-			}
+	// WHEEL -----
+	void TIMER::link(Bucket& bucket, rawrbox::TIMER* timer, int level) {
+		timer->_bucket = &bucket;
+		timer->_level = level;
+		if (level >= 0) _wheelCounts[level]++;
 
-			if (timer->_paused || time < timer->_nextTick) {
-				++it;
-				continue;
-			}
+		timer->_prev = bucket.tail;
+		timer->_next = nullptr;
+
+		if (bucket.tail != nullptr) {
+			bucket.tail->_next = timer;
+		} else {
+			bucket.head = timer;
+		}
 
+		bucket.tail = timer;
+	}
+
+	void TIMER::unlink(rawrbox::TIMER* timer) {
+		auto* bucket = timer->_bucket;
+		if (bucket == nullptr) return;
+
+		if (timer->_prev != nullptr) {
+			timer->_prev->_next = timer->_next;
+		} else {
+			bucket->head = timer->_next;
+		}
+
+		if (timer->_next != nullptr) {
+			timer->_next->_prev = timer->_prev;
+		} else {
+			bucket->tail = timer->_prev;
+		}
+
+		if (timer->_level >= 0) _wheelCounts[timer->_level]--;
+
+		timer->_bucket = nullptr;
+		timer->_level = -1;
+		timer->_prev = nullptr;
+		timer->_next = nullptr;
+	}
+
+	void TIMER::schedule(rawrbox::TIMER* timer, bool cascading) {
+		// Cascades run before the current tick fires, anything else would land on a tick that already ran
+		const uint64_t expiry = std::max(timer->_expiry, cascading ? _now : _now + 1);
+		if (expiry == _now) {
+			link(_wheel[0][_now & (WHEEL_SLOTS - 1)], timer, 0);
+			return;
+		}
+
+		// The highest bit that differs from now picks the level, so it cascades down as the time gets closer
+		const uint64_t diff = expiry ^ _now;
+		const size_t level = static_cast<size_t>(std::bit_width(diff) - 1) / WHEEL_BITS;
+
+		if (level >= WHEEL_LEVELS) {
+			link(_overflow, timer);
+			return;
+		}
+
+		const size_t slot = (expiry >> (level * WHEEL_BITS)) & (WHEEL_SLOTS - 1);
+		link(_wheel[level][slot], timer, static_cast<int>(level));
+	}
+
+	void TIMER::cascade(size_t level) {
+		auto& bucket = level < WHEEL_LEVELS ? _wheel[level][(_now >> (level * WHEEL_BITS)) & (WHEEL_SLOTS - 1)] : _overflow;
+
+		while (bucket.head != nullptr) {
+			auto* timer = bucket.head;
+			unlink(timer);
+			schedule(timer, true);
+		}
+	}
+
+	void TIMER::fire() {
+		auto& slot = _wheel[0][_now & (WHEEL_SLOTS - 1)];
+		if (slot.head == nullptr) return;
+
+		// Move them out first, callbacks can create / destroy timers
+		while (slot.head != nullptr) {
+			auto* timer = slot.head;
+			unlink(timer);
+			link(_firing, timer);
+		}
+
+		while (_firing.head != nullptr) {
+			auto* timer = _firing.head;
+			unlink(timer);
+
+			_current = timer;
 			if (timer->_func != nullptr) timer->_func(); // Tick
-			if (timer == nullptr) {                      // If timer was deleted after callback
-				it = timers.erase(it);
+			_current = nullptr;
+
+			if (timer->_destroyed) { // If timer was deleted after callback
+				release(timer);
 				continue;
 			}
 
 			// Life
+			timer->_fired++;
 			if (!timer->_infinite) timer->_ticks++;
 			if (!timer->_infinite && timer->_ticks >= timer->_iterations) {
+				_current = timer;
 				if (timer->_onComplete) timer->_onComplete();
-				it = timers.erase(it);
+				_current = nullptr;
+
+				release(timer);
 				continue;
 			}
 
-			timer->_nextTick += timer->_msDelay;
-			++it;
+			if (timer->_paused) continue; // Paused on its own callback, resume will schedule it
+
+			timer->_expiry = timer->getExpiry();
+			schedule(timer);
+		}
+	}
+
+	void TIMER::release(rawrbox::TIMER* timer) {
+		unlink(timer);
+
+		auto fnd = timers.find(timer->_id);
+		if (fnd != timers.end() && fnd->second == timer) timers.erase(fnd);
+
+		if (timer == _current) { // Still running its callback, freed once it returns
+			timer->_destroyed = true;
+			return;
+		}
+
+		const auto index = timer->_handle.index;
+		_generations[index]++;
+		_freeSlots.push_back(index);
+		_pool[index].reset();
+	}
+
+	uint64_t TIMER::getExpiry() const {
+		return this->_start + ((this->_fired + 1) * this->_delayUs) / 1000; // From the start, so rounding never adds up
+	}
+	// -----------
+
+	// STATIC -----
+	void TIMER::update() { update(CLOCK()); }
+
+	void TIMER::update(uint64_t time) {
+		while (_now < time) {
+			// Skip ahead to the next tick that has something to do
+			uint64_t idle = 0;
+			size_t level = 0;
+
+			for (; level < WHEEL_LEVELS && _wheelCounts[level] == 0; level++) {
+				idle = (idle << WHEEL_BITS) | (WHEEL_SLOTS - 1);
+			}
+
+			if (level == WHEEL_LEVELS && _overflow.head == nullptr) {
+				_now = time;
+				break;
+			}
+
+			if (idle != 0) {
+				const uint64_t skip = _now | idle;
+				if (skip >= time) {
+					_now = time;
+					break;
+				}
+
+				_now = skip;
+			}
+
+			_now++;
+
+			// Higher levels first, they can drop timers into the lower ones
+			for (size_t cascadeLevel = WHEEL_LEVELS; cascadeLevel > 0; cascadeLevel--) {
+				const uint64_t mask = (uint64_t(1) << (cascadeLevel * WHEEL_BITS)) - 1;
+				if ((_now & mask) == 0) cascade(cascadeLevel);
+			}
+
+			fire();
 		}
 	}
 
@@ -63,32 +225,68 @@ namespace rawrbox {
 		std::string _id = id.empty() ? std::to_string(++ID) : id;
 		if (exists(_id)) return nullptr;
 
+		uint32_t index = 0;
+		if (!_freeSlots.empty()) {
+			index = _freeSlots.back();
+			_freeSlots.pop_back();
+		} else {
+			index = static_cast<uint32_t>(_pool.size());
+			_pool.emplace_back(nullptr);
+			_generations.push_back(0);
+		}
+
 		auto t = std::make_unique<rawrbox::TIMER>();
-		t->_msDelay = msDelay;
+		t->_delayUs = static_cast<uint64_t>(std::llround(std::max(msDelay, 0.F) * 1000.0));
 		t->_func = std::move(func);
 		t->_onComplete = std::move(onComplete);
 		t->_iterations = reps;
 		t->_ticks = 0;
 		t->_id = _id;
+		t->_handle = {index, _generations[index]};
 		t->_infinite = reps <= 0;
-		t->_nextTick = static_cast<float>(rawrbox::TimeUtils::time()) + t->_msDelay;
+		t->_start = std::max(CLOCK(), _now);
+		t->_expiry = t->getExpiry();
 
-		timers[_id] = std::move(t);
-		return timers[_id].get();
+		auto* timer = t.get();
+		_pool[index] = std::move(t);
+		timers[_id] = timer;
+
+		schedule(timer);
+		return timer;
 	}
 
-	bool TIMER::destroy(const std::string& id) {
+	rawrbox::TIMER* TIMER::get(const std::string& id) {
 		auto fnd = timers.find(id);
-		if (fnd == timers.end()) return false;
-		fnd->second = nullptr; // Update will clean it
+		return fnd == timers.end() ? nullptr : fnd->second;
+	}
+
+	rawrbox::TIMER* TIMER::get(const rawrbox::TimerHandle& handle) {
+		if (handle.index >= _pool.size() || _generations[handle.index] != handle.generation) return nullptr;
+
+		auto* timer = _pool[handle.index].get();
+		return timer == nullptr || timer->_destroyed ? nullptr : timer;
+	}
 
+	bool TIMER::destroy(const std::string& id) {
+		auto* timer = get(id);
+		if (timer == nullptr) return false;
+
+		release(timer);
+		return true;
+	}
+
+	bool TIMER::destroy(const rawrbox::TimerHandle& handle) {
+		auto* timer = get(handle);
+		if (timer == nullptr) return false;
+
+		release(timer);
 		return true;
 	}
 
 	bool TIMER::pause(const std::string& id, bool pause) {
-		auto fnd = timers.find(id);
-		if (fnd == timers.end()) return false;
-		fnd->second->pause(pause);
+		auto* timer = get(id);
+		if (timer == nullptr) return false;
+		timer->pause(pause);
 
 		return true;
 	}
@@ -98,25 +296,69 @@ namespace rawrbox {
 	}
 
 	void TIMER::clear() {
+		auto* current = _current;
+		for (auto& timer : _pool) {
+			if (timer != nullptr && timer.get() != current) timer.reset();
+		}
+
+		_wheel = {};
+		_wheelCounts = {};
+		_overflow = {};
+		_firing = {};
+
 		timers.clear();
+		_freeSlots.clear();
+
+		for (uint32_t i = static_cast<uint32_t>(_pool.size()); i > 0; i--) {
+			if (_pool[i - 1] != nullptr) continue; // Only the running timer, it frees itself after its callback
+
+			_generations[i - 1]++;
+			_freeSlots.push_back(i - 1);
+		}
+
+		if (current != nullptr) {
+			current->_bucket = nullptr;
+			current->_level = -1;
+			current->_destroyed = true;
+		} else {
+			_now = 0;
+		}
+
 		ID = 0;
 	}
+
+	size_t TIMER::size() {
+		return timers.size();
+	}
+
+	uint64_t TIMER::now() {
+		return _now;
+	}
 	// -----------
-	void TIMER::destroy() {
-		auto fnd = timers.find(this->_id);
-		if (fnd == timers.end()) return;
 
-		timers.erase(fnd);
+	const std::string& TIMER::getID() const { return this->_id; }
+	const rawrbox::TimerHandle& TIMER::getHandle() const { return this->_handle; }
+	bool TIMER::isPaused() const { return this->_paused; }
+
+	void TIMER::destroy() {
+		release(this);
 	}
 
 	void TIMER::pause(bool pause) {
+		if (this->_paused == pause || this->_destroyed) return;
 		this->_paused = pause;
 
+		const uint64_t time = std::max(CLOCK(), _now);
 		if (pause) {
-			this->_pausedTime = static_cast<float>(rawrbox::TimeUtils::time());
+			this->_pausedAt = time;
+			unlink(this);
 		} else {
-			this->_nextTick += (static_cast<float>(rawrbox::TimeUtils::time()) - this->_pausedTime);
-			this->_pausedTime = 0;
+			this->_start += time - this->_pausedAt;
+			this->_pausedAt = 0;
+
+			if (this == _current) return; // Scheduled after its callback
+			this->_expiry = this->getExpiry();
+			schedule(this);
 		}
 	}
 } // namespace rawrbox
@@ -0,0 +1,100 @@
+#include <rawrbox/utils/batch_buffer.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+	struct Record {
+		uint32_t a = 0;
+		uint32_t b = 0;
+		float value = 0.F;
+
+		bool operator<(const Record& other) const { return std::tie(a, b) < std::tie(other.a, other.b); }
+		bool operator==(const Record& other) const = default;
+	};
+
+	// Same records, split between a number of threads
+	std::vector<Record> run(rawrbox::BatchBuffer<Record>& buffer, size_t threads, uint32_t count) {
+		std::vector<std::thread> workers = {};
+		for (size_t t = 0; t < threads; t++) {
+			workers.emplace_back([&buffer, t, threads, count]() {
+				for (uint32_t i = static_cast<uint32_t>(t); i < count; i += static_cast<uint32_t>(threads)) {
+					buffer.push({i % 97, i, static_cast<float>(i) * 0.5F});
+				}
+			});
+		}
+
+		for (auto& worker : workers)
+			worker.join();
+
+		std::vector<Record> out = {};
+		buffer.collect(out);
+		std::sort(out.begin(), out.end());
+
+		return out;
+	}
+} // namespace
+
+TEST_CASE("BatchBuffer should behave as expected", "[rawrbox::BatchBuffer]") {
+	SECTION("rawrbox::BatchBuffer::push / collect") {
+		rawrbox::BatchBuffer<Record> buffer(4);
+
+		buffer.push({1, 2, 3.F});
+		buffer.push({4, 5, 6.F});
+		REQUIRE(buffer.size() == 2);
+
+		std::vector<Record> out = {};
+		buffer.collect(out);
+
+		REQUIRE(out.size() == 2);
+		REQUIRE(out[0] == Record{1, 2, 3.F});
+		REQUIRE(buffer.empty());
+
+		buffer.collect(out);
+		REQUIRE(out.size() == 2); // Nothing new
+	}
+
+	SECTION("rawrbox::BatchBuffer overflow") {
+		rawrbox::BatchBuffer<Record> buffer(2);
+
+		for (uint32_t i = 0; i < 5; i++) {
+			buffer.push({i, i, 0.F});
+		}
+
+		std::vector<Record> out = {};
+		buffer.collect(out);
+
+		REQUIRE(out.size() == 5);
+		REQUIRE(buffer.capacity() >= 5); // Grown for the next batch
+
+		for (uint32_t i = 0; i < 5; i++) {
+			REQUIRE(out[i].a == i);
+		}
+	}
+
+	SECTION("rawrbox::BatchBuffer deterministic across thread counts") {
+		rawrbox::BatchBuffer<Record> buffer(64);
+
+		const auto single = run(buffer, 1, 20000);
+		REQUIRE(single.size() == 20000);
+
+		for (size_t threads : {2, 4, 8}) {
+			REQUIRE(run(buffer, threads, 20000) == single);
+		}
+	}
+}
+
+TEST_CASE("BatchBuffer benchmark", "[rawrbox::BatchBuffer][.benchmark]") {
+	rawrbox::BatchBuffer<Record> buffer(1024);
+	run(buffer, 8, 50000); // Warm up, grows to fit
+
+	BENCHMARK("50k records, 8 threads, collect + sort") {
+		return run(buffer, 8, 50000).size();
+	};
+}
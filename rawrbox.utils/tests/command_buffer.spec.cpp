@@ -0,0 +1,140 @@
+#include <rawrbox/utils/command_buffer.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+	enum class Type : uint8_t {
+		CREATE,
+		DESTROY,
+		SET
+	};
+
+	struct Command {
+		Type type = Type::SET;
+		uint32_t handle = 0;
+		uint32_t value = 0;
+	};
+
+	// Toy world, handle -> value
+	struct World {
+		std::unordered_map<uint32_t, uint32_t> objects = {};
+
+		void operator()(const Command& command) {
+			switch (command.type) {
+				case Type::CREATE:
+					objects[command.handle] = command.value;
+					break;
+				case Type::DESTROY:
+					objects.erase(command.handle);
+					break;
+				case Type::SET:
+					if (objects.contains(command.handle)) objects[command.handle] = command.value;
+					break;
+			}
+		}
+	};
+
+	void produce(rawrbox::CommandBuffer<Command>& buffer, uint32_t threads, uint32_t count) {
+		std::vector<std::thread> workers = {};
+		for (uint32_t t = 0; t < threads; t++) {
+			workers.emplace_back([&buffer, t, count]() {
+				for (uint32_t i = 0; i < count; i++) {
+					buffer.push({Type::SET, t, i});
+				}
+			});
+		}
+
+		for (auto& worker : workers)
+			worker.join();
+	}
+} // namespace
+
+TEST_CASE("CommandBuffer should behave as expected", "[rawrbox::CommandBuffer]") {
+	rawrbox::CommandBuffer<Command> buffer(4);
+
+	SECTION("rawrbox::CommandBuffer::reserve") {
+		const uint32_t a = buffer.reserve();
+		const uint32_t b = buffer.reserve();
+
+		REQUIRE(a != 0);
+		REQUIRE(b != 0);
+		REQUIRE(a != b);
+
+		buffer.clear();
+		REQUIRE(buffer.reserve() > b); // Never reused
+	}
+
+	SECTION("rawrbox::CommandBuffer::apply") {
+		for (uint32_t i = 0; i < 10; i++) {
+			buffer.push({Type::SET, 0, i}); // Past the capacity too
+		}
+
+		REQUIRE(buffer.size() == 10);
+
+		std::vector<uint32_t> order = {};
+		REQUIRE(buffer.apply([&order](const Command& command) { order.push_back(command.value); }) == 10);
+
+		REQUIRE(buffer.empty());
+		for (uint32_t i = 0; i < 10; i++) {
+			REQUIRE(order[i] == i);
+		}
+
+		// Pushed while applying, goes to the next one
+		buffer.push({Type::SET, 0, 0});
+		REQUIRE(buffer.apply([&buffer](const Command& command) { buffer.push({Type::SET, 0, command.value + 1}); }) == 1);
+		REQUIRE(buffer.size() == 1);
+	}
+
+	SECTION("rawrbox::CommandBuffer create then destroy") {
+		World world = {};
+
+		const uint32_t crate = buffer.reserve();
+		const uint32_t barrel = buffer.reserve();
+
+		// All in the same frame, barrel never gets to exist after it
+		buffer.push({Type::CREATE, crate, 1});
+		buffer.push({Type::CREATE, barrel, 2});
+		buffer.push({Type::SET, barrel, 3});
+		buffer.push({Type::SET, crate, 4});
+		buffer.push({Type::DESTROY, barrel});
+		buffer.push({Type::SET, barrel, 5}); // Already gone, ignored
+
+		buffer.apply(world);
+
+		REQUIRE(world.objects.size() == 1);
+		REQUIRE(world.objects[crate] == 4);
+		REQUIRE_FALSE(world.objects.contains(barrel));
+	}
+
+	SECTION("rawrbox::CommandBuffer multiple producers") {
+		produce(buffer, 8, 1000);
+		REQUIRE(buffer.size() == 8000);
+
+		// Each thread's commands keep their order
+		std::vector<uint32_t> next(8, 0);
+		buffer.apply([&next](const Command& command) {
+			REQUIRE(command.value == next[command.handle]);
+			next[command.handle]++;
+		});
+
+		for (uint32_t n : next) {
+			REQUIRE(n == 1000);
+		}
+	}
+}
+
+TEST_CASE("CommandBuffer benchmark", "[rawrbox::CommandBuffer][.benchmark]") {
+	rawrbox::CommandBuffer<Command> buffer(80000);
+	World world = {};
+
+	BENCHMARK("Record + apply (8 producers, 80k commands)") {
+		produce(buffer, 8, 10000);
+		return buffer.apply(world);
+	};
+}
@@ -0,0 +1,109 @@
+#include <rawrbox/utils/dirty_ranges.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstring>
+#include <random>
+#include <string>
+
+TEST_CASE("DirtyRanges should behave as expected", "[rawrbox::DirtyRanges]") {
+	SECTION("rawrbox::DirtyRanges::mark") {
+		rawrbox::DirtyRanges ranges(2, 8);
+
+		ranges.mark(10);
+		ranges.mark(50, 60);
+		REQUIRE(ranges.get().size() == 2);
+
+		ranges.mark(12); // Within gap of 10
+		REQUIRE(ranges.get().size() == 2);
+		REQUIRE(ranges.get()[0].start == 10);
+		REQUIRE(ranges.get()[0].end == 13);
+
+		ranges.mark(0, 5); // Before everything
+		REQUIRE(ranges.get().size() == 3);
+		REQUIRE(ranges.get()[0].start == 0);
+
+		ranges.mark(4, 55); // Bridges all of them
+		REQUIRE(ranges.get().size() == 1);
+		REQUIRE(ranges.get()[0].start == 0);
+		REQUIRE(ranges.get()[0].end == 60);
+		REQUIRE(ranges.count() == 60);
+
+		ranges.mark(5, 5); // Empty, ignored
+		REQUIRE(ranges.get().size() == 1);
+	}
+
+	SECTION("rawrbox::DirtyRanges::collapse") {
+		rawrbox::DirtyRanges ranges(0, 4);
+
+		ranges.mark(0);
+		ranges.mark(10);
+		ranges.mark(30);
+		ranges.mark(50);
+		ranges.mark(52, 60); // Over the limit, closest ones get merged
+
+		REQUIRE(ranges.get().size() == 4);
+		REQUIRE(ranges.get()[3].start == 50);
+		REQUIRE(ranges.get()[3].end == 60);
+
+		ranges.mark(100);
+		REQUIRE(ranges.get().size() == 4);
+		REQUIRE(ranges.get()[0].start == 0);
+		REQUIRE(ranges.get()[0].end == 11);
+	}
+
+	SECTION("rawrbox::DirtyRanges::clamp") {
+		rawrbox::DirtyRanges ranges(0);
+
+		ranges.mark(0, 10);
+		ranges.mark(20, 30);
+		ranges.mark(40, 50);
+
+		ranges.clamp(25);
+		REQUIRE(ranges.get().size() == 2);
+		REQUIRE(ranges.get()[1].end == 25);
+
+		ranges.clear();
+		REQUIRE(ranges.empty());
+	}
+}
+
+TEST_CASE("DirtyRanges benchmark", "[rawrbox::DirtyRanges][.benchmark]") {
+	// Same size as rawrbox::Instance
+	struct Instance {
+		std::array<float, 16> matrix = {};
+		std::array<uint32_t, 4> data = {};
+	};
+
+	constexpr size_t TOTAL = 100000;
+
+	std::vector<Instance> instances(TOTAL);
+	std::vector<Instance> gpu(TOTAL); // Stand-in for the upload
+
+	std::mt19937 rng(1337);
+	std::uniform_int_distribution<uint32_t> dist(0, TOTAL - 1);
+
+	BENCHMARK("Full upload (100k instances)") {
+		std::memcpy(gpu.data(), instances.data(), sizeof(Instance) * TOTAL);
+		return gpu.size();
+	};
+
+	for (size_t dirty : {10, 100, 1000, 10000}) {
+		std::vector<uint32_t> indices(dirty);
+		for (auto& index : indices)
+			index = dist(rng);
+
+		BENCHMARK("Dirty upload (100k instances, " + std::to_string(dirty) + " dirty)") {
+			rawrbox::DirtyRanges ranges;
+			for (auto index : indices)
+				ranges.mark(index);
+
+			for (const auto& range : ranges.get())
+				std::memcpy(gpu.data() + range.start, instances.data() + range.start, sizeof(Instance) * range.count());
+
+			return ranges.count();
+		};
+	}
+}
@@ -1,8 +1,29 @@
 #include <rawrbox/utils/event.hpp>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
 #include <string>
+#include <thread>
+#include <vector>
+
+// Counts this thread's heap allocations, so the dispatch can be checked to be allocation free
+namespace {
+	thread_local size_t allocations = 0;
+} // namespace
+
+void* operator new(std::size_t size) {
+	allocations++;
+	if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t /*size*/) noexcept { std::free(ptr); }
 
 TEST_CASE("Event should behave as expected", "[rawrbox::Event]") {
 	SECTION("rawrbox::Event::size") {
@@ -25,4 +46,191 @@ TEST_CASE("Event should behave as expected", "[rawrbox::Event]") {
 
 		a("ok");
 	}
+
+	SECTION("rawrbox::Event::remove") {
+		rawrbox::Event<int> a;
+		std::vector<int> called = {};
+
+		// Same lambda type, only the token tells them apart
+		std::vector<rawrbox::EventToken> tokens = {};
+		for (int i = 0; i < 3; i++) {
+			tokens.push_back(a += [&called, i](int /*_v*/) { called.push_back(i); });
+		}
+
+		a -= tokens[1];
+		REQUIRE(a.size() == 2);
+		REQUIRE(a.remove(tokens[1]) == false);
+
+		a(0);
+		REQUIRE(called == std::vector<int>{0, 2});
+	}
+
+	SECTION("rawrbox::Event::remove self") {
+		rawrbox::Event<> a;
+		rawrbox::EventToken token = {};
+		int calls = 0;
+		int others = 0;
+
+		token = a += [&a, &token, &calls]() {
+			calls++;
+			REQUIRE(a.remove(token));
+		};
+		a += [&others]() { others++; };
+
+		a();
+		a();
+
+		REQUIRE(calls == 1);
+		REQUIRE(others == 2);
+		REQUIRE(a.size() == 1);
+	}
+
+	SECTION("rawrbox::Event::reentrancy") {
+		rawrbox::Event<int> a;
+		std::vector<int> called = {};
+		rawrbox::EventToken last = {};
+
+		a += [&a, &called](int depth) {
+			called.push_back(depth);
+			if (depth < 2) a(depth + 1); // Nested call of the same event
+		};
+
+		a += [&a, &called, &last](int depth) {
+			called.push_back(10 + depth);
+			if (depth == 0) {
+				a.remove(last);                                               // Not called anymore, even by the outer call
+				a += [&called](int inner) { called.push_back(100 + inner); }; // Only from the next call
+			}
+		};
+
+		last = a += [&called](int depth) { called.push_back(20 + depth); };
+
+		a(0);
+		REQUIRE(called == std::vector<int>{0, 1, 2, 12, 22, 11, 21, 10});
+		REQUIRE(a.size() == 3);
+
+		called.clear();
+		a(2);
+		REQUIRE(called == std::vector<int>{2, 12, 102});
+	}
+
+	SECTION("rawrbox::Event::clear during call") {
+		rawrbox::Event<> a;
+		int calls = 0;
+
+		a += [&a, &calls]() {
+			calls++;
+			a.clear();
+		};
+		a += [&calls]() { calls++; };
+
+		a();
+		REQUIRE(calls == 1);
+		REQUIRE(a.empty());
+	}
+
+	SECTION("rawrbox::Event::copy") {
+		rawrbox::Event<int> a;
+		std::array<int, 64> big = {}; // Too big to be stored inline
+		int total = 0;
+
+		a += [big, &total](int v) { total += v + big[0]; };
+		a += [&total](int v) { total += v; };
+
+		auto b = a;
+		a.clear();
+		b(2);
+
+		REQUIRE(total == 4);
+		REQUIRE(b.size() == 2);
+	}
+
+	SECTION("rawrbox::Event::threads") {
+		rawrbox::Event<int> a;
+		std::atomic<size_t> always = 0;
+		std::atomic<size_t> churn = 0;
+
+		a += [&always](int v) { always += static_cast<size_t>(v); };
+
+		// Called from every thread at once (ex: physics contacts), while handlers come and go
+		constexpr size_t THREADS = 8;
+		constexpr size_t CALLS = 20000;
+
+		std::atomic<bool> running = true;
+		std::thread changer([&a, &churn, &running]() {
+			while (running) {
+				auto token = a += [&churn](int /*_v*/) { churn++; };
+				a -= token;
+			}
+		});
+
+		std::vector<std::thread> threads = {};
+		for (size_t t = 0; t < THREADS; t++) {
+			threads.emplace_back([&a]() {
+				for (size_t i = 0; i < CALLS; i++) {
+					a(1);
+
+					if (i % 1000 == 0) {
+						auto token = a += [](int /*_v*/) {}; // From inside the calling threads too
+						a.remove(token);
+					}
+				}
+			});
+		}
+
+		for (auto& thread : threads)
+			thread.join();
+
+		running = false;
+		changer.join();
+
+		REQUIRE(always == THREADS * CALLS);
+		REQUIRE(a.size() == 1);
+
+		a(1);
+		REQUIRE(always == THREADS * CALLS + 1);
+	}
+
+	SECTION("rawrbox::Event::allocations") {
+		rawrbox::Event<int, float> a;
+		int total = 0;
+
+		for (int i = 0; i < 16; i++) {
+			a += [&total, i](int v, float /*_f*/) { total += v + i; };
+		}
+
+		a += [&a, &total](int /*_v*/, float /*_f*/) {
+			auto token = a += [&total](int, float) { total++; }; // Added and removed while calling
+			a -= token;
+		};
+
+		a(1, 0.F); // Let the pending list grow once
+
+		const size_t before = allocations;
+		for (int i = 0; i < 100; i++) {
+			a(1, 0.F);
+		}
+
+		REQUIRE(allocations == before);
+		REQUIRE(total > 0);
+	}
+}
+
+TEST_CASE("Event benchmark", "[rawrbox::Event][.benchmark]") {
+	rawrbox::Event<int> a;
+	int total = 0;
+
+	for (int i = 0; i < 32; i++) {
+		a += [&total, i](int v) { total += v * i; };
+	}
+
+	size_t allocated = 0;
+	BENCHMARK("dispatch to 32 handlers") {
+		const size_t before = allocations;
+		a(1);
+		allocated += allocations - before;
+		return total;
+	};
+
+	REQUIRE(allocated == 0);
 }
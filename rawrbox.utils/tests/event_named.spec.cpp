@@ -3,6 +3,7 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <string>
+#include <vector>
 
 TEST_CASE("Event should behave as expected", "[rawrbox::EventNamed]") {
 	SECTION("rawrbox::EventNamed::size") {
@@ -26,4 +27,35 @@ TEST_CASE("Event should behave as expected", "[rawrbox::EventNamed]") {
 		a.add("test", [](const std::string& t) { REQUIRE(t == "ok"); });
 		a("ok");
 	}
+
+	SECTION("rawrbox::EventNamed::add") {
+		rawrbox::EventNamed<int> a;
+		std::vector<std::string> called = {};
+
+		a.add("test", [&called](int /*_v*/) { called.emplace_back("old"); });
+		a.add("test", [&called](int /*_v*/) { called.emplace_back("new"); });
+		REQUIRE(a.size() == 1);
+		REQUIRE(a.exists("test"));
+
+		a(0);
+		REQUIRE(called == std::vector<std::string>{"new"});
+	}
+
+	SECTION("rawrbox::EventNamed::remove during call") {
+		rawrbox::EventNamed<int> a;
+		int calls = 0;
+
+		a.add("self", [&a, &calls](int /*_v*/) {
+			calls++;
+			a.remove("self");
+			a.remove("other");
+		});
+		a.add("other", [&calls](int /*_v*/) { calls++; });
+
+		a(0);
+		a(0);
+		REQUIRE(calls == 1);
+		REQUIRE(a.empty());
+		REQUIRE(a.exists("self") == false);
+	}
 }
@@ -0,0 +1,174 @@
+#include <rawrbox/utils/file_watcher.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+	using Event = std::pair<std::string, rawrbox::FileStatus>;
+
+	constexpr auto TIMEOUT = std::chrono::seconds(5); // Only hit when something is broken
+
+	void writeFile(const std::filesystem::path& path, const std::string& content) {
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file << content;
+	}
+
+	// Pushes the write time forward, so polling always sees a change no matter the filesystem resolution
+	void bumpTime(const std::filesystem::path& path) {
+		std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(1));
+	}
+
+	struct Recorder {
+		std::mutex lock;
+		std::vector<Event> events = {};
+
+		std::vector<Event> get() {
+			const std::lock_guard<std::mutex> guard(lock);
+			return events;
+		}
+
+		// Polls until the events match, or gives up
+		template <typename T>
+		std::vector<Event> waitUntil(const T& pred) {
+			const auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+
+			auto current = this->get();
+			while (!pred(current) && std::chrono::steady_clock::now() < deadline) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(5));
+				current = this->get();
+			}
+
+			return current;
+		}
+
+		std::vector<Event> waitFor(size_t count) {
+			return this->waitUntil([count](const std::vector<Event>& got) { return got.size() >= count; });
+		}
+
+		// Changes the watched marker and waits for it, anything that happened before has been reported by then. Returns the rest
+		std::vector<Event> sync(const std::filesystem::path& marker) {
+			const Event expected = {marker.generic_string(), rawrbox::FileStatus::modified};
+
+			writeFile(marker, "return 0");
+			bumpTime(marker);
+
+			auto current = this->waitUntil([&expected](const std::vector<Event>& got) { return std::ranges::find(got, expected) != got.end(); });
+			REQUIRE(std::ranges::find(current, expected) != current.end());
+
+			const std::lock_guard<std::mutex> guard(this->lock);
+			std::erase(this->events, expected);
+			std::erase(current, expected);
+			return current;
+		}
+	};
+} // namespace
+
+TEST_CASE("FileWatcher should behave as expected", "[rawrbox::FileWatcher]") {
+	auto mode = GENERATE(rawrbox::FileWatcherMode::AUTO, rawrbox::FileWatcherMode::POLLING);
+	constexpr auto DELAY = std::chrono::milliseconds(50);
+
+	auto root = std::filesystem::temp_directory_path() / "rawrbox-watcher";
+	std::filesystem::remove_all(root);
+	std::filesystem::create_directories(root);
+
+	auto script = root / "script.lua";
+	auto other = root / "other.lua";
+	auto marker = root / "marker.lua";
+	writeFile(script, "return 1");
+	writeFile(other, "return 2");
+	writeFile(marker, "return 0");
+
+	Recorder recorder;
+	std::thread::id callbackThread = {};
+
+	rawrbox::FileWatcher watcher(
+	    [&recorder, &callbackThread](const std::string& path, rawrbox::FileStatus status) {
+		    const std::lock_guard<std::mutex> guard(recorder.lock);
+		    recorder.events.emplace_back(path, status);
+		    callbackThread = std::this_thread::get_id();
+	    },
+	    DELAY, mode);
+
+	watcher.watchFile(script.generic_string());
+	watcher.watchFile(marker.generic_string());
+	watcher.start();
+
+#ifdef __linux__
+	REQUIRE(watcher.isNative() == (mode == rawrbox::FileWatcherMode::AUTO));
+#endif
+
+	SECTION("rawrbox::FileWatcher::write") {
+		for (int i = 0; i < 5; i++) {
+			writeFile(script, "return " + std::to_string(i)); // A burst, only reported once
+		}
+
+		bumpTime(script);
+		writeFile(other, "return 3"); // Not watched
+
+		REQUIRE(recorder.sync(marker) == std::vector<Event>{{script.generic_string(), rawrbox::FileStatus::modified}});
+		REQUIRE(callbackThread != std::this_thread::get_id());
+	}
+
+	SECTION("rawrbox::FileWatcher::rename") {
+		// Editor style save, write to a temp file then replace the original
+		auto temp = root / "script.lua.tmp";
+		writeFile(temp, "return 10");
+		bumpTime(temp);
+		std::filesystem::rename(temp, script);
+
+		REQUIRE(recorder.sync(marker) == std::vector<Event>{{script.generic_string(), rawrbox::FileStatus::modified}});
+		REQUIRE(watcher.isWatching(script.generic_string()));
+	}
+
+	SECTION("rawrbox::FileWatcher::erase") {
+		std::filesystem::remove(script);
+
+		REQUIRE(recorder.waitFor(1) == std::vector<Event>{{script.generic_string(), rawrbox::FileStatus::erased}});
+		REQUIRE_FALSE(watcher.isWatching(script.generic_string()));
+
+		// Not watched anymore
+		writeFile(script, "return 1");
+		REQUIRE(recorder.sync(marker).size() == 1);
+	}
+
+	SECTION("rawrbox::FileWatcher recreated folder") {
+		auto folder = root / "folder";
+		auto nested = folder / "nested.lua";
+
+		std::filesystem::create_directories(folder);
+		writeFile(nested, "return 1");
+		watcher.watchFile(nested.generic_string());
+
+		// Replaced before the delay runs out, so it's still a modification
+		std::filesystem::remove_all(folder);
+		std::filesystem::create_directories(folder);
+		writeFile(nested, "return 2");
+		bumpTime(nested);
+
+		REQUIRE(recorder.sync(marker) == std::vector<Event>{{nested.generic_string(), rawrbox::FileStatus::modified}});
+
+		// And still watched in the new folder
+		writeFile(nested, "return 3");
+		bumpTime(nested);
+
+		REQUIRE(recorder.waitFor(2).size() == 2);
+	}
+
+	SECTION("rawrbox::FileWatcher::unwatchFile") {
+		watcher.unwatchFile(script.generic_string());
+		REQUIRE_FALSE(watcher.isWatching(script.generic_string()));
+
+		writeFile(script, "return 5");
+		REQUIRE(recorder.sync(marker).empty());
+	}
+
+	watcher.stop();
+	std::filesystem::remove_all(root);
+}
@@ -0,0 +1,152 @@
+#include <rawrbox/utils/logger.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <spdlog/sinks/base_sink.h>
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+	// Keeps every written message
+	class MemorySink : public spdlog::sinks::base_sink<std::mutex> {
+	protected:
+		void sink_it_(const spdlog::details::log_msg& msg) override {
+			this->messages.emplace_back(msg.payload.data(), msg.payload.size());
+		}
+
+		void flush_() override {}
+
+	public:
+		std::vector<std::string> messages = {};
+	};
+
+	struct Player {
+		std::string name;
+		int score = 0;
+	};
+
+	std::shared_ptr<MemorySink> captureSink() {
+		auto sink = std::make_shared<MemorySink>();
+
+		rawrbox::Logger::flush();
+		rawrbox::Logger::LOGGER->sinks().clear();
+		rawrbox::Logger::LOGGER->sinks().push_back(sink);
+
+		return sink;
+	}
+} // namespace
+
+template <>
+struct fmt::formatter<Player> : fmt::formatter<std::string> {
+	auto format(const Player& player, fmt::format_context& ctx) const {
+		return fmt::formatter<std::string>::format(fmt::format("{} ({})", player.name, player.score), ctx);
+	}
+};
+
+TEST_CASE("Logger should behave as expected", "[rawrbox::Logger]") {
+	rawrbox::Logger logger("Test");
+	rawrbox::Logger::LEVEL = spdlog::level::trace;
+
+	auto sink = captureSink();
+
+	SECTION("rawrbox::Logger::info") {
+		{
+			std::string temp = "temporary";
+			logger.info("{} {:.2f} {} {}", temp, 1.5F, fmt::styled(temp, fmt::fg(fmt::color::coral)), Player{"bob", 3});
+		} // Arguments are gone before the message is formatted
+
+		logger.warn("{:>5}|{}", 42, "literal");
+		logger.info("{:>9}|{:.2f}", Player{"bob", 3}, 2.5); // Formatted on the caller, specs kept
+		rawrbox::Logger::flush();
+
+		REQUIRE(sink->messages.size() == 3);
+		REQUIRE(sink->messages[0].find("temporary 1.50") != std::string::npos);
+		REQUIRE(sink->messages[0].find("bob (3)") != std::string::npos);
+		REQUIRE(sink->messages[0].find(fmt::format("{}", fmt::styled("temporary", fmt::fg(fmt::color::coral)))) != std::string::npos);
+		REQUIRE(sink->messages[1].find("   42|literal") != std::string::npos);
+		REQUIRE(sink->messages[2].find("  bob (3)|2.50") != std::string::npos);
+	}
+
+	SECTION("rawrbox::Logger::LEVEL") {
+		rawrbox::Logger::LEVEL = spdlog::level::warn;
+
+		logger.info("skipped");
+		logger.debug("skipped");
+		logger.error("written");
+		rawrbox::Logger::flush();
+
+		REQUIRE(sink->messages.size() == 1);
+		REQUIRE(sink->messages[0].find("written") != std::string::npos);
+	}
+
+	SECTION("rawrbox::Logger::threads") {
+		constexpr size_t THREADS = 8;
+		constexpr size_t MESSAGES = 20000;
+
+		std::vector<std::thread> threads = {};
+		for (size_t t = 0; t < THREADS; t++) {
+			threads.emplace_back([&logger, t]() {
+				for (size_t i = 0; i < MESSAGES; i++) {
+					logger.info("{} {}", t, i);
+				}
+			});
+		}
+
+		for (auto& thread : threads)
+			thread.join();
+
+		rawrbox::Logger::flush();
+		REQUIRE(sink->messages.size() == THREADS * MESSAGES);
+
+		// Nothing lost, and in order per thread
+		std::vector<size_t> next(THREADS, 0);
+		bool ordered = true;
+
+		for (const auto& message : sink->messages) {
+			auto split = message.rfind(' ');
+			auto start = message.rfind(' ', split - 1);
+
+			size_t t = std::stoul(message.substr(start + 1, split - start - 1));
+			size_t i = std::stoul(message.substr(split + 1));
+
+			ordered &= next[t] == i;
+			next[t] = i + 1;
+		}
+
+		REQUIRE(ordered);
+		REQUIRE(next == std::vector<size_t>(THREADS, MESSAGES));
+	}
+
+	rawrbox::Logger::flush();
+	rawrbox::Logger::LOGGER->sinks().clear();
+}
+
+TEST_CASE("Logger benchmark", "[rawrbox::Logger][.benchmark]") {
+	rawrbox::Logger logger("Benchmark");
+	auto sink = captureSink();
+	size_t i = 0;
+
+	rawrbox::Logger::LEVEL = spdlog::level::warn;
+	BENCHMARK("Disabled level") {
+		logger.debug("Loaded '{}' in {}ms", "some/file.json", i++);
+	};
+
+	rawrbox::Logger::LEVEL = spdlog::level::trace;
+	// Drained between samples, so it measures the calling thread and not the writer
+	BENCHMARK_ADVANCED("Enabled, queued")(Catch::Benchmark::Chronometer meter) {
+		rawrbox::Logger::flush();
+		meter.measure([&logger, &i]() { logger.info("Loaded '{}' in {}ms", "some/file.json", i++); });
+	};
+
+	BENCHMARK("Enabled, formatted on the caller (previous behaviour)") {
+		auto str = fmt::format("Loaded '{}' in {}ms", "some/file.json", i++);
+		rawrbox::Logger::write(spdlog::level::info, "Benchmark", str);
+	};
+
+	rawrbox::Logger::flush();
+	rawrbox::Logger::LOGGER->sinks().clear();
+}
@@ -14,4 +14,24 @@ TEST_CASE("PathUtils should behave as expected", "[rawrbox::PathUtils]") {
 		REQUIRE(rawrbox::PathUtils::stripRootPath("C:/windows/pls/screee") == "windows/pls/screee");
 #endif
 	}
+
+	SECTION("rawrbox::PathUtils::toKey") {
+		REQUIRE(rawrbox::PathUtils::toKey("./assets/json/test.json") == "assets/json/test.json");
+		REQUIRE(rawrbox::PathUtils::toKey("assets/json/../json/test.json") == "assets/json/test.json");
+		REQUIRE(rawrbox::PathUtils::toKey(std::filesystem::current_path() / "assets/json/test.json") == "assets/json/test.json");
+
+		// Follows the working directory
+		auto old = std::filesystem::current_path();
+		auto temp = std::filesystem::temp_directory_path();
+
+		std::filesystem::current_path(temp);
+		REQUIRE(rawrbox::PathUtils::toKey(temp / "assets/json/test.json") == "assets/json/test.json");
+		REQUIRE(rawrbox::PathUtils::toKey(old / "assets/json/test.json") != "assets/json/test.json");
+		std::filesystem::current_path(old);
+	}
+
+	SECTION("rawrbox::PathUtils::hash") {
+		REQUIRE(rawrbox::PathUtils::hash("assets/json/test.json") == rawrbox::PathUtils::hash(rawrbox::PathUtils::toKey("./assets/json/test.json")));
+		REQUIRE(rawrbox::PathUtils::hash("assets/json/test.json") != rawrbox::PathUtils::hash("assets/json/test2.json"));
+	}
 }
@@ -0,0 +1,293 @@
+#include <rawrbox/utils/profiler.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <latch>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+	struct TraceEvent {
+		std::string name;
+		std::string ph;
+		uint32_t tid = 0;
+		int64_t ts = 0; // ns
+		int64_t dur = 0;
+
+		// Args, whichever the event has
+		std::string detail;
+		std::string argName;
+		double value = 0.0;
+	};
+
+	// Reads the value after "key": on a single event line, strings are unescaped. Empty if missing
+	std::string field(const std::string& line, const std::string& key, size_t from = 0) {
+		auto pos = line.find(fmt::format("\"{}\":", key), from);
+		if (pos == std::string::npos) return "";
+		pos += key.size() + 3;
+
+		std::string value = {};
+		if (line[pos] != '"') {
+			while (pos < line.size() && line[pos] != ',' && line[pos] != '}') {
+				value.push_back(line[pos++]);
+			}
+
+			return value;
+		}
+
+		for (pos++; pos < line.size() && line[pos] != '"'; pos++) {
+			if (line[pos] != '\\') {
+				value.push_back(line[pos]);
+				continue;
+			}
+
+			switch (line[++pos]) {
+				case 'n': value.push_back('\n'); break;
+				case 't': value.push_back('\t'); break;
+				case 'r': value.push_back('\r'); break;
+				default: value.push_back(line[pos]); break; // Quotes and backslashes
+			}
+		}
+
+		REQUIRE(pos < line.size()); // Closed
+		return value;
+	}
+
+	int64_t toNs(const std::string& value) { return std::llround(std::stod(value) * 1000.0); }
+
+	// The export writes one event per line, enough to read it back without a json library
+	std::vector<TraceEvent> parse(const std::string& json) {
+		const std::string header = R"({"displayTimeUnit":"ms","traceEvents":[)";
+		REQUIRE(json.starts_with(header));
+		REQUIRE(json.ends_with("]}"));
+
+		std::vector<TraceEvent> events = {};
+
+		size_t begin = header.size();
+		const size_t last = json.size() - 2;
+		while (begin < last) {
+			size_t end = json.find(",\n", begin);
+			if (end == std::string::npos || end > last) end = last;
+
+			const std::string line = json.substr(begin, end - begin);
+			REQUIRE(line.starts_with("{"));
+			REQUIRE(line.ends_with("}"));
+
+			TraceEvent ev = {};
+			ev.name = field(line, "name");
+			ev.ph = field(line, "ph");
+			ev.tid = static_cast<uint32_t>(std::stoul(field(line, "tid")));
+
+			const auto ts = field(line, "ts");
+			if (!ts.empty()) ev.ts = toNs(ts);
+			const auto dur = field(line, "dur");
+			if (!dur.empty()) ev.dur = toNs(dur);
+
+			const auto args = line.find("\"args\":{");
+			if (args != std::string::npos) {
+				ev.detail = field(line, "detail", args);
+				ev.argName = field(line, "name", args);
+
+				const auto value = field(line, "value", args);
+				if (!value.empty()) ev.value = std::stod(value);
+			}
+
+			events.push_back(ev);
+			begin = end + 2;
+		}
+
+		return events;
+	}
+
+	const TraceEvent& find(const std::vector<TraceEvent>& events, const std::string& name) {
+		auto fnd = std::ranges::find(events, name, &TraceEvent::name);
+		REQUIRE(fnd != events.end());
+		return *fnd;
+	}
+} // namespace
+
+TEST_CASE("PROFILER should behave as expected", "[rawrbox::PROFILER]") {
+	SECTION("rawrbox::PROFILER::zone") {
+		rawrbox::PROFILER::start();
+
+		{
+			const rawrbox::ProfileZone outer("outer");
+			{
+				const rawrbox::ProfileZone inner("inner", "textures/\"quoted\".png");
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+
+			rawrbox::PROFILER::counter("entities", 42);
+		}
+
+		rawrbox::PROFILER::frame();
+		rawrbox::PROFILER::stop();
+
+		{
+			const rawrbox::ProfileZone ignored("ignored"); // Not recording
+		}
+
+		auto events = parse(rawrbox::PROFILER::exportJSON());
+		REQUIRE(std::ranges::find(events, "ignored", &TraceEvent::name) == events.end());
+
+		const auto& outer = find(events, "outer");
+		const auto& inner = find(events, "inner");
+
+		REQUIRE(outer.ph == "X");
+		REQUIRE(inner.ph == "X");
+		REQUIRE(outer.tid == inner.tid);
+
+		// Nested, and the parent comes first
+		REQUIRE(inner.ts >= outer.ts);
+		REQUIRE(inner.ts + inner.dur <= outer.ts + outer.dur);
+		REQUIRE(inner.dur >= 1000000);
+		REQUIRE(std::ranges::find(events, "outer", &TraceEvent::name) < std::ranges::find(events, "inner", &TraceEvent::name));
+		REQUIRE(inner.detail == "textures/\"quoted\".png");
+
+		const auto& counter = find(events, "entities");
+		REQUIRE(counter.ph == "C");
+		REQUIRE(counter.value == 42.0);
+
+		const auto& frame = find(events, "frame");
+		REQUIRE(frame.ph == "i");
+		REQUIRE(frame.ts >= outer.ts + outer.dur);
+	}
+
+	SECTION("rawrbox::PROFILER threads") {
+		rawrbox::PROFILER::start();
+
+		std::latch first(1);
+		std::thread a([&first]() {
+			rawrbox::PROFILER::setThreadName("worker-a");
+			{
+				const rawrbox::ProfileZone zone("a");
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+
+			first.count_down();
+		});
+
+		std::thread b([&first]() {
+			rawrbox::PROFILER::setThreadName("worker-b");
+			first.wait();
+
+			const rawrbox::ProfileZone zone("b"); // Strictly after "a"
+		});
+
+		a.join();
+		b.join();
+		rawrbox::PROFILER::stop();
+
+		auto events = parse(rawrbox::PROFILER::exportJSON());
+
+		const auto& zoneA = find(events, "a");
+		const auto& zoneB = find(events, "b");
+		REQUIRE(zoneA.tid != zoneB.tid);
+		REQUIRE(zoneB.ts >= zoneA.ts + zoneA.dur);
+
+		// Named threads
+		auto threadName = [&events](uint32_t tid) {
+			for (const auto& event : events) {
+				if (event.ph == "M" && event.name == "thread_name" && event.tid == tid) return event.argName;
+			}
+
+			return std::string();
+		};
+
+		REQUIRE(threadName(zoneA.tid) == "worker-a");
+		REQUIRE(threadName(zoneB.tid) == "worker-b");
+
+		// Events are ordered by time, whatever thread recorded them
+		int64_t last = 0;
+		for (const auto& event : events) {
+			if (event.ph == "M") continue;
+
+			REQUIRE(event.ts >= last);
+			last = event.ts;
+		}
+	}
+
+	SECTION("rawrbox::PROFILER::start") {
+		rawrbox::PROFILER::start();
+		{
+			const rawrbox::ProfileZone zone("old");
+		}
+		rawrbox::PROFILER::stop();
+
+		rawrbox::PROFILER::start(); // Drops the last capture
+		{
+			const rawrbox::ProfileZone zone("new");
+		}
+		rawrbox::PROFILER::stop();
+
+		auto events = parse(rawrbox::PROFILER::exportJSON());
+		REQUIRE(std::ranges::find(events, "old", &TraceEvent::name) == events.end());
+		REQUIRE(std::ranges::find(events, "new", &TraceEvent::name) != events.end());
+	}
+
+	SECTION("rawrbox::PROFILER::start mid zone") {
+		rawrbox::PROFILER::start();
+		{
+			const rawrbox::ProfileZone zone("straddling"); // Opened on the last capture, closed on the new one
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+			rawrbox::PROFILER::start();
+			const rawrbox::ProfileZone inner("inside");
+		}
+		rawrbox::PROFILER::stop();
+
+		auto events = parse(rawrbox::PROFILER::exportJSON());
+		REQUIRE(std::ranges::find(events, "straddling", &TraceEvent::name) == events.end());
+		REQUIRE(std::ranges::find(events, "inside", &TraceEvent::name) != events.end());
+	}
+
+	SECTION("rawrbox::PROFILER::exportJSON while recording") {
+		std::atomic<bool> running = true;
+		rawrbox::PROFILER::start();
+
+		std::latch ready(4);
+		std::vector<std::thread> workers = {};
+		for (int t = 0; t < 4; t++) {
+			workers.emplace_back([&running, &ready, t]() {
+				size_t i = 0;
+				while (running && i < 20000) { // Bounded, exports of a busy capture get big
+					{
+						const rawrbox::ProfileZone zone("work", fmt::format("item-{}", (i++ % 8) + static_cast<size_t>(t) * 8));
+					}
+
+					if (i == 1) ready.count_down(); // Recorded its first zone
+				}
+			});
+		}
+
+		ready.wait();
+
+		// New captures start while the last one is exported, events from different captures are never mixed
+		size_t exported = 0;
+		for (int capture = 0; capture < 20; capture++) {
+			auto events = parse(rawrbox::PROFILER::exportJSON());
+			for (const auto& event : events) {
+				if (event.ph == "M") continue;
+
+				REQUIRE(event.name == "work");
+				REQUIRE(event.detail.starts_with("item-"));
+				exported++;
+			}
+
+			rawrbox::PROFILER::start();
+		}
+
+		REQUIRE(exported > 0); // The first capture has at least the zone of each worker
+		running = false;
+		for (auto& worker : workers)
+			worker.join();
+
+		rawrbox::PROFILER::stop();
+	}
+}
@@ -0,0 +1,59 @@
+#include <rawrbox/utils/slot_map.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+TEST_CASE("SlotMap should behave as expected", "[rawrbox::SlotMap]") {
+	SECTION("rawrbox::SlotMap::insert") {
+		rawrbox::SlotMap<std::string> map;
+
+		auto a = map.insert("a");
+		auto b = map.insert("b");
+
+		REQUIRE(map.size() == 2);
+		REQUIRE(map.get(a) == "a");
+		REQUIRE(map.get(b) == "b");
+		REQUIRE(map.indexOf(b) == 1);
+		REQUIRE(map.handleAt(1) == b);
+	}
+
+	SECTION("rawrbox::SlotMap::remove") {
+		rawrbox::SlotMap<std::string> map;
+
+		auto a = map.insert("a");
+		auto b = map.insert("b");
+		auto c = map.insert("c");
+
+		// Last element is swapped into the hole, handles stay valid
+		REQUIRE(map.remove(a) == 0);
+		REQUIRE_FALSE(map.valid(a));
+		REQUIRE(map.size() == 2);
+		REQUIRE(map.data()[0] == "c");
+		REQUIRE(map.get(b) == "b");
+		REQUIRE(map.get(c) == "c");
+		REQUIRE(map.indexOf(c) == 0);
+
+		// Removing the last one doesn't move anything
+		REQUIRE(map.remove(b) == rawrbox::SlotMap<std::string>::INVALID);
+		REQUIRE(map.remove(b) == rawrbox::SlotMap<std::string>::INVALID);
+		REQUIRE(map.size() == 1);
+
+		// Handles are reused
+		auto d = map.insert("d");
+		REQUIRE((d == a || d == b));
+		REQUIRE(map.get(d) == "d");
+
+		REQUIRE_THROWS(map.get(1337));
+	}
+
+	SECTION("rawrbox::SlotMap::clear") {
+		rawrbox::SlotMap<int> map;
+		map.insert(1);
+		map.insert(2);
+
+		map.clear();
+		REQUIRE(map.empty());
+		REQUIRE(map.insert(3) == 0);
+	}
+}
@@ -0,0 +1,183 @@
+#include <rawrbox/utils/crc.hpp>
+#include <rawrbox/utils/snapshot_ring.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+	// Small deterministic "world", positions and velocities moved by an input every frame
+	struct World {
+		std::vector<float> state = std::vector<float>(512, 0.F);
+
+		void step(int input) {
+			for (size_t i = 0; i < state.size(); i += 2) {
+				if (i % 64 == 0) state[i + 1] += static_cast<float>(input) * 0.25F; // Only a few "bodies" react
+				state[i] += state[i + 1] * (1.F / 60.F);
+			}
+		}
+
+		[[nodiscard]] uint32_t hash() const {
+			static const CRC::Table<uint32_t, 32> table(CRC::CRC_32());
+			return CRC::Calculate(state.data(), state.size() * sizeof(float), table);
+		}
+
+		void save(rawrbox::SnapshotRing& ring, uint64_t frame) const {
+			ring.push(frame, state.data(), state.size() * sizeof(float), this->hash());
+		}
+
+		bool restore(const rawrbox::SnapshotRing& ring, uint64_t frame) {
+			std::vector<uint8_t> data = {};
+			if (!ring.get(frame, data)) return false;
+
+			state.resize(data.size() / sizeof(float));
+			std::memcpy(state.data(), data.data(), data.size());
+			return true;
+		}
+	};
+} // namespace
+
+TEST_CASE("SnapshotRing should behave as expected", "[rawrbox::SnapshotRing]") {
+	SECTION("rawrbox::SnapshotRing::encode / decode") {
+		std::mt19937 rng(1337);
+		std::uniform_int_distribution<int> byte(0, 255);
+
+		std::vector<uint8_t> base(4096);
+		for (auto& b : base)
+			b = static_cast<uint8_t>(byte(rng));
+
+		// Sparse changes, a grown tail and a shrunk one
+		auto target = base;
+		target[10] ^= 0xFF;
+		target[11] ^= 0xFF;
+		target[2000] ^= 0x01;
+		target.insert(target.end(), {1, 2, 3, 0, 0});
+
+		std::vector<uint8_t> delta = {};
+		std::vector<uint8_t> out = {};
+
+		rawrbox::SnapshotRing::encode(base, target.data(), target.size(), delta);
+		REQUIRE(delta.size() < 32);
+
+		rawrbox::SnapshotRing::decode(base, delta, target.size(), out);
+		REQUIRE(out == target);
+
+		std::vector<uint8_t> shrunk(base.begin(), base.begin() + 100);
+		rawrbox::SnapshotRing::encode(base, shrunk.data(), shrunk.size(), delta);
+		REQUIRE(delta.empty());
+
+		rawrbox::SnapshotRing::decode(base, delta, shrunk.size(), out);
+		REQUIRE(out == shrunk);
+
+		// Nothing in common
+		std::vector<uint8_t> empty = {};
+		rawrbox::SnapshotRing::encode(empty, base.data(), base.size(), delta);
+		rawrbox::SnapshotRing::decode(empty, delta, base.size(), out);
+		REQUIRE(out == base);
+	}
+
+	SECTION("rawrbox::SnapshotRing::push / get") {
+		rawrbox::SnapshotRing ring(8, 3);
+		World world = {};
+
+		std::vector<std::vector<float>> expected = {};
+		for (uint64_t frame = 0; frame < 20; frame++) {
+			world.save(ring, frame);
+			expected.push_back(world.state);
+			world.step(static_cast<int>(frame % 3));
+		}
+
+		REQUIRE(ring.size() == 8);
+		REQUIRE(ring.getOldest() == 12);
+		REQUIRE(ring.getNewest() == 19);
+		REQUIRE_FALSE(ring.has(11));
+
+		for (uint64_t frame = 12; frame < 20; frame++) {
+			World restored = {};
+			REQUIRE(restored.restore(ring, frame));
+			REQUIRE(restored.state == expected[frame]);
+			REQUIRE(ring.getHash(frame) == restored.hash());
+		}
+
+		REQUIRE(ring.getMemoryUsage() < 8 * 512 * sizeof(float));
+	}
+
+	SECTION("rawrbox::SnapshotRing rollback") {
+		rawrbox::SnapshotRing ring(32, 8);
+		World world = {};
+
+		std::vector<int> inputs(30, 1);
+		for (uint64_t frame = 0; frame < inputs.size(); frame++) {
+			world.save(ring, frame);
+			world.step(inputs[frame]);
+		}
+
+		const uint32_t final = world.hash();
+
+		// Late input for frame 10, roll back and resimulate with it
+		inputs[10] = -4;
+
+		REQUIRE(world.restore(ring, 10));
+		ring.discard(10);
+		REQUIRE(ring.getNewest() == 10);
+
+		for (uint64_t frame = 10; frame < inputs.size(); frame++) {
+			if (frame != 10) world.save(ring, frame);
+			world.step(inputs[frame]);
+		}
+
+		REQUIRE(world.hash() != final);
+
+		// Same inputs again from the same frame give bit identical hashes, on every frame
+		std::vector<uint32_t> hashes = {};
+		for (uint64_t frame = 10; frame < inputs.size(); frame++) {
+			hashes.push_back(ring.getHash(frame).value());
+		}
+
+		REQUIRE(world.restore(ring, 10));
+		for (uint64_t frame = 10; frame < inputs.size(); frame++) {
+			REQUIRE(world.hash() == hashes[frame - 10]);
+			world.save(ring, frame); // Pushing an existing frame replaces it and everything after
+			world.step(inputs[frame]);
+		}
+
+		REQUIRE(ring.getNewest() == inputs.size() - 1);
+	}
+
+	SECTION("rawrbox::SnapshotRing::clear") {
+		rawrbox::SnapshotRing ring(4, 2);
+		World world = {};
+
+		world.save(ring, 0);
+		world.save(ring, 1);
+		ring.clear();
+
+		REQUIRE(ring.empty());
+		REQUIRE_FALSE(ring.getNewest().has_value());
+
+		world.save(ring, 5);
+		REQUIRE(ring.has(5));
+	}
+}
+
+TEST_CASE("SnapshotRing benchmark", "[rawrbox::SnapshotRing][.benchmark]") {
+	World world = {};
+	world.state.resize(256 * 1024); // ~1MB of state, about what a few thousand bodies save
+
+	rawrbox::SnapshotRing ring(64, 16);
+	uint64_t frame = 0;
+
+	BENCHMARK("push") {
+		world.step(1);
+		world.save(ring, frame++);
+		return ring.size();
+	};
+
+	std::vector<uint8_t> out = {};
+	BENCHMARK("get oldest") {
+		return ring.get(ring.getOldest().value(), out);
+	};
+}
@@ -0,0 +1,72 @@
+#include <rawrbox/utils/sort.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+TEST_CASE("SortUtils should behave as expected", "[rawrbox::SortUtils]") {
+	SECTION("rawrbox::SortUtils::radix") {
+		std::mt19937_64 rng(1337);
+
+		std::vector<uint64_t> keys(10000);
+		for (auto& key : keys) {
+			key = rng();
+		}
+
+		std::vector<uint32_t> order = {};
+		rawrbox::SortUtils::radix(keys, order);
+
+		REQUIRE(order.size() == keys.size());
+		REQUIRE(std::ranges::is_sorted(order, {}, [&keys](uint32_t i) { return keys[i]; }));
+	}
+
+	SECTION("rawrbox::SortUtils::radix stable") {
+		// Only a few distinct keys, equal ones keep their order
+		std::vector<uint64_t> keys = {3, 1, 2, 1, 3, 0xFF00000000000000, 1, 2};
+
+		std::vector<uint32_t> order = {};
+		rawrbox::SortUtils::radix(keys, order);
+
+		REQUIRE(order == std::vector<uint32_t>{1, 3, 6, 2, 7, 0, 4, 5});
+	}
+
+	SECTION("rawrbox::SortUtils::radix edge cases") {
+		std::vector<uint32_t> order = {1, 2, 3};
+
+		rawrbox::SortUtils::radix({}, order);
+		REQUIRE(order.empty());
+
+		rawrbox::SortUtils::radix({42}, order);
+		REQUIRE(order == std::vector<uint32_t>{0});
+
+		rawrbox::SortUtils::radix({7, 7, 7}, order); // Every pass skipped
+		REQUIRE(order == std::vector<uint32_t>{0, 1, 2});
+	}
+}
+
+TEST_CASE("SortUtils benchmark", "[rawrbox::SortUtils][.benchmark]") {
+	std::mt19937_64 rng(1337);
+
+	std::vector<uint64_t> keys(50000);
+	for (auto& key : keys) {
+		key = rng();
+	}
+
+	std::vector<uint32_t> order = {};
+	rawrbox::SortUtils::RadixScratch scratch = {};
+
+	BENCHMARK("Radix sort (50k keys)") {
+		rawrbox::SortUtils::radix(keys, order, scratch);
+		return order.size();
+	};
+
+	BENCHMARK("std::sort (50k keys)") {
+		order.resize(keys.size());
+		std::iota(order.begin(), order.end(), 0U);
+		std::ranges::sort(order, {}, [&keys](uint32_t i) { return keys[i]; });
+		return order.size();
+	};
+}
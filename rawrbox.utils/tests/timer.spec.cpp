@@ -1,7 +1,41 @@
+#include <rawrbox/utils/time.hpp>
 #include <rawrbox/utils/timer.hpp>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <random>
+#include <vector>
+
+namespace {
+	uint64_t fakeTime = 0;
+	uint64_t fakeClock() { return fakeTime; }
+
+	// Simulated time, so the tests don't sleep
+	struct FakeClock {
+		FakeClock() {
+			rawrbox::TIMER::clear();
+			rawrbox::TIMER::CLOCK = &fakeClock;
+			fakeTime = 0;
+		}
+
+		~FakeClock() {
+			rawrbox::TIMER::clear();
+			rawrbox::TIMER::CLOCK = &rawrbox::TimeUtils::time;
+		}
+
+		void advance(uint64_t ms) {
+			fakeTime += ms;
+			rawrbox::TIMER::update();
+		}
+
+		FakeClock(const FakeClock&) = delete;
+		FakeClock(FakeClock&&) = delete;
+		FakeClock& operator=(const FakeClock&) = delete;
+		FakeClock& operator=(FakeClock&&) = delete;
+	};
+} // namespace
+
 TEST_CASE("TIMER should behave as expected", "[rawrbox::TIMER]") {
 	SECTION("rawrbox::TIMER::simple") {
 		REQUIRE(rawrbox::TIMER::timers.empty() == true);
@@ -22,4 +56,151 @@ TEST_CASE("TIMER should behave as expected", "[rawrbox::TIMER]") {
 		rawrbox::TIMER::clear();
 		REQUIRE(rawrbox::TIMER::timers.empty() == true);
 	}
+
+	SECTION("rawrbox::TIMER::update") {
+		FakeClock clock;
+		std::vector<int> order = {};
+
+		rawrbox::TIMER::simple(300, [&order]() { order.push_back(300); });
+		rawrbox::TIMER::simple(100, [&order]() { order.push_back(100); });
+		rawrbox::TIMER::simple(5000, [&order]() { order.push_back(5000); }); // Cascades down two levels
+		rawrbox::TIMER::simple(200, [&order]() { order.push_back(200); });
+		rawrbox::TIMER::simple(100, [&order]() { order.push_back(101); }); // Same tick, creation order
+
+		clock.advance(99);
+		REQUIRE(order.empty());
+
+		clock.advance(1);
+		REQUIRE(order == std::vector<int>{100, 101});
+
+		clock.advance(4899);
+		REQUIRE(order == std::vector<int>{100, 101, 200, 300});
+
+		clock.advance(1);
+		REQUIRE(order == std::vector<int>{100, 101, 200, 300, 5000});
+		REQUIRE(rawrbox::TIMER::timers.empty());
+	}
+
+	SECTION("rawrbox::TIMER::create repetitions") {
+		FakeClock clock;
+		int ticks = 0;
+		bool completed = false;
+
+		rawrbox::TIMER::create("reps", 3, 10, [&ticks]() { ticks++; }, [&completed]() { completed = true; });
+		REQUIRE(rawrbox::TIMER::create("reps", 1, 10, []() {}) == nullptr);
+
+		clock.advance(25);
+		REQUIRE(ticks == 2);
+		REQUIRE(completed == false);
+
+		clock.advance(100);
+		REQUIRE(ticks == 3);
+		REQUIRE(completed == true);
+		REQUIRE(rawrbox::TIMER::exists("reps") == false);
+	}
+
+	SECTION("rawrbox::TIMER::pause") {
+		FakeClock clock;
+		int ticks = 0;
+
+		auto* timer = rawrbox::TIMER::create("paused", 0, 100, [&ticks]() { ticks++; });
+
+		clock.advance(50);
+		timer->pause(true);
+		REQUIRE(timer->isPaused());
+
+		clock.advance(1000);
+		REQUIRE(ticks == 0);
+
+		REQUIRE(rawrbox::TIMER::pause("paused", false));
+		clock.advance(49);
+		REQUIRE(ticks == 0);
+
+		clock.advance(1); // The remaining 50ms
+		REQUIRE(ticks == 1);
+
+		clock.advance(100);
+		REQUIRE(ticks == 2);
+
+		// From its own callback
+		rawrbox::TIMER::create("self", 0, 10, [&ticks]() {
+			ticks++;
+			rawrbox::TIMER::pause("self", true);
+		});
+
+		ticks = 0;
+		clock.advance(50);
+		REQUIRE(ticks == 1); // "paused" is next due at 1300ms
+		REQUIRE(rawrbox::TIMER::get("self")->isPaused());
+	}
+
+	SECTION("rawrbox::TIMER::destroy") {
+		FakeClock clock;
+		int ticks = 0;
+
+		auto* timer = rawrbox::TIMER::create(0, 10, [&ticks]() { ticks++; });
+		auto handle = timer->getHandle();
+		REQUIRE(rawrbox::TIMER::get(handle) == timer);
+
+		REQUIRE(rawrbox::TIMER::destroy(handle));
+		REQUIRE(rawrbox::TIMER::get(handle) == nullptr);
+		REQUIRE(rawrbox::TIMER::destroy(handle) == false);
+
+		// The slot is reused, the old handle stays invalid
+		auto* other = rawrbox::TIMER::create(0, 10, [&ticks]() { ticks++; });
+		REQUIRE(other->getHandle().index == handle.index);
+		REQUIRE(rawrbox::TIMER::get(handle) == nullptr);
+
+		// Destroying itself, and another timer due on the same tick
+		rawrbox::TIMER::create("a", 0, 10, []() {
+			rawrbox::TIMER::destroy("a");
+			rawrbox::TIMER::destroy("b");
+		});
+		rawrbox::TIMER::create("b", 0, 10, []() { FAIL("destroyed"); });
+
+		clock.advance(10);
+		REQUIRE(ticks == 1);
+		REQUIRE(rawrbox::TIMER::timers.size() == 1);
+	}
+
+	SECTION("rawrbox::TIMER 24h") {
+		FakeClock clock;
+		uint64_t seconds = 0;
+		uint64_t frames = 0;
+
+		rawrbox::TIMER::create(0, 1000, [&seconds]() { seconds++; });
+		rawrbox::TIMER::create(0, 12.5F, [&frames]() { frames++; }); // Fractional, rounding to ticks must not add up
+
+		std::mt19937 rng(1337);
+		std::uniform_int_distribution<uint64_t> step(1, 40);
+
+		constexpr uint64_t DAY = 24ULL * 60ULL * 60ULL * 1000ULL;
+		while (fakeTime < DAY) {
+			clock.advance(std::min(step(rng), DAY - fakeTime));
+		}
+
+		REQUIRE(seconds == 24ULL * 60ULL * 60ULL);
+		REQUIRE(frames == DAY * 2 / 25);
+	}
+}
+
+TEST_CASE("TIMER benchmark", "[rawrbox::TIMER][.benchmark]") {
+	FakeClock clock;
+
+	std::mt19937 rng(1337);
+	std::uniform_real_distribution<float> delay(16.F, 60000.F);
+
+	for (size_t i = 0; i < 100000; i++) {
+		rawrbox::TIMER::create(0, delay(rng), []() {});
+	}
+
+	BENCHMARK("update 100k timers, 16ms frame") {
+		clock.advance(16);
+		return rawrbox::TIMER::now();
+	};
+
+	BENCHMARK("create + destroy, 100k active") {
+		auto* timer = rawrbox::TIMER::create(0, delay(rng), []() {});
+		return rawrbox::TIMER::destroy(timer->getHandle());
+	};
 }
@@ -16,7 +16,7 @@ namespace gpu {
 
 		bool _ready = false;
 		rawrbox::Mesh<>* _lastPickedMesh = nullptr;
-		rawrbox::Instance* _lastPickedInstance = nullptr;
+		uint32_t _lastPickedInstance = rawrbox::SlotMap<rawrbox::Instance>::INVALID;
 
 		void setupGLFW() override;
 		void init() override;
@@ -51,18 +51,15 @@ namespace gpu {
 			if (!this->_ready || !isDown || button != rawrbox::MOUSE_BUTTON_1) return;
 
 			rawrbox::RENDERER->gpuPick(mousePos, [this](uint32_t id) {
-				bool updateInstance = false;
-
 				if (this->_lastPickedMesh != nullptr) {
 					this->_lastPickedMesh->setColor(rawrbox::Colors::White());
 					this->_lastPickedMesh = nullptr;
 				}
 
-				if (this->_lastPickedInstance != nullptr) {
-					this->_lastPickedInstance->setColor(rawrbox::Colors::White());
-					this->_lastPickedInstance = nullptr;
-
-					updateInstance = true;
+				if (this->_instance->hasInstance(this->_lastPickedInstance)) {
+					this->_instance->getInstance(this->_lastPickedInstance).setColor(rawrbox::Colors::White());
+					this->_instance->markInstanceDirty(this->_lastPickedInstance);
+					this->_lastPickedInstance = rawrbox::SlotMap<rawrbox::Instance>::INVALID;
 				}
 
 				if (id != 0) {
@@ -77,18 +74,17 @@ namespace gpu {
 					// -----------------
 
 					// Check instance --
-					for (auto& inst : this->_instance->instances()) {
-						if (inst.getId() == id) {
-							inst.setColor(rawrbox::Colors::Red());
-							this->_lastPickedInstance = &inst;
-							updateInstance = true;
+					const auto& instances = this->_instance->instances();
+					for (size_t i = 0; i < instances.size(); i++) {
+						if (instances[i].getId() == id) {
+							this->_lastPickedInstance = this->_instance->getInstanceHandle(i);
+							this->_instance->getInstance(this->_lastPickedInstance).setColor(rawrbox::Colors::Red());
+							this->_instance->markInstanceDirty(this->_lastPickedInstance);
 							break;
 						}
 					}
 					// -----------------
 				}
-
-				if (updateInstance) this->_instance->updateInstances();
 			});
 		};
 		// -----